@@ -0,0 +1,720 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Driver overhead benchmarks of the STM32G4 HAL: register reads and writes,
+ * polling iterations, interrupts and hardware events per API call, counted
+ * by the register model.
+ *
+ * The model runs in lockstep with the SysTick interrupt stopped, so the
+ * counts only depend on the driver code and the report is stable. Each
+ * benchmark checks its result, the report is only written when all pass.
+ *
+ * Usage: host_bench [-o report.json]
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "stm32g4xx_hal.h"
+#include "stm32g4xx_ll_usart.h"
+#include "regmodel.h"
+#include "regmodel_stm32g4xx.h"
+
+#define BENCH_TIMEOUT_S  30U
+
+/* USART1 and SPI1 kernel clock: PCLK2, from HSI after reset */
+#define BENCH_KERCLK     HSI_VALUE
+
+struct bench {
+	const char *name;
+	int (*setup)(void);
+	int (*run)(void);
+};
+
+struct result {
+	const char *name;
+	struct regmodel_stats stats;
+};
+
+static UART_HandleTypeDef huart1;
+static SPI_HandleTypeDef hspi1;
+static I2C_HandleTypeDef hi2c1;
+static CRC_HandleTypeDef hcrc;
+static DMA_HandleTypeDef hdma;
+static FDCAN_HandleTypeDef hfdcan1;
+static volatile int done;
+
+/* DMA addresses are 32-bit, the buffers are static */
+static uint32_t words_src[256];
+static uint32_t words_dst[256];
+static uint8_t bytes_src[67];
+static uint8_t bytes_dst[67];
+
+static void usart1_isr(void)
+{
+	HAL_UART_IRQHandler(&huart1);
+}
+
+static void spi1_isr(void)
+{
+	HAL_SPI_IRQHandler(&hspi1);
+}
+
+static void dma1_channel1_isr(void)
+{
+	HAL_DMA_IRQHandler(&hdma);
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	done = 1;
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	done = 1;
+}
+
+static void dma_complete(DMA_HandleTypeDef *hdma)
+{
+	done = 1;
+}
+
+static void wait_done(void)
+{
+	while (done == 0) {
+		__WFI();
+	}
+	done = 0;
+}
+
+/* CRC-32/MPEG-2, the default configuration of the CRC unit */
+static uint32_t crc32_mpeg2(const uint8_t *data, size_t len)
+{
+	uint32_t crc = 0xFFFFFFFFUL;
+
+	for (size_t i = 0U; i < len; i++) {
+		crc ^= (uint32_t)data[i] << 24;
+		for (uint32_t bit = 0U; bit < 8U; bit++) {
+			crc = ((crc & 0x80000000UL) != 0U) ? ((crc << 1) ^ 0x04C11DB7UL) : (crc << 1);
+		}
+	}
+	return crc;
+}
+
+static void fill(void)
+{
+	for (uint32_t i = 0U; i < 256U; i++) {
+		words_src[i] = 0x5A000000UL | (i * 0x01010101UL);
+	}
+	for (uint32_t i = 0U; i < sizeof(bytes_src); i++) {
+		bytes_src[i] = (uint8_t)(0x30U + i);
+	}
+	memset(words_dst, 0, sizeof(words_dst));
+	memset(bytes_dst, 0, sizeof(bytes_dst));
+}
+
+/* UART ------------------------------------------------------------------------*/
+
+static const UART_ConstInitTypeDef uart1_config =
+	UART_CONST_INIT(BENCH_KERCLK, 115200U, UART_WORDLENGTH_8B, UART_STOPBITS_1, UART_PARITY_NONE,
+			UART_MODE_TX_RX, UART_HWCONTROL_NONE, UART_OVERSAMPLING_16,
+			UART_ONE_BIT_SAMPLE_DISABLE, UART_PRESCALER_DIV1);
+
+static const LL_USART_ConstInitTypeDef usart1_config =
+	LL_USART_CONST_INIT(BENCH_KERCLK, LL_USART_PRESCALER_DIV1, 115200U, LL_USART_DATAWIDTH_8B,
+			    LL_USART_STOPBITS_1, LL_USART_PARITY_NONE, LL_USART_DIRECTION_TX_RX,
+			    LL_USART_HWCONTROL_NONE, LL_USART_OVERSAMPLING_16);
+
+/* USART1 configuration registers after the last init benchmark */
+static uint32_t usart1_regs[5];
+
+/*
+ * Check the USART1 configuration against the previous init benchmark, the
+ * registers being read through the model backdoor, out of the counts.
+ */
+static int usart1_check_config(int first)
+{
+	const uint32_t regs[5] = {
+		regmodel_read(USART1_BASE + offsetof(USART_TypeDef, CR1)),
+		regmodel_read(USART1_BASE + offsetof(USART_TypeDef, CR2)),
+		regmodel_read(USART1_BASE + offsetof(USART_TypeDef, CR3)),
+		regmodel_read(USART1_BASE + offsetof(USART_TypeDef, BRR)),
+		regmodel_read(USART1_BASE + offsetof(USART_TypeDef, PRESC)),
+	};
+
+	/* 16 MHz / 115200 rounded */
+	if (regs[3] != 139U) {
+		return -1;
+	}
+	if (first) {
+		memcpy(usart1_regs, regs, sizeof(regs));
+		return 0;
+	}
+	return (memcmp(usart1_regs, regs, sizeof(regs)) == 0) ? 0 : -1;
+}
+
+static int uart_init_setup(void)
+{
+	__HAL_RCC_USART1_CLK_ENABLE();
+	WRITE_REG(USART1->CR1, 0U);
+
+	memset(&huart1, 0, sizeof(huart1));
+	huart1.Instance = USART1;
+	huart1.Init.BaudRate = 115200U;
+	huart1.Init.WordLength = UART_WORDLENGTH_8B;
+	huart1.Init.StopBits = UART_STOPBITS_1;
+	huart1.Init.Parity = UART_PARITY_NONE;
+	huart1.Init.Mode = UART_MODE_TX_RX;
+	huart1.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	huart1.Init.OverSampling = UART_OVERSAMPLING_16;
+	return 0;
+}
+
+static int uart_init(void)
+{
+	if (HAL_UART_Init(&huart1) != HAL_OK) {
+		return -1;
+	}
+	return usart1_check_config(1);
+}
+
+static int uart_init_const(void)
+{
+	if (HAL_UARTEx_InitConst(&huart1, &uart1_config) != HAL_OK) {
+		return -1;
+	}
+	return usart1_check_config(0);
+}
+
+static int uart_setup(void)
+{
+	__HAL_RCC_USART1_CLK_ENABLE();
+	HAL_NVIC_EnableIRQ(USART1_IRQn);
+
+	huart1.Instance = USART1;
+	huart1.Init.BaudRate = 115200U;
+	huart1.Init.WordLength = UART_WORDLENGTH_8B;
+	huart1.Init.StopBits = UART_STOPBITS_1;
+	huart1.Init.Parity = UART_PARITY_NONE;
+	huart1.Init.Mode = UART_MODE_TX_RX;
+	huart1.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	huart1.Init.OverSampling = UART_OVERSAMPLING_16;
+	return (HAL_UART_Init(&huart1) == HAL_OK) ? 0 : -1;
+}
+
+static int uart_check_output(size_t len)
+{
+	return ((regmodel_uart_capture(USART1_BASE, bytes_dst, sizeof(bytes_dst)) == len) &&
+		(memcmp(bytes_dst, bytes_src, len) == 0)) ? 0 : -1;
+}
+
+static int uart_transmit(void)
+{
+	if (HAL_UART_Transmit(&huart1, bytes_src, 64U, HAL_MAX_DELAY) != HAL_OK) {
+		return -1;
+	}
+	return uart_check_output(64U);
+}
+
+static int uart_transmit_it(void)
+{
+	if (HAL_UART_Transmit_IT(&huart1, bytes_src, 16U) != HAL_OK) {
+		return -1;
+	}
+	wait_done();
+	return uart_check_output(16U);
+}
+
+static int uart_receive_setup(void)
+{
+	return (regmodel_uart_inject(USART1_BASE, bytes_src, 16U) == 16U) ? 0 : -1;
+}
+
+static int uart_receive(void)
+{
+	if (HAL_UART_Receive(&huart1, bytes_dst, 16U, HAL_MAX_DELAY) != HAL_OK) {
+		return -1;
+	}
+	return (memcmp(bytes_dst, bytes_src, 16U) == 0) ? 0 : -1;
+}
+
+static int ll_usart_init_setup(void)
+{
+	LL_USART_Disable(USART1);
+	return 0;
+}
+
+static int ll_usart_init(void)
+{
+	LL_USART_InitTypeDef init = {
+		.PrescalerValue = LL_USART_PRESCALER_DIV1,
+		.BaudRate = 115200U,
+		.DataWidth = LL_USART_DATAWIDTH_8B,
+		.StopBits = LL_USART_STOPBITS_1,
+		.Parity = LL_USART_PARITY_NONE,
+		.TransferDirection = LL_USART_DIRECTION_TX_RX,
+		.HardwareFlowControl = LL_USART_HWCONTROL_NONE,
+		.OverSampling = LL_USART_OVERSAMPLING_16,
+	};
+
+	if (LL_USART_Init(USART1, &init) != SUCCESS) {
+		return -1;
+	}
+	return usart1_check_config(1);
+}
+
+static int ll_usart_init_const(void)
+{
+	LL_USART_ConstInit(USART1, &usart1_config);
+	return usart1_check_config(0);
+}
+
+/* SPI --------------------------------------------------------------------------*/
+
+static const SPI_ConstInitTypeDef spi1_config =
+	SPI_CONST_INIT(SPI_MODE_MASTER, SPI_DIRECTION_2LINES, SPI_DATASIZE_8BIT, SPI_POLARITY_LOW,
+		       SPI_PHASE_1EDGE, SPI_NSS_SOFT, SPI_BAUDRATEPRESCALER_8, SPI_FIRSTBIT_MSB,
+		       SPI_NSS_PULSE_DISABLE);
+
+/* SPI1 configuration registers after the last init benchmark */
+static uint32_t spi1_regs[2];
+
+static int spi1_check_config(int first)
+{
+	const uint32_t regs[2] = {
+		regmodel_read(SPI1_BASE + offsetof(SPI_TypeDef, CR1)),
+		regmodel_read(SPI1_BASE + offsetof(SPI_TypeDef, CR2)),
+	};
+
+	if (first) {
+		memcpy(spi1_regs, regs, sizeof(regs));
+		return 0;
+	}
+	return (memcmp(spi1_regs, regs, sizeof(regs)) == 0) ? 0 : -1;
+}
+
+static int spi_init_setup(void)
+{
+	__HAL_RCC_SPI1_CLK_ENABLE();
+
+	memset(&hspi1, 0, sizeof(hspi1));
+	hspi1.Instance = SPI1;
+	hspi1.Init.Mode = SPI_MODE_MASTER;
+	hspi1.Init.Direction = SPI_DIRECTION_2LINES;
+	hspi1.Init.DataSize = SPI_DATASIZE_8BIT;
+	hspi1.Init.CLKPolarity = SPI_POLARITY_LOW;
+	hspi1.Init.CLKPhase = SPI_PHASE_1EDGE;
+	hspi1.Init.NSS = SPI_NSS_SOFT;
+	hspi1.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_8;
+	hspi1.Init.FirstBit = SPI_FIRSTBIT_MSB;
+	hspi1.Init.TIMode = SPI_TIMODE_DISABLE;
+	hspi1.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+	hspi1.Init.CRCPolynomial = 7U;
+	hspi1.Init.CRCLength = SPI_CRC_LENGTH_DATASIZE;
+	hspi1.Init.NSSPMode = SPI_NSS_PULSE_DISABLE;
+	return 0;
+}
+
+static int spi_init(void)
+{
+	if (HAL_SPI_Init(&hspi1) != HAL_OK) {
+		return -1;
+	}
+	return spi1_check_config(1);
+}
+
+static int spi_init_const(void)
+{
+	if (HAL_SPIEx_InitConst(&hspi1, &spi1_config) != HAL_OK) {
+		return -1;
+	}
+	return spi1_check_config(0);
+}
+
+static int spi_setup(void)
+{
+	__HAL_RCC_SPI1_CLK_ENABLE();
+	HAL_NVIC_EnableIRQ(SPI1_IRQn);
+
+	hspi1.Instance = SPI1;
+	hspi1.Init.Mode = SPI_MODE_MASTER;
+	hspi1.Init.Direction = SPI_DIRECTION_2LINES;
+	hspi1.Init.DataSize = SPI_DATASIZE_8BIT;
+	hspi1.Init.CLKPolarity = SPI_POLARITY_LOW;
+	hspi1.Init.CLKPhase = SPI_PHASE_1EDGE;
+	hspi1.Init.NSS = SPI_NSS_SOFT;
+	hspi1.Init.BaudRatePrescaler = SPI_BAUDRATEPRESCALER_8;
+	hspi1.Init.FirstBit = SPI_FIRSTBIT_MSB;
+	hspi1.Init.TIMode = SPI_TIMODE_DISABLE;
+	hspi1.Init.CRCCalculation = SPI_CRCCALCULATION_DISABLE;
+	hspi1.Init.CRCPolynomial = 7U;
+	hspi1.Init.CRCLength = SPI_CRC_LENGTH_DATASIZE;
+	hspi1.Init.NSSPMode = SPI_NSS_PULSE_DISABLE;
+	return (HAL_SPI_Init(&hspi1) == HAL_OK) ? 0 : -1;
+}
+
+static int spi_transmit(void)
+{
+	return (HAL_SPI_Transmit(&hspi1, bytes_src, 32U, HAL_MAX_DELAY) == HAL_OK) ? 0 : -1;
+}
+
+static int spi_transmit_receive(void)
+{
+	if (HAL_SPI_TransmitReceive(&hspi1, bytes_src, bytes_dst, 32U, HAL_MAX_DELAY) != HAL_OK) {
+		return -1;
+	}
+	return (memcmp(bytes_dst, bytes_src, 32U) == 0) ? 0 : -1;
+}
+
+static int spi_transmit_receive_it(void)
+{
+	if (HAL_SPI_TransmitReceive_IT(&hspi1, bytes_src, bytes_dst, 32U) != HAL_OK) {
+		return -1;
+	}
+	wait_done();
+	return (memcmp(bytes_dst, bytes_src, 32U) == 0) ? 0 : -1;
+}
+
+/* I2C ---------------------------------------------------------------------------*/
+
+static int i2c_setup(void)
+{
+	__HAL_RCC_I2C1_CLK_ENABLE();
+
+	hi2c1.Instance = I2C1;
+	hi2c1.Init.Timing = 0x10802D9BU;
+	hi2c1.Init.OwnAddress1 = 0U;
+	hi2c1.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+	hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+	hi2c1.Init.OwnAddress2 = 0U;
+	hi2c1.Init.OwnAddress2Masks = I2C_OA2_NOMASK;
+	hi2c1.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+	hi2c1.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+	return (HAL_I2C_Init(&hi2c1) == HAL_OK) ? 0 : -1;
+}
+
+static int i2c_master_transmit(void)
+{
+	return (HAL_I2C_Master_Transmit(&hi2c1, 0xA0U, bytes_src, 16U, HAL_MAX_DELAY) == HAL_OK) ?
+		0 : -1;
+}
+
+static int i2c_mem_write(void)
+{
+	return (HAL_I2C_Mem_Write(&hi2c1, 0xA0U, 0x40U, I2C_MEMADD_SIZE_8BIT, bytes_src, 16U,
+				  HAL_MAX_DELAY) == HAL_OK) ? 0 : -1;
+}
+
+static int i2c_mem_read(void)
+{
+	if (HAL_I2C_Mem_Read(&hi2c1, 0xA0U, 0x40U, I2C_MEMADD_SIZE_8BIT, bytes_dst, 16U,
+			     HAL_MAX_DELAY) != HAL_OK) {
+		return -1;
+	}
+	return (memcmp(bytes_dst, bytes_src, 16U) == 0) ? 0 : -1;
+}
+
+/* CRC ---------------------------------------------------------------------------*/
+
+static int crc_setup(uint32_t format)
+{
+	__HAL_RCC_CRC_CLK_ENABLE();
+
+	hcrc.Instance = CRC;
+	hcrc.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+	hcrc.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_ENABLE;
+	hcrc.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
+	hcrc.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+	hcrc.InputDataFormat = format;
+	return (HAL_CRC_Init(&hcrc) == HAL_OK) ? 0 : -1;
+}
+
+static int crc_words_setup(void)
+{
+	return crc_setup(CRC_INPUTDATA_FORMAT_WORDS);
+}
+
+static int crc_bytes_setup(void)
+{
+	return crc_setup(CRC_INPUTDATA_FORMAT_BYTES);
+}
+
+static int crc_words(void)
+{
+	uint8_t stream[sizeof(words_src)];
+
+	/* The unit takes the words MSB first */
+	for (uint32_t i = 0U; i < 256U; i++) {
+		stream[(4U * i) + 0U] = (uint8_t)(words_src[i] >> 24);
+		stream[(4U * i) + 1U] = (uint8_t)(words_src[i] >> 16);
+		stream[(4U * i) + 2U] = (uint8_t)(words_src[i] >> 8);
+		stream[(4U * i) + 3U] = (uint8_t)words_src[i];
+	}
+	return (HAL_CRC_Calculate(&hcrc, words_src, 256U) == crc32_mpeg2(stream, sizeof(stream))) ?
+		0 : -1;
+}
+
+static int crc_bytes(void)
+{
+	return (HAL_CRC_Calculate(&hcrc, (uint32_t *)bytes_src, sizeof(bytes_src)) ==
+		crc32_mpeg2(bytes_src, sizeof(bytes_src))) ? 0 : -1;
+}
+
+/* DMA ---------------------------------------------------------------------------*/
+
+static int dma_setup(void)
+{
+	__HAL_RCC_DMAMUX1_CLK_ENABLE();
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+	hdma.Instance = DMA1_Channel1;
+	hdma.Init.Request = DMA_REQUEST_MEM2MEM;
+	hdma.Init.Direction = DMA_MEMORY_TO_MEMORY;
+	hdma.Init.PeriphInc = DMA_PINC_ENABLE;
+	hdma.Init.MemInc = DMA_MINC_ENABLE;
+	hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+	hdma.Init.Mode = DMA_NORMAL;
+	hdma.Init.Priority = DMA_PRIORITY_HIGH;
+	if (HAL_DMA_Init(&hdma) != HAL_OK) {
+		return -1;
+	}
+	hdma.XferCpltCallback = dma_complete;
+	return 0;
+}
+
+static int dma_m2m_it(void)
+{
+	if (HAL_DMA_Start_IT(&hdma, (uint32_t)words_src, (uint32_t)words_dst, 256U) != HAL_OK) {
+		return -1;
+	}
+	wait_done();
+	return (memcmp(words_dst, words_src, sizeof(words_src)) == 0) ? 0 : -1;
+}
+
+static int dma_m2m_poll(void)
+{
+	if ((HAL_DMA_Start(&hdma, (uint32_t)words_src, (uint32_t)words_dst, 256U) != HAL_OK) ||
+	    (HAL_DMA_PollForTransfer(&hdma, HAL_DMA_FULL_TRANSFER, HAL_MAX_DELAY) != HAL_OK)) {
+		return -1;
+	}
+	return (memcmp(words_dst, words_src, sizeof(words_src)) == 0) ? 0 : -1;
+}
+
+/* FDCAN -------------------------------------------------------------------------*/
+
+/* Elements of an Rx FIFO */
+#define FDCAN_RX_FIFO_DEPTH  3U
+
+static int fdcan_setup(void)
+{
+	__HAL_RCC_FDCAN_CLK_ENABLE();
+
+	hfdcan1.Instance = FDCAN1;
+	hfdcan1.Init.ClockDivider = FDCAN_CLOCK_DIV1;
+	hfdcan1.Init.FrameFormat = FDCAN_FRAME_CLASSIC;
+	hfdcan1.Init.Mode = FDCAN_MODE_INTERNAL_LOOPBACK;
+	hfdcan1.Init.AutoRetransmission = DISABLE;
+	hfdcan1.Init.TransmitPause = DISABLE;
+	hfdcan1.Init.ProtocolException = DISABLE;
+	hfdcan1.Init.NominalPrescaler = 1U;
+	hfdcan1.Init.NominalSyncJumpWidth = 1U;
+	hfdcan1.Init.NominalTimeSeg1 = 13U;
+	hfdcan1.Init.NominalTimeSeg2 = 2U;
+	hfdcan1.Init.DataPrescaler = 1U;
+	hfdcan1.Init.DataSyncJumpWidth = 1U;
+	hfdcan1.Init.DataTimeSeg1 = 1U;
+	hfdcan1.Init.DataTimeSeg2 = 1U;
+	hfdcan1.Init.StdFiltersNbr = 0U;
+	hfdcan1.Init.ExtFiltersNbr = 0U;
+	hfdcan1.Init.TxFifoQueueMode = FDCAN_TX_FIFO_OPERATION;
+	if ((HAL_FDCAN_Init(&hfdcan1) != HAL_OK) || (HAL_FDCAN_Start(&hfdcan1) != HAL_OK)) {
+		return -1;
+	}
+	return 0;
+}
+
+static int fdcan_add_message(void)
+{
+	FDCAN_TxHeaderTypeDef header = {
+		.Identifier = 0x123U,
+		.IdType = FDCAN_STANDARD_ID,
+		.TxFrameType = FDCAN_DATA_FRAME,
+		.DataLength = FDCAN_DLC_BYTES_8,
+		.ErrorStateIndicator = FDCAN_ESI_ACTIVE,
+		.BitRateSwitch = FDCAN_BRS_OFF,
+		.FDFormat = FDCAN_CLASSIC_CAN,
+		.TxEventFifoControl = FDCAN_NO_TX_EVENTS,
+		.MessageMarker = 0U,
+	};
+
+	return (HAL_FDCAN_AddMessageToTxFifoQ(&hfdcan1, &header, bytes_src) == HAL_OK) ? 0 : -1;
+}
+
+static int fdcan_get_message(void)
+{
+	FDCAN_RxHeaderTypeDef header;
+
+	if (HAL_FDCAN_GetRxMessage(&hfdcan1, FDCAN_RX_FIFO0, &header, bytes_dst) != HAL_OK) {
+		return -1;
+	}
+	return ((header.Identifier == 0x123U) && (header.DataLength == FDCAN_DLC_BYTES_8) &&
+		(memcmp(bytes_dst, bytes_src, 8U) == 0)) ? 0 : -1;
+}
+
+/* Rx FIFO 0 full: the frames a per-frame and a bulk read drain */
+static int fdcan_rx_fifo_setup(void)
+{
+	for (uint32_t i = 0U; i < FDCAN_RX_FIFO_DEPTH; i++) {
+		if (fdcan_add_message() != 0) {
+			return -1;
+		}
+	}
+	return ((FDCAN1->RXF0S & FDCAN_RXF0S_F0FL) == FDCAN_RX_FIFO_DEPTH) ? 0 : -1;
+}
+
+static int fdcan_get_message_x3(void)
+{
+	for (uint32_t i = 0U; i < FDCAN_RX_FIFO_DEPTH; i++) {
+		if (fdcan_get_message() != 0) {
+			return -1;
+		}
+	}
+	return ((FDCAN1->RXF0S & FDCAN_RXF0S_F0FL) == 0U) ? 0 : -1;
+}
+
+static int fdcan_get_messages_3(void)
+{
+	FDCAN_RxHeaderTypeDef headers[FDCAN_RX_FIFO_DEPTH];
+	uint8_t data[FDCAN_RX_FIFO_DEPTH][8];
+	uint32_t frames;
+
+	if ((HAL_FDCANEx_GetRxMessages(&hfdcan1, FDCAN_RX_FIFO0, headers, &data[0][0], sizeof(data[0]),
+				       FDCAN_RX_FIFO_DEPTH, &frames) != HAL_OK) ||
+	    (frames != FDCAN_RX_FIFO_DEPTH)) {
+		return -1;
+	}
+	for (uint32_t i = 0U; i < FDCAN_RX_FIFO_DEPTH; i++) {
+		if ((headers[i].Identifier != 0x123U) || (headers[i].DataLength != FDCAN_DLC_BYTES_8) ||
+		    (memcmp(data[i], bytes_src, 8U) != 0)) {
+			return -1;
+		}
+	}
+	return ((FDCAN1->RXF0S & FDCAN_RXF0S_F0FL) == 0U) ? 0 : -1;
+}
+
+/* Harness -----------------------------------------------------------------------*/
+
+static const struct bench benches[] = {
+	{ "uart.init", uart_init_setup, uart_init },
+	{ "uart.init_const", uart_init_setup, uart_init_const },
+	{ "uart.transmit_64", uart_setup, uart_transmit },
+	{ "uart.transmit_it_16", NULL, uart_transmit_it },
+	{ "uart.receive_16", uart_receive_setup, uart_receive },
+	{ "ll_usart.init", ll_usart_init_setup, ll_usart_init },
+	{ "ll_usart.init_const", ll_usart_init_setup, ll_usart_init_const },
+	{ "spi.init", spi_init_setup, spi_init },
+	{ "spi.init_const", spi_init_setup, spi_init_const },
+	{ "spi.transmit_32", spi_setup, spi_transmit },
+	{ "spi.transmit_receive_32", NULL, spi_transmit_receive },
+	{ "spi.transmit_receive_it_32", NULL, spi_transmit_receive_it },
+	{ "i2c.master_transmit_16", i2c_setup, i2c_master_transmit },
+	{ "i2c.mem_write_16", NULL, i2c_mem_write },
+	{ "i2c.mem_read_16", NULL, i2c_mem_read },
+	{ "crc.calculate_words_256", crc_words_setup, crc_words },
+	{ "crc.calculate_bytes_67", crc_bytes_setup, crc_bytes },
+	{ "dma.m2m_it_256", dma_setup, dma_m2m_it },
+	{ "dma.m2m_poll_256", NULL, dma_m2m_poll },
+	{ "fdcan.add_message_8", fdcan_setup, fdcan_add_message },
+	{ "fdcan.get_message_8", NULL, fdcan_get_message },
+	{ "fdcan.get_message_x3", fdcan_rx_fifo_setup, fdcan_get_message_x3 },
+	{ "fdcan.get_messages_3", fdcan_rx_fifo_setup, fdcan_get_messages_3 },
+};
+
+#define BENCHES_NBR  (sizeof(benches) / sizeof(benches[0]))
+
+static void report(FILE *out, const struct result *results)
+{
+	fprintf(out, "{\n  \"series\": \"%s\",\n  \"device\": \"%s\",\n  \"benchmarks\": {\n",
+		BENCH_SERIES, BENCH_DEVICE);
+	for (size_t i = 0U; i < BENCHES_NBR; i++) {
+		const struct regmodel_stats *s = &results[i].stats;
+
+		fprintf(out,
+			"    \"%s\": {\"reads\": %llu, \"writes\": %llu, \"polls\": %llu, "
+			"\"irqs\": %llu, \"events\": %llu}%s\n",
+			results[i].name, (unsigned long long)s->reads,
+			(unsigned long long)s->writes, (unsigned long long)s->polls,
+			(unsigned long long)s->exceptions, (unsigned long long)s->events,
+			(i + 1U < BENCHES_NBR) ? "," : "");
+	}
+	fprintf(out, "  }\n}\n");
+}
+
+int main(int argc, char *argv[])
+{
+	static struct result results[BENCHES_NBR];
+	const char *output = NULL;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "o:")) != -1) {
+		if (opt == 'o') {
+			output = optarg;
+		} else {
+			fprintf(stderr, "usage: %s [-o report.json]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	/* A driver waiting for a flag no model sets would spin forever */
+	alarm(BENCH_TIMEOUT_S);
+
+	if (regmodel_init() != 0) {
+		return 1;
+	}
+	regmodel_irq_connect(USART1_IRQn, usart1_isr);
+	regmodel_irq_connect(SPI1_IRQn, spi1_isr);
+	regmodel_irq_connect(DMA1_Channel1_IRQn, dma1_channel1_isr);
+
+	if (HAL_Init() != HAL_OK) {
+		return 1;
+	}
+	HAL_SuspendTick();
+	regmodel_set_lockstep(1);
+
+	for (size_t i = 0U; i < BENCHES_NBR; i++) {
+		fill();
+		if ((benches[i].setup != NULL) && (benches[i].setup() != 0)) {
+			fprintf(stderr, "%s: setup failed\n", benches[i].name);
+			return 1;
+		}
+
+		regmodel_stats_reset();
+		if (benches[i].run() != 0) {
+			fprintf(stderr, "%s: failed\n", benches[i].name);
+			return 1;
+		}
+		results[i].name = benches[i].name;
+		regmodel_stats_get(&results[i].stats);
+	}
+
+	if (output != NULL) {
+		FILE *out = fopen(output, "w");
+
+		if (out == NULL) {
+			perror(output);
+			return 1;
+		}
+		report(out, results);
+		fclose(out);
+	} else {
+		report(stdout, results);
+	}
+	return 0;
+}
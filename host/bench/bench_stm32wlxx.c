@@ -0,0 +1,581 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Sub-GHz radio and AES benchmarks of the STM32WL HAL: register reads and
+ * writes, polling iterations, interrupts and hardware events per radio
+ * reconfiguration, buffer transfer and encryption, counted by the register
+ * model.
+ *
+ * The radio model keeps BUSY high for a fixed number of register accesses
+ * after each command, and the AES model computes a block in a fixed number
+ * of accesses, so the polls count the time a driver spends waiting for the
+ * hardware, while the interrupt driven operations sleep instead.
+ *
+ * The model runs in lockstep with the SysTick interrupt stopped, so the
+ * counts only depend on the driver code and the report is stable. Each
+ * benchmark checks the bytes the radio received or the ciphertext against
+ * the NIST SP 800-38A vectors, the report is only written when all pass.
+ *
+ * Usage: host_bench [-o report.json]
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "stm32wlxx_hal.h"
+#include "regmodel.h"
+#include "regmodel_stm32wlxx.h"
+
+#define BENCH_TIMEOUT_S  30U
+
+struct bench {
+	const char *name;
+	int (*setup)(void);
+	int (*run)(void);
+};
+
+struct result {
+	const char *name;
+	struct regmodel_stats stats;
+};
+
+static SUBGHZ_HandleTypeDef hsubghz;
+static SUBGHZEx_XferTypeDef hxfer;
+static DMA_HandleTypeDef hdma_tx;
+static DMA_HandleTypeDef hdma_rx;
+static CRYP_HandleTypeDef hcryp;
+static volatile int done;
+
+/* DMA addresses are 32-bit, the buffers are static */
+static uint8_t bytes_src[255];
+static uint8_t bytes_dst[255];
+static uint8_t captured[512];
+
+static void subghz_radio_isr(void)
+{
+	HAL_SUBGHZEx_BusyIRQHandler(&hxfer);
+}
+
+static void dma1_channel1_isr(void)
+{
+	HAL_DMA_IRQHandler(&hdma_tx);
+}
+
+static void dma1_channel2_isr(void)
+{
+	HAL_DMA_IRQHandler(&hdma_rx);
+}
+
+static void aes_isr(void)
+{
+	HAL_CRYP_IRQHandler(&hcryp);
+}
+
+void HAL_CRYP_OutCpltCallback(CRYP_HandleTypeDef *phcryp)
+{
+	done = 1;
+}
+
+static void xfer_complete(SUBGHZEx_XferTypeDef *phxfer)
+{
+	done = 1;
+}
+
+static void wait_done(void)
+{
+	while (done == 0) {
+		__WFI();
+	}
+	done = 0;
+}
+
+static void fill(void)
+{
+	for (uint32_t i = 0U; i < sizeof(bytes_src); i++) {
+		bytes_src[i] = (uint8_t)(0x30U + i);
+	}
+	memset(bytes_dst, 0, sizeof(bytes_dst));
+}
+
+/* Frequency hop ---------------------------------------------------------------------*/
+
+/*
+ * Reconfiguration of a LoRa receiver for the next channel: standby, frequency,
+ * modulation and packet parameters, sync word, then back to receive.
+ */
+struct hop_command {
+	uint8_t opcode;
+	uint16_t address;
+	uint8_t size;
+	uint8_t params[8];
+};
+
+#define HOP_WRITE_REGISTERS  0x0DU
+#define HOP_SYNC_WORD        0x0740U
+
+static const struct hop_command hop[] = {
+	{ RADIO_SET_STANDBY, 0U, 1U, { 0x00 } },
+	{ RADIO_SET_RFFREQUENCY, 0U, 4U, { 0x36, 0x41, 0x99, 0x9A } },
+	{ RADIO_SET_MODULATIONPARAMS, 0U, 4U, { 0x07, 0x04, 0x01, 0x00 } },
+	{ RADIO_SET_PACKETPARAMS, 0U, 6U, { 0x00, 0x08, 0x00, 0x40, 0x01, 0x00 } },
+	{ HOP_WRITE_REGISTERS, HOP_SYNC_WORD, 2U, { 0x34, 0x44 } },
+	{ RADIO_SET_RX, 0U, 3U, { 0xFF, 0xFF, 0xFF } },
+};
+
+#define HOP_COMMANDS_NBR  (sizeof(hop) / sizeof(hop[0]))
+
+static SUBGHZEx_BatchTypeDef hop_batch;
+static uint8_t hop_storage[64];
+
+/* Bytes the radio receives for the hop */
+static size_t hop_expected(uint8_t *data)
+{
+	size_t len = 0U;
+
+	for (size_t i = 0U; i < HOP_COMMANDS_NBR; i++) {
+		data[len++] = hop[i].opcode;
+		if (hop[i].opcode == HOP_WRITE_REGISTERS) {
+			data[len++] = (uint8_t)(hop[i].address >> 8);
+			data[len++] = (uint8_t)hop[i].address;
+		}
+		memcpy(&data[len], hop[i].params, hop[i].size);
+		len += hop[i].size;
+	}
+	return len;
+}
+
+static int radio_check(const uint8_t *expected, size_t len)
+{
+	size_t count = regmodel_radio_capture(captured, sizeof(captured));
+
+	return ((count == len) && (memcmp(captured, expected, len) == 0) &&
+		(regmodel_radio_busy_errors() == 0U)) ? 0 : -1;
+}
+
+static int hop_check(void)
+{
+	uint8_t expected[64];
+
+	return radio_check(expected, hop_expected(expected));
+}
+
+/* Radio in standby, idle, with nothing captured */
+static int radio_idle(void)
+{
+	uint8_t standby = 0x00U;
+
+	if (HAL_SUBGHZ_ExecSetCmd(&hsubghz, RADIO_SET_STANDBY, &standby, 1U) != HAL_OK) {
+		return -1;
+	}
+	(void)regmodel_radio_capture(captured, sizeof(captured));
+	(void)regmodel_radio_busy_errors();
+	return 0;
+}
+
+static int subghz_init_setup(void)
+{
+	__HAL_RCC_SUBGHZSPI_CLK_ENABLE();
+	__HAL_RCC_DMAMUX1_CLK_ENABLE();
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	HAL_NVIC_EnableIRQ(SUBGHZ_Radio_IRQn);
+	HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+	HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+
+	memset(&hsubghz, 0, sizeof(hsubghz));
+	hsubghz.Init.BaudratePrescaler = SUBGHZSPI_BAUDRATEPRESCALER_8;
+	return 0;
+}
+
+static int subghz_init(void)
+{
+	return (HAL_SUBGHZ_Init(&hsubghz) == HAL_OK) ? 0 : -1;
+}
+
+static int hop_set_cmd(void)
+{
+	for (size_t i = 0U; i < HOP_COMMANDS_NBR; i++) {
+		HAL_StatusTypeDef status;
+
+		if (hop[i].opcode == HOP_WRITE_REGISTERS) {
+			status = HAL_SUBGHZ_WriteRegisters(&hsubghz, hop[i].address,
+							   (uint8_t *)hop[i].params, hop[i].size);
+		} else {
+			status = HAL_SUBGHZ_ExecSetCmd(&hsubghz, (SUBGHZ_RadioSetCmd_t)hop[i].opcode,
+						       (uint8_t *)hop[i].params, hop[i].size);
+		}
+		if (status != HAL_OK) {
+			return -1;
+		}
+	}
+	return hop_check();
+}
+
+static int hop_batch_setup(void)
+{
+	if (HAL_SUBGHZEx_BatchInit(&hop_batch, hop_storage, sizeof(hop_storage)) != HAL_OK) {
+		return -1;
+	}
+	for (size_t i = 0U; i < HOP_COMMANDS_NBR; i++) {
+		HAL_StatusTypeDef status;
+
+		if (hop[i].opcode == HOP_WRITE_REGISTERS) {
+			status = HAL_SUBGHZEx_BatchAddWriteRegisters(&hop_batch, hop[i].address,
+								     hop[i].params, hop[i].size);
+		} else {
+			status = HAL_SUBGHZEx_BatchAddSetCmd(&hop_batch,
+							     (SUBGHZ_RadioSetCmd_t)hop[i].opcode,
+							     hop[i].params, hop[i].size);
+		}
+		if (status != HAL_OK) {
+			return -1;
+		}
+	}
+	return radio_idle();
+}
+
+static int hop_exec_batch(void)
+{
+	if (HAL_SUBGHZEx_ExecBatch(&hsubghz, &hop_batch) != HAL_OK) {
+		return -1;
+	}
+	return hop_check();
+}
+
+static int xfer_setup(void)
+{
+	hdma_tx.Instance = DMA1_Channel1;
+	hdma_tx.Init.Request = DMA_REQUEST_SUBGHZSPI_TX;
+	hdma_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdma_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma_tx.Init.MemInc = DMA_MINC_ENABLE;
+	hdma_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdma_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdma_tx.Init.Mode = DMA_NORMAL;
+	hdma_tx.Init.Priority = DMA_PRIORITY_HIGH;
+
+	hdma_rx.Instance = DMA1_Channel2;
+	hdma_rx.Init = hdma_tx.Init;
+	hdma_rx.Init.Request = DMA_REQUEST_SUBGHZSPI_RX;
+	hdma_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+
+	if ((HAL_DMA_Init(&hdma_tx) != HAL_OK) || (HAL_DMA_Init(&hdma_rx) != HAL_OK) ||
+	    (HAL_SUBGHZEx_XferInit(&hxfer, &hsubghz, &hdma_tx, &hdma_rx) != HAL_OK)) {
+		return -1;
+	}
+	hxfer.XferCpltCallback = xfer_complete;
+	return radio_idle();
+}
+
+static int hop_exec_batch_it(void)
+{
+	if (HAL_SUBGHZEx_ExecBatch_IT(&hxfer, &hop_batch) != HAL_OK) {
+		return -1;
+	}
+	wait_done();
+	return hop_check();
+}
+
+/* Buffer transfers --------------------------------------------------------------------*/
+
+static int buffer_write_check(void)
+{
+	uint8_t expected[2U + sizeof(bytes_src)] = { SUBGHZ_RADIO_WRITE_BUFFER, 0x00U };
+
+	memcpy(&expected[2], bytes_src, sizeof(bytes_src));
+	if (memcmp(regmodel_radio_buffer(), bytes_src, sizeof(bytes_src)) != 0) {
+		return -1;
+	}
+	return radio_check(expected, sizeof(expected));
+}
+
+static int buffer_read_setup(void)
+{
+	memcpy(regmodel_radio_buffer(), bytes_src, sizeof(bytes_src));
+	return radio_idle();
+}
+
+static int buffer_read_check(void)
+{
+	/* Opcode, offset and status byte, then dummy bytes */
+	if (regmodel_radio_capture(captured, sizeof(captured)) != (3U + sizeof(bytes_dst))) {
+		return -1;
+	}
+	return ((memcmp(bytes_dst, bytes_src, sizeof(bytes_dst)) == 0) &&
+		(regmodel_radio_busy_errors() == 0U)) ? 0 : -1;
+}
+
+static int write_buffer(void)
+{
+	if (HAL_SUBGHZ_WriteBuffer(&hsubghz, 0x00U, bytes_src, sizeof(bytes_src)) != HAL_OK) {
+		return -1;
+	}
+	return buffer_write_check();
+}
+
+static int write_buffer_dma(void)
+{
+	if (HAL_SUBGHZEx_WriteBuffer_DMA(&hxfer, 0x00U, bytes_src, sizeof(bytes_src)) != HAL_OK) {
+		return -1;
+	}
+	wait_done();
+	return buffer_write_check();
+}
+
+static int read_buffer(void)
+{
+	if (HAL_SUBGHZ_ReadBuffer(&hsubghz, 0x00U, bytes_dst, sizeof(bytes_dst)) != HAL_OK) {
+		return -1;
+	}
+	return buffer_read_check();
+}
+
+static int read_buffer_dma(void)
+{
+	if (HAL_SUBGHZEx_ReadBuffer_DMA(&hxfer, 0x00U, bytes_dst, sizeof(bytes_dst)) != HAL_OK) {
+		return -1;
+	}
+	wait_done();
+	return buffer_read_check();
+}
+
+/* AES ----------------------------------------------------------------------------------*/
+
+/* NIST SP 800-38A F.1.1, F.2.1 and F.2.5, most significant word first */
+static uint32_t aes_key128[4] = { 0x2B7E1516U, 0x28AED2A6U, 0xABF71588U, 0x09CF4F3CU };
+static uint32_t aes_key256[8] = {
+	0x603DEB10U, 0x15CA71BEU, 0x2B73AEF0U, 0x857D7781U,
+	0x1F352C07U, 0x3B6108D7U, 0x2D9810A3U, 0x0914DFF4U,
+};
+static uint32_t aes_iv[4] = { 0x00010203U, 0x04050607U, 0x08090A0BU, 0x0C0D0E0FU };
+static uint32_t aes_plain[16] = {
+	0x6BC1BEE2U, 0x2E409F96U, 0xE93D7E11U, 0x7393172AU,
+	0xAE2D8A57U, 0x1E03AC9CU, 0x9EB76FACU, 0x45AF8E51U,
+	0x30C81C46U, 0xA35CE411U, 0xE5FBC119U, 0x1A0A52EFU,
+	0xF69F2445U, 0xDF4F9B17U, 0xAD2B417BU, 0xE66C3710U,
+};
+static const uint32_t aes128_ecb[16] = {
+	0x3AD77BB4U, 0x0D7A3660U, 0xA89ECAF3U, 0x2466EF97U,
+	0xF5D3D585U, 0x03B9699DU, 0xE785895AU, 0x96FDBAAFU,
+	0x43B1CD7FU, 0x598ECE23U, 0x881B00E3U, 0xED030688U,
+	0x7B0C785EU, 0x27E8AD3FU, 0x82232071U, 0x04725DD4U,
+};
+static const uint32_t aes128_cbc[16] = {
+	0x7649ABACU, 0x8119B246U, 0xCEE98E9BU, 0x12E9197DU,
+	0x5086CB9BU, 0x507219EEU, 0x95DB113AU, 0x917678B2U,
+	0x73BED6B8U, 0xE3C1743BU, 0x7116E69EU, 0x22229516U,
+	0x3FF1CAA1U, 0x681FAC09U, 0x120ECA30U, 0x7586E1A7U,
+};
+static const uint32_t aes256_cbc[16] = {
+	0xF58C4C04U, 0xD6E5F1BAU, 0x779EABFBU, 0x5F7BFBD6U,
+	0x9CFC4E96U, 0x7EDB808DU, 0x679F777BU, 0xC6702C7DU,
+	0x39F23369U, 0xA9D9BACFU, 0xA530E263U, 0x04231461U,
+	0xB2EB05E2U, 0xC39BE9FCU, 0xDA6C1907U, 0x8C6A9D1BU,
+};
+static uint32_t aes_cipher[16];
+
+#define AES_WORDS  (sizeof(aes_plain) / sizeof(aes_plain[0]))
+
+static int cryp_config(uint32_t algorithm, uint32_t key_size, uint32_t *key)
+{
+	CRYP_ConfigTypeDef config = {
+		.DataType = CRYP_DATATYPE_32B,
+		.KeySize = key_size,
+		.pKey = key,
+		.pInitVect = aes_iv,
+		.Algorithm = algorithm,
+		.DataWidthUnit = CRYP_DATAWIDTHUNIT_WORD,
+		.KeyIVConfigSkip = CRYP_KEYIVCONFIG_ALWAYS,
+	};
+
+	memset(aes_cipher, 0, sizeof(aes_cipher));
+	return (HAL_CRYP_SetConfig(&hcryp, &config) == HAL_OK) ? 0 : -1;
+}
+
+static int cryp_check(const uint32_t *expected)
+{
+	return ((memcmp(aes_cipher, expected, sizeof(aes_cipher)) == 0) &&
+		(hcryp.ErrorCode == HAL_CRYP_ERROR_NONE) &&
+		((hcryp.Instance->SR & (AES_SR_RDERR | AES_SR_WRERR)) == 0U)) ? 0 : -1;
+}
+
+static int cryp_init_setup(void)
+{
+	__HAL_RCC_AES_CLK_ENABLE();
+	HAL_NVIC_EnableIRQ(AES_IRQn);
+
+	memset(&hcryp, 0, sizeof(hcryp));
+	hcryp.Instance = AES;
+	hcryp.Init.DataType = CRYP_DATATYPE_32B;
+	hcryp.Init.KeySize = CRYP_KEYSIZE_128B;
+	hcryp.Init.pKey = aes_key128;
+	hcryp.Init.Algorithm = CRYP_AES_ECB;
+	hcryp.Init.DataWidthUnit = CRYP_DATAWIDTHUNIT_WORD;
+	hcryp.Init.KeyIVConfigSkip = CRYP_KEYIVCONFIG_ALWAYS;
+	return 0;
+}
+
+static int cryp_init(void)
+{
+	return (HAL_CRYP_Init(&hcryp) == HAL_OK) ? 0 : -1;
+}
+
+static int aes128_ecb_setup(void)
+{
+	return cryp_config(CRYP_AES_ECB, CRYP_KEYSIZE_128B, aes_key128);
+}
+
+static int aes128_cbc_setup(void)
+{
+	return cryp_config(CRYP_AES_CBC, CRYP_KEYSIZE_128B, aes_key128);
+}
+
+static int aes256_cbc_setup(void)
+{
+	return cryp_config(CRYP_AES_CBC, CRYP_KEYSIZE_256B, aes_key256);
+}
+
+static int aes_encrypt(const uint32_t *expected)
+{
+	if (HAL_CRYP_Encrypt(&hcryp, aes_plain, AES_WORDS, aes_cipher, 1000U) != HAL_OK) {
+		return -1;
+	}
+	return cryp_check(expected);
+}
+
+static int aes_encrypt_it(const uint32_t *expected)
+{
+	if (HAL_CRYP_Encrypt_IT(&hcryp, aes_plain, AES_WORDS, aes_cipher) != HAL_OK) {
+		return -1;
+	}
+	wait_done();
+	return cryp_check(expected);
+}
+
+static int aes128_ecb_encrypt(void)
+{
+	return aes_encrypt(aes128_ecb);
+}
+
+static int aes128_ecb_encrypt_it(void)
+{
+	return aes_encrypt_it(aes128_ecb);
+}
+
+static int aes128_cbc_encrypt(void)
+{
+	return aes_encrypt(aes128_cbc);
+}
+
+static int aes128_cbc_encrypt_it(void)
+{
+	return aes_encrypt_it(aes128_cbc);
+}
+
+static int aes256_cbc_encrypt(void)
+{
+	return aes_encrypt(aes256_cbc);
+}
+
+static const struct bench benches[] = {
+	{ "subghz.init", subghz_init_setup, subghz_init },
+	{ "subghz.hop_set_cmd", radio_idle, hop_set_cmd },
+	{ "subghz.hop_exec_batch", hop_batch_setup, hop_exec_batch },
+	{ "subghz.hop_exec_batch_it", xfer_setup, hop_exec_batch_it },
+	{ "subghz.write_buffer_255", radio_idle, write_buffer },
+	{ "subghz.write_buffer_dma_255", radio_idle, write_buffer_dma },
+	{ "subghz.read_buffer_255", buffer_read_setup, read_buffer },
+	{ "subghz.read_buffer_dma_255", buffer_read_setup, read_buffer_dma },
+	{ "cryp.init", cryp_init_setup, cryp_init },
+	{ "cryp.aes128_ecb_encrypt_64", aes128_ecb_setup, aes128_ecb_encrypt },
+	{ "cryp.aes128_ecb_encrypt_it_64", aes128_ecb_setup, aes128_ecb_encrypt_it },
+	{ "cryp.aes128_cbc_encrypt_64", aes128_cbc_setup, aes128_cbc_encrypt },
+	{ "cryp.aes128_cbc_encrypt_it_64", aes128_cbc_setup, aes128_cbc_encrypt_it },
+	{ "cryp.aes256_cbc_encrypt_64", aes256_cbc_setup, aes256_cbc_encrypt },
+};
+
+#define BENCHES_NBR  (sizeof(benches) / sizeof(benches[0]))
+
+static void report(FILE *out, const struct result *results)
+{
+	fprintf(out, "{\n  \"series\": \"%s\",\n  \"device\": \"%s\",\n  \"benchmarks\": {\n",
+		BENCH_SERIES, BENCH_DEVICE);
+	for (size_t i = 0U; i < BENCHES_NBR; i++) {
+		const struct regmodel_stats *s = &results[i].stats;
+
+		fprintf(out,
+			"    \"%s\": {\"reads\": %llu, \"writes\": %llu, \"polls\": %llu, "
+			"\"irqs\": %llu, \"events\": %llu}%s\n",
+			results[i].name, (unsigned long long)s->reads,
+			(unsigned long long)s->writes, (unsigned long long)s->polls,
+			(unsigned long long)s->exceptions, (unsigned long long)s->events,
+			(i + 1U < BENCHES_NBR) ? "," : "");
+	}
+	fprintf(out, "  }\n}\n");
+}
+
+int main(int argc, char *argv[])
+{
+	static struct result results[BENCHES_NBR];
+	const char *output = NULL;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "o:")) != -1) {
+		if (opt == 'o') {
+			output = optarg;
+		} else {
+			fprintf(stderr, "usage: %s [-o report.json]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	/* A driver waiting for a flag no model sets would spin forever */
+	alarm(BENCH_TIMEOUT_S);
+
+	if (regmodel_init() != 0) {
+		return 1;
+	}
+	regmodel_irq_connect(SUBGHZ_Radio_IRQn, subghz_radio_isr);
+	regmodel_irq_connect(DMA1_Channel1_IRQn, dma1_channel1_isr);
+	regmodel_irq_connect(DMA1_Channel2_IRQn, dma1_channel2_isr);
+	regmodel_irq_connect(AES_IRQn, aes_isr);
+
+	if (HAL_Init() != HAL_OK) {
+		return 1;
+	}
+	HAL_SuspendTick();
+	regmodel_set_lockstep(1);
+
+	for (size_t i = 0U; i < BENCHES_NBR; i++) {
+		fill();
+		if ((benches[i].setup != NULL) && (benches[i].setup() != 0)) {
+			fprintf(stderr, "%s: setup failed\n", benches[i].name);
+			return 1;
+		}
+
+		regmodel_stats_reset();
+		if (benches[i].run() != 0) {
+			fprintf(stderr, "%s: failed\n", benches[i].name);
+			return 1;
+		}
+		results[i].name = benches[i].name;
+		regmodel_stats_get(&results[i].stats);
+	}
+
+	if (output != NULL) {
+		FILE *out = fopen(output, "w");
+
+		if (out == NULL) {
+			perror(output);
+			return 1;
+		}
+		report(out, results);
+		fclose(out);
+	} else {
+		report(stdout, results);
+	}
+	return 0;
+}
@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""
+Run the host driver benchmarks and compare the report with a baseline.
+
+The benchmark program counts, per driver API call, the register reads and
+writes, the polling iterations, the interrupts and the hardware events, with
+the register model in lockstep so the counts are reproducible. A count above
+the baseline (beyond ``--tolerance`` percent) is a regression and fails the
+check. A count below the baseline is reported as an improvement; refresh the
+baseline with ``--update`` and commit it with the driver change::
+
+    check_bench.py --bench build/host_bench --baseline bench/baselines/stm32g4xx.json \\
+        --report build/bench_stm32g4xx.json
+    check_bench.py ... --update
+
+A benchmark added to or removed from the program also requires ``--update``.
+"""
+
+import argparse
+import json
+import pathlib
+import subprocess
+import sys
+
+METRICS = ("reads", "writes", "polls", "irqs", "events")
+
+
+def run_bench(bench, report):
+    """Run the benchmark program and load the report it writes."""
+    subprocess.run([str(bench), "-o", str(report)], check=True)
+    return json.loads(report.read_text())
+
+
+def compare(baseline, current, tolerance):
+    """Compare two reports, return the regression and improvement messages."""
+    regressions = []
+    improvements = []
+
+    expected = baseline["benchmarks"]
+    measured = current["benchmarks"]
+
+    for name in sorted(set(expected) - set(measured)):
+        regressions.append(f"{name}: missing from the report")
+    for name in sorted(set(measured) - set(expected)):
+        regressions.append(f"{name}: not in the baseline")
+
+    for name in sorted(set(expected) & set(measured)):
+        for metric in METRICS:
+            old = expected[name].get(metric, 0)
+            new = measured[name].get(metric, 0)
+            if new > old * (1.0 + tolerance / 100.0):
+                regressions.append(f"{name}: {metric} {old} -> {new}")
+            elif new < old:
+                improvements.append(f"{name}: {metric} {old} -> {new}")
+
+    return regressions, improvements
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("--bench", type=pathlib.Path, required=True, help="benchmark program")
+    parser.add_argument("--baseline", type=pathlib.Path, required=True, help="baseline report")
+    parser.add_argument("--report", type=pathlib.Path, required=True, help="report written")
+    parser.add_argument(
+        "--tolerance", type=float, default=0.0, help="increase allowed, in percent (default 0)"
+    )
+    parser.add_argument("--update", action="store_true", help="replace the baseline by the report")
+    args = parser.parse_args()
+
+    current = run_bench(args.bench, args.report)
+
+    if args.update:
+        args.baseline.parent.mkdir(parents=True, exist_ok=True)
+        args.baseline.write_text(args.report.read_text())
+        print(f"{args.baseline} updated")
+        return 0
+
+    if not args.baseline.exists():
+        print(f"{args.baseline} not found, create it with --update", file=sys.stderr)
+        return 1
+
+    baseline = json.loads(args.baseline.read_text())
+    if (baseline["series"], baseline["device"]) != (current["series"], current["device"]):
+        print(
+            f"baseline of {baseline['device']}, report of {current['device']}", file=sys.stderr
+        )
+        return 1
+
+    regressions, improvements = compare(baseline, current, args.tolerance)
+
+    for message in improvements:
+        print(f"improved   {message}")
+    for message in regressions:
+        print(f"REGRESSION {message}")
+
+    if regressions:
+        print(f"{len(regressions)} regression(s) against {args.baseline}", file=sys.stderr)
+        return 1
+    if improvements:
+        print(f"Improvements found, refresh {args.baseline} with --update")
+    print(f"{len(current['benchmarks'])} benchmarks checked against {args.baseline}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
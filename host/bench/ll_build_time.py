@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""
+Measure the compile time of translation units using the generic LL headers.
+
+Each translation unit includes the ``stm32_ll_foo.h`` generic headers of the
+LL modules a typical driver uses, and is built in two ways:
+
+* ``ladder``: the generic headers select and parse the series headers.
+* ``pch``: the aggregate header of the series, ``stm32yyxx_ll.h``, is
+  precompiled once and forced into each unit, as done by the
+  ``STM32CUBE_LL_PCH`` option. The precompilation is part of the time.
+
+The compiler and its flags are the ones of the drivers, given after ``--``::
+
+    ll_build_time.py --series stm32g4xx --units 20 --runs 3 -- gcc -DSTM32G474xx ...
+
+The time of a mode is the best of the runs. It depends on the host load, so
+it is reported and not checked against a baseline.
+"""
+
+import argparse
+import json
+import pathlib
+import subprocess
+import sys
+import tempfile
+import time
+
+# LL modules included by each translation unit
+MODULES = ("bus", "rcc", "system", "utils", "gpio", "exti", "dma", "usart", "i2c", "spi", "tim")
+
+MODES = ("ladder", "pch")
+
+
+def write_units(work, series, units):
+    """Write the autoconf.h of the series and the translation units."""
+    config = f"CONFIG_SOC_SERIES_{series[:-2].upper()}X"
+    (work / "autoconf.h").write_text(f"#define {config} 1\n")
+
+    sources = []
+    for i in range(units):
+        source = work / f"unit_{i}.c"
+        source.write_text(
+            "".join(f"#include <stm32_ll_{module}.h>\n" for module in MODULES)
+            + f"\nint unit_{i}(void)\n{{\n  return (int)LL_GPIO_PIN_{i % 16};\n}}\n"
+        )
+        sources.append(source)
+    return sources
+
+
+def compile_units(command, sources, extra=()):
+    """Compile the translation units one after the other, return the time taken."""
+    start = time.perf_counter()
+    for source in sources:
+        subprocess.run(
+            command + list(extra) + ["-c", str(source), "-o", str(source.with_suffix(".o"))],
+            check=True,
+        )
+    return time.perf_counter() - start
+
+
+def run_mode(command, work, series, mode, sources):
+    """Build the translation units once in a mode, return the time taken."""
+    if mode != "pch":
+        return compile_units(command, sources)
+
+    header = work / "pch" / f"{series}_ll.h"
+    header.parent.mkdir(exist_ok=True)
+    header.write_text(f"#include <{series}_ll.h>\n")
+    start = time.perf_counter()
+    subprocess.run(
+        command + ["-x", "c-header", str(header), "-o", str(header) + ".gch"], check=True
+    )
+    precompile = time.perf_counter() - start
+    return precompile + compile_units(command, sources, ["-Winvalid-pch", "-include", str(header)])
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("--series", required=True, help="series, e.g. stm32g4xx")
+    parser.add_argument("--units", type=int, default=20, help="translation units (default 20)")
+    parser.add_argument("--runs", type=int, default=3, help="runs per mode (default 3)")
+    parser.add_argument("-o", "--output", type=pathlib.Path, help="JSON report written")
+    parser.add_argument("command", nargs=argparse.REMAINDER, help="-- compiler and flags")
+    args = parser.parse_args()
+
+    command = args.command[1:] if args.command[:1] == ["--"] else args.command
+    if not command:
+        parser.error("missing compiler command")
+
+    results = {}
+    with tempfile.TemporaryDirectory() as tmp:
+        work = pathlib.Path(tmp)
+        command = command + [f"-I{work}"]
+        sources = write_units(work, args.series, args.units)
+        for mode in MODES:
+            results[mode] = min(
+                run_mode(command, work, args.series, mode, sources) for _ in range(args.runs)
+            )
+
+    reference = results["ladder"]
+    print(f"{args.units} units including {len(MODULES)} LL modules, best of {args.runs} runs")
+    for mode in MODES:
+        print(f"{mode:<10} {results[mode]:8.3f} s  {100.0 * results[mode] / reference:6.1f} %")
+
+    if args.output:
+        report = {
+            "series": args.series,
+            "units": args.units,
+            "modules": list(MODULES),
+            "seconds": results,
+        }
+        args.output.write_text(json.dumps(report, indent=2) + "\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
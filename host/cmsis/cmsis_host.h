@@ -0,0 +1,333 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CMSIS compiler layer of the host build.
+ *
+ * Replaces cmsis_compiler.h/cmsis_gcc.h: the compiler attributes map to GCC
+ * on the host and the intrinsics changing the CPU state (PRIMASK, BASEPRI,
+ * exclusive monitor, sleep) are forwarded to the register model, which owns
+ * the emulated exception state.
+ */
+
+#ifndef CMSIS_HOST_H
+#define CMSIS_HOST_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef __ASM
+#define __ASM                                  __asm__
+#endif
+#ifndef __INLINE
+#define __INLINE                               inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE                        static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE                   __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN                            __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED                                 __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK                                 __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED                               __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_STRUCT
+#define __PACKED_STRUCT                        struct __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_UNION
+#define __PACKED_UNION                         union __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)                           __attribute__((aligned(x)))
+#endif
+#ifndef __RESTRICT
+#define __RESTRICT                             __restrict
+#endif
+#ifndef __COMPILER_BARRIER
+#define __COMPILER_BARRIER()                   __asm__ volatile("" ::: "memory")
+#endif
+#ifndef __UNALIGNED_UINT16_READ
+#define __UNALIGNED_UINT16_READ(addr)          (*(const uint16_t *)(const void *)(addr))
+#endif
+#ifndef __UNALIGNED_UINT16_WRITE
+#define __UNALIGNED_UINT16_WRITE(addr, val)    ((*(uint16_t *)(void *)(addr)) = (val))
+#endif
+#ifndef __UNALIGNED_UINT32_READ
+#define __UNALIGNED_UINT32_READ(addr)          (*(const uint32_t *)(const void *)(addr))
+#endif
+#ifndef __UNALIGNED_UINT32_WRITE
+#define __UNALIGNED_UINT32_WRITE(addr, val)    ((*(uint32_t *)(void *)(addr)) = (val))
+#endif
+
+/* CPU state emulated by the register model */
+void regmodel_cpu_set_primask(uint32_t primask);
+uint32_t regmodel_cpu_get_primask(void);
+void regmodel_cpu_set_basepri(uint32_t basepri);
+uint32_t regmodel_cpu_get_basepri(void);
+uint32_t regmodel_cpu_get_ipsr(void);
+void regmodel_cpu_wait_for_interrupt(void);
+void regmodel_cpu_set_exclusive(void);
+uint32_t regmodel_cpu_test_exclusive(void);
+void regmodel_cpu_clear_exclusive(void);
+__NO_RETURN void regmodel_cpu_breakpoint(uint32_t value);
+
+__STATIC_FORCEINLINE void __NOP(void)
+{
+	__COMPILER_BARRIER();
+}
+
+__STATIC_FORCEINLINE void __DMB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __DSB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __ISB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+__STATIC_FORCEINLINE void __WFI(void)
+{
+	regmodel_cpu_wait_for_interrupt();
+}
+
+__STATIC_FORCEINLINE void __WFE(void)
+{
+	regmodel_cpu_wait_for_interrupt();
+}
+
+__STATIC_FORCEINLINE void __SEV(void)
+{
+}
+
+/* Drivers writing the Arm hint instructions as inline assembly: no-ops on the host */
+__asm__(".macro wfe\n.endm\n.macro wfi\n.endm\n.macro sev\n.endm\n");
+
+#define __BKPT(value)                          regmodel_cpu_breakpoint(value)
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+	regmodel_cpu_set_primask(0U);
+}
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+	regmodel_cpu_set_primask(1U);
+}
+
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)
+{
+	return regmodel_cpu_get_primask();
+}
+
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t priMask)
+{
+	regmodel_cpu_set_primask(priMask & 1U);
+}
+
+__STATIC_FORCEINLINE uint32_t __get_BASEPRI(void)
+{
+	return regmodel_cpu_get_basepri();
+}
+
+__STATIC_FORCEINLINE void __set_BASEPRI(uint32_t basePri)
+{
+	regmodel_cpu_set_basepri(basePri & 0xFFU);
+}
+
+__STATIC_FORCEINLINE uint32_t __get_IPSR(void)
+{
+	return regmodel_cpu_get_ipsr();
+}
+
+__STATIC_FORCEINLINE uint32_t __get_CONTROL(void)
+{
+	return 0U;
+}
+
+__STATIC_FORCEINLINE void __set_CONTROL(uint32_t control)
+{
+	(void)control;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_MSP(void)
+{
+	return 0U;
+}
+
+__STATIC_FORCEINLINE void __set_MSP(uint32_t topOfMainStack)
+{
+	(void)topOfMainStack;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_PSP(void)
+{
+	return 0U;
+}
+
+__STATIC_FORCEINLINE void __set_PSP(uint32_t topOfProcStack)
+{
+	(void)topOfProcStack;
+}
+
+__STATIC_FORCEINLINE uint32_t __get_FPSCR(void)
+{
+	return 0U;
+}
+
+__STATIC_FORCEINLINE void __set_FPSCR(uint32_t fpscr)
+{
+	(void)fpscr;
+}
+
+__STATIC_FORCEINLINE uint32_t __REV(uint32_t value)
+{
+	return __builtin_bswap32(value);
+}
+
+__STATIC_FORCEINLINE uint32_t __REV16(uint32_t value)
+{
+	return ((value & 0xFF00FF00UL) >> 8) | ((value & 0x00FF00FFUL) << 8);
+}
+
+__STATIC_FORCEINLINE int16_t __REVSH(int16_t value)
+{
+	return (int16_t)__builtin_bswap16((uint16_t)value);
+}
+
+__STATIC_FORCEINLINE uint32_t __ROR(uint32_t op1, uint32_t op2)
+{
+	op2 %= 32U;
+	if (op2 == 0U) {
+		return op1;
+	}
+	return (op1 >> op2) | (op1 << (32U - op2));
+}
+
+__STATIC_FORCEINLINE uint32_t __RBIT(uint32_t value)
+{
+	uint32_t result = 0U;
+
+	for (uint32_t bit = 0U; bit < 32U; bit++) {
+		result = (result << 1) | (value & 1U);
+		value >>= 1;
+	}
+	return result;
+}
+
+__STATIC_FORCEINLINE uint8_t __CLZ(uint32_t value)
+{
+	if (value == 0U) {
+		return 32U;
+	}
+	return (uint8_t)__builtin_clz(value);
+}
+
+/*
+ * Exclusive accesses: the monitor is cleared by the model on exception entry,
+ * so a sequence interrupted by an emulated IRQ fails its store as on target.
+ */
+__STATIC_FORCEINLINE uint8_t __LDREXB(volatile uint8_t *addr)
+{
+	regmodel_cpu_set_exclusive();
+	return *addr;
+}
+
+__STATIC_FORCEINLINE uint16_t __LDREXH(volatile uint16_t *addr)
+{
+	regmodel_cpu_set_exclusive();
+	return *addr;
+}
+
+__STATIC_FORCEINLINE uint32_t __LDREXW(volatile uint32_t *addr)
+{
+	regmodel_cpu_set_exclusive();
+	return *addr;
+}
+
+__STATIC_FORCEINLINE uint32_t __STREXB(uint8_t value, volatile uint8_t *addr)
+{
+	if (regmodel_cpu_test_exclusive() == 0U) {
+		return 1U;
+	}
+	*addr = value;
+	return 0U;
+}
+
+__STATIC_FORCEINLINE uint32_t __STREXH(uint16_t value, volatile uint16_t *addr)
+{
+	if (regmodel_cpu_test_exclusive() == 0U) {
+		return 1U;
+	}
+	*addr = value;
+	return 0U;
+}
+
+__STATIC_FORCEINLINE uint32_t __STREXW(uint32_t value, volatile uint32_t *addr)
+{
+	if (regmodel_cpu_test_exclusive() == 0U) {
+		return 1U;
+	}
+	*addr = value;
+	return 0U;
+}
+
+__STATIC_FORCEINLINE void __CLREX(void)
+{
+	regmodel_cpu_clear_exclusive();
+}
+
+__STATIC_FORCEINLINE int32_t __SSAT(int32_t value, uint32_t sat)
+{
+	if ((sat >= 1U) && (sat <= 32U)) {
+		const int32_t max = (int32_t)((1U << (sat - 1U)) - 1U);
+		const int32_t min = -1 - max;
+
+		if (value > max) {
+			return max;
+		}
+		if (value < min) {
+			return min;
+		}
+	}
+	return value;
+}
+
+__STATIC_FORCEINLINE uint32_t __USAT(int32_t value, uint32_t sat)
+{
+	if (sat <= 31U) {
+		const uint32_t max = ((1U << sat) - 1U);
+
+		if (value > (int32_t)max) {
+			return max;
+		}
+		if (value < 0) {
+			return 0U;
+		}
+	}
+	return (uint32_t)value;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CMSIS_HOST_H */
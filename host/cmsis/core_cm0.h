@@ -0,0 +1,12 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Host build stand-in of the CMSIS core_cm0.h, see core_host.h */
+
+#ifndef __CORE_CM0_H_GENERIC
+#define __CORE_CM0_H_GENERIC
+
+#include "core_host.h"
+
+#endif /* __CORE_CM0_H_GENERIC */
@@ -0,0 +1,562 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CMSIS core peripherals of the host build.
+ *
+ * Stands for core_cm0.h ... core_cm33.h. The System Control Space is given
+ * the ARMv7-M layout at its architectural addresses, so the accesses of the
+ * HAL to SCB, NVIC, SysTick or DWT go through the register model like any
+ * peripheral access. The NVIC and SysTick functions are those of CMSIS,
+ * their side effects are emulated by the model.
+ */
+
+#ifndef CORE_HOST_H
+#define CORE_HOST_H
+
+#include "cmsis_host.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __IM    volatile const
+#define __OM    volatile
+#define __IOM   volatile
+
+#ifndef __NVIC_PRIO_BITS
+#define __NVIC_PRIO_BITS 4U
+#endif
+
+#ifndef __MPU_PRESENT
+#define __MPU_PRESENT 0U
+#endif
+
+#ifndef __FPU_PRESENT
+#define __FPU_PRESENT 0U
+#endif
+
+#define __FPU_USED    __FPU_PRESENT
+
+/* Memory mapping of the core hardware */
+#define SCS_BASE            (0xE000E000UL)
+#define ITM_BASE            (0xE0000000UL)
+#define DWT_BASE            (0xE0001000UL)
+#define CoreDebug_BASE      (0xE000EDF0UL)
+#define SysTick_BASE        (SCS_BASE +  0x0010UL)
+#define NVIC_BASE           (SCS_BASE +  0x0100UL)
+#define SCB_BASE            (SCS_BASE +  0x0D00UL)
+#define MPU_BASE            (SCS_BASE +  0x0D90UL)
+#define FPU_BASE            (SCS_BASE +  0x0F30UL)
+
+typedef struct {
+	__IOM uint32_t ISER[8U];
+	uint32_t RESERVED0[24U];
+	__IOM uint32_t ICER[8U];
+	uint32_t RESERVED1[24U];
+	__IOM uint32_t ISPR[8U];
+	uint32_t RESERVED2[24U];
+	__IOM uint32_t ICPR[8U];
+	uint32_t RESERVED3[24U];
+	__IOM uint32_t IABR[8U];
+	uint32_t RESERVED4[56U];
+	union {
+		__IOM uint8_t IP[240U];
+		__IOM uint8_t IPR[240U];
+	};
+	uint32_t RESERVED5[644U];
+	__OM uint32_t STIR;
+} NVIC_Type;
+
+typedef struct {
+	__IM uint32_t CPUID;
+	__IOM uint32_t ICSR;
+	__IOM uint32_t VTOR;
+	__IOM uint32_t AIRCR;
+	__IOM uint32_t SCR;
+	__IOM uint32_t CCR;
+	union {
+		__IOM uint8_t SHP[12U];
+		__IOM uint8_t SHPR[12U];
+	};
+	__IOM uint32_t SHCSR;
+	__IOM uint32_t CFSR;
+	__IOM uint32_t HFSR;
+	__IOM uint32_t DFSR;
+	__IOM uint32_t MMFAR;
+	__IOM uint32_t BFAR;
+	__IOM uint32_t AFSR;
+	union {
+		__IM uint32_t PFR[2U];
+		__IM uint32_t ID_PFR[2U];
+	};
+	union {
+		__IM uint32_t DFR;
+		__IM uint32_t ID_DFR;
+	};
+	union {
+		__IM uint32_t ADR;
+		__IM uint32_t ID_AFR;
+	};
+	union {
+		__IM uint32_t MMFR[4U];
+		__IM uint32_t ID_MFR[4U];
+	};
+	union {
+		__IM uint32_t ISAR[5U];
+		__IM uint32_t ID_ISAR[5U];
+	};
+	uint32_t RESERVED0[1U];
+	__IM uint32_t CLIDR;
+	__IM uint32_t CTR;
+	__IM uint32_t CCSIDR;
+	__IOM uint32_t CSSELR;
+	__IOM uint32_t CPACR;
+	uint32_t RESERVED3[93U];
+	__OM uint32_t STIR;
+	uint32_t RESERVED4[15U];
+	__IM uint32_t MVFR0;
+	__IM uint32_t MVFR1;
+	__IM uint32_t MVFR2;
+	uint32_t RESERVED5[1U];
+	__OM uint32_t ICIALLU;
+	uint32_t RESERVED6[1U];
+	__OM uint32_t ICIMVAU;
+	__OM uint32_t DCIMVAC;
+	__OM uint32_t DCISW;
+	__OM uint32_t DCCMVAU;
+	__OM uint32_t DCCMVAC;
+	__OM uint32_t DCCSW;
+	__OM uint32_t DCCIMVAC;
+	__OM uint32_t DCCISW;
+} SCB_Type;
+
+typedef struct {
+	uint32_t RESERVED0[1U];
+	__IM uint32_t ICTR;
+	__IOM uint32_t ACTLR;
+} SCnSCB_Type;
+
+typedef struct {
+	__IOM uint32_t CTRL;
+	__IOM uint32_t LOAD;
+	__IOM uint32_t VAL;
+	__IM uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct {
+	__IOM uint32_t CTRL;
+	__IOM uint32_t CYCCNT;
+	__IOM uint32_t CPICNT;
+	__IOM uint32_t EXCCNT;
+	__IOM uint32_t SLEEPCNT;
+	__IOM uint32_t LSUCNT;
+	__IOM uint32_t FOLDCNT;
+	__IM uint32_t PCSR;
+	__IOM uint32_t COMP0;
+	__IOM uint32_t MASK0;
+	__IOM uint32_t FUNCTION0;
+	uint32_t RESERVED0[1U];
+	__IOM uint32_t COMP1;
+	__IOM uint32_t MASK1;
+	__IOM uint32_t FUNCTION1;
+	uint32_t RESERVED1[1U];
+	__IOM uint32_t COMP2;
+	__IOM uint32_t MASK2;
+	__IOM uint32_t FUNCTION2;
+	uint32_t RESERVED2[1U];
+	__IOM uint32_t COMP3;
+	__IOM uint32_t MASK3;
+	__IOM uint32_t FUNCTION3;
+	uint32_t RESERVED3[981U];
+	__OM uint32_t LAR;
+	__IM uint32_t LSR;
+} DWT_Type;
+
+typedef struct {
+	__IOM uint32_t DHCSR;
+	__OM uint32_t DCRSR;
+	__IOM uint32_t DCRDR;
+	__IOM uint32_t DEMCR;
+} CoreDebug_Type;
+
+typedef struct {
+	__IM uint32_t TYPE;
+	__IOM uint32_t CTRL;
+	__IOM uint32_t RNR;
+	__IOM uint32_t RBAR;
+	__IOM uint32_t RASR;
+	__IOM uint32_t RBAR_A1;
+	__IOM uint32_t RASR_A1;
+	__IOM uint32_t RBAR_A2;
+	__IOM uint32_t RASR_A2;
+	__IOM uint32_t RBAR_A3;
+	__IOM uint32_t RASR_A3;
+} MPU_Type;
+
+typedef struct {
+	uint32_t RESERVED0[1U];
+	__IOM uint32_t FPCCR;
+	__IOM uint32_t FPCAR;
+	__IOM uint32_t FPDSCR;
+	__IM uint32_t MVFR0;
+	__IM uint32_t MVFR1;
+	__IM uint32_t MVFR2;
+} FPU_Type;
+
+#define SCnSCB              ((SCnSCB_Type    *)SCS_BASE)
+#define SCB                 ((SCB_Type       *)SCB_BASE)
+#define SysTick             ((SysTick_Type   *)SysTick_BASE)
+#define NVIC                ((NVIC_Type      *)NVIC_BASE)
+#define DWT                 ((DWT_Type       *)DWT_BASE)
+#define CoreDebug           ((CoreDebug_Type *)CoreDebug_BASE)
+#define MPU                 ((MPU_Type       *)MPU_BASE)
+#define FPU                 ((FPU_Type       *)FPU_BASE)
+
+/* SCB */
+#define SCB_CPUID_IMPLEMENTER_Pos          24U
+#define SCB_CPUID_IMPLEMENTER_Msk          (0xFFUL << SCB_CPUID_IMPLEMENTER_Pos)
+#define SCB_CPUID_VARIANT_Pos              20U
+#define SCB_CPUID_VARIANT_Msk              (0xFUL << SCB_CPUID_VARIANT_Pos)
+#define SCB_CPUID_ARCHITECTURE_Pos         16U
+#define SCB_CPUID_ARCHITECTURE_Msk         (0xFUL << SCB_CPUID_ARCHITECTURE_Pos)
+#define SCB_CPUID_PARTNO_Pos                4U
+#define SCB_CPUID_PARTNO_Msk               (0xFFFUL << SCB_CPUID_PARTNO_Pos)
+#define SCB_CPUID_REVISION_Pos              0U
+#define SCB_CPUID_REVISION_Msk             (0xFUL)
+
+#define SCB_ICSR_NMIPENDSET_Pos            31U
+#define SCB_ICSR_NMIPENDSET_Msk            (1UL << SCB_ICSR_NMIPENDSET_Pos)
+#define SCB_ICSR_PENDSVSET_Pos             28U
+#define SCB_ICSR_PENDSVSET_Msk             (1UL << SCB_ICSR_PENDSVSET_Pos)
+#define SCB_ICSR_PENDSVCLR_Pos             27U
+#define SCB_ICSR_PENDSVCLR_Msk             (1UL << SCB_ICSR_PENDSVCLR_Pos)
+#define SCB_ICSR_PENDSTSET_Pos             26U
+#define SCB_ICSR_PENDSTSET_Msk             (1UL << SCB_ICSR_PENDSTSET_Pos)
+#define SCB_ICSR_PENDSTCLR_Pos             25U
+#define SCB_ICSR_PENDSTCLR_Msk             (1UL << SCB_ICSR_PENDSTCLR_Pos)
+#define SCB_ICSR_VECTACTIVE_Pos             0U
+#define SCB_ICSR_VECTACTIVE_Msk            (0x1FFUL)
+
+#define SCB_AIRCR_VECTKEY_Pos              16U
+#define SCB_AIRCR_VECTKEY_Msk              (0xFFFFUL << SCB_AIRCR_VECTKEY_Pos)
+#define SCB_AIRCR_PRIGROUP_Pos              8U
+#define SCB_AIRCR_PRIGROUP_Msk             (7UL << SCB_AIRCR_PRIGROUP_Pos)
+#define SCB_AIRCR_SYSRESETREQ_Pos           2U
+#define SCB_AIRCR_SYSRESETREQ_Msk          (1UL << SCB_AIRCR_SYSRESETREQ_Pos)
+
+#define SCB_SCR_SEVONPEND_Pos               4U
+#define SCB_SCR_SEVONPEND_Msk              (1UL << SCB_SCR_SEVONPEND_Pos)
+#define SCB_SCR_SLEEPDEEP_Pos               2U
+#define SCB_SCR_SLEEPDEEP_Msk              (1UL << SCB_SCR_SLEEPDEEP_Pos)
+#define SCB_SCR_SLEEPONEXIT_Pos             1U
+#define SCB_SCR_SLEEPONEXIT_Msk            (1UL << SCB_SCR_SLEEPONEXIT_Pos)
+
+#define SCB_CCR_BP_Pos                     18U
+#define SCB_CCR_BP_Msk                     (1UL << SCB_CCR_BP_Pos)
+#define SCB_CCR_IC_Pos                     17U
+#define SCB_CCR_IC_Msk                     (1UL << SCB_CCR_IC_Pos)
+#define SCB_CCR_DC_Pos                     16U
+#define SCB_CCR_DC_Msk                     (1UL << SCB_CCR_DC_Pos)
+#define SCB_CCR_STKALIGN_Pos                9U
+#define SCB_CCR_STKALIGN_Msk               (1UL << SCB_CCR_STKALIGN_Pos)
+#define SCB_CCR_UNALIGN_TRP_Pos             3U
+#define SCB_CCR_UNALIGN_TRP_Msk            (1UL << SCB_CCR_UNALIGN_TRP_Pos)
+
+#define SCB_SHCSR_USGFAULTENA_Pos          18U
+#define SCB_SHCSR_USGFAULTENA_Msk          (1UL << SCB_SHCSR_USGFAULTENA_Pos)
+#define SCB_SHCSR_BUSFAULTENA_Pos          17U
+#define SCB_SHCSR_BUSFAULTENA_Msk          (1UL << SCB_SHCSR_BUSFAULTENA_Pos)
+#define SCB_SHCSR_MEMFAULTENA_Pos          16U
+#define SCB_SHCSR_MEMFAULTENA_Msk          (1UL << SCB_SHCSR_MEMFAULTENA_Pos)
+
+/* SysTick */
+#define SysTick_CTRL_COUNTFLAG_Pos         16U
+#define SysTick_CTRL_COUNTFLAG_Msk         (1UL << SysTick_CTRL_COUNTFLAG_Pos)
+#define SysTick_CTRL_CLKSOURCE_Pos          2U
+#define SysTick_CTRL_CLKSOURCE_Msk         (1UL << SysTick_CTRL_CLKSOURCE_Pos)
+#define SysTick_CTRL_TICKINT_Pos            1U
+#define SysTick_CTRL_TICKINT_Msk           (1UL << SysTick_CTRL_TICKINT_Pos)
+#define SysTick_CTRL_ENABLE_Pos             0U
+#define SysTick_CTRL_ENABLE_Msk            (1UL)
+#define SysTick_LOAD_RELOAD_Pos             0U
+#define SysTick_LOAD_RELOAD_Msk            (0xFFFFFFUL)
+#define SysTick_VAL_CURRENT_Pos             0U
+#define SysTick_VAL_CURRENT_Msk            (0xFFFFFFUL)
+
+/* DWT and CoreDebug */
+#define DWT_CTRL_NOCYCCNT_Pos              25U
+#define DWT_CTRL_NOCYCCNT_Msk              (1UL << DWT_CTRL_NOCYCCNT_Pos)
+#define DWT_CTRL_CYCCNTENA_Pos              0U
+#define DWT_CTRL_CYCCNTENA_Msk             (1UL)
+#define CoreDebug_DEMCR_TRCENA_Pos         24U
+#define CoreDebug_DEMCR_TRCENA_Msk         (1UL << CoreDebug_DEMCR_TRCENA_Pos)
+
+/* MPU */
+#define MPU_TYPE_DREGION_Pos                8U
+#define MPU_TYPE_DREGION_Msk               (0xFFUL << MPU_TYPE_DREGION_Pos)
+#define MPU_CTRL_PRIVDEFENA_Pos             2U
+#define MPU_CTRL_PRIVDEFENA_Msk            (1UL << MPU_CTRL_PRIVDEFENA_Pos)
+#define MPU_CTRL_HFNMIENA_Pos               1U
+#define MPU_CTRL_HFNMIENA_Msk              (1UL << MPU_CTRL_HFNMIENA_Pos)
+#define MPU_CTRL_ENABLE_Pos                 0U
+#define MPU_CTRL_ENABLE_Msk                (1UL)
+#define MPU_RNR_REGION_Pos                  0U
+#define MPU_RNR_REGION_Msk                 (0xFFUL)
+#define MPU_RBAR_ADDR_Pos                   5U
+#define MPU_RBAR_ADDR_Msk                  (0x7FFFFFFUL << MPU_RBAR_ADDR_Pos)
+#define MPU_RBAR_VALID_Pos                  4U
+#define MPU_RBAR_VALID_Msk                 (1UL << MPU_RBAR_VALID_Pos)
+#define MPU_RBAR_REGION_Pos                 0U
+#define MPU_RBAR_REGION_Msk                (0xFUL)
+#define MPU_RASR_ATTRS_Pos                 16U
+#define MPU_RASR_ATTRS_Msk                 (0xFFFFUL << MPU_RASR_ATTRS_Pos)
+#define MPU_RASR_XN_Pos                    28U
+#define MPU_RASR_XN_Msk                    (1UL << MPU_RASR_XN_Pos)
+#define MPU_RASR_AP_Pos                    24U
+#define MPU_RASR_AP_Msk                    (0x7UL << MPU_RASR_AP_Pos)
+#define MPU_RASR_TEX_Pos                   19U
+#define MPU_RASR_TEX_Msk                   (0x7UL << MPU_RASR_TEX_Pos)
+#define MPU_RASR_S_Pos                     18U
+#define MPU_RASR_S_Msk                     (1UL << MPU_RASR_S_Pos)
+#define MPU_RASR_C_Pos                     17U
+#define MPU_RASR_C_Msk                     (1UL << MPU_RASR_C_Pos)
+#define MPU_RASR_B_Pos                     16U
+#define MPU_RASR_B_Msk                     (1UL << MPU_RASR_B_Pos)
+#define MPU_RASR_SRD_Pos                    8U
+#define MPU_RASR_SRD_Msk                   (0xFFUL << MPU_RASR_SRD_Pos)
+#define MPU_RASR_SIZE_Pos                   1U
+#define MPU_RASR_SIZE_Msk                  (0x1FUL << MPU_RASR_SIZE_Pos)
+#define MPU_RASR_ENABLE_Pos                 0U
+#define MPU_RASR_ENABLE_Msk                (1UL)
+
+/* FPU */
+#define FPU_FPCCR_ASPEN_Pos                31U
+#define FPU_FPCCR_ASPEN_Msk                (1UL << FPU_FPCCR_ASPEN_Pos)
+#define FPU_FPCCR_LSPEN_Pos                30U
+#define FPU_FPCCR_LSPEN_Msk                (1UL << FPU_FPCCR_LSPEN_Pos)
+
+/* NVIC functions */
+#define NVIC_USER_IRQ_OFFSET          16
+
+__STATIC_INLINE void __NVIC_SetPriorityGrouping(uint32_t PriorityGroup)
+{
+	uint32_t reg_value;
+	uint32_t PriorityGroupTmp = (PriorityGroup & (uint32_t)0x07UL);
+
+	reg_value = SCB->AIRCR;
+	reg_value &= ~((uint32_t)(SCB_AIRCR_VECTKEY_Msk | SCB_AIRCR_PRIGROUP_Msk));
+	reg_value = (reg_value | ((uint32_t)0x5FAUL << SCB_AIRCR_VECTKEY_Pos) |
+		     (PriorityGroupTmp << SCB_AIRCR_PRIGROUP_Pos));
+	SCB->AIRCR = reg_value;
+}
+
+__STATIC_INLINE uint32_t __NVIC_GetPriorityGrouping(void)
+{
+	return (uint32_t)((SCB->AIRCR & SCB_AIRCR_PRIGROUP_Msk) >> SCB_AIRCR_PRIGROUP_Pos);
+}
+
+__STATIC_INLINE void __NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		NVIC->ISER[(((uint32_t)IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)IRQn) & 0x1FUL));
+	}
+}
+
+__STATIC_INLINE uint32_t __NVIC_GetEnableIRQ(IRQn_Type IRQn)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		return ((uint32_t)(((NVIC->ISER[(((uint32_t)IRQn) >> 5UL)] &
+				     (1UL << (((uint32_t)IRQn) & 0x1FUL))) != 0UL) ? 1UL : 0UL));
+	}
+	return 0U;
+}
+
+__STATIC_INLINE void __NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		NVIC->ICER[(((uint32_t)IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)IRQn) & 0x1FUL));
+		__DSB();
+		__ISB();
+	}
+}
+
+__STATIC_INLINE uint32_t __NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		return ((uint32_t)(((NVIC->ISPR[(((uint32_t)IRQn) >> 5UL)] &
+				     (1UL << (((uint32_t)IRQn) & 0x1FUL))) != 0UL) ? 1UL : 0UL));
+	}
+	return 0U;
+}
+
+__STATIC_INLINE void __NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		NVIC->ISPR[(((uint32_t)IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)IRQn) & 0x1FUL));
+	}
+}
+
+__STATIC_INLINE void __NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		NVIC->ICPR[(((uint32_t)IRQn) >> 5UL)] = (uint32_t)(1UL << (((uint32_t)IRQn) & 0x1FUL));
+	}
+}
+
+__STATIC_INLINE uint32_t __NVIC_GetActive(IRQn_Type IRQn)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		return ((uint32_t)(((NVIC->IABR[(((uint32_t)IRQn) >> 5UL)] &
+				     (1UL << (((uint32_t)IRQn) & 0x1FUL))) != 0UL) ? 1UL : 0UL));
+	}
+	return 0U;
+}
+
+__STATIC_INLINE void __NVIC_SetPriority(IRQn_Type IRQn, uint32_t priority)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		NVIC->IP[((uint32_t)IRQn)] =
+			(uint8_t)((priority << (8U - __NVIC_PRIO_BITS)) & (uint32_t)0xFFUL);
+	} else {
+		SCB->SHP[(((uint32_t)IRQn) & 0xFUL) - 4UL] =
+			(uint8_t)((priority << (8U - __NVIC_PRIO_BITS)) & (uint32_t)0xFFUL);
+	}
+}
+
+__STATIC_INLINE uint32_t __NVIC_GetPriority(IRQn_Type IRQn)
+{
+	if ((int32_t)(IRQn) >= 0) {
+		return (((uint32_t)NVIC->IP[((uint32_t)IRQn)] >> (8U - __NVIC_PRIO_BITS)));
+	}
+	return (((uint32_t)SCB->SHP[(((uint32_t)IRQn) & 0xFUL) - 4UL] >> (8U - __NVIC_PRIO_BITS)));
+}
+
+__STATIC_INLINE uint32_t NVIC_EncodePriority(uint32_t PriorityGroup, uint32_t PreemptPriority,
+					     uint32_t SubPriority)
+{
+	uint32_t PriorityGroupTmp = (PriorityGroup & (uint32_t)0x07UL);
+	uint32_t PreemptPriorityBits;
+	uint32_t SubPriorityBits;
+
+	PreemptPriorityBits = ((7UL - PriorityGroupTmp) > (uint32_t)(__NVIC_PRIO_BITS)) ?
+			      (uint32_t)(__NVIC_PRIO_BITS) : (uint32_t)(7UL - PriorityGroupTmp);
+	SubPriorityBits = ((PriorityGroupTmp + (uint32_t)(__NVIC_PRIO_BITS)) < (uint32_t)7UL) ?
+			  (uint32_t)0UL : (uint32_t)((PriorityGroupTmp - 7UL) + (uint32_t)(__NVIC_PRIO_BITS));
+
+	return (((PreemptPriority & (uint32_t)((1UL << (PreemptPriorityBits)) - 1UL)) << SubPriorityBits) |
+		((SubPriority & (uint32_t)((1UL << (SubPriorityBits)) - 1UL))));
+}
+
+__STATIC_INLINE void NVIC_DecodePriority(uint32_t Priority, uint32_t PriorityGroup,
+					 uint32_t *const pPreemptPriority, uint32_t *const pSubPriority)
+{
+	uint32_t PriorityGroupTmp = (PriorityGroup & (uint32_t)0x07UL);
+	uint32_t PreemptPriorityBits;
+	uint32_t SubPriorityBits;
+
+	PreemptPriorityBits = ((7UL - PriorityGroupTmp) > (uint32_t)(__NVIC_PRIO_BITS)) ?
+			      (uint32_t)(__NVIC_PRIO_BITS) : (uint32_t)(7UL - PriorityGroupTmp);
+	SubPriorityBits = ((PriorityGroupTmp + (uint32_t)(__NVIC_PRIO_BITS)) < (uint32_t)7UL) ?
+			  (uint32_t)0UL : (uint32_t)((PriorityGroupTmp - 7UL) + (uint32_t)(__NVIC_PRIO_BITS));
+
+	*pPreemptPriority = (Priority >> SubPriorityBits) & (uint32_t)((1UL << (PreemptPriorityBits)) - 1UL);
+	*pSubPriority = (Priority) & (uint32_t)((1UL << (SubPriorityBits)) - 1UL);
+}
+
+__NO_RETURN __STATIC_INLINE void __NVIC_SystemReset(void)
+{
+	__DSB();
+	SCB->AIRCR = (uint32_t)((0x5FAUL << SCB_AIRCR_VECTKEY_Pos) |
+				(SCB->AIRCR & SCB_AIRCR_PRIGROUP_Msk) |
+				SCB_AIRCR_SYSRESETREQ_Msk);
+	__DSB();
+	regmodel_cpu_breakpoint(0U);
+}
+
+#define NVIC_SetPriorityGrouping    __NVIC_SetPriorityGrouping
+#define NVIC_GetPriorityGrouping    __NVIC_GetPriorityGrouping
+#define NVIC_EnableIRQ              __NVIC_EnableIRQ
+#define NVIC_GetEnableIRQ           __NVIC_GetEnableIRQ
+#define NVIC_DisableIRQ             __NVIC_DisableIRQ
+#define NVIC_GetPendingIRQ          __NVIC_GetPendingIRQ
+#define NVIC_SetPendingIRQ          __NVIC_SetPendingIRQ
+#define NVIC_ClearPendingIRQ        __NVIC_ClearPendingIRQ
+#define NVIC_GetActive              __NVIC_GetActive
+#define NVIC_SetPriority            __NVIC_SetPriority
+#define NVIC_GetPriority            __NVIC_GetPriority
+#define NVIC_SystemReset            __NVIC_SystemReset
+
+__STATIC_INLINE uint32_t SysTick_Config(uint32_t ticks)
+{
+	if ((ticks - 1UL) > SysTick_LOAD_RELOAD_Msk) {
+		return (1UL);
+	}
+
+	SysTick->LOAD = (uint32_t)(ticks - 1UL);
+	NVIC_SetPriority(SysTick_IRQn, (1UL << __NVIC_PRIO_BITS) - 1UL);
+	SysTick->VAL = 0UL;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+	return (0UL);
+}
+
+/* Cache maintenance has no effect on the host, the model has no cache */
+__STATIC_INLINE void SCB_EnableICache(void)
+{
+}
+
+__STATIC_INLINE void SCB_DisableICache(void)
+{
+}
+
+__STATIC_INLINE void SCB_InvalidateICache(void)
+{
+}
+
+__STATIC_INLINE void SCB_EnableDCache(void)
+{
+}
+
+__STATIC_INLINE void SCB_DisableDCache(void)
+{
+}
+
+__STATIC_INLINE void SCB_InvalidateDCache(void)
+{
+}
+
+__STATIC_INLINE void SCB_CleanDCache(void)
+{
+}
+
+__STATIC_INLINE void SCB_CleanInvalidateDCache(void)
+{
+}
+
+__STATIC_INLINE void SCB_InvalidateDCache_by_Addr(volatile void *addr, int32_t dsize)
+{
+	(void)addr;
+	(void)dsize;
+}
+
+__STATIC_INLINE void SCB_CleanDCache_by_Addr(volatile void *addr, int32_t dsize)
+{
+	(void)addr;
+	(void)dsize;
+}
+
+__STATIC_INLINE void SCB_CleanInvalidateDCache_by_Addr(volatile void *addr, int32_t dsize)
+{
+	(void)addr;
+	(void)dsize;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CORE_HOST_H */
@@ -0,0 +1,217 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Smoke test of the host build: clock tree, SysTick, UART polling and
+ * interrupt transfers, DMA memory-to-memory transfer.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32g4xx_hal.h"
+#include "regmodel.h"
+#include "regmodel_stm32g4xx.h"
+
+static UART_HandleTypeDef huart1;
+static DMA_HandleTypeDef hdma;
+static volatile int tx_done;
+static volatile int rx_done;
+static volatile int dma_done;
+
+/* DMA addresses are 32-bit, the buffers are static */
+static uint32_t dma_src[64];
+static uint32_t dma_dst[64];
+static uint8_t rx_buf[4];
+
+static void systick_isr(void)
+{
+	HAL_IncTick();
+}
+
+static void usart1_isr(void)
+{
+	HAL_UART_IRQHandler(&huart1);
+}
+
+static void dma1_channel1_isr(void)
+{
+	HAL_DMA_IRQHandler(&hdma);
+}
+
+void HAL_UART_MspInit(UART_HandleTypeDef *huart)
+{
+	__HAL_RCC_USART1_CLK_ENABLE();
+	HAL_NVIC_SetPriority(USART1_IRQn, 5U, 0U);
+	HAL_NVIC_EnableIRQ(USART1_IRQn);
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	tx_done = 1;
+}
+
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+	rx_done = 1;
+}
+
+static void dma_complete(DMA_HandleTypeDef *hdma)
+{
+	dma_done = 1;
+}
+
+static int wait_for(volatile int *flag)
+{
+	uint32_t tickstart = HAL_GetTick();
+
+	while (*flag == 0) {
+		if ((HAL_GetTick() - tickstart) > 1000U) {
+			return -1;
+		}
+		__WFI();
+	}
+	return 0;
+}
+
+static int check(const char *name, int ok)
+{
+	printf("%-24s %s\n", name, ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+/* 170 MHz from the HSI through the PLL, in boost mode */
+static int clock_config(void)
+{
+	RCC_OscInitTypeDef osc = { 0 };
+	RCC_ClkInitTypeDef clk = { 0 };
+
+	HAL_PWREx_ControlVoltageScaling(PWR_REGULATOR_VOLTAGE_SCALE1_BOOST);
+
+	osc.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+	osc.HSIState = RCC_HSI_ON;
+	osc.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+	osc.PLL.PLLState = RCC_PLL_ON;
+	osc.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+	osc.PLL.PLLM = RCC_PLLM_DIV4;
+	osc.PLL.PLLN = 85U;
+	osc.PLL.PLLP = RCC_PLLP_DIV2;
+	osc.PLL.PLLQ = RCC_PLLQ_DIV2;
+	osc.PLL.PLLR = RCC_PLLR_DIV2;
+	if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+		return -1;
+	}
+
+	clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 |
+			RCC_CLOCKTYPE_PCLK2;
+	clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+	clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	clk.APB1CLKDivider = RCC_HCLK_DIV1;
+	clk.APB2CLKDivider = RCC_HCLK_DIV1;
+	if (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_4) != HAL_OK) {
+		return -1;
+	}
+	return 0;
+}
+
+static int uart_test(void)
+{
+	static const uint8_t hello[] = "hello";
+	static const uint8_t ping[] = "ping";
+	uint8_t out[16];
+	int failed = 0;
+
+	huart1.Instance = USART1;
+	huart1.Init.BaudRate = 115200U;
+	huart1.Init.WordLength = UART_WORDLENGTH_8B;
+	huart1.Init.StopBits = UART_STOPBITS_1;
+	huart1.Init.Parity = UART_PARITY_NONE;
+	huart1.Init.Mode = UART_MODE_TX_RX;
+	huart1.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+	huart1.Init.OverSampling = UART_OVERSAMPLING_16;
+	failed |= check("HAL_UART_Init", HAL_UART_Init(&huart1) == HAL_OK);
+
+	failed |= check("HAL_UART_Transmit",
+			(HAL_UART_Transmit(&huart1, hello, 5U, 100U) == HAL_OK) &&
+			(regmodel_uart_capture(USART1_BASE, out, sizeof(out)) == 5U) &&
+			(memcmp(out, hello, 5U) == 0));
+
+	failed |= check("HAL_UART_Transmit_IT",
+			(HAL_UART_Transmit_IT(&huart1, hello, 5U) == HAL_OK) &&
+			(wait_for(&tx_done) == 0) &&
+			(regmodel_uart_capture(USART1_BASE, out, sizeof(out)) == 5U) &&
+			(memcmp(out, hello, 5U) == 0));
+
+	failed |= check("HAL_UART_Receive_IT",
+			(HAL_UART_Receive_IT(&huart1, rx_buf, 4U) == HAL_OK) &&
+			(regmodel_uart_inject(USART1_BASE, ping, 4U) == 4U) &&
+			(wait_for(&rx_done) == 0) && (memcmp(rx_buf, ping, 4U) == 0));
+
+	return failed;
+}
+
+static int dma_test(void)
+{
+	int failed = 0;
+
+	for (uint32_t i = 0U; i < 64U; i++) {
+		dma_src[i] = 0xA5000000UL | i;
+	}
+
+	__HAL_RCC_DMAMUX1_CLK_ENABLE();
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 5U, 0U);
+	HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+
+	hdma.Instance = DMA1_Channel1;
+	hdma.Init.Request = DMA_REQUEST_MEM2MEM;
+	hdma.Init.Direction = DMA_MEMORY_TO_MEMORY;
+	hdma.Init.PeriphInc = DMA_PINC_ENABLE;
+	hdma.Init.MemInc = DMA_MINC_ENABLE;
+	hdma.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+	hdma.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+	hdma.Init.Mode = DMA_NORMAL;
+	hdma.Init.Priority = DMA_PRIORITY_HIGH;
+	failed |= check("HAL_DMA_Init", HAL_DMA_Init(&hdma) == HAL_OK);
+
+	hdma.XferCpltCallback = dma_complete;
+	failed |= check("HAL_DMA_Start_IT",
+			(HAL_DMA_Start_IT(&hdma, (uint32_t)dma_src, (uint32_t)dma_dst, 64U) == HAL_OK) &&
+			(wait_for(&dma_done) == 0) &&
+			(memcmp(dma_src, dma_dst, sizeof(dma_src)) == 0));
+
+	return failed;
+}
+
+int main(void)
+{
+	struct regmodel_stats stats;
+	uint32_t tickstart;
+	int failed = 0;
+
+	if (regmodel_init() != 0) {
+		return 1;
+	}
+	regmodel_irq_connect(REGMODEL_SYSTICK_IRQN, systick_isr);
+	regmodel_irq_connect(USART1_IRQn, usart1_isr);
+	regmodel_irq_connect(DMA1_Channel1_IRQn, dma1_channel1_isr);
+
+	failed |= check("HAL_Init", HAL_Init() == HAL_OK);
+	failed |= check("SystemClock_Config", clock_config() == 0);
+	failed |= check("SystemCoreClock", SystemCoreClock == 170000000UL);
+
+	tickstart = HAL_GetTick();
+	HAL_Delay(10U);
+	failed |= check("HAL_Delay", (HAL_GetTick() - tickstart) >= 10U);
+
+	failed |= uart_test();
+	failed |= dma_test();
+
+	regmodel_stats_get(&stats);
+	printf("register reads %llu, writes %llu, exceptions %llu, events %llu\n",
+	       (unsigned long long)stats.reads, (unsigned long long)stats.writes,
+	       (unsigned long long)stats.exceptions, (unsigned long long)stats.events);
+
+	return failed;
+}
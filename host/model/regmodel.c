@@ -0,0 +1,1123 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Peripheral register model of the host build, see regmodel.h.
+ *
+ * All windows are views of one memfd. The device view sits at the device
+ * addresses, the backdoor view anywhere: peripheral models and the model
+ * thread only use the backdoor, so only the CPU thread faults.
+ *
+ * A CPU access to a trapped window raises SIGSEGV: the handler counts it,
+ * runs the read callback, unprotects the page and sets the x86 trap flag.
+ * The access instruction executes, raises SIGTRAP, and the second handler
+ * protects the page again and runs the write callback. SIG_IRQ is kept
+ * blocked in between, so interrupts are taken between two instructions.
+ */
+
+#define _GNU_SOURCE
+
+#include "regmodel.h"
+#include "cmsis_host.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#if !defined(__x86_64__) && !defined(__i386__)
+#error "The register model decodes x86 page faults"
+#endif
+
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0x100000
+#endif
+
+#define SIG_IRQ             SIGUSR1
+#if defined(__x86_64__)
+#define REG_PC              REG_RIP
+#else
+#define REG_PC              REG_EIP
+#endif
+#define EFLAGS_TF           0x100UL
+#define PF_ERR_WRITE        0x2UL
+
+#define EXC_SYSTICK         15
+#define EXC_PENDSV          14
+#define EXC_IRQ0            16
+#define EXC_MAX             (EXC_IRQ0 + 240)
+#define EVENTS_MAX          64U
+
+/* System Control Space, architectural addresses */
+#define NVIC_ISER           0xE000E100UL
+#define NVIC_ICER           0xE000E180UL
+#define NVIC_ISPR           0xE000E200UL
+#define NVIC_ICPR           0xE000E280UL
+#define NVIC_IABR           0xE000E300UL
+#define NVIC_IP             0xE000E400UL
+#define SCB_ICSR            0xE000ED04UL
+#define SCB_SHP             0xE000ED18UL
+#define SYSTICK_CTRL        0xE000E010UL
+#define SYSTICK_LOAD        0xE000E014UL
+#define SYSTICK_VAL         0xE000E018UL
+#define DWT_CYCCNT          0xE0001004UL
+
+#define ICSR_PENDSTSET      (1UL << 26)
+#define ICSR_PENDSTCLR      (1UL << 25)
+#define ICSR_PENDSVSET      (1UL << 28)
+#define ICSR_PENDSVCLR      (1UL << 27)
+#define ICSR_VECTACTIVE     0x1FFUL
+#define SYSTICK_ENABLE      (1UL << 0)
+#define SYSTICK_TICKINT     (1UL << 1)
+#define SYSTICK_CLKSOURCE   (1UL << 2)
+#define SYSTICK_COUNTFLAG   (1UL << 16)
+
+#define DEFAULT_CORE_CLOCK  16000000UL
+#define NSEC_PER_SEC        1000000000ULL
+
+/* SystemCoreClock of the system_stm32<series>.c built, when linked */
+extern uint32_t SystemCoreClock __attribute__((weak));
+
+struct window {
+	const char *name;
+	uint32_t base;
+	uint32_t size;
+	bool trapped;
+	uint8_t fill;
+	off_t offset;
+	uint8_t *backdoor;
+};
+
+static struct window windows[] = {
+	{ "flash",   0x08000000UL, 0x00200000UL, false, 0xFFU },
+	{ "ccmsram", 0x10000000UL, 0x00100000UL, false, 0x00U },
+	{ "system",  0x1FFF0000UL, 0x00010000UL, false, 0x00U },
+	{ "sram",    0x20000000UL, 0x00200000UL, false, 0x00U },
+	{ "periph",  0x40000000UL, 0x20000000UL, true,  0x00U },
+	{ "fmc",     0xA0000000UL, 0x00010000UL, true,  0x00U },
+	{ "core",    0xE0000000UL, 0x00100000UL, true,  0x00U },
+};
+
+#define WINDOWS_NBR         (sizeof(windows) / sizeof(windows[0]))
+
+struct event {
+	bool used;
+	bool lockstep;
+	uint64_t due;
+	regmodel_event_fn fn;
+	void *arg;
+};
+
+/* Access being single-stepped */
+static struct {
+	volatile sig_atomic_t active;
+	void *page;
+	uint32_t addr;
+	uint32_t size;
+	bool write;
+	uint32_t previous;
+	bool irq_blocked;
+	struct regmodel_periph *periph;
+} step;
+
+/* Emulated exception state of the CPU thread */
+static struct {
+	pthread_t thread;
+	volatile uint32_t primask;
+	volatile uint32_t basepri;
+	volatile uint32_t ipsr;
+	volatile uint32_t exclusive;
+	volatile bool systick_pending;
+	volatile bool pendsv_pending;
+	regmodel_isr_fn vectors[EXC_MAX];
+} cpu;
+
+static struct {
+	bool running;
+	uint64_t period;
+	uint64_t next;
+	bool countflag;
+} systick;
+
+static struct regmodel_stats stats;
+static uint64_t accesses;
+static uint32_t last_read;
+static bool lockstep;
+static struct regmodel_periph *periphs;
+static struct event events[EVENTS_MAX];
+static pthread_mutex_t model_mutex;
+static sigset_t irq_set;
+static __thread int lock_depth;
+static __thread sigset_t lock_saved;
+static size_t page_size;
+static int wake_fd = -1;
+static uint64_t start_time;
+
+static uint64_t events_run(uint64_t now, bool in_lockstep);
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * NSEC_PER_SEC) + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t core_clock(void)
+{
+	if ((&SystemCoreClock != NULL) && (SystemCoreClock != 0U)) {
+		return SystemCoreClock;
+	}
+	return DEFAULT_CORE_CLOCK;
+}
+
+/* The model lock is recursive and masks the interrupts of the CPU thread */
+static void model_lock(void)
+{
+	sigset_t saved;
+
+	pthread_sigmask(SIG_BLOCK, &irq_set, &saved);
+	pthread_mutex_lock(&model_mutex);
+	if (lock_depth++ == 0) {
+		lock_saved = saved;
+	}
+}
+
+static void model_unlock(void)
+{
+	sigset_t saved = lock_saved;
+	bool last = (--lock_depth == 0);
+
+	pthread_mutex_unlock(&model_mutex);
+	if (last) {
+		pthread_sigmask(SIG_SETMASK, &saved, NULL);
+	}
+}
+
+static void wake_model_thread(void)
+{
+	uint64_t one = 1U;
+
+	if (wake_fd >= 0) {
+		(void)!write(wake_fd, &one, sizeof(one));
+	}
+}
+
+static struct window *window_find(uintptr_t addr)
+{
+	for (size_t i = 0U; i < WINDOWS_NBR; i++) {
+		if ((addr >= windows[i].base) && ((addr - windows[i].base) < windows[i].size)) {
+			return &windows[i];
+		}
+	}
+	return NULL;
+}
+
+void *regmodel_backdoor(uint32_t addr)
+{
+	struct window *w = window_find(addr);
+
+	if (w == NULL) {
+		fprintf(stderr, "regmodel: 0x%08X is outside the model\n", addr);
+		abort();
+	}
+	return w->backdoor + (addr - w->base);
+}
+
+uint32_t regmodel_read(uint32_t addr)
+{
+	return *(volatile uint32_t *)regmodel_backdoor(addr);
+}
+
+void regmodel_write(uint32_t addr, uint32_t value)
+{
+	*(volatile uint32_t *)regmodel_backdoor(addr) = value;
+}
+
+void regmodel_set_bits(uint32_t addr, uint32_t bits)
+{
+	regmodel_write(addr, regmodel_read(addr) | bits);
+}
+
+void regmodel_clear_bits(uint32_t addr, uint32_t bits)
+{
+	regmodel_write(addr, regmodel_read(addr) & ~bits);
+}
+
+static uint8_t read_byte(uint32_t addr)
+{
+	return *(volatile uint8_t *)regmodel_backdoor(addr);
+}
+
+void regmodel_update_ready(struct regmodel_periph *periph, const struct regmodel_ready *table,
+			   size_t count)
+{
+	for (size_t i = 0U; i < count; i++) {
+		uint32_t addr = periph->base + table[i].offset;
+
+		if ((regmodel_read(addr) & table[i].enable) == table[i].enable) {
+			regmodel_set_bits(addr, table[i].ready);
+		} else {
+			regmodel_clear_bits(addr, table[i].ready);
+		}
+	}
+}
+
+void regmodel_attach(struct regmodel_periph *periph)
+{
+	model_lock();
+	periph->reads = 0U;
+	periph->writes = 0U;
+	periph->next = periphs;
+	periphs = periph;
+	model_unlock();
+}
+
+struct regmodel_periph *regmodel_find(uint32_t addr)
+{
+	for (struct regmodel_periph *p = periphs; p != NULL; p = p->next) {
+		if ((addr >= p->base) && ((addr - p->base) < p->size)) {
+			return p;
+		}
+	}
+	return NULL;
+}
+
+/* Exceptions ----------------------------------------------------------------*/
+
+static uint32_t exception_priority(int exc)
+{
+	if (exc < EXC_IRQ0) {
+		return read_byte(SCB_SHP + (uint32_t)exc - 4U);
+	}
+	return read_byte(NVIC_IP + (uint32_t)(exc - EXC_IRQ0));
+}
+
+/* Highest priority exception pending and enabled, -1 if none */
+static int exception_next(bool masked)
+{
+	int best = -1;
+	uint32_t best_priority = 0x100U;
+	int candidates[2] = { cpu.pendsv_pending ? EXC_PENDSV : -1,
+			      cpu.systick_pending ? EXC_SYSTICK : -1 };
+
+	if (masked && (cpu.primask != 0U)) {
+		return -1;
+	}
+
+	for (size_t i = 0U; i < 2U; i++) {
+		if (candidates[i] >= 0) {
+			uint32_t priority = exception_priority(candidates[i]);
+
+			if (priority < best_priority) {
+				best = candidates[i];
+				best_priority = priority;
+			}
+		}
+	}
+
+	for (uint32_t word = 0U; word < 8U; word++) {
+		uint32_t ready = regmodel_read(NVIC_ISPR + (4U * word)) &
+				 regmodel_read(NVIC_ISER + (4U * word));
+
+		while (ready != 0U) {
+			uint32_t bit = (uint32_t)__builtin_ctz(ready);
+			int exc = EXC_IRQ0 + (int)((32U * word) + bit);
+			uint32_t priority = exception_priority(exc);
+
+			ready &= ready - 1U;
+			if (priority < best_priority) {
+				best = exc;
+				best_priority = priority;
+			}
+		}
+	}
+
+	if (masked && (best >= 0) && (cpu.basepri != 0U) && (best_priority >= cpu.basepri)) {
+		return -1;
+	}
+	return best;
+}
+
+static void irq_word_update(uint32_t set_addr, uint32_t clear_addr, uint32_t word, uint32_t value)
+{
+	regmodel_write(set_addr + (4U * word), value);
+	regmodel_write(clear_addr + (4U * word), value);
+}
+
+/* Signal the CPU thread when an exception can be taken */
+static void exception_kick(void)
+{
+	if (exception_next(true) >= 0) {
+		pthread_kill(cpu.thread, SIG_IRQ);
+	}
+}
+
+static void exception_set_active(int exc, bool active)
+{
+	if (exc >= EXC_IRQ0) {
+		uint32_t irq = (uint32_t)(exc - EXC_IRQ0);
+		uint32_t addr = NVIC_IABR + (4U * (irq / 32U));
+
+		if (active) {
+			regmodel_set_bits(addr, 1UL << (irq % 32U));
+		} else {
+			regmodel_clear_bits(addr, 1UL << (irq % 32U));
+		}
+	}
+}
+
+static void exception_dispatch(void)
+{
+	for (;;) {
+		regmodel_isr_fn isr;
+		uint32_t ipsr;
+		int exc;
+
+		model_lock();
+		exc = exception_next(true);
+		if (exc < 0) {
+			model_unlock();
+			return;
+		}
+		if (exc == EXC_SYSTICK) {
+			cpu.systick_pending = false;
+		} else if (exc == EXC_PENDSV) {
+			cpu.pendsv_pending = false;
+		} else {
+			uint32_t irq = (uint32_t)(exc - EXC_IRQ0);
+			uint32_t word = irq / 32U;
+
+			irq_word_update(NVIC_ISPR, NVIC_ICPR, word,
+					regmodel_read(NVIC_ISPR + (4U * word)) & ~(1UL << (irq % 32U)));
+		}
+		exception_set_active(exc, true);
+		stats.exceptions++;
+		isr = cpu.vectors[exc];
+		model_unlock();
+
+		if (isr == NULL) {
+			fprintf(stderr, "regmodel: no handler for IRQ %d\n", exc - EXC_IRQ0);
+			abort();
+		}
+
+		ipsr = cpu.ipsr;
+		cpu.ipsr = (uint32_t)exc;
+		cpu.exclusive = 0U;
+		isr();
+		cpu.ipsr = ipsr;
+		cpu.exclusive = 0U;
+
+		model_lock();
+		exception_set_active(exc, false);
+		model_unlock();
+	}
+}
+
+static void irq_signal_handler(int sig)
+{
+	int saved_errno = errno;
+
+	(void)sig;
+	exception_dispatch();
+	errno = saved_errno;
+}
+
+void regmodel_irq_connect(int irqn, regmodel_isr_fn isr)
+{
+	model_lock();
+	cpu.vectors[EXC_IRQ0 + irqn] = isr;
+	model_unlock();
+}
+
+void regmodel_irq_raise(int irqn)
+{
+	model_lock();
+	if (irqn == REGMODEL_SYSTICK_IRQN) {
+		cpu.systick_pending = true;
+	} else if (irqn == REGMODEL_PENDSV_IRQN) {
+		cpu.pendsv_pending = true;
+	} else {
+		uint32_t word = (uint32_t)irqn / 32U;
+
+		irq_word_update(NVIC_ISPR, NVIC_ICPR, word,
+				regmodel_read(NVIC_ISPR + (4U * word)) | (1UL << ((uint32_t)irqn % 32U)));
+	}
+	exception_kick();
+	model_unlock();
+}
+
+/* CPU state, see cmsis_host.h ------------------------------------------------*/
+
+void regmodel_cpu_set_primask(uint32_t primask)
+{
+	model_lock();
+	cpu.primask = primask;
+	exception_kick();
+	model_unlock();
+}
+
+uint32_t regmodel_cpu_get_primask(void)
+{
+	return cpu.primask;
+}
+
+void regmodel_cpu_set_basepri(uint32_t basepri)
+{
+	model_lock();
+	cpu.basepri = basepri;
+	exception_kick();
+	model_unlock();
+}
+
+uint32_t regmodel_cpu_get_basepri(void)
+{
+	return cpu.basepri;
+}
+
+uint32_t regmodel_cpu_get_ipsr(void)
+{
+	return cpu.ipsr;
+}
+
+void regmodel_cpu_wait_for_interrupt(void)
+{
+	uint64_t taken = stats.exceptions;
+	struct timespec ts = { 0, 20000L };
+
+	stats.sleeps++;
+
+	/* Wakes up on a pending exception even when masked, as the core does */
+	for (;;) {
+		bool pending;
+
+		model_lock();
+		if (lockstep) {
+			/* Nothing else advances the time: jump to the next events */
+			(void)events_run(UINT64_MAX, true);
+		}
+		pending = (exception_next(false) >= 0);
+		model_unlock();
+		if (pending || (stats.exceptions != taken)) {
+			return;
+		}
+		nanosleep(&ts, NULL);
+	}
+}
+
+void regmodel_cpu_set_exclusive(void)
+{
+	cpu.exclusive = 1U;
+}
+
+uint32_t regmodel_cpu_test_exclusive(void)
+{
+	uint32_t exclusive = cpu.exclusive;
+
+	cpu.exclusive = 0U;
+	return exclusive;
+}
+
+void regmodel_cpu_clear_exclusive(void)
+{
+	cpu.exclusive = 0U;
+}
+
+void regmodel_cpu_breakpoint(uint32_t value)
+{
+	fprintf(stderr, "regmodel: breakpoint %u\n", value);
+	abort();
+}
+
+/* Core peripheral models ------------------------------------------------------*/
+
+static void nvic_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		       uint32_t previous)
+{
+	uint32_t addr = periph->base + offset;
+	uint32_t word = (offset & 0x7FU) / 4U;
+
+	if (offset >= 0x300U) {
+		/* IABR read-only, IP plain storage */
+		if (offset < 0x320U) {
+			regmodel_write(addr, previous);
+		}
+		return;
+	}
+	if (word >= 8U) {
+		return;
+	}
+	switch (offset & ~0x7FU) {
+	case 0x000U: /* ISER */
+		irq_word_update(NVIC_ISER, NVIC_ICER, word, previous | value);
+		break;
+	case 0x080U: /* ICER */
+		irq_word_update(NVIC_ISER, NVIC_ICER, word, previous & ~value);
+		break;
+	case 0x100U: /* ISPR */
+		irq_word_update(NVIC_ISPR, NVIC_ICPR, word, previous | value);
+		break;
+	case 0x180U: /* ICPR */
+		irq_word_update(NVIC_ISPR, NVIC_ICPR, word, previous & ~value);
+		break;
+	default:
+		break;
+	}
+	exception_kick();
+}
+
+static struct regmodel_periph nvic_model = {
+	.name = "NVIC",
+	.base = NVIC_ISER,
+	.size = 0x400U,
+	.write = nvic_write,
+};
+
+static void scb_read(struct regmodel_periph *periph, uint32_t offset)
+{
+	if (periph->base + offset == SCB_ICSR) {
+		uint32_t icsr = (cpu.ipsr & ICSR_VECTACTIVE);
+
+		icsr |= cpu.systick_pending ? ICSR_PENDSTSET : 0U;
+		icsr |= cpu.pendsv_pending ? ICSR_PENDSVSET : 0U;
+		regmodel_write(SCB_ICSR, icsr);
+	}
+}
+
+static void scb_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	(void)previous;
+
+	if (periph->base + offset == SCB_ICSR) {
+		if ((value & ICSR_PENDSTSET) != 0U) {
+			cpu.systick_pending = true;
+		}
+		if ((value & ICSR_PENDSTCLR) != 0U) {
+			cpu.systick_pending = false;
+		}
+		if ((value & ICSR_PENDSVSET) != 0U) {
+			cpu.pendsv_pending = true;
+		}
+		if ((value & ICSR_PENDSVCLR) != 0U) {
+			cpu.pendsv_pending = false;
+		}
+		exception_kick();
+	} else {
+		/* Exception priorities */
+		exception_kick();
+	}
+}
+
+static struct regmodel_periph scb_model = {
+	.name = "SCB",
+	.base = 0xE000ED00UL,
+	.size = 0x90U,
+	.read = scb_read,
+	.write = scb_write,
+};
+
+static void systick_read(struct regmodel_periph *periph, uint32_t offset)
+{
+	uint32_t addr = periph->base + offset;
+
+	if (addr == SYSTICK_CTRL) {
+		if (systick.countflag) {
+			regmodel_set_bits(SYSTICK_CTRL, SYSTICK_COUNTFLAG);
+			systick.countflag = false;
+		} else {
+			regmodel_clear_bits(SYSTICK_CTRL, SYSTICK_COUNTFLAG);
+		}
+	} else if ((addr == SYSTICK_VAL) && systick.running) {
+		uint64_t now = now_ns();
+		uint64_t left = (systick.next > now) ? (systick.next - now) : 0U;
+		uint64_t reload = regmodel_read(SYSTICK_LOAD) & 0xFFFFFFUL;
+		uint64_t value = (left * (reload + 1U)) / systick.period;
+
+		regmodel_write(SYSTICK_VAL, (uint32_t)((value > reload) ? reload : value));
+	}
+}
+
+static void systick_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+			  uint32_t previous)
+{
+	(void)value;
+	(void)previous;
+
+	if (periph->base + offset == SYSTICK_VAL) {
+		regmodel_write(SYSTICK_VAL, 0U);
+		systick.countflag = false;
+	}
+	/* Period or enable changed, restart the counter */
+	systick.running = false;
+	wake_model_thread();
+}
+
+static struct regmodel_periph systick_model = {
+	.name = "SysTick",
+	.base = SYSTICK_CTRL,
+	.size = 0x10U,
+	.read = systick_read,
+	.write = systick_write,
+};
+
+static void dwt_read(struct regmodel_periph *periph, uint32_t offset)
+{
+	if (periph->base + offset == DWT_CYCCNT) {
+		uint64_t cycles = ((now_ns() - start_time) * core_clock()) / NSEC_PER_SEC;
+
+		regmodel_write(DWT_CYCCNT, (uint32_t)cycles);
+	}
+}
+
+static struct regmodel_periph dwt_model = {
+	.name = "DWT",
+	.base = 0xE0001000UL,
+	.size = 0x1000U,
+	.read = dwt_read,
+};
+
+/* Traps -------------------------------------------------------------------------*/
+
+/*
+ * Run the events due, on the model thread by time or in lockstep on the CPU
+ * thread by register access count. Returns the next due time of the kind.
+ */
+static uint64_t events_run(uint64_t now, bool in_lockstep)
+{
+	uint64_t next = UINT64_MAX;
+
+	for (;;) {
+		struct event *due = NULL;
+
+		for (size_t i = 0U; i < EVENTS_MAX; i++) {
+			if (events[i].used && (events[i].lockstep == in_lockstep) &&
+			    (events[i].due <= now) &&
+			    ((due == NULL) || (events[i].due < due->due))) {
+				due = &events[i];
+			}
+		}
+		if (due == NULL) {
+			break;
+		}
+		due->used = false;
+		stats.events++;
+		due->fn(due->arg);
+	}
+
+	for (size_t i = 0U; i < EVENTS_MAX; i++) {
+		if (events[i].used && (events[i].lockstep == in_lockstep) &&
+		    (events[i].due < next)) {
+			next = events[i].due;
+		}
+	}
+	return next;
+}
+
+
+static void trap_default(int sig)
+{
+	signal(sig, SIG_DFL);
+}
+
+/*
+ * Width of the access of the faulting instruction, for the moves, the
+ * zero/sign extensions and the ALU operations the compiler emits on volatile
+ * registers. 4 for an instruction not decoded.
+ */
+static uint32_t access_size(const uint8_t *ip)
+{
+	bool operand16 = false;
+	bool rex_w = false;
+	uint8_t op;
+
+	for (;; ip++) {
+		if (*ip == 0x66U) {
+			operand16 = true;
+		} else if ((*ip != 0x67U) && (*ip != 0xF2U) && (*ip != 0xF3U) && (*ip != 0x2EU) &&
+			   (*ip != 0x3EU) && (*ip != 0x26U) && (*ip != 0x36U) && (*ip != 0x64U) &&
+			   (*ip != 0x65U)) {
+			break;
+		}
+	}
+#if defined(__x86_64__)
+	if ((*ip & 0xF0U) == 0x40U) {
+		rex_w = ((*ip & 0x08U) != 0U);
+		ip++;
+	}
+#endif
+
+	op = ip[0];
+	if (op == 0x0FU) {
+		switch (ip[1]) {
+		case 0xB6U: /* movzx, movsx */
+		case 0xBEU:
+			return 1U;
+		case 0xB7U:
+		case 0xBFU:
+			return 2U;
+		default:
+			return 4U;
+		}
+	}
+	if ((op == 0x88U) || (op == 0x89U) || (op == 0x8AU) || (op == 0x8BU) || (op == 0xC6U) ||
+	    (op == 0xC7U) || (op == 0x84U) || (op == 0x85U) || (op == 0xF6U) || (op == 0xF7U) ||
+	    ((op >= 0x80U) && (op <= 0x83U)) || ((op < 0x40U) && ((op & 0x07U) < 0x04U))) {
+		/* Even opcodes and 0x80 operate on bytes */
+		if (((op & 0x01U) == 0U) && (op != 0x82U)) {
+			return 1U;
+		}
+		if (rex_w) {
+			return 8U;
+		}
+		return operand16 ? 2U : 4U;
+	}
+	return 4U;
+}
+
+uint32_t regmodel_access_size(void)
+{
+	return step.size;
+}
+
+static void segv_handler(int sig, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = context;
+	uintptr_t addr = (uintptr_t)info->si_addr;
+	struct window *w = window_find(addr);
+	struct regmodel_periph *periph;
+
+	if ((w == NULL) || !w->trapped || step.active) {
+		/* Not a model access, let it crash */
+		trap_default(sig);
+		return;
+	}
+
+	model_lock();
+	step.addr = (uint32_t)addr & ~3U;
+	step.size = access_size((const uint8_t *)uc->uc_mcontext.gregs[REG_PC]);
+	step.write = (((uint64_t)uc->uc_mcontext.gregs[REG_ERR] & PF_ERR_WRITE) != 0U);
+	step.periph = periph = regmodel_find(step.addr);
+	accesses++;
+	if (step.write) {
+		stats.writes++;
+		last_read = 0U;
+		step.previous = regmodel_read(step.addr);
+		if (periph != NULL) {
+			periph->writes++;
+		}
+	} else {
+		stats.reads++;
+		/* Same register read again: an iteration of a polling loop */
+		if ((last_read == (uint32_t)addr) && (periph != NULL)) {
+			stats.polls++;
+		}
+		last_read = (uint32_t)addr;
+		if (periph != NULL) {
+			periph->reads++;
+			if (periph->read != NULL) {
+				periph->read(periph, step.addr - periph->base);
+			}
+		}
+	}
+	model_unlock();
+
+	step.page = (void *)(addr & ~(uintptr_t)(page_size - 1U));
+	step.active = 1;
+	mprotect(step.page, page_size, PROT_READ | PROT_WRITE);
+
+	/* Execute the access alone, with the interrupts held off */
+	step.irq_blocked = (sigismember(&uc->uc_sigmask, SIG_IRQ) == 1);
+	sigaddset(&uc->uc_sigmask, SIG_IRQ);
+	uc->uc_mcontext.gregs[REG_EFL] |= EFLAGS_TF;
+}
+
+static void trap_handler(int sig, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = context;
+	struct regmodel_periph *periph = step.periph;
+
+	(void)info;
+
+	if (!step.active) {
+		trap_default(sig);
+		return;
+	}
+
+	mprotect(step.page, page_size, PROT_NONE);
+	uc->uc_mcontext.gregs[REG_EFL] &= ~EFLAGS_TF;
+	step.active = 0;
+
+	model_lock();
+	if (step.write && (periph != NULL) && (periph->write != NULL)) {
+		periph->write(periph, step.addr - periph->base, regmodel_read(step.addr), step.previous);
+	}
+	if (lockstep) {
+		(void)events_run(accesses, true);
+	}
+	model_unlock();
+
+	if (!step.irq_blocked) {
+		sigdelset(&uc->uc_sigmask, SIG_IRQ);
+	}
+}
+
+/* Model thread ----------------------------------------------------------------*/
+
+static void systick_update(uint64_t now)
+{
+	uint32_t ctrl = regmodel_read(SYSTICK_CTRL);
+
+	if ((ctrl & SYSTICK_ENABLE) == 0U) {
+		systick.running = false;
+		return;
+	}
+
+	if (!systick.running) {
+		uint64_t ticks = (uint64_t)(regmodel_read(SYSTICK_LOAD) & 0xFFFFFFUL) + 1U;
+
+		if ((ctrl & SYSTICK_CLKSOURCE) == 0U) {
+			ticks *= 8U;
+		}
+		systick.period = (ticks * NSEC_PER_SEC) / core_clock();
+		if (systick.period == 0U) {
+			systick.period = 1U;
+		}
+		systick.next = now + systick.period;
+		systick.running = true;
+		return;
+	}
+
+	if (now >= systick.next) {
+		systick.countflag = true;
+		if ((ctrl & SYSTICK_TICKINT) != 0U) {
+			cpu.systick_pending = true;
+		}
+		systick.next += systick.period;
+		if (now >= systick.next) {
+			/* Late, the host was busy: skip the ticks missed */
+			systick.next = now + systick.period;
+		}
+	}
+}
+
+static void *model_thread(void *arg)
+{
+	(void)arg;
+
+	for (;;) {
+		struct pollfd pfd = { .fd = wake_fd, .events = POLLIN };
+		uint64_t now = now_ns();
+		uint64_t next;
+		struct timespec ts;
+		uint64_t count;
+
+		model_lock();
+		systick_update(now);
+		next = events_run(now, false);
+		if (systick.running && (systick.next < next)) {
+			next = systick.next;
+		}
+		exception_kick();
+		model_unlock();
+
+		if (next == UINT64_MAX) {
+			(void)ppoll(&pfd, 1, NULL, NULL);
+		} else {
+			uint64_t wait = (next > now) ? (next - now) : 0U;
+
+			ts.tv_sec = (time_t)(wait / NSEC_PER_SEC);
+			ts.tv_nsec = (long)(wait % NSEC_PER_SEC);
+			(void)ppoll(&pfd, 1, &ts, NULL);
+		}
+		if ((pfd.revents & POLLIN) != 0) {
+			(void)!read(wake_fd, &count, sizeof(count));
+		}
+	}
+	return NULL;
+}
+
+int regmodel_defer(uint32_t delay_us, regmodel_event_fn fn, void *arg)
+{
+	int ret = -1;
+
+	model_lock();
+	for (size_t i = 0U; i < EVENTS_MAX; i++) {
+		if (!events[i].used) {
+			events[i].used = true;
+			events[i].lockstep = lockstep;
+			if (lockstep) {
+				events[i].due = accesses + ((delay_us != 0U) ? delay_us : 1U);
+			} else {
+				events[i].due = now_ns() + ((uint64_t)delay_us * 1000U);
+			}
+			events[i].fn = fn;
+			events[i].arg = arg;
+			ret = 0;
+			break;
+		}
+	}
+	model_unlock();
+
+	if (ret == 0) {
+		wake_model_thread();
+	}
+	return ret;
+}
+
+void regmodel_set_lockstep(int enable)
+{
+	model_lock();
+	lockstep = (enable != 0);
+	model_unlock();
+}
+
+/* Statistics --------------------------------------------------------------------*/
+
+void regmodel_stats_get(struct regmodel_stats *out)
+{
+	model_lock();
+	*out = stats;
+	model_unlock();
+}
+
+void regmodel_stats_reset(void)
+{
+	model_lock();
+	memset(&stats, 0, sizeof(stats));
+	last_read = 0U;
+	for (struct regmodel_periph *p = periphs; p != NULL; p = p->next) {
+		p->reads = 0U;
+		p->writes = 0U;
+	}
+	model_unlock();
+}
+
+#if !defined(REGMODEL_SERIES)
+void regmodel_series_init(void)
+{
+}
+#endif
+
+/* Initialization ----------------------------------------------------------------*/
+
+static int windows_map(void)
+{
+	off_t total = 0;
+	uint8_t *backdoor;
+	int fd;
+
+	for (size_t i = 0U; i < WINDOWS_NBR; i++) {
+		windows[i].offset = total;
+		total += (off_t)windows[i].size;
+	}
+
+	fd = memfd_create("regmodel", MFD_CLOEXEC);
+	if ((fd < 0) || (ftruncate(fd, total) != 0)) {
+		perror("regmodel: memfd");
+		return -1;
+	}
+
+	backdoor = mmap(NULL, (size_t)total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (backdoor == MAP_FAILED) {
+		perror("regmodel: backdoor");
+		return -1;
+	}
+
+	for (size_t i = 0U; i < WINDOWS_NBR; i++) {
+		struct window *w = &windows[i];
+		void *device = mmap((void *)(uintptr_t)w->base, w->size,
+				    w->trapped ? PROT_NONE : (PROT_READ | PROT_WRITE),
+				    MAP_SHARED | MAP_FIXED_NOREPLACE, fd, w->offset);
+
+		if (device != (void *)(uintptr_t)w->base) {
+			fprintf(stderr, "regmodel: cannot map %s at 0x%08X, build without PIE\n",
+				w->name, w->base);
+			return -1;
+		}
+		w->backdoor = backdoor + w->offset;
+		if (w->fill != 0U) {
+			memset(w->backdoor, w->fill, w->size);
+		}
+	}
+
+	close(fd);
+	return 0;
+}
+
+static int signals_install(void)
+{
+	struct sigaction sa;
+
+	memset(&sa, 0, sizeof(sa));
+	sigemptyset(&sa.sa_mask);
+	sigaddset(&sa.sa_mask, SIG_IRQ);
+	sa.sa_flags = SA_SIGINFO;
+	sa.sa_sigaction = segv_handler;
+	if (sigaction(SIGSEGV, &sa, NULL) != 0) {
+		return -1;
+	}
+	sa.sa_sigaction = trap_handler;
+	if (sigaction(SIGTRAP, &sa, NULL) != 0) {
+		return -1;
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sigemptyset(&sa.sa_mask);
+	sa.sa_handler = irq_signal_handler;
+	return sigaction(SIG_IRQ, &sa, NULL);
+}
+
+int regmodel_init(void)
+{
+	pthread_mutexattr_t attr;
+	pthread_t thread;
+	sigset_t saved;
+
+	page_size = (size_t)sysconf(_SC_PAGESIZE);
+	start_time = now_ns();
+	cpu.thread = pthread_self();
+	sigemptyset(&irq_set);
+	sigaddset(&irq_set, SIG_IRQ);
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&model_mutex, &attr);
+
+	if (windows_map() != 0) {
+		return -1;
+	}
+
+	wake_fd = eventfd(0U, EFD_CLOEXEC | EFD_NONBLOCK);
+	if ((wake_fd < 0) || (signals_install() != 0)) {
+		perror("regmodel: signals");
+		return -1;
+	}
+
+	regmodel_attach(&nvic_model);
+	regmodel_attach(&scb_model);
+	regmodel_attach(&systick_model);
+	regmodel_attach(&dwt_model);
+	regmodel_series_init();
+
+	/* The model thread never takes the emulated interrupts */
+	pthread_sigmask(SIG_BLOCK, &irq_set, &saved);
+	if (pthread_create(&thread, NULL, model_thread, NULL) != 0) {
+		fprintf(stderr, "regmodel: cannot start the model thread\n");
+		return -1;
+	}
+	pthread_sigmask(SIG_SETMASK, &saved, NULL);
+	pthread_detach(thread);
+
+	return 0;
+}
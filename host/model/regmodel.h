@@ -0,0 +1,180 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Peripheral register model of the host build.
+ *
+ * The memory map of the device is backed by host memory at the same
+ * addresses, so the HAL/LL sources run unmodified: the base addresses of the
+ * device header are plain host pointers.
+ *
+ * Memories (flash, SRAM, system memory) are ordinary read/write pages. The
+ * peripheral and core windows are trapped: every CPU access faults, is
+ * counted, goes through the read/write callbacks of the peripheral model
+ * attached at that address, and is then single-stepped. Peripheral models
+ * update the registers through the backdoor accessors below, which never
+ * trap, raise interrupts and defer hardware events to the model thread.
+ *
+ * Interrupts are taken by the thread that called regmodel_init() (the CPU
+ * thread) between two instructions, honoring the NVIC enable, PRIMASK and
+ * BASEPRI. Handlers do not nest.
+ *
+ * Requires Linux on x86 (fault decoding and single-step). Only the CPU thread
+ * may access the device view of the trapped windows.
+ */
+
+#ifndef REGMODEL_H
+#define REGMODEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Exception numbers of the core handlers, as IRQn_Type */
+#define REGMODEL_PENDSV_IRQN   (-2)
+#define REGMODEL_SYSTICK_IRQN  (-1)
+
+struct regmodel_periph;
+
+/**
+ * @brief Called before the CPU reads a register of the peripheral.
+ *
+ * May update the register with regmodel_write() to return the value the
+ * hardware would, e.g. pop a receive FIFO or refresh a counter.
+ *
+ * @param periph Peripheral model.
+ * @param offset Offset of the 32-bit register read.
+ */
+typedef void (*regmodel_read_fn)(struct regmodel_periph *periph, uint32_t offset);
+
+/**
+ * @brief Called after the CPU wrote a register of the peripheral.
+ *
+ * The register holds the value written. The model fixes up the bits with a
+ * different behavior, e.g. restores the write-1-to-clear flags from
+ * @p previous, and starts the operation the write triggers.
+ *
+ * @param periph Peripheral model.
+ * @param offset Offset of the 32-bit register written.
+ * @param value Register content after the write.
+ * @param previous Register content before the write.
+ */
+typedef void (*regmodel_write_fn)(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+				  uint32_t previous);
+
+/** Model of a peripheral, attached to its address range */
+struct regmodel_periph {
+	const char *name;
+	uint32_t base;
+	uint32_t size;
+	regmodel_read_fn read;
+	regmodel_write_fn write;
+	void *data;
+	/* Maintained by the model */
+	uint64_t reads;
+	uint64_t writes;
+	struct regmodel_periph *next;
+};
+
+/** Enable bit of a register and the ready bit following it */
+struct regmodel_ready {
+	uint32_t offset;
+	uint32_t enable;
+	uint32_t ready;
+};
+
+/** Counters of the model, since regmodel_init() or regmodel_stats_reset() */
+struct regmodel_stats {
+	uint64_t reads;       /* CPU reads of the trapped windows */
+	uint64_t writes;      /* CPU writes of the trapped windows */
+	uint64_t polls;       /* Reads of the modelled register read just before */
+	uint64_t exceptions;  /* Handlers run, IRQs and SysTick */
+	uint64_t events;      /* Deferred hardware events run */
+	uint64_t sleeps;      /* __WFI()/__WFE() */
+};
+
+typedef void (*regmodel_isr_fn)(void);
+typedef void (*regmodel_event_fn)(void *arg);
+
+/**
+ * @brief Map the memory windows, install the trap handlers, start the model
+ * thread and attach the core and series peripheral models.
+ *
+ * The calling thread becomes the CPU thread.
+ *
+ * @return 0 on success, -1 with a message on stderr otherwise.
+ */
+int regmodel_init(void);
+
+/** @brief Attach a peripheral model, @p periph is to remain valid. */
+void regmodel_attach(struct regmodel_periph *periph);
+
+/** @brief Peripheral model attached at an address, NULL if none. */
+struct regmodel_periph *regmodel_find(uint32_t addr);
+
+/* Backdoor accessors, not trapped nor counted */
+void *regmodel_backdoor(uint32_t addr);
+uint32_t regmodel_read(uint32_t addr);
+void regmodel_write(uint32_t addr, uint32_t value);
+void regmodel_set_bits(uint32_t addr, uint32_t bits);
+void regmodel_clear_bits(uint32_t addr, uint32_t bits);
+
+/**
+ * @brief Follow enable bits with their ready bits, for the oscillator, PLL or
+ * peripheral enable acknowledgments waited by the HAL.
+ */
+void regmodel_update_ready(struct regmodel_periph *periph, const struct regmodel_ready *table,
+			   size_t count);
+
+/** @brief Set the handler of an exception, by IRQ number. */
+void regmodel_irq_connect(int irqn, regmodel_isr_fn isr);
+
+/**
+ * @brief Set an interrupt pending, from any thread or callback.
+ *
+ * The handler runs on the CPU thread once the IRQ is enabled and unmasked.
+ */
+void regmodel_irq_raise(int irqn);
+
+/**
+ * @brief Run a hardware event on the model thread after a delay.
+ *
+ * @return 0 on success, -1 when the event queue is full.
+ */
+int regmodel_defer(uint32_t delay_us, regmodel_event_fn fn, void *arg);
+
+/**
+ * @brief Width in bytes of the CPU access, valid in the read/write callbacks.
+ */
+uint32_t regmodel_access_size(void);
+
+/**
+ * @brief Run the deferred events in lockstep with the CPU.
+ *
+ * The delay of regmodel_defer() counts trapped register accesses instead of
+ * microseconds, and the events run on the CPU thread. __WFI() runs the next
+ * events at once. With the SysTick stopped, the accesses a driver makes are
+ * then independent of the host load.
+ */
+void regmodel_set_lockstep(int enable);
+
+void regmodel_stats_get(struct regmodel_stats *stats);
+void regmodel_stats_reset(void);
+
+/**
+ * @brief Attach the peripheral models of the series, called by regmodel_init().
+ *
+ * Defined by the regmodel_<series>.c of the series built, which the build
+ * flags with REGMODEL_SERIES. Attaches nothing for a series without models.
+ */
+void regmodel_series_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REGMODEL_H */
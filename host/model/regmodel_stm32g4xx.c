@@ -0,0 +1,890 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "regmodel.h"
+#include "regmodel_stm32g4xx.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "stm32g4xx.h"
+
+#define REG(periph, type, reg)  ((periph)->base + (uint32_t)offsetof(type, reg))
+
+/* RCC -----------------------------------------------------------------------*/
+
+static const struct regmodel_ready rcc_ready[] = {
+	{ offsetof(RCC_TypeDef, CR), RCC_CR_HSION, RCC_CR_HSIRDY },
+	{ offsetof(RCC_TypeDef, CR), RCC_CR_HSEON, RCC_CR_HSERDY },
+	{ offsetof(RCC_TypeDef, CR), RCC_CR_PLLON, RCC_CR_PLLRDY },
+	{ offsetof(RCC_TypeDef, CSR), RCC_CSR_LSION, RCC_CSR_LSIRDY },
+	{ offsetof(RCC_TypeDef, BDCR), RCC_BDCR_LSEON, RCC_BDCR_LSERDY },
+	{ offsetof(RCC_TypeDef, CRRCR), RCC_CRRCR_HSI48ON, RCC_CRRCR_HSI48RDY },
+};
+
+static void rcc_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	(void)previous;
+
+	if (offset == offsetof(RCC_TypeDef, CFGR)) {
+		/* The switch completes at once */
+		value &= ~RCC_CFGR_SWS;
+		value |= (value & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos;
+		regmodel_write(periph->base + offset, value);
+	} else {
+		regmodel_update_ready(periph, rcc_ready, sizeof(rcc_ready) / sizeof(rcc_ready[0]));
+	}
+}
+
+static struct regmodel_periph rcc_model = {
+	.name = "RCC",
+	.base = RCC_BASE,
+	.size = sizeof(RCC_TypeDef),
+	.write = rcc_write,
+};
+
+/* U(S)ART ---------------------------------------------------------------------*/
+
+#define UART_QUEUE_SIZE  256U
+
+struct uart_queue {
+	uint8_t data[UART_QUEUE_SIZE];
+	size_t head;
+	size_t count;
+};
+
+struct uart_data {
+	int irqn;
+	struct uart_queue rx;
+	struct uart_queue tx;
+};
+
+#define UART_ISR_CLEARABLE  (USART_ISR_PE | USART_ISR_FE | USART_ISR_NE | USART_ISR_ORE | \
+			     USART_ISR_IDLE | USART_ISR_TC | USART_ISR_LBDF | USART_ISR_CTSIF | \
+			     USART_ISR_RTOF | USART_ISR_EOBF | USART_ISR_CMF | USART_ISR_WUF)
+
+static bool queue_push(struct uart_queue *q, uint8_t byte)
+{
+	if (q->count == UART_QUEUE_SIZE) {
+		return false;
+	}
+	q->data[(q->head + q->count) % UART_QUEUE_SIZE] = byte;
+	q->count++;
+	return true;
+}
+
+static bool queue_pop(struct uart_queue *q, uint8_t *byte)
+{
+	if (q->count == 0U) {
+		return false;
+	}
+	*byte = q->data[q->head];
+	q->head = (q->head + 1U) % UART_QUEUE_SIZE;
+	q->count--;
+	return true;
+}
+
+/* Interrupt line of the U(S)ART, level sensitive */
+static void uart_update(struct regmodel_periph *periph)
+{
+	struct uart_data *uart = periph->data;
+	uint32_t cr1 = regmodel_read(REG(periph, USART_TypeDef, CR1));
+	uint32_t isr = regmodel_read(REG(periph, USART_TypeDef, ISR));
+	uint32_t set = 0U;
+
+	if ((cr1 & USART_CR1_UE) == 0U) {
+		return;
+	}
+	if ((cr1 & USART_CR1_TE) != 0U) {
+		set |= USART_ISR_TEACK | USART_ISR_TXE;
+	}
+	if ((cr1 & USART_CR1_RE) != 0U) {
+		set |= USART_ISR_REACK;
+		if (uart->rx.count != 0U) {
+			set |= USART_ISR_RXNE;
+		}
+	}
+	isr = (isr & ~(USART_ISR_TEACK | USART_ISR_REACK | USART_ISR_TXE | USART_ISR_RXNE)) | set;
+	regmodel_write(REG(periph, USART_TypeDef, ISR), isr);
+
+	if ((((cr1 & USART_CR1_TXEIE) != 0U) && ((isr & USART_ISR_TXE) != 0U)) ||
+	    (((cr1 & USART_CR1_TCIE) != 0U) && ((isr & USART_ISR_TC) != 0U)) ||
+	    (((cr1 & USART_CR1_RXNEIE) != 0U) && ((isr & USART_ISR_RXNE) != 0U))) {
+		regmodel_irq_raise(uart->irqn);
+	}
+}
+
+static void uart_read(struct regmodel_periph *periph, uint32_t offset)
+{
+	struct uart_data *uart = periph->data;
+	uint8_t byte;
+
+	if ((offset == offsetof(USART_TypeDef, RDR)) && queue_pop(&uart->rx, &byte)) {
+		regmodel_write(periph->base + offset, byte);
+		uart_update(periph);
+	}
+}
+
+static void uart_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		       uint32_t previous)
+{
+	struct uart_data *uart = periph->data;
+
+	switch (offset) {
+	case offsetof(USART_TypeDef, TDR):
+		/* Shifted out at once */
+		(void)queue_push(&uart->tx, (uint8_t)value);
+		regmodel_set_bits(REG(periph, USART_TypeDef, ISR), USART_ISR_TC);
+		break;
+	case offsetof(USART_TypeDef, ICR):
+		regmodel_clear_bits(REG(periph, USART_TypeDef, ISR), value & UART_ISR_CLEARABLE);
+		regmodel_write(periph->base + offset, 0U);
+		break;
+	case offsetof(USART_TypeDef, ISR):
+	case offsetof(USART_TypeDef, RDR):
+		/* Read-only */
+		regmodel_write(periph->base + offset, previous);
+		break;
+	case offsetof(USART_TypeDef, RQR):
+		if ((value & USART_RQR_RXFRQ) != 0U) {
+			uint8_t byte;
+
+			(void)queue_pop(&uart->rx, &byte);
+		}
+		regmodel_write(periph->base + offset, 0U);
+		break;
+	default:
+		break;
+	}
+	uart_update(periph);
+}
+
+#define UART_MODEL(instance)                                                   \
+	static struct uart_data instance##_data = { .irqn = instance##_IRQn }; \
+	static struct regmodel_periph instance##_model = {                     \
+		.name = #instance,                                             \
+		.base = instance##_BASE,                                       \
+		.size = sizeof(USART_TypeDef),                                 \
+		.read = uart_read,                                             \
+		.write = uart_write,                                           \
+		.data = &instance##_data,                                      \
+	}
+
+UART_MODEL(USART1);
+UART_MODEL(USART2);
+UART_MODEL(USART3);
+#if defined(UART4)
+UART_MODEL(UART4);
+#endif
+#if defined(UART5)
+UART_MODEL(UART5);
+#endif
+UART_MODEL(LPUART1);
+
+static struct regmodel_periph *const uart_models[] = {
+	&USART1_model,
+	&USART2_model,
+	&USART3_model,
+#if defined(UART4)
+	&UART4_model,
+#endif
+#if defined(UART5)
+	&UART5_model,
+#endif
+	&LPUART1_model,
+};
+
+static struct regmodel_periph *uart_model_find(uint32_t base)
+{
+	for (size_t i = 0U; i < (sizeof(uart_models) / sizeof(uart_models[0])); i++) {
+		if (uart_models[i]->base == base) {
+			return uart_models[i];
+		}
+	}
+	return NULL;
+}
+
+size_t regmodel_uart_inject(uint32_t base, const uint8_t *data, size_t len)
+{
+	struct regmodel_periph *periph = uart_model_find(base);
+	struct uart_data *uart;
+	size_t count = 0U;
+
+	if (periph == NULL) {
+		return 0U;
+	}
+	uart = periph->data;
+	while ((count < len) && queue_push(&uart->rx, data[count])) {
+		count++;
+	}
+	uart_update(periph);
+	return count;
+}
+
+size_t regmodel_uart_capture(uint32_t base, uint8_t *data, size_t size)
+{
+	struct regmodel_periph *periph = uart_model_find(base);
+	size_t count = 0U;
+
+	if (periph == NULL) {
+		return 0U;
+	}
+	while ((count < size) && queue_pop(&((struct uart_data *)periph->data)->tx, &data[count])) {
+		count++;
+	}
+	return count;
+}
+
+/* DMA -----------------------------------------------------------------------------*/
+
+#if defined(DMA1_Channel8)
+#define DMA_CHANNELS_NBR  8U
+#else
+#define DMA_CHANNELS_NBR  6U
+#endif
+
+#define DMA_CHANNEL_OFFSET(ch)  (0x08U + (0x14U * (ch)))
+#define DMA_FLAG_GI             0x1UL
+#define DMA_FLAG_TC             0x2UL
+#define DMA_FLAG_HT             0x4UL
+
+struct dma_data {
+	int irqn[DMA_CHANNELS_NBR];
+	struct {
+		struct regmodel_periph *periph;
+		uint32_t index;
+	} channels[DMA_CHANNELS_NBR];
+};
+
+/* Memory seen by the DMA: the registers through the backdoor, the rest as is */
+static uint8_t *dma_pointer(uint32_t addr)
+{
+	if (addr >= PERIPH_BASE) {
+		return regmodel_backdoor(addr);
+	}
+	return (uint8_t *)(uintptr_t)addr;
+}
+
+static void dma_transfer(void *arg)
+{
+	struct regmodel_periph *periph = *(struct regmodel_periph **)arg;
+	struct dma_data *dma = periph->data;
+	uint32_t ch = (uint32_t)(((uintptr_t)arg - (uintptr_t)dma->channels) /
+				 sizeof(dma->channels[0]));
+	uint32_t channel = periph->base + DMA_CHANNEL_OFFSET(ch);
+	uint32_t ccr = regmodel_read(channel + offsetof(DMA_Channel_TypeDef, CCR));
+	uint32_t count = regmodel_read(channel + offsetof(DMA_Channel_TypeDef, CNDTR)) & 0xFFFFU;
+	uint32_t psize = 1UL << ((ccr & DMA_CCR_PSIZE) >> DMA_CCR_PSIZE_Pos);
+	uint32_t msize = 1UL << ((ccr & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos);
+	uint8_t *paddr = dma_pointer(regmodel_read(channel + offsetof(DMA_Channel_TypeDef, CPAR)));
+	uint8_t *maddr = dma_pointer(regmodel_read(channel + offsetof(DMA_Channel_TypeDef, CMAR)));
+	uint32_t flags = DMA_FLAG_GI | DMA_FLAG_TC | DMA_FLAG_HT;
+
+	if ((ccr & DMA_CCR_EN) == 0U) {
+		/* Aborted meanwhile */
+		return;
+	}
+
+	for (uint32_t i = 0U; i < count; i++) {
+		uint32_t data = 0U;
+
+		/* DIR clear: from the peripheral port to the memory port */
+		if ((ccr & DMA_CCR_DIR) == 0U) {
+			memcpy(&data, paddr, psize);
+			memcpy(maddr, &data, msize);
+		} else {
+			memcpy(&data, maddr, msize);
+			memcpy(paddr, &data, psize);
+		}
+		paddr += ((ccr & DMA_CCR_PINC) != 0U) ? psize : 0U;
+		maddr += ((ccr & DMA_CCR_MINC) != 0U) ? msize : 0U;
+	}
+
+	if ((ccr & DMA_CCR_CIRC) == 0U) {
+		regmodel_write(channel + offsetof(DMA_Channel_TypeDef, CNDTR), 0U);
+	}
+	regmodel_set_bits(periph->base + offsetof(DMA_TypeDef, ISR), flags << (4U * ch));
+	if ((ccr & (DMA_CCR_TCIE | DMA_CCR_HTIE)) != 0U) {
+		regmodel_irq_raise(dma->irqn[ch]);
+	}
+}
+
+static void dma_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	struct dma_data *dma = periph->data;
+
+	if (offset == offsetof(DMA_TypeDef, ISR)) {
+		regmodel_write(periph->base + offset, previous);
+	} else if (offset == offsetof(DMA_TypeDef, IFCR)) {
+		/* Clearing the global flag clears the channel flags */
+		for (uint32_t ch = 0U; ch < DMA_CHANNELS_NBR; ch++) {
+			if ((value & (DMA_FLAG_GI << (4U * ch))) != 0U) {
+				value |= 0xFUL << (4U * ch);
+			}
+		}
+		regmodel_clear_bits(periph->base + offsetof(DMA_TypeDef, ISR), value);
+		regmodel_write(periph->base + offset, 0U);
+	} else if (((offset - DMA_CHANNEL_OFFSET(0U)) % 0x14U) ==
+		   offsetof(DMA_Channel_TypeDef, CCR)) {
+		uint32_t ch = (offset - DMA_CHANNEL_OFFSET(0U)) / 0x14U;
+
+		/* Memory-to-memory channels run as soon as enabled */
+		if ((ch < DMA_CHANNELS_NBR) && ((value & DMA_CCR_MEM2MEM) != 0U) &&
+		    ((value & DMA_CCR_EN) != 0U) && ((previous & DMA_CCR_EN) == 0U)) {
+			dma->channels[ch].periph = periph;
+			(void)regmodel_defer(1U, dma_transfer, &dma->channels[ch]);
+		}
+	}
+}
+
+static struct dma_data dma1_data = {
+	.irqn = {
+		DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+		DMA1_Channel5_IRQn, DMA1_Channel6_IRQn,
+#if defined(DMA1_Channel8)
+		DMA1_Channel7_IRQn, DMA1_Channel8_IRQn,
+#endif
+	},
+};
+
+static struct dma_data dma2_data = {
+	.irqn = {
+		DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_IRQn,
+		DMA2_Channel5_IRQn, DMA2_Channel6_IRQn,
+#if defined(DMA2_Channel8)
+		DMA2_Channel7_IRQn, DMA2_Channel8_IRQn,
+#endif
+	},
+};
+
+static struct regmodel_periph dma1_model = {
+	.name = "DMA1",
+	.base = DMA1_BASE,
+	.size = 0x400U,
+	.write = dma_write,
+	.data = &dma1_data,
+};
+
+static struct regmodel_periph dma2_model = {
+	.name = "DMA2",
+	.base = DMA2_BASE,
+	.size = 0x400U,
+	.write = dma_write,
+	.data = &dma2_data,
+};
+
+/* CRC -----------------------------------------------------------------------------*/
+
+static uint32_t crc_state;
+
+static uint32_t bit_reverse(uint32_t value, uint32_t width)
+{
+	uint32_t result = 0U;
+
+	for (uint32_t i = 0U; i < width; i++) {
+		result = (result << 1) | ((value >> i) & 1U);
+	}
+	return result;
+}
+
+static void crc_output(struct regmodel_periph *periph, uint32_t cr, uint32_t width)
+{
+	uint32_t value = crc_state;
+
+	if ((cr & CRC_CR_REV_OUT) != 0U) {
+		value = bit_reverse(value, width);
+	}
+	regmodel_write(REG(periph, CRC_TypeDef, DR), value);
+}
+
+static void crc_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	uint32_t cr = regmodel_read(REG(periph, CRC_TypeDef, CR));
+	uint32_t poly = regmodel_read(REG(periph, CRC_TypeDef, POL));
+	static const uint32_t widths[] = { 32U, 16U, 8U, 7U };
+	uint32_t width = widths[(cr & CRC_CR_POLYSIZE) >> CRC_CR_POLYSIZE_Pos];
+	uint32_t mask = (width == 32U) ? 0xFFFFFFFFUL : ((1UL << width) - 1U);
+
+	(void)previous;
+
+	if (offset == offsetof(CRC_TypeDef, CR)) {
+		if ((value & CRC_CR_RESET) != 0U) {
+			crc_state = regmodel_read(REG(periph, CRC_TypeDef, INIT)) & mask;
+			regmodel_write(periph->base + offset, value & ~CRC_CR_RESET);
+			crc_output(periph, cr, width);
+		}
+	} else if (offset == offsetof(CRC_TypeDef, DR)) {
+		/* Data as wide as the access, MSB first */
+		uint32_t bits = 8U * ((regmodel_access_size() < 4U) ? regmodel_access_size() : 4U);
+		uint32_t rev_in = (cr & CRC_CR_REV_IN) >> CRC_CR_REV_IN_Pos;
+		uint32_t data = (bits == 32U) ? value : (value & ((1UL << bits) - 1U));
+
+		if (rev_in != 0U) {
+			uint32_t unit = 8U << (rev_in - 1U);
+			uint32_t reversed = 0U;
+
+			unit = (unit > bits) ? bits : unit;
+			for (uint32_t i = 0U; i < bits; i += unit) {
+				reversed |= bit_reverse(data >> i, unit) << i;
+			}
+			data = reversed;
+		}
+		for (uint32_t i = bits; i > 0U; i--) {
+			uint32_t feedback = ((crc_state >> (width - 1U)) ^ (data >> (i - 1U))) & 1U;
+
+			crc_state = (crc_state << 1) & mask;
+			if (feedback != 0U) {
+				crc_state ^= poly & mask;
+			}
+		}
+		crc_output(periph, cr, width);
+	}
+}
+
+static struct regmodel_periph crc_model = {
+	.name = "CRC",
+	.base = CRC_BASE,
+	.size = sizeof(CRC_TypeDef),
+	.write = crc_write,
+};
+
+/* SPI -------------------------------------------------------------------------------*/
+
+/* MOSI looped back to MISO. The 32-bit receive FIFO drops the overrun data */
+#define SPI_FIFO_SIZE  4U
+
+struct spi_data {
+	int irqn;
+	uint8_t fifo[SPI_FIFO_SIZE];
+	uint32_t count;
+};
+
+static void spi_update(struct regmodel_periph *periph)
+{
+	struct spi_data *spi = periph->data;
+	uint32_t cr2 = regmodel_read(REG(periph, SPI_TypeDef, CR2));
+	uint32_t sr = regmodel_read(REG(periph, SPI_TypeDef, SR));
+	uint32_t ds = ((cr2 & SPI_CR2_DS) >> SPI_CR2_DS_Pos) + 1U;
+	uint32_t threshold = ((ds <= 8U) && ((cr2 & SPI_CR2_FRXTH) != 0U)) ? 1U : 2U;
+	uint32_t level = (spi->count < 3U) ? spi->count : 3U;
+
+	sr &= ~(SPI_SR_RXNE | SPI_SR_FRLVL | SPI_SR_FTLVL | SPI_SR_BSY);
+	sr |= SPI_SR_TXE | (level << SPI_SR_FRLVL_Pos);
+	if (spi->count >= threshold) {
+		sr |= SPI_SR_RXNE;
+	}
+	regmodel_write(REG(periph, SPI_TypeDef, SR), sr);
+
+	if ((((cr2 & SPI_CR2_TXEIE) != 0U) && ((sr & SPI_SR_TXE) != 0U)) ||
+	    (((cr2 & SPI_CR2_RXNEIE) != 0U) && ((sr & SPI_SR_RXNE) != 0U))) {
+		regmodel_irq_raise(spi->irqn);
+	}
+}
+
+static void spi_read(struct regmodel_periph *periph, uint32_t offset)
+{
+	struct spi_data *spi = periph->data;
+
+	if (offset == offsetof(SPI_TypeDef, DR)) {
+		uint32_t size = (regmodel_access_size() < 2U) ? 1U : 2U;
+		uint32_t value = 0U;
+
+		for (uint32_t i = 0U; (i < size) && (spi->count != 0U); i++) {
+			value |= (uint32_t)spi->fifo[0] << (8U * i);
+			memmove(&spi->fifo[0], &spi->fifo[1], --spi->count);
+		}
+		regmodel_write(periph->base + offset, value);
+		spi_update(periph);
+	}
+}
+
+static void spi_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	struct spi_data *spi = periph->data;
+	uint32_t cr1 = regmodel_read(REG(periph, SPI_TypeDef, CR1));
+
+	if (offset == offsetof(SPI_TypeDef, DR)) {
+		uint32_t size = (regmodel_access_size() < 2U) ? 1U : 2U;
+
+		for (uint32_t i = 0U; (i < size) && ((cr1 & SPI_CR1_SPE) != 0U); i++) {
+			if (spi->count < SPI_FIFO_SIZE) {
+				spi->fifo[spi->count++] = (uint8_t)(value >> (8U * i));
+			}
+		}
+	} else if (offset == offsetof(SPI_TypeDef, SR)) {
+		regmodel_write(periph->base + offset, previous);
+	} else if ((offset == offsetof(SPI_TypeDef, CR1)) && ((cr1 & SPI_CR1_SPE) == 0U)) {
+		spi->count = 0U;
+	}
+	spi_update(periph);
+}
+
+static struct spi_data spi1_data = { .irqn = SPI1_IRQn };
+
+static struct regmodel_periph spi1_model = {
+	.name = "SPI1",
+	.base = SPI1_BASE,
+	.size = sizeof(SPI_TypeDef),
+	.read = spi_read,
+	.write = spi_write,
+	.data = &spi1_data,
+};
+
+/* I2C -------------------------------------------------------------------------------*/
+
+/*
+ * Master transfers to a 256-byte memory answering any address: the first byte
+ * written sets the memory pointer, the next ones are stored, reads return the
+ * memory from the pointer. Each byte takes the byte time set, none by default.
+ * An error injected ends the transfer, as a master losing the bus.
+ */
+#define I2C_ISR_CLEARABLE  (I2C_ISR_ADDR | I2C_ISR_NACKF | I2C_ISR_STOPF | I2C_ISR_BERR | \
+			    I2C_ISR_ARLO | I2C_ISR_OVR | I2C_ISR_PECERR | I2C_ISR_TIMEOUT | \
+			    I2C_ISR_ALERT)
+
+struct i2c_data {
+	int irqn;
+	int er_irqn;
+	bool active;
+	bool read;
+	bool addressed;
+	uint32_t remaining;
+	uint32_t byte_time_us;
+	uint8_t pointer;
+	uint8_t mem[256];
+};
+
+static void i2c_stop(struct regmodel_periph *periph)
+{
+	struct i2c_data *i2c = periph->data;
+
+	i2c->active = false;
+	regmodel_clear_bits(REG(periph, I2C_TypeDef, ISR),
+			    I2C_ISR_BUSY | I2C_ISR_TXIS | I2C_ISR_RXNE | I2C_ISR_TC | I2C_ISR_TCR);
+	regmodel_set_bits(REG(periph, I2C_TypeDef, ISR), I2C_ISR_STOPF);
+}
+
+static void i2c_update(struct regmodel_periph *periph);
+
+/* Next byte of the transfer, or end of the NBYTES chunk */
+static void i2c_step(struct regmodel_periph *periph)
+{
+	struct i2c_data *i2c = periph->data;
+	uint32_t cr2 = regmodel_read(REG(periph, I2C_TypeDef, CR2));
+	uint32_t isr = REG(periph, I2C_TypeDef, ISR);
+
+	if (i2c->remaining != 0U) {
+		regmodel_set_bits(isr, i2c->read ? I2C_ISR_RXNE : I2C_ISR_TXIS);
+	} else if ((cr2 & I2C_CR2_RELOAD) != 0U) {
+		regmodel_set_bits(isr, I2C_ISR_TCR);
+	} else if ((cr2 & I2C_CR2_AUTOEND) != 0U) {
+		i2c_stop(periph);
+	} else {
+		regmodel_set_bits(isr, I2C_ISR_TC);
+	}
+}
+
+static void i2c_byte_done(void *arg)
+{
+	struct regmodel_periph *periph = arg;
+
+	if (((struct i2c_data *)periph->data)->active) {
+		i2c_step(periph);
+		i2c_update(periph);
+	}
+}
+
+static void i2c_next(struct regmodel_periph *periph)
+{
+	struct i2c_data *i2c = periph->data;
+
+	if ((i2c->byte_time_us == 0U) || (regmodel_defer(i2c->byte_time_us, i2c_byte_done, periph) != 0)) {
+		i2c_step(periph);
+	}
+}
+
+static void i2c_update(struct regmodel_periph *periph)
+{
+	struct i2c_data *i2c = periph->data;
+	uint32_t cr1 = regmodel_read(REG(periph, I2C_TypeDef, CR1));
+	uint32_t isr = regmodel_read(REG(periph, I2C_TypeDef, ISR));
+
+	if ((((cr1 & I2C_CR1_TXIE) != 0U) && ((isr & I2C_ISR_TXIS) != 0U)) ||
+	    (((cr1 & I2C_CR1_RXIE) != 0U) && ((isr & I2C_ISR_RXNE) != 0U)) ||
+	    (((cr1 & I2C_CR1_STOPIE) != 0U) && ((isr & I2C_ISR_STOPF) != 0U)) ||
+	    (((cr1 & I2C_CR1_NACKIE) != 0U) && ((isr & I2C_ISR_NACKF) != 0U)) ||
+	    (((cr1 & I2C_CR1_TCIE) != 0U) && ((isr & (I2C_ISR_TC | I2C_ISR_TCR)) != 0U))) {
+		regmodel_irq_raise(i2c->irqn);
+	}
+	if (((cr1 & I2C_CR1_ERRIE) != 0U) &&
+	    ((isr & (I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR)) != 0U)) {
+		regmodel_irq_raise(i2c->er_irqn);
+	}
+}
+
+static void i2c_read(struct regmodel_periph *periph, uint32_t offset)
+{
+	struct i2c_data *i2c = periph->data;
+	uint32_t isr = REG(periph, I2C_TypeDef, ISR);
+
+	if ((offset == offsetof(I2C_TypeDef, RXDR)) && i2c->active && i2c->read &&
+	    ((regmodel_read(isr) & I2C_ISR_RXNE) != 0U)) {
+		regmodel_write(periph->base + offset, i2c->mem[i2c->pointer++]);
+		regmodel_clear_bits(isr, I2C_ISR_RXNE);
+		i2c->remaining--;
+		i2c_next(periph);
+		i2c_update(periph);
+	}
+}
+
+static void i2c_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	struct i2c_data *i2c = periph->data;
+	uint32_t isr = REG(periph, I2C_TypeDef, ISR);
+
+	switch (offset) {
+	case offsetof(I2C_TypeDef, CR1):
+		if ((value & I2C_CR1_PE) == 0U) {
+			i2c->active = false;
+			regmodel_write(isr, I2C_ISR_TXE);
+		}
+		break;
+	case offsetof(I2C_TypeDef, CR2):
+		regmodel_write(periph->base + offset, value & ~(I2C_CR2_START | I2C_CR2_STOP));
+		if ((value & I2C_CR2_START) != 0U) {
+			i2c->active = true;
+			i2c->read = ((value & I2C_CR2_RD_WRN) != 0U);
+			i2c->addressed = i2c->read;
+			i2c->remaining = (value & I2C_CR2_NBYTES) >> I2C_CR2_NBYTES_Pos;
+			regmodel_clear_bits(isr, I2C_ISR_TC | I2C_ISR_TCR | I2C_ISR_TXIS | I2C_ISR_RXNE);
+			regmodel_set_bits(isr, I2C_ISR_BUSY);
+			i2c_next(periph);
+		} else if (i2c->active && ((regmodel_read(isr) & I2C_ISR_TCR) != 0U)) {
+			/* Reload of NBYTES */
+			i2c->remaining = (value & I2C_CR2_NBYTES) >> I2C_CR2_NBYTES_Pos;
+			regmodel_clear_bits(isr, I2C_ISR_TCR);
+			i2c_next(periph);
+		}
+		if (((value & I2C_CR2_STOP) != 0U) && i2c->active) {
+			i2c_stop(periph);
+		}
+		break;
+	case offsetof(I2C_TypeDef, TXDR):
+		if (i2c->active && !i2c->read && (i2c->remaining != 0U)) {
+			if (!i2c->addressed) {
+				i2c->pointer = (uint8_t)value;
+				i2c->addressed = true;
+			} else {
+				i2c->mem[i2c->pointer++] = (uint8_t)value;
+			}
+			i2c->remaining--;
+			regmodel_clear_bits(isr, I2C_ISR_TXIS);
+			i2c_next(periph);
+		}
+		break;
+	case offsetof(I2C_TypeDef, ICR):
+		regmodel_clear_bits(isr, value & I2C_ISR_CLEARABLE);
+		regmodel_write(periph->base + offset, 0U);
+		break;
+	case offsetof(I2C_TypeDef, ISR):
+		/* Only TXE and TXIS can be set by software */
+		regmodel_write(periph->base + offset, previous | (value & (I2C_ISR_TXE | I2C_ISR_TXIS)));
+		break;
+	case offsetof(I2C_TypeDef, RXDR):
+		regmodel_write(periph->base + offset, previous);
+		break;
+	default:
+		break;
+	}
+	i2c_update(periph);
+}
+
+static struct i2c_data i2c1_data = { .irqn = I2C1_EV_IRQn, .er_irqn = I2C1_ER_IRQn };
+
+static struct regmodel_periph i2c1_model = {
+	.name = "I2C1",
+	.base = I2C1_BASE,
+	.size = sizeof(I2C_TypeDef),
+	.read = i2c_read,
+	.write = i2c_write,
+	.data = &i2c1_data,
+};
+
+uint8_t *regmodel_i2c_memory(uint32_t base)
+{
+	return (base == I2C1_BASE) ? i2c1_data.mem : NULL;
+}
+
+void regmodel_i2c_set_byte_time(uint32_t base, uint32_t byte_time_us)
+{
+	if (base == I2C1_BASE) {
+		i2c1_data.byte_time_us = byte_time_us;
+	}
+}
+
+void regmodel_i2c_inject_error(uint32_t base, uint32_t flags)
+{
+	if (base != I2C1_BASE) {
+		return;
+	}
+	flags &= I2C_ISR_BERR | I2C_ISR_ARLO | I2C_ISR_OVR;
+	if (flags != 0U) {
+		i2c1_data.active = false;
+		regmodel_clear_bits(REG(&i2c1_model, I2C_TypeDef, ISR),
+				    I2C_ISR_BUSY | I2C_ISR_TXIS | I2C_ISR_RXNE | I2C_ISR_TC | I2C_ISR_TCR);
+		regmodel_set_bits(REG(&i2c1_model, I2C_TypeDef, ISR), flags);
+		i2c_update(&i2c1_model);
+	}
+}
+
+/* FDCAN -----------------------------------------------------------------------------*/
+
+/*
+ * Transmission requests complete at once and the frames are looped back to Rx
+ * FIFO 0, as in the internal loopback mode, whatever the filters.
+ */
+#define FDCAN_RAM_ELEMENTS      3U
+#define FDCAN_RAM_ELEMENT_SIZE  72U
+#define FDCAN_RAM_RF0SA         0x0B0U
+#define FDCAN_RAM_TFQSA         0x278U
+#define FDCAN_R1_ANMF           (1UL << 31)
+#define FDCAN_T1_RX_MASK        0x003F0000UL  /* DLC, BRS, FDF */
+
+static void fdcan_update(struct regmodel_periph *periph)
+{
+	uint32_t ir = regmodel_read(REG(periph, FDCAN_GlobalTypeDef, IR));
+	uint32_t ie = regmodel_read(REG(periph, FDCAN_GlobalTypeDef, IE));
+	uint32_t ile = regmodel_read(REG(periph, FDCAN_GlobalTypeDef, ILE));
+
+	if (((ile & FDCAN_ILE_EINT0) != 0U) && ((ir & ie) != 0U)) {
+		regmodel_irq_raise(FDCAN1_IT0_IRQn);
+	}
+}
+
+static void fdcan_transmit(struct regmodel_periph *periph, uint32_t index)
+{
+	uint32_t tx = SRAMCAN_BASE + FDCAN_RAM_TFQSA + (index * FDCAN_RAM_ELEMENT_SIZE);
+	uint32_t rxf0s = regmodel_read(REG(periph, FDCAN_GlobalTypeDef, RXF0S));
+	uint32_t fill = (rxf0s & FDCAN_RXF0S_F0FL) >> FDCAN_RXF0S_F0FL_Pos;
+	uint32_t put = (rxf0s & FDCAN_RXF0S_F0PI) >> FDCAN_RXF0S_F0PI_Pos;
+	uint32_t ir = FDCAN_IR_TC | FDCAN_IR_TFE;
+
+	if (fill < FDCAN_RAM_ELEMENTS) {
+		uint32_t rx = SRAMCAN_BASE + FDCAN_RAM_RF0SA + (put * FDCAN_RAM_ELEMENT_SIZE);
+
+		regmodel_write(rx, regmodel_read(tx));
+		regmodel_write(rx + 4U, (regmodel_read(tx + 4U) & FDCAN_T1_RX_MASK) | FDCAN_R1_ANMF);
+		memcpy(regmodel_backdoor(rx + 8U), regmodel_backdoor(tx + 8U),
+		       FDCAN_RAM_ELEMENT_SIZE - 8U);
+		fill++;
+		put = (put + 1U) % FDCAN_RAM_ELEMENTS;
+		ir |= FDCAN_IR_RF0N | ((fill == FDCAN_RAM_ELEMENTS) ? FDCAN_IR_RF0F : 0U);
+	} else {
+		ir |= FDCAN_IR_RF0L;
+	}
+	regmodel_write(REG(periph, FDCAN_GlobalTypeDef, RXF0S),
+		       (fill << FDCAN_RXF0S_F0FL_Pos) |
+		       (((put + FDCAN_RAM_ELEMENTS - fill) % FDCAN_RAM_ELEMENTS) << FDCAN_RXF0S_F0GI_Pos) |
+		       (put << FDCAN_RXF0S_F0PI_Pos) |
+		       ((fill == FDCAN_RAM_ELEMENTS) ? FDCAN_RXF0S_F0F : 0U));
+
+	regmodel_set_bits(REG(periph, FDCAN_GlobalTypeDef, TXBTO), 1UL << index);
+	index = (index + 1U) % FDCAN_RAM_ELEMENTS;
+	regmodel_write(REG(periph, FDCAN_GlobalTypeDef, TXFQS),
+		       (FDCAN_RAM_ELEMENTS << FDCAN_TXFQS_TFFL_Pos) | (index << FDCAN_TXFQS_TFGI_Pos) |
+		       (index << FDCAN_TXFQS_TFQPI_Pos));
+	regmodel_set_bits(REG(periph, FDCAN_GlobalTypeDef, IR), ir);
+}
+
+static void fdcan_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+			uint32_t previous)
+{
+	switch (offset) {
+	case offsetof(FDCAN_GlobalTypeDef, TXBAR):
+		for (uint32_t i = 0U; i < FDCAN_RAM_ELEMENTS; i++) {
+			if ((value & (1UL << i)) != 0U) {
+				fdcan_transmit(periph, i);
+			}
+		}
+		regmodel_write(periph->base + offset, 0U);
+		break;
+	case offsetof(FDCAN_GlobalTypeDef, IR):
+		regmodel_write(periph->base + offset, previous & ~value);
+		break;
+	case offsetof(FDCAN_GlobalTypeDef, RXF0A): {
+		uint32_t rxf0s = regmodel_read(REG(periph, FDCAN_GlobalTypeDef, RXF0S));
+		uint32_t fill = (rxf0s & FDCAN_RXF0S_F0FL) >> FDCAN_RXF0S_F0FL_Pos;
+		uint32_t get = (rxf0s & FDCAN_RXF0S_F0GI) >> FDCAN_RXF0S_F0GI_Pos;
+		/* The acknowledged element and all the older ones are released */
+		uint32_t released = (((value & FDCAN_RXF0A_F0AI) + FDCAN_RAM_ELEMENTS - get) %
+				     FDCAN_RAM_ELEMENTS) + 1U;
+
+		if (fill == 0U) {
+			released = 0U;
+		} else if (released > fill) {
+			released = fill;
+		}
+		fill -= released;
+		get = (get + released) % FDCAN_RAM_ELEMENTS;
+		rxf0s &= ~(FDCAN_RXF0S_F0FL | FDCAN_RXF0S_F0GI | FDCAN_RXF0S_F0F);
+		rxf0s |= (fill << FDCAN_RXF0S_F0FL_Pos) | (get << FDCAN_RXF0S_F0GI_Pos);
+		regmodel_write(REG(periph, FDCAN_GlobalTypeDef, RXF0S), rxf0s);
+		break;
+	}
+	default:
+		break;
+	}
+	fdcan_update(periph);
+}
+
+static struct regmodel_periph fdcan1_model = {
+	.name = "FDCAN1",
+	.base = FDCAN1_BASE,
+	.size = sizeof(FDCAN_GlobalTypeDef),
+	.write = fdcan_write,
+};
+
+/* Series --------------------------------------------------------------------------*/
+
+void regmodel_series_init(void)
+{
+	/* Cortex-M4 r0p1 */
+	regmodel_write(SCB_BASE + offsetof(SCB_Type, CPUID), 0x410FC241UL);
+
+	/* Reset values */
+	regmodel_write(REG(&rcc_model, RCC_TypeDef, CR), RCC_CR_HSION | RCC_CR_HSIRDY);
+	regmodel_write(REG(&rcc_model, RCC_TypeDef, CFGR), RCC_CFGR_SW_HSI | RCC_CFGR_SWS_HSI);
+	regmodel_write(REG(&rcc_model, RCC_TypeDef, CSR), 0x0C000000UL);
+	regmodel_write(REG(&rcc_model, RCC_TypeDef, PLLCFGR), 0x00001000UL);
+	regmodel_write(FLASH_R_BASE + offsetof(FLASH_TypeDef, ACR), 0x00000600UL);
+	regmodel_write(PWR_BASE + offsetof(PWR_TypeDef, CR1), 0x00000200UL);
+
+	regmodel_attach(&rcc_model);
+	for (size_t i = 0U; i < (sizeof(uart_models) / sizeof(uart_models[0])); i++) {
+		regmodel_attach(uart_models[i]);
+	}
+	regmodel_attach(&dma1_model);
+	regmodel_attach(&dma2_model);
+
+	regmodel_write(REG(&crc_model, CRC_TypeDef, DR), 0xFFFFFFFFUL);
+	regmodel_write(REG(&crc_model, CRC_TypeDef, INIT), 0xFFFFFFFFUL);
+	regmodel_write(REG(&crc_model, CRC_TypeDef, POL), 0x04C11DB7UL);
+	regmodel_attach(&crc_model);
+
+	regmodel_write(REG(&spi1_model, SPI_TypeDef, CR2), 0x00000700UL);
+	regmodel_write(REG(&spi1_model, SPI_TypeDef, SR), SPI_SR_TXE);
+	regmodel_attach(&spi1_model);
+
+	regmodel_write(REG(&i2c1_model, I2C_TypeDef, ISR), I2C_ISR_TXE);
+	regmodel_attach(&i2c1_model);
+
+	regmodel_write(REG(&fdcan1_model, FDCAN_GlobalTypeDef, TXFQS),
+		       FDCAN_RAM_ELEMENTS << FDCAN_TXFQS_TFFL_Pos);
+	regmodel_attach(&fdcan1_model);
+}
@@ -0,0 +1,75 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Peripheral models of the STM32G4 series:
+ *
+ * - RCC: oscillator, PLL and system clock switch acknowledgments.
+ * - USART1..3, UART4..5, LPUART1: enable acknowledgments, transmission
+ *   captured, reception injected, interrupts. FIFO mode is not modelled.
+ * - DMA1, DMA2: memory-to-memory transfers, interrupts. The DMA addresses are
+ *   32-bit, so the buffers must be static (the host build is not PIE).
+ * - CRC: polynomial, input/output reversal, 8/16/32-bit data.
+ * - SPI1: master with MOSI looped back to MISO.
+ * - I2C1: master transfers to a 256-byte memory at any address, immediate or
+ *   at the byte time set, event and error interrupts.
+ * - FDCAN1: Tx FIFO looped back to Rx FIFO 0.
+ *
+ * The other peripherals are plain registers.
+ */
+
+#ifndef REGMODEL_STM32G4XX_H
+#define REGMODEL_STM32G4XX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Queue bytes received by a U(S)ART.
+ *
+ * @param base Base address of the instance, e.g. USART1_BASE.
+ * @return Number of bytes queued, less than @p len when the queue is full.
+ */
+size_t regmodel_uart_inject(uint32_t base, const uint8_t *data, size_t len);
+
+/**
+ * @brief Take the bytes transmitted by a U(S)ART since the last call.
+ *
+ * @param base Base address of the instance, e.g. USART1_BASE.
+ * @return Number of bytes copied to @p data.
+ */
+size_t regmodel_uart_capture(uint32_t base, uint8_t *data, size_t size);
+
+/**
+ * @brief Memory behind an I2C master, 256 bytes.
+ *
+ * @param base Base address of the instance, e.g. I2C1_BASE.
+ * @return The memory, NULL when the instance is not modelled.
+ */
+uint8_t *regmodel_i2c_memory(uint32_t base);
+
+/**
+ * @brief Set the time an I2C master takes per byte, 0 (the default) for none.
+ *
+ * @param base Base address of the instance, e.g. I2C1_BASE.
+ */
+void regmodel_i2c_set_byte_time(uint32_t base, uint32_t byte_time_us);
+
+/**
+ * @brief Raise bus errors on an I2C master, ending its transfer.
+ *
+ * @param base Base address of the instance, e.g. I2C1_BASE.
+ * @param flags I2C_ISR_BERR, I2C_ISR_ARLO and/or I2C_ISR_OVR.
+ */
+void regmodel_i2c_inject_error(uint32_t base, uint32_t flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REGMODEL_STM32G4XX_H */
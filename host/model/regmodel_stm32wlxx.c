@@ -0,0 +1,805 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "regmodel.h"
+#include "regmodel_stm32wlxx.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "stm32wlxx.h"
+
+#define REG(periph, type, reg)  ((periph)->base + (uint32_t)offsetof(type, reg))
+
+/* Radio -----------------------------------------------------------------------*/
+
+#define RADIO_WRITE_REGISTER  0x0DU
+#define RADIO_READ_REGISTER   0x1DU
+#define RADIO_WRITE_BUFFER    0x0EU
+#define RADIO_READ_BUFFER     0x1EU
+#define RADIO_SET_SLEEP       0x84U
+
+/* Status returned outside of the data phases: standby RC, no command status */
+#define RADIO_STATUS          0x22U
+
+#define RADIO_REGS_SIZE       0x1000U
+#define RADIO_CAPTURE_SIZE    2048U
+
+static struct {
+	bool reset;
+	bool selected;
+	bool sleep;
+	bool busy;
+	uintptr_t busy_id;
+	uint32_t index;
+	uint8_t header[3];
+	uint8_t buffer[256];
+	uint8_t regs[RADIO_REGS_SIZE];
+	uint8_t capture[RADIO_CAPTURE_SIZE];
+	size_t captured;
+	uint32_t busy_errors;
+} radio = { .reset = true, .busy = true };
+
+static void radio_irq_update(void);
+
+/* BUSY on PWR_SR2, BUSY edge flag on PWR_SR1 */
+static void radio_set_busy(bool busy)
+{
+	uint32_t polarity = regmodel_read(PWR_BASE + offsetof(PWR_TypeDef, CR4)) & PWR_CR4_WRFBUSYP;
+
+	if (busy == radio.busy) {
+		return;
+	}
+	radio.busy = busy;
+	if (busy) {
+		regmodel_set_bits(PWR_BASE + offsetof(PWR_TypeDef, SR2), PWR_SR2_RFBUSYS | PWR_SR2_RFBUSYMS);
+	} else {
+		regmodel_clear_bits(PWR_BASE + offsetof(PWR_TypeDef, SR2), PWR_SR2_RFBUSYS | PWR_SR2_RFBUSYMS);
+	}
+	if ((polarity != 0U) != busy) {
+		regmodel_set_bits(PWR_BASE + offsetof(PWR_TypeDef, SR1), PWR_SR1_WRFBUSYF);
+		radio_irq_update();
+	}
+}
+
+static void radio_busy_release(void *arg)
+{
+	if (((uintptr_t)arg == radio.busy_id) && !radio.reset && !radio.sleep) {
+		radio_set_busy(false);
+	}
+}
+
+static void radio_busy_pulse(uint32_t accesses)
+{
+	radio_set_busy(true);
+	radio.busy_id++;
+	(void)regmodel_defer(accesses, radio_busy_release, (void *)radio.busy_id);
+}
+
+static void radio_reset(bool reset)
+{
+	if (reset == radio.reset) {
+		return;
+	}
+	radio.reset = reset;
+	radio.index = 0U;
+	radio.sleep = false;
+	if (reset) {
+		radio_set_busy(true);
+	} else {
+		radio_busy_pulse(REGMODEL_RADIO_WAKEUP_ACCESSES);
+	}
+}
+
+static void radio_select(bool selected)
+{
+	if (selected == radio.selected) {
+		return;
+	}
+	radio.selected = selected;
+	if (radio.reset) {
+		return;
+	}
+	if (selected) {
+		/* NSS falling edge wakes the radio up */
+		if (radio.sleep) {
+			radio.sleep = false;
+			radio_busy_pulse(REGMODEL_RADIO_WAKEUP_ACCESSES);
+		}
+	} else if (radio.index != 0U) {
+		/* NSS rising edge ends the command */
+		if (radio.header[0] == RADIO_SET_SLEEP) {
+			radio.sleep = true;
+			radio_set_busy(true);
+		} else {
+			radio_busy_pulse(REGMODEL_RADIO_BUSY_ACCESSES);
+		}
+		radio.index = 0U;
+	}
+}
+
+/* Byte shifted out on MOSI, returns the byte shifted in on MISO */
+static uint8_t radio_exchange(uint8_t mosi)
+{
+	uint32_t index = radio.index;
+	uint32_t address = ((uint32_t)radio.header[1] << 8) | radio.header[2];
+	uint8_t miso = RADIO_STATUS;
+
+	if (!radio.selected || radio.reset) {
+		return 0xFFU;
+	}
+	if ((index == 0U) && radio.busy) {
+		radio.busy_errors++;
+	}
+	if (radio.captured < RADIO_CAPTURE_SIZE) {
+		radio.capture[radio.captured++] = mosi;
+	}
+	if (index < sizeof(radio.header)) {
+		radio.header[index] = mosi;
+	}
+
+	switch (radio.header[0]) {
+	case RADIO_WRITE_REGISTER:
+		if (index >= 3U) {
+			radio.regs[(address + index - 3U) % RADIO_REGS_SIZE] = mosi;
+		}
+		break;
+	case RADIO_READ_REGISTER:
+		if (index >= 4U) {
+			miso = radio.regs[(address + index - 4U) % RADIO_REGS_SIZE];
+		}
+		break;
+	case RADIO_WRITE_BUFFER:
+		if (index >= 2U) {
+			radio.buffer[(radio.header[1] + index - 2U) & 0xFFU] = mosi;
+		}
+		break;
+	case RADIO_READ_BUFFER:
+		if (index >= 3U) {
+			miso = radio.buffer[(radio.header[1] + index - 3U) & 0xFFU];
+		}
+		break;
+	default:
+		break;
+	}
+	radio.index++;
+	return miso;
+}
+
+size_t regmodel_radio_capture(uint8_t *data, size_t size)
+{
+	size_t count = (radio.captured < size) ? radio.captured : size;
+
+	memcpy(data, radio.capture, count);
+	radio.captured = 0U;
+	return count;
+}
+
+uint8_t *regmodel_radio_buffer(void)
+{
+	return radio.buffer;
+}
+
+uint32_t regmodel_radio_busy_errors(void)
+{
+	uint32_t errors = radio.busy_errors;
+
+	radio.busy_errors = 0U;
+	return errors;
+}
+
+/* RCC -----------------------------------------------------------------------*/
+
+static const struct regmodel_ready rcc_ready[] = {
+	{ offsetof(RCC_TypeDef, CR), RCC_CR_MSION, RCC_CR_MSIRDY },
+	{ offsetof(RCC_TypeDef, CR), RCC_CR_HSION, RCC_CR_HSIRDY },
+	{ offsetof(RCC_TypeDef, CR), RCC_CR_HSEON, RCC_CR_HSERDY },
+	{ offsetof(RCC_TypeDef, CR), RCC_CR_PLLON, RCC_CR_PLLRDY },
+	{ offsetof(RCC_TypeDef, CSR), RCC_CSR_LSION, RCC_CSR_LSIRDY },
+	{ offsetof(RCC_TypeDef, CSR), RCC_CSR_RFRST, RCC_CSR_RFRSTF },
+	{ offsetof(RCC_TypeDef, BDCR), RCC_BDCR_LSEON, RCC_BDCR_LSERDY },
+};
+
+static void rcc_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	(void)previous;
+
+	if (offset == offsetof(RCC_TypeDef, CFGR)) {
+		/* The switch and the prescaler updates complete at once */
+		value &= ~RCC_CFGR_SWS;
+		value |= ((value & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos) | RCC_CFGR_HPREF |
+			 RCC_CFGR_PPRE1F | RCC_CFGR_PPRE2F;
+		regmodel_write(periph->base + offset, value);
+	} else if (offset == offsetof(RCC_TypeDef, EXTCFGR)) {
+		regmodel_write(periph->base + offset,
+			       value | RCC_EXTCFGR_SHDHPREF | RCC_EXTCFGR_C2HPREF);
+	} else {
+		regmodel_update_ready(periph, rcc_ready, sizeof(rcc_ready) / sizeof(rcc_ready[0]));
+		if (offset == offsetof(RCC_TypeDef, CSR)) {
+			radio_reset((value & RCC_CSR_RFRST) != 0U);
+		}
+	}
+}
+
+static struct regmodel_periph rcc_model = {
+	.name = "RCC",
+	.base = RCC_BASE,
+	.size = sizeof(RCC_TypeDef),
+	.write = rcc_write,
+};
+
+/* PWR, EXTI ---------------------------------------------------------------------*/
+
+/* Radio BUSY interrupt of the CPU1, level sensitive */
+static void radio_irq_update(void)
+{
+	uint32_t sr1 = regmodel_read(PWR_BASE + offsetof(PWR_TypeDef, SR1));
+	uint32_t cr3 = regmodel_read(PWR_BASE + offsetof(PWR_TypeDef, CR3));
+	uint32_t imr2 = regmodel_read(EXTI_BASE + offsetof(EXTI_TypeDef, IMR2));
+
+	if (((sr1 & PWR_SR1_WRFBUSYF) != 0U) && ((cr3 & PWR_CR3_EWRFBUSY) != 0U) &&
+	    ((imr2 & EXTI_IMR2_IM45) != 0U)) {
+		regmodel_irq_raise(SUBGHZ_Radio_IRQn);
+	}
+}
+
+static void pwr_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	switch (offset) {
+	case offsetof(PWR_TypeDef, SR1):
+	case offsetof(PWR_TypeDef, SR2):
+		/* Read-only */
+		regmodel_write(periph->base + offset, previous);
+		break;
+	case offsetof(PWR_TypeDef, SCR):
+		regmodel_clear_bits(REG(periph, PWR_TypeDef, SR1), value);
+		regmodel_write(periph->base + offset, 0U);
+		break;
+	case offsetof(PWR_TypeDef, SUBGHZSPICR):
+		radio_select((value & PWR_SUBGHZSPICR_NSS) == 0U);
+		break;
+	default:
+		break;
+	}
+	radio_irq_update();
+}
+
+static struct regmodel_periph pwr_model = {
+	.name = "PWR",
+	.base = PWR_BASE,
+	.size = sizeof(PWR_TypeDef),
+	.write = pwr_write,
+};
+
+static void exti_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		       uint32_t previous)
+{
+	radio_irq_update();
+}
+
+static struct regmodel_periph exti_model = {
+	.name = "EXTI",
+	.base = EXTI_BASE,
+	.size = sizeof(EXTI_TypeDef),
+	.write = exti_write,
+};
+
+/* DMA -----------------------------------------------------------------------------*/
+
+#define DMA_CHANNELS_NBR        7U
+#define DMA_CHANNEL_OFFSET(ch)  (0x08U + (0x14U * (ch)))
+#define DMA_FLAG_GI             0x1UL
+#define DMA_FLAG_TC             0x2UL
+#define DMA_FLAG_HT             0x4UL
+
+/* DMAMUX1 request lines */
+#define DMAMUX_REQUEST_SUBGHZSPI_RX  41U
+#define DMAMUX_REQUEST_SUBGHZSPI_TX  42U
+
+struct dma_data {
+	uint32_t mux_base;
+	int irqn[DMA_CHANNELS_NBR];
+	/* Data items transferred since the channel was enabled */
+	uint32_t done[DMA_CHANNELS_NBR];
+};
+
+static struct dma_data dma1_data = {
+	.mux_base = DMAMUX1_Channel0_BASE,
+	.irqn = {
+		DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+		DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn,
+	},
+};
+
+static struct dma_data dma2_data = {
+	.mux_base = DMAMUX1_Channel7_BASE,
+	.irqn = {
+		DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn, DMA2_Channel4_IRQn,
+		DMA2_Channel5_IRQn, DMA2_Channel6_IRQn, DMA2_Channel7_IRQn,
+	},
+};
+
+static void subghzspi_dma(void);
+
+static void dma_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	struct dma_data *dma = periph->data;
+
+	if (offset == offsetof(DMA_TypeDef, ISR)) {
+		regmodel_write(periph->base + offset, previous);
+	} else if (offset == offsetof(DMA_TypeDef, IFCR)) {
+		/* Clearing the global flag clears the channel flags */
+		for (uint32_t ch = 0U; ch < DMA_CHANNELS_NBR; ch++) {
+			if ((value & (DMA_FLAG_GI << (4U * ch))) != 0U) {
+				value |= 0xFUL << (4U * ch);
+			}
+		}
+		regmodel_clear_bits(periph->base + offsetof(DMA_TypeDef, ISR), value);
+		regmodel_write(periph->base + offset, 0U);
+	} else if (((offset - DMA_CHANNEL_OFFSET(0U)) % 0x14U) ==
+		   offsetof(DMA_Channel_TypeDef, CCR)) {
+		uint32_t ch = (offset - DMA_CHANNEL_OFFSET(0U)) / 0x14U;
+
+		if ((ch < DMA_CHANNELS_NBR) && ((value & DMA_CCR_EN) != 0U) &&
+		    ((previous & DMA_CCR_EN) == 0U)) {
+			dma->done[ch] = 0U;
+			subghzspi_dma();
+		}
+	}
+}
+
+static struct regmodel_periph dma1_model = {
+	.name = "DMA1",
+	.base = DMA1_BASE,
+	.size = 0x400U,
+	.write = dma_write,
+	.data = &dma1_data,
+};
+
+static struct regmodel_periph dma2_model = {
+	.name = "DMA2",
+	.base = DMA2_BASE,
+	.size = 0x400U,
+	.write = dma_write,
+	.data = &dma2_data,
+};
+
+/*
+ * Serve a peripheral request with a byte data item: the first enabled channel
+ * DMAMUX1 routes the request to moves @p data to or from the memory.
+ *
+ * @return false when no channel serves the request.
+ */
+static bool dma_request(uint32_t request, uint8_t *data)
+{
+	static struct regmodel_periph *const dmas[] = { &dma1_model, &dma2_model };
+
+	for (size_t i = 0U; i < (sizeof(dmas) / sizeof(dmas[0])); i++) {
+		struct regmodel_periph *periph = dmas[i];
+		struct dma_data *dma = periph->data;
+
+		for (uint32_t ch = 0U; ch < DMA_CHANNELS_NBR; ch++) {
+			uint32_t channel = periph->base + DMA_CHANNEL_OFFSET(ch);
+			uint32_t mux = regmodel_read(dma->mux_base + (4U * ch));
+			uint32_t ccr = regmodel_read(channel + offsetof(DMA_Channel_TypeDef, CCR));
+			uint32_t count = regmodel_read(channel + offsetof(DMA_Channel_TypeDef, CNDTR));
+			uint32_t msize = 1UL << ((ccr & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos);
+			uint32_t flags = 0U;
+			uint8_t *maddr;
+
+			if (((mux & DMAMUX_CxCR_DMAREQ_ID) != request) || ((ccr & DMA_CCR_EN) == 0U) ||
+			    (count == 0U)) {
+				continue;
+			}
+
+			maddr = (uint8_t *)(uintptr_t)regmodel_read(channel +
+								    offsetof(DMA_Channel_TypeDef, CMAR));
+			if ((ccr & DMA_CCR_MINC) != 0U) {
+				maddr += msize * dma->done[ch];
+			}
+			/* DIR set: from the memory port to the peripheral port */
+			if ((ccr & DMA_CCR_DIR) != 0U) {
+				*data = *maddr;
+			} else {
+				memset(maddr, 0, msize);
+				*maddr = *data;
+			}
+			dma->done[ch]++;
+			count--;
+
+			if (dma->done[ch] == ((dma->done[ch] + count) / 2U)) {
+				flags |= DMA_FLAG_GI | DMA_FLAG_HT;
+			}
+			if (count == 0U) {
+				flags |= DMA_FLAG_GI | DMA_FLAG_TC;
+				if ((ccr & DMA_CCR_CIRC) != 0U) {
+					count = dma->done[ch];
+					dma->done[ch] = 0U;
+				}
+			}
+			regmodel_write(channel + offsetof(DMA_Channel_TypeDef, CNDTR), count);
+			if (flags != 0U) {
+				regmodel_set_bits(periph->base + offsetof(DMA_TypeDef, ISR), flags << (4U * ch));
+				if ((((flags & DMA_FLAG_TC) != 0U) && ((ccr & DMA_CCR_TCIE) != 0U)) ||
+				    (((flags & DMA_FLAG_HT) != 0U) && ((ccr & DMA_CCR_HTIE) != 0U))) {
+					regmodel_irq_raise(dma->irqn[ch]);
+				}
+			}
+			return true;
+		}
+	}
+	return false;
+}
+
+/* SUBGHZSPI -------------------------------------------------------------------------*/
+
+/* Master connected to the radio. The 32-bit receive FIFO drops the overrun data */
+#define SPI_FIFO_SIZE  4U
+
+static struct {
+	uint8_t fifo[SPI_FIFO_SIZE];
+	uint32_t count;
+} subghzspi;
+
+static void subghzspi_update(void)
+{
+	uint32_t cr2 = regmodel_read(SUBGHZSPI_BASE + offsetof(SPI_TypeDef, CR2));
+	uint32_t sr = regmodel_read(SUBGHZSPI_BASE + offsetof(SPI_TypeDef, SR));
+	uint32_t threshold = ((cr2 & SPI_CR2_FRXTH) != 0U) ? 1U : 2U;
+	uint32_t level = (subghzspi.count < 3U) ? subghzspi.count : 3U;
+
+	sr &= ~(SPI_SR_RXNE | SPI_SR_FRLVL | SPI_SR_FTLVL | SPI_SR_BSY);
+	sr |= SPI_SR_TXE | (level << SPI_SR_FRLVL_Pos);
+	if (subghzspi.count >= threshold) {
+		sr |= SPI_SR_RXNE;
+	}
+	regmodel_write(SUBGHZSPI_BASE + offsetof(SPI_TypeDef, SR), sr);
+}
+
+/* Shift a byte out to the radio, the byte shifted in enters the receive FIFO */
+static void subghzspi_shift(uint8_t mosi)
+{
+	uint8_t miso = radio_exchange(mosi);
+
+	if (subghzspi.count < SPI_FIFO_SIZE) {
+		subghzspi.fifo[subghzspi.count++] = miso;
+	}
+}
+
+/* Serve the DMA requests the SUBGHZSPI raises, the transfers complete at once */
+static void subghzspi_dma(void)
+{
+	uint32_t cr1 = regmodel_read(SUBGHZSPI_BASE + offsetof(SPI_TypeDef, CR1));
+	uint32_t cr2 = regmodel_read(SUBGHZSPI_BASE + offsetof(SPI_TypeDef, CR2));
+	bool progress = true;
+	uint8_t data;
+
+	if ((cr1 & SPI_CR1_SPE) == 0U) {
+		return;
+	}
+	while (progress) {
+		progress = false;
+		if (((cr2 & SPI_CR2_RXDMAEN) != 0U) && (subghzspi.count != 0U) &&
+		    dma_request(DMAMUX_REQUEST_SUBGHZSPI_RX, &subghzspi.fifo[0])) {
+			memmove(&subghzspi.fifo[0], &subghzspi.fifo[1], --subghzspi.count);
+			progress = true;
+		}
+		if (((cr2 & SPI_CR2_TXDMAEN) != 0U) &&
+		    (((cr2 & SPI_CR2_RXDMAEN) == 0U) || (subghzspi.count < SPI_FIFO_SIZE)) &&
+		    dma_request(DMAMUX_REQUEST_SUBGHZSPI_TX, &data)) {
+			subghzspi_shift(data);
+			progress = true;
+		}
+	}
+	subghzspi_update();
+}
+
+static void subghzspi_read(struct regmodel_periph *periph, uint32_t offset)
+{
+	if (offset == offsetof(SPI_TypeDef, DR)) {
+		uint32_t size = (regmodel_access_size() < 2U) ? 1U : 2U;
+		uint32_t value = 0U;
+
+		for (uint32_t i = 0U; (i < size) && (subghzspi.count != 0U); i++) {
+			value |= (uint32_t)subghzspi.fifo[0] << (8U * i);
+			memmove(&subghzspi.fifo[0], &subghzspi.fifo[1], --subghzspi.count);
+		}
+		regmodel_write(periph->base + offset, value);
+		subghzspi_update();
+	}
+}
+
+static void subghzspi_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+			    uint32_t previous)
+{
+	uint32_t cr1 = regmodel_read(REG(periph, SPI_TypeDef, CR1));
+
+	if (offset == offsetof(SPI_TypeDef, DR)) {
+		uint32_t size = (regmodel_access_size() < 2U) ? 1U : 2U;
+
+		for (uint32_t i = 0U; (i < size) && ((cr1 & SPI_CR1_SPE) != 0U); i++) {
+			subghzspi_shift((uint8_t)(value >> (8U * i)));
+		}
+	} else if (offset == offsetof(SPI_TypeDef, SR)) {
+		regmodel_write(periph->base + offset, previous);
+	} else if ((offset == offsetof(SPI_TypeDef, CR1)) && ((cr1 & SPI_CR1_SPE) == 0U)) {
+		subghzspi.count = 0U;
+	}
+	subghzspi_update();
+	subghzspi_dma();
+}
+
+static struct regmodel_periph subghzspi_model = {
+	.name = "SUBGHZSPI",
+	.base = SUBGHZSPI_BASE,
+	.size = sizeof(SPI_TypeDef),
+	.read = subghzspi_read,
+	.write = subghzspi_write,
+};
+
+/* AES -----------------------------------------------------------------------------*/
+
+/*
+ * Encryption in ECB and CBC modes, 128 or 256-bit key, 32-bit data type. The
+ * block enters DINR and leaves DOUTR most significant word first. CCF is set
+ * a fixed number of register accesses after the last input word.
+ */
+static const uint8_t aes_sbox[256] = {
+	0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+	0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+	0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+	0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+	0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+	0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+	0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+	0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+	0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+	0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+	0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+	0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+	0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+	0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+	0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+	0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16,
+};
+
+static struct {
+	uint32_t in[4];
+	uint32_t in_count;
+	uint32_t out[4];
+	uint32_t out_count;
+	bool busy;
+} aes;
+
+static uint8_t aes_xtime(uint8_t x)
+{
+	return (uint8_t)((x << 1) ^ (((x & 0x80U) != 0U) ? 0x1BU : 0U));
+}
+
+/* FIPS-197 cipher, @p nk is the key length in words */
+static void aes_cipher(const uint8_t *key, uint32_t nk, uint8_t *state)
+{
+	uint32_t nr = nk + 6U;
+	uint8_t w[4U * 4U * 15U];
+	uint8_t rcon = 0x01U;
+
+	memcpy(w, key, 4U * nk);
+	for (uint32_t i = nk; i < (4U * (nr + 1U)); i++) {
+		uint8_t t[4];
+
+		memcpy(t, &w[4U * (i - 1U)], sizeof(t));
+		if ((i % nk) == 0U) {
+			uint8_t t0 = t[0];
+
+			t[0] = aes_sbox[t[1]] ^ rcon;
+			t[1] = aes_sbox[t[2]];
+			t[2] = aes_sbox[t[3]];
+			t[3] = aes_sbox[t0];
+			rcon = aes_xtime(rcon);
+		} else if ((nk > 6U) && ((i % nk) == 4U)) {
+			for (uint32_t j = 0U; j < 4U; j++) {
+				t[j] = aes_sbox[t[j]];
+			}
+		}
+		for (uint32_t j = 0U; j < 4U; j++) {
+			w[(4U * i) + j] = w[(4U * (i - nk)) + j] ^ t[j];
+		}
+	}
+
+	for (uint32_t j = 0U; j < 16U; j++) {
+		state[j] ^= w[j];
+	}
+	for (uint32_t round = 1U; round <= nr; round++) {
+		uint8_t s[16];
+
+		/* SubBytes and ShiftRows, the state is column-major */
+		for (uint32_t c = 0U; c < 4U; c++) {
+			for (uint32_t r = 0U; r < 4U; r++) {
+				s[(4U * c) + r] = aes_sbox[state[(4U * ((c + r) % 4U)) + r]];
+			}
+		}
+		if (round != nr) {
+			for (uint32_t c = 0U; c < 4U; c++) {
+				uint8_t *a = &s[4U * c];
+				uint8_t all = a[0] ^ a[1] ^ a[2] ^ a[3];
+				uint8_t a0 = a[0];
+
+				a[0] ^= all ^ aes_xtime(a[0] ^ a[1]);
+				a[1] ^= all ^ aes_xtime(a[1] ^ a[2]);
+				a[2] ^= all ^ aes_xtime(a[2] ^ a[3]);
+				a[3] ^= all ^ aes_xtime(a[3] ^ a0);
+			}
+		}
+		for (uint32_t j = 0U; j < 16U; j++) {
+			state[j] = s[j] ^ w[(16U * round) + j];
+		}
+	}
+}
+
+/* Registers holding the most significant word last, to bytes */
+static void aes_bytes(uint32_t reg, uint32_t words, uint8_t *bytes)
+{
+	for (uint32_t i = 0U; i < words; i++) {
+		uint32_t value = regmodel_read(reg + (4U * (words - 1U - i)));
+
+		for (uint32_t j = 0U; j < 4U; j++) {
+			bytes[(4U * i) + j] = (uint8_t)(value >> (24U - (8U * j)));
+		}
+	}
+}
+
+static void aes_complete(void *arg)
+{
+	uint32_t cr = regmodel_read(AES_BASE + offsetof(AES_TypeDef, CR));
+
+	if (!aes.busy) {
+		/* Disabled while computing */
+		return;
+	}
+	aes.busy = false;
+	aes.out_count = 4U;
+	regmodel_clear_bits(AES_BASE + offsetof(AES_TypeDef, SR), AES_SR_BUSY);
+	regmodel_set_bits(AES_BASE + offsetof(AES_TypeDef, SR), AES_SR_CCF);
+	if ((cr & AES_CR_CCFIE) != 0U) {
+		regmodel_irq_raise(AES_IRQn);
+	}
+}
+
+/* Start the computation of the block received */
+static void aes_start(struct regmodel_periph *periph)
+{
+	uint32_t cr = regmodel_read(REG(periph, AES_TypeDef, CR));
+	uint32_t nk = ((cr & AES_CR_KEYSIZE) != 0U) ? 8U : 4U;
+	uint8_t key[32];
+	uint8_t block[16];
+
+	aes_bytes(REG(periph, AES_TypeDef, KEYR0), 4U, &key[4U * (nk - 4U)]);
+	if (nk == 8U) {
+		aes_bytes(REG(periph, AES_TypeDef, KEYR4), 4U, key);
+	}
+	for (uint32_t i = 0U; i < 16U; i++) {
+		block[i] = (uint8_t)(aes.in[i / 4U] >> (24U - (8U * (i % 4U))));
+	}
+	if ((cr & AES_CR_CHMOD) == AES_CR_CHMOD_0) {
+		uint8_t iv[16];
+
+		aes_bytes(REG(periph, AES_TypeDef, IVR0), 4U, iv);
+		for (uint32_t i = 0U; i < 16U; i++) {
+			block[i] ^= iv[i];
+		}
+	}
+	aes_cipher(key, nk, block);
+	for (uint32_t i = 0U; i < 4U; i++) {
+		aes.out[i] = ((uint32_t)block[4U * i] << 24) | ((uint32_t)block[(4U * i) + 1U] << 16) |
+			     ((uint32_t)block[(4U * i) + 2U] << 8) | block[(4U * i) + 3U];
+	}
+	if ((cr & AES_CR_CHMOD) == AES_CR_CHMOD_0) {
+		/* The ciphertext chains to the next block */
+		for (uint32_t i = 0U; i < 4U; i++) {
+			regmodel_write(REG(periph, AES_TypeDef, IVR0) + (4U * (3U - i)), aes.out[i]);
+		}
+	}
+	aes.in_count = 0U;
+	aes.busy = true;
+	regmodel_set_bits(REG(periph, AES_TypeDef, SR), AES_SR_BUSY);
+	(void)regmodel_defer(REGMODEL_AES_ACCESSES, aes_complete, NULL);
+}
+
+static void aes_read(struct regmodel_periph *periph, uint32_t offset)
+{
+	if (offset == offsetof(AES_TypeDef, DOUTR)) {
+		if (aes.out_count != 0U) {
+			regmodel_write(periph->base + offset, aes.out[4U - aes.out_count]);
+			aes.out_count--;
+		} else {
+			regmodel_set_bits(REG(periph, AES_TypeDef, SR), AES_SR_RDERR);
+		}
+	}
+}
+
+static void aes_write(struct regmodel_periph *periph, uint32_t offset, uint32_t value,
+		      uint32_t previous)
+{
+	switch (offset) {
+	case offsetof(AES_TypeDef, CR):
+		if ((value & AES_CR_CCFC) != 0U) {
+			regmodel_clear_bits(REG(periph, AES_TypeDef, SR), AES_SR_CCF);
+		}
+		if ((value & AES_CR_ERRC) != 0U) {
+			regmodel_clear_bits(REG(periph, AES_TypeDef, SR), AES_SR_RDERR | AES_SR_WRERR);
+		}
+		/* Clearing EN aborts the computation and flushes the data */
+		if ((value & AES_CR_EN) == 0U) {
+			aes.in_count = 0U;
+			aes.out_count = 0U;
+			aes.busy = false;
+			regmodel_clear_bits(REG(periph, AES_TypeDef, SR), AES_SR_BUSY);
+		}
+		regmodel_write(periph->base + offset, value & ~(AES_CR_CCFC | AES_CR_ERRC));
+		break;
+	case offsetof(AES_TypeDef, SR):
+		/* Read-only */
+		regmodel_write(periph->base + offset, previous);
+		break;
+	case offsetof(AES_TypeDef, DINR):
+		if ((regmodel_read(REG(periph, AES_TypeDef, CR)) & AES_CR_EN) == 0U) {
+			break;
+		}
+		if (aes.busy || (aes.out_count != 0U)) {
+			regmodel_set_bits(REG(periph, AES_TypeDef, SR), AES_SR_WRERR);
+			break;
+		}
+		aes.in[aes.in_count++] = value;
+		if (aes.in_count == 4U) {
+			aes_start(periph);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static struct regmodel_periph aes_model = {
+	.name = "AES",
+	.base = AES_BASE,
+	.size = sizeof(AES_TypeDef),
+	.read = aes_read,
+	.write = aes_write,
+};
+
+/* Series --------------------------------------------------------------------------*/
+
+void regmodel_series_init(void)
+{
+	/* Cortex-M4 r0p1 */
+	regmodel_write(SCB_BASE + offsetof(SCB_Type, CPUID), 0x410FC241UL);
+
+	/* Reset values: MSI 4 MHz, radio under reset */
+	regmodel_write(REG(&rcc_model, RCC_TypeDef, CR),
+		       RCC_CR_MSION | RCC_CR_MSIRDY | (6UL << RCC_CR_MSIRANGE_Pos));
+	regmodel_write(REG(&rcc_model, RCC_TypeDef, CFGR),
+		       RCC_CFGR_HPREF | RCC_CFGR_PPRE1F | RCC_CFGR_PPRE2F);
+	regmodel_write(REG(&rcc_model, RCC_TypeDef, EXTCFGR),
+		       RCC_EXTCFGR_SHDHPREF | RCC_EXTCFGR_C2HPREF);
+	regmodel_write(REG(&rcc_model, RCC_TypeDef, CSR),
+		       (6UL << RCC_CSR_MSISRANGE_Pos) | RCC_CSR_RFRST | RCC_CSR_RFRSTF);
+	regmodel_attach(&rcc_model);
+
+	regmodel_write(REG(&pwr_model, PWR_TypeDef, SUBGHZSPICR), PWR_SUBGHZSPICR_NSS);
+	regmodel_write(REG(&pwr_model, PWR_TypeDef, SR2), PWR_SR2_RFBUSYS | PWR_SR2_RFBUSYMS);
+	regmodel_attach(&pwr_model);
+	regmodel_attach(&exti_model);
+
+	regmodel_attach(&dma1_model);
+	regmodel_attach(&dma2_model);
+
+	regmodel_write(REG(&subghzspi_model, SPI_TypeDef, CR2), 0x00000700UL);
+	regmodel_write(REG(&subghzspi_model, SPI_TypeDef, SR), SPI_SR_TXE);
+	regmodel_attach(&subghzspi_model);
+
+	regmodel_attach(&aes_model);
+}
@@ -0,0 +1,64 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Peripheral models of the STM32WL series:
+ *
+ * - RCC: oscillator, PLL, system clock switch and radio reset
+ *   acknowledgments.
+ * - PWR, EXTI: sub-GHz radio NSS and BUSY signals, radio BUSY edge flag and
+ *   interrupt (EXTI line 45, SUBGHZ_Radio_IRQn).
+ * - SUBGHZSPI: master connected to the radio, Rx FIFO, Tx and Rx DMA
+ *   requests.
+ * - DMA1, DMA2 through DMAMUX1: SUBGHZSPI requests. The DMA addresses are
+ *   32-bit, so the buffers must be static (the host build is not PIE).
+ * - Sub-GHz radio: register file, 256-byte data buffer, sleep and BUSY. BUSY
+ *   is raised at the end of each command and when the radio wakes up, and
+ *   released after a fixed number of register accesses in lockstep mode.
+ *   Radio interrupts (EXTI line 44) are not modelled.
+ * - AES: encryption in ECB and CBC modes with a 128 or 256-bit key, 32-bit
+ *   data type, computation complete flag and interrupt (AES_IRQn), read and
+ *   write errors. The other chaining modes, decryption and the DMA requests
+ *   are not modelled.
+ *
+ * The other peripherals are plain registers.
+ */
+
+#ifndef REGMODEL_STM32WLXX_H
+#define REGMODEL_STM32WLXX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Register accesses the radio stays BUSY after a command */
+#define REGMODEL_RADIO_BUSY_ACCESSES    16U
+
+/** Register accesses the radio stays BUSY when woken up from sleep or reset */
+#define REGMODEL_RADIO_WAKEUP_ACCESSES  64U
+
+/** Register accesses the AES takes to compute a block */
+#define REGMODEL_AES_ACCESSES           8U
+
+/**
+ * @brief Take the command bytes received by the radio since the last call.
+ *
+ * @return Number of bytes copied to @p data.
+ */
+size_t regmodel_radio_capture(uint8_t *data, size_t size);
+
+/** @brief Data buffer of the radio, 256 bytes. */
+uint8_t *regmodel_radio_buffer(void);
+
+/** @brief Commands started while the radio was BUSY, since the last call. */
+uint32_t regmodel_radio_busy_errors(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REGMODEL_STM32WLXX_H */
@@ -0,0 +1,210 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * HAL wait strategy: the polling I2C transfers blocked in I2C_WaitOnEvent()
+ * and HAL_WaitBlock() until the I2C1 event or error interrupt, against the
+ * same transfers busy-polling, and the bus errors ending a blocked transfer.
+ * The I2C1 model takes a byte time so that the transfers wait.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32g4xx_hal.h"
+#include "regmodel.h"
+#include "regmodel_stm32g4xx.h"
+
+#define MEMORY_ADDRESS  0xA0U
+#define BYTE_TIME_US    200U
+
+static I2C_HandleTypeDef hi2c1;
+static volatile int signaled;
+static uint32_t waits;
+static uint32_t signals;
+
+static void systick_isr(void)
+{
+	HAL_IncTick();
+}
+
+static void i2c1_ev_isr(void)
+{
+	HAL_I2C_EV_IRQHandler(&hi2c1);
+}
+
+static void i2c1_er_isr(void)
+{
+	HAL_I2C_ER_IRQHandler(&hi2c1);
+}
+
+/* Strategy of a single thread: sleep until the interrupt signaling the handle */
+static void strategy_wait(const void *pObject, uint32_t Timeout)
+{
+	uint32_t tickstart = HAL_GetTick();
+
+	waits++;
+	while (!signaled) {
+		if ((Timeout != HAL_MAX_DELAY) && ((HAL_GetTick() - tickstart) >= Timeout)) {
+			return;
+		}
+		__WFI();
+	}
+	signaled = 0;
+}
+
+static void strategy_signal(const void *pObject)
+{
+	if (pObject == &hi2c1) {
+		signals++;
+		signaled = 1;
+	}
+}
+
+static const HAL_WaitStrategyTypeDef strategy = {
+	.Wait = strategy_wait,
+	.Signal = strategy_signal,
+};
+
+static int check(const char *name, int ok)
+{
+	printf("i2c_wait.%-24s %s\n", name, ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+static int setup(void)
+{
+	__HAL_RCC_I2C1_CLK_ENABLE();
+
+	hi2c1.Instance = I2C1;
+	hi2c1.Init.Timing = 0x10802D9BU;
+	hi2c1.Init.OwnAddress1 = 0U;
+	hi2c1.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+	hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+	hi2c1.Init.OwnAddress2 = 0U;
+	hi2c1.Init.OwnAddress2Masks = I2C_OA2_NOMASK;
+	hi2c1.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+	hi2c1.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+	return (HAL_I2C_Init(&hi2c1) == HAL_OK) ? 0 : -1;
+}
+
+/*
+ * An error interrupt taken while no transfer runs in interrupt mode: the
+ * flags are cleared and the error recorded before the waiter is signaled.
+ * Called with the I2C1 interrupts still disabled in the NVIC.
+ */
+static int error_handler(void)
+{
+	int ok;
+
+	if (HAL_WaitSetStrategy(&strategy) != HAL_OK) {
+		return -1;
+	}
+	hi2c1.ErrorCode = HAL_I2C_ERROR_NONE;
+	__HAL_I2C_ENABLE_IT(&hi2c1, I2C_IT_ERRI);
+	regmodel_i2c_inject_error(I2C1_BASE, I2C_ISR_ARLO | I2C_ISR_BERR);
+	HAL_I2C_ER_IRQHandler(&hi2c1);
+	HAL_NVIC_ClearPendingIRQ(I2C1_ER_IRQn);
+
+	ok = (hi2c1.ErrorCode == (HAL_I2C_ERROR_ARLO | HAL_I2C_ERROR_BERR)) &&
+	     ((hi2c1.Instance->ISR & (I2C_ISR_ARLO | I2C_ISR_BERR)) == 0U) &&
+	     ((hi2c1.Instance->CR1 & I2C_CR1_ERRIE) == 0U) && (signals == 1U) &&
+	     (hi2c1.State == HAL_I2C_STATE_READY);
+	signaled = 0;
+	return ok ? 0 : -1;
+}
+
+/* One write and read back of 32 bytes, with the register reads made */
+static int transfer(uint64_t *reads)
+{
+	static uint8_t src[32];
+	static uint8_t dst[32];
+	struct regmodel_stats before;
+	struct regmodel_stats after;
+
+	for (size_t i = 0U; i < sizeof(src); i++) {
+		src[i] = (uint8_t)((i * 7U) + *reads);
+	}
+	memset(dst, 0, sizeof(dst));
+	regmodel_stats_get(&before);
+	if ((HAL_I2C_Mem_Write(&hi2c1, MEMORY_ADDRESS, 0x20U, I2C_MEMADD_SIZE_8BIT, src, sizeof(src),
+			       1000U) != HAL_OK) ||
+	    (HAL_I2C_Mem_Read(&hi2c1, MEMORY_ADDRESS, 0x20U, I2C_MEMADD_SIZE_8BIT, dst, sizeof(dst),
+			      1000U) != HAL_OK)) {
+		return -1;
+	}
+	regmodel_stats_get(&after);
+	*reads = after.reads - before.reads;
+	return (memcmp(src, dst, sizeof(src)) == 0) ? 0 : -1;
+}
+
+/* Blocked until the interrupts, far fewer register reads than busy-polling */
+static int blocking(void)
+{
+	uint64_t busy = 0U;
+	uint64_t blocked = 1U;
+
+	if ((HAL_WaitSetStrategy(NULL) != HAL_OK) || (transfer(&busy) != 0)) {
+		return -1;
+	}
+	waits = 0U;
+	signals = 0U;
+	if ((HAL_WaitSetStrategy(&strategy) != HAL_OK) || (transfer(&blocked) != 0)) {
+		return -1;
+	}
+	printf("i2c_wait.reads: busy-polling %llu, blocked %llu (%u waits, %u signals)\n",
+	       (unsigned long long)busy, (unsigned long long)blocked, (unsigned int)waits,
+	       (unsigned int)signals);
+	/* Every byte awaited: 64 data bytes, the 2 memory addresses */
+	return ((waits >= 66U) && (signals >= 66U) && (blocked < busy)) ? 0 : -1;
+}
+
+static void inject_berr(void *arg)
+{
+	regmodel_i2c_inject_error(I2C1_BASE, I2C_ISR_BERR);
+}
+
+/* A bus error in the middle of a blocked transfer ends it, not its timeout */
+static int bus_error(void)
+{
+	static uint8_t src[64];
+	uint32_t tickstart;
+	HAL_StatusTypeDef status;
+
+	if ((HAL_WaitSetStrategy(&strategy) != HAL_OK) ||
+	    (regmodel_defer(10U * BYTE_TIME_US, inject_berr, NULL) != 0)) {
+		return -1;
+	}
+	tickstart = HAL_GetTick();
+	status = HAL_I2C_Mem_Write(&hi2c1, MEMORY_ADDRESS, 0x00U, I2C_MEMADD_SIZE_8BIT, src, sizeof(src),
+				   1000U);
+	return ((status == HAL_ERROR) && (hi2c1.ErrorCode == HAL_I2C_ERROR_BERR) &&
+		((hi2c1.Instance->ISR & I2C_ISR_BERR) == 0U) && (hi2c1.State == HAL_I2C_STATE_READY) &&
+		((HAL_GetTick() - tickstart) < 1000U)) ? 0 : -1;
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	if (regmodel_init() != 0) {
+		return 1;
+	}
+	regmodel_irq_connect(REGMODEL_SYSTICK_IRQN, systick_isr);
+	regmodel_irq_connect(I2C1_EV_IRQn, i2c1_ev_isr);
+	regmodel_irq_connect(I2C1_ER_IRQn, i2c1_er_isr);
+
+	failed |= check("HAL_Init", HAL_Init() == HAL_OK);
+	failed |= check("setup", setup() == 0);
+	failed |= check("error_handler", error_handler() == 0);
+
+	HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+	HAL_NVIC_EnableIRQ(I2C1_ER_IRQn);
+	regmodel_i2c_set_byte_time(I2C1_BASE, BYTE_TIME_US);
+
+	failed |= check("blocking", blocking() == 0);
+	failed |= check("bus_error", bus_error() == 0);
+
+	return failed;
+}
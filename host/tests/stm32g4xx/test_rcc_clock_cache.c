@@ -0,0 +1,204 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * RCC clock tree cache: the frequency getters answering from the snapshot
+ * without register access, the notifiers called with the new clock tree, and
+ * the snapshot taken again when an interrupt changes the clock configuration
+ * while it is being taken. The model runs in lockstep for the latter, so that
+ * the interrupt lands on each register access of HAL_RCC_GetClockTree().
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32g4xx_hal.h"
+#include "regmodel.h"
+
+static RCC_ClockTreeTypeDef notified[2];
+static uint32_t notifications[2];
+static uint32_t notify_order;
+static volatile int clock_isr_done;
+static volatile int in_get;
+static uint32_t preempted;
+
+static void systick_isr(void)
+{
+	HAL_IncTick();
+}
+
+/* Halves or restores PCLK1, as a clock failure handler would */
+static void clock_isr(void)
+{
+	RCC->CFGR ^= RCC_CFGR_PPRE1_2;
+	HAL_RCC_UpdateClockTree();
+	preempted += (uint32_t)in_get;
+	clock_isr_done = 1;
+}
+
+static void raise_clock_irq(void *arg)
+{
+	regmodel_irq_raise(RCC_IRQn);
+}
+
+static void notify(const RCC_ClockTreeTypeDef *pClockTree, void *pContext)
+{
+	uint32_t index = (uint32_t)(uintptr_t)pContext;
+
+	notified[index] = *pClockTree;
+	notifications[index]++;
+	notify_order = (notify_order * 10U) + index + 1U;
+}
+
+static int check(const char *name, int ok)
+{
+	printf("rcc_clock_cache.%-24s %s\n", name, ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+static int clock_config(uint32_t apb1_divider)
+{
+	RCC_ClkInitTypeDef clk = { 0 };
+
+	clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 |
+			RCC_CLOCKTYPE_PCLK2;
+	clk.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+	clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	clk.APB1CLKDivider = apb1_divider;
+	clk.APB2CLKDivider = RCC_HCLK_DIV2;
+	return (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_0) == HAL_OK) ? 0 : -1;
+}
+
+/* PCLK1 from the registers, as HAL_RCC_GetPCLK1Freq() computes it uncached */
+static uint32_t pclk1_registers(void)
+{
+	return HSI_VALUE >> APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos];
+}
+
+/* Getters without register access once the snapshot is taken */
+static int cache(void)
+{
+	const RCC_ClockTreeTypeDef *tree;
+	struct regmodel_stats before;
+	struct regmodel_stats after;
+	uint32_t generation;
+	uint32_t sysclk;
+	uint32_t pclk1;
+	uint32_t pclk2;
+
+	if (clock_config(RCC_HCLK_DIV1) != 0) {
+		return -1;
+	}
+	tree = HAL_RCC_GetClockTree();
+	generation = tree->Generation;
+	if ((tree->SYSCLKFreq != HSI_VALUE) || (tree->HCLKFreq != HSI_VALUE) ||
+	    (tree->PCLK1Freq != HSI_VALUE) || (tree->PCLK2Freq != (HSI_VALUE / 2U))) {
+		return -1;
+	}
+
+	regmodel_stats_get(&before);
+	sysclk = HAL_RCC_GetSysClockFreq();
+	pclk1 = HAL_RCC_GetPCLK1Freq();
+	pclk2 = HAL_RCC_GetPCLK2Freq();
+	regmodel_stats_get(&after);
+	if ((after.reads != before.reads) || (sysclk != HSI_VALUE) || (pclk1 != HSI_VALUE) ||
+	    (pclk2 != (HSI_VALUE / 2U))) {
+		return -1;
+	}
+
+	/* Reconfiguration: invalidated on entry, taken again on completion */
+	if (clock_config(RCC_HCLK_DIV4) != 0) {
+		return -1;
+	}
+	return ((HAL_RCC_GetClockTree() == tree) && (tree->Generation == generation + 2U) &&
+		(tree->PCLK1Freq == (HSI_VALUE / 4U)) && (HAL_RCC_GetPCLK1Freq() == (HSI_VALUE / 4U))) ?
+		0 : -1;
+}
+
+/* Called in registration order with the new tree, once each per change */
+static int notifiers(void)
+{
+	static RCC_ClockNotifierTypeDef first = { .Callback = notify, .pContext = (void *)0 };
+	static RCC_ClockNotifierTypeDef second = { .Callback = notify, .pContext = (void *)1 };
+	RCC_ClockNotifierTypeDef no_callback = { 0 };
+
+	if ((HAL_RCC_RegisterClockNotifier(&first) != HAL_OK) ||
+	    (HAL_RCC_RegisterClockNotifier(&second) != HAL_OK) ||
+	    (HAL_RCC_RegisterClockNotifier(&first) != HAL_ERROR) ||
+	    (HAL_RCC_RegisterClockNotifier(&no_callback) != HAL_ERROR) ||
+	    (HAL_RCC_RegisterClockNotifier(NULL) != HAL_ERROR)) {
+		return -1;
+	}
+
+	notify_order = 0U;
+	if ((clock_config(RCC_HCLK_DIV2) != 0) || (notify_order != 12U) || (notifications[0] != 1U) ||
+	    (notifications[1] != 1U) || (notified[0].PCLK1Freq != (HSI_VALUE / 2U)) ||
+	    (memcmp(&notified[0], HAL_RCC_GetClockTree(), sizeof(notified[0])) != 0) ||
+	    (memcmp(&notified[1], &notified[0], sizeof(notified[0])) != 0)) {
+		return -1;
+	}
+
+	/* Unregistered: no longer called */
+	notify_order = 0U;
+	if ((HAL_RCC_UnRegisterClockNotifier(&first) != HAL_OK) ||
+	    (HAL_RCC_UnRegisterClockNotifier(&first) != HAL_ERROR) || (clock_config(RCC_HCLK_DIV1) != 0) ||
+	    (notify_order != 2U) || (notifications[0] != 1U) || (notifications[1] != 2U)) {
+		return -1;
+	}
+	return (HAL_RCC_UnRegisterClockNotifier(&second) == HAL_OK) ? 0 : -1;
+}
+
+/*
+ * An interrupt changing PCLK1 after each register access of the snapshot:
+ * the snapshot returned matches the registers whenever the interrupt lands.
+ */
+static int preemption(void)
+{
+	uint32_t stale = 0U;
+
+	HAL_NVIC_EnableIRQ(RCC_IRQn);
+	regmodel_set_lockstep(1);
+	for (uint32_t delay = 1U; delay <= 16U; delay++) {
+		const RCC_ClockTreeTypeDef *tree;
+
+		HAL_RCC_InvalidateClockTree();
+		clock_isr_done = 0;
+		if (regmodel_defer(delay, raise_clock_irq, NULL) != 0) {
+			return -1;
+		}
+		in_get = 1;
+		tree = HAL_RCC_GetClockTree();
+		in_get = 0;
+		while (!clock_isr_done) {
+			__WFI();
+		}
+		if ((tree->PCLK1Freq != pclk1_registers()) || (HAL_RCC_GetPCLK1Freq() != pclk1_registers())) {
+			stale++;
+		}
+	}
+	regmodel_set_lockstep(0);
+	HAL_NVIC_DisableIRQ(RCC_IRQn);
+
+	printf("rcc_clock_cache.preemption: %u of 16 interrupts during the snapshot, %u stale\n",
+	       (unsigned int)preempted, (unsigned int)stale);
+	return ((preempted != 0U) && (stale == 0U)) ? 0 : -1;
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	if (regmodel_init() != 0) {
+		return 1;
+	}
+	regmodel_irq_connect(REGMODEL_SYSTICK_IRQN, systick_isr);
+	regmodel_irq_connect(RCC_IRQn, clock_isr);
+
+	failed |= check("HAL_Init", HAL_Init() == HAL_OK);
+	failed |= check("cache", cache() == 0);
+	failed |= check("notifiers", notifiers() == 0);
+	failed |= check("preemption", preemption() == 0);
+
+	return failed;
+}
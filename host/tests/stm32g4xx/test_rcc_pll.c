@@ -0,0 +1,142 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * RCC extended module: the PLL solver, its configurations applied through
+ * HAL_RCC_OscConfig() on the RCC model and read back with
+ * HAL_RCC_GetSysClockFreq(), and the targets out of reach.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32g4xx_hal.h"
+#include "regmodel.h"
+
+static void systick_isr(void)
+{
+	HAL_IncTick();
+}
+
+static int check(const char *name, int ok)
+{
+	printf("rcc_pll.%-24s %s\n", name, ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+/* 170 MHz system clock from the HSI: the configuration of the reference manual */
+static int solve_sysclk(RCC_PLLInitTypeDef *pll)
+{
+	RCC_PLLTargetTypeDef target = {
+		.PLLSource = RCC_PLLSOURCE_HSI,
+		.InputFreq = HSI_VALUE,
+		.PLLQFreq = 85000000U,
+		.PLLRFreq = 170000000U,
+	};
+
+	if (HAL_RCCEx_PLLSolve(&target, pll) != HAL_OK) {
+		return -1;
+	}
+	/* Unused PLLP output at its lowest frequency */
+	return ((pll->PLLState == RCC_PLL_ON) && (pll->PLLSource == RCC_PLLSOURCE_HSI) &&
+		(pll->PLLM == RCC_PLLM_DIV4) && (pll->PLLN == 85U) && (pll->PLLP == RCC_PLLP_DIV31) &&
+		(pll->PLLQ == RCC_PLLQ_DIV4) && (pll->PLLR == RCC_PLLR_DIV2)) ? 0 : -1;
+}
+
+/* The solved configuration, programmed in boost mode */
+static int apply(const RCC_PLLInitTypeDef *pll)
+{
+	RCC_OscInitTypeDef osc = { 0 };
+	RCC_ClkInitTypeDef clk = { 0 };
+
+	HAL_PWREx_ControlVoltageScaling(PWR_REGULATOR_VOLTAGE_SCALE1_BOOST);
+
+	osc.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+	osc.HSIState = RCC_HSI_ON;
+	osc.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+	osc.PLL = *pll;
+	if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+		return -1;
+	}
+
+	clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 |
+			RCC_CLOCKTYPE_PCLK2;
+	clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+	clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	clk.APB1CLKDivider = RCC_HCLK_DIV1;
+	clk.APB2CLKDivider = RCC_HCLK_DIV1;
+	if (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_4) != HAL_OK) {
+		return -1;
+	}
+	return ((HAL_RCC_GetSysClockFreq() == 170000000U) && (SystemCoreClock == 170000000U)) ? 0 : -1;
+}
+
+/* Within tolerance only: 165 MHz is not reachable exactly from 16 MHz */
+static int tolerance(void)
+{
+	RCC_PLLTargetTypeDef target = {
+		.PLLSource = RCC_PLLSOURCE_HSI,
+		.InputFreq = HSI_VALUE,
+		.PLLRFreq = 165000000U,
+	};
+	RCC_PLLInitTypeDef pll = { 0 };
+	uint32_t freq;
+
+	if (HAL_RCCEx_PLLSolve(&target, &pll) != HAL_ERROR) {
+		return -1;
+	}
+	target.PLLRTolerance = 1000000U;
+	if (HAL_RCCEx_PLLSolve(&target, &pll) != HAL_OK) {
+		return -1;
+	}
+	/* Same computation as HAL_RCC_GetSysClockFreq() */
+	freq = ((HSI_VALUE / pll.PLLM) * pll.PLLN) / pll.PLLR;
+	printf("rcc_pll.tolerance: M=%u N=%u R=%u, %u Hz for 165000000 Hz\n", (unsigned int)pll.PLLM,
+	       (unsigned int)pll.PLLN, (unsigned int)pll.PLLR, (unsigned int)freq);
+	return ((freq != 165000000U) && (freq >= 164000000U) && (freq <= 166000000U)) ? 0 : -1;
+}
+
+/* Above the VCO range divided by the lowest PLLR, or no PLL entry clock in range */
+static int unreachable(void)
+{
+	RCC_PLLTargetTypeDef target = {
+		.PLLSource = RCC_PLLSOURCE_HSE,
+		.InputFreq = 24000000U,
+		.PLLRFreq = 200000000U,
+		.PLLRTolerance = 1000000U,
+	};
+	RCC_PLLInitTypeDef pll;
+
+	memset(&pll, 0xA5, sizeof(pll));
+	if (HAL_RCCEx_PLLSolve(&target, &pll) != HAL_ERROR) {
+		return -1;
+	}
+	target.PLLRFreq = 100000000U;
+	target.InputFreq = 2000000U;
+	if ((HAL_RCCEx_PLLSolve(&target, &pll) != HAL_ERROR) || (HAL_RCCEx_PLLSolve(NULL, &pll) != HAL_ERROR) ||
+	    (HAL_RCCEx_PLLSolve(&target, NULL) != HAL_ERROR)) {
+		return -1;
+	}
+	/* Left unchanged on error */
+	return (pll.PLLM == 0xA5A5A5A5U) ? 0 : -1;
+}
+
+int main(void)
+{
+	RCC_PLLInitTypeDef pll = { 0 };
+	int failed = 0;
+
+	if (regmodel_init() != 0) {
+		return 1;
+	}
+	regmodel_irq_connect(REGMODEL_SYSTICK_IRQN, systick_isr);
+
+	failed |= check("HAL_Init", HAL_Init() == HAL_OK);
+	failed |= check("solve_sysclk", solve_sysclk(&pll) == 0);
+	failed |= check("apply", apply(&pll) == 0);
+	failed |= check("tolerance", tolerance() == 0);
+	failed |= check("unreachable", unreachable() == 0);
+
+	return failed;
+}
@@ -0,0 +1,307 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SMARTCARD extended module: APDU exchanges of the T=1 block engine with a
+ * scripted card on the USART1 model. The card answers each block the engine
+ * sends with the next step of the script, with a corrupted EDC or an R-block
+ * where a retransmission is expected. The exchange latency is measured with a
+ * microsecond GetTime() hook.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "stm32g4xx_hal.h"
+#include "regmodel.h"
+#include "regmodel_stm32g4xx.h"
+
+#define CARD_NAD    0x00U
+#define BLOCK_MAX   (3U + SMARTCARDEX_T1_IFS_MAX + 1U)
+
+/* One step of the card script: block expected from the engine, then the answer */
+struct card_step {
+	uint8_t expect[BLOCK_MAX];  /* NAD, PCB, LEN and INF, the LRC is checked apart */
+	size_t expect_len;
+	uint8_t answer[BLOCK_MAX];  /* NAD, PCB, LEN and INF, the LRC is appended */
+	size_t answer_len;
+	int corrupt;                /* Answer sent with a wrong LRC */
+};
+
+static SMARTCARD_HandleTypeDef hsmartcard;
+static SMARTCARDEx_T1TypeDef ht1;
+static volatile int block_sent;
+static volatile int apdu_done;
+
+static void systick_isr(void)
+{
+	HAL_IncTick();
+}
+
+static void usart1_isr(void)
+{
+	HAL_SMARTCARD_IRQHandler(&hsmartcard);
+}
+
+void HAL_SMARTCARD_MspInit(SMARTCARD_HandleTypeDef *hsc)
+{
+	__HAL_RCC_USART1_CLK_ENABLE();
+	HAL_NVIC_EnableIRQ(USART1_IRQn);
+}
+
+void HAL_SMARTCARD_TxCpltCallback(SMARTCARD_HandleTypeDef *hsc)
+{
+	/* The engine starts the reception of the answer before the card is told */
+	HAL_SMARTCARDEx_T1_TxCplt(&ht1);
+	block_sent = 1;
+}
+
+void HAL_SMARTCARD_RxCpltCallback(SMARTCARD_HandleTypeDef *hsc)
+{
+	HAL_SMARTCARDEx_T1_RxCplt(&ht1);
+}
+
+void HAL_SMARTCARD_ErrorCallback(SMARTCARD_HandleTypeDef *hsc)
+{
+	HAL_SMARTCARDEx_T1_Error(&ht1);
+}
+
+static void apdu_complete(SMARTCARDEx_T1TypeDef *pht1)
+{
+	apdu_done = 1;
+}
+
+/* Microseconds, for a latency below the SysTick period */
+static uint32_t time_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U));
+}
+
+static int check(const char *name, int ok)
+{
+	printf("smartcard_t1.%-24s %s\n", name, ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+static uint8_t lrc(const uint8_t *block, size_t len)
+{
+	uint8_t edc = 0U;
+
+	for (size_t i = 0U; i < len; i++) {
+		edc ^= block[i];
+	}
+	return edc;
+}
+
+/* Engine ---------------------------------------------------------------------------*/
+
+static int t1_init(void)
+{
+	static const SMARTCARDEx_T1InitTypeDef t1 = {
+		.BWT = 15360U,
+		.CWT = 45U,
+		.EDC = SMARTCARDEX_T1_EDC_LRC,
+		.NAD = CARD_NAD,
+		.IFSC = 32U,
+		.IFSD = 32U,
+	};
+
+	hsmartcard.Instance = USART1;
+	hsmartcard.Init.BaudRate = 10752U;
+	hsmartcard.Init.WordLength = SMARTCARD_WORDLENGTH_9B;
+	hsmartcard.Init.StopBits = SMARTCARD_STOPBITS_1_5;
+	hsmartcard.Init.Parity = SMARTCARD_PARITY_EVEN;
+	hsmartcard.Init.Mode = SMARTCARD_MODE_TX_RX;
+	hsmartcard.Init.CLKPolarity = SMARTCARD_POLARITY_LOW;
+	hsmartcard.Init.CLKPhase = SMARTCARD_PHASE_1EDGE;
+	hsmartcard.Init.CLKLastBit = SMARTCARD_LASTBIT_ENABLE;
+	hsmartcard.Init.OneBitSampling = SMARTCARD_ONE_BIT_SAMPLE_DISABLE;
+	hsmartcard.Init.Prescaler = 10U;
+	hsmartcard.Init.GuardTime = 2U;
+	hsmartcard.Init.NACKEnable = SMARTCARD_NACK_DISABLE;
+	hsmartcard.Init.TimeOutEnable = SMARTCARD_TIMEOUT_ENABLE;
+	hsmartcard.Init.TimeOutValue = t1.BWT;
+	hsmartcard.Init.BlockLength = 0U;
+	hsmartcard.Init.AutoRetryCount = 0U;
+	hsmartcard.Init.ClockPrescaler = SMARTCARD_PRESCALER_DIV1;
+	hsmartcard.AdvancedInit.AdvFeatureInit = SMARTCARD_ADVFEATURE_NO_INIT;
+	if ((HAL_SMARTCARD_Init(&hsmartcard) != HAL_OK) ||
+	    (HAL_SMARTCARDEx_T1_Init(&ht1, &hsmartcard, &t1) != HAL_OK)) {
+		return -1;
+	}
+	ht1.GetTime = time_us;
+	ht1.ApduCpltCallback = apdu_complete;
+	return 0;
+}
+
+/*
+ * Run an APDU exchange against the card script: every block the engine sends
+ * must match the next step, which gives the card answer.
+ */
+static int exchange(const uint8_t *cmd, uint16_t cmd_size, uint8_t *rsp, uint16_t rsp_size,
+		    const struct card_step *script, size_t steps)
+{
+	uint32_t tickstart = HAL_GetTick();
+	uint8_t block[BLOCK_MAX + 1U];
+	size_t step = 0U;
+
+	block_sent = 0;
+	apdu_done = 0;
+	if (HAL_SMARTCARDEx_T1_Transceive_IT(&ht1, cmd, cmd_size, rsp, rsp_size) != HAL_OK) {
+		return -1;
+	}
+	while (apdu_done == 0) {
+		if ((HAL_GetTick() - tickstart) > 1000U) {
+			return -1;
+		}
+		if (block_sent != 0) {
+			const struct card_step *s = &script[step];
+			uint8_t answer[BLOCK_MAX + 1U];
+			size_t len;
+
+			block_sent = 0;
+			len = regmodel_uart_capture(USART1_BASE, block, sizeof(block));
+			if ((step == steps) || (len != (s->expect_len + 1U)) ||
+			    (memcmp(block, s->expect, s->expect_len) != 0) ||
+			    (block[s->expect_len] != lrc(s->expect, s->expect_len))) {
+				return -1;
+			}
+			memcpy(answer, s->answer, s->answer_len);
+			answer[s->answer_len] = lrc(s->answer, s->answer_len) ^ (s->corrupt ? 0x5AU : 0U);
+			if (regmodel_uart_inject(USART1_BASE, answer, s->answer_len + 1U) != (s->answer_len + 1U)) {
+				return -1;
+			}
+			step++;
+		}
+		__WFI();
+	}
+	/* Every step of the script played, nothing sent after the last one */
+	return ((step == steps) && (regmodel_uart_capture(USART1_BASE, block, sizeof(block)) == 0U)) ? 0 : -1;
+}
+
+/*
+ * SELECT, answered with a corrupted I-block: the engine asks for it again
+ * with R(0) EDC error, then takes the good copy.
+ */
+static int apdu_bad_edc(void)
+{
+	static const uint8_t cmd[] = { 0x00U, 0xA4U, 0x04U, 0x00U, 0x02U, 0x3FU, 0x00U };
+	static const struct card_step script[] = {
+		{
+			.expect = { CARD_NAD, 0x00U, 7U, 0x00U, 0xA4U, 0x04U, 0x00U, 0x02U, 0x3FU, 0x00U },
+			.expect_len = 10U,
+			.answer = { CARD_NAD, 0x00U, 2U, 0x90U, 0x00U },
+			.answer_len = 5U,
+			.corrupt = 1,
+		},
+		{
+			.expect = { CARD_NAD, 0x81U, 0U },
+			.expect_len = 3U,
+			.answer = { CARD_NAD, 0x00U, 2U, 0x90U, 0x00U },
+			.answer_len = 5U,
+		},
+	};
+	uint8_t rsp[16];
+
+	HAL_SMARTCARDEx_T1_ResetStats(&ht1);
+	if ((exchange(cmd, sizeof(cmd), rsp, sizeof(rsp), script, 2U) != 0) ||
+	    (ht1.ErrorCode != HAL_SMARTCARDEX_T1_ERROR_NONE)) {
+		return -1;
+	}
+	return ((ht1.RspLength == 2U) && (rsp[0] == 0x90U) && (rsp[1] == 0x00U) &&
+		(ht1.Stats.Apdus == 1U) && (ht1.Stats.Blocks == 2U) && (ht1.Stats.Retransmissions == 1U) &&
+		(ht1.Stats.Errors == 0U)) ? 0 : -1;
+}
+
+/*
+ * READ BINARY, after the previous exchange: the card missed the I-block and
+ * asks for it again with R(1), the engine sends the same block.
+ */
+static int apdu_resend(void)
+{
+	static const uint8_t cmd[] = { 0x00U, 0xB0U, 0x00U, 0x00U, 0x04U };
+	static const struct card_step script[] = {
+		{
+			.expect = { CARD_NAD, 0x40U, 5U, 0x00U, 0xB0U, 0x00U, 0x00U, 0x04U },
+			.expect_len = 8U,
+			.answer = { CARD_NAD, 0x92U, 0U },
+			.answer_len = 3U,
+		},
+		{
+			.expect = { CARD_NAD, 0x40U, 5U, 0x00U, 0xB0U, 0x00U, 0x00U, 0x04U },
+			.expect_len = 8U,
+			.answer = { CARD_NAD, 0x40U, 6U, 0xDEU, 0xADU, 0xBEU, 0xEFU, 0x90U, 0x00U },
+			.answer_len = 9U,
+		},
+	};
+	static const uint8_t expected[] = { 0xDEU, 0xADU, 0xBEU, 0xEFU, 0x90U, 0x00U };
+	uint8_t rsp[16];
+
+	HAL_SMARTCARDEx_T1_ResetStats(&ht1);
+	if ((exchange(cmd, sizeof(cmd), rsp, sizeof(rsp), script, 2U) != 0) ||
+	    (ht1.ErrorCode != HAL_SMARTCARDEX_T1_ERROR_NONE)) {
+		return -1;
+	}
+	return ((ht1.RspLength == sizeof(expected)) && (memcmp(rsp, expected, sizeof(expected)) == 0) &&
+		(ht1.Stats.Blocks == 2U) && (ht1.Stats.Retransmissions == 1U)) ? 0 : -1;
+}
+
+/* Latency of a clean exchange, one block each way */
+static int apdu_latency(void)
+{
+	static const uint8_t cmd[] = { 0x80U, 0xCAU, 0x9FU, 0x7FU, 0x00U };
+	static const struct card_step script[] = {
+		{
+			.expect = { CARD_NAD, 0x00U, 5U, 0x80U, 0xCAU, 0x9FU, 0x7FU, 0x00U },
+			.expect_len = 8U,
+			.answer = { CARD_NAD, 0x00U, 2U, 0x90U, 0x00U },
+			.answer_len = 5U,
+		},
+		{
+			.expect = { CARD_NAD, 0x40U, 5U, 0x80U, 0xCAU, 0x9FU, 0x7FU, 0x00U },
+			.expect_len = 8U,
+			.answer = { CARD_NAD, 0x40U, 2U, 0x90U, 0x00U },
+			.answer_len = 5U,
+		},
+	};
+	uint32_t total = 0U;
+	uint8_t rsp[16];
+
+	HAL_SMARTCARDEx_T1_ResetStats(&ht1);
+	for (int round = 0; round < 100; round++) {
+		/* The sequence numbers toggle at each exchange */
+		if (exchange(cmd, sizeof(cmd), rsp, sizeof(rsp), &script[ht1.SendSeq], 1U) != 0) {
+			return -1;
+		}
+		total += ht1.Stats.LastLatency;
+	}
+	printf("smartcard_t1.latency: last %u us, mean %u us, max %u us over %u APDUs, 2 blocks each\n",
+	       (unsigned int)ht1.Stats.LastLatency, (unsigned int)(total / ht1.Stats.Apdus),
+	       (unsigned int)ht1.Stats.MaxLatency, (unsigned int)ht1.Stats.Apdus);
+	return ((ht1.Stats.Apdus == 100U) && (ht1.Stats.Errors == 0U) &&
+		(ht1.Stats.MaxLatency >= ht1.Stats.LastLatency)) ? 0 : -1;
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	if (regmodel_init() != 0) {
+		return 1;
+	}
+	regmodel_irq_connect(REGMODEL_SYSTICK_IRQN, systick_isr);
+	regmodel_irq_connect(USART1_IRQn, usart1_isr);
+
+	failed |= check("HAL_Init", HAL_Init() == HAL_OK);
+	failed |= check("t1_init", t1_init() == 0);
+	failed |= check("apdu_bad_edc", apdu_bad_edc() == 0);
+	failed |= check("apdu_resend", apdu_resend() == 0);
+	failed |= check("apdu_latency", apdu_latency() == 0);
+
+	return failed;
+}
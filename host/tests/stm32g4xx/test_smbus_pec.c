@@ -0,0 +1,269 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * SMBUS extended module: the table driven PEC against a bitwise CRC-8, and
+ * the transaction engine with software PEC against a smart battery, the
+ * 256-byte memory behind the I2C1 model: the command code addresses its
+ * registers.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32g4xx_hal.h"
+#include "regmodel.h"
+#include "regmodel_stm32g4xx.h"
+
+#define BATTERY_ADDRESS  (0x0BU << 1)
+#define BATTERY_VOLTAGE  0x09U  /* Read word */
+#define BATTERY_MODE     0x03U  /* Write word */
+#define BATTERY_NAME     0x21U  /* Block read */
+
+static SMBUS_HandleTypeDef hsmbus;
+static SMBUSEx_EngineTypeDef hengine;
+static volatile int done;
+
+static void systick_isr(void)
+{
+	HAL_IncTick();
+}
+
+static void i2c1_ev_isr(void)
+{
+	HAL_SMBUS_EV_IRQHandler(&hsmbus);
+}
+
+void HAL_SMBUS_MspInit(SMBUS_HandleTypeDef *hsmbus)
+{
+	__HAL_RCC_I2C1_CLK_ENABLE();
+	HAL_NVIC_EnableIRQ(I2C1_EV_IRQn);
+}
+
+void HAL_SMBUS_MasterTxCpltCallback(SMBUS_HandleTypeDef *hsmbus)
+{
+	HAL_SMBUSEx_EngineMasterTxCplt(&hengine);
+}
+
+void HAL_SMBUS_MasterRxCpltCallback(SMBUS_HandleTypeDef *hsmbus)
+{
+	HAL_SMBUSEx_EngineMasterRxCplt(&hengine);
+}
+
+void HAL_SMBUS_ErrorCallback(SMBUS_HandleTypeDef *hsmbus)
+{
+	HAL_SMBUSEx_EngineError(&hengine);
+}
+
+static void engine_complete(SMBUSEx_EngineTypeDef *phengine)
+{
+	done = 1;
+}
+
+static int check(const char *name, int ok)
+{
+	printf("smbus_pec.%-24s %s\n", name, ok ? "ok" : "FAILED");
+	return ok ? 0 : 1;
+}
+
+/* Reference CRC-8 of the SMBus specification, x^8 + x^2 + x + 1, MSB first */
+static uint8_t pec_bitwise(uint8_t pec, const uint8_t *data, size_t size)
+{
+	for (size_t i = 0U; i < size; i++) {
+		pec ^= data[i];
+		for (int bit = 0; bit < 8; bit++) {
+			pec = ((pec & 0x80U) != 0U) ? (uint8_t)((pec << 1) ^ 0x07U) : (uint8_t)(pec << 1);
+		}
+	}
+	return pec;
+}
+
+/* PEC ------------------------------------------------------------------------------*/
+
+static int pec_bytes(void)
+{
+	for (uint32_t pec = 0U; pec < 256U; pec++) {
+		for (uint32_t value = 0U; value < 256U; value++) {
+			uint8_t byte = (uint8_t)value;
+
+			if (HAL_SMBUSEx_CalculatePEC((uint8_t)pec, &byte, 1U) !=
+			    pec_bitwise((uint8_t)pec, &byte, 1U)) {
+				return -1;
+			}
+		}
+	}
+	return 0;
+}
+
+static int pec_messages(void)
+{
+	static const uint8_t check_string[] = "123456789";
+	uint8_t message[64];
+	uint32_t seed = 1U;
+
+	/* Check value of CRC-8/SMBUS */
+	if (HAL_SMBUSEx_CalculatePEC(0U, check_string, 9U) != 0xF4U) {
+		return -1;
+	}
+	for (int round = 0; round < 1000; round++) {
+		size_t size = 1U + (size_t)(round % (int)sizeof(message));
+		size_t split = (size_t)round % size;
+		uint8_t pec;
+
+		for (size_t i = 0U; i < size; i++) {
+			seed = (seed * 1103515245U) + 12345U;
+			message[i] = (uint8_t)(seed >> 16);
+		}
+		/* Whole message, then in two parts */
+		pec = pec_bitwise(0U, message, size);
+		if ((HAL_SMBUSEx_CalculatePEC(0U, message, (uint32_t)size) != pec) ||
+		    (HAL_SMBUSEx_CalculatePEC(HAL_SMBUSEx_CalculatePEC(0U, message, (uint32_t)split),
+					      &message[split], (uint32_t)(size - split)) != pec)) {
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/* Smart battery ---------------------------------------------------------------------*/
+
+static int smbus_init(void)
+{
+	hsmbus.Instance = I2C1;
+	hsmbus.Init.Timing = 0x10802D9BU;
+	hsmbus.Init.AnalogFilter = SMBUS_ANALOGFILTER_ENABLE;
+	hsmbus.Init.OwnAddress1 = 0U;
+	hsmbus.Init.AddressingMode = SMBUS_ADDRESSINGMODE_7BIT;
+	hsmbus.Init.DualAddressMode = SMBUS_DUALADDRESS_DISABLE;
+	hsmbus.Init.OwnAddress2 = 0U;
+	hsmbus.Init.OwnAddress2Masks = SMBUS_OA2_NOMASK;
+	hsmbus.Init.GeneralCallMode = SMBUS_GENERALCALL_DISABLE;
+	hsmbus.Init.NoStretchMode = SMBUS_NOSTRETCH_DISABLE;
+	hsmbus.Init.PacketErrorCheckMode = SMBUS_PEC_DISABLE;
+	hsmbus.Init.PeripheralMode = SMBUS_PERIPHERAL_MODE_SMBUS_HOST;
+	hsmbus.Init.SMBusTimeout = 0U;
+	if ((HAL_SMBUS_Init(&hsmbus) != HAL_OK) ||
+	    (HAL_SMBUSEx_EngineInit(&hengine, &hsmbus, SMBUSEX_PEC_AUTO) != HAL_OK) ||
+	    (hengine.PECMode != SMBUSEX_PEC_SOFTWARE)) {
+		return -1;
+	}
+	hengine.XferCpltCallback = engine_complete;
+	return 0;
+}
+
+static int transaction(SMBUSEx_TransactionTypeDef *xact)
+{
+	uint32_t tickstart = HAL_GetTick();
+
+	done = 0;
+	if (HAL_SMBUSEx_Transaction_IT(&hengine, xact) != HAL_OK) {
+		return -1;
+	}
+	while (done == 0) {
+		if ((HAL_GetTick() - tickstart) > 1000U) {
+			return -1;
+		}
+		__WFI();
+	}
+	/* The stop ends the transfer after the last callback */
+	while (hsmbus.State != HAL_SMBUS_STATE_READY) {
+		if ((HAL_GetTick() - tickstart) > 1000U) {
+			return -1;
+		}
+		__WFI();
+	}
+	return 0;
+}
+
+static int write_word(void)
+{
+	static const uint8_t mode[] = { 0x80U, 0x60U };
+	uint8_t message[] = { BATTERY_ADDRESS, BATTERY_MODE, mode[0], mode[1] };
+	uint8_t *battery = regmodel_i2c_memory(I2C1_BASE);
+	SMBUSEx_TransactionTypeDef xact = {
+		.DevAddress = BATTERY_ADDRESS,
+		.Protocol = SMBUSEX_WRITE_WORD,
+		.Command = BATTERY_MODE,
+		.pTxData = mode,
+	};
+
+	if ((transaction(&xact) != 0) || (hengine.ErrorCode != HAL_SMBUS_ERROR_NONE)) {
+		return -1;
+	}
+	/* Data, then the PEC the engine appended */
+	return ((battery[BATTERY_MODE] == mode[0]) && (battery[BATTERY_MODE + 1U] == mode[1]) &&
+		(battery[BATTERY_MODE + 2U] == pec_bitwise(0U, message, sizeof(message)))) ? 0 : -1;
+}
+
+static int read_word(int corrupt)
+{
+	uint8_t message[] = { BATTERY_ADDRESS, BATTERY_VOLTAGE, BATTERY_ADDRESS | 0x01U, 0x34U, 0x30U };
+	uint8_t *battery = regmodel_i2c_memory(I2C1_BASE);
+	uint8_t voltage[2] = { 0U };
+	uint32_t expected = corrupt ? HAL_SMBUS_ERROR_PECERR : HAL_SMBUS_ERROR_NONE;
+	SMBUSEx_TransactionTypeDef xact = {
+		.DevAddress = BATTERY_ADDRESS,
+		.Protocol = SMBUSEX_READ_WORD,
+		.Command = BATTERY_VOLTAGE,
+		.pRxData = voltage,
+	};
+
+	battery[BATTERY_VOLTAGE] = message[3];
+	battery[BATTERY_VOLTAGE + 1U] = message[4];
+	battery[BATTERY_VOLTAGE + 2U] = pec_bitwise(0U, message, sizeof(message)) ^ (corrupt ? 0x01U : 0U);
+
+	if ((transaction(&xact) != 0) || (hengine.ErrorCode != expected)) {
+		return -1;
+	}
+	return ((voltage[0] == message[3]) && (voltage[1] == message[4])) ? 0 : -1;
+}
+
+static int block_read(void)
+{
+	static const char name[] = "LION";
+	uint8_t message[3U + 1U + sizeof(name) - 1U] = { BATTERY_ADDRESS, BATTERY_NAME,
+							  BATTERY_ADDRESS | 0x01U, sizeof(name) - 1U };
+	uint8_t *battery = regmodel_i2c_memory(I2C1_BASE);
+	uint8_t data[SMBUSEX_BLOCK_MAX] = { 0U };
+	SMBUSEx_TransactionTypeDef xact = {
+		.DevAddress = BATTERY_ADDRESS,
+		.Protocol = SMBUSEX_BLOCK_READ,
+		.Command = BATTERY_NAME,
+		.pRxData = data,
+		.RxSize = sizeof(data),
+	};
+
+	memcpy(&message[4], name, sizeof(name) - 1U);
+	/* Count, data, PEC */
+	memcpy(&battery[BATTERY_NAME], &message[3], sizeof(message) - 3U);
+	battery[BATTERY_NAME + sizeof(message) - 3U] = pec_bitwise(0U, message, sizeof(message));
+
+	if ((transaction(&xact) != 0) || (hengine.ErrorCode != HAL_SMBUS_ERROR_NONE)) {
+		return -1;
+	}
+	return ((xact.RxSize == (sizeof(name) - 1U)) && (memcmp(data, name, sizeof(name) - 1U) == 0)) ?
+	       0 : -1;
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	if (regmodel_init() != 0) {
+		return 1;
+	}
+	regmodel_irq_connect(REGMODEL_SYSTICK_IRQN, systick_isr);
+	regmodel_irq_connect(I2C1_EV_IRQn, i2c1_ev_isr);
+
+	failed |= check("HAL_Init", HAL_Init() == HAL_OK);
+	failed |= check("pec_bytes", pec_bytes() == 0);
+	failed |= check("pec_messages", pec_messages() == 0);
+	failed |= check("engine_init", smbus_init() == 0);
+	failed |= check("write_word", write_word() == 0);
+	failed |= check("read_word", read_word(0) == 0);
+	failed |= check("read_word_pec_error", read_word(1) == 0);
+	failed |= check("block_read", block_read() == 0);
+
+	return failed;
+}
@@ -0,0 +1,85 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake STM32F1 device header of the unit tests, see README.rst.
+ *
+ * Declares only the registers the extended modules under test use. The
+ * peripheral instances are register blocks of the test, in host memory below
+ * 4 GB (the host build is not PIE).
+ */
+
+#ifndef STM32F1XX_H
+#define STM32F1XX_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STM32F1
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __IM    volatile const
+#define __OM    volatile
+#define __IOM   volatile
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE      static inline
+#endif
+
+#define SET_BIT(REG, BIT)     ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)   ((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)    ((REG) & (BIT))
+#define CLEAR_REG(REG)        ((REG) = (0x0))
+#define WRITE_REG(REG, VAL)   ((REG) = (VAL))
+#define READ_REG(REG)         ((REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  WRITE_REG((REG), (((READ_REG(REG)) & (~(CLEARMASK))) | (SETMASK)))
+
+/* GPIO, AFIO --------------------------------------------------------------------*/
+
+typedef struct {
+	__IO uint32_t CRL;
+	__IO uint32_t CRH;
+	__IO uint32_t IDR;
+	__IO uint32_t ODR;
+	__IO uint32_t BSRR;
+	__IO uint32_t BRR;
+	__IO uint32_t LCKR;
+} GPIO_TypeDef;
+
+typedef struct {
+	__IO uint32_t EVCR;
+	__IO uint32_t MAPR;
+	__IO uint32_t EXTICR[4];
+	uint32_t RESERVED0;
+	__IO uint32_t MAPR2;
+} AFIO_TypeDef;
+
+/* Register blocks of the GPIO ports and of the AFIO, defined by the test */
+extern GPIO_TypeDef unit_gpio[3];
+extern AFIO_TypeDef unit_afio;
+#define GPIOA                     (&unit_gpio[0])
+#define GPIOB                     (&unit_gpio[1])
+#define GPIOC                     (&unit_gpio[2])
+#define AFIO                      (&unit_afio)
+
+#define IS_GPIO_ALL_INSTANCE(INSTANCE)  (((INSTANCE) == GPIOA) || ((INSTANCE) == GPIOB) || \
+					 ((INSTANCE) == GPIOC))
+
+#define AFIO_EVCR_PIN_Pos         (0U)
+#define AFIO_EVCR_PIN             (0xFUL << AFIO_EVCR_PIN_Pos)
+#define AFIO_EVCR_PORT_Pos        (4U)
+#define AFIO_EVCR_PORT            (0x7UL << AFIO_EVCR_PORT_Pos)
+#define AFIO_EVCR_EVOE_Pos        (7U)
+#define AFIO_EVCR_EVOE            (0x1UL << AFIO_EVCR_EVOE_Pos)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32F1XX_H */
@@ -0,0 +1,38 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake STM32F1 HAL header of the unit tests, see README.rst.
+ *
+ * Includes the HAL definitions and the headers of the modules under test, not
+ * the HAL configuration. The HAL functions the modules call are implemented
+ * by the tests.
+ */
+
+#ifndef STM32F1XX_HAL_H
+#define STM32F1XX_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_GPIO_MODULE_ENABLED
+#define HAL_DMA_MODULE_ENABLED
+
+#define assert_param(expr) ((void)0U)
+
+#include "stm32f1xx_hal_def.h"
+#include "stm32f1xx_hal_gpio.h"
+
+/* The DMA handle is only passed through by the modules under test */
+typedef struct __DMA_HandleTypeDef DMA_HandleTypeDef;
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress,
+				   uint32_t DataLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32F1XX_HAL_H */
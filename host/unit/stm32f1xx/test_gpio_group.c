@@ -0,0 +1,332 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32F1 GPIO groups (GPIOEx).
+ *
+ * The ports are plain register blocks: the test applies each BSRR word the
+ * module stores to the output data register of the port, as the hardware
+ * does, and checks every pin against the bit of the logical value it is
+ * mapped to. The pins outside the group must keep their level.
+ *
+ * The last test counts the port register accesses of a group write and read
+ * against the per-pin HAL_GPIO_WritePin()/HAL_GPIO_ReadPin() sequence, the
+ * way the register model of the host build does: the page of the ports is
+ * protected, each access faults, is counted and executed alone under the x86
+ * trap flag.
+ */
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "stm32f1xx_hal_gpio_ex.c"
+
+/* Alone at the start of a page, so that its accesses can be trapped */
+GPIO_TypeDef unit_gpio[3] __attribute__((aligned(4096)));
+AFIO_TypeDef unit_afio;
+
+struct __DMA_HandleTypeDef {
+	uint32_t src;
+	uint32_t dst;
+	uint32_t size;
+};
+
+HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, uint32_t DstAddress,
+				   uint32_t DataLength)
+{
+	hdma->src = SrcAddress;
+	hdma->dst = DstAddress;
+	hdma->size = DataLength;
+	return HAL_OK;
+}
+
+/* 12-bit value on two ports, bits in no particular pin order */
+static const GPIOEx_PinTypeDef pins[] = {
+	{ GPIOA, GPIO_PIN_3 }, { GPIOB, GPIO_PIN_0 }, { GPIOA, GPIO_PIN_15 }, { GPIOA, GPIO_PIN_0 },
+	{ GPIOB, GPIO_PIN_7 }, { GPIOB, GPIO_PIN_8 }, { GPIOA, GPIO_PIN_9 }, { GPIOB, GPIO_PIN_14 },
+	{ GPIOA, GPIO_PIN_1 }, { GPIOB, GPIO_PIN_2 }, { GPIOA, GPIO_PIN_12 }, { GPIOB, GPIO_PIN_11 },
+};
+
+#define PINS_NBR  (sizeof(pins) / sizeof(pins[0]))
+
+static GPIOEx_GroupTypeDef group;
+
+#define EXPECT(cond)                                                          \
+	do {                                                                  \
+		if (!(cond)) {                                                \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			return -1;                                            \
+		}                                                             \
+	} while (0)
+
+/* Output data register after a BSRR store: set wins over reset */
+static uint32_t bsrr_apply(uint32_t odr, uint32_t bsrr)
+{
+	return ((odr & ~(bsrr >> 16)) | bsrr) & 0xFFFFU;
+}
+
+/* Reference: output data registers of a value, pin by pin */
+static void reference(uint32_t value, uint32_t odr_a, uint32_t odr_b, uint32_t *ref_a, uint32_t *ref_b)
+{
+	for (uint32_t bit = 0U; bit < PINS_NBR; bit++) {
+		uint32_t *odr = (pins[bit].GPIOx == GPIOA) ? &odr_a : &odr_b;
+
+		if ((value & (1UL << bit)) != 0U) {
+			*odr |= pins[bit].Pin;
+		} else {
+			*odr &= ~(uint32_t)pins[bit].Pin;
+		}
+	}
+	*ref_a = odr_a;
+	*ref_b = odr_b;
+}
+
+static int test_init(void)
+{
+	EXPECT(HAL_GPIOEx_GroupInit(&group, pins, PINS_NBR) == HAL_OK);
+	EXPECT(group.PortNbr == 2U);
+	return 0;
+}
+
+static int test_init_errors(void)
+{
+	static const GPIOEx_PinTypeDef twice[] = { { GPIOA, GPIO_PIN_1 }, { GPIOA, GPIO_PIN_1 } };
+	static const GPIOEx_PinTypeDef multi[] = { { GPIOA, GPIO_PIN_1 | GPIO_PIN_2 } };
+	static const GPIOEx_PinTypeDef ports[] = { { GPIOA, GPIO_PIN_1 }, { GPIOB, GPIO_PIN_1 },
+						   { GPIOC, GPIO_PIN_1 } };
+	GPIOEx_GroupTypeDef scratch;
+
+	EXPECT(HAL_GPIOEx_GroupInit(&scratch, twice, 2U) == HAL_ERROR);
+	EXPECT(HAL_GPIOEx_GroupInit(&scratch, multi, 1U) == HAL_ERROR);
+	EXPECT(HAL_GPIOEx_GroupInit(&scratch, ports, 3U) == HAL_ERROR);
+	EXPECT(HAL_GPIOEx_GroupInit(&scratch, pins, 0U) == HAL_ERROR);
+	EXPECT(HAL_GPIOEx_GroupInit(&scratch, pins, GPIOEX_GROUP_MAX_BITS + 1U) == HAL_ERROR);
+	return 0;
+}
+
+/* Every value, from outputs with all the pins of the ports high then low */
+static int test_write(void)
+{
+	for (uint32_t level = 0U; level < 2U; level++) {
+		uint32_t idle = (level != 0U) ? 0xFFFFU : 0U;
+
+		for (uint32_t value = 0U; value < (1UL << PINS_NBR); value++) {
+			uint32_t ref_a;
+			uint32_t ref_b;
+
+			GPIOA->ODR = idle;
+			GPIOB->ODR = idle;
+			/* Bits above the width are ignored */
+			HAL_GPIOEx_GroupWrite(&group, value | 0xA000U);
+			GPIOA->ODR = bsrr_apply(GPIOA->ODR, GPIOA->BSRR);
+			GPIOB->ODR = bsrr_apply(GPIOB->ODR, GPIOB->BSRR);
+
+			reference(value, idle, idle, &ref_a, &ref_b);
+			EXPECT(GPIOA->ODR == ref_a);
+			EXPECT(GPIOB->ODR == ref_b);
+		}
+	}
+	return 0;
+}
+
+static int test_read(void)
+{
+	for (uint32_t value = 0U; value < (1UL << PINS_NBR); value++) {
+		uint32_t idr_a;
+		uint32_t idr_b;
+
+		/* Noise on the pins outside the group */
+		reference(value, value * 0x9E37U, value * 0x7F4AU, &idr_a, &idr_b);
+		GPIOA->IDR = idr_a;
+		GPIOB->IDR = idr_b;
+		EXPECT(HAL_GPIOEx_GroupRead(&group) == value);
+	}
+	return 0;
+}
+
+/* DMA addresses are 32-bit, the buffers are static */
+static uint32_t values[64];
+static uint32_t words_b[64];
+
+static int test_encode_dma(void)
+{
+	DMA_HandleTypeDef hdma = { 0 };
+
+	for (uint32_t i = 0U; i < 64U; i++) {
+		values[i] = (i * 0x3A5U) & 0xFFFU;
+	}
+	EXPECT(HAL_GPIOEx_GroupEncode(&group, GPIOC, values, words_b, 64U) == HAL_ERROR);
+	EXPECT(HAL_GPIOEx_GroupEncode(&group, GPIOB, values, words_b, 64U) == HAL_OK);
+	/* Same words as a write */
+	for (uint32_t i = 0U; i < 64U; i++) {
+		HAL_GPIOEx_GroupWrite(&group, values[i]);
+		EXPECT(words_b[i] == GPIOB->BSRR);
+	}
+	/* In place */
+	EXPECT(HAL_GPIOEx_GroupEncode(&group, GPIOB, values, values, 64U) == HAL_OK);
+	EXPECT(memcmp(values, words_b, sizeof(values)) == 0);
+
+	EXPECT(HAL_GPIOEx_GroupStart_DMA(&group, GPIOC, &hdma, words_b, 64U) == HAL_ERROR);
+	EXPECT(HAL_GPIOEx_GroupStart_DMA(&group, GPIOB, &hdma, words_b, 0U) == HAL_ERROR);
+	EXPECT(HAL_GPIOEx_GroupStart_DMA(&group, GPIOB, &hdma, words_b, 64U) == HAL_OK);
+	EXPECT(hdma.src == (uint32_t)words_b);
+	EXPECT(hdma.dst == (uint32_t)&GPIOB->BSRR);
+	EXPECT(hdma.size == 64U);
+	return 0;
+}
+
+/* Port register access counter ------------------------------------------------*/
+
+#define EFLAGS_TF     0x100UL
+#define PF_ERR_WRITE  0x2UL
+
+/* Thread local, hence out of the page of the ports the handlers protect */
+static _Thread_local void *port_page;
+static _Thread_local size_t port_page_size;
+static _Thread_local uint32_t port_reads;
+static _Thread_local uint32_t port_writes;
+
+static void port_segv(int sig, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = context;
+	uintptr_t addr = (uintptr_t)info->si_addr;
+
+	if ((addr >= (uintptr_t)unit_gpio) && (addr < (uintptr_t)&unit_gpio[3])) {
+		if (((uint64_t)uc->uc_mcontext.gregs[REG_ERR] & PF_ERR_WRITE) != 0U) {
+			port_writes++;
+		} else {
+			port_reads++;
+		}
+	}
+	/* Other data of the page is accessed, not counted */
+	mprotect(port_page, port_page_size, PROT_READ | PROT_WRITE);
+	uc->uc_mcontext.gregs[REG_EFL] |= EFLAGS_TF;
+}
+
+static void port_trap(int sig, siginfo_t *info, void *context)
+{
+	ucontext_t *uc = context;
+
+	mprotect(port_page, port_page_size, PROT_NONE);
+	uc->uc_mcontext.gregs[REG_EFL] &= ~EFLAGS_TF;
+}
+
+static void count_start(void)
+{
+	struct sigaction sa = { 0 };
+
+	port_page = unit_gpio;
+	port_page_size = (size_t)sysconf(_SC_PAGESIZE);
+	port_reads = 0U;
+	port_writes = 0U;
+	sa.sa_flags = SA_SIGINFO;
+	sa.sa_sigaction = port_segv;
+	sigaction(SIGSEGV, &sa, NULL);
+	sa.sa_sigaction = port_trap;
+	sigaction(SIGTRAP, &sa, NULL);
+	mprotect(port_page, port_page_size, PROT_NONE);
+}
+
+static void count_stop(void)
+{
+	mprotect(port_page, port_page_size, PROT_READ | PROT_WRITE);
+	signal(SIGSEGV, SIG_DFL);
+	signal(SIGTRAP, SIG_DFL);
+}
+
+/* The pin by pin sequences the group replaces, as in the F1 GPIO module */
+static void write_pins(uint32_t value)
+{
+	for (uint32_t bit = 0U; bit < PINS_NBR; bit++) {
+		if ((value & (1UL << bit)) != 0U) {
+			pins[bit].GPIOx->BSRR = pins[bit].Pin;
+		} else {
+			pins[bit].GPIOx->BSRR = (uint32_t)pins[bit].Pin << 16U;
+		}
+	}
+}
+
+static uint32_t read_pins(void)
+{
+	uint32_t value = 0U;
+
+	for (uint32_t bit = 0U; bit < PINS_NBR; bit++) {
+		if ((pins[bit].GPIOx->IDR & pins[bit].Pin) != 0U) {
+			value |= (1UL << bit);
+		}
+	}
+	return value;
+}
+
+#if defined(__x86_64__)
+static int test_accesses(void)
+{
+	uint32_t group_writes;
+	uint32_t group_reads;
+	uint32_t value;
+
+	count_start();
+	HAL_GPIOEx_GroupWrite(&group, 0x5A5U);
+	group_writes = port_writes;
+	group_reads = port_reads;
+	count_stop();
+	/* One store per port, the pins of a port switch together */
+	EXPECT((group_writes == group.PortNbr) && (group_reads == 0U));
+
+	count_start();
+	write_pins(0x5A5U);
+	count_stop();
+	EXPECT((port_writes == PINS_NBR) && (port_reads == 0U));
+	printf("gpio_group.accesses: write %u stores (per pin %u)", group_writes, port_writes);
+
+	count_start();
+	value = HAL_GPIOEx_GroupRead(&group);
+	group_writes = port_writes;
+	group_reads = port_reads;
+	count_stop();
+	EXPECT((group_reads == group.PortNbr) && (group_writes == 0U));
+
+	count_start();
+	EXPECT(read_pins() == value);
+	count_stop();
+	EXPECT((port_reads == PINS_NBR) && (port_writes == 0U));
+	printf(", read %u loads (per pin %u), %u-bit value on %u ports\n", group_reads, port_reads,
+	       (uint32_t)PINS_NBR, group.PortNbr);
+	return 0;
+}
+#endif /* __x86_64__ */
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} tests[] = {
+	{ "init", test_init },
+	{ "init_errors", test_init_errors },
+	{ "write", test_write },
+	{ "read", test_read },
+	{ "encode_dma", test_encode_dma },
+#if defined(__x86_64__)
+	{ "accesses", test_accesses },
+#endif /* __x86_64__ */
+};
+
+int main(void)
+{
+	int failed = 0;
+
+	for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		int ok = (tests[i].run() == 0);
+
+		printf("gpio_group.%-24s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+		failed |= !ok;
+	}
+	return failed;
+}
@@ -0,0 +1,90 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake CMSIS core_cm33.h of the STM32H5 unit tests, see README.rst.
+ *
+ * Included by the device header of the tree. Defines the qualifiers and the
+ * CPU state intrinsics only: no core peripheral is declared. The intrinsics
+ * act on a PRIMASK variable, the barriers are host fences.
+ */
+
+#ifndef __CORE_CM33_H_GENERIC
+#define __CORE_CM33_H_GENERIC
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __IM    volatile const
+#define __OM    volatile
+#define __IOM   volatile
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE      static inline
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)         __attribute__((aligned(x)))
+#endif
+
+/* PRIMASK of the thread running the module under test */
+extern _Thread_local uint32_t unit_primask;
+
+static inline uint32_t __get_PRIMASK(void)
+{
+	return unit_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+	unit_primask = priMask & 1U;
+}
+
+static inline void __disable_irq(void)
+{
+	unit_primask = 1U;
+}
+
+static inline void __enable_irq(void)
+{
+	unit_primask = 0U;
+}
+
+static inline void __DMB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __DSB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __ISB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline uint32_t __RBIT(uint32_t value)
+{
+	uint32_t result = 0U;
+
+	for (uint32_t bit = 0U; bit < 32U; bit++) {
+		result |= ((value >> bit) & 1U) << (31U - bit);
+	}
+	return result;
+}
+
+#define __CLZ(value)  ((uint8_t)(((value) == 0U) ? 32U : (uint32_t)__builtin_clz(value)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CORE_CM33_H_GENERIC */
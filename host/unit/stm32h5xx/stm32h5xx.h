@@ -0,0 +1,53 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake STM32H5 device header of the unit tests, see README.rst.
+ *
+ * The register definitions are those of the STM32H563 device header of the
+ * tree, over the fake core_cm33.h of this directory. The peripheral instances
+ * are register blocks of the test.
+ */
+
+#ifndef STM32H5XX_H
+#define STM32H5XX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STM32H5
+#define STM32H563xx
+
+#include "stm32h563xx.h"
+
+typedef enum {
+	RESET = 0,
+	SET = !RESET
+} FlagStatus, ITStatus;
+
+typedef enum {
+	DISABLE = 0,
+	ENABLE = !DISABLE
+} FunctionalState;
+
+typedef enum {
+	SUCCESS = 0,
+	ERROR = !SUCCESS
+} ErrorStatus;
+
+#define SET_BIT(REG, BIT)     ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)   ((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)    ((REG) & (BIT))
+#define CLEAR_REG(REG)        ((REG) = (0x0))
+#define WRITE_REG(REG, VAL)   ((REG) = (VAL))
+#define READ_REG(REG)         ((REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  WRITE_REG((REG), (((READ_REG(REG)) & (~(CLEARMASK))) | (SETMASK)))
+#define POSITION_VAL(VAL)     (__CLZ(__RBIT(VAL)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H5XX_H */
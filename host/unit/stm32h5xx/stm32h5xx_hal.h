@@ -0,0 +1,37 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake STM32H5 HAL header of the unit tests, see README.rst.
+ *
+ * Includes the HAL definitions and the headers of the modules under test, not
+ * the HAL configuration. The HAL functions the modules call are implemented
+ * by the tests.
+ */
+
+#ifndef STM32H5XX_HAL_H
+#define STM32H5XX_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_DMA_MODULE_ENABLED
+#define HAL_I3C_MODULE_ENABLED
+
+#define USE_HAL_I3C_REGISTER_CALLBACKS  0U
+
+#define assert_param(expr) ((void)0U)
+
+#include "stm32h5xx_hal_def.h"
+#include "stm32h5xx_hal_dma.h"
+#include "stm32h5xx_hal_i3c.h"
+
+uint32_t HAL_GetTick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H5XX_HAL_H */
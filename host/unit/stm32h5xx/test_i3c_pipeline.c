@@ -0,0 +1,549 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32H5 I3C precompiled frames and transfer pipeline
+ * (I3CEx).
+ *
+ * HAL_I3C_AddDescToFrame() is simulated: it writes one control word per
+ * descriptor and packs the Tx data, like the I3C module for private
+ * transfers. HAL_I3C_Ctrl_MultipleTransfer_DMA() records the transfer and
+ * makes the handle busy; the test completes the frame by making the handle
+ * ready again and calling the pipeline handlers as the HAL I3C callbacks do.
+ * The IBI flag is set in the EVR register of the instance.
+ *
+ * The last test measures the frame rate the pipeline handlers sustain on the
+ * host, the bus time excluded.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "stm32h5xx_hal_i3c_ex.c"
+
+I3C_TypeDef unit_i3c1;
+_Thread_local uint32_t unit_primask;
+
+static uint32_t unit_tick;
+static uint32_t starts;
+static const I3C_XferTypeDef *started_xfer;
+static HAL_StatusTypeDef start_status;
+static I3C_CCCInfoTypeDef ibi_info;
+
+/* Private transfers only: one control word per descriptor, Tx data packed */
+HAL_StatusTypeDef HAL_I3C_AddDescToFrame(I3C_HandleTypeDef *hi3c, const I3C_CCCTypeDef *pCCCDesc,
+					 const I3C_PrivateTypeDef *pPrivateDesc, I3C_XferTypeDef *pXferData,
+					 uint8_t nbFrame, uint32_t option)
+{
+	uint32_t tx = 0U;
+	uint32_t rx = 0U;
+
+	if (nbFrame > pXferData->CtrlBuf.Size) {
+		hi3c->ErrorCode = HAL_I3C_ERROR_INVALID_PARAM;
+		return HAL_ERROR;
+	}
+
+	for (uint32_t index = 0U; index < nbFrame; index++) {
+		const I3C_PrivateTypeDef *desc = &pPrivateDesc[index];
+		uint32_t size;
+
+		if (desc->Direction == HAL_I3C_DIRECTION_READ) {
+			size = desc->RxBuf.Size;
+			if ((rx + size) > pXferData->RxBuf.Size) {
+				hi3c->ErrorCode = HAL_I3C_ERROR_INVALID_PARAM;
+				return HAL_ERROR;
+			}
+			rx += size;
+		} else {
+			size = desc->TxBuf.Size;
+			if ((tx + size) > pXferData->TxBuf.Size) {
+				hi3c->ErrorCode = HAL_I3C_ERROR_INVALID_PARAM;
+				return HAL_ERROR;
+			}
+			memcpy(&pXferData->TxBuf.pBuffer[tx], desc->TxBuf.pBuffer, size);
+			tx += size;
+		}
+
+		pXferData->CtrlBuf.pBuffer[index] = size | ((uint32_t)desc->TargetAddr << I3C_CR_ADD_Pos) |
+						    desc->Direction | (option & I3CEX_OPERATION_TYPE_MASK) |
+						    ((index == (nbFrame - 1U)) ? I3C_CR_MEND : 0U);
+	}
+
+	hi3c->ControlXferCount = nbFrame;
+	hi3c->TxXferCount = tx;
+	hi3c->RxXferCount = rx;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I3C_Ctrl_MultipleTransfer_DMA(I3C_HandleTypeDef *hi3c, I3C_XferTypeDef *pXferData)
+{
+	starts++;
+	started_xfer = pXferData;
+	if (start_status == HAL_OK) {
+		hi3c->State = HAL_I3C_STATE_BUSY_TX_RX;
+	}
+	return start_status;
+}
+
+HAL_StatusTypeDef HAL_I3C_GetCCCInfo(I3C_HandleTypeDef *hi3c, uint32_t notifyId, I3C_CCCInfoTypeDef *pCCCInfo)
+{
+	*pCCCInfo = ibi_info;
+	return HAL_OK;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return unit_tick;
+}
+
+#define EXPECT(cond)                                                          \
+	do {                                                                  \
+		if (!(cond)) {                                                \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			return -1;                                            \
+		}                                                             \
+	} while (0)
+
+/* Write 2 bytes, read 4 bytes, write 3 bytes */
+static uint8_t data0[] = { 0x10, 0x11 };
+static uint8_t data2[] = { 0x20, 0x21, 0x22 };
+static I3C_PrivateTypeDef descs[] = {
+	{ 0x32, { data0, sizeof(data0) }, { NULL, 0U }, HAL_I3C_DIRECTION_WRITE },
+	{ 0x32, { NULL, 0U }, { NULL, 4U }, HAL_I3C_DIRECTION_READ },
+	{ 0x33, { data2, sizeof(data2) }, { NULL, 0U }, HAL_I3C_DIRECTION_WRITE },
+};
+#define DESC_NBR  ((uint8_t)(sizeof(descs) / sizeof(descs[0])))
+
+static I3C_HandleTypeDef hi3c;
+static I3CEx_FrameTypeDef frame;
+static uint32_t ctrl[8];
+static uint8_t txbuf[64];
+static uint8_t rxbuf[64];
+static I3C_XferTypeDef xfer;
+
+static void reset(void)
+{
+	memset(&hi3c, 0, sizeof(hi3c));
+	memset(&frame, 0, sizeof(frame));
+	memset(&unit_i3c1, 0, sizeof(unit_i3c1));
+	memset(&ibi_info, 0, sizeof(ibi_info));
+	memset(txbuf, 0, sizeof(txbuf));
+	memset(rxbuf, 0, sizeof(rxbuf));
+	hi3c.Instance = &unit_i3c1;
+	hi3c.State = HAL_I3C_STATE_READY;
+	xfer.CtrlBuf.pBuffer = ctrl;
+	xfer.CtrlBuf.Size = sizeof(ctrl) / sizeof(ctrl[0]);
+	xfer.TxBuf.pBuffer = txbuf;
+	xfer.TxBuf.Size = sizeof(txbuf);
+	xfer.RxBuf.pBuffer = rxbuf;
+	xfer.RxBuf.Size = sizeof(rxbuf);
+	unit_tick = 0U;
+	starts = 0U;
+	started_xfer = NULL;
+	start_status = HAL_OK;
+}
+
+static int compile(uint32_t option)
+{
+	return (HAL_I3CEx_FrameCompile(&hi3c, &frame, descs, DESC_NBR, option, &xfer) == HAL_OK) ? 0 : -1;
+}
+
+/* End of the ongoing frame, as seen by HAL_I3C_CtrlMultipleXferCpltCallback() */
+static void complete(I3CEx_PipelineTypeDef *hpipe)
+{
+	hi3c.State = HAL_I3C_STATE_READY;
+	HAL_I3CEx_PipelineXferCplt(hpipe);
+}
+
+static int test_frame_compile(void)
+{
+	uint8_t *data;
+	uint32_t size;
+
+	reset();
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == 0);
+
+	EXPECT(frame.DescNbr == DESC_NBR);
+	EXPECT(frame.pDesc == descs);
+	EXPECT(frame.Option == I3C_PRIVATE_WITH_ARB_RESTART);
+
+	/* The DMA lengths are those of the frame, not of the buffers */
+	EXPECT(frame.ControlNbr == 3U);
+	EXPECT(frame.Xfer.CtrlBuf.Size == 3U);
+	EXPECT(frame.Xfer.TxBuf.Size == 5U);
+	EXPECT(frame.Xfer.RxBuf.Size == 4U);
+	EXPECT((ctrl[2] & I3C_CR_MEND) != 0U);
+
+	EXPECT(frame.Offset[0] == 0U);
+	EXPECT(frame.Offset[1] == 0U);
+	EXPECT(frame.Offset[2] == 2U);
+
+	data = HAL_I3CEx_FrameGetData(&frame, 2U, &size);
+	EXPECT(data == &txbuf[2]);
+	EXPECT(size == 3U);
+	EXPECT(memcmp(data, data2, sizeof(data2)) == 0);
+
+	data = HAL_I3CEx_FrameGetData(&frame, 1U, &size);
+	EXPECT(data == &rxbuf[0]);
+	EXPECT(size == 4U);
+
+	EXPECT(HAL_I3CEx_FrameGetData(&frame, DESC_NBR, NULL) == NULL);
+	return 0;
+}
+
+static int test_compile_errors(void)
+{
+	reset();
+	EXPECT(HAL_I3CEx_FrameCompile(NULL, &frame, descs, DESC_NBR, I3C_PRIVATE_WITH_ARB_RESTART, &xfer) ==
+	       HAL_ERROR);
+	EXPECT(HAL_I3CEx_FrameCompile(&hi3c, &frame, NULL, DESC_NBR, I3C_PRIVATE_WITH_ARB_RESTART, &xfer) ==
+	       HAL_ERROR);
+	EXPECT(HAL_I3CEx_FrameCompile(&hi3c, &frame, descs, DESC_NBR, I3C_PRIVATE_WITH_ARB_RESTART, NULL) ==
+	       HAL_ERROR);
+
+	EXPECT(HAL_I3CEx_FrameCompile(&hi3c, &frame, descs, 0U, I3C_PRIVATE_WITH_ARB_RESTART, &xfer) ==
+	       HAL_ERROR);
+	EXPECT(hi3c.ErrorCode == HAL_I3C_ERROR_INVALID_PARAM);
+
+	hi3c.ErrorCode = 0U;
+	EXPECT(HAL_I3CEx_FrameCompile(&hi3c, &frame, descs, I3CEX_FRAME_MAX_DESC + 1U,
+				      I3C_PRIVATE_WITH_ARB_RESTART, &xfer) == HAL_ERROR);
+	EXPECT(hi3c.ErrorCode == HAL_I3C_ERROR_INVALID_PARAM);
+
+	/* CCC frames are not compiled */
+	hi3c.ErrorCode = 0U;
+	EXPECT(compile(I3C_BROADCAST_WITH_DEFBYTE_RESTART) == -1);
+	EXPECT(hi3c.ErrorCode == HAL_I3C_ERROR_INVALID_PARAM);
+
+	/* Legacy I2C frames are */
+	EXPECT(compile(I2C_PRIVATE_WITHOUT_ARB_RESTART) == 0);
+
+	/* A frame larger than its buffers is left empty */
+	memset(&frame, 0, sizeof(frame));
+	xfer.TxBuf.Size = 4U;
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == -1);
+	EXPECT(frame.DescNbr == 0U);
+	EXPECT(HAL_I3CEx_FrameStart_DMA(&hi3c, &frame) == HAL_ERROR);
+	EXPECT(starts == 0U);
+	return 0;
+}
+
+static int test_set_tx_data(void)
+{
+	static const uint8_t update[] = { 0xA0, 0xA1, 0xA2 };
+	static const uint8_t expected[] = { 0x10, 0x11, 0xA0, 0xA1, 0xA2, 0x00 };
+
+	reset();
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == 0);
+
+	EXPECT(HAL_I3CEx_FrameSetTxData(&frame, 2U, update) == HAL_OK);
+	EXPECT(memcmp(txbuf, expected, sizeof(expected)) == 0);
+
+	/* Read descriptors and wrong indexes are refused */
+	EXPECT(HAL_I3CEx_FrameSetTxData(&frame, 1U, update) == HAL_ERROR);
+	EXPECT(HAL_I3CEx_FrameSetTxData(&frame, DESC_NBR, update) == HAL_ERROR);
+	EXPECT(HAL_I3CEx_FrameSetTxData(&frame, 0U, NULL) == HAL_ERROR);
+	EXPECT(memcmp(txbuf, expected, sizeof(expected)) == 0);
+	return 0;
+}
+
+static int test_start_dma(void)
+{
+	reset();
+	EXPECT(compile(I3C_PRIVATE_WITHOUT_ARB_STOP) == 0);
+
+	/* The arbitration header setting does not change under a transfer */
+	hi3c.State = HAL_I3C_STATE_BUSY_TX_RX;
+	EXPECT(HAL_I3CEx_FrameStart_DMA(&hi3c, &frame) == HAL_BUSY);
+	EXPECT(starts == 0U);
+	EXPECT(unit_i3c1.CFGR == 0U);
+
+	/* The handle is restored from the frame */
+	hi3c.State = HAL_I3C_STATE_READY;
+	hi3c.ControlXferCount = 0U;
+	hi3c.TxXferCount = 0U;
+	hi3c.RxXferCount = 0U;
+	EXPECT(HAL_I3CEx_FrameStart_DMA(&hi3c, &frame) == HAL_OK);
+	EXPECT(starts == 1U);
+	EXPECT(started_xfer == &frame.Xfer);
+	EXPECT(hi3c.pPrivateDesc == descs);
+	EXPECT(hi3c.ControlXferCount == 3U);
+	EXPECT(hi3c.TxXferCount == 5U);
+	EXPECT(hi3c.RxXferCount == 4U);
+	EXPECT((unit_i3c1.CFGR & I3C_CFGR_NOARBH) != 0U);
+
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == 0);
+	hi3c.State = HAL_I3C_STATE_LISTEN;
+	EXPECT(HAL_I3CEx_FrameStart_DMA(&hi3c, &frame) == HAL_OK);
+	EXPECT((unit_i3c1.CFGR & I3C_CFGR_NOARBH) == 0U);
+	return 0;
+}
+
+static int test_continuous(void)
+{
+	I3CEx_PipelineTypeDef pipe;
+	I3CEx_EventTypeDef events[8];
+	I3CEx_EventTypeDef event;
+	I3CEx_PipelineStatsTypeDef stats;
+
+	reset();
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == 0);
+	EXPECT(HAL_I3CEx_PipelineInit(&pipe, &hi3c, events, 8U) == HAL_OK);
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_ERROR);
+
+	unit_tick = 100U;
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_OK);
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_BUSY);
+
+	for (uint32_t index = 0U; index < 3U; index++) {
+		unit_tick += 10U;
+		complete(&pipe);
+	}
+	EXPECT(starts == 4U);
+	EXPECT(hi3c.State == HAL_I3C_STATE_BUSY_TX_RX);
+
+	/* The ongoing frame completes, it is not restarted */
+	HAL_I3CEx_PipelineStop(&pipe);
+	unit_tick += 10U;
+	complete(&pipe);
+	EXPECT(starts == 4U);
+
+	for (uint32_t index = 0U; index < 4U; index++) {
+		EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK);
+		EXPECT(event.Type == I3CEX_EVENT_FRAME);
+		EXPECT(event.pFrame == &frame);
+		EXPECT(event.Timestamp == (110U + (10U * index)));
+	}
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_ERROR);
+
+	HAL_I3CEx_PipelineGetStats(&pipe, &stats);
+	EXPECT(stats.Frames == 4U);
+	EXPECT(stats.Transfers == (4U * DESC_NBR));
+	EXPECT(stats.Elapsed == 40U);
+	EXPECT(stats.Overflows == 0U);
+
+	HAL_I3CEx_PipelineResetStats(&pipe);
+	HAL_I3CEx_PipelineGetStats(&pipe, &stats);
+	EXPECT(stats.Frames == 0U);
+	EXPECT(stats.Transfers == 0U);
+	EXPECT(pipe.StartTime == unit_tick);
+
+	/* Single shot */
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 0U) == HAL_OK);
+	complete(&pipe);
+	EXPECT(starts == 5U);
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK);
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_ERROR);
+	return 0;
+}
+
+static int test_ibi_deferral(void)
+{
+	I3CEx_PipelineTypeDef pipe;
+	I3CEx_EventTypeDef events[8];
+	I3CEx_EventTypeDef event;
+	I3CEx_PipelineStatsTypeDef stats;
+
+	reset();
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == 0);
+	EXPECT(HAL_I3CEx_PipelineInit(&pipe, &hi3c, events, 8U) == HAL_OK);
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_OK);
+
+	/* A target raised an IBI during the frame: it is served first */
+	unit_i3c1.EVR = I3C_EVR_IBIF;
+	complete(&pipe);
+	EXPECT(starts == 1U);
+	EXPECT(pipe.RestartPending == 1U);
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_BUSY);
+
+	/* Other notifications do not restart the frame */
+	HAL_I3CEx_PipelineNotify(&pipe, EVENT_ID_HJ);
+	EXPECT(starts == 1U);
+
+	unit_i3c1.EVR = 0U;
+	ibi_info.IBICRTgtAddr = 0x33U;
+	ibi_info.IBITgtNbPayload = 2U;
+	ibi_info.IBITgtPayload = 0xBEEFU;
+	unit_tick = 7U;
+	HAL_I3CEx_PipelineNotify(&pipe, EVENT_ID_IBI);
+	EXPECT(starts == 2U);
+	EXPECT(pipe.RestartPending == 0U);
+
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK);
+	EXPECT(event.Type == I3CEX_EVENT_FRAME);
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK);
+	EXPECT(event.Type == I3CEX_EVENT_IBI);
+	EXPECT(event.pFrame == NULL);
+	EXPECT(event.TargetAddr == 0x33U);
+	EXPECT(event.IBIPayloadSize == 2U);
+	EXPECT(event.IBIPayload == 0xBEEFU);
+	EXPECT(event.Timestamp == 7U);
+
+	HAL_I3CEx_PipelineGetStats(&pipe, &stats);
+	EXPECT(stats.IBIs == 1U);
+	EXPECT(stats.Deferred == 1U);
+
+	/* Stopped while the restart waits: the IBI does not restart the frame */
+	unit_i3c1.EVR = I3C_EVR_IBIF;
+	complete(&pipe);
+	HAL_I3CEx_PipelineStop(&pipe);
+	unit_i3c1.EVR = 0U;
+	HAL_I3CEx_PipelineNotify(&pipe, EVENT_ID_IBI);
+	EXPECT(starts == 2U);
+	return 0;
+}
+
+static int test_overflow(void)
+{
+	I3CEx_PipelineTypeDef pipe;
+	I3CEx_EventTypeDef events[4];
+	I3CEx_EventTypeDef event;
+	I3CEx_PipelineStatsTypeDef stats;
+	uint32_t read = 0U;
+
+	reset();
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == 0);
+	EXPECT(HAL_I3CEx_PipelineInit(&pipe, &hi3c, events, 1U) == HAL_ERROR);
+	EXPECT(HAL_I3CEx_PipelineInit(&pipe, &hi3c, events, 4U) == HAL_OK);
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_OK);
+
+	/* One entry is kept free: 3 events fit, the next 2 are dropped */
+	for (uint32_t index = 0U; index < 5U; index++) {
+		unit_tick = index;
+		complete(&pipe);
+	}
+	HAL_I3CEx_PipelineGetStats(&pipe, &stats);
+	EXPECT(stats.Frames == 5U);
+	EXPECT(stats.Overflows == 2U);
+	EXPECT(starts == 6U);
+
+	while (HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK) {
+		EXPECT(event.Timestamp == read);
+		read++;
+	}
+	EXPECT(read == 3U);
+
+	/* The queue wraps around once read */
+	for (uint32_t index = 0U; index < 10U; index++) {
+		unit_tick = 100U + index;
+		complete(&pipe);
+		EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK);
+		EXPECT(event.Timestamp == (100U + index));
+	}
+	HAL_I3CEx_PipelineGetStats(&pipe, &stats);
+	EXPECT(stats.Overflows == 2U);
+	return 0;
+}
+
+static int test_errors(void)
+{
+	I3CEx_PipelineTypeDef pipe;
+	I3CEx_EventTypeDef events[8];
+	I3CEx_EventTypeDef event;
+	I3CEx_PipelineStatsTypeDef stats;
+
+	reset();
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == 0);
+	EXPECT(HAL_I3CEx_PipelineInit(&pipe, &hi3c, events, 8U) == HAL_OK);
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_OK);
+
+	/* A failed frame stops the continuous mode */
+	hi3c.State = HAL_I3C_STATE_READY;
+	hi3c.ErrorCode = HAL_I3C_ERROR_CE2;
+	HAL_I3CEx_PipelineError(&pipe);
+	EXPECT(pipe.Continuous == 0U);
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK);
+	EXPECT(event.Type == I3CEX_EVENT_ERROR);
+	EXPECT(event.pFrame == &frame);
+	EXPECT(event.ErrorCode == HAL_I3C_ERROR_CE2);
+
+	/* So does a restart the HAL refuses, reported after the frame */
+	hi3c.ErrorCode = 0U;
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_OK);
+	start_status = HAL_ERROR;
+	complete(&pipe);
+	EXPECT(pipe.Continuous == 0U);
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK);
+	EXPECT(event.Type == I3CEX_EVENT_FRAME);
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_OK);
+	EXPECT(event.Type == I3CEX_EVENT_ERROR);
+	EXPECT(HAL_I3CEx_PipelineGetEvent(&pipe, &event) == HAL_ERROR);
+
+	/* A refused start leaves the pipeline idle */
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_ERROR);
+	EXPECT(pipe.Continuous == 0U);
+
+	HAL_I3CEx_PipelineGetStats(&pipe, &stats);
+	EXPECT(stats.Errors == 2U);
+	EXPECT(stats.Frames == 1U);
+	return 0;
+}
+
+/* Pipeline handler cost per frame: completion, event queued and read, restart */
+#define RATE_FRAMES  1000000U
+
+static int test_rate(void)
+{
+	I3CEx_PipelineTypeDef pipe;
+	I3CEx_EventTypeDef events[8];
+	I3CEx_EventTypeDef event;
+	I3CEx_PipelineStatsTypeDef stats;
+	struct timespec begin;
+	struct timespec end;
+	double seconds;
+
+	reset();
+	EXPECT(compile(I3C_PRIVATE_WITH_ARB_RESTART) == 0);
+	EXPECT(HAL_I3CEx_PipelineInit(&pipe, &hi3c, events, 8U) == HAL_OK);
+	EXPECT(HAL_I3CEx_PipelineStart(&pipe, &frame, 1U) == HAL_OK);
+
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+	for (uint32_t index = 0U; index < RATE_FRAMES; index++) {
+		complete(&pipe);
+		if (HAL_I3CEx_PipelineGetEvent(&pipe, &event) != HAL_OK) {
+			return -1;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	HAL_I3CEx_PipelineStop(&pipe);
+
+	HAL_I3CEx_PipelineGetStats(&pipe, &stats);
+	EXPECT(stats.Frames == RATE_FRAMES);
+	EXPECT(stats.Overflows == 0U);
+	EXPECT(starts == (RATE_FRAMES + 1U));
+
+	seconds = (double)(end.tv_sec - begin.tv_sec) + ((double)(end.tv_nsec - begin.tv_nsec) / 1e9);
+	printf("i3c_pipeline.rate: %.0f frames/s, %.0f transfers/s, %.1f ns/frame (host)\n",
+	       RATE_FRAMES / seconds, (RATE_FRAMES * (double)DESC_NBR) / seconds, (seconds * 1e9) / RATE_FRAMES);
+	return 0;
+}
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} tests[] = {
+	{ "frame_compile", test_frame_compile },
+	{ "compile_errors", test_compile_errors },
+	{ "set_tx_data", test_set_tx_data },
+	{ "start_dma", test_start_dma },
+	{ "continuous", test_continuous },
+	{ "ibi_deferral", test_ibi_deferral },
+	{ "overflow", test_overflow },
+	{ "errors", test_errors },
+	{ "rate", test_rate },
+};
+
+int main(void)
+{
+	int failed = 0;
+
+	for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		int ok = (tests[i].run() == 0);
+
+		printf("i3c_pipeline.%-24s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+		failed |= !ok;
+	}
+	return failed;
+}
@@ -0,0 +1,365 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake STM32H7 device header of the unit tests, see README.rst.
+ *
+ * Declares only the registers the extended modules under test use. The
+ * peripheral instances are register blocks of the test, in host memory below
+ * 4 GB (the host build is not PIE). The CPU state intrinsics act on a PRIMASK
+ * variable, the barriers are host fences.
+ */
+
+#ifndef STM32H7XX_H
+#define STM32H7XX_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STM32H7
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __IM    volatile const
+#define __OM    volatile
+#define __IOM   volatile
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE      static inline
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)         __attribute__((aligned(x)))
+#endif
+
+typedef enum {
+	DISABLE = 0,
+	ENABLE = !DISABLE
+} FunctionalState;
+
+#define SET_BIT(REG, BIT)     ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)   ((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)    ((REG) & (BIT))
+#define CLEAR_REG(REG)        ((REG) = (0x0))
+#define WRITE_REG(REG, VAL)   ((REG) = (VAL))
+#define READ_REG(REG)         ((REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  WRITE_REG((REG), (((READ_REG(REG)) & (~(CLEARMASK))) | (SETMASK)))
+#define POSITION_VAL(VAL)     ((uint32_t)__builtin_ctz(VAL))
+
+/* CPU state ---------------------------------------------------------------------*/
+
+/* PRIMASK of the thread running the module under test */
+extern _Thread_local uint32_t unit_primask;
+
+static inline uint32_t __get_PRIMASK(void)
+{
+	return unit_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+	unit_primask = priMask & 1U;
+}
+
+static inline void __disable_irq(void)
+{
+	unit_primask = 1U;
+}
+
+static inline void __enable_irq(void)
+{
+	unit_primask = 0U;
+}
+
+static inline void __DMB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __DSB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __ISB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/* FDCAN -------------------------------------------------------------------------*/
+
+typedef struct {
+	__IO uint32_t CREL;
+	__IO uint32_t ENDN;
+	uint32_t RESERVED1;
+	__IO uint32_t DBTP;
+	__IO uint32_t TEST;
+	__IO uint32_t RWD;
+	__IO uint32_t CCCR;
+	__IO uint32_t NBTP;
+	__IO uint32_t TSCC;
+	__IO uint32_t TSCV;
+	__IO uint32_t TOCC;
+	__IO uint32_t TOCV;
+	uint32_t RESERVED2[4];
+	__IO uint32_t ECR;
+	__IO uint32_t PSR;
+	__IO uint32_t TDCR;
+	uint32_t RESERVED3;
+	__IO uint32_t IR;
+	__IO uint32_t IE;
+	__IO uint32_t ILS;
+	__IO uint32_t ILE;
+	uint32_t RESERVED4[8];
+	__IO uint32_t GFC;
+	__IO uint32_t SIDFC;
+	__IO uint32_t XIDFC;
+	uint32_t RESERVED5;
+	__IO uint32_t XIDAM;
+	__IO uint32_t HPMS;
+	__IO uint32_t NDAT1;
+	__IO uint32_t NDAT2;
+	__IO uint32_t RXF0C;
+	__IO uint32_t RXF0S;
+	__IO uint32_t RXF0A;
+	__IO uint32_t RXBC;
+	__IO uint32_t RXF1C;
+	__IO uint32_t RXF1S;
+	__IO uint32_t RXF1A;
+	__IO uint32_t RXESC;
+	__IO uint32_t TXBC;
+	__IO uint32_t TXFQS;
+	__IO uint32_t TXESC;
+	__IO uint32_t TXBRP;
+	__IO uint32_t TXBAR;
+	__IO uint32_t TXBCR;
+	__IO uint32_t TXBTO;
+	__IO uint32_t TXBCF;
+	__IO uint32_t TXBTIE;
+	__IO uint32_t TXBCIE;
+	uint32_t RESERVED6[2];
+	__IO uint32_t TXEFC;
+	__IO uint32_t TXEFS;
+	__IO uint32_t TXEFA;
+	uint32_t RESERVED7;
+} FDCAN_GlobalTypeDef;
+
+/* The TT registers are not used by the modules under test */
+typedef struct __TTCAN_TypeDef TTCAN_TypeDef;
+
+/* Register block of the FDCAN1 instance, defined by the test */
+extern FDCAN_GlobalTypeDef unit_fdcan1;
+#define FDCAN1                               (&unit_fdcan1)
+
+#define FDCAN_RXF0C_F0S_Pos                  16U
+#define FDCAN_RXF0C_F0S                      (0x7FUL << FDCAN_RXF0C_F0S_Pos)
+#define FDCAN_RXF0C_F0OM_Pos                 31U
+#define FDCAN_RXF0C_F0OM                     (0x1UL << FDCAN_RXF0C_F0OM_Pos)
+#define FDCAN_RXF0S_F0FL                     0x0000007FUL
+#define FDCAN_RXF0S_F0GI_Pos                 8U
+#define FDCAN_RXF0S_F0GI                     (0x3FUL << FDCAN_RXF0S_F0GI_Pos)
+#define FDCAN_RXF0S_F0PI_Pos                 16U
+#define FDCAN_RXF0S_F0PI                     (0x3FUL << FDCAN_RXF0S_F0PI_Pos)
+#define FDCAN_RXF0S_F0F                      (0x1UL << 24)
+
+#define FDCAN_RXF1C_F1S_Pos                  16U
+#define FDCAN_RXF1C_F1S                      (0x7FUL << FDCAN_RXF1C_F1S_Pos)
+#define FDCAN_RXF1C_F1OM_Pos                 31U
+#define FDCAN_RXF1C_F1OM                     (0x1UL << FDCAN_RXF1C_F1OM_Pos)
+#define FDCAN_RXF1S_F1FL                     0x0000007FUL
+#define FDCAN_RXF1S_F1GI_Pos                 8U
+#define FDCAN_RXF1S_F1GI                     (0x3FUL << FDCAN_RXF1S_F1GI_Pos)
+#define FDCAN_RXF1S_F1PI_Pos                 16U
+#define FDCAN_RXF1S_F1PI                     (0x3FUL << FDCAN_RXF1S_F1PI_Pos)
+#define FDCAN_RXF1S_F1F                      (0x1UL << 24)
+
+#define FDCAN_TXBC_TFQM                      (0x1UL << 30)
+#define FDCAN_TXFQS_TFQF                     (0x1UL << 21)
+
+/* HSEM --------------------------------------------------------------------------*/
+
+#define HSEM_SEMID_MIN                       0U
+#define HSEM_SEMID_MAX                       31U
+#define HSEM_PROCESSID_MIN                   0U
+#define HSEM_PROCESSID_MAX                   255U
+
+/* RCC ---------------------------------------------------------------------------*/
+
+/* STM32H743: three power domains, RCC before version 2.0 */
+#define POWER_DOMAINS_NUMBER                 3U
+
+#define RCC_PLLCFGR_PLL1VCOSEL               (0x1UL << 1)
+#define RCC_PLLCFGR_PLL1RGE_0                (0x0UL << 2)
+#define RCC_PLLCFGR_PLL1RGE_1                (0x1UL << 2)
+#define RCC_PLLCFGR_PLL1RGE_2                (0x2UL << 2)
+#define RCC_PLLCFGR_PLL1RGE_3                (0x3UL << 2)
+#define RCC_PLLCFGR_PLL2VCOSEL               (0x1UL << 5)
+#define RCC_PLLCFGR_PLL2RGE_0                (0x0UL << 6)
+#define RCC_PLLCFGR_PLL2RGE_1                (0x1UL << 6)
+#define RCC_PLLCFGR_PLL2RGE_2                (0x2UL << 6)
+#define RCC_PLLCFGR_PLL2RGE_3                (0x3UL << 6)
+#define RCC_PLLCFGR_PLL3VCOSEL               (0x1UL << 9)
+#define RCC_PLLCFGR_PLL3RGE_0                (0x0UL << 10)
+#define RCC_PLLCFGR_PLL3RGE_1                (0x1UL << 10)
+#define RCC_PLLCFGR_PLL3RGE_2                (0x2UL << 10)
+#define RCC_PLLCFGR_PLL3RGE_3                (0x3UL << 10)
+
+/* USB OTG -----------------------------------------------------------------------*/
+
+typedef struct {
+	__IO uint32_t GOTGCTL;
+	__IO uint32_t GOTGINT;
+	__IO uint32_t GAHBCFG;
+	__IO uint32_t GUSBCFG;
+	__IO uint32_t GRSTCTL;
+	__IO uint32_t GINTSTS;
+	__IO uint32_t GINTMSK;
+	__IO uint32_t GRXSTSR;
+	__IO uint32_t GRXSTSP;
+	__IO uint32_t GRXFSIZ;
+	__IO uint32_t DIEPTXF0_HNPTXFSIZ;
+	__IO uint32_t HNPTXSTS;
+	__IO uint32_t Reserved30[2];
+	__IO uint32_t GCCFG;
+	__IO uint32_t CID;
+	__IO uint32_t GSNPSID;
+	__IO uint32_t GHWCFG1;
+	__IO uint32_t GHWCFG2;
+	__IO uint32_t GHWCFG3;
+	__IO uint32_t Reserved6;
+	__IO uint32_t GLPMCFG;
+	__IO uint32_t GPWRDN;
+	__IO uint32_t GDFIFOCFG;
+	__IO uint32_t GADPCTL;
+	__IO uint32_t Reserved43[39];
+	__IO uint32_t HPTXFSIZ;
+	__IO uint32_t DIEPTXF[0x0F];
+} USB_OTG_GlobalTypeDef;
+
+typedef struct {
+	__IO uint32_t DCFG;
+	__IO uint32_t DCTL;
+	__IO uint32_t DSTS;
+	uint32_t Reserved0C;
+	__IO uint32_t DIEPMSK;
+	__IO uint32_t DOEPMSK;
+	__IO uint32_t DAINT;
+	__IO uint32_t DAINTMSK;
+	uint32_t Reserved20;
+	uint32_t Reserved9;
+	__IO uint32_t DVBUSDIS;
+	__IO uint32_t DVBUSPULSE;
+	__IO uint32_t DTHRCTL;
+	__IO uint32_t DIEPEMPMSK;
+	__IO uint32_t DEACHINT;
+	__IO uint32_t DEACHMSK;
+	uint32_t Reserved40;
+	__IO uint32_t DINEP1MSK;
+	uint32_t Reserved44[15];
+	__IO uint32_t DOUTEP1MSK;
+} USB_OTG_DeviceTypeDef;
+
+typedef struct {
+	__IO uint32_t DIEPCTL;
+	__IO uint32_t Reserved04;
+	__IO uint32_t DIEPINT;
+	__IO uint32_t Reserved0C;
+	__IO uint32_t DIEPTSIZ;
+	__IO uint32_t DIEPDMA;
+	__IO uint32_t DTXFSTS;
+	__IO uint32_t Reserved18;
+} USB_OTG_INEndpointTypeDef;
+
+typedef struct {
+	__IO uint32_t DOEPCTL;
+	__IO uint32_t Reserved04;
+	__IO uint32_t DOEPINT;
+	__IO uint32_t Reserved0C;
+	__IO uint32_t DOEPTSIZ;
+	__IO uint32_t DOEPDMA;
+	__IO uint32_t Reserved18[2];
+} USB_OTG_OUTEndpointTypeDef;
+
+typedef struct {
+	__IO uint32_t HCFG;
+	__IO uint32_t HFIR;
+	__IO uint32_t HFNUM;
+	uint32_t Reserved40C;
+	__IO uint32_t HPTXSTS;
+	__IO uint32_t HAINT;
+	__IO uint32_t HAINTMSK;
+} USB_OTG_HostTypeDef;
+
+typedef struct {
+	__IO uint32_t HCCHAR;
+	__IO uint32_t HCSPLT;
+	__IO uint32_t HCINT;
+	__IO uint32_t HCINTMSK;
+	__IO uint32_t HCTSIZ;
+	__IO uint32_t HCDMA;
+	uint32_t Reserved[2];
+} USB_OTG_HostChannelTypeDef;
+
+#define USB_OTG_GLOBAL_BASE                  0x000UL
+#define USB_OTG_DEVICE_BASE                  0x800UL
+#define USB_OTG_IN_ENDPOINT_BASE             0x900UL
+#define USB_OTG_OUT_ENDPOINT_BASE            0xB00UL
+#define USB_OTG_EP_REG_SIZE                  0x20UL
+#define USB_OTG_HOST_BASE                    0x400UL
+#define USB_OTG_HOST_PORT_BASE               0x440UL
+#define USB_OTG_HOST_CHANNEL_BASE            0x500UL
+#define USB_OTG_HOST_CHANNEL_SIZE            0x20UL
+#define USB_OTG_PCGCCTL_BASE                 0xE00UL
+#define USB_OTG_FIFO_BASE                    0x1000UL
+#define USB_OTG_FIFO_SIZE                    0x1000UL
+
+/* Register block of the USB OTG HS instance, defined by the test */
+extern uint32_t unit_usb_otg_hs[(USB_OTG_FIFO_BASE) / 4U];
+#define USB_OTG_HS                           ((USB_OTG_GlobalTypeDef *)unit_usb_otg_hs)
+
+#define USB_OTG_HCCHAR_MPSIZ                 0x000007FFUL
+#define USB_OTG_HCCHAR_EPNUM_Pos             11U
+#define USB_OTG_HCCHAR_EPNUM                 (0xFUL << USB_OTG_HCCHAR_EPNUM_Pos)
+#define USB_OTG_HCCHAR_EPDIR                 (0x1UL << 15)
+#define USB_OTG_HCCHAR_LSDEV                 (0x1UL << 17)
+#define USB_OTG_HCCHAR_EPTYP_Pos             18U
+#define USB_OTG_HCCHAR_EPTYP                 (0x3UL << USB_OTG_HCCHAR_EPTYP_Pos)
+#define USB_OTG_HCCHAR_DAD_Pos               22U
+#define USB_OTG_HCCHAR_DAD                   (0x7FUL << USB_OTG_HCCHAR_DAD_Pos)
+#define USB_OTG_HCCHAR_ODDFRM                (0x1UL << 29)
+#define USB_OTG_HCCHAR_CHDIS                 (0x1UL << 30)
+#define USB_OTG_HCCHAR_CHENA                 (0x1UL << 31)
+
+#define USB_OTG_HCINT_XFRC                   (0x1UL << 0)
+#define USB_OTG_HCINT_CHH                    (0x1UL << 1)
+#define USB_OTG_HCINT_AHBERR                 (0x1UL << 2)
+#define USB_OTG_HCINT_STALL                  (0x1UL << 3)
+#define USB_OTG_HCINT_NAK                    (0x1UL << 4)
+#define USB_OTG_HCINT_ACK                    (0x1UL << 5)
+#define USB_OTG_HCINT_NYET                   (0x1UL << 6)
+#define USB_OTG_HCINT_TXERR                  (0x1UL << 7)
+#define USB_OTG_HCINT_BBERR                  (0x1UL << 8)
+#define USB_OTG_HCINT_FRMOR                  (0x1UL << 9)
+#define USB_OTG_HCINT_DTERR                  (0x1UL << 10)
+
+#define USB_OTG_HCINTMSK_XFRCM               USB_OTG_HCINT_XFRC
+#define USB_OTG_HCINTMSK_CHHM                USB_OTG_HCINT_CHH
+#define USB_OTG_HCINTMSK_AHBERR              USB_OTG_HCINT_AHBERR
+#define USB_OTG_HCINTMSK_STALLM              USB_OTG_HCINT_STALL
+#define USB_OTG_HCINTMSK_NAKM                USB_OTG_HCINT_NAK
+#define USB_OTG_HCINTMSK_ACKM                USB_OTG_HCINT_ACK
+#define USB_OTG_HCINTMSK_NYET                USB_OTG_HCINT_NYET
+#define USB_OTG_HCINTMSK_TXERRM              USB_OTG_HCINT_TXERR
+#define USB_OTG_HCINTMSK_BBERRM              USB_OTG_HCINT_BBERR
+#define USB_OTG_HCINTMSK_FRMORM              USB_OTG_HCINT_FRMOR
+#define USB_OTG_HCINTMSK_DTERRM              USB_OTG_HCINT_DTERR
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H7XX_H */
@@ -0,0 +1,39 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake STM32H7 HAL header of the unit tests, see README.rst.
+ *
+ * Includes the HAL definitions and the headers of the modules under test, not
+ * the HAL configuration. The HAL functions the modules call are implemented
+ * by the tests.
+ */
+
+#ifndef STM32H7XX_HAL_H
+#define STM32H7XX_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_FDCAN_MODULE_ENABLED
+#define HAL_HCD_MODULE_ENABLED
+#define HAL_HSEM_MODULE_ENABLED
+#define HAL_RCC_MODULE_ENABLED
+
+#define assert_param(expr) ((void)0U)
+
+#include "stm32h7xx_hal_def.h"
+#include "stm32h7xx_hal_fdcan.h"
+#include "stm32h7xx_hal_hcd.h"
+#include "stm32h7xx_hal_hsem.h"
+#include "stm32h7xx_hal_rcc.h"
+
+uint32_t HAL_GetTick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H7XX_HAL_H */
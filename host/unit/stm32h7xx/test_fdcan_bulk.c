@@ -0,0 +1,447 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32H7 FDCAN bulk reception (FDCANEx).
+ *
+ * The Rx FIFOs are simulated over a message RAM array: the test writes the
+ * elements the way the controller stores them, publishes the fill level and
+ * get index in RXFnS, and applies the index the module acknowledges in RXFnA.
+ * The frames read back are checked against the frames written, in order and
+ * across the wraparound of the FIFOs.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32h7xx_hal_fdcan_ex.c"
+
+FDCAN_GlobalTypeDef unit_fdcan1;
+_Thread_local uint32_t unit_primask;
+
+/* Stubs of the HAL functions of the other sections of the module */
+HAL_StatusTypeDef HAL_FDCAN_Init(FDCAN_HandleTypeDef *hfdcan)
+{
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigFilter(FDCAN_HandleTypeDef *hfdcan, FDCAN_FilterTypeDef *sFilterConfig)
+{
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigGlobalFilter(FDCAN_HandleTypeDef *hfdcan, uint32_t NonMatchingStd,
+					       uint32_t NonMatchingExt, uint32_t RejectRemoteStd,
+					       uint32_t RejectRemoteExt)
+{
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_AddMessageToTxFifoQ(FDCAN_HandleTypeDef *hfdcan, FDCAN_TxHeaderTypeDef *pTxHeader,
+						uint8_t *pTxData)
+{
+	return HAL_ERROR;
+}
+
+uint32_t HAL_FDCAN_GetLatestTxFifoQRequestBuffer(FDCAN_HandleTypeDef *hfdcan)
+{
+	return 0U;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_AbortTxRequest(FDCAN_HandleTypeDef *hfdcan, uint32_t BufferIndexes)
+{
+	return HAL_ERROR;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return 0U;
+}
+
+#define EXPECT(cond)                                                          \
+	do {                                                                  \
+		if (!(cond)) {                                                \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			return -1;                                            \
+		}                                                             \
+	} while (0)
+
+/* Value RXFnA holds while the module has not written it */
+#define ACK_NONE  0xFFFFFFFFU
+
+struct frame {
+	uint32_t id;
+	uint32_t xtd;
+	uint32_t rtr;
+	uint32_t esi;
+	uint32_t ts;
+	uint32_t dlc;
+	uint32_t brs;
+	uint32_t fdf;
+	uint32_t fidx;
+	uint32_t anmf;
+	uint8_t data[64];
+};
+
+/* Rx FIFO of the controller */
+struct sim_fifo {
+	uint32_t rx_fifo;
+	uint32_t *base;
+	uint32_t words;
+	uint32_t nbr;
+	uint32_t overwrite;
+	uint32_t get;
+	uint32_t put;
+	uint32_t fill;
+	struct frame frames[64];
+};
+
+static FDCAN_HandleTypeDef hfdcan;
+static uint32_t msgram[2560];
+static struct sim_fifo fifo0;
+static struct sim_fifo fifo1;
+static uint32_t seed = 1U;
+
+static uint32_t rand32(void)
+{
+	seed = (seed * 1103515245U) + 12345U;
+	return seed;
+}
+
+static uint32_t dlc_bytes(uint32_t dlc)
+{
+	static const uint8_t bytes[] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64 };
+
+	return bytes[dlc];
+}
+
+static volatile uint32_t *reg_status(const struct sim_fifo *fifo)
+{
+	return (fifo->rx_fifo == FDCAN_RX_FIFO0) ? &FDCAN1->RXF0S : &FDCAN1->RXF1S;
+}
+
+static volatile uint32_t *reg_ack(const struct sim_fifo *fifo)
+{
+	return (fifo->rx_fifo == FDCAN_RX_FIFO0) ? &FDCAN1->RXF0A : &FDCAN1->RXF1A;
+}
+
+/* RXFnS and RXFnA as the controller presents them */
+static void sim_publish(const struct sim_fifo *fifo)
+{
+	*reg_status(fifo) = fifo->fill | (fifo->get << FDCAN_RXF0S_F0GI_Pos) |
+			    (fifo->put << FDCAN_RXF0S_F0PI_Pos) |
+			    ((fifo->fill == fifo->nbr) ? FDCAN_RXF0S_F0F : 0U);
+	*reg_ack(fifo) = ACK_NONE;
+}
+
+/* Elements released by the acknowledge of the module, 0 without one */
+static uint32_t sim_acknowledge(struct sim_fifo *fifo)
+{
+	uint32_t ack = *reg_ack(fifo);
+	uint32_t released;
+
+	if (ack == ACK_NONE) {
+		return 0U;
+	}
+	released = ((ack + fifo->nbr - fifo->get) % fifo->nbr) + 1U;
+	fifo->fill -= released;
+	fifo->get = (ack + 1U) % fifo->nbr;
+	sim_publish(fifo);
+	return released;
+}
+
+static void sim_receive(struct sim_fifo *fifo, const struct frame *frame)
+{
+	uint32_t *element = fifo->base + (fifo->put * fifo->words);
+	uint32_t size = dlc_bytes(frame->dlc);
+
+	if (fifo->fill == fifo->nbr) {
+		if (fifo->overwrite == 0U) {
+			return;
+		}
+		/* The oldest element is replaced */
+		fifo->get = (fifo->get + 1U) % fifo->nbr;
+		fifo->fill--;
+	}
+	element[0] = (frame->xtd ? frame->id : (frame->id << 18)) | (frame->rtr << 29) | (frame->xtd << 30) |
+		     (frame->esi << 31);
+	element[1] = frame->ts | (frame->dlc << 16) | (frame->brs << 20) | (frame->fdf << 21) |
+		     (frame->fidx << 24) | (frame->anmf << 31);
+	memcpy(&element[2], frame->data, size);
+	fifo->frames[fifo->put] = *frame;
+	fifo->put = (fifo->put + 1U) % fifo->nbr;
+	fifo->fill++;
+	sim_publish(fifo);
+}
+
+/* Random frame fitting the elements of the FIFO */
+static void random_frame(const struct sim_fifo *fifo, struct frame *frame)
+{
+	uint32_t bits = rand32();
+
+	frame->xtd = bits & 1U;
+	frame->id = rand32() & (frame->xtd ? 0x1FFFFFFFU : 0x7FFU);
+	frame->rtr = (bits >> 1) & 1U;
+	frame->esi = (bits >> 2) & 1U;
+	frame->brs = (bits >> 3) & 1U;
+	frame->fdf = (bits >> 4) & 1U;
+	frame->anmf = (bits >> 5) & 1U;
+	frame->fidx = (bits >> 8) & 0x7FU;
+	frame->ts = (bits >> 16) & 0xFFFFU;
+	do {
+		frame->dlc = rand32() & 0xFU;
+	} while (dlc_bytes(frame->dlc) > ((fifo->words - 2U) * 4U));
+	for (uint32_t i = 0U; i < 64U; i++) {
+		frame->data[i] = (uint8_t)rand32();
+	}
+}
+
+static int header_matches(const FDCAN_RxHeaderTypeDef *header, const struct frame *frame)
+{
+	return (header->Identifier == frame->id) &&
+	       (header->IdType == (frame->xtd ? FDCAN_EXTENDED_ID : FDCAN_STANDARD_ID)) &&
+	       (header->RxFrameType == (frame->rtr ? FDCAN_REMOTE_FRAME : FDCAN_DATA_FRAME)) &&
+	       (header->ErrorStateIndicator == (frame->esi ? FDCAN_ESI_PASSIVE : FDCAN_ESI_ACTIVE)) &&
+	       (header->RxTimestamp == frame->ts) && (header->DataLength == (frame->dlc << 16)) &&
+	       (header->BitRateSwitch == (frame->brs ? FDCAN_BRS_ON : FDCAN_BRS_OFF)) &&
+	       (header->FDFormat == (frame->fdf ? FDCAN_FD_CAN : FDCAN_CLASSIC_CAN)) &&
+	       (header->FilterIndex == frame->fidx) && (header->IsFilterMatchingFrame == frame->anmf);
+}
+
+/* FIFO 0 of 8 elements of 64 bytes, FIFO 1 of 5 elements of 8 bytes */
+static void setup(uint32_t overwrite)
+{
+	memset(&unit_fdcan1, 0, sizeof(unit_fdcan1));
+	memset(&hfdcan, 0, sizeof(hfdcan));
+	hfdcan.Instance = FDCAN1;
+	hfdcan.State = HAL_FDCAN_STATE_BUSY;
+	hfdcan.Init.RxFifo0ElmtsNbr = 8U;
+	hfdcan.Init.RxFifo0ElmtSize = FDCAN_DATA_BYTES_64;
+	hfdcan.Init.RxFifo1ElmtsNbr = 5U;
+	hfdcan.Init.RxFifo1ElmtSize = FDCAN_DATA_BYTES_8;
+	hfdcan.msgRam.RxFIFO0SA = (uint32_t)&msgram[0];
+	hfdcan.msgRam.RxFIFO1SA = (uint32_t)&msgram[8U * FDCAN_DATA_BYTES_64];
+	FDCAN1->RXF0C = (8U << FDCAN_RXF0C_F0S_Pos) | overwrite;
+	FDCAN1->RXF1C = (5U << FDCAN_RXF1C_F1S_Pos) | overwrite;
+
+	fifo0 = (struct sim_fifo){ .rx_fifo = FDCAN_RX_FIFO0, .base = &msgram[0], .words = FDCAN_DATA_BYTES_64,
+				   .nbr = 8U, .overwrite = overwrite };
+	fifo1 = (struct sim_fifo){ .rx_fifo = FDCAN_RX_FIFO1, .base = &msgram[8U * FDCAN_DATA_BYTES_64],
+				   .words = FDCAN_DATA_BYTES_8, .nbr = 5U, .overwrite = overwrite };
+	sim_publish(&fifo0);
+	sim_publish(&fifo1);
+}
+
+static int test_not_started(void)
+{
+	FDCAN_RxHeaderTypeDef header;
+	const uint32_t *element;
+	uint8_t data[64];
+	uint32_t count = 1U;
+
+	setup(FDCAN_RX_FIFO_BLOCKING);
+	hfdcan.State = HAL_FDCAN_STATE_READY;
+	EXPECT(HAL_FDCANEx_GetRxMessages(&hfdcan, FDCAN_RX_FIFO0, &header, data, 64U, 1U, &count) == HAL_ERROR);
+	EXPECT(count == 0U);
+	EXPECT((hfdcan.ErrorCode & HAL_FDCAN_ERROR_NOT_STARTED) != 0U);
+	EXPECT(HAL_FDCANEx_AcquireRxElements(&hfdcan, FDCAN_RX_FIFO0, &element, 1U, &count) == HAL_ERROR);
+	EXPECT(HAL_FDCANEx_ReleaseRxElements(&hfdcan, FDCAN_RX_FIFO0, 1U) == HAL_ERROR);
+	EXPECT(FDCAN1->RXF0A == ACK_NONE);
+
+	/* No element allocated to the FIFO */
+	setup(FDCAN_RX_FIFO_BLOCKING);
+	FDCAN1->RXF1C = 0U;
+	EXPECT(HAL_FDCANEx_GetRxMessages(&hfdcan, FDCAN_RX_FIFO1, &header, data, 64U, 1U, &count) == HAL_ERROR);
+	EXPECT((hfdcan.ErrorCode & HAL_FDCAN_ERROR_PARAM) != 0U);
+	return 0;
+}
+
+/* Random bursts read in random batches, many times around the FIFO */
+static int get_messages(struct sim_fifo *fifo)
+{
+	FDCAN_RxHeaderTypeDef headers[8];
+	uint8_t data[8][64];
+	uint32_t stride = (fifo->words - 2U) * 4U;
+	uint32_t received = 0U;
+	uint32_t read = 0U;
+
+	while (read < 20000U) {
+		uint32_t burst = rand32() % (fifo->nbr + 1U);
+		uint32_t max = 1U + (rand32() % 8U);
+		uint32_t count = ACK_NONE;
+		uint32_t get = fifo->get;
+		uint32_t fill;
+
+		for (uint32_t i = 0U; (i < burst) && (fifo->fill < fifo->nbr); i++) {
+			struct frame frame;
+
+			random_frame(fifo, &frame);
+			sim_receive(fifo, &frame);
+			received++;
+		}
+		fill = fifo->fill;
+
+		memset(data, 0xA5, sizeof(data));
+		EXPECT(HAL_FDCANEx_GetRxMessages(&hfdcan, fifo->rx_fifo, headers, &data[0][0], stride, max,
+						 &count) == HAL_OK);
+		EXPECT(count == ((fill < max) ? fill : max));
+		/* One acknowledge releasing all the frames read, none without frames */
+		EXPECT(sim_acknowledge(fifo) == count);
+		for (uint32_t i = 0U; i < count; i++) {
+			const struct frame *frame = &fifo->frames[(get + i) % fifo->nbr];
+			const uint8_t *dest = &data[0][0] + (i * stride);
+			uint32_t size = dlc_bytes(frame->dlc);
+
+			EXPECT(header_matches(&headers[i], frame));
+			EXPECT(memcmp(dest, frame->data, size) == 0);
+			/* Nothing written past the payload */
+			for (uint32_t byte = size; byte < stride; byte++) {
+				EXPECT(dest[byte] == 0xA5U);
+			}
+		}
+		read += count;
+	}
+	EXPECT(read + fifo->fill == received);
+	return 0;
+}
+
+static int test_get_messages_fifo0(void)
+{
+	setup(FDCAN_RX_FIFO_BLOCKING);
+	return get_messages(&fifo0);
+}
+
+static int test_get_messages_fifo1(void)
+{
+	setup(FDCAN_RX_FIFO_BLOCKING);
+	return get_messages(&fifo1);
+}
+
+static int test_acquire_release(void)
+{
+	const uint32_t *elements[8];
+	FDCAN_RxHeaderTypeDef header;
+	uint32_t count = ACK_NONE;
+
+	setup(FDCAN_RX_FIFO_BLOCKING);
+	/* Empty */
+	EXPECT(HAL_FDCANEx_AcquireRxElements(&hfdcan, FDCAN_RX_FIFO0, elements, 8U, &count) == HAL_OK);
+	EXPECT(count == 0U);
+	EXPECT(HAL_FDCANEx_ReleaseRxElements(&hfdcan, FDCAN_RX_FIFO0, 0U) == HAL_OK);
+	EXPECT(HAL_FDCANEx_ReleaseRxElements(&hfdcan, FDCAN_RX_FIFO0, 1U) == HAL_ERROR);
+	EXPECT((hfdcan.ErrorCode & HAL_FDCAN_ERROR_PARAM) != 0U);
+	EXPECT(sim_acknowledge(&fifo0) == 0U);
+
+	for (uint32_t round = 0U; round < 5000U; round++) {
+		uint32_t burst = rand32() % (fifo0.nbr + 1U);
+		uint32_t max = 1U + (rand32() % 8U);
+		uint32_t get = fifo0.get;
+		uint32_t release;
+		uint32_t fill;
+
+		for (uint32_t i = 0U; (i < burst) && (fifo0.fill < fifo0.nbr); i++) {
+			struct frame frame;
+
+			random_frame(&fifo0, &frame);
+			sim_receive(&fifo0, &frame);
+		}
+		fill = fifo0.fill;
+
+		EXPECT(HAL_FDCANEx_AcquireRxElements(&hfdcan, FDCAN_RX_FIFO0, elements, max, &count) == HAL_OK);
+		EXPECT(count == ((fill < max) ? fill : max));
+		/* Nothing is released until the elements are parsed */
+		EXPECT(sim_acknowledge(&fifo0) == 0U);
+		for (uint32_t i = 0U; i < count; i++) {
+			uint32_t slot = (get + i) % fifo0.nbr;
+			const struct frame *frame = &fifo0.frames[slot];
+
+			EXPECT(elements[i] == (fifo0.base + (slot * fifo0.words)));
+			HAL_FDCANEx_DecodeRxHeader(elements[i], &header);
+			EXPECT(header_matches(&header, frame));
+			EXPECT(memcmp(__HAL_FDCANEX_GET_RX_ELEMENT_DATA(elements[i]), frame->data,
+				      dlc_bytes(frame->dlc)) == 0);
+		}
+
+		/* Part of them, the others are returned again */
+		release = (count != 0U) ? (rand32() % (count + 1U)) : 0U;
+		EXPECT(HAL_FDCANEx_ReleaseRxElements(&hfdcan, FDCAN_RX_FIFO0, release) == HAL_OK);
+		EXPECT(sim_acknowledge(&fifo0) == release);
+		EXPECT(fifo0.get == ((get + release) % fifo0.nbr));
+	}
+	return 0;
+}
+
+static int test_overwrite(void)
+{
+	FDCAN_RxHeaderTypeDef headers[8];
+	const uint32_t *element;
+	uint8_t data[8][64];
+	uint32_t count = ACK_NONE;
+	uint32_t get;
+
+	setup(FDCAN_RX_FIFO_OVERWRITE);
+	/* Elements parsed in place could be replaced */
+	EXPECT(HAL_FDCANEx_AcquireRxElements(&hfdcan, FDCAN_RX_FIFO0, &element, 1U, &count) == HAL_ERROR);
+	EXPECT(count == 0U);
+	EXPECT((hfdcan.ErrorCode & HAL_FDCAN_ERROR_PARAM) != 0U);
+
+	/* Full after replacing the 3 oldest of 11 frames */
+	for (uint32_t i = 0U; i < 11U; i++) {
+		struct frame frame;
+
+		random_frame(&fifo0, &frame);
+		sim_receive(&fifo0, &frame);
+	}
+	EXPECT(fifo0.fill == fifo0.nbr);
+	EXPECT(fifo0.get == 3U);
+
+	/* The oldest element is skipped, the next frame replaces it */
+	get = fifo0.get;
+	EXPECT(HAL_FDCANEx_GetRxMessages(&hfdcan, FDCAN_RX_FIFO0, headers, &data[0][0], 64U, 8U, &count) == HAL_OK);
+	EXPECT(count == (fifo0.nbr - 1U));
+	for (uint32_t i = 0U; i < count; i++) {
+		EXPECT(header_matches(&headers[i], &fifo0.frames[(get + 1U + i) % fifo0.nbr]));
+	}
+	/* Acknowledging the newest element releases the skipped one too */
+	EXPECT(sim_acknowledge(&fifo0) == fifo0.nbr);
+	EXPECT(fifo0.fill == 0U);
+
+	/* Not full: nothing is skipped */
+	for (uint32_t i = 0U; i < 4U; i++) {
+		struct frame frame;
+
+		random_frame(&fifo0, &frame);
+		sim_receive(&fifo0, &frame);
+	}
+	get = fifo0.get;
+	EXPECT(HAL_FDCANEx_GetRxMessages(&hfdcan, FDCAN_RX_FIFO0, headers, &data[0][0], 64U, 8U, &count) == HAL_OK);
+	EXPECT(count == 4U);
+	EXPECT(header_matches(&headers[0], &fifo0.frames[get]));
+	EXPECT(sim_acknowledge(&fifo0) == 4U);
+	return 0;
+}
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} tests[] = {
+	{ "not_started", test_not_started },
+	{ "get_messages_fifo0", test_get_messages_fifo0 },
+	{ "get_messages_fifo1", test_get_messages_fifo1 },
+	{ "acquire_release", test_acquire_release },
+	{ "overwrite", test_overwrite },
+};
+
+int main(void)
+{
+	int failed = 0;
+
+	for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		int ok = (tests[i].run() == 0);
+
+		printf("fdcan_bulk.%-24s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+		failed |= !ok;
+	}
+	return failed;
+}
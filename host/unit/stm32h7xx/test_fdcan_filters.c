@@ -0,0 +1,337 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32H7 FDCAN acceptance filter compiler (FDCANEx).
+ *
+ * The compiled elements are run through a model of the filter lists, first
+ * match wins, for every standard identifier and for windows of extended
+ * identifiers: each requested identifier must reach its Rx FIFO or Rx buffer,
+ * and the identifiers accepted without being requested must be the ExtraIds
+ * the compiler reports.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32h7xx_hal_fdcan_ex.c"
+
+FDCAN_GlobalTypeDef unit_fdcan1;
+_Thread_local uint32_t unit_primask;
+
+/* Stubs of the HAL functions of the other sections of the module */
+HAL_StatusTypeDef HAL_FDCAN_Init(FDCAN_HandleTypeDef *hfdcan)
+{
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigFilter(FDCAN_HandleTypeDef *hfdcan, FDCAN_FilterTypeDef *sFilterConfig)
+{
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigGlobalFilter(FDCAN_HandleTypeDef *hfdcan, uint32_t NonMatchingStd,
+					       uint32_t NonMatchingExt, uint32_t RejectRemoteStd,
+					       uint32_t RejectRemoteExt)
+{
+	return HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_AddMessageToTxFifoQ(FDCAN_HandleTypeDef *hfdcan, FDCAN_TxHeaderTypeDef *pTxHeader,
+						uint8_t *pTxData)
+{
+	return HAL_ERROR;
+}
+
+uint32_t HAL_FDCAN_GetLatestTxFifoQRequestBuffer(FDCAN_HandleTypeDef *hfdcan)
+{
+	return 0U;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_AbortTxRequest(FDCAN_HandleTypeDef *hfdcan, uint32_t BufferIndexes)
+{
+	return HAL_ERROR;
+}
+
+uint32_t HAL_GetTick(void)
+{
+	return 0U;
+}
+
+#define EXPECT(cond)                                                          \
+	do {                                                                  \
+		if (!(cond)) {                                                \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			return -1;                                            \
+		}                                                             \
+	} while (0)
+
+/* Destination of a frame: filter element configuration, Rx buffer 0x100 + index */
+#define DEST_REJECT  0U
+#define DEST_BUFFER  0x100U
+
+static FDCANEx_FilterSetTypeDef set;
+
+static int match(uint32_t type, uint32_t id, uint32_t id1, uint32_t id2)
+{
+	switch (type) {
+	case FDCAN_FILTER_RANGE:
+	case FDCAN_FILTER_RANGE_NO_EIDM:
+		return (id >= id1) && (id <= id2);
+	case FDCAN_FILTER_DUAL:
+		return (id == id1) || (id == id2);
+	case FDCAN_FILTER_MASK:
+		return (id & id2) == (id1 & id2);
+	default:
+		return 0;
+	}
+}
+
+/* Filter list model, first match wins, non-matching frames rejected */
+static uint32_t destination(uint32_t id_type, uint32_t id)
+{
+	if (id_type == FDCAN_STANDARD_ID) {
+		for (uint32_t i = 0U; i < set.StdFiltersNbr; i++) {
+			uint32_t element = set.StdFilters[i];
+			uint32_t config = (element >> 27) & 0x7U;
+			uint32_t id1 = (element >> 16) & 0x7FFU;
+
+			if (config == FDCAN_FILTER_TO_RXBUFFER) {
+				if (id == id1) {
+					return DEST_BUFFER + (element & 0x3FU);
+				}
+			} else if (match(element >> 30, id, id1, element & 0x7FFU)) {
+				return config;
+			}
+		}
+	} else {
+		for (uint32_t i = 0U; i < set.ExtFiltersNbr; i++) {
+			uint32_t f0 = set.ExtFilters[2U * i];
+			uint32_t f1 = set.ExtFilters[(2U * i) + 1U];
+			uint32_t config = f0 >> 29;
+
+			if (config == FDCAN_FILTER_TO_RXBUFFER) {
+				if (id == (f0 & FDCANEX_EXT_ID_MAX)) {
+					return DEST_BUFFER + (f1 & 0x3FU);
+				}
+			} else if (match(f1 >> 30, id, f0 & FDCANEX_EXT_ID_MAX, f1 & FDCANEX_EXT_ID_MAX)) {
+				return config;
+			}
+		}
+	}
+	return DEST_REJECT;
+}
+
+/* Requested destination of an identifier, from the profile */
+static uint32_t requested(const FDCANEx_AcceptTypeDef *accept, uint32_t nbr, uint32_t id_type, uint32_t id)
+{
+	for (uint32_t i = 0U; i < nbr; i++) {
+		if ((accept[i].IdType == id_type) && (id >= accept[i].IdLow) && (id <= accept[i].IdHigh)) {
+			return (accept[i].RxBufferIndex != FDCANEX_NO_RX_BUFFER) ?
+			       (DEST_BUFFER + accept[i].RxBufferIndex) : accept[i].FilterConfig;
+		}
+	}
+	return DEST_REJECT;
+}
+
+/* Every requested identifier of [first, last] reaches its destination, the extra ones are counted */
+static int check_window(const FDCANEx_AcceptTypeDef *accept, uint32_t nbr, uint32_t id_type, uint32_t first,
+			uint32_t last, uint32_t *extra)
+{
+	for (uint32_t id = first; id <= last; id++) {
+		uint32_t want = requested(accept, nbr, id_type, id);
+		uint32_t got = destination(id_type, id);
+
+		if (want != DEST_REJECT) {
+			EXPECT(got == want);
+		} else if (got != DEST_REJECT) {
+			(*extra)++;
+		}
+	}
+	return 0;
+}
+
+static int compile(FDCANEx_AcceptTypeDef *accept, uint32_t nbr, uint32_t max_std, uint32_t max_ext)
+{
+	FDCANEx_FilterProfileTypeDef profile = {
+		.pAccept = accept,
+		.AcceptNbr = nbr,
+		.MaxStdFilters = max_std,
+		.MaxExtFilters = max_ext,
+		.ServiceInterval = 1000U,
+	};
+
+	memset(&set, 0, sizeof(set));
+	return (HAL_FDCANEx_CompileFilters(&profile, &set) == HAL_OK) ? 0 : -1;
+}
+
+#define STD(lo, hi, fifo)  { FDCAN_STANDARD_ID, (lo), (hi), FDCAN_FILTER_TO_RXFIFO##fifo, 100U, 8U, 0U, 0U }
+#define EXT(lo, hi, fifo)  { FDCAN_EXTENDED_ID, (lo), (hi), FDCAN_FILTER_TO_RXFIFO##fifo, 100U, 8U, 0U, 0U }
+#define NBR(a)             (sizeof(a) / sizeof((a)[0]))
+
+/* Four identifiers differing on two bits: one exact mask filter */
+static int test_mask_singles(void)
+{
+	FDCANEx_AcceptTypeDef accept[] = { STD(0x700, 0x700, 0), STD(0x100, 0x100, 0), STD(0x500, 0x500, 0),
+					   STD(0x300, 0x300, 0) };
+	uint32_t extra = 0U;
+
+	EXPECT(compile(accept, NBR(accept), 0U, 0U) == 0);
+	EXPECT(set.StdFiltersNbr == 1U);
+	EXPECT(set.StdFilters[0] == ((FDCAN_FILTER_MASK << 30) | (FDCAN_FILTER_TO_RXFIFO0 << 27) | (0x100U << 16) |
+				     0x1FFU));
+	EXPECT(check_window(accept, NBR(accept), FDCAN_STANDARD_ID, 0U, FDCANEX_STD_ID_MAX, &extra) == 0);
+	EXPECT((extra == 0U) && (set.ExtraIds == 0U));
+	for (uint32_t i = 0U; i < NBR(accept); i++) {
+		EXPECT(accept[i].FilterIndex == 0U);
+	}
+	return 0;
+}
+
+/* Aligned ranges forming a block, next to ranges and singles which do not */
+static int test_mask_ranges(void)
+{
+	FDCANEx_AcceptTypeDef accept[] = {
+		STD(0x000, 0x00F, 0), STD(0x040, 0x04F, 0), STD(0x400, 0x40F, 0), STD(0x440, 0x44F, 0),
+		STD(0x123, 0x135, 0), STD(0x201, 0x201, 0), STD(0x302, 0x302, 0),
+		/* Same block on the other FIFO is not merged */
+		STD(0x010, 0x01F, 1), STD(0x050, 0x05F, 1),
+	};
+	uint32_t extra = 0U;
+
+	EXPECT(compile(accept, NBR(accept), 0U, 0U) == 0);
+	/* One mask per FIFO, one range, one dual */
+	EXPECT(set.StdFiltersNbr == 4U);
+	EXPECT((set.StdFilters[0] >> 30) == FDCAN_FILTER_MASK);
+	EXPECT((set.StdFilters[1] >> 30) == FDCAN_FILTER_MASK);
+	EXPECT(check_window(accept, NBR(accept), FDCAN_STANDARD_ID, 0U, FDCANEX_STD_ID_MAX, &extra) == 0);
+	EXPECT((extra == 0U) && (set.ExtraIds == 0U));
+	return 0;
+}
+
+/* Identifiers with no common block stay on dual ID filters */
+static int test_duals(void)
+{
+	FDCANEx_AcceptTypeDef accept[] = { STD(0x101, 0x101, 0), STD(0x202, 0x202, 0), STD(0x404, 0x404, 0),
+					   STD(0x708, 0x708, 0) };
+	uint32_t extra = 0U;
+
+	EXPECT(compile(accept, NBR(accept), 0U, 0U) == 0);
+	EXPECT(set.StdFiltersNbr == 2U);
+	EXPECT((set.StdFilters[0] >> 30) == FDCAN_FILTER_DUAL);
+	EXPECT((set.StdFilters[1] >> 30) == FDCAN_FILTER_DUAL);
+	EXPECT(check_window(accept, NBR(accept), FDCAN_STANDARD_ID, 0U, FDCANEX_STD_ID_MAX, &extra) == 0);
+	EXPECT(extra == 0U);
+	return 0;
+}
+
+/* An identifier routed to an Rx buffer leaves the block of the others */
+static int test_rx_buffers(void)
+{
+	FDCANEx_AcceptTypeDef accept[] = { STD(0x100, 0x100, 0), STD(0x300, 0x300, 0), STD(0x500, 0x500, 0),
+					   STD(0x700, 0x700, 0), STD(0x080, 0x080, 1) };
+	FDCANEx_FilterProfileTypeDef profile = {
+		.pAccept = accept,
+		.AcceptNbr = NBR(accept),
+		.MaxRxBuffers = 1U,
+		.RxBufferRateThreshold = 500U,
+		.ServiceInterval = 1000U,
+	};
+	uint32_t extra = 0U;
+
+	accept[2].Rate = 1000U;
+	memset(&set, 0, sizeof(set));
+	EXPECT(HAL_FDCANEx_CompileFilters(&profile, &set) == HAL_OK);
+	EXPECT(set.RxBuffersNbr == 1U);
+	EXPECT(check_window(accept, NBR(accept), FDCAN_STANDARD_ID, 0U, FDCANEX_STD_ID_MAX, &extra) == 0);
+	/* The three others are not a block anymore: two filters, plus the buffer and FIFO 1 */
+	EXPECT(set.StdFiltersNbr == 4U);
+	EXPECT(extra == 0U);
+	return 0;
+}
+
+/* Over budget: masks first, then the closest ranges are merged */
+static int test_budget(void)
+{
+	FDCANEx_AcceptTypeDef accept[] = {
+		STD(0x100, 0x100, 0), STD(0x300, 0x300, 0), STD(0x500, 0x500, 0), STD(0x700, 0x700, 0),
+		STD(0x010, 0x012, 0), STD(0x016, 0x018, 0), STD(0x030, 0x033, 0), STD(0x060, 0x061, 0),
+	};
+	uint32_t extra = 0U;
+
+	EXPECT(compile(accept, NBR(accept), 2U, 0U) == 0);
+	EXPECT(set.StdFiltersNbr == 2U);
+	EXPECT((set.StdFilters[0] >> 30) == FDCAN_FILTER_MASK);
+	EXPECT(check_window(accept, NBR(accept), FDCAN_STANDARD_ID, 0U, FDCANEX_STD_ID_MAX, &extra) == 0);
+	EXPECT(extra == set.ExtraIds);
+	/* 0x010 to 0x061 in a single range */
+	EXPECT(set.ExtraIds == ((0x061U - 0x010U + 1U) - 3U - 3U - 4U - 2U));
+
+	/* The mask leaves no room for the ranges: everything in one range */
+	EXPECT(compile(accept, NBR(accept), 1U, 0U) == 0);
+	EXPECT(set.StdFiltersNbr == 1U);
+	extra = 0U;
+	EXPECT(check_window(accept, NBR(accept), FDCAN_STANDARD_ID, 0U, FDCANEX_STD_ID_MAX, &extra) == 0);
+	EXPECT(extra == set.ExtraIds);
+	return 0;
+}
+
+static int test_extended(void)
+{
+	FDCANEx_AcceptTypeDef accept[] = {
+		EXT(0x18FF0000U, 0x18FF0000U, 0), EXT(0x18FF0004U, 0x18FF0004U, 0),
+		EXT(0x18FF0008U, 0x18FF0008U, 0), EXT(0x18FF000CU, 0x18FF000CU, 0),
+		EXT(0x18FF0100U, 0x18FF01FFU, 1), STD(0x7FF, 0x7FF, 1),
+	};
+	uint32_t extra = 0U;
+
+	EXPECT(compile(accept, NBR(accept), 0U, 0U) == 0);
+	EXPECT((set.StdFiltersNbr == 1U) && (set.ExtFiltersNbr == 2U));
+	EXPECT(set.ExtFilters[0] == ((FDCAN_FILTER_TO_RXFIFO0 << 29) | 0x18FF0000U));
+	EXPECT(set.ExtFilters[1] == ((FDCAN_FILTER_MASK << 30) | (FDCANEX_EXT_ID_MAX & ~0xCU)));
+	EXPECT(check_window(accept, NBR(accept), FDCAN_EXTENDED_ID, 0x18FEFF00U, 0x18FF02FFU, &extra) == 0);
+	EXPECT(check_window(accept, NBR(accept), FDCAN_STANDARD_ID, 0U, FDCANEX_STD_ID_MAX, &extra) == 0);
+	EXPECT(extra == 0U);
+	return 0;
+}
+
+static int test_errors(void)
+{
+	FDCANEx_AcceptTypeDef reversed[] = { STD(0x200, 0x100, 0) };
+	FDCANEx_AcceptTypeDef too_high[] = { STD(0x800, 0x800, 0) };
+	FDCANEx_AcceptTypeDef buffered[] = { STD(0x100, 0x100, 0) };
+
+	EXPECT(compile(reversed, 1U, 0U, 0U) != 0);
+	EXPECT(compile(too_high, 1U, 0U, 0U) != 0);
+	buffered[0].FilterConfig = FDCAN_FILTER_TO_RXBUFFER;
+	EXPECT(compile(buffered, 1U, 0U, 0U) != 0);
+	EXPECT(HAL_FDCANEx_CompileFilters(NULL, &set) == HAL_ERROR);
+	return 0;
+}
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} tests[] = {
+	{ "mask_singles", test_mask_singles },
+	{ "mask_ranges", test_mask_ranges },
+	{ "duals", test_duals },
+	{ "rx_buffers", test_rx_buffers },
+	{ "budget", test_budget },
+	{ "extended", test_extended },
+	{ "errors", test_errors },
+};
+
+int main(void)
+{
+	int failed = 0;
+
+	for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		int ok = (tests[i].run() == 0);
+
+		printf("fdcan_filters.%-24s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+		failed |= !ok;
+	}
+	return failed;
+}
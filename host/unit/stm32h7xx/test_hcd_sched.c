@@ -0,0 +1,640 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32H7 HCD transfer scheduler (HCDEx) on a USB host
+ * simulator.
+ *
+ * The simulator stands for the OTG host channels, the HCD driver and the
+ * device endpoints:
+ *
+ * - HAL_HCD_HC_Init(), HAL_HCD_HC_SubmitRequest() and HAL_HCD_HC_Halt()
+ *   program the channel registers and the channel state of the HCD handle.
+ *   A halt requested while the channel is enabled takes effect at the end of
+ *   the next transaction.
+ * - sim_transaction() runs one bus transaction of a channel: the device
+ *   endpoint answers with the next entry of its script, NAK or data.
+ * - sim_irq() handles the channel interrupt flags as the slave mode
+ *   HCD_HC_IN_IRQHandler() and HCD_HC_OUT_IRQHandler() do, including the
+ *   re-activation of control and bulk IN channels after a NAK and the halted
+ *   channel interrupt taken without notification.
+ *
+ * The device keeps its own data toggle, which the host toggle saved by the
+ * scheduler must match.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32h7xx_hal_hcd_ex.c"
+
+_Thread_local uint32_t unit_primask;
+uint32_t unit_usb_otg_hs[USB_OTG_FIFO_BASE / 4U];
+
+/* USB host simulator ------------------------------------------------------------*/
+
+#define SIM_SCRIPT_MAX     8U
+#define SIM_ENDPOINTS_MAX  4U
+
+enum sim_answer {
+	SIM_NAK,
+	SIM_DATA,
+};
+
+struct sim_endpoint {
+	uint8_t dev_addr;
+	uint8_t ep_addr;
+	uint8_t toggle;
+	uint8_t next_byte;
+	uint8_t answers[SIM_SCRIPT_MAX];
+	uint16_t lengths[SIM_SCRIPT_MAX];
+	uint32_t head;
+	uint32_t count;
+};
+
+struct sim_channel {
+	struct sim_endpoint *ep;
+	int halt_pending;
+	int done;
+};
+
+static HCD_HandleTypeDef hhcd;
+static struct sim_channel channels[16];
+static struct sim_endpoint endpoints[SIM_ENDPOINTS_MAX];
+static uint32_t endpoints_nbr;
+
+static HCDEx_SchedTypeDef hsched;
+
+static USB_OTG_HostChannelTypeDef *sim_regs(uint8_t ch_num)
+{
+	uint32_t USBx_BASE = (uint32_t)hhcd.Instance;
+
+	return USBx_HC(ch_num);
+}
+
+static void sim_reset(void)
+{
+	memset(unit_usb_otg_hs, 0, sizeof(unit_usb_otg_hs));
+	memset(&hhcd, 0, sizeof(hhcd));
+	memset(channels, 0, sizeof(channels));
+	memset(endpoints, 0, sizeof(endpoints));
+	endpoints_nbr = 0U;
+
+	hhcd.Instance = USB_OTG_HS;
+	hhcd.Init.Host_channels = 16U;
+}
+
+static struct sim_endpoint *sim_endpoint(uint8_t dev_addr, uint8_t ep_addr)
+{
+	for (uint32_t i = 0U; i < endpoints_nbr; i++) {
+		if ((endpoints[i].dev_addr == dev_addr) && (endpoints[i].ep_addr == ep_addr)) {
+			return &endpoints[i];
+		}
+	}
+	endpoints[endpoints_nbr].dev_addr = dev_addr;
+	endpoints[endpoints_nbr].ep_addr = ep_addr;
+	return &endpoints[endpoints_nbr++];
+}
+
+/* Queue the answer of a device endpoint to a transaction */
+static void sim_answer(uint8_t dev_addr, uint8_t ep_addr, enum sim_answer answer, uint16_t length)
+{
+	struct sim_endpoint *ep = sim_endpoint(dev_addr, ep_addr);
+	uint32_t slot = (ep->head + ep->count) % SIM_SCRIPT_MAX;
+
+	ep->answers[slot] = (uint8_t)answer;
+	ep->lengths[slot] = length;
+	ep->count++;
+}
+
+/* Stop a channel at once, as USB_HC_Halt() at the end of a transaction */
+static void sim_hc_halt(uint8_t ch_num)
+{
+	USB_OTG_HostChannelTypeDef *regs = sim_regs(ch_num);
+
+	regs->HCCHAR &= ~(USB_OTG_HCCHAR_CHENA | USB_OTG_HCCHAR_CHDIS);
+	regs->HCINT |= USB_OTG_HCINT_CHH;
+	channels[ch_num].halt_pending = 0;
+}
+
+static void sim_hc_reactivate(uint8_t ch_num)
+{
+	USB_OTG_HostChannelTypeDef *regs = sim_regs(ch_num);
+
+	regs->HCCHAR = (regs->HCCHAR & ~USB_OTG_HCCHAR_CHDIS) | USB_OTG_HCCHAR_CHENA;
+	channels[ch_num].halt_pending = 0;
+}
+
+/* Run one bus transaction on a channel, return 0 when the channel is idle */
+static int sim_transaction(uint8_t ch_num)
+{
+	USB_OTG_HostChannelTypeDef *regs = sim_regs(ch_num);
+	struct sim_channel *ch = &channels[ch_num];
+	HCD_HCTypeDef *hc = &hhcd.hc[ch_num];
+	struct sim_endpoint *ep = ch->ep;
+	uint16_t length;
+
+	if (((regs->HCCHAR & USB_OTG_HCCHAR_CHENA) == 0U) || (ch->done != 0)) {
+		return 0;
+	}
+	if (ep->count == 0U) {
+		/* No transaction: a pending halt completes */
+		if (ch->halt_pending != 0) {
+			sim_hc_halt(ch_num);
+			return 1;
+		}
+		return 0;
+	}
+
+	length = ep->lengths[ep->head];
+	if (ep->answers[ep->head] == SIM_NAK) {
+		regs->HCINT |= USB_OTG_HCINT_NAK;
+	} else {
+		if (hc->ep_is_in != 0U) {
+			if (length > hc->xfer_len) {
+				length = (uint16_t)hc->xfer_len;
+			}
+			for (uint32_t i = 0U; i < length; i++) {
+				hc->xfer_buff[i] = ep->next_byte++;
+			}
+			hc->xfer_count = length;
+		} else {
+			hc->xfer_count = hc->xfer_len;
+		}
+		ep->toggle ^= 1U;
+		regs->HCINT |= USB_OTG_HCINT_XFRC;
+		ch->done = 1;
+		if ((hc->ep_type == EP_TYPE_INTR) || (hc->ep_type == EP_TYPE_ISOC)) {
+			/* Periodic channels are disabled at the end of the transfer */
+			regs->HCCHAR &= ~USB_OTG_HCCHAR_CHENA;
+		}
+	}
+	ep->head = (ep->head + 1U) % SIM_SCRIPT_MAX;
+	ep->count--;
+
+	if (ch->halt_pending != 0) {
+		sim_hc_halt(ch_num);
+	}
+	return 1;
+}
+
+static void sim_notify(uint8_t ch_num)
+{
+	HAL_HCD_HC_NotifyURBChange_Callback(&hhcd, ch_num, hhcd.hc[ch_num].urb_state);
+}
+
+/* HCD_HC_IN_IRQHandler(), slave mode */
+static void sim_hc_in_irq(uint8_t ch_num)
+{
+	USB_OTG_HostChannelTypeDef *regs = sim_regs(ch_num);
+	HCD_HCTypeDef *hc = &hhcd.hc[ch_num];
+	int control_bulk = (hc->ep_type == EP_TYPE_CTRL) || (hc->ep_type == EP_TYPE_BULK);
+
+	if ((regs->HCINT & USB_OTG_HCINT_XFRC) != 0U) {
+		regs->HCINT &= ~USB_OTG_HCINT_ACK;
+		hc->state = HC_XFRC;
+		hc->ErrCnt = 0U;
+		regs->HCINT &= ~USB_OTG_HCINT_XFRC;
+		if (control_bulk) {
+			sim_hc_halt(ch_num);
+			regs->HCINT &= ~USB_OTG_HCINT_NAK;
+		} else {
+			hc->urb_state = URB_DONE;
+			sim_notify(ch_num);
+		}
+		hc->toggle_in ^= 1U;
+	} else if ((regs->HCINT & USB_OTG_HCINT_CHH) != 0U) {
+		regs->HCINT &= ~USB_OTG_HCINT_CHH;
+		if (hc->state == HC_XFRC) {
+			hc->state = HC_HALTED;
+			hc->urb_state = URB_DONE;
+		} else if (hc->state == HC_NAK) {
+			hc->state = HC_HALTED;
+			hc->urb_state = URB_NOTREADY;
+			if (control_bulk) {
+				sim_hc_reactivate(ch_num);
+			}
+		} else if (hc->state == HC_HALTED) {
+			return;
+		}
+		sim_notify(ch_num);
+	} else if ((regs->HCINT & USB_OTG_HCINT_NAK) != 0U) {
+		hc->ErrCnt = 0U;
+		hc->state = HC_NAK;
+		sim_hc_halt(ch_num);
+		regs->HCINT &= ~USB_OTG_HCINT_NAK;
+	}
+}
+
+/* HCD_HC_OUT_IRQHandler(), slave mode */
+static void sim_hc_out_irq(uint8_t ch_num)
+{
+	USB_OTG_HostChannelTypeDef *regs = sim_regs(ch_num);
+	HCD_HCTypeDef *hc = &hhcd.hc[ch_num];
+
+	if ((regs->HCINT & USB_OTG_HCINT_XFRC) != 0U) {
+		hc->ErrCnt = 0U;
+		regs->HCINT &= ~USB_OTG_HCINT_XFRC;
+		hc->state = HC_XFRC;
+		sim_hc_halt(ch_num);
+	} else if ((regs->HCINT & USB_OTG_HCINT_NAK) != 0U) {
+		hc->ErrCnt = 0U;
+		hc->state = HC_NAK;
+		if ((hc->do_ping == 0U) && (hc->speed == HCD_DEVICE_SPEED_HIGH)) {
+			hc->do_ping = 1U;
+		}
+		sim_hc_halt(ch_num);
+		regs->HCINT &= ~USB_OTG_HCINT_NAK;
+	} else if ((regs->HCINT & USB_OTG_HCINT_CHH) != 0U) {
+		regs->HCINT &= ~USB_OTG_HCINT_CHH;
+		if (hc->state == HC_XFRC) {
+			hc->state = HC_HALTED;
+			hc->urb_state = URB_DONE;
+			if ((hc->ep_type == EP_TYPE_BULK) || (hc->ep_type == EP_TYPE_INTR)) {
+				hc->toggle_out ^= 1U;
+			}
+		} else if (hc->state == HC_NAK) {
+			hc->state = HC_HALTED;
+			hc->urb_state = URB_NOTREADY;
+		} else if (hc->state == HC_HALTED) {
+			return;
+		}
+		sim_notify(ch_num);
+	}
+}
+
+/* Take the host channel interrupts until none is pending */
+static void sim_irq(void)
+{
+	int pending;
+
+	do {
+		pending = 0;
+		for (uint8_t ch_num = 0U; ch_num < 16U; ch_num++) {
+			USB_OTG_HostChannelTypeDef *regs = sim_regs(ch_num);
+
+			if ((regs->HCINT & regs->HCINTMSK) == 0U) {
+				continue;
+			}
+			pending = 1;
+			if (hhcd.hc[ch_num].ep_is_in != 0U) {
+				sim_hc_in_irq(ch_num);
+			} else {
+				sim_hc_out_irq(ch_num);
+			}
+		}
+	} while (pending != 0);
+}
+
+/* Transaction on a channel followed by its interrupts */
+static void sim_step(uint8_t ch_num)
+{
+	(void)sim_transaction(ch_num);
+	sim_irq();
+}
+
+HAL_StatusTypeDef HAL_HCD_HC_Init(HCD_HandleTypeDef *phhcd, uint8_t ch_num, uint8_t epnum, uint8_t dev_address,
+				  uint8_t speed, uint8_t ep_type, uint16_t mps)
+{
+	USB_OTG_HostChannelTypeDef *regs = sim_regs(ch_num);
+	HCD_HCTypeDef *hc = &phhcd->hc[ch_num];
+
+	hc->do_ping = 0U;
+	hc->dev_addr = dev_address;
+	hc->ch_num = ch_num;
+	hc->ep_type = ep_type;
+	hc->ep_num = epnum & 0x7FU;
+	hc->ep_is_in = ((epnum & 0x80U) == 0x80U) ? 1U : 0U;
+	hc->speed = speed;
+	hc->max_packet = mps;
+
+	regs->HCINT = 0U;
+	regs->HCINTMSK = USB_OTG_HCINTMSK_XFRCM | USB_OTG_HCINTMSK_STALLM | USB_OTG_HCINTMSK_TXERRM |
+			 USB_OTG_HCINTMSK_DTERRM | USB_OTG_HCINTMSK_AHBERR | USB_OTG_HCINTMSK_NAKM |
+			 USB_OTG_HCINTMSK_CHHM;
+	regs->HCCHAR = ((uint32_t)dev_address << USB_OTG_HCCHAR_DAD_Pos) |
+		       (((uint32_t)epnum & 0xFU) << USB_OTG_HCCHAR_EPNUM_Pos) |
+		       ((uint32_t)ep_type << USB_OTG_HCCHAR_EPTYP_Pos) | mps |
+		       (((epnum & 0x80U) == 0x80U) ? USB_OTG_HCCHAR_EPDIR : 0U);
+
+	channels[ch_num].ep = sim_endpoint(dev_address, epnum);
+	channels[ch_num].halt_pending = 0;
+	channels[ch_num].done = 0;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_HCD_HC_SubmitRequest(HCD_HandleTypeDef *phhcd, uint8_t ch_num, uint8_t direction,
+					   uint8_t ep_type, uint8_t token, uint8_t *pbuff, uint16_t length,
+					   uint8_t do_ping)
+{
+	HCD_HCTypeDef *hc = &phhcd->hc[ch_num];
+
+	hc->ep_is_in = direction;
+	hc->ep_type = ep_type;
+	hc->do_ping = do_ping;
+	hc->xfer_buff = pbuff;
+	hc->xfer_len = length;
+	hc->xfer_count = 0U;
+	hc->urb_state = URB_IDLE;
+	hc->state = HC_IDLE;
+
+	sim_regs(ch_num)->HCCHAR = (sim_regs(ch_num)->HCCHAR & ~USB_OTG_HCCHAR_CHDIS) | USB_OTG_HCCHAR_CHENA;
+	channels[ch_num].halt_pending = 0;
+	channels[ch_num].done = 0;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_HCD_HC_Halt(HCD_HandleTypeDef *phhcd, uint8_t ch_num)
+{
+	USB_OTG_HostChannelTypeDef *regs = sim_regs(ch_num);
+
+	if (((regs->HCCHAR & USB_OTG_HCCHAR_CHENA) != 0U) && (channels[ch_num].done == 0)) {
+		/* A transaction may be in progress: the channel stops after it */
+		regs->HCCHAR |= USB_OTG_HCCHAR_CHDIS;
+		channels[ch_num].halt_pending = 1;
+	} else {
+		sim_hc_halt(ch_num);
+	}
+	return HAL_OK;
+}
+
+uint32_t HAL_HCD_HC_GetXferCount(HCD_HandleTypeDef *phhcd, uint8_t chnum)
+{
+	return phhcd->hc[chnum].xfer_count;
+}
+
+void HAL_HCD_HC_NotifyURBChange_Callback(HCD_HandleTypeDef *phhcd, uint8_t chnum, HCD_URBStateTypeDef urb_state)
+{
+	HAL_HCDEx_SchedURBChange(&hsched, chnum, urb_state);
+}
+
+/* Tests -------------------------------------------------------------------------*/
+
+#define EXPECT(cond)                                                          \
+	do {                                                                  \
+		if (!(cond)) {                                                \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			return -1;                                            \
+		}                                                             \
+	} while (0)
+
+#define DEV   1U
+#define BULK_IN    0x81U
+#define BULK_OUT   0x02U
+#define INTR_IN    0x83U
+
+static HCDEx_EndpointTypeDef ep;
+static HCDEx_URBTypeDef urbs[2];
+static uint8_t buffers[2][64];
+static uint32_t completions;
+
+static void urb_complete(HCDEx_URBTypeDef *hurb)
+{
+	completions++;
+}
+
+static int setup(uint8_t ep_addr, uint8_t ep_type, uint16_t interval)
+{
+	sim_reset();
+	memset(urbs, 0, sizeof(urbs));
+	memset(buffers, 0, sizeof(buffers));
+	completions = 0U;
+
+	/* One channel, so that a channel released too early is visible */
+	if ((HAL_HCDEx_SchedInit(&hsched, &hhcd, 0U, 1U, 2U, 4U) != HAL_OK) ||
+	    (HAL_HCDEx_EndpointOpen(&hsched, &ep, DEV, ep_addr, ep_type, HCD_DEVICE_SPEED_HIGH, 64U,
+				    interval) != HAL_OK)) {
+		return -1;
+	}
+	for (uint32_t i = 0U; i < 2U; i++) {
+		urbs[i].pBuffer = buffers[i];
+		urbs[i].Length = sizeof(buffers[i]);
+		urbs[i].pCallback = urb_complete;
+	}
+	return 0;
+}
+
+static int check_data(const uint8_t *data, uint32_t length, uint8_t first)
+{
+	for (uint32_t i = 0U; i < length; i++) {
+		if (data[i] != (uint8_t)(first + i)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/*
+ * The IN endpoint is throttled after 2 NAKs, but the device answers with data
+ * before the halt takes effect: the URB completes with its data and the
+ * toggle is saved once the channel is halted.
+ */
+static int test_throttle_race(void)
+{
+	EXPECT(setup(BULK_IN, EP_TYPE_BULK, 0U) == 0);
+	sim_answer(DEV, BULK_IN, SIM_NAK, 0U);
+	sim_answer(DEV, BULK_IN, SIM_NAK, 0U);
+	sim_answer(DEV, BULK_IN, SIM_DATA, 13U);
+
+	EXPECT(HAL_HCDEx_SubmitURB(&hsched, &ep, &urbs[0]) == HAL_OK);
+	EXPECT(ep.Channel == 0U);
+	sim_step(0U);
+	sim_step(0U);
+
+	/* Throttled: the channel stays with the endpoint until it is halted */
+	EXPECT(ep.Stats.Throttled == 1U);
+	EXPECT(ep.Channel == 0U);
+	EXPECT((hsched.HaltingChannels & 1U) != 0U);
+
+	/* A SOF before the halt completed keeps the channel */
+	HAL_HCDEx_SchedSOF(&hsched);
+	EXPECT(ep.Channel == 0U);
+
+	sim_step(0U);
+	EXPECT(completions == 1U);
+	EXPECT(urbs[0].Status == HCDEX_URB_DONE);
+	EXPECT(urbs[0].Actual == 13U);
+	EXPECT(check_data(buffers[0], 13U, 0U));
+	EXPECT(ep.Channel == HCDEX_NO_CHANNEL);
+	EXPECT(hsched.HaltingChannels == 0U);
+	EXPECT(ep.ToggleIn == sim_endpoint(DEV, BULK_IN)->toggle);
+	return 0;
+}
+
+/*
+ * The halt completes while the interrupts of the last transaction are still
+ * pending: the SOF must leave the channel to the HCD driver, which reports
+ * the completion.
+ */
+static int test_sof_before_irq(void)
+{
+	EXPECT(setup(BULK_IN, EP_TYPE_BULK, 0U) == 0);
+	sim_answer(DEV, BULK_IN, SIM_NAK, 0U);
+	sim_answer(DEV, BULK_IN, SIM_NAK, 0U);
+	sim_answer(DEV, BULK_IN, SIM_DATA, 7U);
+
+	EXPECT(HAL_HCDEx_SubmitURB(&hsched, &ep, &urbs[0]) == HAL_OK);
+	sim_step(0U);
+	sim_step(0U);
+
+	EXPECT(sim_transaction(0U) == 1);
+	EXPECT((sim_regs(0U)->HCCHAR & USB_OTG_HCCHAR_CHENA) == 0U);
+	HAL_HCDEx_SchedSOF(&hsched);
+	EXPECT(ep.Channel == 0U);
+	EXPECT(completions == 0U);
+
+	sim_irq();
+	EXPECT(completions == 1U);
+	EXPECT(urbs[0].Actual == 7U);
+	EXPECT(ep.Channel == HCDEX_NO_CHANNEL);
+	EXPECT(ep.ToggleIn == sim_endpoint(DEV, BULK_IN)->toggle);
+	return 0;
+}
+
+/*
+ * The HCD driver re-activates the IN channel after a NAK received while it
+ * halts: the scheduler halts it again, and frees it on the SOF following the
+ * silent halt. The URB is retried once the backoff expires.
+ */
+static int test_halt_rearmed(void)
+{
+	EXPECT(setup(BULK_IN, EP_TYPE_BULK, 0U) == 0);
+	sim_answer(DEV, BULK_IN, SIM_NAK, 0U);
+	sim_answer(DEV, BULK_IN, SIM_NAK, 0U);
+	sim_answer(DEV, BULK_IN, SIM_NAK, 0U);
+
+	EXPECT(HAL_HCDEx_SubmitURB(&hsched, &ep, &urbs[0]) == HAL_OK);
+	sim_step(0U);
+	sim_step(0U);
+	sim_step(0U);
+	EXPECT(channels[0].halt_pending != 0);
+
+	/* Halted with nothing to report */
+	sim_step(0U);
+	EXPECT((sim_regs(0U)->HCCHAR & USB_OTG_HCCHAR_CHENA) == 0U);
+	EXPECT(ep.Channel == 0U);
+	EXPECT(completions == 0U);
+
+	/* Freed, the backoff of 1 SOF expires in the same SOF: the URB restarts */
+	HAL_HCDEx_SchedSOF(&hsched);
+	EXPECT(hsched.HaltingChannels == 0U);
+	EXPECT(ep.Channel == 0U);
+	EXPECT(urbs[0].Status == HCDEX_URB_ACTIVE);
+	EXPECT(hsched.Stats.ChannelStarts == 2U);
+
+	sim_answer(DEV, BULK_IN, SIM_DATA, 5U);
+	sim_step(0U);
+	EXPECT(completions == 1U);
+	EXPECT(urbs[0].Actual == 5U);
+	EXPECT(ep.ToggleIn == sim_endpoint(DEV, BULK_IN)->toggle);
+	return 0;
+}
+
+/*
+ * Closing an endpoint aborts its queued URBs at once. The URB in progress
+ * completes once the channel is halted, with the data received meanwhile.
+ */
+static int test_close_in_progress(void)
+{
+	EXPECT(setup(BULK_IN, EP_TYPE_BULK, 0U) == 0);
+
+	EXPECT(HAL_HCDEx_SubmitURB(&hsched, &ep, &urbs[0]) == HAL_OK);
+	EXPECT(HAL_HCDEx_SubmitURB(&hsched, &ep, &urbs[1]) == HAL_OK);
+	EXPECT(HAL_HCDEx_EndpointClose(&hsched, &ep) == HAL_OK);
+	EXPECT(completions == 1U);
+	EXPECT(urbs[1].Status == HCDEX_URB_ABORTED);
+	EXPECT(urbs[0].Status == HCDEX_URB_ACTIVE);
+	EXPECT(hsched.pEndpoints == NULL);
+
+	sim_answer(DEV, BULK_IN, SIM_DATA, 9U);
+	sim_step(0U);
+	EXPECT(completions == 2U);
+	EXPECT(urbs[0].Status == HCDEX_URB_DONE);
+	EXPECT(urbs[0].Actual == 9U);
+	EXPECT(hsched.pChannel[0] == NULL);
+	EXPECT(hsched.HaltingChannels == 0U);
+
+	/* Without data, the URB in progress is aborted once halted */
+	EXPECT(setup(BULK_IN, EP_TYPE_BULK, 0U) == 0);
+	EXPECT(HAL_HCDEx_SubmitURB(&hsched, &ep, &urbs[0]) == HAL_OK);
+	EXPECT(HAL_HCDEx_EndpointClose(&hsched, &ep) == HAL_OK);
+	EXPECT(completions == 0U);
+	sim_step(0U);
+	EXPECT(completions == 1U);
+	EXPECT(urbs[0].Status == HCDEX_URB_ABORTED);
+	EXPECT(hsched.pChannel[0] == NULL);
+	return 0;
+}
+
+/*
+ * The HCD driver updates the IN toggle of a periodic channel after the URB
+ * notification: the toggle is saved on the next SOF.
+ */
+static int test_periodic_toggle(void)
+{
+	EXPECT(setup(INTR_IN, EP_TYPE_INTR, 1U) == 0);
+	sim_answer(DEV, INTR_IN, SIM_DATA, 8U);
+
+	EXPECT(HAL_HCDEx_SubmitURB(&hsched, &ep, &urbs[0]) == HAL_OK);
+	sim_step(0U);
+	EXPECT(completions == 1U);
+	EXPECT(urbs[0].Actual == 8U);
+	EXPECT(ep.Channel == 0U);
+
+	HAL_HCDEx_SchedSOF(&hsched);
+	EXPECT(ep.Channel == HCDEX_NO_CHANNEL);
+	EXPECT(ep.ToggleIn == 1U);
+	EXPECT(ep.ToggleIn == sim_endpoint(DEV, INTR_IN)->toggle);
+	return 0;
+}
+
+/* OUT NAKs are retried, then throttled with the channel already halted */
+static int test_out_throttle(void)
+{
+	EXPECT(setup(BULK_OUT, EP_TYPE_BULK, 0U) == 0);
+	sim_answer(DEV, BULK_OUT, SIM_NAK, 0U);
+	sim_answer(DEV, BULK_OUT, SIM_NAK, 0U);
+
+	EXPECT(HAL_HCDEx_SubmitURB(&hsched, &ep, &urbs[0]) == HAL_OK);
+	sim_step(0U);
+	EXPECT(ep.Channel == 0U);
+	EXPECT(ep.DoPing == 1U);
+	sim_step(0U);
+	EXPECT(ep.Stats.Throttled == 1U);
+	EXPECT(ep.Channel == HCDEX_NO_CHANNEL);
+
+	HAL_HCDEx_SchedSOF(&hsched);
+	EXPECT(ep.Channel == 0U);
+	sim_answer(DEV, BULK_OUT, SIM_DATA, 0U);
+	sim_step(0U);
+	EXPECT(completions == 1U);
+	EXPECT(urbs[0].Actual == sizeof(buffers[0]));
+	EXPECT(ep.ToggleOut == sim_endpoint(DEV, BULK_OUT)->toggle);
+	return 0;
+}
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} tests[] = {
+	{ "throttle_race", test_throttle_race },
+	{ "sof_before_irq", test_sof_before_irq },
+	{ "halt_rearmed", test_halt_rearmed },
+	{ "close_in_progress", test_close_in_progress },
+	{ "periodic_toggle", test_periodic_toggle },
+	{ "out_throttle", test_out_throttle },
+};
+
+int main(void)
+{
+	int failed = 0;
+
+	for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		int ok = (tests[i].run() == 0);
+
+		printf("hcd_sched.%-24s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+		failed |= !ok;
+	}
+	return failed;
+}
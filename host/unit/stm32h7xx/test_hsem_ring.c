@@ -0,0 +1,426 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32H7 HSEM message rings (HSEMEx), with the producers
+ * and the consumer on different threads standing for the cores.
+ *
+ * The HSEM simulator implements the semaphores the rings use:
+ *
+ * - HAL_HSEM_Take() and HAL_HSEM_FastTake() take a free semaphore
+ *   atomically, HAL_HSEM_Release() frees it when the owner matches.
+ * - A release of a semaphore whose notification is active raises the HSEM
+ *   interrupt of the consumer core: as HAL_HSEM_IRQHandler() does, the
+ *   notification is deactivated and the released semaphore is given to
+ *   HAL_HSEM_FreeCallback(), run by the consumer thread.
+ *
+ * The consumer only drains a ring after a doorbell, with a timeout: a lost
+ * notification fails the test.
+ *
+ * The threaded tests report the message rate, the latency from the send
+ * call to the reception of each message and the number of messages per
+ * doorbell.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "stm32h7xx_hal_hsem_ex.c"
+
+_Thread_local uint32_t unit_primask;
+uint32_t unit_usb_otg_hs[USB_OTG_FIFO_BASE / 4U];
+
+/* HSEM simulator ----------------------------------------------------------------*/
+
+#define SIM_FAST_TAKE  0x100U  /* Owner of a semaphore taken in one step */
+
+static uint32_t sim_owner[HSEM_SEMID_MAX + 1U];
+static uint32_t sim_notified;
+static uint32_t sim_irq;
+static pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_cond = PTHREAD_COND_INITIALIZER;
+
+static HAL_StatusTypeDef sim_take(uint32_t SemID, uint32_t owner)
+{
+	uint32_t expected = 0U;
+
+	return __atomic_compare_exchange_n(&sim_owner[SemID], &expected, owner, 0, __ATOMIC_ACQ_REL,
+					   __ATOMIC_ACQUIRE) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_HSEM_Take(uint32_t SemID, uint32_t ProcessID)
+{
+	return sim_take(SemID, ProcessID + 1U);
+}
+
+HAL_StatusTypeDef HAL_HSEM_FastTake(uint32_t SemID)
+{
+	return sim_take(SemID, SIM_FAST_TAKE);
+}
+
+void HAL_HSEM_Release(uint32_t SemID, uint32_t ProcessID)
+{
+	uint32_t owner = __atomic_load_n(&sim_owner[SemID], __ATOMIC_ACQUIRE);
+	uint32_t mask = 1UL << SemID;
+
+	/* A one step take is released with process ID 0 */
+	if ((owner != (ProcessID + 1U)) && !((owner == SIM_FAST_TAKE) && (ProcessID == 0U))) {
+		return;
+	}
+	pthread_mutex_lock(&sim_lock);
+	__atomic_store_n(&sim_owner[SemID], 0U, __ATOMIC_RELEASE);
+	if ((sim_notified & mask) != 0U) {
+		sim_notified &= ~mask;
+		sim_irq |= mask;
+		pthread_cond_signal(&sim_cond);
+	}
+	pthread_mutex_unlock(&sim_lock);
+}
+
+void HAL_HSEM_ActivateNotification(uint32_t SemMask)
+{
+	pthread_mutex_lock(&sim_lock);
+	sim_notified |= SemMask;
+	pthread_mutex_unlock(&sim_lock);
+}
+
+/* Wait for the HSEM interrupt of the consumer core, 0 on timeout */
+static uint32_t sim_wait_irq(void)
+{
+	struct timespec deadline;
+	uint32_t mask;
+
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += 5;
+
+	pthread_mutex_lock(&sim_lock);
+	while (sim_irq == 0U) {
+		if (pthread_cond_timedwait(&sim_cond, &sim_lock, &deadline) != 0) {
+			break;
+		}
+	}
+	mask = sim_irq;
+	sim_irq = 0U;
+	pthread_mutex_unlock(&sim_lock);
+	return mask;
+}
+
+static void sim_reset(void)
+{
+	memset(sim_owner, 0, sizeof(sim_owner));
+	sim_notified = 0U;
+	sim_irq = 0U;
+}
+
+/* Rings ---------------------------------------------------------------------------*/
+
+#define EXPECT(cond)                                                          \
+	do {                                                                  \
+		if (!(cond)) {                                                \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			return -1;                                            \
+		}                                                             \
+	} while (0)
+
+#define DOORBELL      3U
+#define LOCK          4U
+#define PAYLOAD_MAX   56U
+#define SLOT_SIZE     64U
+#define SLOTS         8U
+#define MESSAGES      100000U
+#define PRODUCERS_MAX 2U
+
+/* Memory shared by the cores */
+static HSEMEx_RingCtrlTypeDef ctrl __attribute__((aligned(HSEMEX_CACHE_LINE_SIZE)));
+static uint8_t slots[__HAL_HSEMEX_RING_STORAGE_SIZE(PAYLOAD_MAX, SLOTS)]
+	__attribute__((aligned(HSEMEX_CACHE_LINE_SIZE)));
+
+struct producer {
+	HSEMEx_RingTypeDef hring;
+	uint8_t id;
+	int zero_copy;
+	int failed;
+};
+
+static struct producer producers[PRODUCERS_MAX];
+static HSEMEx_RingTypeDef consumer;
+
+/* Send time of each message, written by the producer before it is queued */
+static uint64_t sent_ns[PRODUCERS_MAX][MESSAGES];
+
+struct latency {
+	uint64_t total;
+	uint64_t max;
+};
+
+static uint64_t now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000U) + (uint64_t)ts.tv_nsec;
+}
+
+/* Message: producer ID, sequence number, then bytes derived from both */
+static uint32_t message_length(uint32_t seq)
+{
+	return 5U + (seq % (PAYLOAD_MAX - 4U));
+}
+
+static void message_fill(uint8_t *data, uint8_t id, uint32_t seq)
+{
+	uint32_t length = message_length(seq);
+
+	data[0] = id;
+	memcpy(&data[1], &seq, sizeof(seq));
+	for (uint32_t i = 5U; i < length; i++) {
+		data[i] = (uint8_t)((seq * 31U) + (i * 7U) + id);
+	}
+}
+
+static void *producer_thread(void *arg)
+{
+	struct producer *p = arg;
+	uint8_t message[PAYLOAD_MAX];
+
+	for (uint32_t seq = 0U; seq < MESSAGES; seq++) {
+		HAL_StatusTypeDef status;
+
+		if (p->zero_copy) {
+			uint8_t *buffer;
+			uint32_t size;
+
+			while ((status = HAL_HSEMEx_RingAcquire(&p->hring, &buffer, &size)) == HAL_BUSY) {
+				sched_yield();
+			}
+			if ((status != HAL_OK) || (size < PAYLOAD_MAX)) {
+				p->failed = 1;
+				break;
+			}
+			sent_ns[p->id][seq] = now_ns();
+			message_fill(buffer, p->id, seq);
+			status = HAL_HSEMEx_RingCommit(&p->hring, message_length(seq));
+		} else {
+			message_fill(message, p->id, seq);
+			do {
+				sent_ns[p->id][seq] = now_ns();
+				status = HAL_HSEMEx_RingSend(&p->hring, message, message_length(seq));
+				if (status == HAL_BUSY) {
+					sched_yield();
+				}
+			} while (status == HAL_BUSY);
+		}
+		if (status != HAL_OK) {
+			p->failed = 1;
+			break;
+		}
+	}
+	return NULL;
+}
+
+static int message_check(const uint8_t *data, uint32_t length, uint32_t *next_seq, uint32_t producers_nbr,
+			 struct latency *lat)
+{
+	uint64_t delay;
+	uint8_t expected[PAYLOAD_MAX];
+	uint32_t seq;
+
+	EXPECT(length >= 5U);
+	EXPECT(data[0] < producers_nbr);
+	memcpy(&seq, &data[1], sizeof(seq));
+	/* In order for each producer */
+	EXPECT(seq == next_seq[data[0]]);
+	EXPECT(length == message_length(seq));
+	message_fill(expected, data[0], seq);
+	EXPECT(memcmp(data, expected, length) == 0);
+	delay = now_ns() - sent_ns[data[0]][seq];
+	lat->total += delay;
+	if (delay > lat->max) {
+		lat->max = delay;
+	}
+	next_seq[data[0]]++;
+	return 0;
+}
+
+/* Consumer: drain after each doorbell, by peek/release or by copy */
+static int consume(uint32_t producers_nbr, int zero_copy, struct latency *lat)
+{
+	uint32_t next_seq[PRODUCERS_MAX] = { 0U };
+	uint32_t received = 0U;
+	uint32_t irqs = 0U;
+
+	while (received < (producers_nbr * MESSAGES)) {
+		uint32_t mask = sim_wait_irq();
+
+		EXPECT(mask != 0U);
+		irqs++;
+		EXPECT(HAL_HSEMEx_RingDoorbell(&consumer, mask) == 1U);
+		for (;;) {
+			HAL_StatusTypeDef status;
+			uint8_t copy[PAYLOAD_MAX];
+			uint8_t *data = copy;
+			uint32_t length;
+
+			if (zero_copy) {
+				status = HAL_HSEMEx_RingPeek(&consumer, &data, &length);
+			} else {
+				status = HAL_HSEMEx_RingReceive(&consumer, copy, sizeof(copy), &length);
+			}
+			if (status == HAL_BUSY) {
+				break;
+			}
+			EXPECT(status == HAL_OK);
+			EXPECT(message_check(data, length, next_seq, producers_nbr, lat) == 0);
+			if (zero_copy) {
+				EXPECT(HAL_HSEMEx_RingRelease(&consumer) == HAL_OK);
+			}
+			received++;
+		}
+	}
+	EXPECT(consumer.Stats.Messages == (producers_nbr * MESSAGES));
+	EXPECT(consumer.Stats.Doorbells == irqs);
+	EXPECT(HAL_HSEMEx_RingGetCount(&consumer) == 0U);
+	return 0;
+}
+
+static int run(uint32_t producers_nbr, int zero_copy)
+{
+	pthread_t threads[PRODUCERS_MAX];
+	uint32_t doorbells = 0U;
+	struct latency lat = { 0U, 0U };
+	uint32_t total = producers_nbr * MESSAGES;
+	uint64_t begin;
+	uint64_t elapsed;
+	int result;
+
+	sim_reset();
+	EXPECT(HAL_HSEMEx_RingInit(&consumer, &ctrl, slots, SLOT_SIZE, SLOTS, DOORBELL) == HAL_OK);
+	EXPECT(HAL_HSEMEx_RingReset(&consumer) == HAL_OK);
+	for (uint32_t i = 0U; i < producers_nbr; i++) {
+		struct producer *p = &producers[i];
+
+		memset(p, 0, sizeof(*p));
+		p->id = (uint8_t)i;
+		p->zero_copy = zero_copy;
+		EXPECT(HAL_HSEMEx_RingInit(&p->hring, &ctrl, slots, SLOT_SIZE, SLOTS, DOORBELL) == HAL_OK);
+		if (producers_nbr > 1U) {
+			EXPECT(HAL_HSEMEx_RingSetLock(&p->hring, LOCK, i) == HAL_OK);
+		}
+	}
+	HAL_HSEMEx_RingEnableDoorbell(&consumer);
+
+	begin = now_ns();
+	for (uint32_t i = 0U; i < producers_nbr; i++) {
+		EXPECT(pthread_create(&threads[i], NULL, producer_thread, &producers[i]) == 0);
+	}
+	result = consume(producers_nbr, zero_copy, &lat);
+	elapsed = now_ns() - begin;
+	for (uint32_t i = 0U; i < producers_nbr; i++) {
+		pthread_join(threads[i], NULL);
+	}
+	EXPECT(result == 0);
+
+	for (uint32_t i = 0U; i < producers_nbr; i++) {
+		EXPECT(producers[i].failed == 0);
+		EXPECT(producers[i].hring.Stats.Messages == MESSAGES);
+		doorbells += producers[i].hring.Stats.Doorbells;
+	}
+	/* At most one notification per doorbell rung */
+	EXPECT(consumer.Stats.Doorbells <= doorbells);
+
+	printf("hsem_ring.rate: %u producer(s), %s: %.0f messages/s, latency %.0f ns mean %.0f us max, "
+	       "%.2f messages per doorbell (host threads)\n",
+	       producers_nbr, zero_copy ? "zero copy" : "copy", (total * 1e9) / (double)elapsed,
+	       (double)lat.total / total, (double)lat.max / 1e3, (double)total / consumer.Stats.Doorbells);
+	return 0;
+}
+
+static int test_init_errors(void)
+{
+	HSEMEx_RingTypeDef hring;
+
+	EXPECT(HAL_HSEMEx_RingInit(&hring, &ctrl, &slots[4], SLOT_SIZE, SLOTS, DOORBELL) == HAL_ERROR);
+	EXPECT(HAL_HSEMEx_RingInit(&hring, &ctrl, slots, 48U, SLOTS, DOORBELL) == HAL_ERROR);
+	EXPECT(HAL_HSEMEx_RingInit(&hring, &ctrl, slots, SLOT_SIZE, 6U, DOORBELL) == HAL_ERROR);
+	EXPECT(HAL_HSEMEx_RingInit(&hring, &ctrl, slots, SLOT_SIZE, SLOTS, HSEM_SEMID_MAX + 1U) ==
+	       HAL_ERROR);
+	EXPECT(HAL_HSEMEx_RingInit(&hring, &ctrl, slots, SLOT_SIZE, SLOTS, DOORBELL) == HAL_OK);
+	EXPECT(HAL_HSEMEx_RingSetLock(&hring, DOORBELL, 0U) == HAL_ERROR);
+	return 0;
+}
+
+/* Full and empty ring, oversized messages, on one thread */
+static int test_full_empty(void)
+{
+	uint8_t message[PAYLOAD_MAX + 1U] = { 0U };
+	uint8_t *buffer;
+	uint32_t length;
+
+	sim_reset();
+	EXPECT(HAL_HSEMEx_RingInit(&consumer, &ctrl, slots, SLOT_SIZE, SLOTS, DOORBELL) == HAL_OK);
+	EXPECT(HAL_HSEMEx_RingReset(&consumer) == HAL_OK);
+	EXPECT(HAL_HSEMEx_RingInit(&producers[0].hring, &ctrl, slots, SLOT_SIZE, SLOTS, DOORBELL) == HAL_OK);
+
+	EXPECT(HAL_HSEMEx_RingPeek(&consumer, &buffer, &length) == HAL_BUSY);
+	EXPECT(HAL_HSEMEx_RingSend(&producers[0].hring, message, PAYLOAD_MAX + 1U) == HAL_ERROR);
+	for (uint32_t i = 0U; i < SLOTS; i++) {
+		EXPECT(HAL_HSEMEx_RingSend(&producers[0].hring, message, 8U) == HAL_OK);
+	}
+	EXPECT(HAL_HSEMEx_RingSend(&producers[0].hring, message, 8U) == HAL_BUSY);
+	EXPECT(producers[0].hring.Stats.Full == 1U);
+	EXPECT(HAL_HSEMEx_RingGetCount(&consumer) == SLOTS);
+	/* Too small a buffer leaves the message in the ring */
+	EXPECT(HAL_HSEMEx_RingReceive(&consumer, message, 4U, &length) == HAL_ERROR);
+	EXPECT(HAL_HSEMEx_RingReceive(&consumer, message, sizeof(message), &length) == HAL_OK);
+	EXPECT(length == 8U);
+	EXPECT(HAL_HSEMEx_RingGetCount(&consumer) == (SLOTS - 1U));
+	return 0;
+}
+
+static int test_single_producer(void)
+{
+	return run(1U, 1);
+}
+
+static int test_single_producer_copy(void)
+{
+	return run(1U, 0);
+}
+
+static int test_two_producers(void)
+{
+	return run(2U, 0);
+}
+
+static int test_two_producers_zero_copy(void)
+{
+	return run(2U, 1);
+}
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} tests[] = {
+	{ "init_errors", test_init_errors },
+	{ "full_empty", test_full_empty },
+	{ "single_producer", test_single_producer },
+	{ "single_producer_copy", test_single_producer_copy },
+	{ "two_producers", test_two_producers },
+	{ "two_producers_zero_copy", test_two_producers_zero_copy },
+};
+
+int main(void)
+{
+	int failed = 0;
+
+	for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		int ok = (tests[i].run() == 0);
+
+		printf("hsem_ring.%-24s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+		failed |= !ok;
+	}
+	return failed;
+}
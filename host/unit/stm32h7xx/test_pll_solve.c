@@ -0,0 +1,229 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32H7 PLL solver (RCCEx).
+ *
+ * Each configuration returned is checked against the PLL equations: VCO
+ * input and output within the limits of their range, PLLRGE and PLLVCOSEL
+ * matching them, and every used output within its tolerance of the target.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "stm32h7xx_hal_rcc_ex_pll.c"
+
+#define EXPECT(cond)                                                          \
+	do {                                                                  \
+		if (!(cond)) {                                                \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			return -1;                                            \
+		}                                                             \
+	} while (0)
+
+#define HSE_FREQ  25000000U
+
+/* VCO output frequency, scaled by the fractional part resolution */
+static uint64_t vco_x(const RCC_PLLTargetTypeDef *target, const RCC_PLLInitTypeDef *pll)
+{
+	return ((uint64_t)target->InputFreq * ((pll->PLLN * PLLFRACN_RESOLUTION) + pll->PLLFRACN)) / pll->PLLM;
+}
+
+static uint32_t output_freq(const RCC_PLLTargetTypeDef *target, const RCC_PLLInitTypeDef *pll, uint32_t div)
+{
+	return (uint32_t)(vco_x(target, pll) / ((uint64_t)div * PLLFRACN_RESOLUTION));
+}
+
+static int within(uint32_t freq, uint32_t target, uint32_t tolerance)
+{
+	return (target == 0U) || (((freq > target) ? (freq - target) : (target - freq)) <= tolerance);
+}
+
+/* Configuration returned for target: PLL equations and limits */
+static int check_config(const RCC_PLLTargetTypeDef *target, const RCC_PLLInitTypeDef *pll)
+{
+	static const uint32_t pllrge[3][4] = {
+		{ RCC_PLL1VCIRANGE_0, RCC_PLL1VCIRANGE_1, RCC_PLL1VCIRANGE_2, RCC_PLL1VCIRANGE_3 },
+		{ RCC_PLL2VCIRANGE_0, RCC_PLL2VCIRANGE_1, RCC_PLL2VCIRANGE_2, RCC_PLL2VCIRANGE_3 },
+		{ RCC_PLL3VCIRANGE_0, RCC_PLL3VCIRANGE_1, RCC_PLL3VCIRANGE_2, RCC_PLL3VCIRANGE_3 },
+	};
+	static const uint32_t pllvcosel[3][2] = {
+		{ RCC_PLL1VCOWIDE, RCC_PLL1VCOMEDIUM },
+		{ RCC_PLL2VCOWIDE, RCC_PLL2VCOMEDIUM },
+		{ RCC_PLL3VCOWIDE, RCC_PLL3VCOMEDIUM },
+	};
+	uint32_t vci = target->InputFreq / pll->PLLM;
+	uint64_t vco = vco_x(target, pll) / PLLFRACN_RESOLUTION;
+	uint32_t range = (vci < 2000000U) ? 0U : ((vci < 4000000U) ? 1U : ((vci < 8000000U) ? 2U : 3U));
+	uint32_t medium = (range == 0U) ? 1U : 0U;
+
+	EXPECT(pll->PLLState == RCC_PLL_ON);
+	EXPECT(pll->PLLSource == target->PLLSource);
+	EXPECT((pll->PLLM >= 1U) && (pll->PLLM <= 63U));
+	EXPECT((pll->PLLN >= PLLN_MIN) && (pll->PLLN <= PLLN_MAX));
+	EXPECT(pll->PLLFRACN < PLLFRACN_RESOLUTION);
+	EXPECT((target->Fractional != 0U) || (pll->PLLFRACN == 0U));
+	EXPECT((vci >= PLLVCO_INPUT_MIN) && (vci <= PLLVCO_INPUT_MAX));
+	EXPECT(pll->PLLRGE == pllrge[target->PLLx - 1U][range]);
+	EXPECT(pll->PLLVCOSEL == pllvcosel[target->PLLx - 1U][medium]);
+	if (medium != 0U) {
+		EXPECT((vco >= PLLVCO_MEDIUM_OUTPUT_MIN) && (vco <= PLLVCO_MEDIUM_OUTPUT_MAX));
+	} else {
+		EXPECT((vco >= PLLVCO_WIDE_OUTPUT_MIN) && (vco <= PLLVCO_WIDE_OUTPUT_MAX));
+	}
+	EXPECT((pll->PLLP >= 1U) && (pll->PLLP <= PLLDIV_MAX));
+	EXPECT((pll->PLLQ >= 1U) && (pll->PLLQ <= PLLDIV_MAX));
+	EXPECT((pll->PLLR >= 1U) && (pll->PLLR <= PLLDIV_MAX));
+	/* PLL1 P: 1 or even, the solver only uses even values */
+	EXPECT((target->PLLx != 1U) || ((pll->PLLP % 2U) == 0U));
+	EXPECT(within(output_freq(target, pll, pll->PLLP), target->PLLPFreq, target->PLLPTolerance));
+	EXPECT(within(output_freq(target, pll, pll->PLLQ), target->PLLQFreq, target->PLLQTolerance));
+	EXPECT(within(output_freq(target, pll, pll->PLLR), target->PLLRFreq, target->PLLRTolerance));
+	/* Unused outputs at their lowest frequency */
+	EXPECT((target->PLLPFreq != 0U) || (pll->PLLP == PLLDIV_MAX));
+	EXPECT((target->PLLQFreq != 0U) || (pll->PLLQ == PLLDIV_MAX));
+	EXPECT((target->PLLRFreq != 0U) || (pll->PLLR == PLLDIV_MAX));
+	return 0;
+}
+
+/* PLL1 from HSE: 400 MHz system clock and 100 MHz kernel clock, integer factors */
+static int test_pll1_sysclk(void)
+{
+	RCC_PLLTargetTypeDef target = {
+		.PLLSource = RCC_PLLSOURCE_HSE,
+		.InputFreq = HSE_FREQ,
+		.PLLx = 1U,
+		.PLLPFreq = 400000000U,
+		.PLLQFreq = 100000000U,
+	};
+	RCC_PLLInitTypeDef pll;
+
+	memset(&pll, 0, sizeof(pll));
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_OK);
+	EXPECT(check_config(&target, &pll) == 0);
+	EXPECT(output_freq(&target, &pll, pll.PLLP) == 400000000U);
+	EXPECT(output_freq(&target, &pll, pll.PLLQ) == 100000000U);
+	/* Highest VCO input: 12.5 MHz, the 25 MHz HSE is above the VCO input range */
+	EXPECT((pll.PLLM == 2U) && (pll.PLLN == 64U) && (pll.PLLP == 2U) && (pll.PLLQ == 8U));
+	EXPECT((pll.PLLRGE == RCC_PLL1VCIRANGE_3) && (pll.PLLVCOSEL == RCC_PLL1VCOWIDE));
+	return 0;
+}
+
+/*
+ * PLL3 from HSE for the SAI: 49.152 MHz (48 kHz x 1024) is not a rational
+ * multiple of 25 MHz reachable with integer factors, the fractional factor
+ * gets within 50 Hz (1 ppm).
+ */
+static int test_pll3_audio(void)
+{
+	RCC_PLLTargetTypeDef target = {
+		.PLLSource = RCC_PLLSOURCE_HSE,
+		.InputFreq = HSE_FREQ,
+		.PLLx = 3U,
+		.Fractional = 1U,
+		.PLLPFreq = 49152000U,
+		.PLLPTolerance = 50U,
+	};
+	RCC_PLLInitTypeDef pll;
+	uint32_t freq;
+
+	memset(&pll, 0, sizeof(pll));
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_OK);
+	EXPECT(check_config(&target, &pll) == 0);
+	EXPECT(pll.PLLFRACN != 0U);
+	freq = output_freq(&target, &pll, pll.PLLP);
+	printf("pll_solve.audio: M=%u N=%u FRACN=%u P=%u, %u Hz for 49152000 Hz\n",
+	       (unsigned int)pll.PLLM, (unsigned int)pll.PLLN, (unsigned int)pll.PLLFRACN,
+	       (unsigned int)pll.PLLP, (unsigned int)freq);
+
+	/* Integer factors only: far from 1 ppm, pPLLInit left unchanged */
+	target.Fractional = 0U;
+	memset(&pll, 0xA5, sizeof(pll));
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_ERROR);
+	EXPECT(pll.PLLM == 0xA5A5A5A5U);
+	return 0;
+}
+
+/* An exact integer solution is preferred to a fractional one of equal error */
+static int test_integer_preferred(void)
+{
+	RCC_PLLTargetTypeDef target = {
+		.PLLSource = RCC_PLLSOURCE_HSE,
+		.InputFreq = HSE_FREQ,
+		.PLLx = 2U,
+		.Fractional = 1U,
+		.PLLRFreq = 200000000U,
+	};
+	RCC_PLLInitTypeDef pll;
+
+	memset(&pll, 0, sizeof(pll));
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_OK);
+	EXPECT(check_config(&target, &pll) == 0);
+	EXPECT(pll.PLLFRACN == 0U);
+	EXPECT(output_freq(&target, &pll, pll.PLLR) == 200000000U);
+	return 0;
+}
+
+static int test_errors(void)
+{
+	RCC_PLLTargetTypeDef target = {
+		.PLLSource = RCC_PLLSOURCE_HSE,
+		.InputFreq = HSE_FREQ,
+		.PLLx = 1U,
+		.Fractional = 1U,
+		.PLLPFreq = 1000000000U,
+		.PLLPTolerance = 1000000U,
+	};
+	RCC_PLLInitTypeDef pll;
+
+	memset(&pll, 0xA5, sizeof(pll));
+	/* Above the highest VCO frequency */
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_ERROR);
+	/* Below the lowest output frequency */
+	target.PLLPFreq = 1000000U;
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_ERROR);
+	/* Entry clock below the lowest VCO input frequency */
+	target.PLLPFreq = 100000000U;
+	target.InputFreq = 500000U;
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_ERROR);
+	/* No output used */
+	target.InputFreq = HSE_FREQ;
+	target.PLLPFreq = 0U;
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_ERROR);
+	/* No PLL4 */
+	target.PLLPFreq = 100000000U;
+	target.PLLx = 4U;
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_ERROR);
+	target.PLLx = 0U;
+	EXPECT(HAL_RCCEx_PLLSolve(&target, &pll) == HAL_ERROR);
+	EXPECT(HAL_RCCEx_PLLSolve(NULL, &pll) == HAL_ERROR);
+	target.PLLx = 1U;
+	EXPECT(HAL_RCCEx_PLLSolve(&target, NULL) == HAL_ERROR);
+	EXPECT(pll.PLLM == 0xA5A5A5A5U);
+	return 0;
+}
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} tests[] = {
+	{ "pll1_sysclk", test_pll1_sysclk },
+	{ "pll3_audio", test_pll3_audio },
+	{ "integer_preferred", test_integer_preferred },
+	{ "errors", test_errors },
+};
+
+int main(void)
+{
+	int failed = 0;
+
+	for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		int ok = (tests[i].run() == 0);
+
+		printf("pll_solve.%-24s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+		failed |= !ok;
+	}
+	return failed;
+}
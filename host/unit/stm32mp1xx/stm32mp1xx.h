@@ -0,0 +1,78 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake STM32MP1 device header of the unit tests, see README.rst.
+ *
+ * Declares only the registers the extended modules under test use. The
+ * peripheral instances are register blocks of the test, in host memory below
+ * 4 GB (the host build is not PIE). The barriers are host fences.
+ */
+
+#ifndef STM32MP1XX_H
+#define STM32MP1XX_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STM32MP1
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __IM    volatile const
+#define __OM    volatile
+#define __IOM   volatile
+
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE      static inline
+#endif
+
+#define SET_BIT(REG, BIT)     ((REG) |= (BIT))
+#define CLEAR_BIT(REG, BIT)   ((REG) &= ~(BIT))
+#define READ_BIT(REG, BIT)    ((REG) & (BIT))
+#define CLEAR_REG(REG)        ((REG) = (0x0))
+#define WRITE_REG(REG, VAL)   ((REG) = (VAL))
+#define READ_REG(REG)         ((REG))
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  WRITE_REG((REG), (((READ_REG(REG)) & (~(CLEARMASK))) | (SETMASK)))
+
+/* CPU state ---------------------------------------------------------------------*/
+
+static inline void __DMB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __DSB(void)
+{
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+/* IPCC --------------------------------------------------------------------------*/
+
+typedef struct {
+	__IO uint32_t C1CR;
+	__IO uint32_t C1MR;
+	__IO uint32_t C1SCR;
+	__IO uint32_t C1TOC2SR;
+	__IO uint32_t C2CR;
+	__IO uint32_t C2MR;
+	__IO uint32_t C2SCR;
+	__IO uint32_t C2TOC1SR;
+} IPCC_TypeDef;
+
+/* Register block of the IPCC, defined by the test */
+extern IPCC_TypeDef unit_ipcc;
+#define IPCC                                 (&unit_ipcc)
+
+#define IPCC_CHANNEL_NUMBER                  6U
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32MP1XX_H */
@@ -0,0 +1,13 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32MP1 IPCC message channels (IPCCEx): the STM32WL test,
+ * built against the STM32MP1 copy of the module and the fake headers of this
+ * directory.
+ */
+
+#define UNIT_IPCC_EX_SOURCE  "stm32mp1xx_hal_ipcc_ex.c"
+
+#include "../stm32wlxx/test_ipcc_channel.c"
@@ -0,0 +1,31 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Fake STM32WL HAL header of the unit tests, see README.rst.
+ *
+ * Includes the HAL definitions and the headers of the modules under test, not
+ * the HAL configuration. The HAL functions the modules call are implemented
+ * by the tests.
+ */
+
+#ifndef STM32WLXX_HAL_H
+#define STM32WLXX_HAL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_IPCC_MODULE_ENABLED
+
+#define assert_param(expr) ((void)0U)
+
+#include "stm32wlxx_hal_def.h"
+#include "stm32wlxx_hal_ipcc.h"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32WLXX_HAL_H */
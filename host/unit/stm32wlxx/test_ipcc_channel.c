@@ -0,0 +1,355 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Unit test of the STM32WL IPCC message channels (IPCCEx), with one thread
+ * per CPU.
+ *
+ * The IPCC simulator keeps, for each CPU, the occupied flag of the channel
+ * in the direction of the other CPU:
+ *
+ * - HAL_IPCC_NotifyCPU(), direction Tx, sets the flag of the CPU and raises
+ *   the Rx occupied interrupt of the other one; direction Rx clears the flag
+ *   of the other CPU and raises its Tx free interrupt.
+ * - HAL_IPCC_GetChannelStatus() returns the flag of the CPU in direction Tx
+ *   and the one of the other CPU in direction Rx.
+ *
+ * The interrupts are sticky flags the thread of the CPU waits for, with a
+ * timeout: a lost notification fails the test. A CPU only processes its Rx
+ * ring after an Rx occupied interrupt.
+ *
+ * The duplex test reports the message rate of the two threads and the
+ * number of messages per notification. The STM32MP1 test builds this file
+ * against the STM32MP1 copy of the module.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef UNIT_IPCC_EX_SOURCE
+#define UNIT_IPCC_EX_SOURCE  "stm32wlxx_hal_ipcc_ex.c"
+#endif
+
+#include UNIT_IPCC_EX_SOURCE
+
+IPCC_TypeDef unit_ipcc;
+
+/* IPCC simulator ----------------------------------------------------------------*/
+
+#define SIM_CPUS     2U
+#define SIM_IRQ_RX   0x1U  /* Rx occupied */
+#define SIM_IRQ_TX   0x2U  /* Tx free */
+
+static _Thread_local uint32_t sim_cpu;
+static uint32_t sim_occupied[SIM_CPUS];
+static uint32_t sim_irq[SIM_CPUS];
+static pthread_mutex_t sim_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t sim_cond = PTHREAD_COND_INITIALIZER;
+
+IPCC_CHANNELStatusTypeDef HAL_IPCC_GetChannelStatus(IPCC_HandleTypeDef const *const hipcc, uint32_t ChannelIndex,
+						    IPCC_CHANNELDirTypeDef ChannelDir)
+{
+	uint32_t cpu = (ChannelDir == IPCC_CHANNEL_DIR_TX) ? sim_cpu : (sim_cpu ^ 1U);
+
+	return (__atomic_load_n(&sim_occupied[cpu], __ATOMIC_SEQ_CST) != 0U) ?
+	       IPCC_CHANNEL_STATUS_OCCUPIED : IPCC_CHANNEL_STATUS_FREE;
+}
+
+HAL_StatusTypeDef HAL_IPCC_NotifyCPU(IPCC_HandleTypeDef const *const hipcc, uint32_t ChannelIndex,
+				     IPCC_CHANNELDirTypeDef ChannelDir)
+{
+	uint32_t peer = sim_cpu ^ 1U;
+
+	pthread_mutex_lock(&sim_lock);
+	if (ChannelDir == IPCC_CHANNEL_DIR_TX) {
+		__atomic_store_n(&sim_occupied[sim_cpu], 1U, __ATOMIC_SEQ_CST);
+		sim_irq[peer] |= SIM_IRQ_RX;
+	} else if (__atomic_load_n(&sim_occupied[peer], __ATOMIC_SEQ_CST) != 0U) {
+		__atomic_store_n(&sim_occupied[peer], 0U, __ATOMIC_SEQ_CST);
+		sim_irq[peer] |= SIM_IRQ_TX;
+	}
+	pthread_cond_broadcast(&sim_cond);
+	pthread_mutex_unlock(&sim_lock);
+	return HAL_OK;
+}
+
+/* Take the interrupts of the CPU, waiting for one if @p wait, 0 on timeout */
+static uint32_t sim_take_irq(int wait)
+{
+	struct timespec deadline;
+	uint32_t irq;
+
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_sec += 5;
+
+	pthread_mutex_lock(&sim_lock);
+	while (wait && (sim_irq[sim_cpu] == 0U)) {
+		if (pthread_cond_timedwait(&sim_cond, &sim_lock, &deadline) != 0) {
+			break;
+		}
+	}
+	irq = sim_irq[sim_cpu];
+	sim_irq[sim_cpu] = 0U;
+	pthread_mutex_unlock(&sim_lock);
+	return irq;
+}
+
+static void sim_reset(void)
+{
+	memset(sim_occupied, 0, sizeof(sim_occupied));
+	memset(sim_irq, 0, sizeof(sim_irq));
+}
+
+/* Channels ------------------------------------------------------------------------*/
+
+#define EXPECT(cond)                                                          \
+	do {                                                                  \
+		if (!(cond)) {                                                \
+			fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond); \
+			return -1;                                            \
+		}                                                             \
+	} while (0)
+
+#define SLOT_SIZE     32U
+#define PAYLOAD_MAX   (SLOT_SIZE - IPCCEX_SLOT_HEADER)
+#define SLOTS         8U
+#define MESSAGES      200000U
+#define BATCH         3U
+#define BUDGET        5U
+
+/* Memory shared by the CPUs, one area per direction */
+static uint32_t shared[SIM_CPUS][__HAL_IPCCEX_RING_SIZE(SLOT_SIZE, SLOTS) / 4U];
+
+static IPCC_HandleTypeDef hipcc;
+
+struct cpu {
+	IPCCEx_ChannelTypeDef hch;
+	uint32_t next_seq;
+	uint32_t received;
+	int rx_error;
+	int result;
+};
+
+static struct cpu cpus[SIM_CPUS];
+
+/* Message: sequence number, then bytes derived from it and the sender */
+static uint32_t message_length(uint32_t seq)
+{
+	return 4U + (seq % (PAYLOAD_MAX - 3U));
+}
+
+static void message_fill(uint8_t *data, uint32_t cpu, uint32_t seq)
+{
+	uint32_t length = message_length(seq);
+
+	memcpy(data, &seq, sizeof(seq));
+	for (uint32_t i = 4U; i < length; i++) {
+		data[i] = (uint8_t)((seq * 13U) + (i * 5U) + cpu);
+	}
+}
+
+static void rx_callback(IPCCEx_ChannelTypeDef *hch, const uint8_t *pData, uint32_t Length)
+{
+	struct cpu *c = &cpus[sim_cpu];
+	uint8_t expected[PAYLOAD_MAX];
+
+	/* In order, from the other CPU */
+	message_fill(expected, sim_cpu ^ 1U, c->next_seq);
+	if ((Length != message_length(c->next_seq)) || (memcmp(pData, expected, Length) != 0)) {
+		c->rx_error = 1;
+	}
+	c->next_seq++;
+	c->received++;
+}
+
+static int channels_init(void)
+{
+	sim_reset();
+	/* CPU0 resets the shared areas before CPU1 initializes its channel */
+	for (uint32_t cpu = 0U; cpu < SIM_CPUS; cpu++) {
+		memset(&cpus[cpu], 0, sizeof(cpus[cpu]));
+		EXPECT(HAL_IPCCEx_ChannelInit(&cpus[cpu].hch, &hipcc, IPCC_CHANNEL_1, shared[cpu],
+					      shared[cpu ^ 1U], SLOT_SIZE, SLOTS, rx_callback) == HAL_OK);
+		if (cpu == 0U) {
+			EXPECT(HAL_IPCCEx_ChannelReset(&cpus[0].hch) == HAL_OK);
+		}
+	}
+	return 0;
+}
+
+/* CPU: sends its messages by batches while processing the messages received */
+static int cpu_run(void)
+{
+	struct cpu *c = &cpus[sim_cpu];
+	uint8_t message[PAYLOAD_MAX];
+	uint32_t sent = 0U;
+	int rx_more = 0;
+
+	while ((sent < MESSAGES) || (c->received < MESSAGES)) {
+		uint32_t irq;
+		int blocked = 0;
+
+		for (uint32_t i = 0U; (i < BATCH) && (sent < MESSAGES); i++) {
+			HAL_StatusTypeDef status;
+
+			message_fill(message, sim_cpu, sent);
+			status = HAL_IPCCEx_ChannelWrite(&c->hch, message, message_length(sent));
+			if (status == HAL_BUSY) {
+				blocked = 1;
+				break;
+			}
+			EXPECT(status == HAL_OK);
+			sent++;
+		}
+		EXPECT(HAL_IPCCEx_ChannelFlush(&c->hch) == HAL_OK);
+
+		/* Wait when there is nothing else to do */
+		irq = sim_take_irq(!rx_more && (blocked || (sent == MESSAGES)));
+		EXPECT((irq != 0U) || rx_more || (!blocked && (sent < MESSAGES)));
+		if (((irq & SIM_IRQ_RX) != 0U) || rx_more) {
+			rx_more = (HAL_IPCCEx_ChannelProcess(&c->hch, BUDGET) == BUDGET);
+		}
+		EXPECT(c->rx_error == 0);
+	}
+	return 0;
+}
+
+static void *cpu_thread(void *arg)
+{
+	sim_cpu = (uint32_t)(uintptr_t)arg;
+	cpus[sim_cpu].result = cpu_run();
+	return NULL;
+}
+
+static int test_init_errors(void)
+{
+	IPCCEx_ChannelTypeDef hch;
+
+	EXPECT(HAL_IPCCEx_ChannelInit(&hch, &hipcc, IPCC_CHANNEL_NUMBER, shared[0], shared[1], SLOT_SIZE,
+				      SLOTS, rx_callback) == HAL_ERROR);
+	EXPECT(HAL_IPCCEx_ChannelInit(&hch, &hipcc, IPCC_CHANNEL_1, shared[0], shared[0], SLOT_SIZE,
+				      SLOTS, rx_callback) == HAL_ERROR);
+	EXPECT(HAL_IPCCEx_ChannelInit(&hch, &hipcc, IPCC_CHANNEL_1, shared[0], shared[1], 30U,
+				      SLOTS, rx_callback) == HAL_ERROR);
+	EXPECT(HAL_IPCCEx_ChannelInit(&hch, &hipcc, IPCC_CHANNEL_1, shared[0], shared[1], SLOT_SIZE,
+				      6U, rx_callback) == HAL_ERROR);
+	EXPECT(HAL_IPCCEx_ChannelInit(&hch, &hipcc, IPCC_CHANNEL_1, shared[0], shared[1], SLOT_SIZE,
+				      SLOTS, NULL) == HAL_ERROR);
+	return 0;
+}
+
+/* Notification suppression and credits, both CPUs on one thread */
+static int test_suppression_credits(void)
+{
+	struct cpu *c0 = &cpus[0];
+	struct cpu *c1 = &cpus[1];
+	uint8_t message[PAYLOAD_MAX];
+
+	EXPECT(channels_init() == 0);
+
+	/* The first message notifies, the next ones find CPU1 busy */
+	sim_cpu = 0U;
+	for (uint32_t seq = 0U; seq < 3U; seq++) {
+		message_fill(message, 0U, seq);
+		EXPECT(HAL_IPCCEx_ChannelSend(&c0->hch, message, message_length(seq)) == HAL_OK);
+	}
+	EXPECT(c0->hch.Stats.Notifications == 1U);
+	EXPECT(c0->hch.Stats.Suppressed == 2U);
+
+	/* One batch for the three messages, then CPU1 clears the flag */
+	sim_cpu = 1U;
+	EXPECT(sim_take_irq(0) == SIM_IRQ_RX);
+	EXPECT(HAL_IPCCEx_ChannelProcess(&c1->hch, SLOTS) == 3U);
+	EXPECT((c1->received == 3U) && (c1->rx_error == 0));
+	EXPECT(c1->hch.Stats.Batches == 1U);
+	sim_cpu = 0U;
+	EXPECT(sim_take_irq(0) == SIM_IRQ_TX);
+	EXPECT(HAL_IPCC_GetChannelStatus(&hipcc, IPCC_CHANNEL_1, IPCC_CHANNEL_DIR_TX) ==
+	       IPCC_CHANNEL_STATUS_FREE);
+
+	/* Credits: the ring fills up, the Tail of CPU1 is read only when exhausted */
+	for (uint32_t seq = 3U; seq < (3U + SLOTS); seq++) {
+		message_fill(message, 0U, seq);
+		EXPECT(HAL_IPCCEx_ChannelWrite(&c0->hch, message, message_length(seq)) == HAL_OK);
+	}
+	EXPECT(HAL_IPCCEx_ChannelWrite(&c0->hch, message, 4U) == HAL_BUSY);
+	EXPECT(c0->hch.Stats.NoCredit == 1U);
+	EXPECT(c0->hch.Stats.CreditRefresh == 3U);
+	EXPECT(HAL_IPCCEx_ChannelFlush(&c0->hch) == HAL_OK);
+	EXPECT(c0->hch.Stats.Notifications == 2U);
+
+	/* A budget leaves the flag set: the messages are not notified again */
+	sim_cpu = 1U;
+	EXPECT(sim_take_irq(0) == SIM_IRQ_RX);
+	EXPECT(HAL_IPCCEx_ChannelProcess(&c1->hch, 5U) == 5U);
+	sim_cpu = 0U;
+	EXPECT(HAL_IPCC_GetChannelStatus(&hipcc, IPCC_CHANNEL_1, IPCC_CHANNEL_DIR_TX) ==
+	       IPCC_CHANNEL_STATUS_OCCUPIED);
+	EXPECT(HAL_IPCCEx_ChannelGetCredits(&c0->hch) == 5U);
+	sim_cpu = 1U;
+	EXPECT(HAL_IPCCEx_ChannelProcess(&c1->hch, SLOTS) == (SLOTS - 5U));
+	EXPECT((c1->received == (3U + SLOTS)) && (c1->rx_error == 0));
+	return 0;
+}
+
+/* Both CPUs sending and receiving at once, on their own threads */
+static int test_duplex(void)
+{
+	pthread_t threads[SIM_CPUS];
+	struct timespec begin;
+	struct timespec end;
+	uint32_t notifications = 0U;
+	double seconds;
+
+	EXPECT(channels_init() == 0);
+	clock_gettime(CLOCK_MONOTONIC, &begin);
+	for (uint32_t cpu = 0U; cpu < SIM_CPUS; cpu++) {
+		EXPECT(pthread_create(&threads[cpu], NULL, cpu_thread, (void *)(uintptr_t)cpu) == 0);
+	}
+	for (uint32_t cpu = 0U; cpu < SIM_CPUS; cpu++) {
+		pthread_join(threads[cpu], NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	for (uint32_t cpu = 0U; cpu < SIM_CPUS; cpu++) {
+		IPCCEx_ChannelStatsTypeDef *stats = &cpus[cpu].hch.Stats;
+
+		EXPECT(cpus[cpu].result == 0);
+		EXPECT(cpus[cpu].received == MESSAGES);
+		EXPECT(stats->TxMessages == MESSAGES);
+		EXPECT(stats->RxMessages == MESSAGES);
+		/* Flushes on a busy peer are not notified */
+		EXPECT(stats->Notifications < MESSAGES);
+		notifications += stats->Notifications;
+	}
+
+	seconds = (double)(end.tv_sec - begin.tv_sec) + ((double)(end.tv_nsec - begin.tv_nsec) / 1e9);
+	printf("ipcc_channel.rate: %.0f messages/s each way, %.2f messages per notification (host threads)\n",
+	       MESSAGES / seconds, (SIM_CPUS * (double)MESSAGES) / notifications);
+	return 0;
+}
+
+static const struct {
+	const char *name;
+	int (*run)(void);
+} tests[] = {
+	{ "init_errors", test_init_errors },
+	{ "suppression_credits", test_suppression_credits },
+	{ "duplex", test_duplex },
+};
+
+int main(void)
+{
+	int failed = 0;
+
+	for (size_t i = 0U; i < (sizeof(tests) / sizeof(tests[0])); i++) {
+		int ok = (tests[i].run() == 0);
+
+		printf("ipcc_channel.%-21s %s\n", tests[i].name, ok ? "ok" : "FAILED");
+		failed |= !ok;
+	}
+	return failed;
+}
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+Generate the generic STM32Cube LL headers.
+
+Two kinds of headers are written to the ``common_ll/include`` directory:
+
+* ``stm32_ll_foo.h``: includes the ``stm32yyxx_ll_foo.h`` LL header of the
+  series the application is built for, selected by a ``CONFIG_SOC_SERIES_*``
+  ladder.
+* ``stm32yyxx_ll.h``: includes all the LL headers of one series. It is the
+  header precompiled by the ``STM32CUBE_LL_PCH`` build option: the generic
+  headers included afterwards find their series header already included::
+
+    genllheaders.py [-p stm32cube] [-o stm32cube/common_ll/include]
+
+The LL USB headers are skipped: they are part of the HAL PCD/HCD drivers, not
+of the LL API.
+
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import argparse
+import pathlib
+import re
+import sys
+
+SCRIPT_DIR = pathlib.Path(__file__).absolute().parent
+REPO_ROOT = SCRIPT_DIR / ".." / ".."
+
+# stm32g4xx_ll_usart.h: series stm32g4xx, module usart
+LL_HEADER_RE = re.compile(r"^(?P<series>stm32[a-z0-9]+xx)_ll_(?P<module>[a-z0-9]+)\.h$")
+
+# LL headers which are not part of the LL API
+SKIPPED_MODULES = ("usb",)
+
+HEADER = """/*
+ * NOTE: Autogenerated file using genllheaders.py
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+"""
+
+
+def series_config(series):
+    """Return the Kconfig symbol of a series: stm32g4xx -> CONFIG_SOC_SERIES_STM32G4X."""
+    return f"CONFIG_SOC_SERIES_{series[:-2].upper()}X"
+
+
+def ladder(includes):
+    """Return the #if ladder including one header per series."""
+    lines = []
+    for i, (series, include) in enumerate(includes):
+        directive = "#if" if i == 0 else "#elif"
+        lines.append(f"{directive} defined({series_config(series)})")
+        lines.append(f"#include <{include}>")
+    lines.append("#endif")
+    return "\n".join(lines) + "\n"
+
+
+def generic_header(includes):
+    """Return a generic header dispatching to the series headers."""
+    return HEADER + "\n#include <autoconf.h>\n\n" + ladder(includes)
+
+
+def series_header(series, modules):
+    """Return the aggregate header of a series."""
+    guard = f"{series.upper()}_LL_H"
+    lines = [HEADER, f"#ifndef {guard}", f"#define {guard}", ""]
+    lines += [f"#include <{series}_ll_{module}.h>" for module in modules]
+    lines += ["", f"#endif /* {guard} */", ""]
+    return "\n".join(lines)
+
+
+def ll_modules(hal_path):
+    """Return the LL modules of each series, sorted."""
+    modules = {}
+    for entry in sorted(hal_path.iterdir()):
+        include = entry / "drivers" / "include"
+        if not entry.name.startswith("stm32") or not include.is_dir():
+            continue
+        for header in include.iterdir():
+            match = LL_HEADER_RE.match(header.name)
+            if not match or match.group("series") != entry.name:
+                continue
+            if match.group("module") in SKIPPED_MODULES:
+                continue
+            modules.setdefault(entry.name, []).append(match.group("module"))
+    return {series: sorted(names) for series, names in sorted(modules.items())}
+
+
+def main(hal_path, output):
+    """Write the generic headers of the series found in hal_path to output."""
+    modules = ll_modules(hal_path)
+    output.mkdir(parents=True, exist_ok=True)
+
+    all_modules = sorted({module for names in modules.values() for module in names})
+    for module in all_modules:
+        includes = [
+            (series, f"{series}_ll_{module}.h")
+            for series, names in modules.items()
+            if module in names
+        ]
+        (output / f"stm32_ll_{module}.h").write_text(generic_header(includes))
+
+    for series, names in modules.items():
+        (output / f"{series}_ll.h").write_text(series_header(series, names))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument(
+        "-p",
+        "--hal",
+        type=pathlib.Path,
+        default=REPO_ROOT / "stm32cube",
+        help="STM32Cube directory (default stm32cube)",
+    )
+    parser.add_argument(
+        "-o",
+        "--output",
+        type=pathlib.Path,
+        default=REPO_ROOT / "stm32cube" / "common_ll" / "include",
+        help="output directory (default stm32cube/common_ll/include)",
+    )
+    args = parser.parse_args()
+
+    main(args.hal, args.output)
+    sys.exit(0)
@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""
+Decode a HAL trace memory dump into a Perfetto trace or folded stacks.
+
+The HAL records the entry and exit of its instrumented functions in the
+``HAL_Trace`` structure when ``USE_HAL_TRACE`` is 1U. Once recording is stopped
+with ``HAL_TraceStop()``, dump the structure with a debugger, for example with
+GDB::
+
+    (gdb) dump binary memory trace.bin &HAL_Trace (char *)&HAL_Trace + sizeof(HAL_Trace)
+
+then decode it::
+
+    hal_trace.py trace.bin --format perfetto -o trace.json
+    hal_trace.py trace.bin --format folded | flamegraph.pl > trace.svg
+
+The Perfetto output is a JSON trace, opened with https://ui.perfetto.dev, with
+one track per execution context (thread mode and each exception number).
+The folded output gives the self time of each call stack in cycles.
+
+Function names are read from the ``HAL_TRACE_ID_*`` definitions of the series
+trace header given with ``--header``.
+
+Durations include the time spent in the handlers preempting a function.
+The records are in cycle counter order; the 32-bit counter is unwrapped
+assuming less than 2^32 cycles between two consecutive records. The exit
+records whose entry was overwritten in the ring are ignored, and the frames
+still open at the end of the dump are closed at the last record.
+"""
+
+import argparse
+import json
+import pathlib
+import re
+import struct
+import sys
+
+HAL_TRACE_MAGIC = 0x43525448
+HAL_TRACE_EVENT_ENTER = 0
+HAL_TRACE_EVENT_EXIT = 1
+
+HEADER_FORMAT = "<5I"
+RECORD_FORMAT = "<IIHBB"
+
+DEFAULT_HEADER = (
+    pathlib.Path(__file__).resolve().parent.parent
+    / "stm32cube/stm32g4xx/drivers/include/stm32g4xx_hal_trace.h"
+)
+
+EXCEPTION_NAMES = {
+    0: "Thread",
+    2: "NMI",
+    3: "HardFault",
+    4: "MemManage",
+    5: "BusFault",
+    6: "UsageFault",
+    11: "SVCall",
+    12: "DebugMon",
+    14: "PendSV",
+    15: "SysTick",
+}
+
+
+def parse_ids(header):
+    """Map the HAL_TRACE_ID_* values of a trace header to their names."""
+    ids = {}
+    pattern = re.compile(r"#define\s+HAL_TRACE_ID_(\w+)\s+(0x[0-9A-Fa-f]+)U")
+    for match in pattern.finditer(header.read_text()):
+        ids[int(match.group(2), 16)] = match.group(1)
+    return ids
+
+
+def context_name(context):
+    """Name of an execution context from its exception number."""
+    if context in EXCEPTION_NAMES:
+        return EXCEPTION_NAMES[context]
+    if context >= 16:
+        return f"IRQ{context - 16}"
+    return f"Exception{context}"
+
+
+def read_records(data):
+    """Return the core clock and the records of a dump, oldest first."""
+    offset = data.find(struct.pack("<I", HAL_TRACE_MAGIC))
+    if offset < 0:
+        sys.exit("HAL_Trace magic not found, was HAL_TraceInit() called?")
+
+    magic, depth, core_clock, _enable, index = struct.unpack_from(
+        HEADER_FORMAT, data, offset
+    )
+    assert magic == HAL_TRACE_MAGIC
+    base = offset + struct.calcsize(HEADER_FORMAT)
+    size = struct.calcsize(RECORD_FORMAT)
+    if len(data) < base + depth * size:
+        sys.exit(f"dump too short for {depth} records")
+
+    count = min(index, depth)
+    records = []
+    for position in range(index - count, index):
+        records.append(
+            struct.unpack_from(RECORD_FORMAT, data, base + (position % depth) * size)
+        )
+    return core_clock, records
+
+
+def build_frames(records, ids):
+    """Match the entry and exit records into frames, per context.
+
+    Returns a list of (context, stack, start, end, handle) with the times in
+    cycles from the first record.
+    """
+    frames = []
+    stacks = {}
+    wraps = 0
+    previous = None
+    origin = None
+
+    def close(context, until, end):
+        """Close the frames of a context down to index 'until'."""
+        stack = stacks[context]
+        while len(stack) > until:
+            name, start, handle = stack[-1]
+            frames.append(
+                (context, tuple(frame[0] for frame in stack), start, end, handle)
+            )
+            stack.pop()
+
+    time = 0
+    for cycles, handle, func, event, context in records:
+        if previous is not None and cycles < previous:
+            wraps += 1
+        previous = cycles
+        if origin is None:
+            origin = cycles
+        time = (wraps << 32) + cycles - origin
+        name = ids.get(func, f"0x{func:04X}")
+        stack = stacks.setdefault(context, [])
+
+        if event == HAL_TRACE_EVENT_ENTER:
+            stack.append((name, time, handle))
+        elif stack and stack[-1][0] == name and stack[-1][2] == handle:
+            close(context, len(stack) - 1, time)
+
+    for context in stacks:
+        close(context, 0, time)
+    return frames
+
+
+def write_perfetto(frames, core_clock, output):
+    """Write the frames as Chrome JSON trace events."""
+    scale = 1e6 / core_clock if core_clock else 1.0
+    events = []
+    for context in sorted({frame[0] for frame in frames}):
+        events.append(
+            {
+                "name": "thread_name",
+                "ph": "M",
+                "pid": 1,
+                "tid": context,
+                "args": {"name": context_name(context)},
+            }
+        )
+    for context, stack, start, end, handle in sorted(frames, key=lambda f: f[2]):
+        events.append(
+            {
+                "name": stack[-1],
+                "ph": "X",
+                "pid": 1,
+                "tid": context,
+                "ts": start * scale,
+                "dur": (end - start) * scale,
+                "args": {"handle": f"0x{handle:08X}", "cycles": end - start},
+            }
+        )
+    json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, output, indent=1)
+    output.write("\n")
+
+
+def write_folded(frames, output):
+    """Write the self time of each call stack, in cycles."""
+    totals = {}
+    children = {}
+    for context, stack, start, end, _handle in frames:
+        path = (context_name(context),) + stack
+        totals[path] = totals.get(path, 0) + (end - start)
+        if len(stack) > 1:
+            parent = path[:-1]
+            children[parent] = children.get(parent, 0) + (end - start)
+    for path in sorted(totals):
+        self_time = totals[path] - children.get(path, 0)
+        if self_time > 0:
+            output.write(f"{';'.join(path)} {self_time}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("dump", type=pathlib.Path, help="binary dump of HAL_Trace")
+    parser.add_argument(
+        "--header",
+        type=pathlib.Path,
+        default=DEFAULT_HEADER,
+        help="series trace header defining the HAL_TRACE_ID_* values",
+    )
+    parser.add_argument(
+        "--format",
+        choices=("perfetto", "folded"),
+        default="perfetto",
+        help="output format",
+    )
+    parser.add_argument(
+        "-o", "--output", type=argparse.FileType("w"), default=sys.stdout
+    )
+    args = parser.parse_args()
+
+    core_clock, records = read_records(args.dump.read_bytes())
+    frames = build_frames(records, parse_ids(args.header))
+    if args.format == "perfetto":
+        write_perfetto(frames, core_clock, args.output)
+    else:
+        write_folded(frames, args.output)
+
+
+if __name__ == "__main__":
+    main()
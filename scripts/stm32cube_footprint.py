@@ -0,0 +1,222 @@
+#!/usr/bin/env python3
+"""
+Report the flash and RAM footprint of the STM32Cube HAL/LL from a link map.
+
+The input sections placed by the linker are read from a GNU ld map file, for
+example ``zephyr.map`` in the build directory, and summed per module (HAL I2C,
+LL USART...), per object file or per function::
+
+    stm32cube_footprint.py build/zephyr/zephyr.map
+    stm32cube_footprint.py build/zephyr/zephyr.map --by function --filter "HAL I2C"
+    stm32cube_footprint.py build/zephyr/zephyr.map --format json -o footprint.json
+
+The flash footprint counts the code, the constants and the initial values of
+the initialized data. The RAM footprint counts the initialized and the zeroed
+data. Sections removed by ``--gc-sections`` are not in the report, so the
+drivers must be built with ``-ffunction-sections -fdata-sections``, as Zephyr
+does, to get the footprint of each function.
+
+A ``_ex`` object is accounted to the module it extends. The objects which are
+not part of the STM32Cube drivers are ignored, unless ``--all`` is given.
+"""
+
+import argparse
+import collections
+import json
+import pathlib
+import re
+import sys
+
+# Input section of the map: name, address, size and object, the name being on
+# a line of its own when it is too long.
+PLACEMENT = r"0x(?P<addr>[0-9a-fA-F]+)\s+0x(?P<size>[0-9a-fA-F]+)\s+(?P<obj>.+)"
+SECTION_RE = re.compile(r"^ (?P<name>[.\w*]\S*)(?:\s+" + PLACEMENT + r")?$")
+CONTINUATION_RE = re.compile(r"^\s+" + PLACEMENT + r"$")
+
+# Object name, from "lib.a(obj)" or a path.
+ARCHIVE_MEMBER_RE = re.compile(r"\((?P<member>[^()]+)\)$")
+
+# Driver objects: stm32g0xx_hal_i2c_ex, stm32g0xx_ll_usart, stm32g0xx_hal...
+DRIVER_RE = re.compile(r"^stm32\w+?xx_(?P<layer>hal|ll)(?:_(?P<module>\w+?))?(?:_ex)?$")
+SYSTEM_RE = re.compile(r"^system_stm32\w+xx$")
+
+FLASH_PREFIXES = (".text", ".rodata", ".ARM.extab", ".ARM.exidx")
+DATA_PREFIXES = (".data",)
+BSS_PREFIXES = (".bss", "COMMON", ".noinit")
+
+
+def object_name(path):
+    """Return the name of an object without its directory and extensions."""
+    match = ARCHIVE_MEMBER_RE.search(path)
+    name = match.group("member") if match else pathlib.PurePath(path).name
+    for suffix in (".obj", ".o", ".c"):
+        if name.endswith(suffix):
+            name = name[: -len(suffix)]
+    return name
+
+
+def module_name(obj):
+    """Return the module of a driver object, None for the other objects."""
+    match = DRIVER_RE.match(obj)
+    if match:
+        layer = match.group("layer").upper()
+        module = match.group("module")
+        return f"{layer} {module.upper()}" if module else layer
+    if SYSTEM_RE.match(obj):
+        return "SYSTEM"
+    return None
+
+
+def section_kind(name):
+    """Return "flash", "data" or "bss" for a section counted, else None."""
+    if name.startswith(FLASH_PREFIXES):
+        return "flash"
+    if name.startswith(DATA_PREFIXES):
+        return "data"
+    if name.startswith(BSS_PREFIXES):
+        return "bss"
+    return None
+
+
+def symbol_name(name):
+    """Return the function or variable of a section named after it."""
+    for prefix in (".ARM.exidx", ".ARM.extab"):
+        if name.startswith(prefix):
+            name = name[len(prefix):]
+    for prefix in (".text.", ".rodata.", ".data.", ".bss.", ".noinit."):
+        if name.startswith(prefix):
+            return name[len(prefix):]
+    return name
+
+
+def parse_map(lines):
+    """Yield (section, size, object) for the input sections placed."""
+    lines = iter(lines)
+
+    # The input sections discarded come first, in the same format.
+    for line in lines:
+        if line.startswith("Linker script and memory map"):
+            break
+
+    pending = None
+    for line in lines:
+        line = line.rstrip("\n")
+        if pending is not None:
+            match = CONTINUATION_RE.match(line)
+            if match:
+                yield pending, int(match.group("size"), 16), match.group("obj").strip()
+                pending = None
+                continue
+            pending = None
+
+        match = SECTION_RE.match(line)
+        if not match:
+            continue
+        if match.group("size") is None:
+            pending = match.group("name")
+        else:
+            yield match.group("name"), int(match.group("size"), 16), match.group("obj").strip()
+
+
+def footprint(sections, by, include_all):
+    """Sum the flash and RAM sizes per module, object or function."""
+    totals = collections.defaultdict(lambda: {"flash": 0, "ram": 0})
+
+    for name, size, path in sections:
+        kind = section_kind(name)
+        if kind is None or size == 0:
+            continue
+
+        obj = object_name(path)
+        module = module_name(obj)
+        if module is None:
+            if not include_all:
+                continue
+            module = obj
+
+        if by == "module":
+            key = module
+        elif by == "object":
+            key = obj
+        else:
+            key = f"{obj}:{symbol_name(name)}"
+
+        entry = totals[key]
+        entry["module"] = module
+        if kind in ("flash", "data"):
+            entry["flash"] += size
+        if kind in ("data", "bss"):
+            entry["ram"] += size
+
+    return totals
+
+
+def format_text(totals, by):
+    """Format the report as a table sorted by flash size."""
+    rows = sorted(totals.items(), key=lambda item: (-item[1]["flash"], -item[1]["ram"], item[0]))
+    width = max([len(by)] + [len(key) for key in totals])
+
+    lines = [f"{by.capitalize():<{width}}  {'Flash':>8}  {'RAM':>8}"]
+    for key, entry in rows:
+        lines.append(f"{key:<{width}}  {entry['flash']:>8}  {entry['ram']:>8}")
+    flash = sum(entry["flash"] for entry in totals.values())
+    ram = sum(entry["ram"] for entry in totals.values())
+    lines.append(f"{'Total':<{width}}  {flash:>8}  {ram:>8}")
+    return "\n".join(lines) + "\n"
+
+
+def format_json(totals, by):
+    """Format the report as JSON."""
+    report = {
+        "by": by,
+        "entries": {key: totals[key] for key in sorted(totals)},
+        "total": {
+            "flash": sum(entry["flash"] for entry in totals.values()),
+            "ram": sum(entry["ram"] for entry in totals.values()),
+        },
+    }
+    return json.dumps(report, indent=2) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter
+    )
+    parser.add_argument("map", type=pathlib.Path, help="GNU ld map file")
+    parser.add_argument(
+        "--by",
+        choices=("module", "object", "function"),
+        default="module",
+        help="accounting granularity (default module)",
+    )
+    parser.add_argument("--filter", help="only report the modules matching this regular expression")
+    parser.add_argument("--all", action="store_true", help="report all the objects of the link")
+    parser.add_argument("--format", choices=("text", "json"), default="text", help="output format")
+    parser.add_argument("-o", "--output", type=pathlib.Path, help="output file (default stdout)")
+    args = parser.parse_args()
+
+    if not args.map.exists():
+        print(f"{args.map} not found", file=sys.stderr)
+        return 1
+
+    with args.map.open(encoding="utf-8", errors="replace") as map_file:
+        totals = footprint(parse_map(map_file), args.by, args.all)
+
+    if args.filter:
+        pattern = re.compile(args.filter)
+        totals = {key: entry for key, entry in totals.items() if pattern.search(entry["module"])}
+
+    if args.format == "json":
+        report = format_json(totals, args.by)
+    else:
+        report = format_text(totals, args.by)
+
+    if args.output:
+        args.output.write_text(report)
+    else:
+        sys.stdout.write(report)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,12 @@
+/*
+ * NOTE: Autogenerated file using genllheaders.py
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STM32F0XX_LL_H
+#define STM32F0XX_LL_H
+
+#include <stm32f0xx_ll_tim.h>
+
+#endif /* STM32F0XX_LL_H */
@@ -0,0 +1,13 @@
+/*
+ * NOTE: Autogenerated file using genllheaders.py
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STM32F1XX_LL_H
+#define STM32F1XX_LL_H
+
+#include <stm32f1xx_ll_tim.h>
+#include <stm32f1xx_ll_usart.h>
+
+#endif /* STM32F1XX_LL_H */
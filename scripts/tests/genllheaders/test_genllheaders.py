@@ -0,0 +1,26 @@
+"""
+Tests for the genllheaders.py script.
+
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import pathlib
+import sys
+
+THIS_DIR = pathlib.Path(__file__).absolute().parent
+DATA_DIR = THIS_DIR / "data"
+
+sys.path.insert(0, str(THIS_DIR / ".." / ".." / "genllheaders"))
+
+from genllheaders import main  # noqa: E402
+
+EXPECTED = ("stm32_ll_tim.h", "stm32_ll_usart.h", "stm32f0xx_ll.h", "stm32f1xx_ll.h")
+
+
+def test_main(tmp_path):
+    """Check the generic and the aggregate headers generated."""
+    main(DATA_DIR / "stm32cube", tmp_path)
+
+    assert sorted(file.name for file in tmp_path.iterdir()) == sorted(EXPECTED)
+    for name in EXPECTED:
+        assert (tmp_path / name).read_text() == (DATA_DIR / name).read_text(), name
@@ -0,0 +1,134 @@
+"""
+Tests for the hal_trace.py script.
+
+data/hal_trace.bin is a dump of HAL_Trace captured on the STM32G4 host register
+model (host/), the drivers built with USE_HAL_TRACE=1U and HAL_TRACE_DEPTH=64U:
+five polling HAL_I2C_Mem_Write() wrap the ring, then HAL_Delay() runs while
+I2C1 sends 4 bytes in interrupt mode. The ring starts with two exits whose
+entries were overwritten.
+
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import json
+import pathlib
+import subprocess
+import sys
+
+THIS_DIR = pathlib.Path(__file__).absolute().parent
+DATA_DIR = THIS_DIR / "data"
+SCRIPT = THIS_DIR / ".." / ".." / "hal_trace.py"
+
+sys.path.insert(0, str(SCRIPT.parent))
+
+from hal_trace import (  # noqa: E402
+    DEFAULT_HEADER,
+    HAL_TRACE_EVENT_ENTER,
+    HAL_TRACE_EVENT_EXIT,
+    build_frames,
+    parse_ids,
+    read_records,
+)
+
+I2C_EV_CONTEXT = 16 + 31  # I2C1_EV_IRQn
+
+
+def load():
+    """Return the core clock, the records and the frames of the dump."""
+    core_clock, records = read_records((DATA_DIR / "hal_trace.bin").read_bytes())
+    return core_clock, records, build_frames(records, parse_ids(DEFAULT_HEADER))
+
+
+def test_records():
+    """Check the ring read back oldest first, in cycle counter order."""
+    core_clock, records, _frames = load()
+
+    assert core_clock == 16000000
+    assert len(records) == 64
+    assert [record[0] for record in records] == sorted(record[0] for record in records)
+    assert [record[3] for record in records[:2]] == [HAL_TRACE_EVENT_EXIT] * 2
+    assert records[-1][2:4] == (0x0101, HAL_TRACE_EVENT_EXIT)
+
+
+def test_frames():
+    """Check the orphan exits ignored and every entry paired with its exit."""
+    _core_clock, records, frames = load()
+    counts = {}
+    for context, stack, start, end, _handle in frames:
+        assert end >= start
+        counts[(context, stack)] = counts.get((context, stack), 0) + 1
+
+    assert len(frames) == sum(1 for record in records if record[3] == HAL_TRACE_EVENT_ENTER)
+    assert counts == {
+        (0, ("I2C_MEM_WRITE",)): 2,
+        (0, ("I2C_MEM_WRITE", "I2C_WAITONFLAGUNTILTIMEOUT")): 4,
+        (0, ("I2C_MEM_WRITE", "I2C_WAITONTXISFLAGUNTILTIMEOUT")): 17,
+        (0, ("I2C_MEM_WRITE", "I2C_WAITONSTOPFLAGUNTILTIMEOUT")): 2,
+        (0, ("HAL_DELAY",)): 1,
+        (I2C_EV_CONTEXT, ("I2C_EV_IRQHANDLER",)): 5,
+    }
+
+
+def test_preemption():
+    """Check the interrupt frames on their own track, inside HAL_Delay()."""
+    _core_clock, _records, frames = load()
+    delay = [frame for frame in frames if frame[1] == ("HAL_DELAY",)][0]
+
+    for context, _stack, start, end, _handle in frames:
+        if context == I2C_EV_CONTEXT:
+            assert delay[2] < start <= end < delay[3]
+
+
+def test_folded(tmp_path):
+    """Check the self times written by the command line add up to the frames."""
+    _core_clock, _records, frames = load()
+    output = tmp_path / "trace.folded"
+    subprocess.run(
+        [sys.executable, str(SCRIPT), str(DATA_DIR / "hal_trace.bin"), "--format", "folded",
+         "-o", str(output)],
+        check=True,
+    )
+    folded = dict(line.rsplit(" ", 1) for line in output.read_text().splitlines())
+
+    assert sorted(folded) == [
+        "IRQ31;I2C_EV_IRQHANDLER",
+        "Thread;HAL_DELAY",
+        "Thread;I2C_MEM_WRITE",
+        "Thread;I2C_MEM_WRITE;I2C_WAITONFLAGUNTILTIMEOUT",
+        "Thread;I2C_MEM_WRITE;I2C_WAITONSTOPFLAGUNTILTIMEOUT",
+        "Thread;I2C_MEM_WRITE;I2C_WAITONTXISFLAGUNTILTIMEOUT",
+    ]
+    assert sum(int(cycles) for cycles in folded.values()) == sum(
+        end - start for _context, stack, start, end, _handle in frames if len(stack) == 1
+    )
+
+
+def test_perfetto(tmp_path):
+    """Check the JSON trace written by the command line, in microseconds."""
+    _core_clock, _records, frames = load()
+    output = tmp_path / "trace.json"
+    subprocess.run(
+        [sys.executable, str(SCRIPT), str(DATA_DIR / "hal_trace.bin"), "-o", str(output)],
+        check=True,
+    )
+    events = json.loads(output.read_text())["traceEvents"]
+    names = {event["tid"]: event["args"]["name"] for event in events if event["ph"] == "M"}
+    slices = [event for event in events if event["ph"] == "X"]
+
+    assert names == {0: "Thread", I2C_EV_CONTEXT: "IRQ31"}
+    assert len(slices) == len(frames)
+    for event in slices:
+        assert event["dur"] == event["args"]["cycles"] / 16
+        assert event["args"]["handle"] in ("0x00000000", "0x00414700")
+
+
+def test_no_magic(tmp_path):
+    """Check that a dump without HAL_Trace is rejected."""
+    dump = tmp_path / "empty.bin"
+    dump.write_bytes(bytes(788))
+    result = subprocess.run(
+        [sys.executable, str(SCRIPT), str(dump)], capture_output=True, text=True
+    )
+
+    assert result.returncode != 0
+    assert "magic not found" in result.stderr
@@ -0,0 +1,70 @@
+"""
+Tests for the stm32cube_footprint.py script.
+
+SPDX-License-Identifier: Apache-2.0
+"""
+
+import json
+import pathlib
+import subprocess
+import sys
+
+THIS_DIR = pathlib.Path(__file__).absolute().parent
+DATA_DIR = THIS_DIR / "data"
+SCRIPT = THIS_DIR / ".." / ".." / "stm32cube_footprint.py"
+
+sys.path.insert(0, str(SCRIPT.parent))
+
+from stm32cube_footprint import footprint, parse_map  # noqa: E402
+
+
+def load(by, include_all=False):
+    """Return the footprint of the test map."""
+    with (DATA_DIR / "zephyr.map").open() as map_file:
+        return footprint(parse_map(map_file), by, include_all)
+
+
+def test_modules():
+    """Check the sums per module: discarded sections ignored, _ex folded in."""
+    totals = load("module")
+
+    assert dict(totals) == {
+        "HAL I2C": {"module": "HAL I2C", "flash": 0x80 + 0x30, "ram": 0},
+        "HAL UART": {"module": "HAL UART", "flash": 0x60 + 0x120 + 0x18, "ram": 0},
+        "LL USART": {"module": "LL USART", "flash": 0x40, "ram": 0},
+        "SYSTEM": {"module": "SYSTEM", "flash": 0x10 + 0x10 + 0x4, "ram": 0x4},
+        "HAL": {"module": "HAL", "flash": 0, "ram": 0x4 + 0x4},
+    }
+
+
+def test_functions():
+    """Check the sums per function, names wrapped on their own line included."""
+    totals = load("function")
+
+    assert totals["stm32g0xx_hal_uart:UART_SetConfig"]["flash"] == 0x120
+    assert totals["stm32g0xx_hal_i2c_ex:HAL_I2CEx_ConfigAnalogFilter"]["module"] == "HAL I2C"
+    assert totals["stm32g0xx_hal:COMMON"]["ram"] == 0x4
+    assert "stm32g0xx_hal_i2c:HAL_I2C_DeInit" not in totals
+
+
+def test_all_objects():
+    """Check that --all accounts the application objects too."""
+    totals = load("object", include_all=True)
+
+    assert totals["main"] == {"module": "main", "flash": 0x20 + 0x4, "ram": 0x4 + 0x8}
+    assert "main" not in load("object")
+
+
+def test_json_report(tmp_path):
+    """Check the JSON report written by the command line."""
+    output = tmp_path / "footprint.json"
+    subprocess.run(
+        [sys.executable, str(SCRIPT), str(DATA_DIR / "zephyr.map"), "--filter", "^HAL",
+         "--format", "json", "-o", str(output)],
+        check=True,
+    )
+    report = json.loads(output.read_text())
+
+    assert report["by"] == "module"
+    assert sorted(report["entries"]) == ["HAL", "HAL I2C", "HAL UART"]
+    assert report["total"] == {"flash": 0xB0 + 0x198, "ram": 0x8}
@@ -0,0 +1,37 @@
+/*
+ * NOTE: Autogenerated file using genllheaders.py
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STM32G0XX_LL_H
+#define STM32G0XX_LL_H
+
+#include <stm32g0xx_ll_adc.h>
+#include <stm32g0xx_ll_bus.h>
+#include <stm32g0xx_ll_comp.h>
+#include <stm32g0xx_ll_cortex.h>
+#include <stm32g0xx_ll_crc.h>
+#include <stm32g0xx_ll_crs.h>
+#include <stm32g0xx_ll_dac.h>
+#include <stm32g0xx_ll_dma.h>
+#include <stm32g0xx_ll_dmamux.h>
+#include <stm32g0xx_ll_exti.h>
+#include <stm32g0xx_ll_gpio.h>
+#include <stm32g0xx_ll_i2c.h>
+#include <stm32g0xx_ll_iwdg.h>
+#include <stm32g0xx_ll_lptim.h>
+#include <stm32g0xx_ll_lpuart.h>
+#include <stm32g0xx_ll_pwr.h>
+#include <stm32g0xx_ll_rcc.h>
+#include <stm32g0xx_ll_rng.h>
+#include <stm32g0xx_ll_rtc.h>
+#include <stm32g0xx_ll_spi.h>
+#include <stm32g0xx_ll_system.h>
+#include <stm32g0xx_ll_tim.h>
+#include <stm32g0xx_ll_ucpd.h>
+#include <stm32g0xx_ll_usart.h>
+#include <stm32g0xx_ll_utils.h>
+#include <stm32g0xx_ll_wwdg.h>
+
+#endif /* STM32G0XX_LL_H */
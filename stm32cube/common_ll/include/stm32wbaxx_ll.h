@@ -0,0 +1,36 @@
+/*
+ * NOTE: Autogenerated file using genllheaders.py
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STM32WBAXX_LL_H
+#define STM32WBAXX_LL_H
+
+#include <stm32wbaxx_ll_adc.h>
+#include <stm32wbaxx_ll_bus.h>
+#include <stm32wbaxx_ll_comp.h>
+#include <stm32wbaxx_ll_cortex.h>
+#include <stm32wbaxx_ll_crc.h>
+#include <stm32wbaxx_ll_dma.h>
+#include <stm32wbaxx_ll_exti.h>
+#include <stm32wbaxx_ll_gpio.h>
+#include <stm32wbaxx_ll_hsem.h>
+#include <stm32wbaxx_ll_i2c.h>
+#include <stm32wbaxx_ll_icache.h>
+#include <stm32wbaxx_ll_iwdg.h>
+#include <stm32wbaxx_ll_lptim.h>
+#include <stm32wbaxx_ll_lpuart.h>
+#include <stm32wbaxx_ll_pka.h>
+#include <stm32wbaxx_ll_pwr.h>
+#include <stm32wbaxx_ll_rcc.h>
+#include <stm32wbaxx_ll_rng.h>
+#include <stm32wbaxx_ll_rtc.h>
+#include <stm32wbaxx_ll_spi.h>
+#include <stm32wbaxx_ll_system.h>
+#include <stm32wbaxx_ll_tim.h>
+#include <stm32wbaxx_ll_usart.h>
+#include <stm32wbaxx_ll_utils.h>
+#include <stm32wbaxx_ll_wwdg.h>
+
+#endif /* STM32WBAXX_LL_H */
@@ -0,0 +1,38 @@
+/*
+ * NOTE: Autogenerated file using genllheaders.py
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STM32WBXX_LL_H
+#define STM32WBXX_LL_H
+
+#include <stm32wbxx_ll_adc.h>
+#include <stm32wbxx_ll_bus.h>
+#include <stm32wbxx_ll_comp.h>
+#include <stm32wbxx_ll_cortex.h>
+#include <stm32wbxx_ll_crc.h>
+#include <stm32wbxx_ll_crs.h>
+#include <stm32wbxx_ll_dma.h>
+#include <stm32wbxx_ll_dmamux.h>
+#include <stm32wbxx_ll_exti.h>
+#include <stm32wbxx_ll_gpio.h>
+#include <stm32wbxx_ll_hsem.h>
+#include <stm32wbxx_ll_i2c.h>
+#include <stm32wbxx_ll_ipcc.h>
+#include <stm32wbxx_ll_iwdg.h>
+#include <stm32wbxx_ll_lptim.h>
+#include <stm32wbxx_ll_lpuart.h>
+#include <stm32wbxx_ll_pka.h>
+#include <stm32wbxx_ll_pwr.h>
+#include <stm32wbxx_ll_rcc.h>
+#include <stm32wbxx_ll_rng.h>
+#include <stm32wbxx_ll_rtc.h>
+#include <stm32wbxx_ll_spi.h>
+#include <stm32wbxx_ll_system.h>
+#include <stm32wbxx_ll_tim.h>
+#include <stm32wbxx_ll_usart.h>
+#include <stm32wbxx_ll_utils.h>
+#include <stm32wbxx_ll_wwdg.h>
+
+#endif /* STM32WBXX_LL_H */
@@ -0,0 +1,38 @@
+/*
+ * NOTE: Autogenerated file using genllheaders.py
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef STM32WLXX_LL_H
+#define STM32WLXX_LL_H
+
+#include <stm32wlxx_ll_adc.h>
+#include <stm32wlxx_ll_bus.h>
+#include <stm32wlxx_ll_comp.h>
+#include <stm32wlxx_ll_cortex.h>
+#include <stm32wlxx_ll_crc.h>
+#include <stm32wlxx_ll_dac.h>
+#include <stm32wlxx_ll_dma.h>
+#include <stm32wlxx_ll_dmamux.h>
+#include <stm32wlxx_ll_exti.h>
+#include <stm32wlxx_ll_gpio.h>
+#include <stm32wlxx_ll_hsem.h>
+#include <stm32wlxx_ll_i2c.h>
+#include <stm32wlxx_ll_ipcc.h>
+#include <stm32wlxx_ll_iwdg.h>
+#include <stm32wlxx_ll_lptim.h>
+#include <stm32wlxx_ll_lpuart.h>
+#include <stm32wlxx_ll_pka.h>
+#include <stm32wlxx_ll_pwr.h>
+#include <stm32wlxx_ll_rcc.h>
+#include <stm32wlxx_ll_rng.h>
+#include <stm32wlxx_ll_rtc.h>
+#include <stm32wlxx_ll_spi.h>
+#include <stm32wlxx_ll_system.h>
+#include <stm32wlxx_ll_tim.h>
+#include <stm32wlxx_ll_usart.h>
+#include <stm32wlxx_ll_utils.h>
+#include <stm32wlxx_ll_wwdg.h>
+
+#endif /* STM32WLXX_LL_H */
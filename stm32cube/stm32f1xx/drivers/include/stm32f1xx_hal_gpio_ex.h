@@ -35,6 +35,59 @@ extern "C" {
   * @{
   */
 /* Exported types ------------------------------------------------------------*/
+
+/** @defgroup GPIOEx_Exported_Types GPIOEx Exported Types
+  * @{
+  */
+
+#if !defined(GPIOEX_GROUP_MAX_BITS)
+#define GPIOEX_GROUP_MAX_BITS    16U   /*!< Maximum width of a GPIO group, multiple of 4 up to 32.
+                                            May be overridden in stm32f1xx_hal_conf.h */
+#endif /* GPIOEX_GROUP_MAX_BITS */
+
+#if !defined(GPIOEX_GROUP_MAX_PORTS)
+#define GPIOEX_GROUP_MAX_PORTS   2U    /*!< Maximum number of ports spanned by a GPIO group.
+                                            May be overridden in stm32f1xx_hal_conf.h */
+#endif /* GPIOEX_GROUP_MAX_PORTS */
+
+/* DMA handle, stm32f1xx_hal_dma.h is included after this file */
+struct __DMA_HandleTypeDef;
+
+/**
+  * @brief  GPIO group pin definition
+  */
+typedef struct
+{
+  GPIO_TypeDef *GPIOx;  /*!< GPIO port of the pin                                      */
+
+  uint16_t Pin;         /*!< Pin, a single value of @ref GPIO_pins_define             */
+} GPIOEx_PinTypeDef;
+
+/**
+  * @brief  GPIO group structure definition, maps each bit of a logical value to a pin
+  */
+typedef struct
+{
+  GPIO_TypeDef *Port[GPIOEX_GROUP_MAX_PORTS];     /*!< Ports spanned by the group                              */
+
+  uint32_t PortNbr;                               /*!< Number of ports in Port                                 */
+
+  uint32_t Width;                                 /*!< Number of bits of the logical value                     */
+
+  uint32_t PinMask[GPIOEX_GROUP_MAX_PORTS];       /*!< Pins of the group on each port                          */
+
+  uint32_t BSRR[GPIOEX_GROUP_MAX_PORTS][GPIOEX_GROUP_MAX_BITS / 4U][16U]; /*!< BSRR word of each port for each
+                                                       value of each 4-bit digit of the logical value           */
+
+  uint8_t BitPort[GPIOEX_GROUP_MAX_BITS];         /*!< Index in Port of the pin of each bit                    */
+
+  uint16_t BitPin[GPIOEX_GROUP_MAX_BITS];         /*!< Pin of each bit                                         */
+} GPIOEx_GroupTypeDef;
+
+/**
+  * @}
+  */
+
 /* Exported constants --------------------------------------------------------*/
 
 /** @defgroup GPIOEx_Exported_Constants GPIOEx Exported Constants
@@ -872,6 +925,20 @@ void HAL_GPIOEx_DisableEventout(void);
   * @}
   */
 
+/** @addtogroup GPIOEx_Exported_Functions_Group2
+  * @{
+  */
+HAL_StatusTypeDef HAL_GPIOEx_GroupInit(GPIOEx_GroupTypeDef *hgroup, const GPIOEx_PinTypeDef *pPins, uint32_t Width);
+void              HAL_GPIOEx_GroupWrite(const GPIOEx_GroupTypeDef *hgroup, uint32_t Value);
+uint32_t          HAL_GPIOEx_GroupRead(const GPIOEx_GroupTypeDef *hgroup);
+HAL_StatusTypeDef HAL_GPIOEx_GroupEncode(const GPIOEx_GroupTypeDef *hgroup, const GPIO_TypeDef *GPIOx,
+                                         const uint32_t *pValues, uint32_t *pBSRR, uint32_t Size);
+HAL_StatusTypeDef HAL_GPIOEx_GroupStart_DMA(const GPIOEx_GroupTypeDef *hgroup, GPIO_TypeDef *GPIOx,
+                                            struct __DMA_HandleTypeDef *hdma, const uint32_t *pBSRR, uint32_t Size);
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -79,6 +79,9 @@
 __IO uint32_t uwTick;
 uint32_t uwTickPrio   = (1UL << __NVIC_PRIO_BITS); /* Invalid PRIO */
 HAL_TickFreqTypeDef uwTickFreq = HAL_TICK_FREQ_DEFAULT;  /* 1KHz */
+#if defined(USE_HAL_ATOMIC_LOCK) && (USE_HAL_ATOMIC_LOCK == 1U)
+volatile HAL_LockStatsTypeDef HAL_LockStats;
+#endif /* USE_HAL_ATOMIC_LOCK */
 /**
   * @}
   */
@@ -6,6 +6,7 @@
   *         This file provides firmware functions to manage the following
   *          functionalities of the General Purpose Input/Output (GPIO) extension peripheral.
   *           + Extended features functions
+  *           + GPIO group functions
   *
   ******************************************************************************
   * @attention
@@ -24,6 +25,8 @@
   ==============================================================================
   [..] GPIO module on STM32F1 family, manage also the AFIO register:
        (+) Possibility to use the EVENTOUT Cortex feature
+       (+) GPIO groups: a logical value of up to GPIOEX_GROUP_MAX_BITS bits mapped
+           to arbitrary pins, written with a single BSRR store per port
 
                      ##### How to use this driver #####
   ==============================================================================
@@ -32,6 +35,28 @@
     (#) Activate EVENTOUT Cortex feature using the HAL_GPIOEx_EnableEventout()
     (#) Deactivate EVENTOUT Cortex feature using the HAL_GPIOEx_DisableEventout()
 
+  [..] This driver provides functions to use GPIO groups
+    (#) Configure the mode of each pin of the group with HAL_GPIO_Init().
+    (#) Describe the pins in a GPIOEx_PinTypeDef array, the first entry being the
+        least significant bit of the logical value, and call HAL_GPIOEx_GroupInit().
+        The BSRR set and reset words of each port are precomputed for every value
+        of every 4-bit digit of the logical value.
+    (#) Write a logical value with HAL_GPIOEx_GroupWrite(): the BSRR words of all the
+        ports are computed first, then stored back to back. All the pins of a port
+        change on the same clock cycle.
+    (#) Read the logical value back from the input data registers with
+        HAL_GPIOEx_GroupRead().
+    (#) To stream values without CPU, encode a buffer of logical values into BSRR
+        words of one port with HAL_GPIOEx_GroupEncode(), then start a DMA transfer
+        of the words to the BSRR register of the port with HAL_GPIOEx_GroupStart_DMA().
+        (++) The DMA channel is configured by the user with 32-bit data size. It is
+             either triggered by a timer update request (memory to peripheral, memory
+             increment enabled, peripheral increment disabled) to output the values at
+             a fixed rate, or run as memory to memory (peripheral increment enabled,
+             memory increment disabled) to output the values at bus speed.
+        (++) A group spanning several ports needs one buffer and one DMA channel per
+             port; the ports are then not updated on the same clock cycle.
+
   @endverbatim
   ******************************************************************************
   */
@@ -50,6 +75,25 @@
 
 #ifdef HAL_GPIO_MODULE_ENABLED
 
+/* Private define ------------------------------------------------------------*/
+/** @defgroup GPIOEx_Private_Constants GPIOEx Private Constants
+  * @{
+  */
+#define GPIOEX_BSRR_RESET_POS   16U   /*!< Position of the reset bits in BSRR */
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup GPIOEx_Private_Functions GPIOEx Private Functions
+  * @{
+  */
+static uint32_t GPIOEx_GroupEncode(const GPIOEx_GroupTypeDef *hgroup, uint32_t PortIndex, uint32_t Value);
+static uint32_t GPIOEx_GroupPortIndex(const GPIOEx_GroupTypeDef *hgroup, const GPIO_TypeDef *GPIOx);
+/**
+  * @}
+  */
+
 /** @defgroup GPIOEx_Exported_Functions GPIOEx Exported Functions
   * @{
   */
@@ -110,6 +154,297 @@ void HAL_GPIOEx_DisableEventout(void)
   * @}
   */
 
+/** @defgroup GPIOEx_Exported_Functions_Group2 GPIO group functions
+ *  @brief    GPIO group functions
+ *
+@verbatim
+  ==============================================================================
+                 ##### GPIO group functions #####
+  ==============================================================================
+    [..]  This section provides functions allowing to:
+    (+) Build a GPIO group using the function HAL_GPIOEx_GroupInit()
+    (+) Write and read a GPIO group using HAL_GPIOEx_GroupWrite() and HAL_GPIOEx_GroupRead()
+    (+) Encode logical values into BSRR words using HAL_GPIOEx_GroupEncode()
+    (+) Stream BSRR words to a port by DMA using HAL_GPIOEx_GroupStart_DMA()
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Build a GPIO group and precompute its BSRR words.
+  * @note   The pins are not configured, HAL_GPIO_Init() must be called for each of them.
+  * @param  hgroup pointer to a GPIOEx_GroupTypeDef structure.
+  * @param  pPins pointer to an array of Width pins, pPins[0] being the least
+  *         significant bit of the logical value.
+  * @param  Width number of bits of the logical value, from 1 to GPIOEX_GROUP_MAX_BITS.
+  * @retval HAL status, HAL_ERROR if a pin is invalid or used twice or if the pins
+  *         span more than GPIOEX_GROUP_MAX_PORTS ports.
+  */
+HAL_StatusTypeDef HAL_GPIOEx_GroupInit(GPIOEx_GroupTypeDef *hgroup, const GPIOEx_PinTypeDef *pPins, uint32_t Width)
+{
+  uint32_t bit;
+  uint32_t port;
+  uint32_t digit;
+  uint32_t value;
+  uint32_t bsrr;
+
+  if ((hgroup == NULL) || (pPins == NULL) || (Width == 0U) || (Width > GPIOEX_GROUP_MAX_BITS))
+  {
+    return HAL_ERROR;
+  }
+
+  hgroup->PortNbr = 0U;
+  hgroup->Width = Width;
+
+  for (bit = 0U; bit < Width; bit++)
+  {
+    /* A group pin is a single pin of a valid port */
+    if ((pPins[bit].GPIOx == NULL) || (pPins[bit].Pin == 0U) ||
+        ((pPins[bit].Pin & (pPins[bit].Pin - 1U)) != 0U))
+    {
+      return HAL_ERROR;
+    }
+    assert_param(IS_GPIO_ALL_INSTANCE(pPins[bit].GPIOx));
+
+    for (port = 0U; port < hgroup->PortNbr; port++)
+    {
+      if (hgroup->Port[port] == pPins[bit].GPIOx)
+      {
+        break;
+      }
+    }
+
+    if (port == hgroup->PortNbr)
+    {
+      if (hgroup->PortNbr == GPIOEX_GROUP_MAX_PORTS)
+      {
+        return HAL_ERROR;
+      }
+      hgroup->Port[port] = pPins[bit].GPIOx;
+      hgroup->PinMask[port] = 0U;
+      hgroup->PortNbr++;
+    }
+
+    if ((hgroup->PinMask[port] & pPins[bit].Pin) != 0U)
+    {
+      return HAL_ERROR;
+    }
+
+    hgroup->PinMask[port] |= pPins[bit].Pin;
+    hgroup->BitPort[bit] = (uint8_t)port;
+    hgroup->BitPin[bit] = pPins[bit].Pin;
+  }
+
+  /* Precompute the BSRR word of each port for each value of each digit: the pins
+     of the bits at one are set, the pins of the bits at zero are reset */
+  for (port = 0U; port < hgroup->PortNbr; port++)
+  {
+    for (digit = 0U; digit < ((Width + 3U) / 4U); digit++)
+    {
+      for (value = 0U; value < 16U; value++)
+      {
+        bsrr = 0U;
+
+        for (bit = (digit * 4U); (bit < ((digit * 4U) + 4U)) && (bit < Width); bit++)
+        {
+          if (hgroup->BitPort[bit] == port)
+          {
+            if ((value & (1UL << (bit - (digit * 4U)))) != 0U)
+            {
+              bsrr |= (uint32_t)hgroup->BitPin[bit];
+            }
+            else
+            {
+              bsrr |= (uint32_t)hgroup->BitPin[bit] << GPIOEX_BSRR_RESET_POS;
+            }
+          }
+        }
+
+        hgroup->BSRR[port][digit][value] = bsrr;
+      }
+    }
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Write a logical value to a GPIO group.
+  * @note   The BSRR words of all the ports are computed before the first store, the
+  *         stores are then issued back to back, one per port.
+  * @param  hgroup pointer to a GPIOEx_GroupTypeDef structure.
+  * @param  Value logical value, the bits above the group width are ignored.
+  * @retval None
+  */
+void HAL_GPIOEx_GroupWrite(const GPIOEx_GroupTypeDef *hgroup, uint32_t Value)
+{
+  uint32_t bsrr[GPIOEX_GROUP_MAX_PORTS];
+  uint32_t port;
+
+  for (port = 0U; port < hgroup->PortNbr; port++)
+  {
+    bsrr[port] = GPIOEx_GroupEncode(hgroup, port, Value);
+  }
+
+  for (port = 0U; port < hgroup->PortNbr; port++)
+  {
+    hgroup->Port[port]->BSRR = bsrr[port];
+  }
+}
+
+/**
+  * @brief  Read the logical value of a GPIO group.
+  * @note   The input data register of each port is read once.
+  * @param  hgroup pointer to a GPIOEx_GroupTypeDef structure.
+  * @retval Logical value
+  */
+uint32_t HAL_GPIOEx_GroupRead(const GPIOEx_GroupTypeDef *hgroup)
+{
+  uint32_t idr[GPIOEX_GROUP_MAX_PORTS];
+  uint32_t port;
+  uint32_t bit;
+  uint32_t value = 0U;
+
+  for (port = 0U; port < hgroup->PortNbr; port++)
+  {
+    idr[port] = hgroup->Port[port]->IDR;
+  }
+
+  for (bit = 0U; bit < hgroup->Width; bit++)
+  {
+    if ((idr[hgroup->BitPort[bit]] & (uint32_t)hgroup->BitPin[bit]) != 0U)
+    {
+      value |= (1UL << bit);
+    }
+  }
+
+  return value;
+}
+
+/**
+  * @brief  Encode logical values into BSRR words of one port of a GPIO group.
+  * @note   pBSRR may be equal to pValues to encode in place.
+  * @param  hgroup pointer to a GPIOEx_GroupTypeDef structure.
+  * @param  GPIOx port of the group the words are encoded for.
+  * @param  pValues pointer to the logical values.
+  * @param  pBSRR pointer to the BSRR words.
+  * @param  Size number of values.
+  * @retval HAL status, HAL_ERROR if GPIOx is not a port of the group.
+  */
+HAL_StatusTypeDef HAL_GPIOEx_GroupEncode(const GPIOEx_GroupTypeDef *hgroup, const GPIO_TypeDef *GPIOx,
+                                         const uint32_t *pValues, uint32_t *pBSRR, uint32_t Size)
+{
+  uint32_t port;
+  uint32_t index;
+
+  if ((pValues == NULL) || (pBSRR == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  port = GPIOEx_GroupPortIndex(hgroup, GPIOx);
+  if (port == hgroup->PortNbr)
+  {
+    return HAL_ERROR;
+  }
+
+  for (index = 0U; index < Size; index++)
+  {
+    pBSRR[index] = GPIOEx_GroupEncode(hgroup, port, pValues[index]);
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Start a DMA transfer of BSRR words to a port of a GPIO group.
+  * @note   The DMA channel is configured by the user, see "How to use this driver".
+  *         Completion is reported by the callbacks of the DMA handle and the
+  *         transfer is stopped with HAL_DMA_Abort().
+  * @param  hgroup pointer to a GPIOEx_GroupTypeDef structure.
+  * @param  GPIOx port of the group the words were encoded for.
+  * @param  hdma pointer to a DMA_HandleTypeDef structure.
+  * @param  pBSRR pointer to the BSRR words, encoded with HAL_GPIOEx_GroupEncode().
+  * @param  Size number of words, from 1 to 65535.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_GPIOEx_GroupStart_DMA(const GPIOEx_GroupTypeDef *hgroup, GPIO_TypeDef *GPIOx,
+                                            struct __DMA_HandleTypeDef *hdma, const uint32_t *pBSRR, uint32_t Size)
+{
+#if defined(HAL_DMA_MODULE_ENABLED)
+  if ((hdma == NULL) || (pBSRR == NULL) || (Size == 0U) || (Size > 0xFFFFU) ||
+      (GPIOEx_GroupPortIndex(hgroup, GPIOx) == hgroup->PortNbr))
+  {
+    return HAL_ERROR;
+  }
+
+  /* In memory to memory mode, the source is the peripheral address of the channel */
+  return HAL_DMA_Start_IT(hdma, (uint32_t)pBSRR, (uint32_t)&GPIOx->BSRR, Size);
+#else
+  UNUSED(hgroup);
+  UNUSED(GPIOx);
+  UNUSED(hdma);
+  UNUSED(pBSRR);
+  UNUSED(Size);
+
+  return HAL_ERROR;
+#endif /* HAL_DMA_MODULE_ENABLED */
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup GPIOEx_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Compute the BSRR word of one port of a GPIO group for a logical value.
+  * @param  hgroup pointer to a GPIOEx_GroupTypeDef structure.
+  * @param  PortIndex index of the port in the group.
+  * @param  Value logical value.
+  * @retval BSRR word
+  */
+static uint32_t GPIOEx_GroupEncode(const GPIOEx_GroupTypeDef *hgroup, uint32_t PortIndex, uint32_t Value)
+{
+  uint32_t digit;
+  uint32_t bsrr = 0U;
+
+  for (digit = 0U; digit < ((hgroup->Width + 3U) / 4U); digit++)
+  {
+    bsrr |= hgroup->BSRR[PortIndex][digit][(Value >> (digit * 4U)) & 0xFU];
+  }
+
+  return bsrr;
+}
+
+/**
+  * @brief  Find the index of a port in a GPIO group.
+  * @param  hgroup pointer to a GPIOEx_GroupTypeDef structure.
+  * @param  GPIOx port to look for.
+  * @retval Index of the port, hgroup->PortNbr if GPIOx is not a port of the group.
+  */
+static uint32_t GPIOEx_GroupPortIndex(const GPIOEx_GroupTypeDef *hgroup, const GPIO_TypeDef *GPIOx)
+{
+  uint32_t port;
+
+  for (port = 0U; port < hgroup->PortNbr; port++)
+  {
+    if (hgroup->Port[port] == GPIOx)
+    {
+      break;
+    }
+  }
+
+  return port;
+}
+
 /**
   * @}
   */
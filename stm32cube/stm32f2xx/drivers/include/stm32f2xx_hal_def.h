@@ -90,6 +90,20 @@ typedef enum
 #if (USE_RTOS == 1U)
   /* Reserved for future use */
   #error "USE_RTOS should be 0 in the current HAL release"
+#elif defined(USE_HAL_ATOMIC_LOCK) && (USE_HAL_ATOMIC_LOCK == 1U)
+/* Lock taken and released atomically, see HAL_LockAcquire() */
+#define __HAL_LOCK(__HANDLE__)                               \
+  do{                                                        \
+    if(HAL_LockAcquire(&(__HANDLE__)->Lock) != HAL_OK)       \
+    {                                                        \
+      return HAL_BUSY;                                       \
+    }                                                        \
+  }while (0U)
+
+#define __HAL_UNLOCK(__HANDLE__)                             \
+  do{                                                        \
+    HAL_LockRelease(&(__HANDLE__)->Lock);                    \
+  }while (0U)
 #else
   #define __HAL_LOCK(__HANDLE__)                                           \
                                 do{                                        \
@@ -109,6 +123,103 @@ typedef enum
                                     }while (0U)
 #endif /* USE_RTOS */
 
+#if defined(USE_HAL_ATOMIC_LOCK) && (USE_HAL_ATOMIC_LOCK == 1U)
+/**
+  * @brief  HAL lock contention counters, approximate when updated concurrently
+  */
+typedef struct
+{
+  uint32_t Busy;     /*!< Lock attempts refused because the handle was already locked */
+  uint32_t Retries;  /*!< Exclusive store retries caused by a concurrent access        */
+} HAL_LockStatsTypeDef;
+
+extern volatile HAL_LockStatsTypeDef HAL_LockStats;
+
+/** @brief  Take a handle lock as a single atomic operation, so that HAL calls on
+  *         different handles need no external serialization between threads and
+  *         interrupts. Enabled by defining USE_HAL_ATOMIC_LOCK to 1U.
+  * @note   Exclusive accesses are used on ARMv7-M and ARMv8-M, and a PRIMASK
+  *         critical section on ARMv6-M.
+  * @param  pLock Pointer to the Lock field of the handle.
+  * @retval HAL_OK when the lock is taken, HAL_BUSY when it was already taken
+  */
+__STATIC_INLINE HAL_StatusTypeDef HAL_LockAcquire(volatile HAL_LockTypeDef *pLock)
+{
+#if defined(__ARM_ARCH_6M__) && (__ARM_ARCH_6M__ == 1)
+  HAL_StatusTypeDef status = HAL_OK;
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if (*pLock == HAL_LOCKED)
+  {
+    HAL_LockStats.Busy++;
+    status = HAL_BUSY;
+  }
+  else
+  {
+    *pLock = HAL_LOCKED;
+  }
+  __set_PRIMASK(primask);
+
+  return status;
+#else
+  uint32_t lock;
+  uint32_t failed;
+
+  do
+  {
+    /* The size of the enumeration depends on the compiler options */
+    if (sizeof(HAL_LockTypeDef) == sizeof(uint8_t))
+    {
+      lock = __LDREXB((volatile uint8_t *)pLock);
+    }
+    else
+    {
+      lock = __LDREXW((volatile uint32_t *)pLock);
+    }
+
+    if (lock == (uint32_t)HAL_LOCKED)
+    {
+      __CLREX();
+      HAL_LockStats.Busy++;
+      return HAL_BUSY;
+    }
+
+    if (sizeof(HAL_LockTypeDef) == sizeof(uint8_t))
+    {
+      failed = __STREXB((uint8_t)HAL_LOCKED, (volatile uint8_t *)pLock);
+    }
+    else
+    {
+      failed = __STREXW((uint32_t)HAL_LOCKED, (volatile uint32_t *)pLock);
+    }
+
+    if (failed != 0U)
+    {
+      HAL_LockStats.Retries++;
+    }
+  } while (failed != 0U);
+
+  /* Accesses to the handle must not be performed before the lock is taken */
+  __DMB();
+
+  return HAL_OK;
+#endif /* __ARM_ARCH_6M__ */
+}
+
+/** @brief  Release a handle lock taken with HAL_LockAcquire().
+  * @param  pLock Pointer to the Lock field of the handle.
+  * @retval None
+  */
+__STATIC_INLINE void HAL_LockRelease(volatile HAL_LockTypeDef *pLock)
+{
+  /* Accesses to the handle must be completed before the lock is released */
+  __DMB();
+  *pLock = HAL_UNLOCKED;
+}
+#endif /* USE_HAL_ATOMIC_LOCK */
+
+
 #if defined (__ARMCC_VERSION) && (__ARMCC_VERSION >= 6010050) /* ARM Compiler V6 */
   #ifndef __weak
     #define __weak  __attribute__((weak))
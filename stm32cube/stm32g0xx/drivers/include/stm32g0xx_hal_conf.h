@@ -91,6 +91,19 @@ extern "C" {
 #define USE_HAL_USART_REGISTER_CALLBACKS      0u
 #define USE_HAL_WWDG_REGISTER_CALLBACKS       0u
 
+/* ########################## DMA variants selection ############################## */
+/**
+  * @brief This is the list of modules where the DMA variants can be compiled out,
+  *        removing the DMA APIs, the DMA handles and the DMA abort paths of the
+  *        interrupt handlers. They can be set from the build.
+  */
+#if !defined(USE_HAL_I2C_DMA)
+#define USE_HAL_I2C_DMA                       1u
+#endif /* USE_HAL_I2C_DMA */
+#if !defined(USE_HAL_UART_DMA)
+#define USE_HAL_UART_DMA                      1u
+#endif /* USE_HAL_UART_DMA */
+
 /* ########################## Oscillator Values adaptation ####################*/
 /**
   * @brief Adjust the value of External High Speed oscillator (HSE) used in your application.
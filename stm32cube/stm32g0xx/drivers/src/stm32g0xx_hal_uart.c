@@ -197,8 +197,9 @@
 /** @addtogroup UART_Private_Functions
   * @{
   */
-static void UART_EndTxTransfer(UART_HandleTypeDef *huart);
 static void UART_EndRxTransfer(UART_HandleTypeDef *huart);
+#if (USE_HAL_UART_DMA == 1)
+static void UART_EndTxTransfer(UART_HandleTypeDef *huart);
 static void UART_DMATransmitCplt(DMA_HandleTypeDef *hdma);
 static void UART_DMAReceiveCplt(DMA_HandleTypeDef *hdma);
 static void UART_DMARxHalfCplt(DMA_HandleTypeDef *hdma);
@@ -209,6 +210,7 @@ static void UART_DMATxAbortCallback(DMA_HandleTypeDef *hdma);
 static void UART_DMARxAbortCallback(DMA_HandleTypeDef *hdma);
 static void UART_DMATxOnlyAbortCallback(DMA_HandleTypeDef *hdma);
 static void UART_DMARxOnlyAbortCallback(DMA_HandleTypeDef *hdma);
+#endif /* USE_HAL_UART_DMA */
 static void UART_TxISR_8BIT(UART_HandleTypeDef *huart);
 static void UART_TxISR_16BIT(UART_HandleTypeDef *huart);
 static void UART_TxISR_8BIT_FIFOEN(UART_HandleTypeDef *huart);
@@ -1449,6 +1451,7 @@ HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pData,
   }
 }
 
+#if (USE_HAL_UART_DMA == 1)
 /**
   * @brief Send an amount of data in DMA mode.
   * @note   When UART parity is not enabled (PCE = 0), and Word Length is configured to 9 bits (M1-M0 = 01),
@@ -1720,6 +1723,7 @@ HAL_StatusTypeDef HAL_UART_DMAStop(UART_HandleTypeDef *huart)
 
   return HAL_OK;
 }
+#endif /* USE_HAL_UART_DMA */
 
 /**
   * @brief  Abort ongoing transfers (blocking mode).
@@ -1746,6 +1750,7 @@ HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart)
     ATOMIC_CLEAR_BIT(huart->Instance->CR1, (USART_CR1_IDLEIE));
   }
 
+#if (USE_HAL_UART_DMA == 1)
   /* Abort the UART DMA Tx channel if enabled */
   if (HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAT))
   {
@@ -1797,6 +1802,7 @@ HAL_StatusTypeDef HAL_UART_Abort(UART_HandleTypeDef *huart)
       }
     }
   }
+#endif /* USE_HAL_UART_DMA */
 
   /* Reset Tx and Rx transfer counters */
   huart->TxXferCount = 0U;
@@ -1842,6 +1848,7 @@ HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *huart)
   ATOMIC_CLEAR_BIT(huart->Instance->CR1, (USART_CR1_TCIE | USART_CR1_TXEIE_TXFNFIE));
   ATOMIC_CLEAR_BIT(huart->Instance->CR3, USART_CR3_TXFTIE);
 
+#if (USE_HAL_UART_DMA == 1)
   /* Abort the UART DMA Tx channel if enabled */
   if (HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAT))
   {
@@ -1867,6 +1874,7 @@ HAL_StatusTypeDef HAL_UART_AbortTransmit(UART_HandleTypeDef *huart)
       }
     }
   }
+#endif /* USE_HAL_UART_DMA */
 
   /* Reset Tx transfer counter */
   huart->TxXferCount = 0U;
@@ -1907,6 +1915,7 @@ HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
     ATOMIC_CLEAR_BIT(huart->Instance->CR1, (USART_CR1_IDLEIE));
   }
 
+#if (USE_HAL_UART_DMA == 1)
   /* Abort the UART DMA Rx channel if enabled */
   if (HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAR))
   {
@@ -1932,6 +1941,7 @@ HAL_StatusTypeDef HAL_UART_AbortReceive(UART_HandleTypeDef *huart)
       }
     }
   }
+#endif /* USE_HAL_UART_DMA */
 
   /* Reset Rx transfer counter */
   huart->RxXferCount = 0U;
@@ -1978,6 +1988,7 @@ HAL_StatusTypeDef HAL_UART_Abort_IT(UART_HandleTypeDef *huart)
     ATOMIC_CLEAR_BIT(huart->Instance->CR1, (USART_CR1_IDLEIE));
   }
 
+#if (USE_HAL_UART_DMA == 1)
   /* If DMA Tx and/or DMA Rx Handles are associated to UART Handle, DMA Abort complete callbacks should be initialised
      before any call to DMA Abort functions */
   /* DMA Tx Handle is valid */
@@ -2057,6 +2068,7 @@ HAL_StatusTypeDef HAL_UART_Abort_IT(UART_HandleTypeDef *huart)
       }
     }
   }
+#endif /* USE_HAL_UART_DMA */
 
   /* if no DMA abort complete callback execution is required => call user Abort Complete callback */
   if (abortcplt == 1U)
@@ -2122,6 +2134,7 @@ HAL_StatusTypeDef HAL_UART_AbortTransmit_IT(UART_HandleTypeDef *huart)
   ATOMIC_CLEAR_BIT(huart->Instance->CR1, (USART_CR1_TCIE | USART_CR1_TXEIE_TXFNFIE));
   ATOMIC_CLEAR_BIT(huart->Instance->CR3, USART_CR3_TXFTIE);
 
+#if (USE_HAL_UART_DMA == 1)
   /* Abort the UART DMA Tx channel if enabled */
   if (HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAT))
   {
@@ -2164,6 +2177,7 @@ HAL_StatusTypeDef HAL_UART_AbortTransmit_IT(UART_HandleTypeDef *huart)
     }
   }
   else
+#endif /* USE_HAL_UART_DMA */
   {
     /* Reset Tx transfer counter */
     huart->TxXferCount = 0U;
@@ -2219,6 +2233,7 @@ HAL_StatusTypeDef HAL_UART_AbortReceive_IT(UART_HandleTypeDef *huart)
     ATOMIC_CLEAR_BIT(huart->Instance->CR1, (USART_CR1_IDLEIE));
   }
 
+#if (USE_HAL_UART_DMA == 1)
   /* Abort the UART DMA Rx channel if enabled */
   if (HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAR))
   {
@@ -2268,6 +2283,7 @@ HAL_StatusTypeDef HAL_UART_AbortReceive_IT(UART_HandleTypeDef *huart)
     }
   }
   else
+#endif /* USE_HAL_UART_DMA */
   {
     /* Reset Rx transfer counter */
     huart->RxXferCount = 0U;
@@ -2401,6 +2417,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
            Disable Rx Interrupts, and disable Rx DMA request, if ongoing */
         UART_EndRxTransfer(huart);
 
+#if (USE_HAL_UART_DMA == 1)
         /* Abort the UART DMA Rx channel if enabled */
         if (HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAR))
         {
@@ -2435,6 +2452,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
           }
         }
         else
+#endif /* USE_HAL_UART_DMA */
         {
           /* Call user error callback */
 #if (USE_HAL_UART_REGISTER_CALLBACKS == 1)
@@ -2472,6 +2490,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
   {
     __HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_IDLEF);
 
+#if (USE_HAL_UART_DMA == 1)
     /* Check if DMA mode is enabled in UART */
     if (HAL_IS_BIT_SET(huart->Instance->CR3, USART_CR3_DMAR))
     {
@@ -2523,6 +2542,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
     }
     else
     {
+#endif /* USE_HAL_UART_DMA */
       /* DMA mode not enabled */
       /* Check received length : If all expected data are received, do nothing.
          Otherwise, if at least one data has already been received, IDLE event is to be notified to user */
@@ -2558,7 +2578,9 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
 #endif /* (USE_HAL_UART_REGISTER_CALLBACKS) */
       }
       return;
+#if (USE_HAL_UART_DMA == 1)
     }
+#endif /* USE_HAL_UART_DMA */
   }
 
   /* UART wakeup from Stop mode interrupt occurred ---------------------------*/
@@ -3346,12 +3368,14 @@ void UART_AdvFeatureConfig(UART_HandleTypeDef *huart)
     MODIFY_REG(huart->Instance->CR3, USART_CR3_OVRDIS, huart->AdvancedInit.OverrunDisable);
   }
 
+#if (USE_HAL_UART_DMA == 1)
   /* if required, configure DMA disabling on reception error */
   if (HAL_IS_BIT_SET(huart->AdvancedInit.AdvFeatureInit, UART_ADVFEATURE_DMADISABLEONERROR_INIT))
   {
     assert_param(IS_UART_ADVFEATURE_DMAONRXERROR(huart->AdvancedInit.DMADisableonRxError));
     MODIFY_REG(huart->Instance->CR3, USART_CR3_DDRE, huart->AdvancedInit.DMADisableonRxError);
   }
+#endif /* USE_HAL_UART_DMA */
 
   /* if required, configure auto Baud rate detection scheme */
   if (HAL_IS_BIT_SET(huart->AdvancedInit.AdvFeatureInit, UART_ADVFEATURE_AUTOBAUDRATE_INIT))
@@ -3558,6 +3582,7 @@ HAL_StatusTypeDef UART_Start_Receive_IT(UART_HandleTypeDef *huart, uint8_t *pDat
   return HAL_OK;
 }
 
+#if (USE_HAL_UART_DMA == 1)
 /**
   * @brief  Start Receive operation in DMA mode.
   * @note   This function could be called by all HAL UART API providing reception in DMA mode.
@@ -3635,6 +3660,7 @@ static void UART_EndTxTransfer(UART_HandleTypeDef *huart)
   /* At end of Tx process, restore huart->gState to Ready */
   huart->gState = HAL_UART_STATE_READY;
 }
+#endif /* USE_HAL_UART_DMA */
 
 
 /**
@@ -3663,6 +3689,7 @@ static void UART_EndRxTransfer(UART_HandleTypeDef *huart)
 }
 
 
+#if (USE_HAL_UART_DMA == 1)
 /**
   * @brief DMA UART transmit process complete callback.
   * @param hdma DMA handle.
@@ -4047,6 +4074,7 @@ static void UART_DMARxOnlyAbortCallback(DMA_HandleTypeDef *hdma)
   HAL_UART_AbortReceiveCpltCallback(huart);
 #endif /* USE_HAL_UART_REGISTER_CALLBACKS */
 }
+#endif /* USE_HAL_UART_DMA */
 
 /**
   * @brief TX interrupt handler for 7 or 8 bits data word length .
@@ -907,6 +907,7 @@ HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_IT(UART_HandleTypeDef *huart, uint8_t
   }
 }
 
+#if (USE_HAL_UART_DMA == 1)
 /**
   * @brief Receive an amount of data in DMA mode till either the expected number
   *        of data is received or an IDLE event occurs.
@@ -983,6 +984,7 @@ HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_
     return HAL_BUSY;
   }
 }
+#endif /* USE_HAL_UART_DMA */
 
 /**
   * @brief Provide Rx Event type that has lead to RxEvent callback execution.
@@ -27,6 +27,7 @@ extern "C" {
 
 /* Includes ------------------------------------------------------------------*/
 #include "stm32g4xx_hal_conf.h"
+#include "stm32g4xx_hal_wait.h"
 
 /** @addtogroup STM32G4xx_HAL_Driver
   * @{
@@ -72,6 +72,47 @@ typedef struct
                            can be a value of @ref EXTI_GPIOSel */
 } EXTI_ConfigTypeDef;
 
+#if !defined(USE_HAL_EXTI_DISPATCH_DELAY)
+#define USE_HAL_EXTI_DISPATCH_DELAY  0U     /*!< Set to 1U in stm32g4xx_hal_conf.h to measure the dispatch
+                                                 delay of each line with the DWT cycle counter */
+#endif /* USE_HAL_EXTI_DISPATCH_DELAY */
+
+/**
+  * @brief  EXTI dispatcher line entry definition
+  */
+typedef struct
+{
+  void (* Callback)(uint32_t Line, void *pContext); /*!< Called with Line and pContext                */
+  void *pContext;                                   /*!< User context given to Callback               */
+  uint32_t Line;                                    /*!< Line, a value of @ref EXTI_Line              */
+} EXTI_DispatchEntryTypeDef;
+
+/**
+  * @brief  EXTI dispatcher line statistics definition
+  */
+typedef struct
+{
+  uint32_t Events;       /*!< Pending events served                                                */
+  uint32_t DelayLast;    /*!< CPU cycles from the dispatcher entry to the last callback call: the
+                              higher lines served before and the dispatch itself. The interrupt
+                              entry latency, before the dispatcher, is not included. Only
+                              updated when USE_HAL_EXTI_DISPATCH_DELAY is 1U                        */
+  uint32_t DelayMax;     /*!< Maximum of DelayLast                                                 */
+} EXTI_DispatchStatsTypeDef;
+
+/**
+  * @brief  EXTI dispatcher structure definition
+  */
+typedef struct
+{
+  uint32_t Register;                          /*!< Pending register served, line register index */
+  uint32_t Mask;                              /*!< Lines with a registered callback             */
+  EXTI_DispatchEntryTypeDef Entry[32U];       /*!< Callback of each line of the register        */
+  EXTI_DispatchStatsTypeDef Stats[32U];       /*!< Statistics of each line of the register      */
+  uint32_t Calls;                             /*!< HAL_EXTI_DispatchIRQHandler() calls           */
+  uint32_t Spurious;                          /*!< Calls without any pending registered line     */
+} EXTI_DispatchTypeDef;
+
 /**
   * @}
   */
@@ -291,6 +332,24 @@ uint32_t          HAL_EXTI_GetPending(EXTI_HandleTypeDef *hexti, uint32_t Edge);
 void              HAL_EXTI_ClearPending(EXTI_HandleTypeDef *hexti, uint32_t Edge);
 void              HAL_EXTI_GenerateSWI(EXTI_HandleTypeDef *hexti);
 
+/**
+  * @}
+  */
+
+/** @defgroup EXTI_Exported_Functions_Group3 Dispatch functions
+  * @brief    Dispatch functions
+  * @{
+  */
+/* Dispatch functions *********************************************************/
+HAL_StatusTypeDef HAL_EXTI_DispatchInit(EXTI_DispatchTypeDef *hdispatch);
+HAL_StatusTypeDef HAL_EXTI_DispatchRegister(EXTI_DispatchTypeDef *hdispatch, uint32_t ExtiLine,
+                                            void (* pCallback)(uint32_t Line, void *pContext), void *pContext);
+HAL_StatusTypeDef HAL_EXTI_DispatchUnRegister(EXTI_DispatchTypeDef *hdispatch, uint32_t ExtiLine);
+void              HAL_EXTI_DispatchIRQHandler(EXTI_DispatchTypeDef *hdispatch);
+HAL_StatusTypeDef HAL_EXTI_DispatchGetStats(const EXTI_DispatchTypeDef *hdispatch, uint32_t ExtiLine,
+                                            EXTI_DispatchStatsTypeDef *pStats);
+void              HAL_EXTI_DispatchResetStats(EXTI_DispatchTypeDef *hdispatch);
+
 /**
   * @}
   */
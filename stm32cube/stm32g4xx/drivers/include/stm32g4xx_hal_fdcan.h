@@ -1116,6 +1116,9 @@ typedef  void (*pFDCAN_ErrorStatusCallbackTypeDef)(FDCAN_HandleTypeDef *hfdcan,
   * @}
   */
 
+/* Include FDCAN HAL Extended module */
+#include "stm32g4xx_hal_fdcan_ex.h"
+
 /* Exported functions --------------------------------------------------------*/
 /** @addtogroup FDCAN_Exported_Functions
   * @{
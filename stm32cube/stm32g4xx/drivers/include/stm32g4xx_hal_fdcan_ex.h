@@ -0,0 +1,66 @@
+/**
+  ******************************************************************************
+  * @file    stm32g4xx_hal_fdcan_ex.h
+  * @brief   Header file of FDCAN HAL Extended module.
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32G4xx_HAL_FDCAN_EX_H
+#define STM32G4xx_HAL_FDCAN_EX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32g4xx_hal_def.h"
+
+#if defined(FDCAN1)
+
+/** @addtogroup STM32G4xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup FDCANEx
+  * @{
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup FDCANEx_Exported_Functions
+  * @{
+  */
+
+/** @addtogroup FDCANEx_Exported_Functions_Group1
+  * @{
+  */
+HAL_StatusTypeDef HAL_FDCANEx_GetRxMessages(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, FDCAN_RxHeaderTypeDef *pRxHeader,
+                                            uint8_t *pRxData, uint32_t DataStride, uint32_t MaxFrames, uint32_t *pFramesNbr);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* FDCAN1 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32G4xx_HAL_FDCAN_EX_H */
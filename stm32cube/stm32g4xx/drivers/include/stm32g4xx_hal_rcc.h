@@ -34,6 +34,10 @@
   * @{
   */
 
+#if !defined(USE_HAL_RCC_CLOCK_CACHE)
+#define USE_HAL_RCC_CLOCK_CACHE  0U  /*!< May be set to 1U in stm32g4xx_hal_conf.h to cache clock frequencies */
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
 /* Exported types ------------------------------------------------------------*/
 /** @defgroup RCC_Exported_Types RCC Exported Types
   * @{
@@ -120,6 +124,38 @@ typedef struct
 
 }RCC_ClkInitTypeDef;
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+/**
+  * @brief  RCC clock tree snapshot structure definition
+  */
+typedef struct
+{
+  uint32_t SYSCLKFreq;            /*!< SYSCLK frequency in Hz                                                 */
+
+  uint32_t HCLKFreq;              /*!< HCLK frequency in Hz                                                   */
+
+  uint32_t PCLK1Freq;             /*!< PCLK1 frequency in Hz                                                  */
+
+  uint32_t PCLK2Freq;             /*!< PCLK2 frequency in Hz                                                  */
+
+  __IO uint32_t Generation;       /*!< Incremented each time the snapshot is invalidated                     */
+
+}RCC_ClockTreeTypeDef;
+
+/**
+  * @brief  RCC clock tree change notifier structure definition
+  */
+typedef struct __RCC_ClockNotifierTypeDef
+{
+  void (* Callback)(const RCC_ClockTreeTypeDef *pClockTree, void *pContext); /*!< Called with the updated clock tree */
+
+  void *pContext;                                 /*!< User context given to Callback                       */
+
+  struct __RCC_ClockNotifierTypeDef *pNext;       /*!< Next registered notifier, managed by the driver      */
+
+}RCC_ClockNotifierTypeDef;
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
 /**
   * @}
   */
@@ -3386,6 +3422,23 @@ void              HAL_RCC_CSSCallback(void);
   * @}
   */
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+/** @addtogroup RCC_Exported_Functions_Group3
+  * @{
+  */
+
+/* Clock tree cache functions  **************************************************/
+const RCC_ClockTreeTypeDef *HAL_RCC_GetClockTree(void);
+void              HAL_RCC_InvalidateClockTree(void);
+void              HAL_RCC_UpdateClockTree(void);
+HAL_StatusTypeDef HAL_RCC_RegisterClockNotifier(RCC_ClockNotifierTypeDef *pNotifier);
+HAL_StatusTypeDef HAL_RCC_UnRegisterClockNotifier(RCC_ClockNotifierTypeDef *pNotifier);
+
+/**
+  * @}
+  */
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
 /**
   * @}
   */
@@ -173,6 +173,32 @@ typedef struct
 
 }RCC_CRSSynchroInfoTypeDef;
 
+/**
+  * @brief  RCC PLL solver target structure definition
+  * @note   An output with a target frequency of 0 is not used, its divider is set to its maximum value.
+  */
+typedef struct
+{
+  uint32_t PLLSource;             /*!< PLL entry clock source.
+                                       This parameter must be a value of @ref RCC_PLL_Clock_Source */
+
+  uint32_t InputFreq;             /*!< Frequency of the PLL entry clock in Hz, usually HSI_VALUE or HSE_VALUE */
+
+  uint32_t PLLPFreq;              /*!< Target frequency of the PLLP output (ADC clock) in Hz, 0 when not used */
+
+  uint32_t PLLPTolerance;         /*!< Maximum deviation from PLLPFreq in Hz */
+
+  uint32_t PLLQFreq;              /*!< Target frequency of the PLLQ output (SAI, I2S, USB, FDCAN, QUADSPI clocks)
+                                       in Hz, 0 when not used */
+
+  uint32_t PLLQTolerance;         /*!< Maximum deviation from PLLQFreq in Hz */
+
+  uint32_t PLLRFreq;              /*!< Target frequency of the PLLR output (system clock) in Hz, 0 when not used */
+
+  uint32_t PLLRTolerance;         /*!< Maximum deviation from PLLRFreq in Hz */
+
+}RCC_PLLTargetTypeDef;
+
 /**
   * @}
   */
@@ -1297,6 +1323,16 @@ void              HAL_RCCEx_CRS_SyncWarnCallback(void);
 void              HAL_RCCEx_CRS_ExpectedSyncCallback(void);
 void              HAL_RCCEx_CRS_ErrorCallback(uint32_t Error);
 
+/**
+  * @}
+  */
+
+/** @addtogroup RCCEx_Exported_Functions_Group4
+  * @{
+  */
+
+HAL_StatusTypeDef HAL_RCCEx_PLLSolve(const RCC_PLLTargetTypeDef *pTarget, RCC_PLLInitTypeDef *pPLLInit);
+
 /**
   * @}
   */
@@ -35,7 +35,87 @@ extern "C" {
   * @{
   */
 
+/** @defgroup SMARTCARDEx_T1_IFS_Max SMARTCARD Extended T=1 maximum information field size
+  * @{
+  */
+#if !defined(SMARTCARDEX_T1_IFS_MAX)
+#define SMARTCARDEX_T1_IFS_MAX   254U   /*!< Largest IFSC/IFSD supported, may be lowered in stm32g4xx_hal_conf.h
+                                             to reduce the size of SMARTCARDEx_T1TypeDef */
+#endif /* SMARTCARDEX_T1_IFS_MAX */
+/**
+  * @}
+  */
+
 /* Exported types ------------------------------------------------------------*/
+/** @defgroup SMARTCARDEx_Exported_Types SMARTCARD Extended Exported Types
+  * @{
+  */
+
+/**
+  * @brief  SMARTCARD T=1 protocol parameters, taken from the card ATR
+  */
+typedef struct
+{
+  uint32_t BWT;          /*!< Block waiting time, in etu                                         */
+  uint32_t CWT;          /*!< Character waiting time, in etu                                     */
+  uint8_t  EDC;          /*!< Error detection code, a value of @ref SMARTCARDEx_T1_EDC             */
+  uint8_t  NAD;          /*!< Node address byte                                                  */
+  uint8_t  IFSC;         /*!< Information field size of the card, 1 to SMARTCARDEX_T1_IFS_MAX    */
+  uint8_t  IFSD;         /*!< Information field size of the interface, 1 to SMARTCARDEX_T1_IFS_MAX */
+} SMARTCARDEx_T1InitTypeDef;
+
+/**
+  * @brief  SMARTCARD T=1 statistics
+  */
+typedef struct
+{
+  uint32_t Apdus;            /*!< APDU exchanges completed, successfully or not          */
+  uint32_t Errors;           /*!< APDU exchanges failed                                  */
+  uint32_t Blocks;           /*!< Blocks received                                        */
+  uint32_t Retransmissions;  /*!< Blocks sent again or R-blocks sent after a bad block   */
+  uint32_t WTXRequests;      /*!< Waiting time extensions granted to the card            */
+  uint32_t LastLatency;      /*!< GetTime() ticks of the last APDU exchange              */
+  uint32_t MaxLatency;       /*!< Largest APDU exchange duration, in GetTime() ticks     */
+} SMARTCARDEx_T1StatsTypeDef;
+
+/**
+  * @brief  SMARTCARD T=1 protocol handle
+  */
+typedef struct __SMARTCARDEx_T1TypeDef
+{
+  SMARTCARD_HandleTypeDef     *hsmartcard;                           /*!< SMARTCARD handle                       */
+  SMARTCARDEx_T1InitTypeDef   Init;                                  /*!< Protocol parameters                    */
+  const uint8_t               *pCmd;                                 /*!< Command APDU                           */
+  uint8_t                     *pRsp;                                 /*!< Response APDU buffer                   */
+  uint16_t                    CmdSize;                               /*!< Command APDU length                    */
+  uint16_t                    CmdOffset;                             /*!< Command bytes acknowledged by the card */
+  uint16_t                    RspSize;                               /*!< Size of pRsp                           */
+  uint16_t                    RspLength;                             /*!< Response APDU length                   */
+  __IO uint32_t               ErrorCode;                             /*!< Error code of the last exchange, a value
+                                                                          of @ref SMARTCARDEx_T1_Error_Code      */
+  __IO uint8_t                State;                                 /*!< Exchange state                         */
+  uint8_t                     SendSeq;                               /*!< N(S) of the next I-block sent          */
+  uint8_t                     RecvSeq;                               /*!< N(S) expected in the next I-block read */
+  uint8_t                     Chunk;                                 /*!< INF length of the last I-block sent    */
+  uint8_t                     WTXMultiplier;                         /*!< BWT multiplier granted to the card     */
+  uint8_t                     Retries;                               /*!< Consecutive error recoveries           */
+  uint8_t                     RxError;                               /*!< Parity, framing or noise error seen    */
+  uint16_t                    TxLength;                              /*!< Length of the last block sent          */
+  uint8_t                     TxBlock[SMARTCARDEX_T1_IFS_MAX + 5U];  /*!< Last block sent                        */
+  uint8_t                     RxBlock[SMARTCARDEX_T1_IFS_MAX + 5U];  /*!< Block being read                       */
+  uint32_t                    StartTime;                             /*!< GetTime() value at exchange start      */
+  uint32_t                    (*GetTime)(void);                      /*!< Timestamp source, HAL_GetTick() by
+                                                                          default                                */
+  SMARTCARDEx_T1StatsTypeDef  Stats;                                 /*!< Statistics                             */
+  void                        (*ApduCpltCallback)(struct __SMARTCARDEx_T1TypeDef *ht1); /*!< Called at the end of
+                                                                          each exchange, may be NULL             */
+  void                        *pContext;                             /*!< User context                           */
+} SMARTCARDEx_T1TypeDef;
+
+/**
+  * @}
+  */
+
 /* Exported constants --------------------------------------------------------*/
 
 /** @addtogroup SMARTCARDEx_Exported_Constants  SMARTCARD Extended Exported Constants
@@ -51,6 +131,36 @@ extern "C" {
   * @}
   */
 
+/** @defgroup SMARTCARDEx_T1_EDC SMARTCARD Extended T=1 error detection code
+  * @{
+  */
+#define SMARTCARDEX_T1_EDC_LRC             0x00U   /*!< 1-byte longitudinal redundancy check */
+#define SMARTCARDEX_T1_EDC_CRC             0x01U   /*!< 2-byte cyclic redundancy check       */
+/**
+  * @}
+  */
+
+/** @defgroup SMARTCARDEx_T1_Error_Code SMARTCARD Extended T=1 error code
+  * @{
+  */
+#define HAL_SMARTCARDEX_T1_ERROR_NONE      0x00000000U   /*!< No error                                        */
+#define HAL_SMARTCARDEX_T1_ERROR_PROTOCOL  0x00000001U   /*!< Error recovery failed after the maximum retries */
+#define HAL_SMARTCARDEX_T1_ERROR_TIMEOUT   0x00000002U   /*!< Last failure was a BWT or CWT expiry            */
+#define HAL_SMARTCARDEX_T1_ERROR_OVERFLOW  0x00000004U   /*!< Response APDU larger than the response buffer   */
+#define HAL_SMARTCARDEX_T1_ERROR_ABORTED   0x00000008U   /*!< Chain aborted by the card                       */
+#define HAL_SMARTCARDEX_T1_ERROR_SEND      0x00000010U   /*!< A block could not be started                    */
+/**
+  * @}
+  */
+
+/** @defgroup SMARTCARDEx_T1_Retries SMARTCARD Extended T=1 error recovery attempts
+  * @{
+  */
+#define SMARTCARDEX_T1_MAX_RETRIES         3U      /*!< Error recoveries before an exchange is failed */
+/**
+  * @}
+  */
+
 /** @defgroup SMARTCARDEx_Advanced_Features_Initialization_Type SMARTCARD advanced feature initialization type
   * @{
   */
@@ -310,6 +420,26 @@ HAL_StatusTypeDef HAL_SMARTCARDEx_DisableFifoMode(SMARTCARD_HandleTypeDef *hsmar
 HAL_StatusTypeDef HAL_SMARTCARDEx_SetTxFifoThreshold(SMARTCARD_HandleTypeDef *hsmartcard, uint32_t Threshold);
 HAL_StatusTypeDef HAL_SMARTCARDEx_SetRxFifoThreshold(SMARTCARD_HandleTypeDef *hsmartcard, uint32_t Threshold);
 
+/**
+  * @}
+  */
+
+/** @addtogroup SMARTCARDEx_Exported_Functions_Group4
+  * @{
+  */
+
+/* T=1 protocol functions *****************************************************/
+HAL_StatusTypeDef HAL_SMARTCARDEx_T1_Init(SMARTCARDEx_T1TypeDef *ht1, SMARTCARD_HandleTypeDef *hsmartcard,
+                                          const SMARTCARDEx_T1InitTypeDef *pInit);
+HAL_StatusTypeDef HAL_SMARTCARDEx_T1_Transceive_IT(SMARTCARDEx_T1TypeDef *ht1, const uint8_t *pCmd, uint16_t CmdSize,
+                                                   uint8_t *pRsp, uint16_t RspSize);
+uint32_t          HAL_SMARTCARDEx_T1_IsBusy(const SMARTCARDEx_T1TypeDef *ht1);
+void              HAL_SMARTCARDEx_T1_TxCplt(SMARTCARDEx_T1TypeDef *ht1);
+void              HAL_SMARTCARDEx_T1_RxCplt(SMARTCARDEx_T1TypeDef *ht1);
+void              HAL_SMARTCARDEx_T1_Error(SMARTCARDEx_T1TypeDef *ht1);
+void              HAL_SMARTCARDEx_T1_GetStats(const SMARTCARDEx_T1TypeDef *ht1, SMARTCARDEx_T1StatsTypeDef *pStats);
+void              HAL_SMARTCARDEx_T1_ResetStats(SMARTCARDEx_T1TypeDef *ht1);
+
 /**
   * @}
   */
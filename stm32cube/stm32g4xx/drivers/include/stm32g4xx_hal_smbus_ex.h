@@ -35,7 +35,63 @@ extern "C" {
   * @{
   */
 
+/** @defgroup SMBUSEx_Block_Max SMBUS Extended maximum block size
+  * @{
+  */
+#if !defined(SMBUSEX_BLOCK_MAX)
+#define SMBUSEX_BLOCK_MAX                 32U   /*!< Block protocols data size, may be overridden in
+                                                     stm32g4xx_hal_conf.h                                 */
+#endif /* SMBUSEX_BLOCK_MAX */
+/**
+  * @}
+  */
+
 /* Exported types ------------------------------------------------------------*/
+/** @defgroup SMBUSEx_Exported_Types SMBUS Extended Exported Types
+  * @{
+  */
+
+/**
+  * @brief  SMBUS transaction structure definition
+  */
+typedef struct
+{
+  uint16_t       DevAddress;  /*!< Target device address, 7 bits address shifted to the left          */
+  uint8_t        Protocol;    /*!< Bus protocol, a value of @ref SMBUSEx_Protocol                      */
+  uint8_t        Command;     /*!< Command code                                                        */
+  const uint8_t  *pTxData;    /*!< Data written after the command code                                 */
+  uint8_t        TxSize;      /*!< Number of bytes to write, used by the block protocols only          */
+  uint8_t        *pRxData;    /*!< Buffer for the data read                                            */
+  uint8_t        RxSize;      /*!< Size of pRxData for the block protocols, updated with the number
+                                   of bytes read once the transaction is complete                      */
+} SMBUSEx_TransactionTypeDef;
+
+/**
+  * @brief  SMBUS transaction engine structure definition
+  */
+typedef struct __SMBUSEx_EngineTypeDef
+{
+  SMBUS_HandleTypeDef         *hsmbus;                        /*!< SMBUS handle, in master mode            */
+  SMBUSEx_TransactionTypeDef  *pXact;                         /*!< Transaction in progress                 */
+  uint32_t                    PECMode;                        /*!< Resolved PEC mode, a value of
+                                                                   @ref SMBUSEx_PEC_Mode                   */
+  __IO uint32_t               ErrorCode;                      /*!< Error code of the last transaction,
+                                                                   a value of @ref SMBUS_Error_Code_definition
+                                                                   or @ref SMBUSEx_Error_Code              */
+  __IO uint8_t                Phase;                          /*!< Phase of the transaction in progress    */
+  uint8_t                     PEC;                            /*!< Software PEC accumulator                */
+  uint8_t                     Count;                          /*!< Block count received from the target    */
+  uint8_t                     TxBuf[SMBUSEX_BLOCK_MAX + 3U];  /*!< Command, count, data and PEC written    */
+  uint8_t                     RxBuf[SMBUSEX_BLOCK_MAX + 1U];  /*!< Data and PEC read                       */
+  void                        (*XferCpltCallback)(struct __SMBUSEx_EngineTypeDef *hengine); /*!< Called at the end
+                                                                   of each transaction, may be NULL        */
+  void                        *pContext;                      /*!< User context                            */
+} SMBUSEx_EngineTypeDef;
+
+/**
+  * @}
+  */
+
 /* Exported constants --------------------------------------------------------*/
 /** @defgroup SMBUSEx_Exported_Constants SMBUS Extended Exported Constants
   * @{
@@ -61,6 +117,43 @@ extern "C" {
   * @}
   */
 
+/** @defgroup SMBUSEx_Protocol SMBUS Extended transaction protocol
+  * @{
+  */
+#define SMBUSEX_WRITE_BYTE                0x01U   /*!< Command, 1 data byte written                       */
+#define SMBUSEX_WRITE_WORD                0x02U   /*!< Command, 2 data bytes written                      */
+#define SMBUSEX_BLOCK_WRITE               0x03U   /*!< Command, count and TxSize data bytes written        */
+#define SMBUSEX_READ_BYTE                 0x04U   /*!< Command written, 1 data byte read                  */
+#define SMBUSEX_READ_WORD                 0x05U   /*!< Command written, 2 data bytes read                 */
+#define SMBUSEX_BLOCK_READ                0x06U   /*!< Command written, count and data bytes read         */
+#define SMBUSEX_PROCESS_CALL              0x07U   /*!< Command and 2 data bytes written, 2 data bytes read */
+#define SMBUSEX_BLOCK_PROCESS_CALL        0x08U   /*!< Block write followed by a block read              */
+/**
+  * @}
+  */
+
+/** @defgroup SMBUSEx_PEC_Mode SMBUS Extended transaction PEC mode
+  * @{
+  */
+#define SMBUSEX_PEC_NONE                  0x00000000U   /*!< No PEC byte                                       */
+#define SMBUSEX_PEC_HARDWARE              0x00000001U   /*!< PEC computed and checked by the peripheral, needs
+                                                             Init.PacketErrorCheckMode set to SMBUS_PEC_ENABLE */
+#define SMBUSEX_PEC_SOFTWARE              0x00000002U   /*!< PEC computed and checked with a CRC-8 table       */
+#define SMBUSEX_PEC_AUTO                  0x00000003U   /*!< Hardware PEC when enabled in the handle, software
+                                                             PEC otherwise                                     */
+/**
+  * @}
+  */
+
+/** @defgroup SMBUSEx_Error_Code SMBUS Extended transaction error code
+  * @{
+  */
+#define HAL_SMBUSEX_ERROR_BLOCKSIZE       (0x00010000U)    /*!< Block count out of range      */
+#define HAL_SMBUSEX_ERROR_SEQUENCE        (0x00020000U)    /*!< Read part could not be started */
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -98,6 +191,22 @@ void HAL_SMBUSEx_DisableFastModePlus(uint32_t ConfigFastModePlus);
   * @}
   */
 
+/** @addtogroup SMBUSEx_Exported_Functions_Group4 PEC and Transaction Functions
+  * @{
+  */
+/* PEC and transaction functions  ***********************************************/
+uint8_t           HAL_SMBUSEx_CalculatePEC(uint8_t InitialPEC, const uint8_t *pData, uint32_t Size);
+HAL_StatusTypeDef HAL_SMBUSEx_EngineInit(SMBUSEx_EngineTypeDef *hengine, SMBUS_HandleTypeDef *hsmbus,
+                                         uint32_t PECMode);
+HAL_StatusTypeDef HAL_SMBUSEx_Transaction_IT(SMBUSEx_EngineTypeDef *hengine, SMBUSEx_TransactionTypeDef *pXact);
+uint32_t          HAL_SMBUSEx_EngineIsBusy(const SMBUSEx_EngineTypeDef *hengine);
+void              HAL_SMBUSEx_EngineMasterTxCplt(SMBUSEx_EngineTypeDef *hengine);
+void              HAL_SMBUSEx_EngineMasterRxCplt(SMBUSEx_EngineTypeDef *hengine);
+void              HAL_SMBUSEx_EngineError(SMBUSEx_EngineTypeDef *hengine);
+/**
+  * @}
+  */
+
 /**
   * @}
   */
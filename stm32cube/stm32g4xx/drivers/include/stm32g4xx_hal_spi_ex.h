@@ -36,14 +36,88 @@ extern "C" {
   */
 
 /* Exported types ------------------------------------------------------------*/
+/** @defgroup SPIEx_Exported_Types SPIEx Exported Types
+  * @{
+  */
+
+/**
+  * @brief  SPI constant configuration, built at compile time by SPI_CONST_INIT()
+  *         and applied by HAL_SPIEx_InitConst()
+  */
+typedef struct
+{
+  SPI_InitTypeDef Init;         /*!< Communication parameters, copied to the handle Init field. */
+
+  uint32_t CR1;                 /*!< CR1 register value, SPI_CR1_SPE excluded. */
+
+  uint32_t CR2;                 /*!< CR2 register value. */
+} SPI_ConstInitTypeDef;
+
+/**
+  * @}
+  */
+
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
+/** @defgroup SPIEx_Exported_Macros SPIEx Exported Macros
+  * @{
+  */
+
+/** @brief  Build the constant configuration of a SPI in Motorola mode without CRC,
+  *         to initialize a static const SPI_ConstInitTypeDef.
+  * @note   The arguments must be constant expressions: the register values are then
+  *         computed by the compiler. As in HAL_SPI_Init(), the baud rate prescaler
+  *         is forced to 2 in slave mode and the RX FIFO threshold follows the data size.
+  * @param  __MODE__ Value of @ref SPI_Mode.
+  * @param  __DIRECTION__ Value of @ref SPI_Direction.
+  * @param  __DATASIZE__ Value of @ref SPI_Data_Size.
+  * @param  __CLKPOLARITY__ Value of @ref SPI_Clock_Polarity.
+  * @param  __CLKPHASE__ Value of @ref SPI_Clock_Phase.
+  * @param  __NSS__ Value of @ref SPI_Slave_Select_management.
+  * @param  __BAUDRATEPRESCALER__ Value of @ref SPI_BaudRate_Prescaler.
+  * @param  __FIRSTBIT__ Value of @ref SPI_MSB_LSB_transmission.
+  * @param  __NSSPMODE__ Value of @ref SPI_NSSP_Mode.
+  * @retval Initializer of a SPI_ConstInitTypeDef
+  */
+#define SPI_CONST_INIT(__MODE__, __DIRECTION__, __DATASIZE__, __CLKPOLARITY__, __CLKPHASE__, __NSS__,    \
+                       __BAUDRATEPRESCALER__, __FIRSTBIT__, __NSSPMODE__)                                 \
+  {                                                                                                       \
+    {                                                                                                     \
+      (__MODE__), (__DIRECTION__), (__DATASIZE__), (__CLKPOLARITY__), (__CLKPHASE__), (__NSS__),          \
+      SPI_CONST_BAUDRATEPRESCALER((__MODE__), (__BAUDRATEPRESCALER__)), (__FIRSTBIT__),                   \
+      SPI_TIMODE_DISABLE, SPI_CRCCALCULATION_DISABLE, 7U, SPI_CRC_LENGTH_DATASIZE, (__NSSPMODE__)         \
+    },                                                                                                    \
+    (((__MODE__) & (SPI_CR1_MSTR | SPI_CR1_SSI)) |                                                        \
+     ((__DIRECTION__) & (SPI_CR1_RXONLY | SPI_CR1_BIDIMODE)) |                                            \
+     ((__CLKPOLARITY__) & SPI_CR1_CPOL) |                                                                 \
+     ((__CLKPHASE__) & SPI_CR1_CPHA) |                                                                    \
+     ((__NSS__) & SPI_CR1_SSM) |                                                                          \
+     (SPI_CONST_BAUDRATEPRESCALER((__MODE__), (__BAUDRATEPRESCALER__)) & SPI_CR1_BR_Msk) |                \
+     ((__FIRSTBIT__) & SPI_CR1_LSBFIRST)),                                                                \
+    ((((__NSS__) >> 16U) & SPI_CR2_SSOE) |                                                                \
+     ((__NSSPMODE__) & SPI_CR2_NSSP) |                                                                    \
+     ((__DATASIZE__) & SPI_CR2_DS_Msk) |                                                                  \
+     (((__DATASIZE__) > SPI_DATASIZE_8BIT) ? SPI_RXFIFO_THRESHOLD_HF : SPI_RXFIFO_THRESHOLD_QF))          \
+  }
+
+/**
+  * @}
+  */
+
 /* Exported functions --------------------------------------------------------*/
 /** @addtogroup SPIEx_Exported_Functions
   * @{
   */
 
 /* Initialization and de-initialization functions  ****************************/
+/** @addtogroup SPIEx_Exported_Functions_Group2
+  * @{
+  */
+HAL_StatusTypeDef HAL_SPIEx_InitConst(SPI_HandleTypeDef *hspi, const SPI_ConstInitTypeDef *pConfig);
+/**
+  * @}
+  */
+
 /* IO operation functions *****************************************************/
 /** @addtogroup SPIEx_Exported_Functions_Group1
   * @{
@@ -57,6 +131,24 @@ HAL_StatusTypeDef HAL_SPIEx_FlushRxFifo(SPI_HandleTypeDef *hspi);
   * @}
   */
 
+/* Private macros ------------------------------------------------------------*/
+/** @defgroup SPIEx_Private_Macros SPIEx Private Macros
+  * @{
+  */
+
+/** @brief  Baud rate prescaler applied by the constant configuration: forced to 2 in
+  *         slave mode, as the slave clock is not used.
+  * @param  __MODE__ Value of @ref SPI_Mode.
+  * @param  __BAUDRATEPRESCALER__ Value of @ref SPI_BaudRate_Prescaler.
+  * @retval Value of @ref SPI_BaudRate_Prescaler
+  */
+#define SPI_CONST_BAUDRATEPRESCALER(__MODE__, __BAUDRATEPRESCALER__)                                     \
+  (((__MODE__) == SPI_MODE_MASTER) ? (__BAUDRATEPRESCALER__) : SPI_BAUDRATEPRESCALER_2)
+
+/**
+  * @}
+  */
+
 /**
   * @}
   */
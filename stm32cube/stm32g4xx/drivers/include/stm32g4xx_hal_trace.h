@@ -0,0 +1,197 @@
+/**
+  ******************************************************************************
+  * @file    stm32g4xx_hal_trace.h
+  * @brief   Header file of the HAL trace hooks.
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32G4xx_HAL_TRACE_H
+#define STM32G4xx_HAL_TRACE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32g4xx.h"
+
+/** @addtogroup STM32G4xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup HAL
+  * @{
+  */
+
+/** @defgroup HAL_Trace HAL Trace
+  * @brief    Entry and exit records of the HAL APIs, IRQ handlers and wait loops.
+  *           Enabled by defining USE_HAL_TRACE to 1U, the hooks are empty otherwise.
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup HAL_Trace_Exported_Constants HAL Trace Exported Constants
+  * @{
+  */
+
+#if !defined(USE_HAL_TRACE)
+#define USE_HAL_TRACE               0U
+#endif /* USE_HAL_TRACE */
+
+#if !defined(HAL_TRACE_DEPTH)
+#define HAL_TRACE_DEPTH             256U   /*!< Number of records, power of 2.
+                                                May be overridden in stm32g4xx_hal_conf.h */
+#endif /* HAL_TRACE_DEPTH */
+
+/* HAL_TraceRecord() takes the record index modulo HAL_TRACE_DEPTH with a mask */
+#if ((HAL_TRACE_DEPTH) == 0U) || (((HAL_TRACE_DEPTH) & ((HAL_TRACE_DEPTH) - 1U)) != 0U)
+#error "HAL_TRACE_DEPTH should be a power of 2"
+#endif /* HAL_TRACE_DEPTH */
+
+#define HAL_TRACE_MAGIC             0x43525448U  /*!< "HTRC", start of the HAL_Trace structure in a memory dump */
+
+/** @defgroup HAL_Trace_Event HAL Trace event
+  * @{
+  */
+#define HAL_TRACE_EVENT_ENTER       0x00U   /*!< Function entered  */
+#define HAL_TRACE_EVENT_EXIT        0x01U   /*!< Function returned */
+/**
+  * @}
+  */
+
+/** @defgroup HAL_Trace_Id HAL Trace function identifiers
+  * @brief    Module in the upper byte, function in the lower byte.
+  *           Parsed by the host decoder, keep one definition per line.
+  * @{
+  */
+#define HAL_TRACE_ID_HAL_DELAY                        0x0101U
+#define HAL_TRACE_ID_DMA_START                        0x0201U
+#define HAL_TRACE_ID_DMA_START_IT                     0x0202U
+#define HAL_TRACE_ID_DMA_POLLFORTRANSFER              0x0203U
+#define HAL_TRACE_ID_DMA_IRQHANDLER                   0x0204U
+#define HAL_TRACE_ID_GPIO_EXTI_IRQHANDLER             0x0301U
+#define HAL_TRACE_ID_ADC_START                        0x0401U
+#define HAL_TRACE_ID_ADC_POLLFORCONVERSION            0x0402U
+#define HAL_TRACE_ID_ADC_START_DMA                    0x0403U
+#define HAL_TRACE_ID_ADC_IRQHANDLER                   0x0404U
+#define HAL_TRACE_ID_I2C_MASTER_TRANSMIT              0x0501U
+#define HAL_TRACE_ID_I2C_MASTER_RECEIVE               0x0502U
+#define HAL_TRACE_ID_I2C_MEM_WRITE                    0x0503U
+#define HAL_TRACE_ID_I2C_MEM_READ                     0x0504U
+#define HAL_TRACE_ID_I2C_EV_IRQHANDLER                0x0505U
+#define HAL_TRACE_ID_I2C_ER_IRQHANDLER                0x0506U
+#define HAL_TRACE_ID_I2C_WAITONFLAGUNTILTIMEOUT       0x0507U
+#define HAL_TRACE_ID_I2C_WAITONTXISFLAGUNTILTIMEOUT   0x0508U
+#define HAL_TRACE_ID_I2C_WAITONSTOPFLAGUNTILTIMEOUT   0x0509U
+#define HAL_TRACE_ID_I2C_WAITONRXNEFLAGUNTILTIMEOUT   0x050AU
+#define HAL_TRACE_ID_SPI_TRANSMIT                     0x0601U
+#define HAL_TRACE_ID_SPI_RECEIVE                      0x0602U
+#define HAL_TRACE_ID_SPI_TRANSMITRECEIVE              0x0603U
+#define HAL_TRACE_ID_SPI_IRQHANDLER                   0x0604U
+#define HAL_TRACE_ID_SPI_WAITFLAGSTATEUNTILTIMEOUT    0x0605U
+#define HAL_TRACE_ID_SPI_WAITFIFOSTATEUNTILTIMEOUT    0x0606U
+#define HAL_TRACE_ID_UART_TRANSMIT                    0x0701U
+#define HAL_TRACE_ID_UART_RECEIVE                     0x0702U
+#define HAL_TRACE_ID_UART_IRQHANDLER                  0x0703U
+#define HAL_TRACE_ID_UART_WAITONFLAGUNTILTIMEOUT      0x0704U
+#define HAL_TRACE_ID_TIM_IRQHANDLER                   0x0801U
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#if (USE_HAL_TRACE == 1U)
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup HAL_Trace_Exported_Types HAL Trace Exported Types
+  * @{
+  */
+
+/**
+  * @brief  HAL trace record
+  */
+typedef struct
+{
+  uint32_t Cycles;      /*!< DWT cycle counter                                       */
+  uint32_t Handle;      /*!< Address of the handle, 0 when the function has none     */
+  uint16_t Id;          /*!< Function, a value of @ref HAL_Trace_Id                  */
+  uint8_t  Event;       /*!< A value of @ref HAL_Trace_Event                         */
+  uint8_t  Context;     /*!< Active exception number (IPSR), 0 in thread mode        */
+} HAL_TraceRecordTypeDef;
+
+/**
+  * @brief  HAL trace buffer, a ring overwriting its oldest records
+  */
+typedef struct
+{
+  uint32_t                Magic;                      /*!< HAL_TRACE_MAGIC once initialized            */
+  uint32_t                Depth;                      /*!< Number of records, HAL_TRACE_DEPTH          */
+  uint32_t                CoreClock;                  /*!< SystemCoreClock at initialization, in Hz    */
+  __IO uint32_t           Enable;                     /*!< Records taken when not 0                    */
+  __IO uint32_t           Index;                      /*!< Records taken since the initialization      */
+  HAL_TraceRecordTypeDef  Records[HAL_TRACE_DEPTH];   /*!< Record Index is at Index % HAL_TRACE_DEPTH  */
+} HAL_TraceTypeDef;
+
+/**
+  * @}
+  */
+
+extern HAL_TraceTypeDef HAL_Trace;
+#endif /* USE_HAL_TRACE */
+
+/* Exported macros -----------------------------------------------------------*/
+/** @defgroup HAL_Trace_Exported_Macros HAL Trace Exported Macros
+  * @{
+  */
+
+#if (USE_HAL_TRACE == 1U)
+#define HAL_TRACE_ENTER(__ID__, __HANDLE__) HAL_TraceRecord((__ID__), (__HANDLE__), HAL_TRACE_EVENT_ENTER)
+#define HAL_TRACE_EXIT(__ID__, __HANDLE__)  HAL_TraceRecord((__ID__), (__HANDLE__), HAL_TRACE_EVENT_EXIT)
+#else
+#define HAL_TRACE_ENTER(__ID__, __HANDLE__) ((void)0U)
+#define HAL_TRACE_EXIT(__ID__, __HANDLE__)  ((void)0U)
+#endif /* USE_HAL_TRACE */
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+#if (USE_HAL_TRACE == 1U)
+/** @defgroup HAL_Trace_Exported_Functions HAL Trace Exported Functions
+  * @{
+  */
+void HAL_TraceInit(void);
+void HAL_TraceStart(void);
+void HAL_TraceStop(void);
+void HAL_TraceRecord(uint32_t Id, const void *pHandle, uint32_t Event);
+/**
+  * @}
+  */
+#endif /* USE_HAL_TRACE */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32G4xx_HAL_TRACE_H */
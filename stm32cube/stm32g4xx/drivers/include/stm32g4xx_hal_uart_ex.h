@@ -56,6 +56,25 @@ typedef struct
   uint8_t Address;             /*!< UART/USART node address (7-bit long max). */
 } UART_WakeUpTypeDef;
 
+/**
+  * @brief  UART constant configuration, built at compile time by UART_CONST_INIT() or
+  *         LPUART_CONST_INIT() and applied by HAL_UARTEx_InitConst()
+  */
+typedef struct
+{
+  UART_InitTypeDef Init;       /*!< Communication parameters, copied to the handle Init field. */
+
+  uint32_t CR1;                /*!< CR1 register value, USART_CR1_UE excluded. */
+
+  uint32_t CR2;                /*!< CR2 register value. */
+
+  uint32_t CR3;                /*!< CR3 register value. */
+
+  uint32_t BRR;                /*!< BRR register value. */
+
+  uint32_t PRESC;              /*!< PRESC register value. */
+} UART_ConstInitTypeDef;
+
 /**
   * @}
   */
@@ -127,6 +146,74 @@ typedef struct
   */
 
 /* Exported macros -----------------------------------------------------------*/
+/** @defgroup UARTEx_Exported_Macros UARTEx Exported Macros
+  * @{
+  */
+
+/** @brief  Build the constant configuration of a USART or UART instance, to initialize
+  *         a static const UART_ConstInitTypeDef.
+  * @note   The arguments must be constant expressions: the register values, baud rate
+  *         divider included, are then computed by the compiler.
+  * @param  __KERCLK__ Kernel clock frequency of the instance in Hz, as configured in RCC
+  *         when HAL_UARTEx_InitConst() is called.
+  * @param  __BAUDRATE__ Baud rate.
+  * @param  __WORDLENGTH__ Value of @ref UARTEx_Word_Length.
+  * @param  __STOPBITS__ Value of @ref UART_Stop_Bits.
+  * @param  __PARITY__ Value of @ref UART_Parity.
+  * @param  __MODE__ Value of @ref UART_Mode.
+  * @param  __HWFLOWCTL__ Value of @ref UART_Hardware_Flow_Control.
+  * @param  __OVERSAMPLING__ Value of @ref UART_Over_Sampling.
+  * @param  __ONEBITSAMPLING__ Value of @ref UART_OneBit_Sampling.
+  * @param  __PRESCALER__ Value of @ref UART_ClockPrescaler.
+  * @retval Initializer of a UART_ConstInitTypeDef
+  */
+#define UART_CONST_INIT(__KERCLK__, __BAUDRATE__, __WORDLENGTH__, __STOPBITS__, __PARITY__, __MODE__,    \
+                        __HWFLOWCTL__, __OVERSAMPLING__, __ONEBITSAMPLING__, __PRESCALER__)                \
+  {                                                                                                        \
+    {                                                                                                      \
+      (__BAUDRATE__), (__WORDLENGTH__), (__STOPBITS__), (__PARITY__), (__MODE__), (__HWFLOWCTL__),         \
+      (__OVERSAMPLING__), (__ONEBITSAMPLING__), (__PRESCALER__)                                            \
+    },                                                                                                     \
+    ((__WORDLENGTH__) | (__PARITY__) | (__MODE__) | (__OVERSAMPLING__)),                                   \
+    (__STOPBITS__),                                                                                        \
+    ((__HWFLOWCTL__) | (__ONEBITSAMPLING__)),                                                              \
+    UART_CONST_BRR((__KERCLK__), (__BAUDRATE__), (__OVERSAMPLING__), (__PRESCALER__)),                     \
+    (__PRESCALER__)                                                                                        \
+  }
+
+/** @brief  Build the constant configuration of a LPUART instance, to initialize
+  *         a static const UART_ConstInitTypeDef.
+  * @note   The arguments must be constant expressions: the register values, baud rate
+  *         divider included, are then computed by the compiler.
+  * @param  __KERCLK__ Kernel clock frequency of the instance in Hz, as configured in RCC
+  *         when HAL_UARTEx_InitConst() is called.
+  * @param  __BAUDRATE__ Baud rate.
+  * @param  __WORDLENGTH__ Value of @ref UARTEx_Word_Length.
+  * @param  __STOPBITS__ Value of @ref UART_Stop_Bits, UART_STOPBITS_1 or UART_STOPBITS_2.
+  * @param  __PARITY__ Value of @ref UART_Parity.
+  * @param  __MODE__ Value of @ref UART_Mode.
+  * @param  __HWFLOWCTL__ Value of @ref UART_Hardware_Flow_Control.
+  * @param  __PRESCALER__ Value of @ref UART_ClockPrescaler.
+  * @retval Initializer of a UART_ConstInitTypeDef
+  */
+#define LPUART_CONST_INIT(__KERCLK__, __BAUDRATE__, __WORDLENGTH__, __STOPBITS__, __PARITY__, __MODE__,  \
+                          __HWFLOWCTL__, __PRESCALER__)                                                    \
+  {                                                                                                        \
+    {                                                                                                      \
+      (__BAUDRATE__), (__WORDLENGTH__), (__STOPBITS__), (__PARITY__), (__MODE__), (__HWFLOWCTL__),         \
+      UART_OVERSAMPLING_16, UART_ONE_BIT_SAMPLE_DISABLE, (__PRESCALER__)                                   \
+    },                                                                                                     \
+    ((__WORDLENGTH__) | (__PARITY__) | (__MODE__)),                                                        \
+    (__STOPBITS__),                                                                                        \
+    (__HWFLOWCTL__),                                                                                       \
+    LPUART_CONST_BRR((__KERCLK__), (__BAUDRATE__), (__PRESCALER__)),                                       \
+    (__PRESCALER__)                                                                                        \
+  }
+
+/**
+  * @}
+  */
+
 /* Exported functions --------------------------------------------------------*/
 /** @addtogroup UARTEx_Exported_Functions
   * @{
@@ -139,6 +226,7 @@ typedef struct
 /* Initialization and de-initialization functions  ****************************/
 HAL_StatusTypeDef HAL_RS485Ex_Init(UART_HandleTypeDef *huart, uint32_t Polarity, uint32_t AssertionTime,
                                    uint32_t DeassertionTime);
+HAL_StatusTypeDef HAL_UARTEx_InitConst(UART_HandleTypeDef *huart, const UART_ConstInitTypeDef *pConfig);
 
 /**
   * @}
@@ -629,6 +717,47 @@ HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_
                                                  ((__THRESHOLD__) == UART_RXFIFO_THRESHOLD_7_8) || \
                                                  ((__THRESHOLD__) == UART_RXFIFO_THRESHOLD_8_8))
 
+/** @brief  BRR register value of a USART or UART, computed from constant parameters.
+  * @param  __KERCLK__ Kernel clock frequency of the instance in Hz.
+  * @param  __BAUDRATE__ Baud rate.
+  * @param  __OVERSAMPLING__ Value of @ref UART_Over_Sampling.
+  * @param  __PRESCALER__ Value of @ref UART_ClockPrescaler.
+  * @retval BRR register value
+  */
+#define UART_CONST_BRR(__KERCLK__, __BAUDRATE__, __OVERSAMPLING__, __PRESCALER__)                       \
+  (((__OVERSAMPLING__) == UART_OVERSAMPLING_8) ?                                                         \
+   ((UART_CONST_DIV_SAMPLING8((__KERCLK__), (__BAUDRATE__), (__PRESCALER__)) & 0xFFF0U) |                \
+    ((UART_CONST_DIV_SAMPLING8((__KERCLK__), (__BAUDRATE__), (__PRESCALER__)) & 0x000FU) >> 1U)) :       \
+   UART_CONST_DIV_SAMPLING16((__KERCLK__), (__BAUDRATE__), (__PRESCALER__)))
+
+/** @brief  USARTDIV in 8-bit oversampling mode, computed from constant parameters.
+  * @param  __KERCLK__ Kernel clock frequency of the instance in Hz.
+  * @param  __BAUDRATE__ Baud rate.
+  * @param  __PRESCALER__ Value of @ref UART_ClockPrescaler.
+  * @retval USARTDIV value
+  */
+#define UART_CONST_DIV_SAMPLING8(__KERCLK__, __BAUDRATE__, __PRESCALER__)                               \
+  (((((__KERCLK__) / UART_GET_DIV_FACTOR(__PRESCALER__)) * 2U) + ((__BAUDRATE__) / 2U)) / (__BAUDRATE__))
+
+/** @brief  USARTDIV in 16-bit oversampling mode, computed from constant parameters.
+  * @param  __KERCLK__ Kernel clock frequency of the instance in Hz.
+  * @param  __BAUDRATE__ Baud rate.
+  * @param  __PRESCALER__ Value of @ref UART_ClockPrescaler.
+  * @retval USARTDIV value
+  */
+#define UART_CONST_DIV_SAMPLING16(__KERCLK__, __BAUDRATE__, __PRESCALER__)                              \
+  ((((__KERCLK__) / UART_GET_DIV_FACTOR(__PRESCALER__)) + ((__BAUDRATE__) / 2U)) / (__BAUDRATE__))
+
+/** @brief  BRR register value of a LPUART, computed from constant parameters.
+  * @param  __KERCLK__ Kernel clock frequency of the instance in Hz.
+  * @param  __BAUDRATE__ Baud rate.
+  * @param  __PRESCALER__ Value of @ref UART_ClockPrescaler.
+  * @retval BRR register value
+  */
+#define LPUART_CONST_BRR(__KERCLK__, __BAUDRATE__, __PRESCALER__)                                       \
+  ((uint32_t)((((((uint64_t)(__KERCLK__)) / UART_GET_DIV_FACTOR(__PRESCALER__)) * 256U) +               \
+               (uint32_t)((__BAUDRATE__) / 2U)) / (__BAUDRATE__)))
+
 /**
   * @}
   */
@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************
+  * @file    stm32g4xx_hal_wait.h
+  * @brief   Header file of the HAL wait strategy.
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32G4xx_HAL_WAIT_H
+#define STM32G4xx_HAL_WAIT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32g4xx_hal_def.h"
+
+/** @addtogroup STM32G4xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup HAL
+  * @{
+  */
+
+/** @defgroup HAL_Wait HAL Wait strategy
+  * @brief    How the blocking HAL APIs wait for a peripheral flag.
+  *           Enabled by defining USE_HAL_WAIT_STRATEGY to 1U, the wait loops
+  *           busy-poll otherwise.
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup HAL_Wait_Exported_Constants HAL Wait Exported Constants
+  * @{
+  */
+
+#if !defined(USE_HAL_WAIT_STRATEGY)
+#define USE_HAL_WAIT_STRATEGY       0U
+#endif /* USE_HAL_WAIT_STRATEGY */
+
+/**
+  * @}
+  */
+
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup HAL_Wait_Exported_Types HAL Wait Exported Types
+  * @{
+  */
+
+/**
+  * @brief  HAL wait strategy, the services of the RTOS the blocking HAL APIs wait with
+  */
+typedef struct
+{
+  void (* Wait)(const void *pObject, uint32_t Timeout);  /*!< Block the calling thread until Signal() is called with
+                                                              the same object or Timeout ticks elapsed, HAL_MAX_DELAY
+                                                              waiting forever. A Signal() preceding the Wait() is not
+                                                              to be lost, typically a binary semaphore per object   */
+  void (* Signal)(const void *pObject);                  /*!< Wake the thread waiting on the object, called from the
+                                                              peripheral interrupt handler                          */
+  void (* Yield)(void);                                  /*!< Let the other ready threads run, called by the wait
+                                                              loops of the flags without interrupt. May be NULL     */
+} HAL_WaitStrategyTypeDef;
+
+/**
+  * @}
+  */
+#endif /* USE_HAL_WAIT_STRATEGY */
+
+/* Exported macros -----------------------------------------------------------*/
+/** @defgroup HAL_Wait_Exported_Macros HAL Wait Exported Macros
+  * @{
+  */
+
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+#define HAL_WAIT_YIELD()    HAL_WaitYield()
+#else
+#define HAL_WAIT_YIELD()    ((void)0U)
+#endif /* USE_HAL_WAIT_STRATEGY */
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+/** @defgroup HAL_Wait_Exported_Functions HAL Wait Exported Functions
+  * @{
+  */
+HAL_StatusTypeDef HAL_WaitSetStrategy(const HAL_WaitStrategyTypeDef *pStrategy);
+uint32_t HAL_WaitIsBlocking(void);
+void HAL_WaitBlock(const void *pObject, uint32_t Tickstart, uint32_t Timeout);
+void HAL_WaitSignal(const void *pObject);
+void HAL_WaitYield(void);
+/**
+  * @}
+  */
+#endif /* USE_HAL_WAIT_STRATEGY */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32G4xx_HAL_WAIT_H */
@@ -174,6 +174,32 @@ typedef struct
   */
 #endif /* USE_FULL_LL_DRIVER */
 
+/** @defgroup USART_LL_ES_CONST_INIT USART Exported Constant Init structure
+  * @{
+  */
+
+/**
+  * @brief LL USART constant configuration, built at compile time by LL_USART_CONST_INIT()
+  *        and applied by LL_USART_ConstInit()
+  */
+typedef struct
+{
+  uint32_t CR1;                       /*!< CR1 register value, USART_CR1_UE excluded. */
+
+  uint32_t CR2;                       /*!< CR2 register value. */
+
+  uint32_t CR3;                       /*!< CR3 register value. */
+
+  uint32_t BRR;                       /*!< BRR register value. */
+
+  uint32_t PRESC;                     /*!< PRESC register value. */
+
+} LL_USART_ConstInitTypeDef;
+
+/**
+  * @}
+  */
+
 /* Exported constants --------------------------------------------------------*/
 /** @defgroup USART_LL_Exported_Constants USART Exported Constants
   * @{
@@ -601,6 +627,69 @@ typedef struct
   ((((__PERIPHCLK__)/(USART_PRESCALER_TAB[(__PRESCALER__)]))\
     + ((__BAUDRATE__)/2U))/(__BAUDRATE__))
 
+/**
+  * @brief  Get the division factor of a prescaler, as a constant expression
+  * @param  __PRESCALER__ Value of @ref USART_LL_EC_PRESCALER
+  * @retval Division factor (1 to 256)
+  */
+#define __LL_USART_PRESCALER_DIV(__PRESCALER__) \
+  (((__PRESCALER__) == LL_USART_PRESCALER_DIV1)   ? 1U   : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV2)   ? 2U   : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV4)   ? 4U   : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV6)   ? 6U   : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV8)   ? 8U   : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV10)  ? 10U  : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV12)  ? 12U  : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV16)  ? 16U  : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV32)  ? 32U  : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV64)  ? 64U  : \
+   ((__PRESCALER__) == LL_USART_PRESCALER_DIV128) ? 128U : 256U)
+
+/**
+  * @brief  Compute the BRR register value, as a constant expression, according to
+  *         Peripheral Clock, prescaler, oversampling and expected Baud Rate
+  * @note   Same value as written by @ref LL_USART_SetBaudRate().
+  * @param  __PERIPHCLK__ Peripheral Clock frequency used for USART instance
+  * @param  __PRESCALER__ Value of @ref USART_LL_EC_PRESCALER
+  * @param  __OVERSAMPLING__ Value of @ref USART_LL_EC_OVERSAMPLING
+  * @param  __BAUDRATE__ Baud rate value to achieve
+  * @retval BRR register value
+  */
+#define __LL_USART_CONST_BRR(__PERIPHCLK__, __PRESCALER__, __OVERSAMPLING__, __BAUDRATE__) \
+  (((__OVERSAMPLING__) == LL_USART_OVERSAMPLING_8) ? \
+   (((((((__PERIPHCLK__) / __LL_USART_PRESCALER_DIV(__PRESCALER__)) * 2U) \
+       + ((__BAUDRATE__) / 2U)) / (__BAUDRATE__)) & 0xFFF0U) | \
+    ((((((__PERIPHCLK__) / __LL_USART_PRESCALER_DIV(__PRESCALER__)) * 2U) \
+       + ((__BAUDRATE__) / 2U)) / (__BAUDRATE__) & 0x000FU) >> 1U)) : \
+   ((((__PERIPHCLK__) / __LL_USART_PRESCALER_DIV(__PRESCALER__)) \
+     + ((__BAUDRATE__) / 2U)) / (__BAUDRATE__) & 0xFFFFU))
+
+/**
+  * @brief  Build the constant configuration of an USART in asynchronous mode, to
+  *         initialize a static const LL_USART_ConstInitTypeDef
+  * @note   The arguments must be constant expressions: the register values, baud rate
+  *         divider included, are then computed by the compiler.
+  * @param  __PERIPHCLK__ Peripheral Clock frequency used for USART instance
+  * @param  __PRESCALER__ Value of @ref USART_LL_EC_PRESCALER
+  * @param  __BAUDRATE__ Baud rate value to achieve
+  * @param  __DATAWIDTH__ Value of @ref USART_LL_EC_DATAWIDTH
+  * @param  __STOPBITS__ Value of @ref USART_LL_EC_STOPBITS
+  * @param  __PARITY__ Value of @ref USART_LL_EC_PARITY
+  * @param  __DIRECTION__ Value of @ref USART_LL_EC_DIRECTION
+  * @param  __HWCONTROL__ Value of @ref USART_LL_EC_HWCONTROL
+  * @param  __OVERSAMPLING__ Value of @ref USART_LL_EC_OVERSAMPLING
+  * @retval Initializer of a LL_USART_ConstInitTypeDef
+  */
+#define LL_USART_CONST_INIT(__PERIPHCLK__, __PRESCALER__, __BAUDRATE__, __DATAWIDTH__, __STOPBITS__, \
+                            __PARITY__, __DIRECTION__, __HWCONTROL__, __OVERSAMPLING__) \
+  { \
+    ((__DATAWIDTH__) | (__PARITY__) | (__DIRECTION__) | (__OVERSAMPLING__)), \
+    (__STOPBITS__), \
+    (__HWCONTROL__), \
+    __LL_USART_CONST_BRR((__PERIPHCLK__), (__PRESCALER__), (__OVERSAMPLING__), (__BAUDRATE__)), \
+    (__PRESCALER__) \
+  }
+
 /**
   * @}
   */
@@ -2003,6 +2092,39 @@ __STATIC_INLINE uint32_t LL_USART_GetBlockLength(USART_TypeDef *USARTx)
   return (uint32_t)(READ_BIT(USARTx->RTOR, USART_RTOR_BLEN) >> USART_RTOR_BLEN_Pos);
 }
 
+/**
+  * @brief  Configure the USART in asynchronous mode from a constant configuration,
+  *         writing each configuration register once
+  * @note   The configuration is built at compile time by @ref LL_USART_CONST_INIT().
+  * @note   CR1, CR2, CR3, BRR and PRESC are written whole: the features not set by
+  *         @ref LL_USART_CONST_INIT() are disabled.
+  * @note   The USART must be disabled (UE=0) and is left disabled: enable it with
+  *         @ref LL_USART_Enable().
+  * @rmtoll PRESC        PRESCALER     LL_USART_ConstInit\n
+  *         BRR          BRR           LL_USART_ConstInit\n
+  *         CR2          STOP          LL_USART_ConstInit\n
+  *         CR3          RTSE          LL_USART_ConstInit\n
+  *         CR3          CTSE          LL_USART_ConstInit\n
+  *         CR1          M0            LL_USART_ConstInit\n
+  *         CR1          M1            LL_USART_ConstInit\n
+  *         CR1          PCE           LL_USART_ConstInit\n
+  *         CR1          PS            LL_USART_ConstInit\n
+  *         CR1          TE            LL_USART_ConstInit\n
+  *         CR1          RE            LL_USART_ConstInit\n
+  *         CR1          OVER8         LL_USART_ConstInit
+  * @param  USARTx USART Instance
+  * @param  USART_ConstInit pointer to the constant configuration
+  * @retval None
+  */
+__STATIC_INLINE void LL_USART_ConstInit(USART_TypeDef *USARTx, const LL_USART_ConstInitTypeDef *USART_ConstInit)
+{
+  WRITE_REG(USARTx->PRESC, USART_ConstInit->PRESC);
+  WRITE_REG(USARTx->BRR, USART_ConstInit->BRR);
+  WRITE_REG(USARTx->CR2, USART_ConstInit->CR2);
+  WRITE_REG(USARTx->CR3, USART_ConstInit->CR3);
+  WRITE_REG(USARTx->CR1, USART_ConstInit->CR1);
+}
+
 /**
   * @}
   */
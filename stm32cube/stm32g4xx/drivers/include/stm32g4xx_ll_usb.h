@@ -122,6 +122,9 @@ typedef struct
 
   uint8_t   xfer_fill_db;     /*!< double buffer Need to Fill new buffer  used with bulk_in                */
 
+  uint8_t   xfer_sof;         /*!< SOFs seen since the isochronous IN transfer was armed or the OUT transfer
+                                   got a packet, up to 2, 0 when not watched                              */
+
 } USB_EPTypeDef;
 
 
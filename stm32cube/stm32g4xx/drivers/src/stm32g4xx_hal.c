@@ -85,10 +85,20 @@
 __IO uint32_t uwTick;
 uint32_t uwTickPrio = (1UL << __NVIC_PRIO_BITS); /* Invalid PRIO */
 uint32_t uwTickFreq = HAL_TICK_FREQ_DEFAULT;  /* 1KHz */
+#if defined(USE_HAL_ATOMIC_LOCK) && (USE_HAL_ATOMIC_LOCK == 1U)
+volatile HAL_LockStatsTypeDef HAL_LockStats;
+#endif /* USE_HAL_ATOMIC_LOCK */
+#if (USE_HAL_TRACE == 1U)
+HAL_TraceTypeDef HAL_Trace;
+#endif /* USE_HAL_TRACE */
 /**
   * @}
   */
 
+/* Private variables ---------------------------------------------------------*/
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+static const HAL_WaitStrategyTypeDef *pHalWaitStrategy = NULL;
+#endif /* USE_HAL_WAIT_STRATEGY */
 /* Private function prototypes -----------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 
@@ -401,6 +411,8 @@ __weak void HAL_Delay(uint32_t Delay)
   uint32_t tickstart = HAL_GetTick();
   uint32_t wait = Delay;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_HAL_DELAY, NULL);
+
   /* Add a freq to guarantee minimum wait */
   if (wait < HAL_MAX_DELAY)
   {
@@ -410,6 +422,8 @@ __weak void HAL_Delay(uint32_t Delay)
   while ((HAL_GetTick() - tickstart) < wait)
   {
   }
+
+  HAL_TRACE_EXIT(HAL_TRACE_ID_HAL_DELAY, NULL);
 }
 
 /**
@@ -757,6 +771,250 @@ void HAL_SYSCFG_CCMSRAM_WriteProtectionEnable(uint32_t Page)
   * @}
   */
 
+#if (USE_HAL_TRACE == 1U)
+/** @defgroup HAL_Exported_Functions_Group5 HAL Trace functions
+  *  @brief    HAL Trace functions
+  *
+@verbatim
+ ===============================================================================
+                      ##### HAL Trace functions #####
+ ===============================================================================
+    [..]
+      When USE_HAL_TRACE is 1U, the HAL APIs, IRQ handlers and wait loops
+      instrumented record their entry and exit in HAL_Trace, with the DWT cycle
+      counter and the active exception number.
+      (+) HAL_TraceInit() clears HAL_Trace, starts the DWT cycle counter and
+          starts recording.
+      (+) HAL_TraceStop() and HAL_TraceStart() suspend and resume recording.
+      (+) HAL_Trace is a ring keeping the last HAL_TRACE_DEPTH records. Once
+          stopped, it is dumped by a debugger and converted by the
+          scripts/hal_trace.py host decoder.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize the HAL trace and start recording.
+  * @note   SystemCoreClock is saved to convert the cycles in time, the trace
+  *         is to be initialized once the system clock is configured.
+  * @retval None
+  */
+void HAL_TraceInit(void)
+{
+  uint32_t index;
+
+  HAL_Trace.Enable = 0U;
+  HAL_Trace.Index = 0U;
+  for (index = 0U; index < HAL_TRACE_DEPTH; index++)
+  {
+    HAL_Trace.Records[index].Cycles = 0U;
+    HAL_Trace.Records[index].Handle = 0U;
+    HAL_Trace.Records[index].Id = 0U;
+    HAL_Trace.Records[index].Event = 0U;
+    HAL_Trace.Records[index].Context = 0U;
+  }
+  HAL_Trace.Depth = HAL_TRACE_DEPTH;
+  HAL_Trace.CoreClock = SystemCoreClock;
+  HAL_Trace.Magic = HAL_TRACE_MAGIC;
+
+  SET_BIT(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);
+  SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);
+
+  HAL_Trace.Enable = 1U;
+}
+
+/**
+  * @brief  Resume the HAL trace recording.
+  * @retval None
+  */
+void HAL_TraceStart(void)
+{
+  HAL_Trace.Enable = 1U;
+}
+
+/**
+  * @brief  Suspend the HAL trace recording.
+  * @retval None
+  */
+void HAL_TraceStop(void)
+{
+  HAL_Trace.Enable = 0U;
+}
+
+/**
+  * @brief  Add a record to the HAL trace.
+  * @note   Called through HAL_TRACE_ENTER() and HAL_TRACE_EXIT(). The record
+  *         slot is reserved with exclusive accesses, so that records may be
+  *         added from any context without masking the interrupts.
+  * @param  Id Function, a value of @ref HAL_Trace_Id
+  * @param  pHandle Handle of the function, NULL if none
+  * @param  Event A value of @ref HAL_Trace_Event
+  * @retval None
+  */
+void HAL_TraceRecord(uint32_t Id, const void *pHandle, uint32_t Event)
+{
+  HAL_TraceRecordTypeDef *p_record;
+  uint32_t index;
+  uint32_t cycles;
+  uint32_t context;
+
+  if (HAL_Trace.Enable == 0U)
+  {
+    return;
+  }
+
+  /* Sampled with the index reservation: an interrupt in between makes the
+     store fail and the sampling start again, so the cycle counts follow the
+     record order */
+  do
+  {
+    index = __LDREXW(&HAL_Trace.Index);
+    cycles = DWT->CYCCNT;
+    context = __get_IPSR();
+  } while (__STREXW(index + 1U, &HAL_Trace.Index) != 0U);
+
+  p_record = &HAL_Trace.Records[index & (HAL_TRACE_DEPTH - 1U)];
+  p_record->Cycles = cycles;
+  p_record->Handle = (uint32_t)pHandle;
+  p_record->Id = (uint16_t)Id;
+  p_record->Event = (uint8_t)Event;
+  p_record->Context = (uint8_t)context;
+}
+
+/**
+  * @}
+  */
+#endif /* USE_HAL_TRACE */
+
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+/** @defgroup HAL_Exported_Functions_Group6 HAL Wait strategy functions
+  *  @brief    HAL Wait strategy functions
+  *
+@verbatim
+ ===============================================================================
+                   ##### HAL Wait strategy functions #####
+ ===============================================================================
+    [..]
+      When USE_HAL_WAIT_STRATEGY is 1U, the blocking HAL APIs called from a
+      thread wait for the peripheral flags with the strategy registered by
+      HAL_WaitSetStrategy(), and busy-poll until one is registered.
+      (+) The drivers able to interrupt on the awaited flag enable its interrupt,
+          block the thread with HAL_WaitBlock() and signal it from their IRQ
+          handler with HAL_WaitSignal().
+      (+) The other wait loops call HAL_WaitYield() on each poll.
+      (+) Called from an interrupt handler or with the interrupts masked, the
+          wait loops busy-poll.
+    [..]
+      The strategy of an RTOS gives, for example, Wait() taking a binary
+      semaphore associated to the object with a timeout, Signal() giving it,
+      and Yield() yielding the thread.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Register the wait strategy of the blocking HAL APIs.
+  * @param  pStrategy Wait strategy, NULL to busy-poll.
+  *         The structure is used in place and is to remain valid.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_WaitSetStrategy(const HAL_WaitStrategyTypeDef *pStrategy)
+{
+  if (pStrategy != NULL)
+  {
+    if ((pStrategy->Wait == NULL) || (pStrategy->Signal == NULL))
+    {
+      return HAL_ERROR;
+    }
+  }
+
+  pHalWaitStrategy = pStrategy;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Tell if the caller can block on a peripheral event.
+  * @retval 1 when a strategy is registered and the caller is a thread with the
+  *         interrupts enabled, 0 otherwise.
+  */
+uint32_t HAL_WaitIsBlocking(void)
+{
+  if ((pHalWaitStrategy == NULL) || (__get_IPSR() != 0U) || (__get_PRIMASK() != 0U))
+  {
+    return 0U;
+  }
+
+  return 1U;
+}
+
+/**
+  * @brief  Block the calling thread until the object is signaled or the timeout.
+  * @note   To be called once HAL_WaitIsBlocking() returned 1, the interrupt
+  *         of the awaited event enabled. The caller checks again its flag and
+  *         its timeout once returned, the wake up may be spurious.
+  * @param  pObject Object waited, the peripheral handle.
+  * @param  Tickstart Tick start value of the timeout.
+  * @param  Timeout Timeout duration, HAL_MAX_DELAY waiting forever.
+  * @retval None
+  */
+void HAL_WaitBlock(const void *pObject, uint32_t Tickstart, uint32_t Timeout)
+{
+  uint32_t elapsed;
+  uint32_t remaining = HAL_MAX_DELAY;
+
+  if (Timeout != HAL_MAX_DELAY)
+  {
+    elapsed = HAL_GetTick() - Tickstart;
+    if (elapsed > Timeout)
+    {
+      return;
+    }
+    /* One more tick for the timeout checks of the callers, elapsed > Timeout */
+    remaining = (Timeout - elapsed) + 1U;
+  }
+
+  pHalWaitStrategy->Wait(pObject, remaining);
+}
+
+/**
+  * @brief  Wake the thread blocked on the object.
+  * @note   Called from the interrupt handler of the peripheral.
+  * @param  pObject Object signaled, the peripheral handle.
+  * @retval None
+  */
+void HAL_WaitSignal(const void *pObject)
+{
+  if (pHalWaitStrategy != NULL)
+  {
+    pHalWaitStrategy->Signal(pObject);
+  }
+}
+
+/**
+  * @brief  Let the other threads run while polling a flag.
+  * @note   Does nothing when no strategy or no Yield() is registered, or when
+  *         the caller cannot block.
+  * @retval None
+  */
+void HAL_WaitYield(void)
+{
+  if (HAL_WaitIsBlocking() != 0U)
+  {
+    if (pHalWaitStrategy->Yield != NULL)
+    {
+      pHalWaitStrategy->Yield();
+    }
+  }
+}
+
+/**
+  * @}
+  */
+#endif /* USE_HAL_WAIT_STRATEGY */
+
 /**
   * @}
   */
@@ -1225,6 +1225,8 @@ HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc)
   uint32_t tmp_multimode_config = LL_ADC_GetMultimode(__LL_ADC_COMMON_INSTANCE(hadc->Instance));
 #endif
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_ADC_START, hadc);
+
   /* Check the parameters */
   assert_param(IS_ADC_ALL_INSTANCE(hadc->Instance));
 
@@ -1232,7 +1234,7 @@ HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc)
   if (LL_ADC_REG_IsConversionOngoing(hadc->Instance) == 0UL)
   {
     /* Process locked */
-    __HAL_LOCK(hadc);
+    __HAL_LOCK_TRACE(hadc, HAL_TRACE_ID_ADC_START);
 
     /* Enable the ADC peripheral */
     tmp_hal_status = ADC_Enable(hadc);
@@ -1339,6 +1341,7 @@ HAL_StatusTypeDef HAL_ADC_Start(ADC_HandleTypeDef *hadc)
     tmp_hal_status = HAL_BUSY;
   }
 
+  HAL_TRACE_EXIT(HAL_TRACE_ID_ADC_START, hadc);
   /* Return function status */
   return tmp_hal_status;
 }
@@ -1416,6 +1419,8 @@ HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Ti
   uint32_t tmp_multimode_config = LL_ADC_GetMultimode(__LL_ADC_COMMON_INSTANCE(hadc->Instance));
 #endif
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_ADC_POLLFORCONVERSION, hadc);
+
   /* Check the parameters */
   assert_param(IS_ADC_ALL_INSTANCE(hadc->Instance));
 
@@ -1443,6 +1448,7 @@ HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Ti
       if (READ_BIT(hadc->Instance->CFGR, ADC_CFGR_DMAEN) != 0UL)
       {
         SET_BIT(hadc->State, HAL_ADC_STATE_ERROR_CONFIG);
+        HAL_TRACE_EXIT(HAL_TRACE_ID_ADC_POLLFORCONVERSION, hadc);
         return HAL_ERROR;
       }
       else
@@ -1456,6 +1462,7 @@ HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Ti
       if (LL_ADC_GetMultiDMATransfer(__LL_ADC_COMMON_INSTANCE(hadc->Instance)) != LL_ADC_MULTI_REG_DMA_EACH_ADC)
       {
         SET_BIT(hadc->State, HAL_ADC_STATE_ERROR_CONFIG);
+        HAL_TRACE_EXIT(HAL_TRACE_ID_ADC_POLLFORCONVERSION, hadc);
         return HAL_ERROR;
       }
       else
@@ -1468,6 +1475,7 @@ HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Ti
     if (READ_BIT(hadc->Instance->CFGR, ADC_CFGR_DMAEN) != 0UL)
     {
       SET_BIT(hadc->State, HAL_ADC_STATE_ERROR_CONFIG);
+      HAL_TRACE_EXIT(HAL_TRACE_ID_ADC_POLLFORCONVERSION, hadc);
       return HAL_ERROR;
     }
     else
@@ -1497,6 +1505,7 @@ HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Ti
           /* Process unlocked */
           __HAL_UNLOCK(hadc);
 
+          HAL_TRACE_EXIT(HAL_TRACE_ID_ADC_POLLFORCONVERSION, hadc);
           return HAL_TIMEOUT;
         }
       }
@@ -1565,6 +1574,7 @@ HAL_StatusTypeDef HAL_ADC_PollForConversion(ADC_HandleTypeDef *hadc, uint32_t Ti
     }
   }
 
+  HAL_TRACE_EXIT(HAL_TRACE_ID_ADC_POLLFORCONVERSION, hadc);
   /* Return function status */
   return HAL_OK;
 }
@@ -2005,6 +2015,8 @@ HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, ui
   uint32_t tmp_multimode_config = LL_ADC_GetMultimode(__LL_ADC_COMMON_INSTANCE(hadc->Instance));
 #endif
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_ADC_START_DMA, hadc);
+
   /* Check the parameters */
   assert_param(IS_ADC_ALL_INSTANCE(hadc->Instance));
 
@@ -2012,7 +2024,7 @@ HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, ui
   if (LL_ADC_REG_IsConversionOngoing(hadc->Instance) == 0UL)
   {
     /* Process locked */
-    __HAL_LOCK(hadc);
+    __HAL_LOCK_TRACE(hadc, HAL_TRACE_ID_ADC_START_DMA);
 
 #if defined(ADC_MULTIMODE_SUPPORT)
     /* Ensure that multimode regular conversions are not enabled.   */
@@ -2123,6 +2135,7 @@ HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, ui
     tmp_hal_status = HAL_BUSY;
   }
 
+  HAL_TRACE_EXIT(HAL_TRACE_ID_ADC_START_DMA, hadc);
   /* Return function status */
   return tmp_hal_status;
 }
@@ -2298,6 +2311,8 @@ void HAL_ADC_IRQHandler(ADC_HandleTypeDef *hadc)
   uint32_t tmp_multimode_config = LL_ADC_GetMultimode(__LL_ADC_COMMON_INSTANCE(hadc->Instance));
 #endif
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_ADC_IRQHANDLER, hadc);
+
   /* Check the parameters */
   assert_param(IS_ADC_ALL_INSTANCE(hadc->Instance));
   assert_param(IS_ADC_EOC_SELECTION(hadc->Init.EOCSelection));
@@ -2650,6 +2665,7 @@ void HAL_ADC_IRQHandler(ADC_HandleTypeDef *hadc)
 #endif /* USE_HAL_ADC_REGISTER_CALLBACKS */
   }
 
+  HAL_TRACE_EXIT(HAL_TRACE_ID_ADC_IRQHANDLER, hadc);
 }
 
 /**
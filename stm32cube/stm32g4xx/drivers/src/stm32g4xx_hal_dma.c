@@ -379,11 +379,13 @@ HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, ui
 {
   HAL_StatusTypeDef status = HAL_OK;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_DMA_START, hdma);
+
   /* Check the parameters */
   assert_param(IS_DMA_BUFFER_SIZE(DataLength));
 
   /* Process locked */
-  __HAL_LOCK(hdma);
+  __HAL_LOCK_TRACE(hdma, HAL_TRACE_ID_DMA_START);
 
   if (HAL_DMA_STATE_READY == hdma->State)
   {
@@ -406,6 +408,7 @@ HAL_StatusTypeDef HAL_DMA_Start(DMA_HandleTypeDef *hdma, uint32_t SrcAddress, ui
     __HAL_UNLOCK(hdma);
     status = HAL_BUSY;
   }
+  HAL_TRACE_EXIT(HAL_TRACE_ID_DMA_START, hdma);
   return status;
 }
 
@@ -423,11 +426,13 @@ HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress,
 {
   HAL_StatusTypeDef status = HAL_OK;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_DMA_START_IT, hdma);
+
   /* Check the parameters */
   assert_param(IS_DMA_BUFFER_SIZE(DataLength));
 
   /* Process locked */
-  __HAL_LOCK(hdma);
+  __HAL_LOCK_TRACE(hdma, HAL_TRACE_ID_DMA_START_IT);
 
   if (HAL_DMA_STATE_READY == hdma->State)
   {
@@ -479,6 +484,7 @@ HAL_StatusTypeDef HAL_DMA_Start_IT(DMA_HandleTypeDef *hdma, uint32_t SrcAddress,
     /* Remain BUSY */
     status = HAL_BUSY;
   }
+  HAL_TRACE_EXIT(HAL_TRACE_ID_DMA_START_IT, hdma);
   return status;
 }
 
@@ -614,11 +620,14 @@ HAL_StatusTypeDef HAL_DMA_PollForTransfer(DMA_HandleTypeDef *hdma, HAL_DMA_Level
   uint32_t temp;
   uint32_t tickstart;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_DMA_POLLFORTRANSFER, hdma);
+
   if (HAL_DMA_STATE_BUSY != hdma->State)
   {
     /* no transfer ongoing */
     hdma->ErrorCode = HAL_DMA_ERROR_NO_XFER;
     __HAL_UNLOCK(hdma);
+    HAL_TRACE_EXIT(HAL_TRACE_ID_DMA_POLLFORTRANSFER, hdma);
     return HAL_ERROR;
   }
 
@@ -626,6 +635,7 @@ HAL_StatusTypeDef HAL_DMA_PollForTransfer(DMA_HandleTypeDef *hdma, HAL_DMA_Level
   if (0U != (hdma->Instance->CCR & DMA_CCR_CIRC))
   {
     hdma->ErrorCode = HAL_DMA_ERROR_NOT_SUPPORTED;
+    HAL_TRACE_EXIT(HAL_TRACE_ID_DMA_POLLFORTRANSFER, hdma);
     return HAL_ERROR;
   }
 
@@ -663,6 +673,7 @@ HAL_StatusTypeDef HAL_DMA_PollForTransfer(DMA_HandleTypeDef *hdma, HAL_DMA_Level
       /* Process Unlocked */
       __HAL_UNLOCK(hdma);
 
+      HAL_TRACE_EXIT(HAL_TRACE_ID_DMA_POLLFORTRANSFER, hdma);
       return HAL_ERROR;
     }
     /* Check for the Timeout */
@@ -679,6 +690,7 @@ HAL_StatusTypeDef HAL_DMA_PollForTransfer(DMA_HandleTypeDef *hdma, HAL_DMA_Level
         /* Process Unlocked */
         __HAL_UNLOCK(hdma);
 
+        HAL_TRACE_EXIT(HAL_TRACE_ID_DMA_POLLFORTRANSFER, hdma);
         return HAL_ERROR;
       }
     }
@@ -729,6 +741,7 @@ HAL_StatusTypeDef HAL_DMA_PollForTransfer(DMA_HandleTypeDef *hdma, HAL_DMA_Level
   /* Process unlocked */
   __HAL_UNLOCK(hdma);
 
+  HAL_TRACE_EXIT(HAL_TRACE_ID_DMA_POLLFORTRANSFER, hdma);
   return HAL_OK;
 }
 
@@ -743,6 +756,8 @@ void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
   uint32_t flag_it = hdma->DmaBaseAddress->ISR;
   uint32_t source_it = hdma->Instance->CCR;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_DMA_IRQHANDLER, hdma);
+
   /* Half Transfer Complete Interrupt management ******************************/
   if ((0U != (flag_it & ((uint32_t)DMA_FLAG_HT1 << (hdma->ChannelIndex & 0x1FU)))) && (0U != (source_it & DMA_IT_HT)))
   {
@@ -819,6 +834,7 @@ void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
   {
     /* Nothing To Do */
   }
+  HAL_TRACE_EXIT(HAL_TRACE_ID_DMA_IRQHANDLER, hdma);
   return;
 }
 
@@ -8,6 +8,7 @@
   *          functionalities of the General Purpose Input/Output (EXTI) peripheral:
   *           + Initialization and de-initialization functions
   *           + IO operation functions
+  *           + Dispatch functions
   *
   ******************************************************************************
   * @attention
@@ -80,6 +81,20 @@
 
     (#) Generate software interrupt using HAL_EXTI_GenerateSWI().
 
+    (#) Serve several lines sharing an interrupt vector with a dispatcher.
+        (++) Initialize an EXTI_DispatchTypeDef structure with HAL_EXTI_DispatchInit().
+        (++) Register a callback and its context for each line with
+             HAL_EXTI_DispatchRegister(). All the lines of a dispatcher belong
+             to the same pending register.
+        (++) Call HAL_EXTI_DispatchIRQHandler() from the interrupt vectors. The
+             pending register is read and cleared once, then the callbacks of
+             the pending lines are called from the highest line to the lowest.
+        (++) Get the number of events and, when USE_HAL_EXTI_DISPATCH_DELAY
+             is set to 1U, the cycles elapsed from the dispatcher entry to the
+             callback of each line with HAL_EXTI_DispatchGetStats(). This dispatch
+             delay adds to the interrupt entry latency, which is not measured:
+             call the dispatcher first in the interrupt vector.
+
   @endverbatim
   */
 
@@ -620,6 +635,255 @@ void HAL_EXTI_GenerateSWI(EXTI_HandleTypeDef *hexti)
 }
 
 
+/**
+  * @}
+  */
+
+/** @addtogroup EXTI_Exported_Functions_Group3
+  *  @brief    Dispatch functions
+  *
+@verbatim
+ ===============================================================================
+                       ##### Dispatch functions #####
+ ===============================================================================
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize an Exti dispatcher, without any registered line.
+  * @note   When USE_HAL_EXTI_DISPATCH_DELAY is 1U, the DWT cycle counter is started.
+  * @param  hdispatch Exti dispatcher.
+  * @retval HAL Status.
+  */
+HAL_StatusTypeDef HAL_EXTI_DispatchInit(EXTI_DispatchTypeDef *hdispatch)
+{
+  uint32_t linepos;
+
+  /* Check null pointer */
+  if (hdispatch == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  hdispatch->Register = 0x00u;
+  hdispatch->Mask = 0x00u;
+
+  for (linepos = 0U; linepos < 32U; linepos++)
+  {
+    hdispatch->Entry[linepos].Callback = NULL;
+    hdispatch->Entry[linepos].pContext = NULL;
+    hdispatch->Entry[linepos].Line = 0x00u;
+  }
+
+  HAL_EXTI_DispatchResetStats(hdispatch);
+
+#if (USE_HAL_EXTI_DISPATCH_DELAY == 1U)
+  /* Start the cycle counter */
+  SET_BIT(CoreDebug->DEMCR, CoreDebug_DEMCR_TRCENA_Msk);
+  SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA_Msk);
+#endif /* USE_HAL_EXTI_DISPATCH_DELAY */
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Register the callback of a line in an Exti dispatcher.
+  * @param  hdispatch Exti dispatcher.
+  * @param  ExtiLine Exti line, a configurable line of @ref EXTI_Line from the
+  *         same pending register as the lines already registered.
+  * @param  pCallback function called on a pending event of the line.
+  * @param  pContext user context given to pCallback.
+  * @retval HAL Status.
+  */
+HAL_StatusTypeDef HAL_EXTI_DispatchRegister(EXTI_DispatchTypeDef *hdispatch, uint32_t ExtiLine,
+                                            void (* pCallback)(uint32_t Line, void *pContext), void *pContext)
+{
+  uint32_t offset;
+  uint32_t linepos;
+
+  /* Check null pointer */
+  if ((hdispatch == NULL) || (pCallback == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Check parameter */
+  assert_param(IS_EXTI_LINE(ExtiLine));
+
+  /* Direct lines have no pending bit */
+  if ((ExtiLine & EXTI_CONFIG) == 0x00u)
+  {
+    return HAL_ERROR;
+  }
+
+  /* Compute line register offset */
+  offset = ((ExtiLine & EXTI_REG_MASK) >> EXTI_REG_SHIFT);
+  /* Compute line position */
+  linepos = (ExtiLine & EXTI_PIN_MASK);
+
+  if ((hdispatch->Mask != 0x00u) && (hdispatch->Register != offset))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Fill the entry before the line is seen by the interrupt handler */
+  hdispatch->Entry[linepos].Callback = pCallback;
+  hdispatch->Entry[linepos].pContext = pContext;
+  hdispatch->Entry[linepos].Line = ExtiLine;
+  hdispatch->Register = offset;
+  hdispatch->Mask |= (1uL << linepos);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Unregister the callback of a line from an Exti dispatcher.
+  * @note   The pending bit of the line is no longer read nor cleared by the dispatcher.
+  * @param  hdispatch Exti dispatcher.
+  * @param  ExtiLine Exti line, a value of @ref EXTI_Line.
+  * @retval HAL Status.
+  */
+HAL_StatusTypeDef HAL_EXTI_DispatchUnRegister(EXTI_DispatchTypeDef *hdispatch, uint32_t ExtiLine)
+{
+  uint32_t linepos;
+
+  /* Check null pointer */
+  if (hdispatch == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  /* Check parameter */
+  assert_param(IS_EXTI_LINE(ExtiLine));
+
+  linepos = (ExtiLine & EXTI_PIN_MASK);
+
+  if (((hdispatch->Mask & (1uL << linepos)) == 0x00u) || (hdispatch->Entry[linepos].Line != ExtiLine))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Remove the line from the interrupt handler before clearing the entry */
+  hdispatch->Mask &= ~(1uL << linepos);
+  hdispatch->Entry[linepos].Callback = NULL;
+  hdispatch->Entry[linepos].pContext = NULL;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Handle the EXTI interrupt requests of the lines of a dispatcher.
+  * @note   The pending register is read once and the pending bits of the lines
+  *         served are cleared with a single write. The callbacks are then called
+  *         from the highest line to the lowest. An event occurring on a line
+  *         after the read sets the pending bit again and is served on the next
+  *         interrupt.
+  * @note   When USE_HAL_EXTI_DISPATCH_DELAY is 1U, the dispatch delay of a line
+  *         is counted from the entry of this function, not from the event.
+  * @param  hdispatch Exti dispatcher.
+  * @retval none.
+  */
+void HAL_EXTI_DispatchIRQHandler(EXTI_DispatchTypeDef *hdispatch)
+{
+  __IO uint32_t *regaddr;
+  uint32_t pending;
+  uint32_t linepos;
+#if (USE_HAL_EXTI_DISPATCH_DELAY == 1U)
+  uint32_t start = DWT->CYCCNT;
+  uint32_t delay;
+#endif /* USE_HAL_EXTI_DISPATCH_DELAY */
+
+  hdispatch->Calls++;
+
+  /* Get the pending bits of the lines served */
+  regaddr = (&EXTI->PR1 + (EXTI_CONFIG_OFFSET * hdispatch->Register));
+  pending = (*regaddr & hdispatch->Mask);
+
+  if (pending == 0x00u)
+  {
+    hdispatch->Spurious++;
+    return;
+  }
+
+  /* Clear pending bits */
+  *regaddr = pending;
+
+  while (pending != 0x00u)
+  {
+    /* Highest pending line */
+    linepos = 31U - (uint32_t)__CLZ(pending);
+    pending &= ~(1uL << linepos);
+
+    hdispatch->Stats[linepos].Events++;
+
+#if (USE_HAL_EXTI_DISPATCH_DELAY == 1U)
+    delay = DWT->CYCCNT - start;
+    hdispatch->Stats[linepos].DelayLast = delay;
+    if (delay > hdispatch->Stats[linepos].DelayMax)
+    {
+      hdispatch->Stats[linepos].DelayMax = delay;
+    }
+#endif /* USE_HAL_EXTI_DISPATCH_DELAY */
+
+    /* Call pending callback */
+    hdispatch->Entry[linepos].Callback(hdispatch->Entry[linepos].Line, hdispatch->Entry[linepos].pContext);
+  }
+}
+
+/**
+  * @brief  Get the statistics of a line of an Exti dispatcher.
+  * @param  hdispatch Exti dispatcher.
+  * @param  ExtiLine Exti line, a value of @ref EXTI_Line.
+  * @param  pStats pointer to the statistics filled.
+  * @retval HAL Status.
+  */
+HAL_StatusTypeDef HAL_EXTI_DispatchGetStats(const EXTI_DispatchTypeDef *hdispatch, uint32_t ExtiLine,
+                                            EXTI_DispatchStatsTypeDef *pStats)
+{
+  uint32_t linepos;
+
+  /* Check null pointer */
+  if ((hdispatch == NULL) || (pStats == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Check parameter */
+  assert_param(IS_EXTI_LINE(ExtiLine));
+
+  if (((ExtiLine & EXTI_REG_MASK) >> EXTI_REG_SHIFT) != hdispatch->Register)
+  {
+    return HAL_ERROR;
+  }
+
+  linepos = (ExtiLine & EXTI_PIN_MASK);
+  *pStats = hdispatch->Stats[linepos];
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Reset the statistics of an Exti dispatcher.
+  * @param  hdispatch Exti dispatcher.
+  * @retval None.
+  */
+void HAL_EXTI_DispatchResetStats(EXTI_DispatchTypeDef *hdispatch)
+{
+  uint32_t linepos;
+
+  for (linepos = 0U; linepos < 32U; linepos++)
+  {
+    hdispatch->Stats[linepos].Events = 0x00u;
+    hdispatch->Stats[linepos].DelayLast = 0x00u;
+    hdispatch->Stats[linepos].DelayMax = 0x00u;
+  }
+
+  hdispatch->Calls = 0x00u;
+  hdispatch->Spurious = 0x00u;
+}
+
 /**
   * @}
   */
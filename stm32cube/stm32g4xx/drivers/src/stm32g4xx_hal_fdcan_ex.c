@@ -0,0 +1,255 @@
+/**
+  ******************************************************************************
+  * @file    stm32g4xx_hal_fdcan_ex.c
+  * @brief   FDCAN Extended HAL module driver.
+  *          This file provides firmware functions to manage the following
+  *          functionalities of the Flexible DataRate Controller Area Network
+  *          (FDCAN) peripheral:
+  *           + Bulk Rx FIFO reception
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                        ##### How to use this driver #####
+  ==============================================================================
+    [..]
+      (#) To drain an Rx FIFO in bursts, call HAL_FDCANEx_GetRxMessages()
+          instead of HAL_FDCAN_GetRxMessage(): the fill level is read once, up
+          to MaxFrames frames are copied and acknowledged with a single write
+          to the acknowledge register.
+
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32g4xx_hal.h"
+
+#if defined(FDCAN1)
+
+/** @addtogroup STM32G4xx_HAL_Driver
+  * @{
+  */
+
+/** @defgroup FDCANEx FDCANEx
+  * @brief FDCAN Extended HAL module driver
+  * @{
+  */
+
+#ifdef HAL_FDCAN_MODULE_ENABLED
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/** @defgroup FDCANEx_Private_Constants FDCANEx Private Constants
+  * @{
+  */
+/* Same values as the FDCAN module private defines for the message RAM layout */
+#define FDCANEX_RX_FIFO_ELMTS_NBR  3U          /* Rx FIFO elements number            */
+#define FDCANEX_RX_FIFO_ELMT_WORDS 18U         /* Rx FIFO element size in 32-bit words */
+
+#define FDCANEX_ELEMENT_MASK_STDID ((uint32_t)0x1FFC0000U) /* Standard Identifier         */
+#define FDCANEX_ELEMENT_MASK_EXTID ((uint32_t)0x1FFFFFFFU) /* Extended Identifier         */
+#define FDCANEX_ELEMENT_MASK_RTR   ((uint32_t)0x20000000U) /* Remote Transmission Request */
+#define FDCANEX_ELEMENT_MASK_XTD   ((uint32_t)0x40000000U) /* Extended Identifier         */
+#define FDCANEX_ELEMENT_MASK_ESI   ((uint32_t)0x80000000U) /* Error State Indicator       */
+#define FDCANEX_ELEMENT_MASK_TS    ((uint32_t)0x0000FFFFU) /* Timestamp                   */
+#define FDCANEX_ELEMENT_MASK_DLC   ((uint32_t)0x000F0000U) /* Data Length Code            */
+#define FDCANEX_ELEMENT_MASK_BRS   ((uint32_t)0x00100000U) /* Bit Rate Switch             */
+#define FDCANEX_ELEMENT_MASK_FDF   ((uint32_t)0x00200000U) /* FD Format                   */
+#define FDCANEX_ELEMENT_MASK_FIDX  ((uint32_t)0x7F000000U) /* Filter Index                */
+#define FDCANEX_ELEMENT_MASK_ANMF  ((uint32_t)0x80000000U) /* Accepted Non-matching Frame */
+/**
+  * @}
+  */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/** @defgroup FDCANEx_Private_Variables FDCANEx Private Variables
+  * @{
+  */
+static const uint8_t FDCANEx_DLCtoBytes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup FDCANEx_Exported_Functions FDCANEx Exported Functions
+  * @{
+  */
+
+/** @defgroup FDCANEx_Exported_Functions_Group1 Bulk reception functions
+  * @brief    Bulk reception functions
+  *
+@verbatim
+  ==============================================================================
+                      ##### Bulk reception functions #####
+  ==============================================================================
+    [..]  This section provides functions allowing to:
+      (+) Copy several frames out of an Rx FIFO with a single acknowledge.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Get up to MaxFrames frames from an Rx FIFO.
+  * @note   The Rx FIFO status is read once and all copied elements are
+  *         acknowledged with a single register write.
+  * @param  hfdcan pointer to an FDCAN_HandleTypeDef structure that contains
+  *         the configuration information for the specified FDCAN.
+  * @param  RxFifo Rx FIFO.
+  *         This parameter can be one of the following values:
+  *           @arg FDCAN_RX_FIFO0: Rx FIFO 0
+  *           @arg FDCAN_RX_FIFO1: Rx FIFO 1
+  * @param  pRxHeader pointer to an array of MaxFrames FDCAN_RxHeaderTypeDef structures.
+  * @param  pRxData pointer to the buffer where the payloads are stored, frame n
+  *         payload starting at pRxData + (n * DataStride).
+  * @param  DataStride distance in bytes between two payloads, at least the
+  *         largest payload received.
+  * @param  MaxFrames maximum number of frames to read.
+  * @param  pFramesNbr pointer to the number of frames read.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_FDCANEx_GetRxMessages(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, FDCAN_RxHeaderTypeDef *pRxHeader,
+                                            uint8_t *pRxData, uint32_t DataStride, uint32_t MaxFrames, uint32_t *pFramesNbr)
+{
+  FDCAN_RxHeaderTypeDef *pHeader;
+  const uint32_t *RxAddress;
+  const uint8_t *pData;
+  uint8_t *pDest;
+  uint32_t *pBase;
+  uint32_t ByteCounter;
+  uint32_t DataLength;
+  uint32_t status;
+  uint32_t overwrite;
+  uint32_t GetIndex;
+  uint32_t FillLevel;
+  uint32_t count;
+
+  /* Check function parameters */
+  assert_param(IS_FDCAN_RX_FIFO(RxFifo));
+
+  *pFramesNbr = 0U;
+
+  if (hfdcan->State != HAL_FDCAN_STATE_BUSY)
+  {
+    /* Update error code */
+    hfdcan->ErrorCode |= HAL_FDCAN_ERROR_NOT_STARTED;
+
+    return HAL_ERROR;
+  }
+
+  if (RxFifo == FDCAN_RX_FIFO0)
+  {
+    status = hfdcan->Instance->RXF0S;
+    overwrite = hfdcan->Instance->RXGFC & FDCAN_RXGFC_F0OM;
+    pBase = (uint32_t *)hfdcan->msgRam.RxFIFO0SA;
+    GetIndex = (status & FDCAN_RXF0S_F0GI) >> FDCAN_RXF0S_F0GI_Pos;
+    FillLevel = status & FDCAN_RXF0S_F0FL;
+    status &= FDCAN_RXF0S_F0F;
+  }
+  else
+  {
+    status = hfdcan->Instance->RXF1S;
+    overwrite = hfdcan->Instance->RXGFC & FDCAN_RXGFC_F1OM;
+    pBase = (uint32_t *)hfdcan->msgRam.RxFIFO1SA;
+    GetIndex = (status & FDCAN_RXF1S_F1GI) >> FDCAN_RXF1S_F1GI_Pos;
+    FillLevel = status & FDCAN_RXF1S_F1FL;
+    status &= FDCAN_RXF1S_F1F;
+  }
+
+  /* When the Rx FIFO is full in overwrite mode the oldest element is being replaced */
+  if ((status != 0U) && (overwrite != 0U))
+  {
+    GetIndex++;
+    FillLevel--;
+    if (GetIndex == FDCANEX_RX_FIFO_ELMTS_NBR)
+    {
+      GetIndex = 0U;
+    }
+  }
+
+  count = (FillLevel < MaxFrames) ? FillLevel : MaxFrames;
+  pDest = pRxData;
+
+  for (; *pFramesNbr < count; (*pFramesNbr)++)
+  {
+    RxAddress = pBase + (GetIndex * FDCANEX_RX_FIFO_ELMT_WORDS);
+    pHeader = &pRxHeader[*pFramesNbr];
+
+    pHeader->IdType = RxAddress[0] & FDCANEX_ELEMENT_MASK_XTD;
+    if (pHeader->IdType == FDCAN_STANDARD_ID)
+    {
+      pHeader->Identifier = ((RxAddress[0] & FDCANEX_ELEMENT_MASK_STDID) >> 18U);
+    }
+    else
+    {
+      pHeader->Identifier = (RxAddress[0] & FDCANEX_ELEMENT_MASK_EXTID);
+    }
+    pHeader->RxFrameType = (RxAddress[0] & FDCANEX_ELEMENT_MASK_RTR);
+    pHeader->ErrorStateIndicator = (RxAddress[0] & FDCANEX_ELEMENT_MASK_ESI);
+    pHeader->RxTimestamp = (RxAddress[1] & FDCANEX_ELEMENT_MASK_TS);
+    pHeader->DataLength = (RxAddress[1] & FDCANEX_ELEMENT_MASK_DLC);
+    pHeader->BitRateSwitch = (RxAddress[1] & FDCANEX_ELEMENT_MASK_BRS);
+    pHeader->FDFormat = (RxAddress[1] & FDCANEX_ELEMENT_MASK_FDF);
+    pHeader->FilterIndex = ((RxAddress[1] & FDCANEX_ELEMENT_MASK_FIDX) >> 24U);
+    pHeader->IsFilterMatchingFrame = ((RxAddress[1] & FDCANEX_ELEMENT_MASK_ANMF) >> 31U);
+
+    /* Retrieve Rx payload */
+    pData = (const uint8_t *)&RxAddress[2U];
+    DataLength = FDCANEx_DLCtoBytes[pHeader->DataLength >> 16U];
+    for (ByteCounter = 0U; ByteCounter < DataLength; ByteCounter++)
+    {
+      pDest[ByteCounter] = pData[ByteCounter];
+    }
+    pDest += DataStride;
+
+    GetIndex++;
+    if (GetIndex == FDCANEX_RX_FIFO_ELMTS_NBR)
+    {
+      GetIndex = 0U;
+    }
+  }
+
+  if (count != 0U)
+  {
+    /* Acknowledging an element releases it and all the older ones */
+    GetIndex = (GetIndex == 0U) ? (FDCANEX_RX_FIFO_ELMTS_NBR - 1U) : (GetIndex - 1U);
+    if (RxFifo == FDCAN_RX_FIFO0)
+    {
+      hfdcan->Instance->RXF0A = GetIndex;
+    }
+    else
+    {
+      hfdcan->Instance->RXF1A = GetIndex;
+    }
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* HAL_FDCAN_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* FDCAN1 */
@@ -2038,6 +2038,8 @@ static HAL_StatusTypeDef FMAC_WaitOnStartUntilTimeout(FMAC_HandleTypeDef *hfmac,
 
       return HAL_ERROR;
     }
+
+    HAL_WAIT_YIELD();
   }
   return HAL_OK;
 }
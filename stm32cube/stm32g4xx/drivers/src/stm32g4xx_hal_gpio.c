@@ -489,12 +489,16 @@ HAL_StatusTypeDef HAL_GPIO_LockPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
   */
 void HAL_GPIO_EXTI_IRQHandler(uint16_t GPIO_Pin)
 {
+  HAL_TRACE_ENTER(HAL_TRACE_ID_GPIO_EXTI_IRQHANDLER, NULL);
+
   /* EXTI line interrupt detected */
   if (__HAL_GPIO_EXTI_GET_IT(GPIO_Pin) != 0x00u)
   {
     __HAL_GPIO_EXTI_CLEAR_IT(GPIO_Pin);
     HAL_GPIO_EXTI_Callback(GPIO_Pin);
   }
+
+  HAL_TRACE_EXIT(HAL_TRACE_ID_GPIO_EXTI_IRQHANDLER, NULL);
 }
 
 /**
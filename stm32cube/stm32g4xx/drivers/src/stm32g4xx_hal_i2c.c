@@ -35,9 +35,10 @@
         (##) I2C pins configuration
             (+++) Enable the clock for the I2C GPIOs
             (+++) Configure I2C pins as alternate function open-drain
-        (##) NVIC configuration if you need to use interrupt process
+        (##) NVIC configuration if you need to use interrupt process, or blocking
+             process with USE_HAL_WAIT_STRATEGY set to 1U
             (+++) Configure the I2Cx interrupt priority
-            (+++) Enable the NVIC I2C IRQ Channel
+            (+++) Enable the NVIC I2C event and error IRQ Channels
         (##) DMA Configuration if you need to use DMA process
             (+++) Declare a DMA_HandleTypeDef handle structure for
                   the transmit or receive channel
@@ -404,6 +405,21 @@
 /* Macro to get remaining data to transfer on DMA side */
 #define I2C_GET_DMA_REMAIN_DATA(__HANDLE__)     __HAL_DMA_GET_COUNTER(__HANDLE__)
 
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+/* Interrupt of the event setting a flag, 0 for the flags without interrupt */
+#define I2C_FLAG_TO_IT(__FLAG__)  ((((__FLAG__) == I2C_FLAG_TXIS)  ? I2C_IT_TXI   : \
+                                    ((__FLAG__) == I2C_FLAG_RXNE)  ? I2C_IT_RXI   : \
+                                    ((__FLAG__) == I2C_FLAG_STOPF) ? I2C_IT_STOPI : \
+                                    ((__FLAG__) == I2C_FLAG_TC)    ? I2C_IT_TCI   : \
+                                    ((__FLAG__) == I2C_FLAG_TCR)   ? I2C_IT_TCI   : \
+                                    ((__FLAG__) == I2C_FLAG_ADDR)  ? I2C_IT_ADDRI : \
+                                    ((__FLAG__) == I2C_FLAG_AF)    ? I2C_IT_NACKI : 0U))
+
+/* Interrupts enabled by I2C_WaitOnEvent(), disabled by the event and error IRQ handlers */
+#define I2C_WAIT_IT               (I2C_IT_TXI | I2C_IT_RXI | I2C_IT_STOPI | I2C_IT_TCI | \
+                                   I2C_IT_ADDRI | I2C_IT_NACKI | I2C_IT_ERRI)
+#endif /* USE_HAL_WAIT_STRATEGY */
+
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 
@@ -456,6 +472,9 @@ static HAL_StatusTypeDef I2C_WaitOnSTOPFlagUntilTimeout(I2C_HandleTypeDef *hi2c,
                                                         uint32_t Tickstart);
 static HAL_StatusTypeDef I2C_IsErrorOccurred(I2C_HandleTypeDef *hi2c, uint32_t Timeout,
                                              uint32_t Tickstart);
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+static void I2C_WaitOnEvent(I2C_HandleTypeDef *hi2c, uint32_t ITs, uint32_t Timeout, uint32_t Tickstart);
+#endif /* USE_HAL_WAIT_STRATEGY */
 
 /* Private functions to centralize the enable/disable of Interrupts */
 static void I2C_Enable_IRQ(I2C_HandleTypeDef *hi2c, uint16_t InterruptRequest);
@@ -1119,16 +1138,19 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevA
 {
   uint32_t tickstart;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_MASTER_TRANSMIT, hi2c);
+
   if (hi2c->State == HAL_I2C_STATE_READY)
   {
     /* Process Locked */
-    __HAL_LOCK(hi2c);
+    __HAL_LOCK_TRACE(hi2c, HAL_TRACE_ID_I2C_MASTER_TRANSMIT);
 
     /* Init tickstart for timeout management*/
     tickstart = HAL_GetTick();
 
     if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_BUSY, SET, I2C_TIMEOUT_BUSY, tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_TRANSMIT, hi2c);
       return HAL_ERROR;
     }
 
@@ -1161,6 +1183,7 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevA
       /* Wait until TXIS flag is set */
       if (I2C_WaitOnTXISFlagUntilTimeout(hi2c, Timeout, tickstart) != HAL_OK)
       {
+        HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_TRANSMIT, hi2c);
         return HAL_ERROR;
       }
       /* Write data to TXDR */
@@ -1177,6 +1200,7 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevA
         /* Wait until TCR flag is set */
         if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_TCR, RESET, Timeout, tickstart) != HAL_OK)
         {
+          HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_TRANSMIT, hi2c);
           return HAL_ERROR;
         }
 
@@ -1199,6 +1223,7 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevA
     /* Wait until STOPF flag is set */
     if (I2C_WaitOnSTOPFlagUntilTimeout(hi2c, Timeout, tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_TRANSMIT, hi2c);
       return HAL_ERROR;
     }
 
@@ -1214,10 +1239,12 @@ HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *hi2c, uint16_t DevA
     /* Process Unlocked */
     __HAL_UNLOCK(hi2c);
 
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_TRANSMIT, hi2c);
     return HAL_OK;
   }
   else
   {
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_TRANSMIT, hi2c);
     return HAL_BUSY;
   }
 }
@@ -1238,16 +1265,19 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAd
 {
   uint32_t tickstart;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_MASTER_RECEIVE, hi2c);
+
   if (hi2c->State == HAL_I2C_STATE_READY)
   {
     /* Process Locked */
-    __HAL_LOCK(hi2c);
+    __HAL_LOCK_TRACE(hi2c, HAL_TRACE_ID_I2C_MASTER_RECEIVE);
 
     /* Init tickstart for timeout management*/
     tickstart = HAL_GetTick();
 
     if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_BUSY, SET, I2C_TIMEOUT_BUSY, tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_RECEIVE, hi2c);
       return HAL_ERROR;
     }
 
@@ -1280,6 +1310,7 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAd
       /* Wait until RXNE flag is set */
       if (I2C_WaitOnRXNEFlagUntilTimeout(hi2c, Timeout, tickstart) != HAL_OK)
       {
+        HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_RECEIVE, hi2c);
         return HAL_ERROR;
       }
 
@@ -1297,6 +1328,7 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAd
         /* Wait until TCR flag is set */
         if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_TCR, RESET, Timeout, tickstart) != HAL_OK)
         {
+          HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_RECEIVE, hi2c);
           return HAL_ERROR;
         }
 
@@ -1319,6 +1351,7 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAd
     /* Wait until STOPF flag is set */
     if (I2C_WaitOnSTOPFlagUntilTimeout(hi2c, Timeout, tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_RECEIVE, hi2c);
       return HAL_ERROR;
     }
 
@@ -1334,10 +1367,12 @@ HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *hi2c, uint16_t DevAd
     /* Process Unlocked */
     __HAL_UNLOCK(hi2c);
 
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_RECEIVE, hi2c);
     return HAL_OK;
   }
   else
   {
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MASTER_RECEIVE, hi2c);
     return HAL_BUSY;
   }
 }
@@ -2375,6 +2410,8 @@ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress
 {
   uint32_t tickstart;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
+
   /* Check the parameters */
   assert_param(IS_I2C_MEMADD_SIZE(MemAddSize));
 
@@ -2383,17 +2420,19 @@ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress
     if ((pData == NULL) || (Size == 0U))
     {
       hi2c->ErrorCode = HAL_I2C_ERROR_INVALID_PARAM;
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
       return  HAL_ERROR;
     }
 
     /* Process Locked */
-    __HAL_LOCK(hi2c);
+    __HAL_LOCK_TRACE(hi2c, HAL_TRACE_ID_I2C_MEM_WRITE);
 
     /* Init tickstart for timeout management*/
     tickstart = HAL_GetTick();
 
     if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_BUSY, SET, I2C_TIMEOUT_BUSY, tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
       return HAL_ERROR;
     }
 
@@ -2411,6 +2450,7 @@ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress
     {
       /* Process Unlocked */
       __HAL_UNLOCK(hi2c);
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
       return HAL_ERROR;
     }
 
@@ -2431,6 +2471,7 @@ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress
       /* Wait until TXIS flag is set */
       if (I2C_WaitOnTXISFlagUntilTimeout(hi2c, Timeout, tickstart) != HAL_OK)
       {
+        HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
         return HAL_ERROR;
       }
 
@@ -2448,6 +2489,7 @@ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress
         /* Wait until TCR flag is set */
         if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_TCR, RESET, Timeout, tickstart) != HAL_OK)
         {
+          HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
           return HAL_ERROR;
         }
 
@@ -2471,6 +2513,7 @@ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress
     /* Wait until STOPF flag is reset */
     if (I2C_WaitOnSTOPFlagUntilTimeout(hi2c, Timeout, tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
       return HAL_ERROR;
     }
 
@@ -2486,10 +2529,12 @@ HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress
     /* Process Unlocked */
     __HAL_UNLOCK(hi2c);
 
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
     return HAL_OK;
   }
   else
   {
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_WRITE, hi2c);
     return HAL_BUSY;
   }
 }
@@ -2512,6 +2557,8 @@ HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
 {
   uint32_t tickstart;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
+
   /* Check the parameters */
   assert_param(IS_I2C_MEMADD_SIZE(MemAddSize));
 
@@ -2520,17 +2567,19 @@ HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
     if ((pData == NULL) || (Size == 0U))
     {
       hi2c->ErrorCode = HAL_I2C_ERROR_INVALID_PARAM;
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
       return  HAL_ERROR;
     }
 
     /* Process Locked */
-    __HAL_LOCK(hi2c);
+    __HAL_LOCK_TRACE(hi2c, HAL_TRACE_ID_I2C_MEM_READ);
 
     /* Init tickstart for timeout management*/
     tickstart = HAL_GetTick();
 
     if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_BUSY, SET, I2C_TIMEOUT_BUSY, tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
       return HAL_ERROR;
     }
 
@@ -2548,6 +2597,7 @@ HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
     {
       /* Process Unlocked */
       __HAL_UNLOCK(hi2c);
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
       return HAL_ERROR;
     }
 
@@ -2571,6 +2621,7 @@ HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
       /* Wait until RXNE flag is set */
       if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_RXNE, RESET, Timeout, tickstart) != HAL_OK)
       {
+        HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
         return HAL_ERROR;
       }
 
@@ -2588,6 +2639,7 @@ HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
         /* Wait until TCR flag is set */
         if (I2C_WaitOnFlagUntilTimeout(hi2c, I2C_FLAG_TCR, RESET, Timeout, tickstart) != HAL_OK)
         {
+          HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
           return HAL_ERROR;
         }
 
@@ -2610,6 +2662,7 @@ HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
     /* Wait until STOPF flag is reset */
     if (I2C_WaitOnSTOPFlagUntilTimeout(hi2c, Timeout, tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
       return HAL_ERROR;
     }
 
@@ -2625,10 +2678,12 @@ HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
     /* Process Unlocked */
     __HAL_UNLOCK(hi2c);
 
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
     return HAL_OK;
   }
   else
   {
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_MEM_READ, hi2c);
     return HAL_BUSY;
   }
 }
@@ -4445,11 +4500,23 @@ void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef *hi2c)
   uint32_t itflags   = READ_REG(hi2c->Instance->ISR);
   uint32_t itsources = READ_REG(hi2c->Instance->CR1);
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_EV_IRQHANDLER, hi2c);
+
   /* I2C events treatment -------------------------------------*/
   if (hi2c->XferISR != NULL)
   {
     hi2c->XferISR(hi2c, itflags, itsources);
   }
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+  else
+  {
+    /* Polling transfer blocked in I2C_WaitOnEvent() */
+    __HAL_I2C_DISABLE_IT(hi2c, I2C_WAIT_IT);
+    HAL_WaitSignal(hi2c);
+  }
+#endif /* USE_HAL_WAIT_STRATEGY */
+
+  HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_EV_IRQHANDLER, hi2c);
 }
 
 /**
@@ -4464,6 +4531,8 @@ void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *hi2c)
   uint32_t itsources = READ_REG(hi2c->Instance->CR1);
   uint32_t tmperror;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_ER_IRQHANDLER, hi2c);
+
   /* I2C Bus error interrupt occurred ------------------------------------*/
   if ((I2C_CHECK_FLAG(itflags, I2C_FLAG_BERR) != RESET) && \
       (I2C_CHECK_IT_SOURCE(itsources, I2C_IT_ERRI) != RESET))
@@ -4497,11 +4566,25 @@ void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef *hi2c)
   /* Store current volatile hi2c->ErrorCode, misra rule */
   tmperror = hi2c->ErrorCode;
 
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+  if (hi2c->XferISR == NULL)
+  {
+    /* Polling transfer blocked in I2C_WaitOnEvent(), I2C_IsErrorOccurred() ends it on the error recorded */
+    __HAL_I2C_DISABLE_IT(hi2c, I2C_WAIT_IT);
+    HAL_WaitSignal(hi2c);
+
+    HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_ER_IRQHANDLER, hi2c);
+    return;
+  }
+#endif /* USE_HAL_WAIT_STRATEGY */
+
   /* Call the Error Callback in case of Error detected */
   if ((tmperror & (HAL_I2C_ERROR_BERR | HAL_I2C_ERROR_OVR | HAL_I2C_ERROR_ARLO)) !=  HAL_I2C_ERROR_NONE)
   {
     I2C_ITError(hi2c, tmperror);
   }
+
+  HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_ER_IRQHANDLER, hi2c);
 }
 
 /**
@@ -6368,6 +6451,8 @@ static void I2C_DMAAbort(DMA_HandleTypeDef *hdma)
 static HAL_StatusTypeDef I2C_WaitOnFlagUntilTimeout(I2C_HandleTypeDef *hi2c, uint32_t Flag, FlagStatus Status,
                                                     uint32_t Timeout, uint32_t Tickstart)
 {
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_WAITONFLAGUNTILTIMEOUT, hi2c);
+
   while (__HAL_I2C_GET_FLAG(hi2c, Flag) == Status)
   {
     /* Check for the Timeout */
@@ -6381,10 +6466,16 @@ static HAL_StatusTypeDef I2C_WaitOnFlagUntilTimeout(I2C_HandleTypeDef *hi2c, uin
 
         /* Process Unlocked */
         __HAL_UNLOCK(hi2c);
+        HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONFLAGUNTILTIMEOUT, hi2c);
         return HAL_ERROR;
       }
     }
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+
+    I2C_WaitOnEvent(hi2c, (Status == RESET) ? I2C_FLAG_TO_IT(Flag) : 0U, Timeout, Tickstart);
+#endif /* USE_HAL_WAIT_STRATEGY */
   }
+  HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONFLAGUNTILTIMEOUT, hi2c);
   return HAL_OK;
 }
 
@@ -6399,11 +6490,14 @@ static HAL_StatusTypeDef I2C_WaitOnFlagUntilTimeout(I2C_HandleTypeDef *hi2c, uin
 static HAL_StatusTypeDef I2C_WaitOnTXISFlagUntilTimeout(I2C_HandleTypeDef *hi2c, uint32_t Timeout,
                                                         uint32_t Tickstart)
 {
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_WAITONTXISFLAGUNTILTIMEOUT, hi2c);
+
   while (__HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_TXIS) == RESET)
   {
     /* Check if an error is detected */
     if (I2C_IsErrorOccurred(hi2c, Timeout, Tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONTXISFLAGUNTILTIMEOUT, hi2c);
       return HAL_ERROR;
     }
 
@@ -6419,10 +6513,16 @@ static HAL_StatusTypeDef I2C_WaitOnTXISFlagUntilTimeout(I2C_HandleTypeDef *hi2c,
         /* Process Unlocked */
         __HAL_UNLOCK(hi2c);
 
+        HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONTXISFLAGUNTILTIMEOUT, hi2c);
         return HAL_ERROR;
       }
     }
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+
+    I2C_WaitOnEvent(hi2c, I2C_IT_TXI | I2C_IT_NACKI | I2C_IT_ERRI, Timeout, Tickstart);
+#endif /* USE_HAL_WAIT_STRATEGY */
   }
+  HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONTXISFLAGUNTILTIMEOUT, hi2c);
   return HAL_OK;
 }
 
@@ -6437,11 +6537,14 @@ static HAL_StatusTypeDef I2C_WaitOnTXISFlagUntilTimeout(I2C_HandleTypeDef *hi2c,
 static HAL_StatusTypeDef I2C_WaitOnSTOPFlagUntilTimeout(I2C_HandleTypeDef *hi2c, uint32_t Timeout,
                                                         uint32_t Tickstart)
 {
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_WAITONSTOPFLAGUNTILTIMEOUT, hi2c);
+
   while (__HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_STOPF) == RESET)
   {
     /* Check if an error is detected */
     if (I2C_IsErrorOccurred(hi2c, Timeout, Tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONSTOPFLAGUNTILTIMEOUT, hi2c);
       return HAL_ERROR;
     }
 
@@ -6455,9 +6558,15 @@ static HAL_StatusTypeDef I2C_WaitOnSTOPFlagUntilTimeout(I2C_HandleTypeDef *hi2c,
       /* Process Unlocked */
       __HAL_UNLOCK(hi2c);
 
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONSTOPFLAGUNTILTIMEOUT, hi2c);
       return HAL_ERROR;
     }
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+
+    I2C_WaitOnEvent(hi2c, I2C_IT_STOPI | I2C_IT_NACKI | I2C_IT_ERRI, Timeout, Tickstart);
+#endif /* USE_HAL_WAIT_STRATEGY */
   }
+  HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONSTOPFLAGUNTILTIMEOUT, hi2c);
   return HAL_OK;
 }
 
@@ -6472,11 +6581,14 @@ static HAL_StatusTypeDef I2C_WaitOnSTOPFlagUntilTimeout(I2C_HandleTypeDef *hi2c,
 static HAL_StatusTypeDef I2C_WaitOnRXNEFlagUntilTimeout(I2C_HandleTypeDef *hi2c, uint32_t Timeout,
                                                         uint32_t Tickstart)
 {
+  HAL_TRACE_ENTER(HAL_TRACE_ID_I2C_WAITONRXNEFLAGUNTILTIMEOUT, hi2c);
+
   while (__HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_RXNE) == RESET)
   {
     /* Check if an error is detected */
     if (I2C_IsErrorOccurred(hi2c, Timeout, Tickstart) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONRXNEFLAGUNTILTIMEOUT, hi2c);
       return HAL_ERROR;
     }
 
@@ -6488,6 +6600,7 @@ static HAL_StatusTypeDef I2C_WaitOnRXNEFlagUntilTimeout(I2C_HandleTypeDef *hi2c,
       if ((__HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_RXNE) == SET) && (hi2c->XferSize > 0U))
       {
         /* Return HAL_OK */
+        HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONRXNEFLAGUNTILTIMEOUT, hi2c);
         /* The Reading of data from RXDR will be done in caller function */
         return HAL_OK;
       }
@@ -6515,6 +6628,7 @@ static HAL_StatusTypeDef I2C_WaitOnRXNEFlagUntilTimeout(I2C_HandleTypeDef *hi2c,
         /* Process Unlocked */
         __HAL_UNLOCK(hi2c);
 
+        HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONRXNEFLAGUNTILTIMEOUT, hi2c);
         return HAL_ERROR;
       }
     }
@@ -6528,9 +6642,15 @@ static HAL_StatusTypeDef I2C_WaitOnRXNEFlagUntilTimeout(I2C_HandleTypeDef *hi2c,
       /* Process Unlocked */
       __HAL_UNLOCK(hi2c);
 
+      HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONRXNEFLAGUNTILTIMEOUT, hi2c);
       return HAL_ERROR;
     }
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+
+    I2C_WaitOnEvent(hi2c, I2C_IT_RXI | I2C_IT_STOPI | I2C_IT_NACKI | I2C_IT_ERRI, Timeout, Tickstart);
+#endif /* USE_HAL_WAIT_STRATEGY */
   }
+  HAL_TRACE_EXIT(HAL_TRACE_ID_I2C_WAITONRXNEFLAGUNTILTIMEOUT, hi2c);
   return HAL_OK;
 }
 
@@ -6648,6 +6768,14 @@ static HAL_StatusTypeDef I2C_IsErrorOccurred(I2C_HandleTypeDef *hi2c, uint32_t T
     status = HAL_ERROR;
   }
 
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+  /* Errors recorded and cleared by HAL_I2C_ER_IRQHandler() while blocked in I2C_WaitOnEvent() */
+  if ((hi2c->ErrorCode & (HAL_I2C_ERROR_BERR | HAL_I2C_ERROR_OVR | HAL_I2C_ERROR_ARLO)) != HAL_I2C_ERROR_NONE)
+  {
+    status = HAL_ERROR;
+  }
+#endif /* USE_HAL_WAIT_STRATEGY */
+
   if (status != HAL_OK)
   {
     /* Flush TX register */
@@ -6667,6 +6795,38 @@ static HAL_StatusTypeDef I2C_IsErrorOccurred(I2C_HandleTypeDef *hi2c, uint32_t T
   return status;
 }
 
+#if (USE_HAL_WAIT_STRATEGY == 1U)
+/**
+  * @brief  Block the calling thread until an I2C event or the timeout.
+  * @note   Returns at once when the caller cannot block or without interrupt
+  *         to wait for, the caller then busy-polls its flag.
+  * @note   The I2C event and error interrupts are to be enabled in the NVIC,
+  *         their handlers calling HAL_I2C_EV_IRQHandler() and
+  *         HAL_I2C_ER_IRQHandler(). Without them the thread only wakes up
+  *         at the timeout. The waits checking the bus errors also wake up on
+  *         I2C_IT_ERRI.
+  * @param  hi2c Pointer to a I2C_HandleTypeDef structure that contains
+  *                the configuration information for the specified I2C.
+  * @param  ITs Interrupts waking up the thread, a combination of @ref I2C_Interrupt_configuration_definition
+  * @param  Timeout Timeout duration
+  * @param  Tickstart Tick start value
+  * @retval None
+  */
+static void I2C_WaitOnEvent(I2C_HandleTypeDef *hi2c, uint32_t ITs, uint32_t Timeout, uint32_t Tickstart)
+{
+  /* The event IRQ handler signals the polling transfers only */
+  if ((ITs != 0U) && (hi2c->XferISR == NULL) && (HAL_WaitIsBlocking() != 0U))
+  {
+    /* An event already pending interrupts at once, it is not missed */
+    __HAL_I2C_ENABLE_IT(hi2c, ITs);
+
+    HAL_WaitBlock(hi2c, Tickstart, Timeout);
+
+    __HAL_I2C_DISABLE_IT(hi2c, ITs);
+  }
+}
+#endif /* USE_HAL_WAIT_STRATEGY */
+
 /**
   * @brief  Handles I2Cx communication when starting transfer or during transfer (TC or TCR flag are set).
   * @param  hi2c I2C handle.
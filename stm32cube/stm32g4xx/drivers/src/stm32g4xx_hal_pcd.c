@@ -88,6 +88,7 @@
   */
 
 static HAL_StatusTypeDef PCD_EP_ISR_Handler(PCD_HandleTypeDef *hpcd);
+static void PCD_ISO_Incomplete_Handler(PCD_HandleTypeDef *hpcd);
 #if (USE_USB_DOUBLE_BUFFER == 1U)
 static HAL_StatusTypeDef HAL_PCD_EP_DB_Transmit(PCD_HandleTypeDef *hpcd, PCD_EPTypeDef *ep, uint16_t wEPVal);
 static uint16_t HAL_PCD_EP_DB_Receive(PCD_HandleTypeDef *hpcd, PCD_EPTypeDef *ep, uint16_t wEPVal);
@@ -1126,6 +1127,8 @@ void HAL_PCD_IRQHandler(PCD_HandleTypeDef *hpcd)
   {
     __HAL_PCD_CLEAR_FLAG(hpcd, USB_ISTR_SOF);
 
+    PCD_ISO_Incomplete_Handler(hpcd);
+
 #if (USE_HAL_PCD_REGISTER_CALLBACKS == 1U)
     hpcd->SOFCallback(hpcd);
 #else
@@ -1255,6 +1258,8 @@ __weak void HAL_PCD_ResumeCallback(PCD_HandleTypeDef *hpcd)
 
 /**
   * @brief  Incomplete ISO OUT callback.
+  * @note   Called once from the SOF interrupt, enabled by Init.Sof_enable, when
+  *         an isochronous transfer receiving packets got none in a frame.
   * @param  hpcd PCD handle
   * @param  epnum endpoint number
   * @retval None
@@ -1272,6 +1277,8 @@ __weak void HAL_PCD_ISOOUTIncompleteCallback(PCD_HandleTypeDef *hpcd, uint8_t ep
 
 /**
   * @brief  Incomplete ISO IN callback.
+  * @note   Called once from the SOF interrupt, enabled by Init.Sof_enable, when
+  *         an isochronous transfer missed its frame. It stays armed.
   * @param  hpcd PCD handle
   * @param  epnum endpoint number
   * @retval None
@@ -1407,6 +1414,7 @@ HAL_StatusTypeDef HAL_PCD_EP_Open(PCD_HandleTypeDef *hpcd, uint8_t ep_addr,
   ep->num = ep_addr & EP_ADDR_MSK;
   ep->maxpacket = ep_mps;
   ep->type = ep_type;
+  ep->xfer_sof = 0U;
 
   if (ep->is_in != 0U)
   {
@@ -1447,6 +1455,7 @@ HAL_StatusTypeDef HAL_PCD_EP_Close(PCD_HandleTypeDef *hpcd, uint8_t ep_addr)
     ep->is_in = 0U;
   }
   ep->num   = ep_addr & EP_ADDR_MSK;
+  ep->xfer_sof = 0U;
 
   __HAL_LOCK(hpcd);
   (void)USB_DeactivateEndpoint(hpcd->Instance, ep);
@@ -1473,6 +1482,7 @@ HAL_StatusTypeDef HAL_PCD_EP_Receive(PCD_HandleTypeDef *hpcd, uint8_t ep_addr, u
   ep->xfer_buff = pBuf;
   ep->xfer_len = len;
   ep->xfer_count = 0U;
+  ep->xfer_sof = 0U;
   ep->is_in = 0U;
   ep->num = ep_addr & EP_ADDR_MSK;
 
@@ -1518,6 +1528,7 @@ HAL_StatusTypeDef HAL_PCD_EP_Transmit(PCD_HandleTypeDef *hpcd, uint8_t ep_addr,
   ep->xfer_fill_db = 1U;
   ep->xfer_len_db = len;
   ep->xfer_count = 0U;
+  ep->xfer_sof = 1U;
   ep->is_in = 1U;
   ep->num = ep_addr & EP_ADDR_MSK;
 
@@ -1859,6 +1870,8 @@ static HAL_StatusTypeDef PCD_EP_ISR_Handler(PCD_HandleTypeDef *hpcd)
 
         if ((ep->xfer_len == 0U) || (count < ep->maxpacket))
         {
+          ep->xfer_sof = 0U;
+
           /* RX COMPLETE */
 #if (USE_HAL_PCD_REGISTER_CALLBACKS == 1U)
           hpcd->DataOutStageCallback(hpcd, ep->num);
@@ -1868,6 +1881,8 @@ static HAL_StatusTypeDef PCD_EP_ISR_Handler(PCD_HandleTypeDef *hpcd)
         }
         else
         {
+          /* Packets are flowing, the next frame must bring one */
+          ep->xfer_sof = 1U;
           (void) USB_EPStartXfer(hpcd->Instance, ep);
         }
       }
@@ -1882,6 +1897,7 @@ static HAL_StatusTypeDef PCD_EP_ISR_Handler(PCD_HandleTypeDef *hpcd)
         if (ep->type != EP_TYPE_BULK)
         {
           ep->xfer_len = 0U;
+          ep->xfer_sof = 0U;
 
 #if (USE_USB_DOUBLE_BUFFER == 1U)
           if (ep->doublebuffer != 0U)
@@ -1955,6 +1971,67 @@ static HAL_StatusTypeDef PCD_EP_ISR_Handler(PCD_HandleTypeDef *hpcd)
 }
 
 
+/**
+  * @brief  Report the isochronous transfers which missed their frame.
+  * @note   The USB device has no incomplete isochronous transfer interrupt. An
+  *         IN transfer still pending at the second SOF after it was armed, or
+  *         an OUT transfer which received a packet and nothing in the frame
+  *         after, missed its frame. It is reported once and stays armed: the
+  *         callback may leave it for a later frame. An OUT transfer armed
+  *         while the host sends nothing is not reported.
+  * @param  hpcd PCD handle
+  * @retval None
+  */
+static void PCD_ISO_Incomplete_Handler(PCD_HandleTypeDef *hpcd)
+{
+  PCD_EPTypeDef *ep;
+  uint8_t epnum;
+
+  for (epnum = 1U; epnum < hpcd->Init.dev_endpoints; epnum++)
+  {
+    ep = &hpcd->IN_ep[epnum];
+
+    if ((ep->type == EP_TYPE_ISOC) && (ep->xfer_sof != 0U))
+    {
+      if (ep->xfer_sof == 1U)
+      {
+        ep->xfer_sof = 2U;
+      }
+      else
+      {
+        ep->xfer_sof = 0U;
+
+#if (USE_HAL_PCD_REGISTER_CALLBACKS == 1U)
+        hpcd->ISOINIncompleteCallback(hpcd, epnum);
+#else
+        HAL_PCD_ISOINIncompleteCallback(hpcd, epnum);
+#endif /* USE_HAL_PCD_REGISTER_CALLBACKS */
+      }
+    }
+
+    ep = &hpcd->OUT_ep[epnum];
+
+    if ((ep->type == EP_TYPE_ISOC) && (ep->xfer_sof != 0U))
+    {
+      if (ep->xfer_sof == 1U)
+      {
+        ep->xfer_sof = 2U;
+      }
+      else
+      {
+        ep->xfer_sof = 0U;
+
+#if (USE_HAL_PCD_REGISTER_CALLBACKS == 1U)
+        hpcd->ISOOUTIncompleteCallback(hpcd, epnum);
+#else
+        HAL_PCD_ISOOUTIncompleteCallback(hpcd, epnum);
+#endif /* USE_HAL_PCD_REGISTER_CALLBACKS */
+      }
+    }
+  }
+}
+
+
 #if (USE_USB_DOUBLE_BUFFER == 1U)
 /**
   * @brief  Manage double buffer bulk out transaction from ISR
@@ -6,6 +6,7 @@
   *          This file provides firmware functions to manage the following
   *          functionalities of the USB Peripheral Controller:
   *           + Extended features functions
+  *           + Endpoint streaming functions
   *
   ******************************************************************************
   * @attention
@@ -39,7 +40,23 @@
 /* Private variables ---------------------------------------------------------*/
 /* Private constants ---------------------------------------------------------*/
 /* Private macros ------------------------------------------------------------*/
+/** @defgroup PCDEx_Private_Macros PCDEx Private Macros
+  * @{
+  */
+#define PCDEX_ENTER_CRITICAL(__PRIMASK__)  do { (__PRIMASK__) = __get_PRIMASK(); __disable_irq(); } while (0U)
+#define PCDEX_EXIT_CRITICAL(__PRIMASK__)   __set_PRIMASK(__PRIMASK__)
+/**
+  * @}
+  */
+
 /* Private functions ---------------------------------------------------------*/
+/** @defgroup PCDEx_Private_Functions PCDEx Private Functions
+  * @{
+  */
+static void PCDEx_StreamStart(PCDEx_StreamTypeDef *hstream);
+/**
+  * @}
+  */
 /* Exported functions --------------------------------------------------------*/
 
 /** @defgroup PCDEx_Exported_Functions PCDEx Exported Functions
@@ -320,6 +337,402 @@ __weak void HAL_PCDEx_BCD_Callback(PCD_HandleTypeDef *hpcd, PCD_BCD_MsgTypeDef m
   * @}
   */
 
+/** @defgroup PCDEx_Exported_Functions_Group2 Endpoint streaming functions
+  * @brief    PCDEx endpoint streaming functions
+  *
+@verbatim
+ ===============================================================================
+                 ##### Endpoint streaming functions #####
+ ===============================================================================
+    [..]  This section provides functions allowing to:
+      (+) Queue several transfers per endpoint, restarted from the transfer
+          complete interrupt. Double-buffered packet memory is used when
+          configured with HAL_PCDEx_StreamConfigDoubleBuffer().
+      (+) Return completed transfers to the application in order.
+      (+) Keep an isochronous feedback endpoint armed with the latest rate.
+      (+) Report throughput, starvation and completion jitter.
+
+    [..]  The endpoints are opened by the USB stack as usual. Call
+          HAL_PCDEx_StreamDataStage() from HAL_PCD_DataInStageCallback() or
+          HAL_PCD_DataOutStageCallback(), HAL_PCDEx_StreamIncomplete() from the
+          ISO incomplete callbacks, and HAL_PCDEx_FeedbackDataStage() from
+          HAL_PCD_DataInStageCallback(), for the streamed endpoints instead of
+          forwarding them to the stack.
+
+    [..]  The USB device reports the isochronous transfers missing their frame
+          from the SOF interrupt: set Init.Sof_enable for isochronous streams.
+          Each missed frame is reported once, the transfer stays armed.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize an endpoint stream.
+  * @param  hpcd PCD handle
+  * @param  hstream stream handle
+  * @param  ep_addr endpoint address
+  * @param  pXfer transfer descriptor ring
+  * @param  XferNbr number of descriptors, maximum number of transfers queued,
+  *         a power of 2 so that the ring indexes survive the counters wrapping
+  * @param  ZeroLengthPacket 1 to end bulk IN transfers of a multiple of the max
+  *         packet size with a zero-length packet
+  * @param  GetTime statistics time base, HAL_GetTick() if NULL
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PCDEx_StreamInit(PCD_HandleTypeDef *hpcd, PCDEx_StreamTypeDef *hstream, uint8_t ep_addr,
+                                       PCDEx_StreamXferTypeDef *pXfer, uint32_t XferNbr,
+                                       uint8_t ZeroLengthPacket, uint32_t (*GetTime)(void))
+{
+  if ((hpcd == NULL) || (hstream == NULL) || (pXfer == NULL) || (XferNbr == 0U) ||
+      ((XferNbr & (XferNbr - 1U)) != 0U) ||
+      ((ep_addr & EP_ADDR_MSK) >= hpcd->Init.dev_endpoints))
+  {
+    return HAL_ERROR;
+  }
+
+  hstream->hpcd = hpcd;
+  hstream->pXfer = pXfer;
+  hstream->XferNbr = XferNbr;
+  hstream->EpAddr = ep_addr;
+  hstream->ZeroLengthPacket = ZeroLengthPacket;
+  hstream->GetTime = (GetTime != NULL) ? GetTime : HAL_GetTick;
+
+  HAL_PCDEx_StreamReset(hstream);
+  HAL_PCDEx_StreamResetStats(hstream);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Configure a bulk stream endpoint for double-buffered packet memory.
+  * @note   To be called before the endpoint is opened. Isochronous endpoints
+  *         are always double-buffered, their addresses are set the same way.
+  * @param  hstream stream handle
+  * @param  pmaadress0 first buffer address in packet memory
+  * @param  pmaadress1 second buffer address in packet memory
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PCDEx_StreamConfigDoubleBuffer(PCDEx_StreamTypeDef *hstream, uint16_t pmaadress0,
+                                                   uint16_t pmaadress1)
+{
+  return HAL_PCDEx_PMAConfig(hstream->hpcd, hstream->EpAddr, PCD_DBL_BUF,
+                             ((uint32_t)pmaadress1 << 16) | (uint32_t)pmaadress0);
+}
+
+/**
+  * @brief  Queue a transfer on an endpoint stream.
+  * @note   The buffer is owned by the stream until it is returned by
+  *         HAL_PCDEx_StreamGetCompleted().
+  * @param  hstream stream handle
+  * @param  pBuffer transfer buffer
+  * @param  Length IN endpoint: bytes to send, OUT endpoint: buffer size
+  * @retval HAL status, HAL_BUSY when the descriptor ring is full
+  */
+HAL_StatusTypeDef HAL_PCDEx_StreamSubmit(PCDEx_StreamTypeDef *hstream, uint8_t *pBuffer, uint32_t Length)
+{
+  PCDEx_StreamXferTypeDef *xfer;
+  uint32_t primask;
+
+  if ((hstream->SubmitCount - hstream->ReclaimCount) >= hstream->XferNbr)
+  {
+    return HAL_BUSY;
+  }
+
+  /* The slot is not visible to the interrupt until SubmitCount is updated */
+  xfer = &hstream->pXfer[hstream->SubmitCount & (hstream->XferNbr - 1U)];
+  xfer->pBuffer = pBuffer;
+  xfer->Length = Length;
+  xfer->Actual = 0U;
+
+  PCDEX_ENTER_CRITICAL(primask);
+  hstream->SubmitCount++;
+  if (hstream->Busy == 0U)
+  {
+    PCDEx_StreamStart(hstream);
+  }
+  PCDEX_EXIT_CRITICAL(primask);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Get the oldest completed transfer of an endpoint stream.
+  * @param  hstream stream handle
+  * @param  pXfer pointer to the descriptor to fill
+  * @retval HAL status, HAL_BUSY when no transfer is completed
+  */
+HAL_StatusTypeDef HAL_PCDEx_StreamGetCompleted(PCDEx_StreamTypeDef *hstream, PCDEx_StreamXferTypeDef *pXfer)
+{
+  if (hstream->ReclaimCount == hstream->ActiveCount)
+  {
+    return HAL_BUSY;
+  }
+
+  *pXfer = hstream->pXfer[hstream->ReclaimCount & (hstream->XferNbr - 1U)];
+  hstream->ReclaimCount++;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Drop all the transfers of an endpoint stream.
+  * @note   To be called once the endpoint is closed or flushed, e.g. on USB reset.
+  * @param  hstream stream handle
+  * @retval None
+  */
+void HAL_PCDEx_StreamReset(PCDEx_StreamTypeDef *hstream)
+{
+  uint32_t primask;
+
+  PCDEX_ENTER_CRITICAL(primask);
+  hstream->SubmitCount = 0U;
+  hstream->ActiveCount = 0U;
+  hstream->ReclaimCount = 0U;
+  hstream->ZlpPending = 0U;
+  hstream->Busy = 0U;
+  hstream->BackToBack = 0U;
+  PCDEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @brief  Complete the current transfer of an endpoint stream and start the next one.
+  * @note   To be called from the data stage callback of the streamed endpoint.
+  * @param  hstream stream handle
+  * @retval None
+  */
+void HAL_PCDEx_StreamDataStage(PCDEx_StreamTypeDef *hstream)
+{
+  PCD_HandleTypeDef *hpcd = hstream->hpcd;
+  PCDEx_StreamXferTypeDef *xfer;
+  PCD_EPTypeDef *ep;
+  uint32_t now;
+  uint32_t interval;
+
+  if (hstream->Busy == 0U)
+  {
+    return;
+  }
+
+  xfer = &hstream->pXfer[hstream->ActiveCount & (hstream->XferNbr - 1U)];
+
+  if ((hstream->EpAddr & 0x80U) == 0x80U)
+  {
+    ep = &hpcd->IN_ep[hstream->EpAddr & EP_ADDR_MSK];
+
+    /* Terminate a bulk transfer of a multiple of the max packet size */
+    if ((hstream->ZlpPending == 0U) && (hstream->ZeroLengthPacket != 0U) && (ep->type == EP_TYPE_BULK) &&
+        (xfer->Length != 0U) && ((xfer->Length % ep->maxpacket) == 0U))
+    {
+      hstream->ZlpPending = 1U;
+      (void)HAL_PCD_EP_Transmit(hpcd, hstream->EpAddr, NULL, 0U);
+      return;
+    }
+    hstream->ZlpPending = 0U;
+    xfer->Actual = xfer->Length;
+  }
+  else
+  {
+    xfer->Actual = HAL_PCD_EP_GetRxCount(hpcd, hstream->EpAddr);
+  }
+
+  now = hstream->GetTime();
+  if (hstream->BackToBack != 0U)
+  {
+    interval = now - hstream->LastTime;
+    if (interval < hstream->Stats.IntervalMin)
+    {
+      hstream->Stats.IntervalMin = interval;
+    }
+    if (interval > hstream->Stats.IntervalMax)
+    {
+      hstream->Stats.IntervalMax = interval;
+    }
+  }
+  hstream->LastTime = now;
+  hstream->Stats.Transfers++;
+  hstream->Stats.Bytes += xfer->Actual;
+
+  hstream->ActiveCount++;
+  hstream->Busy = 0U;
+
+  /* Restart the endpoint right away to keep it streaming */
+  if (hstream->ActiveCount != hstream->SubmitCount)
+  {
+    hstream->BackToBack = 1U;
+    PCDEx_StreamStart(hstream);
+  }
+  else
+  {
+    hstream->BackToBack = 0U;
+    hstream->Stats.Starved++;
+  }
+}
+
+/**
+  * @brief  Account an isochronous transfer missed in its frame.
+  * @note   To be called from the ISO incomplete callbacks of the streamed endpoint.
+  *         The transfer stays armed and completes in a later frame.
+  * @param  hstream stream handle
+  * @retval None
+  */
+void HAL_PCDEx_StreamIncomplete(PCDEx_StreamTypeDef *hstream)
+{
+  hstream->Stats.Incomplete++;
+  hstream->BackToBack = 0U;
+}
+
+/**
+  * @brief  Get the statistics of an endpoint stream.
+  * @param  hstream stream handle
+  * @param  pStats pointer to the statistics to fill
+  * @retval None
+  */
+void HAL_PCDEx_StreamGetStats(PCDEx_StreamTypeDef *hstream, PCDEx_StreamStatsTypeDef *pStats)
+{
+  uint32_t primask;
+
+  PCDEX_ENTER_CRITICAL(primask);
+  *pStats = hstream->Stats;
+  pStats->Elapsed = hstream->GetTime() - hstream->StartTime;
+  PCDEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @brief  Clear the statistics of an endpoint stream.
+  * @param  hstream stream handle
+  * @retval None
+  */
+void HAL_PCDEx_StreamResetStats(PCDEx_StreamTypeDef *hstream)
+{
+  uint32_t primask;
+
+  PCDEX_ENTER_CRITICAL(primask);
+  hstream->Stats.Transfers = 0U;
+  hstream->Stats.Bytes = 0U;
+  hstream->Stats.Starved = 0U;
+  hstream->Stats.Incomplete = 0U;
+  hstream->Stats.IntervalMin = 0xFFFFFFFFU;
+  hstream->Stats.IntervalMax = 0U;
+  hstream->Stats.Elapsed = 0U;
+  hstream->StartTime = hstream->GetTime();
+  PCDEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @brief  Initialize an isochronous feedback endpoint.
+  * @note   The feedback is sent once HAL_PCDEx_FeedbackSetRate() is called.
+  * @param  hpcd PCD handle
+  * @param  hfb feedback handle
+  * @param  ep_addr feedback IN endpoint address
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_PCDEx_FeedbackInit(PCD_HandleTypeDef *hpcd, PCDEx_FeedbackTypeDef *hfb, uint8_t ep_addr)
+{
+  if ((hpcd == NULL) || (hfb == NULL) || ((ep_addr & 0x80U) != 0x80U) ||
+      ((ep_addr & EP_ADDR_MSK) >= hpcd->Init.dev_endpoints))
+  {
+    return HAL_ERROR;
+  }
+
+  hfb->hpcd = hpcd;
+  hfb->EpAddr = ep_addr;
+  /* Full speed feedback is 10.14 samples per frame */
+  hfb->Size = 3U;
+  hfb->Busy = 0U;
+  hfb->Slot = 0U;
+  hfb->Sending = 0U;
+  hfb->Updates = 0U;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Update the rate reported by an isochronous feedback endpoint.
+  * @param  hfb feedback handle
+  * @param  Samples number of samples consumed during the measurement window
+  * @param  Frames length of the measurement window, in frames at full speed
+  *         or microframes at high speed
+  * @retval None
+  */
+void HAL_PCDEx_FeedbackSetRate(PCDEx_FeedbackTypeDef *hfb, uint32_t Samples, uint32_t Frames)
+{
+  uint64_t rate;
+  uint32_t value;
+  uint32_t primask;
+  uint8_t slot;
+
+  if (Frames == 0U)
+  {
+    return;
+  }
+
+  /* Fixed point samples per (micro)frame: 16.16 on 4 bytes or 10.14 on 3 bytes */
+  rate = ((uint64_t)Samples << ((hfb->Size == 4U) ? 16U : 14U)) / Frames;
+  value = (rate > 0xFFFFFFFFU) ? 0xFFFFFFFFU : (uint32_t)rate;
+
+  PCDEX_ENTER_CRITICAL(primask);
+  /* Fill the slot the endpoint is not sending, with the interrupts masked as
+     the data stage re-arms the endpoint with the latest slot */
+  slot = (hfb->Busy != 0U) ? (hfb->Sending ^ 1U) : (hfb->Slot ^ 1U);
+  hfb->Value[slot] = value;
+  hfb->Slot = slot;
+  hfb->Updates++;
+  if (hfb->Busy == 0U)
+  {
+    hfb->Busy = 1U;
+    hfb->Sending = slot;
+    (void)HAL_PCD_EP_Transmit(hfb->hpcd, hfb->EpAddr, (uint8_t *)&hfb->Value[slot], hfb->Size);
+  }
+  PCDEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @brief  Re-arm an isochronous feedback endpoint with the latest rate.
+  * @note   To be called from the data IN stage and ISO IN incomplete callbacks
+  *         of the feedback endpoint.
+  * @param  hfb feedback handle
+  * @retval None
+  */
+void HAL_PCDEx_FeedbackDataStage(PCDEx_FeedbackTypeDef *hfb)
+{
+  hfb->Sending = hfb->Slot;
+  (void)HAL_PCD_EP_Transmit(hfb->hpcd, hfb->EpAddr, (uint8_t *)&hfb->Value[hfb->Sending], hfb->Size);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup PCDEx_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Start the oldest queued transfer of an endpoint stream.
+  * @param  hstream stream handle
+  * @retval None
+  */
+static void PCDEx_StreamStart(PCDEx_StreamTypeDef *hstream)
+{
+  PCDEx_StreamXferTypeDef *xfer = &hstream->pXfer[hstream->ActiveCount & (hstream->XferNbr - 1U)];
+
+  hstream->Busy = 1U;
+
+  if ((hstream->EpAddr & 0x80U) == 0x80U)
+  {
+    (void)HAL_PCD_EP_Transmit(hstream->hpcd, hstream->EpAddr, xfer->pBuffer, xfer->Length);
+  }
+  else
+  {
+    (void)HAL_PCD_EP_Receive(hstream->hpcd, hstream->EpAddr, xfer->pBuffer, xfer->Length);
+  }
+}
+
 /**
   * @}
   */
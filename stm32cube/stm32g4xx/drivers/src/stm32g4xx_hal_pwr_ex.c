@@ -918,6 +918,11 @@ void HAL_PWREx_EnterSTOP0Mode(uint8_t STOPEntry)
 
   /* Reset SLEEPDEEP bit of Cortex System Control Register */
   CLEAR_BIT(SCB->SCR, ((uint32_t)SCB_SCR_SLEEPDEEP_Msk));
+
+#if defined(HAL_RCC_MODULE_ENABLED) && (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* The system clock may have been switched to HSI on wake-up */
+  HAL_RCC_InvalidateClockTree();
+#endif /* HAL_RCC_MODULE_ENABLED && USE_HAL_RCC_CLOCK_CACHE */
 }
 
 
@@ -969,6 +974,11 @@ void HAL_PWREx_EnterSTOP1Mode(uint8_t STOPEntry)
 
   /* Reset SLEEPDEEP bit of Cortex System Control Register */
   CLEAR_BIT(SCB->SCR, ((uint32_t)SCB_SCR_SLEEPDEEP_Msk));
+
+#if defined(HAL_RCC_MODULE_ENABLED) && (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* The system clock may have been switched to HSI on wake-up */
+  HAL_RCC_InvalidateClockTree();
+#endif /* HAL_RCC_MODULE_ENABLED && USE_HAL_RCC_CLOCK_CACHE */
 }
 
 
@@ -2606,6 +2606,8 @@ static HAL_StatusTypeDef QSPI_WaitFlagStateUntilTimeout(QSPI_HandleTypeDef *hqsp
         return HAL_ERROR;
       }
     }
+
+    HAL_WAIT_YIELD();
   }
   return HAL_OK;
 }
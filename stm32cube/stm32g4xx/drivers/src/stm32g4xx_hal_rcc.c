@@ -96,6 +96,17 @@
   */
 
 /* Private variables ---------------------------------------------------------*/
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+/** @defgroup RCC_Private_Variables RCC Private Variables
+  * @{
+  */
+static RCC_ClockTreeTypeDef     RCC_ClockTree;                /* Clock tree snapshot                        */
+static __IO uint32_t            RCC_ClockTreeValid = 0U;      /* Set while RCC_ClockTree matches the registers */
+static RCC_ClockNotifierTypeDef *RCC_ClockNotifiers = NULL;   /* Registered clock tree change notifiers     */
+/**
+  * @}
+  */
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
 
 /* Private function prototypes -----------------------------------------------*/
 /** @defgroup RCC_Private_Functions RCC Private Functions
@@ -220,6 +231,11 @@ HAL_StatusTypeDef HAL_RCC_DeInit(void)
 {
   uint32_t tickstart;
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Clock frequencies are computed from the registers until the configuration completes */
+  HAL_RCC_InvalidateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   /* Get Start Tick*/
   tickstart = HAL_GetTick();
 
@@ -292,6 +308,11 @@ HAL_StatusTypeDef HAL_RCC_DeInit(void)
   /* Clear all reset flags */
   SET_BIT(RCC->CSR, RCC_CSR_RMVF);
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Take a new clock tree snapshot and notify the registered users */
+  HAL_RCC_UpdateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   return HAL_OK;
 }
 
@@ -321,6 +342,11 @@ HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef  *RCC_OscInitStruct)
     return HAL_ERROR;
   }
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Clock frequencies are computed from the registers until the configuration completes */
+  HAL_RCC_InvalidateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   /* Check the parameters */
   assert_param(IS_RCC_OSCILLATORTYPE(RCC_OscInitStruct->OscillatorType));
 
@@ -713,6 +739,11 @@ HAL_StatusTypeDef HAL_RCC_OscConfig(RCC_OscInitTypeDef  *RCC_OscInitStruct)
   }
   }
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Take a new clock tree snapshot and notify the registered users */
+  HAL_RCC_UpdateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   return HAL_OK;
 }
 
@@ -776,6 +807,11 @@ HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef  *RCC_ClkInitStruct, ui
     return HAL_ERROR;
   }
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Clock frequencies are computed from the registers until the configuration completes */
+  HAL_RCC_InvalidateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   /* Check the parameters */
   assert_param(IS_RCC_CLOCKTYPE(RCC_ClkInitStruct->ClockType));
   assert_param(IS_FLASH_LATENCY(FLatency));
@@ -936,6 +972,11 @@ HAL_StatusTypeDef HAL_RCC_ClockConfig(RCC_ClkInitTypeDef  *RCC_ClkInitStruct, ui
   /* Update the SystemCoreClock global variable */
   SystemCoreClock = HAL_RCC_GetSysClockFreq() >> (AHBPrescTable[READ_BIT(RCC->CFGR, RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos] & 0x1FU);
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Take a new clock tree snapshot and notify the registered users */
+  HAL_RCC_UpdateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   /* Configure the source of time base considering new system clocks settings*/
   return HAL_InitTick(uwTickPrio);
 }
@@ -1066,6 +1107,13 @@ uint32_t HAL_RCC_GetSysClockFreq(void)
   uint32_t pllvco, pllsource, pllr, pllm;
   uint32_t sysclockfreq;
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  if (RCC_ClockTreeValid != 0U)
+  {
+    return RCC_ClockTree.SYSCLKFreq;
+  }
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   if (__HAL_RCC_GET_SYSCLK_SOURCE() == RCC_CFGR_SWS_HSI)
   {
     /* HSI used as system clock source */
@@ -1129,6 +1177,13 @@ uint32_t HAL_RCC_GetHCLKFreq(void)
   */
 uint32_t HAL_RCC_GetPCLK1Freq(void)
 {
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  if (RCC_ClockTreeValid != 0U)
+  {
+    return RCC_ClockTree.PCLK1Freq;
+  }
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   /* Get HCLK source and Compute PCLK1 frequency ---------------------------*/
   return (HAL_RCC_GetHCLKFreq() >> (APBPrescTable[READ_BIT(RCC->CFGR, RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos] & 0x1FU));
 }
@@ -1141,6 +1196,13 @@ uint32_t HAL_RCC_GetPCLK1Freq(void)
   */
 uint32_t HAL_RCC_GetPCLK2Freq(void)
 {
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  if (RCC_ClockTreeValid != 0U)
+  {
+    return RCC_ClockTree.PCLK2Freq;
+  }
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   /* Get HCLK source and Compute PCLK2 frequency ---------------------------*/
   return (HAL_RCC_GetHCLKFreq()>> (APBPrescTable[READ_BIT(RCC->CFGR, RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos] & 0x1FU));
 }
@@ -1321,6 +1383,11 @@ void HAL_RCC_NMI_IRQHandler(void)
   /* Check RCC CSSF interrupt flag  */
   if(__HAL_RCC_GET_IT(RCC_IT_CSS))
   {
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+    /* The HSE failure switched the system clock to HSI */
+    HAL_RCC_InvalidateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
     /* RCC Clock Security System interrupt user callback */
     HAL_RCC_CSSCallback();
 
@@ -1344,6 +1411,175 @@ __weak void HAL_RCC_CSSCallback(void)
   * @}
   */
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+/** @defgroup RCC_Exported_Functions_Group3 Clock tree cache functions
+ *  @brief   Clock frequency cache and change notification functions
+ *
+@verbatim
+ ===============================================================================
+                      ##### Clock tree cache functions #####
+ ===============================================================================
+    [..]
+    When USE_HAL_RCC_CLOCK_CACHE is set to 1U, the SYSCLK, HCLK, PCLK1 and PCLK2
+    frequencies and the peripheral kernel clock frequencies are computed once and
+    kept until the clock configuration changes, so that HAL_RCC_GetSysClockFreq(),
+    HAL_RCC_GetPCLK1Freq(), HAL_RCC_GetPCLK2Freq() and HAL_RCCEx_GetPeriphCLKFreq()
+    return a stored value.
+
+    (+) The clock tree snapshot is invalidated when HAL_RCC_DeInit(),
+        HAL_RCC_OscConfig(), HAL_RCC_ClockConfig() or HAL_RCCEx_PeriphCLKConfig()
+        is entered, and taken again when it completes successfully. It is also
+        invalidated on a clock security system event and on wake-up from Stop mode.
+    (+) Code changing the clock configuration by other means, for instance with
+        the LL RCC driver, has to call HAL_RCC_UpdateClockTree() once done.
+    (+) HAL_RCC_GetClockTree() returns the snapshot, taking it first if needed.
+    (+) HAL_RCC_RegisterClockNotifier() registers a callback called with the new
+        clock tree each time a snapshot is taken by HAL_RCC_UpdateClockTree(), in
+        the context of the function which changed the clock configuration. It can
+        be used by a driver to recompute its prescalers or baud rate.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Return the clock tree snapshot, taking it first if it is not valid.
+  * @note   The returned structure is updated in place when the clock tree changes.
+  * @note   A snapshot invalidated while it is taken, by an interrupt changing the
+  *         clock configuration, is taken again.
+  * @retval Pointer to the clock tree snapshot
+  */
+const RCC_ClockTreeTypeDef *HAL_RCC_GetClockTree(void)
+{
+  uint32_t generation;
+
+  while (RCC_ClockTreeValid == 0U)
+  {
+    generation = RCC_ClockTree.Generation;
+
+    /* The frequency getters compute from the registers while the snapshot is not valid */
+    RCC_ClockTree.SYSCLKFreq = HAL_RCC_GetSysClockFreq();
+    RCC_ClockTree.HCLKFreq   = HAL_RCC_GetHCLKFreq();
+    RCC_ClockTree.PCLK1Freq  = HAL_RCC_GetPCLK1Freq();
+    RCC_ClockTree.PCLK2Freq  = HAL_RCC_GetPCLK2Freq();
+
+    RCC_ClockTreeValid = 1U;
+
+    /* HAL_RCC_InvalidateClockTree() increments the generation before clearing the valid flag */
+    if (RCC_ClockTree.Generation != generation)
+    {
+      RCC_ClockTreeValid = 0U;
+    }
+  }
+
+  return &RCC_ClockTree;
+}
+
+/**
+  * @brief  Invalidate the clock tree snapshot.
+  * @note   Clock frequencies are computed from the registers until the next
+  *         call to HAL_RCC_GetClockTree() or HAL_RCC_UpdateClockTree().
+  * @retval None
+  */
+void HAL_RCC_InvalidateClockTree(void)
+{
+  RCC_ClockTree.Generation++;
+  RCC_ClockTreeValid = 0U;
+}
+
+/**
+  * @brief  Take a new clock tree snapshot and call the registered notifiers.
+  * @note   To be called after changing the clock configuration without the
+  *         HAL RCC configuration functions.
+  * @retval None
+  */
+void HAL_RCC_UpdateClockTree(void)
+{
+  const RCC_ClockTreeTypeDef *pclocktree;
+  RCC_ClockNotifierTypeDef *pnotifier;
+
+  HAL_RCC_InvalidateClockTree();
+  pclocktree = HAL_RCC_GetClockTree();
+
+  /* Notifiers are called in their registration order */
+  pnotifier = RCC_ClockNotifiers;
+  while (pnotifier != NULL)
+  {
+    pnotifier->Callback(pclocktree, pnotifier->pContext);
+    pnotifier = pnotifier->pNext;
+  }
+}
+
+/**
+  * @brief  Register a clock tree change notifier.
+  * @param  pNotifier  pointer to an RCC_ClockNotifierTypeDef structure with
+  *         Callback and pContext set. It must remain valid until it is unregistered.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_RCC_RegisterClockNotifier(RCC_ClockNotifierTypeDef *pNotifier)
+{
+  RCC_ClockNotifierTypeDef **ppnotifier = &RCC_ClockNotifiers;
+  HAL_StatusTypeDef status = HAL_OK;
+
+  if ((pNotifier == NULL) || (pNotifier->Callback == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Append the notifier, unless it is already registered */
+  while ((*ppnotifier != NULL) && (status == HAL_OK))
+  {
+    if (*ppnotifier == pNotifier)
+    {
+      status = HAL_ERROR;
+    }
+    else
+    {
+      ppnotifier = &((*ppnotifier)->pNext);
+    }
+  }
+
+  if (status == HAL_OK)
+  {
+    pNotifier->pNext = NULL;
+    *ppnotifier = pNotifier;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Unregister a clock tree change notifier.
+  * @param  pNotifier  pointer to a notifier registered with HAL_RCC_RegisterClockNotifier().
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_RCC_UnRegisterClockNotifier(RCC_ClockNotifierTypeDef *pNotifier)
+{
+  RCC_ClockNotifierTypeDef **ppnotifier = &RCC_ClockNotifiers;
+  HAL_StatusTypeDef status = HAL_ERROR;
+
+  while ((*ppnotifier != NULL) && (status != HAL_OK))
+  {
+    if (*ppnotifier == pNotifier)
+    {
+      *ppnotifier = pNotifier->pNext;
+      pNotifier->pNext = NULL;
+      status = HAL_OK;
+    }
+    else
+    {
+      ppnotifier = &((*ppnotifier)->pNext);
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @}
+  */
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
 /**
   * @}
   */
@@ -49,16 +49,34 @@
 #define __LSCO_CLK_ENABLE()       __HAL_RCC_GPIOA_CLK_ENABLE()
 #define LSCO_GPIO_PORT            GPIOA
 #define LSCO_PIN                  GPIO_PIN_2
+
+#define PLLVCO_INPUT_MIN          2660000U          /* Frequency min for PLL VCO input, in Hz  */
+#define PLLVCO_INPUT_MAX          8000000U          /* Frequency max for PLL VCO input, in Hz  */
+#define PLLVCO_OUTPUT_MIN        64000000U          /* Frequency min for PLL VCO output, in Hz */
+#define PLLVCO_OUTPUT_MAX       344000000U          /* Frequency max for PLL VCO output, in Hz */
 /**
   * @}
   */
 
 /* Private macros ------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+/** @defgroup RCCEx_Private_Variables RCCEx Private Variables
+ * @{
+ */
+static uint32_t RCCEx_PeriphCLKFreq[32];        /* Peripheral clock frequencies, indexed by RCC_PERIPHCLK_x bit position */
+static uint32_t RCCEx_PeriphCLKValid = 0U;      /* RCC_PERIPHCLK_x bits of the valid RCCEx_PeriphCLKFreq entries         */
+static uint32_t RCCEx_PeriphCLKGeneration = 0U; /* Clock tree generation the entries were computed for                */
+/**
+  * @}
+  */
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
 /* Private function prototypes -----------------------------------------------*/
 /** @defgroup RCCEx_Private_Functions RCCEx Private Functions
  * @{
  */
+static uint32_t RCCEx_PLLSelectDivider(uint32_t PLLVCOFreq, uint32_t Freq, uint32_t Tolerance, uint32_t DivMin,
+                                       uint32_t DivMax, uint32_t DivStep, uint32_t *pDivider, uint32_t *pError);
 
 /**
   * @}
@@ -130,6 +148,11 @@ HAL_StatusTypeDef HAL_RCCEx_PeriphCLKConfig(RCC_PeriphCLKInitTypeDef  *PeriphClk
   /* Check the parameters */
   assert_param(IS_RCC_PERIPHCLOCK(PeriphClkInit->PeriphClockSelection));
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Clock frequencies are computed from the registers until the configuration completes */
+  HAL_RCC_InvalidateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   /*-------------------------- RTC clock source configuration ----------------------*/
   if((PeriphClkInit->PeriphClockSelection & RCC_PERIPHCLK_RTC) == RCC_PERIPHCLK_RTC)
   {
@@ -471,6 +494,11 @@ HAL_StatusTypeDef HAL_RCCEx_PeriphCLKConfig(RCC_PeriphCLKInitTypeDef  *PeriphClk
 
 #endif /* QUADSPI */
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Take a new clock tree snapshot and notify the registered users */
+  HAL_RCC_UpdateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   return status;
 }
 
@@ -650,10 +678,35 @@ uint32_t HAL_RCCEx_GetPeriphCLKFreq(uint32_t PeriphClk)
   uint32_t frequency = 0U;
   uint32_t srcclk;
   uint32_t pllvco, plln, pllp;
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  uint32_t generation;
+  uint32_t index = 0U;
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
 
   /* Check the parameters */
   assert_param(IS_RCC_PERIPHCLOCK(PeriphClk));
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Drop the frequencies computed for a previous clock configuration */
+  generation = HAL_RCC_GetClockTree()->Generation;
+  if (generation != RCCEx_PeriphCLKGeneration)
+  {
+    RCCEx_PeriphCLKValid = 0U;
+    RCCEx_PeriphCLKGeneration = generation;
+  }
+
+  /* Only single peripheral clock identifiers are cached */
+  if ((PeriphClk != 0U) && ((PeriphClk & (PeriphClk - 1U)) == 0U))
+  {
+    index = POSITION_VAL(PeriphClk);
+
+    if ((RCCEx_PeriphCLKValid & PeriphClk) != 0U)
+    {
+      return RCCEx_PeriphCLKFreq[index];
+    }
+  }
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   if(PeriphClk == RCC_PERIPHCLK_RTC)
   {
     /* Get the current RTC source */
@@ -1254,6 +1307,16 @@ uint32_t HAL_RCCEx_GetPeriphCLKFreq(uint32_t PeriphClk)
     }
   }
 
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+  /* Keep the frequency unless the clock tree changed while it was computed */
+  if ((PeriphClk != 0U) && ((PeriphClk & (PeriphClk - 1U)) == 0U) &&
+      (HAL_RCC_GetClockTree()->Generation == generation))
+  {
+    RCCEx_PeriphCLKFreq[index] = frequency;
+    RCCEx_PeriphCLKValid |= PeriphClk;
+  }
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
   return(frequency);
 }
 
@@ -1328,6 +1391,11 @@ void HAL_RCCEx_LSECSS_IRQHandler(void)
   /* Check RCC LSE CSSF flag  */
   if(__HAL_RCC_GET_IT(RCC_IT_LSECSS))
   {
+#if (USE_HAL_RCC_CLOCK_CACHE == 1U)
+    /* The LSE clock is no longer supplied to the RTC */
+    HAL_RCC_InvalidateClockTree();
+#endif /* USE_HAL_RCC_CLOCK_CACHE */
+
     /* RCC LSE Clock Security System interrupt user callback */
     HAL_RCCEx_LSECSS_Callback();
 
@@ -1797,6 +1865,115 @@ __weak void HAL_RCCEx_CRS_ErrorCallback(uint32_t Error)
 
 #endif /* CRS */
 
+/** @defgroup RCCEx_Exported_Functions_Group4 Extended PLL solver functions
+ *  @brief  Extended PLL solver functions
+ *
+@verbatim
+ ===============================================================================
+                ##### Extended PLL solver functions  #####
+ ===============================================================================
+    [..]
+      HAL_RCCEx_PLLSolve() computes the PLL division and multiplication factors
+      reaching the target frequencies of the PLLP, PLLQ and PLLR outputs within
+      their tolerance, instead of choosing them by hand:
+
+      (#) Fill a RCC_PLLTargetTypeDef structure with the PLL entry clock and the
+          target frequency and tolerance of each output used.
+
+      (#) Call HAL_RCCEx_PLLSolve() to fill the PLL field of the RCC_OscInitTypeDef
+          structure given to HAL_RCC_OscConfig().
+
+      [..]
+      Among the configurations meeting all the tolerances, the one with the lowest
+      total frequency error is returned. Ties are broken by the highest VCO input
+      frequency, to lower the PLL jitter, then by the lowest VCO output frequency,
+      to lower the power consumption.
+      [..]
+      The solver only uses its parameters and does not access the RCC registers,
+      so it can also be used on a host to precompute a configuration at build time.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Compute a PLL configuration reaching the target output frequencies.
+  * @param  pTarget  pointer to an RCC_PLLTargetTypeDef structure giving the PLL
+  *         entry clock and the target output frequencies.
+  * @param  pPLLInit  pointer to an RCC_PLLInitTypeDef structure filled with the
+  *         PLL configuration, with PLLState set to RCC_PLL_ON.
+  * @retval HAL_OK when a configuration meets all the tolerances, HAL_ERROR otherwise
+  *         (pPLLInit is then left unchanged)
+  */
+HAL_StatusTypeDef HAL_RCCEx_PLLSolve(const RCC_PLLTargetTypeDef *pTarget, RCC_PLLInitTypeDef *pPLLInit)
+{
+  uint32_t pllm;
+  uint32_t plln;
+  uint32_t pllvcoin;
+  uint32_t pllvco;
+  uint32_t pllp = 0U;
+  uint32_t pllq = 0U;
+  uint32_t pllr = 0U;
+  uint32_t error;
+  uint32_t besterror = 0xFFFFFFFFU;
+  HAL_StatusTypeDef status = HAL_ERROR;
+
+  /* Check Null pointer */
+  if ((pTarget == NULL) || (pPLLInit == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Check the parameters */
+  assert_param(IS_RCC_PLLSOURCE(pTarget->PLLSource));
+
+  /* The VCO input frequency decreases with PLLM and the VCO output frequency
+     increases with PLLN: keeping only strictly lower errors selects the highest
+     VCO input frequency, then the lowest VCO output frequency, among equal errors */
+  for (pllm = 1U; pllm <= 16U; pllm++)
+  {
+    pllvcoin = pTarget->InputFreq / pllm;
+
+    if ((pllvcoin >= PLLVCO_INPUT_MIN) && (pllvcoin <= PLLVCO_INPUT_MAX))
+    {
+      for (plln = 8U; plln <= 127U; plln++)
+      {
+        /* Same computation as HAL_RCC_GetSysClockFreq() */
+        pllvco = pllvcoin * plln;
+
+        if ((pllvco >= PLLVCO_OUTPUT_MIN) && (pllvco <= PLLVCO_OUTPUT_MAX))
+        {
+          error = 0U;
+
+          if ((RCCEx_PLLSelectDivider(pllvco, pTarget->PLLPFreq, pTarget->PLLPTolerance, 2U, 31U, 1U, &pllp, &error) != 0U) &&
+              (RCCEx_PLLSelectDivider(pllvco, pTarget->PLLQFreq, pTarget->PLLQTolerance, 2U, 8U, 2U, &pllq, &error) != 0U) &&
+              (RCCEx_PLLSelectDivider(pllvco, pTarget->PLLRFreq, pTarget->PLLRTolerance, 2U, 8U, 2U, &pllr, &error) != 0U) &&
+              (error < besterror))
+          {
+            besterror = error;
+
+            pPLLInit->PLLState  = RCC_PLL_ON;
+            pPLLInit->PLLSource = pTarget->PLLSource;
+            pPLLInit->PLLM      = pllm;
+            pPLLInit->PLLN      = plln;
+            pPLLInit->PLLP      = pllp;
+            pPLLInit->PLLQ      = pllq;
+            pPLLInit->PLLR      = pllr;
+
+            status = HAL_OK;
+          }
+        }
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -1805,6 +1982,56 @@ __weak void HAL_RCCEx_CRS_ErrorCallback(uint32_t Error)
  * @{
  */
 
+/**
+  * @brief  Select the PLL output divider closest to a target frequency.
+  * @param  PLLVCOFreq  VCO output frequency in Hz.
+  * @param  Freq  Target frequency in Hz, 0 when the output is not used.
+  * @param  Tolerance  Maximum deviation from Freq in Hz.
+  * @param  DivMin  Lowest divider value.
+  * @param  DivMax  Highest divider value.
+  * @param  DivStep  Step between two divider values.
+  * @param  pDivider  Selected divider.
+  * @param  pError  Incremented by the deviation from Freq of the selected divider.
+  * @retval 1 when the deviation is within Tolerance, 0 otherwise
+  */
+static uint32_t RCCEx_PLLSelectDivider(uint32_t PLLVCOFreq, uint32_t Freq, uint32_t Tolerance, uint32_t DivMin,
+                                       uint32_t DivMax, uint32_t DivStep, uint32_t *pDivider, uint32_t *pError)
+{
+  uint32_t divider;
+  uint32_t candidate;
+  uint32_t outfreq;
+  uint32_t deviation;
+  uint32_t bestdeviation = 0xFFFFFFFFU;
+
+  if (Freq == 0U)
+  {
+    /* Unused output: lowest frequency */
+    *pDivider = DivMax;
+    return 1U;
+  }
+
+  /* Divider values around PLLVCOFreq / Freq */
+  divider = PLLVCOFreq / Freq;
+  divider = (divider > DivMin) ? (DivMin + (((divider - DivMin) / DivStep) * DivStep)) : DivMin;
+  divider = (divider > DivMax) ? DivMax : divider;
+
+  for (candidate = divider; (candidate <= (divider + DivStep)) && (candidate <= DivMax); candidate += DivStep)
+  {
+    outfreq = PLLVCOFreq / candidate;
+    deviation = (outfreq > Freq) ? (outfreq - Freq) : (Freq - outfreq);
+
+    if (deviation < bestdeviation)
+    {
+      bestdeviation = deviation;
+      *pDivider = candidate;
+    }
+  }
+
+  *pError += bestdeviation;
+
+  return (bestdeviation <= Tolerance) ? 1U : 0U;
+}
+
 /**
   * @}
   */
@@ -7,6 +7,7 @@
   *          functionalities of the SmartCard.
   *           + Initialization and de-initialization functions
   *           + Peripheral Control functions
+  *           + T=1 protocol functions
   *
   ******************************************************************************
   * @attention
@@ -36,6 +37,9 @@
             starting RX/TX transfers. Also RX/TX FIFO thresholds must be
             configured prior starting RX/TX transfers.
 
+    (#) APDU exchanges with the ISO/IEC 7816-3 T=1 block protocol, driven from the
+        SMARTCARD interrupt: see the T=1 protocol functions.
+
   @endverbatim
   ******************************************************************************
   */
@@ -63,6 +67,28 @@
 
 /* UART TX FIFO depth */
 #define TX_FIFO_DEPTH 8U
+
+/* T=1 exchange state */
+#define SMARTCARDEX_T1_STATE_IDLE         0x00U   /* No exchange                                  */
+#define SMARTCARDEX_T1_STATE_TX           0x01U   /* Block being sent, a block is expected next   */
+#define SMARTCARDEX_T1_STATE_TX_FINAL     0x02U   /* Last block of the exchange being sent        */
+#define SMARTCARDEX_T1_STATE_RX_PROLOGUE  0x03U   /* Waiting for the block prologue               */
+#define SMARTCARDEX_T1_STATE_RX_BODY      0x04U   /* Receiving the information field and EDC      */
+
+/* T=1 block fields */
+#define SMARTCARDEX_T1_PROLOGUE_SIZE      3U      /* NAD, PCB and LEN                             */
+#define SMARTCARDEX_T1_PCB_I_MASK         0x80U   /* Cleared for an I-block                       */
+#define SMARTCARDEX_T1_PCB_TYPE_MASK      0xC0U   /* Block type                                   */
+#define SMARTCARDEX_T1_PCB_I_NS_Pos       6U      /* I-block send sequence number                 */
+#define SMARTCARDEX_T1_PCB_MORE           0x20U   /* I-block chaining                             */
+#define SMARTCARDEX_T1_PCB_R_BLOCK        0x80U   /* R-block type                                 */
+#define SMARTCARDEX_T1_PCB_R_NR_Pos       4U      /* R-block sequence number                      */
+#define SMARTCARDEX_T1_PCB_R_EDC_ERROR    0x01U   /* R-block: EDC or parity error                 */
+#define SMARTCARDEX_T1_PCB_R_OTHER_ERROR  0x02U   /* R-block: other error                         */
+#define SMARTCARDEX_T1_PCB_S_RESPONSE     0x20U   /* S-block response                             */
+#define SMARTCARDEX_T1_PCB_S_IFS_REQ      0xC1U   /* S(IFS request)                               */
+#define SMARTCARDEX_T1_PCB_S_ABORT_REQ    0xC2U   /* S(ABORT request)                             */
+#define SMARTCARDEX_T1_PCB_S_WTX_REQ      0xC3U   /* S(WTX request)                               */
 /**
   * @}
   */
@@ -71,6 +97,13 @@
 /* Private variables ---------------------------------------------------------*/
 /* Private function prototypes -----------------------------------------------*/
 static void SMARTCARDEx_SetNbDataToProcess(SMARTCARD_HandleTypeDef *hsmartcard);
+static uint16_t SMARTCARDEx_T1_ComputeEDC(const SMARTCARDEx_T1TypeDef *ht1, const uint8_t *pBlock, uint16_t Length);
+static void SMARTCARDEx_T1_SendBlock(SMARTCARDEx_T1TypeDef *ht1, uint8_t Pcb, const uint8_t *pInf, uint8_t Length);
+static void SMARTCARDEx_T1_SendIBlock(SMARTCARDEx_T1TypeDef *ht1);
+static void SMARTCARDEx_T1_Resend(SMARTCARDEx_T1TypeDef *ht1);
+static void SMARTCARDEx_T1_Recover(SMARTCARDEx_T1TypeDef *ht1, uint8_t Reason, uint32_t Cause);
+static void SMARTCARDEx_T1_ProcessBlock(SMARTCARDEx_T1TypeDef *ht1);
+static void SMARTCARDEx_T1_Complete(SMARTCARDEx_T1TypeDef *ht1, uint32_t ErrorCode);
 
 /* Exported functions --------------------------------------------------------*/
 /** @defgroup SMARTCARDEx_Exported_Functions  SMARTCARD Extended Exported Functions
@@ -432,6 +465,280 @@ HAL_StatusTypeDef HAL_SMARTCARDEx_SetRxFifoThreshold(SMARTCARD_HandleTypeDef *hs
   return HAL_OK;
 }
 
+/**
+  * @}
+  */
+
+/** @defgroup SMARTCARDEx_Exported_Functions_Group4 Extended T=1 protocol functions
+  * @brief    SMARTCARD T=1 protocol functions
+  *
+@verbatim
+ ===============================================================================
+                      ##### T=1 protocol functions #####
+ ===============================================================================
+    [..]
+    This subsection provides a set of functions allowing to exchange APDUs with a
+    card using the ISO/IEC 7816-3 T=1 block protocol, entirely in interrupt mode:
+
+     (+) HAL_SMARTCARDEx_T1_Init() initializes a T=1 handle with the parameters of the card ATR.
+     (+) HAL_SMARTCARDEx_T1_Transceive_IT() sends a command APDU and collects the response APDU.
+         Command chaining, response chaining, waiting time extension, information field
+         size adjustment and error recovery are handled from the SMARTCARD interrupt.
+     (+) HAL_SMARTCARDEx_T1_TxCplt(), HAL_SMARTCARDEx_T1_RxCplt() and HAL_SMARTCARDEx_T1_Error()
+         are to be called from the HAL_SMARTCARD_TxCpltCallback(), HAL_SMARTCARD_RxCpltCallback()
+         and HAL_SMARTCARD_ErrorCallback() callbacks.
+     (+) HAL_SMARTCARDEx_T1_GetStats() gives the number of exchanges, the recoveries and the
+         exchange latency measured with the GetTime() handle field.
+
+    [..]
+     (@) The block and character waiting times are enforced with the receiver timeout:
+         Init.TimeOutEnable must be set to SMARTCARD_TIMEOUT_ENABLE in the SMARTCARD handle.
+         The BWT applies up to the third character of a block and the CWT to the remaining ones.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize a T=1 protocol handle.
+  * @param  ht1 Pointer to a SMARTCARDEx_T1TypeDef structure.
+  * @param  hsmartcard Pointer to a SMARTCARD_HandleTypeDef structure, initialized
+  *                    in TX/RX mode with the receiver timeout enabled.
+  * @param  pInit Protocol parameters.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SMARTCARDEx_T1_Init(SMARTCARDEx_T1TypeDef *ht1, SMARTCARD_HandleTypeDef *hsmartcard,
+                                          const SMARTCARDEx_T1InitTypeDef *pInit)
+{
+  if ((ht1 == NULL) || (hsmartcard == NULL) || (pInit == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  if ((pInit->IFSC == 0U) || (pInit->IFSC > SMARTCARDEX_T1_IFS_MAX) ||
+      (pInit->IFSD == 0U) || (pInit->IFSD > SMARTCARDEX_T1_IFS_MAX) ||
+      (pInit->EDC > SMARTCARDEX_T1_EDC_CRC) || (pInit->BWT == 0U) || (pInit->CWT == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  ht1->hsmartcard       = hsmartcard;
+  ht1->Init             = *pInit;
+  ht1->ErrorCode        = HAL_SMARTCARDEX_T1_ERROR_NONE;
+  ht1->State            = SMARTCARDEX_T1_STATE_IDLE;
+  ht1->SendSeq          = 0U;
+  ht1->RecvSeq          = 0U;
+  ht1->WTXMultiplier    = 1U;
+  ht1->GetTime          = HAL_GetTick;
+  ht1->ApduCpltCallback = NULL;
+  ht1->pContext         = NULL;
+  HAL_SMARTCARDEx_T1_ResetStats(ht1);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Exchange an APDU with the card in interrupt mode.
+  * @note   The end of the exchange is reported by the ApduCpltCallback handle field,
+  *         with RspLength and ErrorCode updated.
+  * @param  ht1 Pointer to a SMARTCARDEx_T1TypeDef structure.
+  * @param  pCmd Command APDU, which must remain valid until the end of the exchange.
+  * @param  CmdSize Command APDU length.
+  * @param  pRsp Response APDU buffer.
+  * @param  RspSize Size of the response APDU buffer.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SMARTCARDEx_T1_Transceive_IT(SMARTCARDEx_T1TypeDef *ht1, const uint8_t *pCmd, uint16_t CmdSize,
+                                                   uint8_t *pRsp, uint16_t RspSize)
+{
+  if ((pCmd == NULL) || (CmdSize == 0U) || (pRsp == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  if ((ht1->State != SMARTCARDEX_T1_STATE_IDLE) || (ht1->hsmartcard->gState != HAL_SMARTCARD_STATE_READY) ||
+      (ht1->hsmartcard->RxState != HAL_SMARTCARD_STATE_READY))
+  {
+    return HAL_BUSY;
+  }
+
+  ht1->pCmd          = pCmd;
+  ht1->CmdSize       = CmdSize;
+  ht1->CmdOffset     = 0U;
+  ht1->pRsp          = pRsp;
+  ht1->RspSize       = RspSize;
+  ht1->RspLength     = 0U;
+  ht1->ErrorCode     = HAL_SMARTCARDEX_T1_ERROR_NONE;
+  ht1->Retries       = 0U;
+  ht1->WTXMultiplier = 1U;
+  ht1->StartTime     = ht1->GetTime();
+
+  SMARTCARDEx_T1_SendIBlock(ht1);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Check whether an APDU exchange is in progress.
+  * @param  ht1 Pointer to a SMARTCARDEx_T1TypeDef structure.
+  * @retval 1 when an exchange is in progress, 0 otherwise
+  */
+uint32_t HAL_SMARTCARDEx_T1_IsBusy(const SMARTCARDEx_T1TypeDef *ht1)
+{
+  return (ht1->State != SMARTCARDEX_T1_STATE_IDLE) ? 1U : 0U;
+}
+
+/**
+  * @brief  Tx transfer completed handler, to be called from HAL_SMARTCARD_TxCpltCallback().
+  * @param  ht1 Pointer to a SMARTCARDEx_T1TypeDef structure.
+  * @retval None
+  */
+void HAL_SMARTCARDEx_T1_TxCplt(SMARTCARDEx_T1TypeDef *ht1)
+{
+  uint32_t timeout;
+
+  if (ht1->State == SMARTCARDEX_T1_STATE_TX)
+  {
+    /* Wait for the block prologue within the block waiting time */
+    timeout = ht1->Init.BWT * ht1->WTXMultiplier;
+    HAL_SMARTCARDEx_TimeOut_Config(ht1->hsmartcard, (timeout > USART_RTOR_RTO) ? USART_RTOR_RTO : timeout);
+
+    __HAL_SMARTCARD_CLEAR_FLAG(ht1->hsmartcard, SMARTCARD_CLEAR_RTOF);
+    __HAL_SMARTCARD_ENABLE_IT(ht1->hsmartcard, SMARTCARD_IT_RTO);
+
+    ht1->RxError = 0U;
+    ht1->State   = SMARTCARDEX_T1_STATE_RX_PROLOGUE;
+
+    if (HAL_SMARTCARD_Receive_IT(ht1->hsmartcard, ht1->RxBlock, SMARTCARDEX_T1_PROLOGUE_SIZE) != HAL_OK)
+    {
+      SMARTCARDEx_T1_Complete(ht1, HAL_SMARTCARDEX_T1_ERROR_SEND);
+    }
+  }
+  else if (ht1->State == SMARTCARDEX_T1_STATE_TX_FINAL)
+  {
+    SMARTCARDEx_T1_Complete(ht1, ht1->ErrorCode);
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+  * @brief  Rx transfer completed handler, to be called from HAL_SMARTCARD_RxCpltCallback().
+  * @param  ht1 Pointer to a SMARTCARDEx_T1TypeDef structure.
+  * @retval None
+  */
+void HAL_SMARTCARDEx_T1_RxCplt(SMARTCARDEx_T1TypeDef *ht1)
+{
+  uint16_t length;
+  uint16_t edc_size = (ht1->Init.EDC == SMARTCARDEX_T1_EDC_CRC) ? 2U : 1U;
+  uint16_t edc;
+
+  if (ht1->State == SMARTCARDEX_T1_STATE_RX_PROLOGUE)
+  {
+    /* A block has started: the waiting time extension is consumed */
+    ht1->WTXMultiplier = 1U;
+    HAL_SMARTCARDEx_TimeOut_Config(ht1->hsmartcard, ht1->Init.CWT);
+
+    length = ht1->RxBlock[2];
+    if ((length > ht1->Init.IFSD) || (length == 0xFFU))
+    {
+      /* Unknown block size: read until the character waiting time expires */
+      ht1->RxError = 1U;
+      length = SMARTCARDEX_T1_IFS_MAX;
+    }
+
+    ht1->State = SMARTCARDEX_T1_STATE_RX_BODY;
+
+    if (HAL_SMARTCARD_Receive_IT(ht1->hsmartcard, &ht1->RxBlock[SMARTCARDEX_T1_PROLOGUE_SIZE],
+                                 (uint16_t)(length + edc_size)) != HAL_OK)
+    {
+      SMARTCARDEx_T1_Complete(ht1, HAL_SMARTCARDEX_T1_ERROR_SEND);
+    }
+  }
+  else if (ht1->State == SMARTCARDEX_T1_STATE_RX_BODY)
+  {
+    __HAL_SMARTCARD_DISABLE_IT(ht1->hsmartcard, SMARTCARD_IT_RTO);
+    ht1->Stats.Blocks++;
+
+    length = (uint16_t)ht1->RxBlock[2] + SMARTCARDEX_T1_PROLOGUE_SIZE;
+    edc = SMARTCARDEx_T1_ComputeEDC(ht1, ht1->RxBlock, length);
+
+    if ((ht1->RxError != 0U) ||
+        ((ht1->Init.EDC == SMARTCARDEX_T1_EDC_LRC) && (ht1->RxBlock[length] != (uint8_t)edc)) ||
+        ((ht1->Init.EDC == SMARTCARDEX_T1_EDC_CRC) &&
+         ((ht1->RxBlock[length] != (uint8_t)edc) || (ht1->RxBlock[length + 1U] != (uint8_t)(edc >> 8U)))))
+    {
+      SMARTCARDEx_T1_Recover(ht1, SMARTCARDEX_T1_PCB_R_EDC_ERROR, HAL_SMARTCARDEX_T1_ERROR_NONE);
+    }
+    else
+    {
+      SMARTCARDEx_T1_ProcessBlock(ht1);
+    }
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+}
+
+/**
+  * @brief  Error handler, to be called from HAL_SMARTCARD_ErrorCallback().
+  * @param  ht1 Pointer to a SMARTCARDEx_T1TypeDef structure.
+  * @retval None
+  */
+void HAL_SMARTCARDEx_T1_Error(SMARTCARDEx_T1TypeDef *ht1)
+{
+  uint32_t error = ht1->hsmartcard->ErrorCode;
+
+  if ((ht1->State == SMARTCARDEX_T1_STATE_RX_PROLOGUE) || (ht1->State == SMARTCARDEX_T1_STATE_RX_BODY))
+  {
+    if ((error & (HAL_SMARTCARD_ERROR_PE | HAL_SMARTCARD_ERROR_FE | HAL_SMARTCARD_ERROR_NE)) != 0U)
+    {
+      /* Reception goes on: the block is rejected once complete */
+      ht1->RxError = 1U;
+    }
+
+    if ((error & (HAL_SMARTCARD_ERROR_RTO | HAL_SMARTCARD_ERROR_ORE)) != 0U)
+    {
+      /* Reception aborted by the HAL */
+      __HAL_SMARTCARD_DISABLE_IT(ht1->hsmartcard, SMARTCARD_IT_RTO);
+      SMARTCARDEx_T1_Recover(ht1,
+                             (ht1->RxError != 0U) ? SMARTCARDEX_T1_PCB_R_EDC_ERROR : SMARTCARDEX_T1_PCB_R_OTHER_ERROR,
+                             ((error & HAL_SMARTCARD_ERROR_RTO) != 0U) ? HAL_SMARTCARDEX_T1_ERROR_TIMEOUT :
+                             HAL_SMARTCARDEX_T1_ERROR_NONE);
+    }
+  }
+}
+
+/**
+  * @brief  Get the statistics of a T=1 handle.
+  * @param  ht1 Pointer to a SMARTCARDEx_T1TypeDef structure.
+  * @param  pStats Statistics.
+  * @retval None
+  */
+void HAL_SMARTCARDEx_T1_GetStats(const SMARTCARDEx_T1TypeDef *ht1, SMARTCARDEx_T1StatsTypeDef *pStats)
+{
+  *pStats = ht1->Stats;
+}
+
+/**
+  * @brief  Reset the statistics of a T=1 handle.
+  * @param  ht1 Pointer to a SMARTCARDEx_T1TypeDef structure.
+  * @retval None
+  */
+void HAL_SMARTCARDEx_T1_ResetStats(SMARTCARDEx_T1TypeDef *ht1)
+{
+  ht1->Stats.Apdus           = 0U;
+  ht1->Stats.Errors          = 0U;
+  ht1->Stats.Blocks          = 0U;
+  ht1->Stats.Retransmissions = 0U;
+  ht1->Stats.WTXRequests     = 0U;
+  ht1->Stats.LastLatency     = 0U;
+  ht1->Stats.MaxLatency      = 0U;
+}
+
 /**
   * @}
   */
@@ -479,6 +786,306 @@ static void SMARTCARDEx_SetNbDataToProcess(SMARTCARD_HandleTypeDef *hsmartcard)
   }
 }
 
+/**
+  * @brief  Compute the error detection code of a block.
+  * @param  ht1 T=1 handle.
+  * @param  pBlock Block prologue and information field.
+  * @param  Length Length of the prologue and information field.
+  * @retval LRC, or CRC of ISO/IEC 13239 sent least significant byte first
+  */
+static uint16_t SMARTCARDEx_T1_ComputeEDC(const SMARTCARDEx_T1TypeDef *ht1, const uint8_t *pBlock, uint16_t Length)
+{
+  uint16_t edc;
+
+  if (ht1->Init.EDC == SMARTCARDEX_T1_EDC_LRC)
+  {
+    edc = 0U;
+    for (uint16_t index = 0U; index < Length; index++)
+    {
+      edc ^= pBlock[index];
+    }
+  }
+  else
+  {
+    edc = 0xFFFFU;
+    for (uint16_t index = 0U; index < Length; index++)
+    {
+      edc ^= pBlock[index];
+      for (uint8_t bit = 0U; bit < 8U; bit++)
+      {
+        edc = ((edc & 0x0001U) != 0U) ? ((edc >> 1U) ^ 0x8408U) : (edc >> 1U);
+      }
+    }
+    edc = (uint16_t)~edc;
+  }
+
+  return edc;
+}
+
+/**
+  * @brief  Build and send a block.
+  * @param  ht1 T=1 handle.
+  * @param  Pcb Protocol control byte.
+  * @param  pInf Information field, may be NULL when Length is 0.
+  * @param  Length Information field length.
+  * @retval None
+  */
+static void SMARTCARDEx_T1_SendBlock(SMARTCARDEx_T1TypeDef *ht1, uint8_t Pcb, const uint8_t *pInf, uint8_t Length)
+{
+  uint16_t length = SMARTCARDEX_T1_PROLOGUE_SIZE + (uint16_t)Length;
+  uint16_t edc;
+
+  ht1->TxBlock[0] = ht1->Init.NAD;
+  ht1->TxBlock[1] = Pcb;
+  ht1->TxBlock[2] = Length;
+  for (uint16_t index = 0U; index < Length; index++)
+  {
+    ht1->TxBlock[SMARTCARDEX_T1_PROLOGUE_SIZE + index] = pInf[index];
+  }
+
+  edc = SMARTCARDEx_T1_ComputeEDC(ht1, ht1->TxBlock, length);
+  ht1->TxBlock[length] = (uint8_t)edc;
+  length++;
+  if (ht1->Init.EDC == SMARTCARDEX_T1_EDC_CRC)
+  {
+    ht1->TxBlock[length] = (uint8_t)(edc >> 8U);
+    length++;
+  }
+
+  ht1->TxLength = length;
+  SMARTCARDEx_T1_Resend(ht1);
+}
+
+/**
+  * @brief  Send the I-block carrying the next part of the command APDU.
+  * @param  ht1 T=1 handle.
+  * @retval None
+  */
+static void SMARTCARDEx_T1_SendIBlock(SMARTCARDEx_T1TypeDef *ht1)
+{
+  uint16_t remaining = ht1->CmdSize - ht1->CmdOffset;
+  uint8_t pcb = (uint8_t)(ht1->SendSeq << SMARTCARDEX_T1_PCB_I_NS_Pos);
+
+  if (remaining > ht1->Init.IFSC)
+  {
+    ht1->Chunk = ht1->Init.IFSC;
+    pcb |= SMARTCARDEX_T1_PCB_MORE;
+  }
+  else
+  {
+    ht1->Chunk = (uint8_t)remaining;
+  }
+
+  SMARTCARDEx_T1_SendBlock(ht1, pcb, &ht1->pCmd[ht1->CmdOffset], ht1->Chunk);
+}
+
+/**
+  * @brief  Send the last block again.
+  * @param  ht1 T=1 handle.
+  * @retval None
+  */
+static void SMARTCARDEx_T1_Resend(SMARTCARDEx_T1TypeDef *ht1)
+{
+  ht1->State = SMARTCARDEX_T1_STATE_TX;
+
+  if (HAL_SMARTCARD_Transmit_IT(ht1->hsmartcard, ht1->TxBlock, ht1->TxLength) != HAL_OK)
+  {
+    SMARTCARDEx_T1_Complete(ht1, HAL_SMARTCARDEX_T1_ERROR_SEND);
+  }
+}
+
+/**
+  * @brief  Recover from a bad, missing or unexpected block with an R-block.
+  * @param  ht1 T=1 handle.
+  * @param  Reason R-block error indication.
+  * @param  Cause Error code added when the exchange is failed.
+  * @retval None
+  */
+static void SMARTCARDEx_T1_Recover(SMARTCARDEx_T1TypeDef *ht1, uint8_t Reason, uint32_t Cause)
+{
+  ht1->Retries++;
+
+  if (ht1->Retries > SMARTCARDEX_T1_MAX_RETRIES)
+  {
+    SMARTCARDEx_T1_Complete(ht1, HAL_SMARTCARDEX_T1_ERROR_PROTOCOL | Cause);
+  }
+  else
+  {
+    ht1->Stats.Retransmissions++;
+    SMARTCARDEx_T1_SendBlock(ht1, SMARTCARDEX_T1_PCB_R_BLOCK | (uint8_t)(ht1->RecvSeq << SMARTCARDEX_T1_PCB_R_NR_Pos) |
+                             Reason, NULL, 0U);
+  }
+}
+
+/**
+  * @brief  Process a block received without error.
+  * @param  ht1 T=1 handle.
+  * @retval None
+  */
+static void SMARTCARDEx_T1_ProcessBlock(SMARTCARDEx_T1TypeDef *ht1)
+{
+  uint8_t pcb = ht1->RxBlock[1];
+  uint8_t length = ht1->RxBlock[2];
+  const uint8_t *p_inf = &ht1->RxBlock[SMARTCARDEX_T1_PROLOGUE_SIZE];
+  uint8_t command_sent = ((ht1->CmdOffset + ht1->Chunk) == ht1->CmdSize) ? 1U : 0U;
+
+  if ((pcb & SMARTCARDEX_T1_PCB_I_MASK) == 0U)
+  {
+    /* I-block: only valid once the last command block is sent */
+    if ((ht1->CmdOffset < ht1->CmdSize) && (command_sent == 0U))
+    {
+      SMARTCARDEx_T1_Recover(ht1, SMARTCARDEX_T1_PCB_R_OTHER_ERROR, HAL_SMARTCARDEX_T1_ERROR_NONE);
+    }
+    else if (((pcb >> SMARTCARDEX_T1_PCB_I_NS_Pos) & 1U) != ht1->RecvSeq)
+    {
+      SMARTCARDEx_T1_Recover(ht1, SMARTCARDEX_T1_PCB_R_OTHER_ERROR, HAL_SMARTCARDEX_T1_ERROR_NONE);
+    }
+    else
+    {
+      if (ht1->CmdOffset < ht1->CmdSize)
+      {
+        /* The response acknowledges the last command block */
+        ht1->CmdOffset = ht1->CmdSize;
+        ht1->SendSeq ^= 1U;
+      }
+
+      ht1->RecvSeq ^= 1U;
+      ht1->Retries = 0U;
+
+      if (((uint32_t)ht1->RspLength + length) > ht1->RspSize)
+      {
+        SMARTCARDEx_T1_Complete(ht1, HAL_SMARTCARDEX_T1_ERROR_OVERFLOW);
+      }
+      else
+      {
+        for (uint16_t index = 0U; index < length; index++)
+        {
+          ht1->pRsp[ht1->RspLength + index] = p_inf[index];
+        }
+        ht1->RspLength += length;
+
+        if ((pcb & SMARTCARDEX_T1_PCB_MORE) != 0U)
+        {
+          /* Acknowledge the chained block */
+          SMARTCARDEx_T1_SendBlock(ht1, SMARTCARDEX_T1_PCB_R_BLOCK |
+                                   (uint8_t)(ht1->RecvSeq << SMARTCARDEX_T1_PCB_R_NR_Pos), NULL, 0U);
+        }
+        else
+        {
+          SMARTCARDEx_T1_Complete(ht1, HAL_SMARTCARDEX_T1_ERROR_NONE);
+        }
+      }
+    }
+  }
+  else if ((pcb & SMARTCARDEX_T1_PCB_TYPE_MASK) == SMARTCARDEX_T1_PCB_R_BLOCK)
+  {
+    ht1->Retries++;
+
+    if (ht1->Retries > SMARTCARDEX_T1_MAX_RETRIES)
+    {
+      SMARTCARDEx_T1_Complete(ht1, HAL_SMARTCARDEX_T1_ERROR_PROTOCOL);
+    }
+    else if (ht1->CmdOffset < ht1->CmdSize)
+    {
+      if ((((pcb >> SMARTCARDEX_T1_PCB_R_NR_Pos) & 1U) != ht1->SendSeq) && (command_sent == 0U))
+      {
+        /* Chained command block acknowledged: send the next one */
+        ht1->CmdOffset += ht1->Chunk;
+        ht1->SendSeq ^= 1U;
+        ht1->Retries = 0U;
+      }
+      else
+      {
+        ht1->Stats.Retransmissions++;
+      }
+      SMARTCARDEx_T1_SendIBlock(ht1);
+    }
+    else
+    {
+      /* The card missed the last R-block */
+      ht1->Stats.Retransmissions++;
+      SMARTCARDEx_T1_Resend(ht1);
+    }
+  }
+  else
+  {
+    /* S-block: answer the card requests */
+    switch (pcb)
+    {
+      case SMARTCARDEX_T1_PCB_S_WTX_REQ:
+        if (length == 1U)
+        {
+          ht1->WTXMultiplier = (p_inf[0] != 0U) ? p_inf[0] : 1U;
+          ht1->Stats.WTXRequests++;
+          SMARTCARDEx_T1_SendBlock(ht1, SMARTCARDEX_T1_PCB_S_WTX_REQ | SMARTCARDEX_T1_PCB_S_RESPONSE, p_inf, 1U);
+        }
+        else
+        {
+          SMARTCARDEx_T1_Recover(ht1, SMARTCARDEX_T1_PCB_R_OTHER_ERROR, HAL_SMARTCARDEX_T1_ERROR_NONE);
+        }
+        break;
+
+      case SMARTCARDEX_T1_PCB_S_IFS_REQ:
+        if ((length == 1U) && (p_inf[0] != 0U) && (p_inf[0] <= SMARTCARDEX_T1_IFS_MAX))
+        {
+          ht1->Init.IFSC = p_inf[0];
+          SMARTCARDEx_T1_SendBlock(ht1, SMARTCARDEX_T1_PCB_S_IFS_REQ | SMARTCARDEX_T1_PCB_S_RESPONSE, p_inf, 1U);
+        }
+        else
+        {
+          SMARTCARDEx_T1_Recover(ht1, SMARTCARDEX_T1_PCB_R_OTHER_ERROR, HAL_SMARTCARDEX_T1_ERROR_NONE);
+        }
+        break;
+
+      case SMARTCARDEX_T1_PCB_S_ABORT_REQ:
+        /* Confirm, then end the exchange */
+        SMARTCARDEx_T1_SendBlock(ht1, SMARTCARDEX_T1_PCB_S_ABORT_REQ | SMARTCARDEX_T1_PCB_S_RESPONSE, NULL, 0U);
+        if (ht1->State == SMARTCARDEX_T1_STATE_TX)
+        {
+          ht1->ErrorCode = HAL_SMARTCARDEX_T1_ERROR_ABORTED;
+          ht1->State     = SMARTCARDEX_T1_STATE_TX_FINAL;
+        }
+        break;
+
+      default:
+        SMARTCARDEx_T1_Recover(ht1, SMARTCARDEX_T1_PCB_R_OTHER_ERROR, HAL_SMARTCARDEX_T1_ERROR_NONE);
+        break;
+    }
+  }
+}
+
+/**
+  * @brief  End the APDU exchange in progress.
+  * @param  ht1 T=1 handle.
+  * @param  ErrorCode Error code of the exchange.
+  * @retval None
+  */
+static void SMARTCARDEx_T1_Complete(SMARTCARDEx_T1TypeDef *ht1, uint32_t ErrorCode)
+{
+  uint32_t latency = ht1->GetTime() - ht1->StartTime;
+
+  __HAL_SMARTCARD_DISABLE_IT(ht1->hsmartcard, SMARTCARD_IT_RTO);
+
+  ht1->ErrorCode = ErrorCode;
+  ht1->State     = SMARTCARDEX_T1_STATE_IDLE;
+
+  ht1->Stats.Apdus++;
+  if (ErrorCode != HAL_SMARTCARDEX_T1_ERROR_NONE)
+  {
+    ht1->Stats.Errors++;
+  }
+  ht1->Stats.LastLatency = latency;
+  if (latency > ht1->Stats.MaxLatency)
+  {
+    ht1->Stats.MaxLatency = latency;
+  }
+
+  if (ht1->ApduCpltCallback != NULL)
+  {
+    ht1->ApduCpltCallback(ht1);
+  }
+}
+
 /**
   * @}
   */
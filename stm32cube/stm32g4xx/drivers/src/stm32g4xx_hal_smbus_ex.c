@@ -28,6 +28,8 @@
 
        (+) Disable or enable wakeup from Stop mode(s)
        (+) Disable or enable Fast Mode Plus
+       (+) Compute a PEC with a CRC-8 table
+       (+) Run complete bus protocol transactions from interrupt context
 
                      ##### How to use this driver #####
   ==============================================================================
@@ -37,6 +39,20 @@
     (#) Configure the enable or disable of fast mode plus driving capability using the functions :
           (++) HAL_SMBUSEx_EnableFastModePlus()
           (++) HAL_SMBUSEx_DisableFastModePlus()
+    (#) Compute a PEC in software using the function HAL_SMBUSEx_CalculatePEC()
+    (#) Run write byte/word, block write, read byte/word, block read, process call and block process
+        call transactions without going back to thread context between their write and read parts:
+          (++) Initialize a SMBUSEx_EngineTypeDef with HAL_SMBUSEx_EngineInit() on a SMBUS handle
+               configured in master mode. SMBUSEX_PEC_AUTO uses the hardware PEC when
+               Init.PacketErrorCheckMode is SMBUS_PEC_ENABLE, the CRC-8 table otherwise.
+          (++) Call HAL_SMBUSEx_EngineMasterTxCplt() from HAL_SMBUS_MasterTxCpltCallback(),
+               HAL_SMBUSEx_EngineMasterRxCplt() from HAL_SMBUS_MasterRxCpltCallback() and
+               HAL_SMBUSEx_EngineError() from HAL_SMBUS_ErrorCallback().
+          (++) Fill a SMBUSEx_TransactionTypeDef and start it with HAL_SMBUSEx_Transaction_IT(), from
+               thread or interrupt context. The write part, the repeated start and the read part
+               are chained from the SMBUS interrupt.
+          (++) The engine XferCpltCallback is called at the end of the transaction, with ErrorCode set
+               on failure. HAL_SMBUSEx_EngineIsBusy() can be polled instead.
   @endverbatim
   */
 
@@ -56,9 +72,58 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
+/** @defgroup SMBUSEx_Private_Define SMBUS Extended Private Define
+  * @{
+  */
+#define SMBUSEX_PHASE_IDLE        0x00U   /*!< No transaction                                */
+#define SMBUSEX_PHASE_WRITE       0x01U   /*!< Write part ended by a stop                    */
+#define SMBUSEX_PHASE_COMMAND     0x02U   /*!< Write part followed by a repeated start       */
+#define SMBUSEX_PHASE_COUNT       0x03U   /*!< Block count reception                         */
+#define SMBUSEX_PHASE_DATA        0x04U   /*!< Read part ended by a stop                     */
+#define SMBUSEX_PHASE_FLUSH       0x05U   /*!< Bus release after a wrong block count         */
+/**
+  * @}
+  */
+
 /* Private macro -------------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
+/** @defgroup SMBUSEx_Private_Variables SMBUS Extended Private Variables
+  * @{
+  */
+/* CRC-8 table, polynomial x^8 + x^2 + x + 1 */
+static const uint8_t SMBUSEx_PECTable[256] =
+{
+  0x00U, 0x07U, 0x0EU, 0x09U, 0x1CU, 0x1BU, 0x12U, 0x15U, 0x38U, 0x3FU, 0x36U, 0x31U, 0x24U, 0x23U, 0x2AU, 0x2DU,
+  0x70U, 0x77U, 0x7EU, 0x79U, 0x6CU, 0x6BU, 0x62U, 0x65U, 0x48U, 0x4FU, 0x46U, 0x41U, 0x54U, 0x53U, 0x5AU, 0x5DU,
+  0xE0U, 0xE7U, 0xEEU, 0xE9U, 0xFCU, 0xFBU, 0xF2U, 0xF5U, 0xD8U, 0xDFU, 0xD6U, 0xD1U, 0xC4U, 0xC3U, 0xCAU, 0xCDU,
+  0x90U, 0x97U, 0x9EU, 0x99U, 0x8CU, 0x8BU, 0x82U, 0x85U, 0xA8U, 0xAFU, 0xA6U, 0xA1U, 0xB4U, 0xB3U, 0xBAU, 0xBDU,
+  0xC7U, 0xC0U, 0xC9U, 0xCEU, 0xDBU, 0xDCU, 0xD5U, 0xD2U, 0xFFU, 0xF8U, 0xF1U, 0xF6U, 0xE3U, 0xE4U, 0xEDU, 0xEAU,
+  0xB7U, 0xB0U, 0xB9U, 0xBEU, 0xABU, 0xACU, 0xA5U, 0xA2U, 0x8FU, 0x88U, 0x81U, 0x86U, 0x93U, 0x94U, 0x9DU, 0x9AU,
+  0x27U, 0x20U, 0x29U, 0x2EU, 0x3BU, 0x3CU, 0x35U, 0x32U, 0x1FU, 0x18U, 0x11U, 0x16U, 0x03U, 0x04U, 0x0DU, 0x0AU,
+  0x57U, 0x50U, 0x59U, 0x5EU, 0x4BU, 0x4CU, 0x45U, 0x42U, 0x6FU, 0x68U, 0x61U, 0x66U, 0x73U, 0x74U, 0x7DU, 0x7AU,
+  0x89U, 0x8EU, 0x87U, 0x80U, 0x95U, 0x92U, 0x9BU, 0x9CU, 0xB1U, 0xB6U, 0xBFU, 0xB8U, 0xADU, 0xAAU, 0xA3U, 0xA4U,
+  0xF9U, 0xFEU, 0xF7U, 0xF0U, 0xE5U, 0xE2U, 0xEBU, 0xECU, 0xC1U, 0xC6U, 0xCFU, 0xC8U, 0xDDU, 0xDAU, 0xD3U, 0xD4U,
+  0x69U, 0x6EU, 0x67U, 0x60U, 0x75U, 0x72U, 0x7BU, 0x7CU, 0x51U, 0x56U, 0x5FU, 0x58U, 0x4DU, 0x4AU, 0x43U, 0x44U,
+  0x19U, 0x1EU, 0x17U, 0x10U, 0x05U, 0x02U, 0x0BU, 0x0CU, 0x21U, 0x26U, 0x2FU, 0x28U, 0x3DU, 0x3AU, 0x33U, 0x34U,
+  0x4EU, 0x49U, 0x40U, 0x47U, 0x52U, 0x55U, 0x5CU, 0x5BU, 0x76U, 0x71U, 0x78U, 0x7FU, 0x6AU, 0x6DU, 0x64U, 0x63U,
+  0x3EU, 0x39U, 0x30U, 0x37U, 0x22U, 0x25U, 0x2CU, 0x2BU, 0x06U, 0x01U, 0x08U, 0x0FU, 0x1AU, 0x1DU, 0x14U, 0x13U,
+  0xAEU, 0xA9U, 0xA0U, 0xA7U, 0xB2U, 0xB5U, 0xBCU, 0xBBU, 0x96U, 0x91U, 0x98U, 0x9FU, 0x8AU, 0x8DU, 0x84U, 0x83U,
+  0xDEU, 0xD9U, 0xD0U, 0xD7U, 0xC2U, 0xC5U, 0xCCU, 0xCBU, 0xE6U, 0xE1U, 0xE8U, 0xEFU, 0xFAU, 0xFDU, 0xF4U, 0xF3U
+};
+/**
+  * @}
+  */
+
 /* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SMBUSEx_Private_Functions
+  * @{
+  */
+static HAL_StatusTypeDef SMBUSEx_StartRead(SMBUSEx_EngineTypeDef *hengine, uint8_t Phase, uint16_t Size);
+static void SMBUSEx_Complete(SMBUSEx_EngineTypeDef *hengine, uint32_t ErrorCode);
+/**
+  * @}
+  */
+
 /* Private functions ---------------------------------------------------------*/
 
 /** @defgroup SMBUSEx_Exported_Functions SMBUS Extended Exported Functions
@@ -236,6 +301,385 @@ void HAL_SMBUSEx_DisableFastModePlus(uint32_t ConfigFastModePlus)
   * @}
   */
 
+/** @defgroup SMBUSEx_Exported_Functions_Group4 PEC and Transaction Functions
+  * @brief    PEC and Transaction Functions
+  *
+@verbatim
+ ===============================================================================
+                      ##### PEC and Transaction Functions #####
+ ===============================================================================
+    [..] This section provides functions allowing to:
+      (+) Compute a PEC in software
+      (+) Run a complete bus protocol transaction in interrupt mode
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Compute the PEC (CRC-8) of a buffer.
+  * @note   The PEC of a message sent in several parts is obtained by passing the
+  *         result of each part as InitialPEC of the next one, starting from 0.
+  * @param  InitialPEC PEC of the preceding bytes, 0 for the first part.
+  * @param  pData Pointer to data buffer, including the address bytes.
+  * @param  Size Amount of data.
+  * @retval PEC value
+  */
+uint8_t HAL_SMBUSEx_CalculatePEC(uint8_t InitialPEC, const uint8_t *pData, uint32_t Size)
+{
+  uint8_t pec = InitialPEC;
+
+  for (uint32_t index = 0U; index < Size; index++)
+  {
+    pec = SMBUSEx_PECTable[pec ^ pData[index]];
+  }
+
+  return pec;
+}
+
+/**
+  * @brief  Initialize a transaction engine.
+  * @param  hengine Pointer to a SMBUSEx_EngineTypeDef structure.
+  * @param  hsmbus Pointer to a SMBUS_HandleTypeDef structure initialized in master mode.
+  * @param  PECMode PEC mode of the transactions.
+  *         This parameter can be one of the @ref SMBUSEx_PEC_Mode values
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SMBUSEx_EngineInit(SMBUSEx_EngineTypeDef *hengine, SMBUS_HandleTypeDef *hsmbus,
+                                         uint32_t PECMode)
+{
+  uint32_t pec_mode = PECMode;
+
+  if ((hengine == NULL) || (hsmbus == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  if (pec_mode == SMBUSEX_PEC_AUTO)
+  {
+    pec_mode = (hsmbus->Init.PacketErrorCheckMode == SMBUS_PEC_ENABLE) ? SMBUSEX_PEC_HARDWARE : SMBUSEX_PEC_SOFTWARE;
+  }
+  else if ((pec_mode == SMBUSEX_PEC_HARDWARE) && (hsmbus->Init.PacketErrorCheckMode != SMBUS_PEC_ENABLE))
+  {
+    return HAL_ERROR;
+  }
+  else if (pec_mode > SMBUSEX_PEC_AUTO)
+  {
+    return HAL_ERROR;
+  }
+  else
+  {
+    /* Nothing to do */
+  }
+
+  hengine->hsmbus           = hsmbus;
+  hengine->pXact            = NULL;
+  hengine->PECMode          = pec_mode;
+  hengine->ErrorCode        = HAL_SMBUS_ERROR_NONE;
+  hengine->Phase            = SMBUSEX_PHASE_IDLE;
+  hengine->XferCpltCallback = NULL;
+  hengine->pContext         = NULL;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Start a transaction in interrupt mode.
+  * @note   This function can be called from interrupt context, including from the
+  *         engine XferCpltCallback of a successful transaction.
+  * @param  hengine Pointer to a SMBUSEx_EngineTypeDef structure.
+  * @param  pXact Pointer to the transaction, which must remain valid until its end.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SMBUSEx_Transaction_IT(SMBUSEx_EngineTypeDef *hengine, SMBUSEx_TransactionTypeDef *pXact)
+{
+  HAL_StatusTypeDef status;
+  uint8_t address = (uint8_t)(pXact->DevAddress & 0xFEU);
+  uint16_t tx_size = 1U;
+  uint16_t data_size;
+  uint32_t options;
+
+  if ((hengine->Phase != SMBUSEX_PHASE_IDLE) || (hengine->hsmbus->State != HAL_SMBUS_STATE_READY))
+  {
+    return HAL_BUSY;
+  }
+
+  switch (pXact->Protocol)
+  {
+    case SMBUSEX_WRITE_BYTE:
+      data_size = 1U;
+      break;
+    case SMBUSEX_WRITE_WORD:
+    case SMBUSEX_PROCESS_CALL:
+      data_size = 2U;
+      break;
+    case SMBUSEX_BLOCK_WRITE:
+    case SMBUSEX_BLOCK_PROCESS_CALL:
+      if ((pXact->TxSize == 0U) || (pXact->TxSize > SMBUSEX_BLOCK_MAX))
+      {
+        return HAL_ERROR;
+      }
+      hengine->TxBuf[tx_size] = pXact->TxSize;
+      tx_size++;
+      data_size = pXact->TxSize;
+      break;
+    case SMBUSEX_READ_BYTE:
+    case SMBUSEX_READ_WORD:
+    case SMBUSEX_BLOCK_READ:
+      data_size = 0U;
+      break;
+    default:
+      return HAL_ERROR;
+  }
+
+  if (((data_size != 0U) && (pXact->pTxData == NULL)) ||
+      ((pXact->Protocol > SMBUSEX_BLOCK_WRITE) && (pXact->pRxData == NULL)))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Command code and data written */
+  hengine->TxBuf[0] = pXact->Command;
+  for (uint16_t index = 0U; index < data_size; index++)
+  {
+    hengine->TxBuf[tx_size] = pXact->pTxData[index];
+    tx_size++;
+  }
+
+  if (hengine->PECMode == SMBUSEX_PEC_SOFTWARE)
+  {
+    hengine->PEC = HAL_SMBUSEx_CalculatePEC(0U, &address, 1U);
+    hengine->PEC = HAL_SMBUSEx_CalculatePEC(hengine->PEC, hengine->TxBuf, tx_size);
+  }
+
+  if (pXact->Protocol <= SMBUSEX_BLOCK_WRITE)
+  {
+    /* Write only: the PEC ends the write part */
+    options = SMBUS_FIRST_AND_LAST_FRAME_NO_PEC;
+    if (hengine->PECMode == SMBUSEX_PEC_SOFTWARE)
+    {
+      hengine->TxBuf[tx_size] = hengine->PEC;
+      tx_size++;
+    }
+    else if (hengine->PECMode == SMBUSEX_PEC_HARDWARE)
+    {
+      /* Room for the PEC byte, sent by the peripheral */
+      options = SMBUS_FIRST_AND_LAST_FRAME_WITH_PEC;
+      tx_size++;
+    }
+    else
+    {
+      /* Nothing to do */
+    }
+    hengine->Phase = SMBUSEX_PHASE_WRITE;
+  }
+  else
+  {
+    /* The read part follows after a repeated start */
+    options = SMBUS_FIRST_FRAME;
+    hengine->Phase = SMBUSEX_PHASE_COMMAND;
+  }
+
+  hengine->pXact     = pXact;
+  hengine->ErrorCode = HAL_SMBUS_ERROR_NONE;
+
+  status = HAL_SMBUS_Master_Transmit_IT(hengine->hsmbus, pXact->DevAddress, hengine->TxBuf, tx_size, options);
+
+  if (status != HAL_OK)
+  {
+    hengine->Phase = SMBUSEX_PHASE_IDLE;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Check whether a transaction is in progress.
+  * @param  hengine Pointer to a SMBUSEx_EngineTypeDef structure.
+  * @retval 1 when a transaction is in progress, 0 otherwise
+  */
+uint32_t HAL_SMBUSEx_EngineIsBusy(const SMBUSEx_EngineTypeDef *hengine)
+{
+  return (hengine->Phase != SMBUSEX_PHASE_IDLE) ? 1U : 0U;
+}
+
+/**
+  * @brief  Master Tx transfer completed handler, to be called from HAL_SMBUS_MasterTxCpltCallback().
+  * @param  hengine Pointer to a SMBUSEx_EngineTypeDef structure.
+  * @retval None
+  */
+void HAL_SMBUSEx_EngineMasterTxCplt(SMBUSEx_EngineTypeDef *hengine)
+{
+  uint8_t address;
+  uint16_t rx_size;
+
+  if (hengine->Phase == SMBUSEX_PHASE_WRITE)
+  {
+    SMBUSEx_Complete(hengine, HAL_SMBUS_ERROR_NONE);
+  }
+  else if (hengine->Phase == SMBUSEX_PHASE_COMMAND)
+  {
+    if (hengine->PECMode == SMBUSEX_PEC_SOFTWARE)
+    {
+      address = (uint8_t)((hengine->pXact->DevAddress & 0xFEU) | 0x01U);
+      hengine->PEC = HAL_SMBUSEx_CalculatePEC(hengine->PEC, &address, 1U);
+    }
+
+    if ((hengine->pXact->Protocol == SMBUSEX_BLOCK_READ) || (hengine->pXact->Protocol == SMBUSEX_BLOCK_PROCESS_CALL))
+    {
+      (void)SMBUSEx_StartRead(hengine, SMBUSEX_PHASE_COUNT, 1U);
+    }
+    else
+    {
+      hengine->Count = (hengine->pXact->Protocol == SMBUSEX_READ_BYTE) ? 1U : 2U;
+      rx_size = (uint16_t)hengine->Count + ((hengine->PECMode != SMBUSEX_PEC_NONE) ? 1U : 0U);
+      (void)SMBUSEx_StartRead(hengine, SMBUSEX_PHASE_DATA, rx_size);
+    }
+  }
+  else
+  {
+    /* Completion following an error: already reported */
+  }
+}
+
+/**
+  * @brief  Master Rx transfer completed handler, to be called from HAL_SMBUS_MasterRxCpltCallback().
+  * @param  hengine Pointer to a SMBUSEx_EngineTypeDef structure.
+  * @retval None
+  */
+void HAL_SMBUSEx_EngineMasterRxCplt(SMBUSEx_EngineTypeDef *hengine)
+{
+  SMBUSEx_TransactionTypeDef *p_xact = hengine->pXact;
+  uint32_t error = HAL_SMBUS_ERROR_NONE;
+  uint16_t rx_size;
+
+  if (hengine->Phase == SMBUSEX_PHASE_COUNT)
+  {
+    if (hengine->PECMode == SMBUSEX_PEC_SOFTWARE)
+    {
+      hengine->PEC = HAL_SMBUSEx_CalculatePEC(hengine->PEC, &hengine->Count, 1U);
+    }
+
+    if ((hengine->Count == 0U) || (hengine->Count > SMBUSEX_BLOCK_MAX) || (hengine->Count > p_xact->RxSize))
+    {
+      /* Read one more byte to end the transfer with a NACK and a stop */
+      (void)SMBUSEx_StartRead(hengine, SMBUSEX_PHASE_FLUSH, 1U);
+    }
+    else
+    {
+      rx_size = (uint16_t)hengine->Count + ((hengine->PECMode != SMBUSEX_PEC_NONE) ? 1U : 0U);
+      (void)SMBUSEx_StartRead(hengine, SMBUSEX_PHASE_DATA, rx_size);
+    }
+  }
+  else if (hengine->Phase == SMBUSEX_PHASE_DATA)
+  {
+    if ((hengine->PECMode == SMBUSEX_PEC_SOFTWARE) &&
+        (HAL_SMBUSEx_CalculatePEC(hengine->PEC, hengine->RxBuf, hengine->Count) != hengine->RxBuf[hengine->Count]))
+    {
+      error = HAL_SMBUS_ERROR_PECERR;
+    }
+
+    for (uint32_t index = 0U; index < hengine->Count; index++)
+    {
+      p_xact->pRxData[index] = hengine->RxBuf[index];
+    }
+    p_xact->RxSize = hengine->Count;
+
+    SMBUSEx_Complete(hengine, error);
+  }
+  else if (hengine->Phase == SMBUSEX_PHASE_FLUSH)
+  {
+    p_xact->RxSize = 0U;
+    SMBUSEx_Complete(hengine, HAL_SMBUSEX_ERROR_BLOCKSIZE);
+  }
+  else
+  {
+    /* Completion following an error: already reported */
+  }
+}
+
+/**
+  * @brief  Error handler, to be called from HAL_SMBUS_ErrorCallback().
+  * @note   The SMBUS handle may still be busy ending the transfer when the engine
+  *         XferCpltCallback is called: a new transaction is then refused with HAL_BUSY.
+  * @param  hengine Pointer to a SMBUSEx_EngineTypeDef structure.
+  * @retval None
+  */
+void HAL_SMBUSEx_EngineError(SMBUSEx_EngineTypeDef *hengine)
+{
+  if (hengine->Phase != SMBUSEX_PHASE_IDLE)
+  {
+    SMBUSEx_Complete(hengine, hengine->hsmbus->ErrorCode);
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup SMBUSEx_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Start the read part of a transaction.
+  * @param  hengine Pointer to a SMBUSEx_EngineTypeDef structure.
+  * @param  Phase Read phase.
+  * @param  Size Amount of data to receive, PEC byte included.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SMBUSEx_StartRead(SMBUSEx_EngineTypeDef *hengine, uint8_t Phase, uint16_t Size)
+{
+  HAL_StatusTypeDef status;
+  uint8_t *p_data;
+  uint32_t options;
+
+  if (Phase == SMBUSEX_PHASE_COUNT)
+  {
+    /* Reload mode: the data size is only known once the count is received */
+    p_data  = &hengine->Count;
+    options = SMBUS_NEXT_FRAME;
+  }
+  else
+  {
+    p_data  = hengine->RxBuf;
+    options = ((Phase == SMBUSEX_PHASE_DATA) && (hengine->PECMode == SMBUSEX_PEC_HARDWARE)) ?
+              SMBUS_LAST_FRAME_WITH_PEC : SMBUS_LAST_FRAME_NO_PEC;
+  }
+
+  hengine->Phase = Phase;
+
+  status = HAL_SMBUS_Master_Receive_IT(hengine->hsmbus, hengine->pXact->DevAddress, p_data, Size, options);
+
+  if (status != HAL_OK)
+  {
+    SMBUSEx_Complete(hengine, HAL_SMBUSEX_ERROR_SEQUENCE);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  End the transaction in progress.
+  * @param  hengine Pointer to a SMBUSEx_EngineTypeDef structure.
+  * @param  ErrorCode Error code of the transaction.
+  * @retval None
+  */
+static void SMBUSEx_Complete(SMBUSEx_EngineTypeDef *hengine, uint32_t ErrorCode)
+{
+  hengine->ErrorCode = ErrorCode;
+  hengine->Phase     = SMBUSEX_PHASE_IDLE;
+
+  if (hengine->XferCpltCallback != NULL)
+  {
+    hengine->XferCpltCallback(hengine);
+  }
+}
+
 /**
   * @}
   */
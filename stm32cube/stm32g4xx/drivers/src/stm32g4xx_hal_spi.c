@@ -824,11 +824,13 @@ HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint
   HAL_StatusTypeDef errorcode = HAL_OK;
   uint16_t initial_TxXferCount;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_SPI_TRANSMIT, hspi);
+
   /* Check Direction parameter */
   assert_param(IS_SPI_DIRECTION_2LINES_OR_1LINE(hspi->Init.Direction));
 
   /* Process Locked */
-  __HAL_LOCK(hspi);
+  __HAL_LOCK_TRACE(hspi, HAL_TRACE_ID_SPI_TRANSMIT);
 
   /* Init tickstart for timeout management*/
   tickstart = HAL_GetTick();
@@ -991,6 +993,7 @@ error:
   hspi->State = HAL_SPI_STATE_READY;
   /* Process Unlocked */
   __HAL_UNLOCK(hspi);
+  HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_TRANSMIT, hspi);
   return errorcode;
 }
 
@@ -1013,15 +1016,18 @@ HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint1
   uint32_t tickstart;
   HAL_StatusTypeDef errorcode = HAL_OK;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_SPI_RECEIVE, hspi);
+
   if ((hspi->Init.Mode == SPI_MODE_MASTER) && (hspi->Init.Direction == SPI_DIRECTION_2LINES))
   {
     hspi->State = HAL_SPI_STATE_BUSY_RX;
+    HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_RECEIVE, hspi);
     /* Call transmit-receive function to send Dummy data on Tx line and generate clock on CLK line */
     return HAL_SPI_TransmitReceive(hspi, pData, pData, Size, Timeout);
   }
 
   /* Process Locked */
-  __HAL_LOCK(hspi);
+  __HAL_LOCK_TRACE(hspi, HAL_TRACE_ID_SPI_RECEIVE);
 
   /* Init tickstart for timeout management*/
   tickstart = HAL_GetTick();
@@ -1230,6 +1236,7 @@ HAL_StatusTypeDef HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *pData, uint1
 error :
   hspi->State = HAL_SPI_STATE_READY;
   __HAL_UNLOCK(hspi);
+  HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_RECEIVE, hspi);
   return errorcode;
 }
 
@@ -1263,11 +1270,13 @@ HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxD
   uint32_t             txallowed = 1U;
   HAL_StatusTypeDef    errorcode = HAL_OK;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_SPI_TRANSMITRECEIVE, hspi);
+
   /* Check Direction parameter */
   assert_param(IS_SPI_DIRECTION_2LINES(hspi->Init.Direction));
 
   /* Process Locked */
-  __HAL_LOCK(hspi);
+  __HAL_LOCK_TRACE(hspi, HAL_TRACE_ID_SPI_TRANSMITRECEIVE);
 
   /* Init tickstart for timeout management*/
   tickstart = HAL_GetTick();
@@ -1541,6 +1550,7 @@ HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxD
 error :
   hspi->State = HAL_SPI_STATE_READY;
   __HAL_UNLOCK(hspi);
+  HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_TRANSMITRECEIVE, hspi);
   return errorcode;
 }
 
@@ -2721,11 +2731,14 @@ void HAL_SPI_IRQHandler(SPI_HandleTypeDef *hspi)
   uint32_t itsource = hspi->Instance->CR2;
   uint32_t itflag   = hspi->Instance->SR;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_SPI_IRQHANDLER, hspi);
+
   /* SPI in mode Receiver ----------------------------------------------------*/
   if ((SPI_CHECK_FLAG(itflag, SPI_FLAG_OVR) == RESET) &&
       (SPI_CHECK_FLAG(itflag, SPI_FLAG_RXNE) != RESET) && (SPI_CHECK_IT_SOURCE(itsource, SPI_IT_RXNE) != RESET))
   {
     hspi->RxISR(hspi);
+    HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_IRQHANDLER, hspi);
     return;
   }
 
@@ -2733,6 +2746,7 @@ void HAL_SPI_IRQHandler(SPI_HandleTypeDef *hspi)
   if ((SPI_CHECK_FLAG(itflag, SPI_FLAG_TXE) != RESET) && (SPI_CHECK_IT_SOURCE(itsource, SPI_IT_TXE) != RESET))
   {
     hspi->TxISR(hspi);
+    HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_IRQHANDLER, hspi);
     return;
   }
 
@@ -2751,6 +2765,7 @@ void HAL_SPI_IRQHandler(SPI_HandleTypeDef *hspi)
       else
       {
         __HAL_SPI_CLEAR_OVRFLAG(hspi);
+        HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_IRQHANDLER, hspi);
         return;
       }
     }
@@ -2813,8 +2828,11 @@ void HAL_SPI_IRQHandler(SPI_HandleTypeDef *hspi)
 #endif /* USE_HAL_SPI_REGISTER_CALLBACKS */
       }
     }
+    HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_IRQHANDLER, hspi);
     return;
   }
+
+  HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_IRQHANDLER, hspi);
 }
 
 /**
@@ -3917,6 +3935,8 @@ static HAL_StatusTypeDef SPI_WaitFlagStateUntilTimeout(SPI_HandleTypeDef *hspi,
   uint32_t tmp_timeout;
   uint32_t tmp_tickstart;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_SPI_WAITFLAGSTATEUNTILTIMEOUT, hspi);
+
   /* Adjust Timeout value  in case of end of transfer */
   tmp_timeout   = Timeout - (HAL_GetTick() - Tickstart);
   tmp_tickstart = HAL_GetTick();
@@ -3955,6 +3975,7 @@ static HAL_StatusTypeDef SPI_WaitFlagStateUntilTimeout(SPI_HandleTypeDef *hspi,
         /* Process Unlocked */
         __HAL_UNLOCK(hspi);
 
+        HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_WAITFLAGSTATEUNTILTIMEOUT, hspi);
         return HAL_TIMEOUT;
       }
       /* If Systick is disabled or not incremented, deactivate timeout to go in disable loop procedure */
@@ -3964,8 +3985,11 @@ static HAL_StatusTypeDef SPI_WaitFlagStateUntilTimeout(SPI_HandleTypeDef *hspi,
       }
       count--;
     }
+
+    HAL_WAIT_YIELD();
   }
 
+  HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_WAITFLAGSTATEUNTILTIMEOUT, hspi);
   return HAL_OK;
 }
 
@@ -3988,6 +4012,8 @@ static HAL_StatusTypeDef SPI_WaitFifoStateUntilTimeout(SPI_HandleTypeDef *hspi,
   __IO uint8_t  *ptmpreg8;
   __IO uint8_t  tmpreg8 = 0;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_SPI_WAITFIFOSTATEUNTILTIMEOUT, hspi);
+
   /* Adjust Timeout value  in case of end of transfer */
   tmp_timeout = Timeout - (HAL_GetTick() - Tickstart);
   tmp_tickstart = HAL_GetTick();
@@ -4037,6 +4063,7 @@ static HAL_StatusTypeDef SPI_WaitFifoStateUntilTimeout(SPI_HandleTypeDef *hspi,
         /* Process Unlocked */
         __HAL_UNLOCK(hspi);
 
+        HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_WAITFIFOSTATEUNTILTIMEOUT, hspi);
         return HAL_TIMEOUT;
       }
       /* If Systick is disabled or not incremented, deactivate timeout to go in disable loop procedure */
@@ -4046,8 +4073,11 @@ static HAL_StatusTypeDef SPI_WaitFifoStateUntilTimeout(SPI_HandleTypeDef *hspi,
       }
       count--;
     }
+
+    HAL_WAIT_YIELD();
   }
 
+  HAL_TRACE_EXIT(HAL_TRACE_ID_SPI_WAITFIFOSTATEUNTILTIMEOUT, hspi);
   return HAL_OK;
 }
 
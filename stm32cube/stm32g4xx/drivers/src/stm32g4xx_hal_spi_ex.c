@@ -52,6 +52,107 @@
   * @{
   */
 
+/** @defgroup SPIEx_Exported_Functions_Group2 Initialization functions
+  *  @brief   Extended initialization functions
+  *
+@verbatim
+ ===============================================================================
+                  ##### Initialization functions #####
+ ===============================================================================
+ [..]
+    This subsection provides a function to initialize the SPI from a constant
+    configuration built at compile time by SPI_CONST_INIT(): the register values
+    are computed by the compiler and each register is written once.
+
+    (#) Constant configuration initialization function:
+        (++) HAL_SPIEx_InitConst()
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize the SPI from a constant configuration and initialize the
+  *         associated handle.
+  * @note   The configuration is built at compile time by SPI_CONST_INIT(), in
+  *         Motorola mode without CRC.
+  * @param  hspi pointer to a SPI_HandleTypeDef structure that contains
+  *               the configuration information for SPI module.
+  * @param  pConfig pointer to the constant configuration.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SPIEx_InitConst(SPI_HandleTypeDef *hspi, const SPI_ConstInitTypeDef *pConfig)
+{
+  /* Check the SPI handle allocation */
+  if ((hspi == NULL) || (pConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Check the parameters */
+  assert_param(IS_SPI_ALL_INSTANCE(hspi->Instance));
+  assert_param(IS_SPI_MODE(pConfig->Init.Mode));
+  assert_param(IS_SPI_DIRECTION(pConfig->Init.Direction));
+  assert_param(IS_SPI_DATASIZE(pConfig->Init.DataSize));
+  assert_param(IS_SPI_CPOL(pConfig->Init.CLKPolarity));
+  assert_param(IS_SPI_CPHA(pConfig->Init.CLKPhase));
+  assert_param(IS_SPI_NSS(pConfig->Init.NSS));
+  assert_param(IS_SPI_NSSP(pConfig->Init.NSSPMode));
+  assert_param(IS_SPI_BAUDRATE_PRESCALER(pConfig->Init.BaudRatePrescaler));
+  assert_param(IS_SPI_FIRST_BIT(pConfig->Init.FirstBit));
+
+  hspi->Init = pConfig->Init;
+
+  if (hspi->State == HAL_SPI_STATE_RESET)
+  {
+    /* Allocate lock resource and initialize it */
+    hspi->Lock = HAL_UNLOCKED;
+
+#if (USE_HAL_SPI_REGISTER_CALLBACKS == 1U)
+    /* Init the SPI Callback settings */
+    hspi->TxCpltCallback       = HAL_SPI_TxCpltCallback;       /* Legacy weak TxCpltCallback       */
+    hspi->RxCpltCallback       = HAL_SPI_RxCpltCallback;       /* Legacy weak RxCpltCallback       */
+    hspi->TxRxCpltCallback     = HAL_SPI_TxRxCpltCallback;     /* Legacy weak TxRxCpltCallback     */
+    hspi->TxHalfCpltCallback   = HAL_SPI_TxHalfCpltCallback;   /* Legacy weak TxHalfCpltCallback   */
+    hspi->RxHalfCpltCallback   = HAL_SPI_RxHalfCpltCallback;   /* Legacy weak RxHalfCpltCallback   */
+    hspi->TxRxHalfCpltCallback = HAL_SPI_TxRxHalfCpltCallback; /* Legacy weak TxRxHalfCpltCallback */
+    hspi->ErrorCallback        = HAL_SPI_ErrorCallback;        /* Legacy weak ErrorCallback        */
+    hspi->AbortCpltCallback    = HAL_SPI_AbortCpltCallback;    /* Legacy weak AbortCpltCallback    */
+
+    if (hspi->MspInitCallback == NULL)
+    {
+      hspi->MspInitCallback = HAL_SPI_MspInit; /* Legacy weak MspInit  */
+    }
+
+    /* Init the low level hardware : GPIO, CLOCK, NVIC... */
+    hspi->MspInitCallback(hspi);
+#else
+    /* Init the low level hardware : GPIO, CLOCK, NVIC... */
+    HAL_SPI_MspInit(hspi);
+#endif /* USE_HAL_SPI_REGISTER_CALLBACKS */
+  }
+
+  hspi->State = HAL_SPI_STATE_BUSY;
+
+  /* Write the configuration registers once, the SPI being left disabled */
+  WRITE_REG(hspi->Instance->CR1, pConfig->CR1);
+  WRITE_REG(hspi->Instance->CR2, pConfig->CR2);
+
+#if defined(SPI_I2SCFGR_I2SMOD)
+  /* Activate the SPI mode (Make sure that I2SMOD bit in I2SCFGR register is reset) */
+  CLEAR_BIT(hspi->Instance->I2SCFGR, SPI_I2SCFGR_I2SMOD);
+#endif /* SPI_I2SCFGR_I2SMOD */
+
+  hspi->ErrorCode = HAL_SPI_ERROR_NONE;
+  hspi->State     = HAL_SPI_STATE_READY;
+
+  return HAL_OK;
+}
+
+/**
+  * @}
+  */
+
 /** @defgroup SPIEx_Exported_Functions_Group1 IO operation functions
   *  @brief   Data transfers functions
   *
@@ -3837,6 +3837,8 @@ HAL_StatusTypeDef HAL_TIM_Encoder_Stop_DMA(TIM_HandleTypeDef *htim, uint32_t Cha
   */
 void HAL_TIM_IRQHandler(TIM_HandleTypeDef *htim)
 {
+  HAL_TRACE_ENTER(HAL_TRACE_ID_TIM_IRQHANDLER, htim);
+
   /* Capture compare 1 event */
   if (__HAL_TIM_GET_FLAG(htim, TIM_FLAG_CC1) != RESET)
   {
@@ -4077,6 +4079,8 @@ void HAL_TIM_IRQHandler(TIM_HandleTypeDef *htim)
 #endif /* USE_HAL_TIM_REGISTER_CALLBACKS */
     }
   }
+
+  HAL_TRACE_EXIT(HAL_TRACE_ID_TIM_IRQHANDLER, htim);
 }
 
 /**
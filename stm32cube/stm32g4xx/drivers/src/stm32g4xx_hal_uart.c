@@ -1124,15 +1124,18 @@ HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pD
   const uint16_t *pdata16bits;
   uint32_t tickstart;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_UART_TRANSMIT, huart);
+
   /* Check that a Tx process is not already ongoing */
   if (huart->gState == HAL_UART_STATE_READY)
   {
     if ((pData == NULL) || (Size == 0U))
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_UART_TRANSMIT, huart);
       return  HAL_ERROR;
     }
 
-    __HAL_LOCK(huart);
+    __HAL_LOCK_TRACE(huart, HAL_TRACE_ID_UART_TRANSMIT);
 
     huart->ErrorCode = HAL_UART_ERROR_NONE;
     huart->gState = HAL_UART_STATE_BUSY_TX;
@@ -1161,6 +1164,7 @@ HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pD
     {
       if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_TXE, RESET, tickstart, Timeout) != HAL_OK)
       {
+        HAL_TRACE_EXIT(HAL_TRACE_ID_UART_TRANSMIT, huart);
         return HAL_TIMEOUT;
       }
       if (pdata8bits == NULL)
@@ -1178,16 +1182,19 @@ HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pD
 
     if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_TC, RESET, tickstart, Timeout) != HAL_OK)
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_UART_TRANSMIT, huart);
       return HAL_TIMEOUT;
     }
 
     /* At end of Tx process, restore huart->gState to Ready */
     huart->gState = HAL_UART_STATE_READY;
 
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_TRANSMIT, huart);
     return HAL_OK;
   }
   else
   {
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_TRANSMIT, huart);
     return HAL_BUSY;
   }
 }
@@ -1214,15 +1221,18 @@ HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, ui
   uint16_t uhMask;
   uint32_t tickstart;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_UART_RECEIVE, huart);
+
   /* Check that a Rx process is not already ongoing */
   if (huart->RxState == HAL_UART_STATE_READY)
   {
     if ((pData == NULL) || (Size == 0U))
     {
+      HAL_TRACE_EXIT(HAL_TRACE_ID_UART_RECEIVE, huart);
       return  HAL_ERROR;
     }
 
-    __HAL_LOCK(huart);
+    __HAL_LOCK_TRACE(huart, HAL_TRACE_ID_UART_RECEIVE);
 
     huart->ErrorCode = HAL_UART_ERROR_NONE;
     huart->RxState = HAL_UART_STATE_BUSY_RX;
@@ -1257,6 +1267,7 @@ HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, ui
     {
       if (UART_WaitOnFlagUntilTimeout(huart, UART_FLAG_RXNE, RESET, tickstart, Timeout) != HAL_OK)
       {
+        HAL_TRACE_EXIT(HAL_TRACE_ID_UART_RECEIVE, huart);
         return HAL_TIMEOUT;
       }
       if (pdata8bits == NULL)
@@ -1275,10 +1286,12 @@ HAL_StatusTypeDef HAL_UART_Receive(UART_HandleTypeDef *huart, uint8_t *pData, ui
     /* At end of Rx process, restore huart->RxState to Ready */
     huart->RxState = HAL_UART_STATE_READY;
 
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_RECEIVE, huart);
     return HAL_OK;
   }
   else
   {
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_RECEIVE, huart);
     return HAL_BUSY;
   }
 }
@@ -2244,6 +2257,8 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
   uint32_t errorflags;
   uint32_t errorcode;
 
+  HAL_TRACE_ENTER(HAL_TRACE_ID_UART_IRQHANDLER, huart);
+
   /* If no error occurs */
   errorflags = (isrflags & (uint32_t)(USART_ISR_PE | USART_ISR_FE | USART_ISR_ORE | USART_ISR_NE | USART_ISR_RTOF));
   if (errorflags == 0U)
@@ -2257,6 +2272,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
       {
         huart->RxISR(huart);
       }
+      HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
       return;
     }
   }
@@ -2395,6 +2411,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
         huart->ErrorCode = HAL_UART_ERROR_NONE;
       }
     }
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
     return;
 
   } /* End if some error occurs */
@@ -2449,6 +2466,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
         HAL_UARTEx_RxEventCallback(huart, (huart->RxXferSize - huart->RxXferCount));
 #endif /* (USE_HAL_UART_REGISTER_CALLBACKS) */
       }
+      HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
       return;
     }
     else
@@ -2482,6 +2500,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
         HAL_UARTEx_RxEventCallback(huart, nb_rx_data);
 #endif /* (USE_HAL_UART_REGISTER_CALLBACKS) */
       }
+      HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
       return;
     }
   }
@@ -2501,6 +2520,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
     /* Call legacy weak Wakeup Callback */
     HAL_UARTEx_WakeupCallback(huart);
 #endif /* USE_HAL_UART_REGISTER_CALLBACKS */
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
     return;
   }
 
@@ -2513,6 +2533,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
     {
       huart->TxISR(huart);
     }
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
     return;
   }
 
@@ -2520,6 +2541,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
   if (((isrflags & USART_ISR_TC) != 0U) && ((cr1its & USART_CR1_TCIE) != 0U))
   {
     UART_EndTransmit_IT(huart);
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
     return;
   }
 
@@ -2533,6 +2555,7 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
     /* Call legacy weak Tx Fifo Empty Callback */
     HAL_UARTEx_TxFifoEmptyCallback(huart);
 #endif /* USE_HAL_UART_REGISTER_CALLBACKS */
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
     return;
   }
 
@@ -2546,8 +2569,11 @@ void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
     /* Call legacy weak Rx Fifo Full Callback */
     HAL_UARTEx_RxFifoFullCallback(huart);
 #endif /* USE_HAL_UART_REGISTER_CALLBACKS */
+    HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
     return;
   }
+
+  HAL_TRACE_EXIT(HAL_TRACE_ID_UART_IRQHANDLER, huart);
 }
 
 /**
@@ -3366,6 +3392,8 @@ HAL_StatusTypeDef UART_CheckIdleState(UART_HandleTypeDef *huart)
 HAL_StatusTypeDef UART_WaitOnFlagUntilTimeout(UART_HandleTypeDef *huart, uint32_t Flag, FlagStatus Status,
                                               uint32_t Tickstart, uint32_t Timeout)
 {
+  HAL_TRACE_ENTER(HAL_TRACE_ID_UART_WAITONFLAGUNTILTIMEOUT, huart);
+
   /* Wait until flag is set */
   while ((__HAL_UART_GET_FLAG(huart, Flag) ? SET : RESET) == Status)
   {
@@ -3385,6 +3413,7 @@ HAL_StatusTypeDef UART_WaitOnFlagUntilTimeout(UART_HandleTypeDef *huart, uint32_
 
         __HAL_UNLOCK(huart);
 
+        HAL_TRACE_EXIT(HAL_TRACE_ID_UART_WAITONFLAGUNTILTIMEOUT, huart);
         return HAL_TIMEOUT;
       }
 
@@ -3408,11 +3437,15 @@ HAL_StatusTypeDef UART_WaitOnFlagUntilTimeout(UART_HandleTypeDef *huart, uint32_
           /* Process Unlocked */
           __HAL_UNLOCK(huart);
 
+          HAL_TRACE_EXIT(HAL_TRACE_ID_UART_WAITONFLAGUNTILTIMEOUT, huart);
           return HAL_TIMEOUT;
         }
       }
     }
+
+    HAL_WAIT_YIELD();
   }
+  HAL_TRACE_EXIT(HAL_TRACE_ID_UART_WAITONFLAGUNTILTIMEOUT, huart);
   return HAL_OK;
 }
 
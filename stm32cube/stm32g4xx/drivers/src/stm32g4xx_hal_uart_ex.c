@@ -117,6 +117,11 @@ static void UARTEx_SetNbDataToProcess(UART_HandleTypeDef *huart);
     [..]
     The HAL_RS485Ex_Init() API follows the UART RS485 mode configuration
      procedures (details for the procedures are available in reference manual).
+    [..]
+    The HAL_UARTEx_InitConst() API initializes the UART in asynchronous mode from a
+    constant configuration built at compile time by UART_CONST_INIT() or
+    LPUART_CONST_INIT(): the register values, baud rate divider included, are
+    computed by the compiler and each register is written once.
 
 @endverbatim
 
@@ -240,6 +245,95 @@ HAL_StatusTypeDef HAL_RS485Ex_Init(UART_HandleTypeDef *huart, uint32_t Polarity,
   return (UART_CheckIdleState(huart));
 }
 
+/**
+  * @brief Initialize the UART in asynchronous mode from a constant configuration
+  *        and initialize the associated handle.
+  * @note  The configuration is built at compile time by UART_CONST_INIT() or
+  *        LPUART_CONST_INIT(), with the kernel clock frequency of the instance: the
+  *        clock source and frequency configured in RCC must match it.
+  * @note  CR1, CR2, CR3, BRR and PRESC are written whole: the advanced features and
+  *        the FIFO mode are disabled, huart->AdvancedInit is not applied.
+  * @param huart   UART handle.
+  * @param pConfig Pointer to the constant configuration.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_UARTEx_InitConst(UART_HandleTypeDef *huart, const UART_ConstInitTypeDef *pConfig)
+{
+  /* Check the UART handle allocation */
+  if ((huart == NULL) || (pConfig == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Check the parameters */
+  assert_param((IS_UART_INSTANCE(huart->Instance)) || (IS_LPUART_INSTANCE(huart->Instance)));
+  assert_param(IS_UART_BAUDRATE(pConfig->Init.BaudRate));
+  assert_param(IS_UART_PRESCALER(pConfig->Init.ClockPrescaler));
+  if (UART_INSTANCE_LOWPOWER(huart))
+  {
+    assert_param(IS_LPUART_STOPBITS(pConfig->Init.StopBits));
+    assert_param((pConfig->BRR >= 0x00300U) && (pConfig->BRR <= 0xFFFFFU));
+  }
+  else
+  {
+    assert_param(IS_UART_STOPBITS(pConfig->Init.StopBits));
+    assert_param(IS_UART_ONE_BIT_SAMPLE(pConfig->Init.OneBitSampling));
+    assert_param(pConfig->BRR >= 0x10U);
+  }
+  if (pConfig->Init.HwFlowCtl != UART_HWCONTROL_NONE)
+  {
+    assert_param(IS_UART_HWFLOW_INSTANCE(huart->Instance));
+  }
+
+  huart->Init = pConfig->Init;
+
+  if (huart->gState == HAL_UART_STATE_RESET)
+  {
+    /* Allocate lock resource and initialize it */
+    huart->Lock = HAL_UNLOCKED;
+
+#if (USE_HAL_UART_REGISTER_CALLBACKS == 1)
+    UART_InitCallbacksToDefault(huart);
+
+    if (huart->MspInitCallback == NULL)
+    {
+      huart->MspInitCallback = HAL_UART_MspInit;
+    }
+
+    /* Init the low level hardware */
+    huart->MspInitCallback(huart);
+#else
+    /* Init the low level hardware : GPIO, CLOCK */
+    HAL_UART_MspInit(huart);
+#endif /* (USE_HAL_UART_REGISTER_CALLBACKS) */
+  }
+
+  huart->gState = HAL_UART_STATE_BUSY;
+
+  /* Disable the Peripheral, then write the configuration registers once */
+  WRITE_REG(huart->Instance->CR1, 0U);
+  WRITE_REG(huart->Instance->CR2, pConfig->CR2);
+  WRITE_REG(huart->Instance->CR3, pConfig->CR3);
+  WRITE_REG(huart->Instance->PRESC, pConfig->PRESC);
+  WRITE_REG(huart->Instance->BRR, pConfig->BRR);
+
+  huart->FifoMode = UART_FIFOMODE_DISABLE;
+
+  /* Initialize the number of data to process during RX/TX ISR execution */
+  huart->NbTxDataToProcess = 1;
+  huart->NbRxDataToProcess = 1;
+
+  /* Clear ISR function pointers */
+  huart->RxISR = NULL;
+  huart->TxISR = NULL;
+
+  /* Enable the Peripheral */
+  WRITE_REG(huart->Instance->CR1, pConfig->CR1 | USART_CR1_UE);
+
+  /* TEACK and/or REACK to check before moving huart->gState and huart->RxState to Ready */
+  return (UART_CheckIdleState(huart));
+}
+
 /**
   * @}
   */
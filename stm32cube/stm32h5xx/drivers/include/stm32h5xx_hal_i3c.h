@@ -1009,6 +1009,9 @@ typedef  void (*pI3C_TgtReqDynamicAddrCallbackTypeDef)(I3C_HandleTypeDef *hi3c,
   * @}
   */
 
+/* Include I3C HAL Extended module */
+#include "stm32h5xx_hal_i3c_ex.h"
+
 /* Exported functions ------------------------------------------------------------------------------------------------*/
 /** @addtogroup I3C_Exported_Functions
   * @{
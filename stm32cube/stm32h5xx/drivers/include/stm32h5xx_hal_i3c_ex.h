@@ -0,0 +1,189 @@
+/**
+  **********************************************************************************************************************
+  * @file    stm32h5xx_hal_i3c_ex.h
+  * @brief   Header file of I3C HAL Extended module.
+  **********************************************************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  **********************************************************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -----------------------------------------------------------------------------*/
+#ifndef STM32H5xx_HAL_I3C_EX_H
+#define STM32H5xx_HAL_I3C_EX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ----------------------------------------------------------------------------------------------------------*/
+#include "stm32h5xx_hal_def.h"
+
+#if defined(HAL_DMA_MODULE_ENABLED)
+
+/** @addtogroup STM32H5xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup I3CEx
+  * @{
+  */
+
+/* Exported constants ------------------------------------------------------------------------------------------------*/
+/** @defgroup I3CEx_Exported_Constants I3C Extended Exported Constants
+  * @{
+  */
+
+/** @defgroup I3CEx_FRAME_MAX_DESC I3C Extended maximum number of descriptors in a frame
+  * @{
+  */
+#if !defined(I3CEX_FRAME_MAX_DESC)
+#define I3CEX_FRAME_MAX_DESC        16U     /*!< May be overridden in stm32h5xx_hal_conf.h */
+#endif /* I3CEX_FRAME_MAX_DESC */
+/**
+  * @}
+  */
+
+/** @defgroup I3CEx_EVENT_TYPE I3C Extended pipeline event type
+  * @{
+  */
+#define I3CEX_EVENT_FRAME           0x01U   /*!< A frame completed, its Rx data is valid until it is started again */
+#define I3CEX_EVENT_IBI             0x02U   /*!< In-band interrupt received from a target                          */
+#define I3CEX_EVENT_ERROR           0x03U   /*!< A frame failed, see ErrorCode                                     */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported types ----------------------------------------------------------------------------------------------------*/
+/** @defgroup I3CEx_Exported_Types I3C Extended Exported Types
+  * @{
+  */
+
+/**
+  * @brief  I3C precompiled private transfer frame
+  */
+typedef struct
+{
+  I3C_XferTypeDef            Xfer;                          /*!< Control, Tx and Rx buffers given to the DMA, sized
+                                                                 to the exact frame length                          */
+  const I3C_PrivateTypeDef   *pDesc;                        /*!< Descriptors the frame was compiled from           */
+  uint32_t                   Option;                        /*!< Transfer option, a private value of
+                                                                 @ref I3C_OPTION_DEFINITION                         */
+  uint32_t                   ControlNbr;                    /*!< Number of control words                           */
+  uint16_t                   Offset[I3CEX_FRAME_MAX_DESC];  /*!< Offset of each descriptor data in Xfer.TxBuf
+                                                                 (write) or Xfer.RxBuf (read)                       */
+  uint8_t                    DescNbr;                       /*!< Number of descriptors                             */
+} I3CEx_FrameTypeDef;
+
+/**
+  * @brief  I3C pipeline event
+  */
+typedef struct
+{
+  I3CEx_FrameTypeDef  *pFrame;        /*!< Frame concerned, NULL for an IBI                 */
+  uint32_t            Timestamp;      /*!< GetTime() value when the event was queued        */
+  uint32_t            ErrorCode;      /*!< I3C error code of an I3CEX_EVENT_ERROR event     */
+  uint32_t            IBIPayload;     /*!< IBI payload, little endian                       */
+  uint8_t             Type;           /*!< Event type, a value of @ref I3CEx_EVENT_TYPE     */
+  uint8_t             TargetAddr;     /*!< Dynamic address of the target raising the IBI    */
+  uint8_t             IBIPayloadSize; /*!< Number of IBI payload bytes                      */
+} I3CEx_EventTypeDef;
+
+/**
+  * @brief  I3C pipeline statistics
+  */
+typedef struct
+{
+  uint32_t Frames;      /*!< Frames completed                                                  */
+  uint32_t Transfers;   /*!< Private transfers completed                                       */
+  uint32_t IBIs;        /*!< In-band interrupts received                                       */
+  uint32_t Errors;      /*!< Frames failed                                                     */
+  uint32_t Overflows;   /*!< Events dropped because the event queue was full                   */
+  uint32_t Deferred;    /*!< Frame restarts delayed to let a pending IBI be served             */
+  uint32_t Elapsed;     /*!< GetTime() ticks between the pipeline start and the last frame end */
+} I3CEx_PipelineStatsTypeDef;
+
+/**
+  * @brief  I3C pipeline handle
+  */
+typedef struct
+{
+  I3C_HandleTypeDef           *hi3c;              /*!< I3C controller handle                                 */
+  I3CEx_FrameTypeDef          *pFrame;            /*!< Frame being transferred                               */
+  I3CEx_EventTypeDef          *pEvents;           /*!< Event queue storage                                   */
+  uint16_t                    Depth;              /*!< Number of entries of pEvents                          */
+  __IO uint16_t               Head;               /*!< Next event to write, updated in interrupt context    */
+  __IO uint16_t               Tail;               /*!< Next event to read                                    */
+  __IO uint8_t                Continuous;         /*!< Frame restarted on completion until stopped           */
+  __IO uint8_t                RestartPending;     /*!< Frame restart waits for an IBI to be served          */
+  uint32_t                    StartTime;          /*!< GetTime() value at pipeline start                     */
+  uint32_t                    (*GetTime)(void);   /*!< Timestamp source, HAL_GetTick() by default            */
+  I3CEx_PipelineStatsTypeDef  Stats;              /*!< Statistics                                            */
+} I3CEx_PipelineTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported macros ---------------------------------------------------------------------------------------------------*/
+/* Exported functions ------------------------------------------------------------------------------------------------*/
+/** @addtogroup I3CEx_Exported_Functions I3C Extended Exported Functions
+  * @{
+  */
+
+/** @addtogroup I3CEx_Exported_Functions_Group1 Precompiled frame functions
+  * @{
+  */
+HAL_StatusTypeDef HAL_I3CEx_FrameCompile(I3C_HandleTypeDef *hi3c, I3CEx_FrameTypeDef *hframe,
+                                         const I3C_PrivateTypeDef *pPrivateDesc, uint8_t nbFrame, uint32_t option,
+                                         const I3C_XferTypeDef *pXferData);
+uint8_t          *HAL_I3CEx_FrameGetData(const I3CEx_FrameTypeDef *hframe, uint8_t descIndex, uint32_t *pSize);
+HAL_StatusTypeDef HAL_I3CEx_FrameSetTxData(I3CEx_FrameTypeDef *hframe, uint8_t descIndex, const uint8_t *pData);
+HAL_StatusTypeDef HAL_I3CEx_FrameStart_DMA(I3C_HandleTypeDef *hi3c, I3CEx_FrameTypeDef *hframe);
+/**
+  * @}
+  */
+
+/** @addtogroup I3CEx_Exported_Functions_Group2 Transfer pipeline functions
+  * @{
+  */
+HAL_StatusTypeDef HAL_I3CEx_PipelineInit(I3CEx_PipelineTypeDef *hpipe, I3C_HandleTypeDef *hi3c,
+                                         I3CEx_EventTypeDef *pEvents, uint16_t depth);
+HAL_StatusTypeDef HAL_I3CEx_PipelineStart(I3CEx_PipelineTypeDef *hpipe, I3CEx_FrameTypeDef *hframe,
+                                          uint8_t continuous);
+void              HAL_I3CEx_PipelineStop(I3CEx_PipelineTypeDef *hpipe);
+HAL_StatusTypeDef HAL_I3CEx_PipelineGetEvent(I3CEx_PipelineTypeDef *hpipe, I3CEx_EventTypeDef *pEvent);
+void              HAL_I3CEx_PipelineXferCplt(I3CEx_PipelineTypeDef *hpipe);
+void              HAL_I3CEx_PipelineNotify(I3CEx_PipelineTypeDef *hpipe, uint32_t eventId);
+void              HAL_I3CEx_PipelineError(I3CEx_PipelineTypeDef *hpipe);
+void              HAL_I3CEx_PipelineGetStats(const I3CEx_PipelineTypeDef *hpipe, I3CEx_PipelineStatsTypeDef *pStats);
+void              HAL_I3CEx_PipelineResetStats(I3CEx_PipelineTypeDef *hpipe);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* HAL_DMA_MODULE_ENABLED */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H5xx_HAL_I3C_EX_H */
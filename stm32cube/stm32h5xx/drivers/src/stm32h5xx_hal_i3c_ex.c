@@ -0,0 +1,608 @@
+/**
+  **********************************************************************************************************************
+  * @file    stm32h5xx_hal_i3c_ex.c
+  * @brief   I3C Extended HAL module driver.
+  *          This file provides firmware functions to manage the following
+  *          functionalities of the Improvement Inter Integrated Circuit (I3C) peripheral:
+  *           + Precompiled frame functions
+  *           + Transfer pipeline functions
+  *
+  **********************************************************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  **********************************************************************************************************************
+  @verbatim
+  ======================================================================================================================
+                                           ##### How to use this driver #####
+  ======================================================================================================================
+    [..]
+    The I3C Extended HAL driver can be used as follows, in controller mode with DMA:
+
+    (#) Polling the same targets over and over (sensor hubs) repeats the same frame construction each cycle.
+        A precompiled frame builds the control words and packs the Tx data once:
+        (##) Declare an I3CEx_FrameTypeDef and an I3C_XferTypeDef whose CtrlBuf, TxBuf and RxBuf are large enough
+             for the whole frame, as for HAL_I3C_AddDescToFrame().
+        (##) Call HAL_I3CEx_FrameCompile() with an array of private descriptors and a private option.
+             I3C_PRIVATE_WITH_ARB_RESTART or I3C_PRIVATE_WITHOUT_ARB_RESTART chain all the transfers with repeated
+             starts and end the frame with a stop.
+        (##) Each cycle, patch the data in place: HAL_I3CEx_FrameGetData() returns where the data of a descriptor
+             lies in the frame Tx buffer (write) or Rx buffer (read). HAL_I3CEx_FrameSetTxData() copies new Tx data.
+        (##) Call HAL_I3CEx_FrameStart_DMA(). Completion is reported by HAL_I3C_CtrlMultipleXferCpltCallback().
+
+    (#) A pipeline delivers frame completions, IBIs and errors through a single event queue, and can restart a frame
+        as soon as it completes:
+        (##) Call HAL_I3CEx_PipelineInit() with the event queue storage.
+        (##) Forward the HAL callbacks: call HAL_I3CEx_PipelineXferCplt() from HAL_I3C_CtrlMultipleXferCpltCallback(),
+             HAL_I3CEx_PipelineNotify() from HAL_I3C_NotifyCallback() and HAL_I3CEx_PipelineError() from
+             HAL_I3C_ErrorCallback().
+        (##) Enable the IBI notification with HAL_I3C_ActivateNotification() and EVENT_ID_IBI.
+        (##) Call HAL_I3CEx_PipelineStart(), with continuous set to restart the frame after each completion, then
+             read events with HAL_I3CEx_PipelineGetEvent().
+        (##) A restart is delayed while an IBI is pending, so that the IBI is served between two frames.
+        (##) HAL_I3CEx_PipelineGetStats() gives the number of transfers and the elapsed GetTime() ticks, from which
+             the transfer rate is derived.
+
+    (#) The Rx data of a frame is overwritten by the next restart: in continuous mode, copy it out before the frame
+        completes again, or use two frames and start them alternately.
+
+  @endverbatim
+  **********************************************************************************************************************
+  */
+
+/* Includes ----------------------------------------------------------------------------------------------------------*/
+#include "stm32h5xx_hal.h"
+
+/** @addtogroup STM32H5xx_HAL_Driver
+  * @{
+  */
+
+/** @defgroup I3CEx I3CEx
+  * @brief I3C Extended HAL module driver
+  * @{
+  */
+
+#ifdef HAL_I3C_MODULE_ENABLED
+#if defined(HAL_DMA_MODULE_ENABLED)
+
+/* Private typedef ---------------------------------------------------------------------------------------------------*/
+/* Private define ----------------------------------------------------------------------------------------------------*/
+/** @defgroup I3CEx_Private_Define I3C Extended Private Define
+  * @{
+  */
+/* Same values as the I3C module private defines for control buffer prior preparation */
+#define I3CEX_OPERATION_TYPE_MASK       (0x78000000U)
+#define I3CEX_ARBITRATION_HEADER_MASK   (0x00000004U)
+/**
+  * @}
+  */
+
+/* Private macro -----------------------------------------------------------------------------------------------------*/
+/* Private variables -------------------------------------------------------------------------------------------------*/
+/* Private function prototypes ---------------------------------------------------------------------------------------*/
+/** @defgroup I3CEx_Private_Functions I3C Extended Private Functions
+  * @{
+  */
+static void I3CEx_PipelinePush(I3CEx_PipelineTypeDef *hpipe, const I3CEx_EventTypeDef *pEvent);
+static void I3CEx_PipelineRestart(I3CEx_PipelineTypeDef *hpipe);
+/**
+  * @}
+  */
+
+/* Exported functions ------------------------------------------------------------------------------------------------*/
+
+/** @defgroup I3CEx_Exported_Functions I3C Extended Exported Functions
+  * @{
+  */
+
+/** @defgroup I3CEx_Exported_Functions_Group1 Precompiled frame functions.
+  * @brief    I3C precompiled frame functions.
+  *
+@verbatim
+ =======================================================================================================================
+                                     ##### Precompiled frame functions #####
+ =======================================================================================================================
+    [..]  This subsection provides a set of functions allowing to build a private transfer frame once and to start
+          it many times.
+
+         (+) Call the function HAL_I3CEx_FrameCompile() to build the control buffer and pack the Tx data of a frame.
+         (+) Call the function HAL_I3CEx_FrameGetData() to get the location of the data of a descriptor.
+         (+) Call the function HAL_I3CEx_FrameSetTxData() to update the Tx data of a descriptor.
+         (+) Call the function HAL_I3CEx_FrameStart_DMA() to start the frame.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Compile private descriptors into a reusable frame.
+  * @note   The frame keeps the buffers of pXferData, trimmed to the frame length, and the pPrivateDesc pointer.
+  * @param  hi3c         : [IN]  Pointer to an I3C_HandleTypeDef structure that contains the configuration information
+  *                              for the specified I3C.
+  * @param  hframe       : [OUT] Pointer to an I3CEx_FrameTypeDef structure.
+  * @param  pPrivateDesc : [IN]  Pointer to an array of I3C_PrivateTypeDef descriptors.
+  * @param  nbFrame      : [IN]  Number of descriptors, up to I3CEX_FRAME_MAX_DESC.
+  * @param  option       : [IN]  Value indicating the private transfer option.
+  *                              It can be one private value of @ref I3C_OPTION_DEFINITION
+  * @param  pXferData    : [IN]  Pointer to an I3C_XferTypeDef structure providing the control, Tx and Rx buffers.
+  * @retval HAL Status   :       Value from HAL_StatusTypeDef enumeration.
+  */
+HAL_StatusTypeDef HAL_I3CEx_FrameCompile(I3C_HandleTypeDef *hi3c, I3CEx_FrameTypeDef *hframe,
+                                         const I3C_PrivateTypeDef *pPrivateDesc, uint8_t nbFrame, uint32_t option,
+                                         const I3C_XferTypeDef *pXferData)
+{
+  HAL_StatusTypeDef status;
+  uint32_t tx_offset = 0U;
+  uint32_t rx_offset = 0U;
+  uint32_t op_type = (option & I3CEX_OPERATION_TYPE_MASK);
+
+  /* Check on user parameters */
+  if ((hi3c == NULL) || (hframe == NULL) || (pXferData == NULL) || (pPrivateDesc == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  if ((nbFrame == 0U) || (nbFrame > I3CEX_FRAME_MAX_DESC) ||
+      ((op_type != LL_I3C_CONTROLLER_MTYPE_PRIVATE) && (op_type != LL_I3C_CONTROLLER_MTYPE_LEGACY_I2C)))
+  {
+    hi3c->ErrorCode = HAL_I3C_ERROR_INVALID_PARAM;
+    return HAL_ERROR;
+  }
+
+  hframe->Xfer    = *pXferData;
+  hframe->pDesc   = pPrivateDesc;
+  hframe->Option  = option;
+  hframe->DescNbr = 0U;
+
+  /* Build the control words and pack the Tx data */
+  status = HAL_I3C_AddDescToFrame(hi3c, NULL, pPrivateDesc, &hframe->Xfer, nbFrame, option);
+
+  if (status == HAL_OK)
+  {
+    /* The DMA lengths are taken from the buffer sizes: trim them to the frame */
+    hframe->ControlNbr         = hi3c->ControlXferCount;
+    hframe->Xfer.CtrlBuf.Size  = hi3c->ControlXferCount;
+    hframe->Xfer.TxBuf.Size    = hi3c->TxXferCount;
+    hframe->Xfer.RxBuf.Size    = hi3c->RxXferCount;
+
+    for (uint32_t index = 0U; index < nbFrame; index++)
+    {
+      if (pPrivateDesc[index].Direction == HAL_I3C_DIRECTION_READ)
+      {
+        hframe->Offset[index] = (uint16_t)rx_offset;
+        rx_offset += pPrivateDesc[index].RxBuf.Size;
+      }
+      else
+      {
+        hframe->Offset[index] = (uint16_t)tx_offset;
+        tx_offset += pPrivateDesc[index].TxBuf.Size;
+      }
+    }
+
+    hframe->DescNbr = nbFrame;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Get the location of the data of a descriptor inside a compiled frame.
+  * @param  hframe     : [IN]  Pointer to a compiled I3CEx_FrameTypeDef structure.
+  * @param  descIndex  : [IN]  Index of the descriptor.
+  * @param  pSize      : [OUT] Number of data bytes of the descriptor, may be NULL.
+  * @retval Pointer into the frame Tx buffer for a write, into the frame Rx buffer for a read, NULL on a wrong index.
+  */
+uint8_t *HAL_I3CEx_FrameGetData(const I3CEx_FrameTypeDef *hframe, uint8_t descIndex, uint32_t *pSize)
+{
+  const I3C_PrivateTypeDef *p_desc;
+  uint8_t *p_data;
+
+  if (descIndex >= hframe->DescNbr)
+  {
+    return NULL;
+  }
+
+  p_desc = &hframe->pDesc[descIndex];
+
+  if (p_desc->Direction == HAL_I3C_DIRECTION_READ)
+  {
+    p_data = &hframe->Xfer.RxBuf.pBuffer[hframe->Offset[descIndex]];
+    if (pSize != NULL)
+    {
+      *pSize = p_desc->RxBuf.Size;
+    }
+  }
+  else
+  {
+    p_data = &hframe->Xfer.TxBuf.pBuffer[hframe->Offset[descIndex]];
+    if (pSize != NULL)
+    {
+      *pSize = p_desc->TxBuf.Size;
+    }
+  }
+
+  return p_data;
+}
+
+/**
+  * @brief  Copy new Tx data for a write descriptor of a compiled frame.
+  * @note   The number of bytes copied is the descriptor TxBuf.Size given at compilation.
+  * @param  hframe     : [IN]  Pointer to a compiled I3CEx_FrameTypeDef structure.
+  * @param  descIndex  : [IN]  Index of the descriptor.
+  * @param  pData      : [IN]  New Tx data.
+  * @retval HAL Status :       Value from HAL_StatusTypeDef enumeration.
+  */
+HAL_StatusTypeDef HAL_I3CEx_FrameSetTxData(I3CEx_FrameTypeDef *hframe, uint8_t descIndex, const uint8_t *pData)
+{
+  uint8_t *p_dst;
+  uint32_t size;
+
+  if ((pData == NULL) || (descIndex >= hframe->DescNbr) ||
+      (hframe->pDesc[descIndex].Direction == HAL_I3C_DIRECTION_READ))
+  {
+    return HAL_ERROR;
+  }
+
+  p_dst = HAL_I3CEx_FrameGetData(hframe, descIndex, &size);
+
+  for (uint32_t index = 0U; index < size; index++)
+  {
+    p_dst[index] = pData[index];
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Start a compiled frame with DMA.
+  * @param  hi3c       : [IN]  Pointer to an I3C_HandleTypeDef structure that contains the configuration information
+  *                            for the specified I3C.
+  * @param  hframe     : [IN]  Pointer to a compiled I3CEx_FrameTypeDef structure.
+  * @retval HAL Status :       Value from HAL_StatusTypeDef enumeration.
+  */
+HAL_StatusTypeDef HAL_I3CEx_FrameStart_DMA(I3C_HandleTypeDef *hi3c, I3CEx_FrameTypeDef *hframe)
+{
+  HAL_I3C_StateTypeDef handle_state;
+
+  if ((hi3c == NULL) || (hframe == NULL) || (hframe->DescNbr == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  handle_state = hi3c->State;
+
+  /* The arbitration header setting must not change under an ongoing transfer */
+  if ((handle_state != HAL_I3C_STATE_READY) && (handle_state != HAL_I3C_STATE_LISTEN))
+  {
+    return HAL_BUSY;
+  }
+
+  /* Restore the handle as left by HAL_I3C_AddDescToFrame() */
+  hi3c->pCCCDesc         = NULL;
+  hi3c->pPrivateDesc     = hframe->pDesc;
+  hi3c->ControlXferCount = hframe->ControlNbr;
+  hi3c->TxXferCount      = hframe->Xfer.TxBuf.Size;
+  hi3c->RxXferCount      = hframe->Xfer.RxBuf.Size;
+
+  if ((hframe->Option & I3CEX_ARBITRATION_HEADER_MASK) == I3CEX_ARBITRATION_HEADER_MASK)
+  {
+    LL_I3C_DisableArbitrationHeader(hi3c->Instance);
+  }
+  else
+  {
+    LL_I3C_EnableArbitrationHeader(hi3c->Instance);
+  }
+
+  return HAL_I3C_Ctrl_MultipleTransfer_DMA(hi3c, &hframe->Xfer);
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup I3CEx_Exported_Functions_Group2 Transfer pipeline functions.
+  * @brief    I3C transfer pipeline functions.
+  *
+@verbatim
+ =======================================================================================================================
+                                     ##### Transfer pipeline functions #####
+ =======================================================================================================================
+    [..]  This subsection provides a set of functions allowing to run compiled frames back to back and to receive
+          their completion and the target IBIs through one event queue.
+
+         (+) Call the function HAL_I3CEx_PipelineInit() to initialize a pipeline.
+         (+) Call the function HAL_I3CEx_PipelineStart() to start a frame, once or continuously.
+         (+) Call the function HAL_I3CEx_PipelineStop() to stop restarting the frame.
+         (+) Call the function HAL_I3CEx_PipelineGetEvent() to read the next event.
+         (+) Call the functions HAL_I3CEx_PipelineXferCplt(), HAL_I3CEx_PipelineNotify() and
+             HAL_I3CEx_PipelineError() from the corresponding HAL I3C callbacks.
+         (+) Call the functions HAL_I3CEx_PipelineGetStats() and HAL_I3CEx_PipelineResetStats() to read and clear
+             the statistics.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize a transfer pipeline.
+  * @param  hpipe      : [OUT] Pointer to an I3CEx_PipelineTypeDef structure.
+  * @param  hi3c       : [IN]  Pointer to an I3C_HandleTypeDef structure in controller mode.
+  * @param  pEvents    : [IN]  Event queue storage.
+  * @param  depth      : [IN]  Number of entries of pEvents, at least 2. One entry is kept free.
+  * @retval HAL Status :       Value from HAL_StatusTypeDef enumeration.
+  */
+HAL_StatusTypeDef HAL_I3CEx_PipelineInit(I3CEx_PipelineTypeDef *hpipe, I3C_HandleTypeDef *hi3c,
+                                         I3CEx_EventTypeDef *pEvents, uint16_t depth)
+{
+  if ((hpipe == NULL) || (hi3c == NULL) || (pEvents == NULL) || (depth < 2U))
+  {
+    return HAL_ERROR;
+  }
+
+  hpipe->hi3c           = hi3c;
+  hpipe->pFrame         = NULL;
+  hpipe->pEvents        = pEvents;
+  hpipe->Depth          = depth;
+  hpipe->Head           = 0U;
+  hpipe->Tail           = 0U;
+  hpipe->Continuous     = 0U;
+  hpipe->RestartPending = 0U;
+  hpipe->GetTime        = HAL_GetTick;
+  HAL_I3CEx_PipelineResetStats(hpipe);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Start a compiled frame in a pipeline.
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @param  hframe     : [IN]  Pointer to a compiled I3CEx_FrameTypeDef structure.
+  * @param  continuous : [IN]  1 to restart the frame on each completion until HAL_I3CEx_PipelineStop(), 0 to run it
+  *                            once.
+  * @retval HAL Status :       Value from HAL_StatusTypeDef enumeration.
+  */
+HAL_StatusTypeDef HAL_I3CEx_PipelineStart(I3CEx_PipelineTypeDef *hpipe, I3CEx_FrameTypeDef *hframe,
+                                          uint8_t continuous)
+{
+  HAL_StatusTypeDef status;
+
+  if ((hpipe->Continuous != 0U) || (hpipe->RestartPending != 0U))
+  {
+    return HAL_BUSY;
+  }
+
+  hpipe->pFrame    = hframe;
+  hpipe->StartTime = hpipe->GetTime();
+
+  status = HAL_I3CEx_FrameStart_DMA(hpipe->hi3c, hframe);
+
+  if (status == HAL_OK)
+  {
+    hpipe->Continuous = continuous;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Stop restarting the frame of a pipeline. An ongoing frame completes normally.
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @retval None
+  */
+void HAL_I3CEx_PipelineStop(I3CEx_PipelineTypeDef *hpipe)
+{
+  hpipe->Continuous     = 0U;
+  hpipe->RestartPending = 0U;
+}
+
+/**
+  * @brief  Read the oldest event of a pipeline.
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @param  pEvent     : [OUT] Event read.
+  * @retval HAL Status :       HAL_OK when an event was read, HAL_ERROR when the queue is empty.
+  */
+HAL_StatusTypeDef HAL_I3CEx_PipelineGetEvent(I3CEx_PipelineTypeDef *hpipe, I3CEx_EventTypeDef *pEvent)
+{
+  uint16_t tail = hpipe->Tail;
+
+  if (tail == hpipe->Head)
+  {
+    return HAL_ERROR;
+  }
+
+  *pEvent = hpipe->pEvents[tail];
+
+  tail++;
+  if (tail == hpipe->Depth)
+  {
+    tail = 0U;
+  }
+  hpipe->Tail = tail;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Frame completion handler, to be called from HAL_I3C_CtrlMultipleXferCpltCallback().
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @retval None
+  */
+void HAL_I3CEx_PipelineXferCplt(I3CEx_PipelineTypeDef *hpipe)
+{
+  I3CEx_EventTypeDef event = {0};
+
+  event.Type      = I3CEX_EVENT_FRAME;
+  event.pFrame    = hpipe->pFrame;
+  event.Timestamp = hpipe->GetTime();
+
+  hpipe->Stats.Frames++;
+  hpipe->Stats.Transfers += hpipe->pFrame->DescNbr;
+  hpipe->Stats.Elapsed    = event.Timestamp - hpipe->StartTime;
+
+  I3CEx_PipelinePush(hpipe, &event);
+
+  if (hpipe->Continuous != 0U)
+  {
+    /* The IBI is only served while no frame is ongoing: let it go first */
+    if (LL_I3C_IsActiveFlag_IBI(hpipe->hi3c->Instance) != 0U)
+    {
+      hpipe->RestartPending = 1U;
+      hpipe->Stats.Deferred++;
+    }
+    else
+    {
+      I3CEx_PipelineRestart(hpipe);
+    }
+  }
+}
+
+/**
+  * @brief  Notification handler, to be called from HAL_I3C_NotifyCallback().
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @param  eventId    : [IN]  Notification identifiers given to the callback.
+  * @retval None
+  */
+void HAL_I3CEx_PipelineNotify(I3CEx_PipelineTypeDef *hpipe, uint32_t eventId)
+{
+  I3CEx_EventTypeDef event = {0};
+  I3C_CCCInfoTypeDef ccc_info;
+
+  if ((eventId & EVENT_ID_IBI) == EVENT_ID_IBI)
+  {
+    if (HAL_I3C_GetCCCInfo(hpipe->hi3c, EVENT_ID_IBI, &ccc_info) == HAL_OK)
+    {
+      event.Type           = I3CEX_EVENT_IBI;
+      event.Timestamp      = hpipe->GetTime();
+      event.TargetAddr     = (uint8_t)ccc_info.IBICRTgtAddr;
+      event.IBIPayloadSize = (uint8_t)ccc_info.IBITgtNbPayload;
+      event.IBIPayload     = ccc_info.IBITgtPayload;
+
+      hpipe->Stats.IBIs++;
+
+      I3CEx_PipelinePush(hpipe, &event);
+    }
+
+    if ((hpipe->RestartPending != 0U) && (LL_I3C_IsActiveFlag_IBI(hpipe->hi3c->Instance) == 0U))
+    {
+      hpipe->RestartPending = 0U;
+      I3CEx_PipelineRestart(hpipe);
+    }
+  }
+}
+
+/**
+  * @brief  Error handler, to be called from HAL_I3C_ErrorCallback(). Continuous mode is stopped.
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @retval None
+  */
+void HAL_I3CEx_PipelineError(I3CEx_PipelineTypeDef *hpipe)
+{
+  I3CEx_EventTypeDef event = {0};
+
+  event.Type      = I3CEX_EVENT_ERROR;
+  event.pFrame    = hpipe->pFrame;
+  event.Timestamp = hpipe->GetTime();
+  event.ErrorCode = hpipe->hi3c->ErrorCode;
+
+  hpipe->Continuous     = 0U;
+  hpipe->RestartPending = 0U;
+  hpipe->Stats.Errors++;
+
+  I3CEx_PipelinePush(hpipe, &event);
+}
+
+/**
+  * @brief  Get the statistics of a pipeline.
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @param  pStats     : [OUT] Statistics.
+  * @retval None
+  */
+void HAL_I3CEx_PipelineGetStats(const I3CEx_PipelineTypeDef *hpipe, I3CEx_PipelineStatsTypeDef *pStats)
+{
+  *pStats = hpipe->Stats;
+}
+
+/**
+  * @brief  Reset the statistics of a pipeline and restart the elapsed time measurement.
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @retval None
+  */
+void HAL_I3CEx_PipelineResetStats(I3CEx_PipelineTypeDef *hpipe)
+{
+  hpipe->Stats.Frames    = 0U;
+  hpipe->Stats.Transfers = 0U;
+  hpipe->Stats.IBIs      = 0U;
+  hpipe->Stats.Errors    = 0U;
+  hpipe->Stats.Overflows = 0U;
+  hpipe->Stats.Deferred  = 0U;
+  hpipe->Stats.Elapsed   = 0U;
+  hpipe->StartTime       = hpipe->GetTime();
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup I3CEx_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Queue an event, dropping it when the queue is full.
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @param  pEvent     : [IN]  Event to queue.
+  * @retval None
+  */
+static void I3CEx_PipelinePush(I3CEx_PipelineTypeDef *hpipe, const I3CEx_EventTypeDef *pEvent)
+{
+  uint16_t head = hpipe->Head;
+  uint16_t next = head + 1U;
+
+  if (next == hpipe->Depth)
+  {
+    next = 0U;
+  }
+
+  if (next == hpipe->Tail)
+  {
+    hpipe->Stats.Overflows++;
+  }
+  else
+  {
+    hpipe->pEvents[head] = *pEvent;
+    hpipe->Head = next;
+  }
+}
+
+/**
+  * @brief  Restart the frame of a pipeline, reporting a failure as an error event.
+  * @param  hpipe      : [IN]  Pointer to an I3CEx_PipelineTypeDef structure.
+  * @retval None
+  */
+static void I3CEx_PipelineRestart(I3CEx_PipelineTypeDef *hpipe)
+{
+  if (HAL_I3CEx_FrameStart_DMA(hpipe->hi3c, hpipe->pFrame) != HAL_OK)
+  {
+    HAL_I3CEx_PipelineError(hpipe);
+  }
+}
+
+/**
+  * @}
+  */
+
+#endif /* HAL_DMA_MODULE_ENABLED */
+#endif /* HAL_I3C_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
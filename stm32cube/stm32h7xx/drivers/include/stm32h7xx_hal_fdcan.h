@@ -1934,6 +1934,9 @@ do{                                                              \
   * @}
   */
 
+/* Include FDCAN HAL Extended module */
+#include "stm32h7xx_hal_fdcan_ex.h"
+
 /* Exported functions --------------------------------------------------------*/
 /** @addtogroup FDCAN_Exported_Functions
   * @{
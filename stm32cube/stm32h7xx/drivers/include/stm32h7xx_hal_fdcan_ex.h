@@ -0,0 +1,336 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx_hal_fdcan_ex.h
+  * @brief   Header file of FDCAN HAL Extended module.
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32H7xx_HAL_FDCAN_EX_H
+#define STM32H7xx_HAL_FDCAN_EX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7xx_hal_def.h"
+
+#if defined(FDCAN1)
+
+/** @addtogroup STM32H7xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup FDCANEx
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup FDCANEx_Exported_Constants FDCANEx Exported Constants
+  * @{
+  */
+
+/** @defgroup FDCANEx_Filter_Limits FDCANEx Filter Limits
+  * @{
+  */
+#define FDCANEX_MAX_STD_FILTERS    128U          /*!< Standard filter elements per instance */
+#define FDCANEX_MAX_EXT_FILTERS    64U           /*!< Extended filter elements per instance */
+#define FDCANEX_MAX_RX_BUFFERS     64U           /*!< Dedicated Rx buffers per instance     */
+#define FDCANEX_MAX_FIFO_ELEMENTS  64U           /*!< Elements per Rx FIFO                  */
+#define FDCANEX_MESSAGE_RAM_WORDS  2560U         /*!< Message RAM size in 32-bit words      */
+#define FDCANEX_NO_RX_BUFFER       0xFFFFFFFFU   /*!< Accepted ID not routed to an Rx buffer */
+/**
+  * @}
+  */
+
+/** @defgroup FDCANEx_Tx_Frame_State FDCANEx Tx Frame State
+  * @{
+  */
+#define FDCANEX_TX_FRAME_FREE       0x00U  /*!< Frame not used                                 */
+#define FDCANEX_TX_FRAME_PENDING    0x01U  /*!< Frame waiting in the software queue            */
+#define FDCANEX_TX_FRAME_HW         0x02U  /*!< Frame in a hardware Tx FIFO/Queue buffer       */
+#define FDCANEX_TX_FRAME_CANCELLING 0x03U  /*!< Hardware cancellation requested for the frame  */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup FDCANEx_Exported_Types FDCANEx Exported Types
+  * @{
+  */
+
+/**
+  * @brief  FDCAN accepted identifier range definition
+  */
+typedef struct
+{
+  uint32_t IdType;        /*!< Specifies the identifier type.
+                               This parameter can be a value of @ref FDCAN_id_type                  */
+
+  uint32_t IdLow;         /*!< Specifies the first accepted identifier.
+                               This parameter must be a number between:
+                                - 0 and 0x7FF, if IdType is FDCAN_STANDARD_ID
+                                - 0 and 0x1FFFFFFF, if IdType is FDCAN_EXTENDED_ID               */
+
+  uint32_t IdHigh;        /*!< Specifies the last accepted identifier, equal to IdLow for a single ID */
+
+  uint32_t FilterConfig;  /*!< Specifies the Rx FIFO the identifiers are stored in.
+                               This parameter can be FDCAN_FILTER_TO_RXFIFO0 or FDCAN_FILTER_TO_RXFIFO1 */
+
+  uint32_t Rate;          /*!< Specifies the expected reception rate of the whole range, in frames per second */
+
+  uint32_t MaxPayload;    /*!< Specifies the largest expected payload, in bytes (0 to 64)          */
+
+  uint32_t FilterIndex;   /*!< Output: index of the filter element accepting this range            */
+
+  uint32_t RxBufferIndex; /*!< Output: dedicated Rx buffer index, or FDCANEX_NO_RX_BUFFER           */
+
+} FDCANEx_AcceptTypeDef;
+
+/**
+  * @brief  FDCAN reception traffic profile definition
+  */
+typedef struct
+{
+  FDCANEx_AcceptTypeDef *pAccept;   /*!< Specifies the accepted identifier ranges.
+                                         The array is sorted in place by the compiler.             */
+
+  uint32_t AcceptNbr;               /*!< Specifies the number of entries in pAccept                */
+
+  uint32_t MaxStdFilters;           /*!< Specifies the standard filter elements budget.
+                                         If 0, FDCANEX_MAX_STD_FILTERS is used.                    */
+
+  uint32_t MaxExtFilters;           /*!< Specifies the extended filter elements budget.
+                                         If 0, FDCANEX_MAX_EXT_FILTERS is used.                    */
+
+  uint32_t MaxRxBuffers;            /*!< Specifies the number of dedicated Rx buffers available for
+                                         high-rate identifiers.
+                                         This parameter must be a number between 0 and 64          */
+
+  uint32_t RxBufferRateThreshold;   /*!< Specifies the rate, in frames per second, from which a single
+                                         identifier is routed to a dedicated Rx buffer.
+                                         If 0, no dedicated Rx buffer is used.                     */
+
+  uint32_t ServiceInterval;         /*!< Specifies the longest time between two Rx FIFO drains,
+                                         in microseconds. It sizes the Rx FIFOs.                   */
+
+  uint32_t RamWords;                /*!< Specifies the message RAM budget for filters and Rx sections,
+                                         in 32-bit words. If 0, FDCANEX_MESSAGE_RAM_WORDS is used. */
+
+} FDCANEx_FilterProfileTypeDef;
+
+/**
+  * @brief  FDCAN compiled acceptance filter set definition
+  */
+typedef struct
+{
+  uint32_t StdFiltersNbr;                             /*!< Number of standard filter elements     */
+
+  uint32_t ExtFiltersNbr;                             /*!< Number of extended filter elements     */
+
+  uint32_t StdFilters[FDCANEX_MAX_STD_FILTERS];       /*!< Standard filter elements               */
+
+  uint32_t ExtFilters[FDCANEX_MAX_EXT_FILTERS * 2U];  /*!< Extended filter elements (F0 and F1 words) */
+
+  uint32_t RxFifo0ElmtsNbr;                           /*!< Rx FIFO 0 depth                        */
+
+  uint32_t RxFifo0ElmtSize;                           /*!< Rx FIFO 0 element size, a value of @ref FDCAN_data_field_size */
+
+  uint32_t RxFifo1ElmtsNbr;                           /*!< Rx FIFO 1 depth                        */
+
+  uint32_t RxFifo1ElmtSize;                           /*!< Rx FIFO 1 element size, a value of @ref FDCAN_data_field_size */
+
+  uint32_t RxBuffersNbr;                              /*!< Number of dedicated Rx buffers         */
+
+  uint32_t RxBufferSize;                              /*!< Rx buffer element size, a value of @ref FDCAN_data_field_size */
+
+  uint32_t RamWords;                                  /*!< Message RAM words used by the filters and Rx sections */
+
+  uint32_t ExtraIds;                                  /*!< Identifiers accepted only because ranges were merged
+                                                           to fit the filter budget                */
+
+  uint32_t StdHits[FDCANEX_MAX_STD_FILTERS];          /*!< Frames accepted per standard filter element */
+
+  uint32_t ExtHits[FDCANEX_MAX_EXT_FILTERS];          /*!< Frames accepted per extended filter element */
+
+  uint32_t NonMatchingHits;                           /*!< Frames accepted without matching any filter */
+
+} FDCANEx_FilterSetTypeDef;
+
+/**
+  * @brief  FDCAN software Tx queue frame definition
+  */
+typedef struct __FDCANEx_TxFrameTypeDef
+{
+  FDCAN_TxHeaderTypeDef Header;                 /*!< Frame header                                      */
+
+  uint8_t Data[64];                             /*!< Frame payload                                     */
+
+  uint32_t QueueTime;                           /*!< Time the frame entered the queue                  */
+
+  uint32_t State;                               /*!< Frame state, a value of @ref FDCANEx_Tx_Frame_State */
+
+  uint32_t Flags;                               /*!< Pending cancel or replace request                 */
+
+  uint32_t PriorityKey;                         /*!< Arbitration key, lowest value is sent first       */
+
+  struct __FDCANEx_TxFrameTypeDef *pNext;       /*!< Next frame in the pending or free list            */
+
+} FDCANEx_TxFrameTypeDef;
+
+/**
+  * @brief  FDCAN software Tx queue statistics definition
+  */
+typedef struct
+{
+  uint32_t Queued;          /*!< Frames added to the queue                                   */
+
+  uint32_t Sent;            /*!< Frames transmitted                                          */
+
+  uint32_t Cancelled;       /*!< Frames cancelled before transmission                        */
+
+  uint32_t Replaced;        /*!< Frames whose content was replaced before transmission       */
+
+  uint32_t Preempted;       /*!< Hardware requests aborted to make room for higher priority  */
+
+  uint32_t Overflows;       /*!< Frames rejected because no frame storage was left           */
+
+  uint32_t PendingMax;      /*!< Largest number of frames waiting at once                    */
+
+  uint32_t LatencyMin;      /*!< Shortest time from queueing to transmission                 */
+
+  uint32_t LatencyMax;      /*!< Longest time from queueing to transmission                  */
+
+  uint64_t LatencyTotal;    /*!< Sum of queueing latencies, divided by Sent gives the average */
+
+} FDCANEx_TxQueueStatsTypeDef;
+
+/**
+  * @brief  FDCAN software Tx queue definition
+  */
+typedef struct
+{
+  FDCAN_HandleTypeDef *hfdcan;                  /*!< FDCAN handle                                      */
+
+  FDCANEx_TxFrameTypeDef *pFree;                /*!< Free frames                                       */
+
+  FDCANEx_TxFrameTypeDef *pPending;             /*!< Frames waiting, sorted by priority                */
+
+  FDCANEx_TxFrameTypeDef *pHw[32];              /*!< Frame held by each hardware Tx buffer             */
+
+  uint32_t HwFrames;                            /*!< Frames in hardware Tx buffers                     */
+
+  uint32_t PendingFrames;                       /*!< Frames in the pending list                        */
+
+  uint32_t (*GetTime)(void);                    /*!< Latency time base, HAL_GetTick if NULL           */
+
+  FDCANEx_TxQueueStatsTypeDef Stats;            /*!< Statistics                                        */
+
+} FDCANEx_TxQueueTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported macro ------------------------------------------------------------*/
+/** @defgroup FDCANEx_Exported_Macros FDCANEx Exported Macros
+  * @{
+  */
+
+/**
+  * @brief  Return the payload of an Rx element acquired with HAL_FDCANEx_AcquireRxElements().
+  * @param  __ELEMENT__ pointer to the Rx element in message RAM.
+  * @retval Pointer to the first payload byte
+  */
+#define __HAL_FDCANEX_GET_RX_ELEMENT_DATA(__ELEMENT__) ((const uint8_t *)&((__ELEMENT__)[2U]))
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup FDCANEx_Exported_Functions
+  * @{
+  */
+
+/** @addtogroup FDCANEx_Exported_Functions_Group1
+  * @{
+  */
+HAL_StatusTypeDef HAL_FDCANEx_CompileFilters(FDCANEx_FilterProfileTypeDef *pProfile, FDCANEx_FilterSetTypeDef *pFilterSet);
+HAL_StatusTypeDef HAL_FDCANEx_InitWithFilterSet(FDCAN_HandleTypeDef *hfdcan, const FDCANEx_FilterSetTypeDef *pFilterSet);
+void HAL_FDCANEx_RecordFilterHit(FDCANEx_FilterSetTypeDef *pFilterSet, const FDCAN_RxHeaderTypeDef *pRxHeader);
+void HAL_FDCANEx_ResetFilterHits(FDCANEx_FilterSetTypeDef *pFilterSet);
+/**
+  * @}
+  */
+
+/** @addtogroup FDCANEx_Exported_Functions_Group2
+  * @{
+  */
+HAL_StatusTypeDef HAL_FDCANEx_GetRxMessages(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, FDCAN_RxHeaderTypeDef *pRxHeader,
+                                            uint8_t *pRxData, uint32_t DataStride, uint32_t MaxFrames, uint32_t *pFramesNbr);
+HAL_StatusTypeDef HAL_FDCANEx_AcquireRxElements(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, const uint32_t **pElements,
+                                                uint32_t MaxFrames, uint32_t *pFramesNbr);
+HAL_StatusTypeDef HAL_FDCANEx_ReleaseRxElements(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, uint32_t FramesNbr);
+void HAL_FDCANEx_DecodeRxHeader(const uint32_t *pElement, FDCAN_RxHeaderTypeDef *pRxHeader);
+/**
+  * @}
+  */
+
+/** @addtogroup FDCANEx_Exported_Functions_Group3
+  * @{
+  */
+HAL_StatusTypeDef HAL_FDCANEx_TxQueueInit(FDCANEx_TxQueueTypeDef *hqueue, FDCAN_HandleTypeDef *hfdcan,
+                                          FDCANEx_TxFrameTypeDef *pFrames, uint32_t FramesNbr, uint32_t (*GetTime)(void));
+HAL_StatusTypeDef HAL_FDCANEx_TxQueueAdd(FDCANEx_TxQueueTypeDef *hqueue, const FDCAN_TxHeaderTypeDef *pTxHeader,
+                                         const uint8_t *pTxData);
+HAL_StatusTypeDef HAL_FDCANEx_TxQueueReplace(FDCANEx_TxQueueTypeDef *hqueue, const FDCAN_TxHeaderTypeDef *pTxHeader,
+                                             const uint8_t *pTxData);
+HAL_StatusTypeDef HAL_FDCANEx_TxQueueCancel(FDCANEx_TxQueueTypeDef *hqueue, uint32_t IdType, uint32_t Identifier);
+void HAL_FDCANEx_TxQueueProcess(FDCANEx_TxQueueTypeDef *hqueue);
+uint32_t HAL_FDCANEx_TxQueueGetLevel(const FDCANEx_TxQueueTypeDef *hqueue);
+void HAL_FDCANEx_TxQueueGetStats(const FDCANEx_TxQueueTypeDef *hqueue, FDCANEx_TxQueueStatsTypeDef *pStats);
+void HAL_FDCANEx_TxQueueResetStats(FDCANEx_TxQueueTypeDef *hqueue);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Private macros ------------------------------------------------------------*/
+/** @defgroup FDCANEx_Private_Macros FDCANEx Private Macros
+  * @{
+  */
+#define IS_FDCANEX_ACCEPT_CONFIG(CONFIG) (((CONFIG) == FDCAN_FILTER_TO_RXFIFO0) || \
+                                          ((CONFIG) == FDCAN_FILTER_TO_RXFIFO1))
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* FDCAN1 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H7xx_HAL_FDCAN_EX_H */
@@ -175,6 +175,9 @@ typedef struct
   * @}
   */
 
+/* Include HCD HAL Extended module */
+#include "stm32h7xx_hal_hcd_ex.h"
+
 /* Exported functions --------------------------------------------------------*/
 /** @addtogroup HCD_Exported_Functions HCD Exported Functions
   * @{
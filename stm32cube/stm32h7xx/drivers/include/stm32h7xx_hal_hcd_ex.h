@@ -0,0 +1,199 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx_hal_hcd_ex.h
+  * @brief   Header file of HCD HAL Extension module.
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32H7xx_HAL_HCD_EX_H
+#define STM32H7xx_HAL_HCD_EX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7xx_hal_def.h"
+
+#if defined (USB_OTG_FS) || defined (USB_OTG_HS)
+/** @addtogroup STM32H7xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup HCDEx
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup HCDEx_Exported_Constants HCDEx Exported Constants
+  * @{
+  */
+
+/** @defgroup HCDEx_URB_Status HCDEx URB Status
+  * @{
+  */
+#define HCDEX_URB_QUEUED    0x00U  /*!< URB waiting for a host channel   */
+#define HCDEX_URB_ACTIVE    0x01U  /*!< URB being transferred            */
+#define HCDEX_URB_DONE      0x02U  /*!< URB completed                    */
+#define HCDEX_URB_ERROR     0x03U  /*!< URB failed after retries         */
+#define HCDEX_URB_STALL     0x04U  /*!< Endpoint answered with a STALL   */
+#define HCDEX_URB_ABORTED   0x05U  /*!< Endpoint closed before completion */
+/**
+  * @}
+  */
+
+/** @defgroup HCDEx_No_Channel HCDEx No Channel
+  * @{
+  */
+#define HCDEX_NO_CHANNEL    0xFFU  /*!< Endpoint without host channel    */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup HCDEx_Exported_Types HCDEx Exported Types
+  * @{
+  */
+
+/**
+  * @brief  HCD scheduler USB request block
+  */
+typedef struct __HCDEx_URBTypeDef
+{
+  uint8_t                    *pBuffer;                              /*!< Transfer buffer                                 */
+  uint32_t                   Length;                                /*!< Transfer length, 0 to 65535                     */
+  uint32_t                   Actual;                                /*!< Bytes transferred, set on completion            */
+  uint8_t                    Token;                                 /*!< Control endpoints: 0 for SETUP, 1 for DATA      */
+  uint8_t                    Direction;                             /*!< Control endpoints: 0 for OUT, 1 for IN          */
+  uint8_t                    Status;                                /*!< Status, a value of @ref HCDEx_URB_Status        */
+  void                       (*pCallback)(struct __HCDEx_URBTypeDef *hurb); /*!< Completion callback, may be NULL, called
+                                                                                 from the HCD interrupt            */
+  void                       *pContext;                             /*!< User context                                    */
+  struct __HCDEx_URBTypeDef  *pNext;                                /*!< Next URB of the endpoint queue                  */
+} HCDEx_URBTypeDef;
+
+/**
+  * @brief  HCD scheduler endpoint statistics
+  */
+typedef struct
+{
+  uint32_t Completed;   /*!< URBs completed                                            */
+  uint32_t Bytes;       /*!< Bytes transferred                                         */
+  uint32_t Naks;        /*!< NAK and NYET answers                                      */
+  uint32_t Throttled;   /*!< Times the endpoint was parked after repeated NAKs        */
+  uint32_t Errors;      /*!< URBs failed                                               */
+  uint32_t Stalls;      /*!< URBs stalled                                              */
+  uint32_t Late;        /*!< Periodic transfers started after their scheduled frame    */
+} HCDEx_EndpointStatsTypeDef;
+
+/**
+  * @brief  HCD scheduler endpoint
+  */
+typedef struct __HCDEx_EndpointTypeDef
+{
+  uint8_t                         DevAddr;      /*!< Device address                                   */
+  uint8_t                         EpAddr;       /*!< Endpoint address, bit 7 set for IN               */
+  uint8_t                         EpType;       /*!< EP_TYPE_CTRL, EP_TYPE_ISOC, EP_TYPE_BULK or EP_TYPE_INTR */
+  uint8_t                         Speed;        /*!< HCD_DEVICE_SPEED_HIGH, FULL or LOW               */
+  uint16_t                        MaxPacket;    /*!< Max packet size                                  */
+  uint16_t                        Interval;     /*!< Periodic endpoints: service interval in SOFs     */
+  uint8_t                         ToggleIn;     /*!< IN data toggle kept while no channel is assigned */
+  uint8_t                         ToggleOut;    /*!< OUT data toggle kept while no channel is assigned */
+  uint8_t                         Channel;      /*!< Assigned host channel or HCDEX_NO_CHANNEL        */
+  uint8_t                         DoPing;       /*!< Next OUT transfer starts with a PING             */
+  uint8_t                         Closing;      /*!< Closed, its channel halting                      */
+  uint32_t                        NextFrame;    /*!< Periodic endpoints: next service frame           */
+  uint32_t                        NakCount;     /*!< NAKs received for the current URB                */
+  uint32_t                        Backoff;      /*!< SOFs left before the endpoint is retried         */
+  uint32_t                        BackoffNext;  /*!< Next backoff, doubled on each consecutive throttle */
+  HCDEx_URBTypeDef                *pHead;       /*!< Oldest queued URB                                */
+  HCDEx_URBTypeDef                *pTail;       /*!< Newest queued URB                                */
+  struct __HCDEx_EndpointTypeDef  *pNext;       /*!< Next scheduled endpoint                          */
+  HCDEx_EndpointStatsTypeDef      Stats;        /*!< Statistics                                       */
+} HCDEx_EndpointTypeDef;
+
+/**
+  * @brief  HCD scheduler statistics
+  */
+typedef struct
+{
+  uint32_t ChannelStarts;   /*!< Transfers started on a host channel                   */
+  uint32_t NoChannel;       /*!< Scheduling passes stopped because no channel was free */
+  uint32_t Events;          /*!< URB state notifications handled                       */
+  uint32_t Frames;          /*!< SOFs handled                                          */
+} HCDEx_SchedStatsTypeDef;
+
+/**
+  * @brief  HCD scheduler handle
+  */
+typedef struct
+{
+  HCD_HandleTypeDef        *hhcd;           /*!< HCD handle                                          */
+  HCDEx_EndpointTypeDef    *pEndpoints;     /*!< Open endpoints                                      */
+  HCDEx_EndpointTypeDef    *pLastServed;    /*!< Last asynchronous endpoint given a channel          */
+  HCDEx_EndpointTypeDef    *pChannel[16];   /*!< Endpoint owning each host channel                   */
+  uint32_t                 HaltingChannels; /*!< Channels stopping, freed once halted             */
+  uint32_t                 Frame;           /*!< SOF counter                                         */
+  uint8_t                  FirstChannel;    /*!< First host channel managed by the scheduler         */
+  uint8_t                  ChannelsNbr;     /*!< Number of host channels managed by the scheduler    */
+  uint16_t                 NakThreshold;    /*!< NAKs tolerated before an endpoint is throttled      */
+  uint32_t                 BackoffMax;      /*!< Longest throttle, in SOFs                           */
+  HCDEx_SchedStatsTypeDef  Stats;           /*!< Statistics                                          */
+} HCDEx_SchedTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup HCDEx_Exported_Functions HCDEx Exported Functions
+  * @{
+  */
+
+/** @addtogroup HCDEx_Exported_Functions_Group1 Transfer scheduler functions
+  * @{
+  */
+HAL_StatusTypeDef HAL_HCDEx_SchedInit(HCDEx_SchedTypeDef *hsched, HCD_HandleTypeDef *hhcd, uint8_t FirstChannel,
+                                      uint8_t ChannelsNbr, uint16_t NakThreshold, uint32_t BackoffMax);
+HAL_StatusTypeDef HAL_HCDEx_EndpointOpen(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep, uint8_t dev_address,
+                                         uint8_t ep_addr, uint8_t ep_type, uint8_t speed, uint16_t mps,
+                                         uint16_t interval);
+HAL_StatusTypeDef HAL_HCDEx_EndpointClose(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep);
+void HAL_HCDEx_EndpointResetToggle(HCDEx_EndpointTypeDef *hep);
+HAL_StatusTypeDef HAL_HCDEx_SubmitURB(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep, HCDEx_URBTypeDef *hurb);
+void HAL_HCDEx_SchedSOF(HCDEx_SchedTypeDef *hsched);
+void HAL_HCDEx_SchedURBChange(HCDEx_SchedTypeDef *hsched, uint8_t chnum, HCD_URBStateTypeDef urb_state);
+void HAL_HCDEx_SchedGetStats(HCDEx_SchedTypeDef *hsched, HCDEx_SchedStatsTypeDef *pStats);
+void HAL_HCDEx_SchedResetStats(HCDEx_SchedTypeDef *hsched);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+#endif /* defined (USB_OTG_FS) || defined (USB_OTG_HS) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H7xx_HAL_HCD_EX_H */
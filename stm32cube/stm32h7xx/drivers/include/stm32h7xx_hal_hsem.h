@@ -115,6 +115,9 @@ extern "C" {
   * @}
   */
 
+/* Include HSEM HAL Extended module */
+#include "stm32h7xx_hal_hsem_ex.h"
+
 /* Exported functions --------------------------------------------------------*/
 /** @defgroup HSEM_Exported_Functions HSEM Exported Functions
   * @{
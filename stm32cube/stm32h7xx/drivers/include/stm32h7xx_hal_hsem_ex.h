@@ -0,0 +1,191 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx_hal_hsem_ex.h
+  * @brief   Header file of HSEM HAL Extended module.
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32H7xx_HAL_HSEM_EX_H
+#define STM32H7xx_HAL_HSEM_EX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7xx_hal_def.h"
+
+/** @addtogroup STM32H7xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup HSEMEx
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup HSEMEx_Exported_Constants HSEMEx Exported Constants
+  * @{
+  */
+
+/** @defgroup HSEMEx_Ring_Layout HSEMEx message ring layout
+  * @{
+  */
+#define HSEMEX_CACHE_LINE_SIZE      32U   /*!< Cortex-M7 D-cache line size, alignment of the shared ring parts */
+#define HSEMEX_RING_SLOT_HEADER     8U    /*!< Bytes at the start of each slot holding the message length     */
+/**
+  * @}
+  */
+
+/** @defgroup HSEMEx_Ring_Lock HSEMEx message ring lock
+  * @{
+  */
+#define HSEMEX_RING_NO_LOCK         0xFFFFFFFFU  /*!< Single producer ring, no producer lock semaphore */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup HSEMEx_Exported_Types HSEMEx Exported Types
+  * @{
+  */
+
+/**
+  * @brief  HSEM message ring control block, shared between the cores
+  * @note   It must be aligned on HSEMEX_CACHE_LINE_SIZE. Head and Tail are on
+  *         different cache lines so that each one is only written by one side.
+  */
+typedef struct
+{
+  __IO uint32_t Head;                                                    /*!< Slots committed, written by the producers */
+  uint32_t      ReservedHead[(HSEMEX_CACHE_LINE_SIZE / 4U) - 1U];        /*!< Reserved, rest of the Head cache line     */
+  __IO uint32_t Tail;                                                    /*!< Slots released, written by the consumer   */
+  uint32_t      ReservedTail[(HSEMEX_CACHE_LINE_SIZE / 4U) - 1U];        /*!< Reserved, rest of the Tail cache line     */
+} HSEMEx_RingCtrlTypeDef;
+
+/**
+  * @brief  HSEM message ring statistics
+  */
+typedef struct
+{
+  uint32_t Messages;        /*!< Messages committed (producer) or released (consumer)     */
+  uint32_t Full;            /*!< Acquire attempts on a full ring                          */
+  uint32_t Empty;           /*!< Peek attempts on an empty ring                           */
+  uint32_t Doorbells;       /*!< Doorbells rung (producer) or received (consumer)         */
+  uint32_t LockBusy;        /*!< Acquire attempts with the producer lock held elsewhere   */
+} HSEMEx_RingStatsTypeDef;
+
+/**
+  * @brief  HSEM message ring handle, local to each core and each producer
+  */
+typedef struct
+{
+  HSEMEx_RingCtrlTypeDef   *pCtrl;            /*!< Shared control block                                   */
+  uint8_t                  *pSlots;           /*!< Shared slots, SlotNbr * SlotSize bytes, aligned on
+                                                   HSEMEX_CACHE_LINE_SIZE                                 */
+  uint32_t                 SlotSize;          /*!< Bytes per slot, header included, multiple of
+                                                   HSEMEX_CACHE_LINE_SIZE                                 */
+  uint32_t                 SlotNbr;           /*!< Number of slots, power of 2                            */
+  uint32_t                 DoorbellSemID;     /*!< Semaphore released by the producers after a commit     */
+  uint32_t                 LockSemID;         /*!< Semaphore serializing the producers, or
+                                                   HSEMEX_RING_NO_LOCK                                    */
+  uint32_t                 ProcessID;         /*!< Process ID of this producer for LockSemID, unique     */
+  uint32_t                 CacheMaintenance;  /*!< D-cache clean/invalidate of the shared parts, set by
+                                                   HAL_HSEMEx_RingInit() when the D-cache is enabled     */
+  uint32_t                 Pending;           /*!< Slot acquired and not committed, or peeked and not
+                                                   released                                               */
+  HSEMEx_RingStatsTypeDef  Stats;             /*!< Statistics                                             */
+} HSEMEx_RingTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported macros -----------------------------------------------------------*/
+/** @defgroup HSEMEx_Exported_Macros HSEMEx Exported Macros
+  * @{
+  */
+
+/** @brief  Shared slot storage needed by a message ring.
+  * @param  __PAYLOAD__ maximum message size in bytes.
+  * @param  __SLOTS__ number of slots.
+  * @retval Number of bytes.
+  */
+#define __HAL_HSEMEX_RING_STORAGE_SIZE(__PAYLOAD__, __SLOTS__) \
+  ((((((__PAYLOAD__) + HSEMEX_RING_SLOT_HEADER) + (HSEMEX_CACHE_LINE_SIZE - 1U)) / HSEMEX_CACHE_LINE_SIZE) * \
+    HSEMEX_CACHE_LINE_SIZE) * (__SLOTS__))
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup HSEMEx_Exported_Functions
+  * @{
+  */
+
+/** @addtogroup HSEMEx_Exported_Functions_Group1
+  * @{
+  */
+/* Message ring configuration functions ***************************************/
+HAL_StatusTypeDef HAL_HSEMEx_RingInit(HSEMEx_RingTypeDef *hring, HSEMEx_RingCtrlTypeDef *pCtrl, uint8_t *pSlots,
+                                      uint32_t SlotSize, uint32_t SlotNbr, uint32_t DoorbellSemID);
+HAL_StatusTypeDef HAL_HSEMEx_RingSetLock(HSEMEx_RingTypeDef *hring, uint32_t LockSemID, uint32_t ProcessID);
+HAL_StatusTypeDef HAL_HSEMEx_RingReset(HSEMEx_RingTypeDef *hring);
+/**
+  * @}
+  */
+
+/** @addtogroup HSEMEx_Exported_Functions_Group2
+  * @{
+  */
+/* Message ring producer functions ********************************************/
+HAL_StatusTypeDef HAL_HSEMEx_RingAcquire(HSEMEx_RingTypeDef *hring, uint8_t **ppBuffer, uint32_t *pSize);
+HAL_StatusTypeDef HAL_HSEMEx_RingCommit(HSEMEx_RingTypeDef *hring, uint32_t Length);
+HAL_StatusTypeDef HAL_HSEMEx_RingSend(HSEMEx_RingTypeDef *hring, const uint8_t *pData, uint32_t Length);
+/**
+  * @}
+  */
+
+/** @addtogroup HSEMEx_Exported_Functions_Group3
+  * @{
+  */
+/* Message ring consumer functions ********************************************/
+void              HAL_HSEMEx_RingEnableDoorbell(const HSEMEx_RingTypeDef *hring);
+uint32_t          HAL_HSEMEx_RingDoorbell(HSEMEx_RingTypeDef *hring, uint32_t SemMask);
+HAL_StatusTypeDef HAL_HSEMEx_RingPeek(HSEMEx_RingTypeDef *hring, uint8_t **ppBuffer, uint32_t *pLength);
+HAL_StatusTypeDef HAL_HSEMEx_RingRelease(HSEMEx_RingTypeDef *hring);
+HAL_StatusTypeDef HAL_HSEMEx_RingReceive(HSEMEx_RingTypeDef *hring, uint8_t *pData, uint32_t Size,
+                                         uint32_t *pLength);
+uint32_t          HAL_HSEMEx_RingGetCount(const HSEMEx_RingTypeDef *hring);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32H7xx_HAL_HSEM_EX_H */
@@ -36,6 +36,77 @@ extern "C" {
   * @{
   */
 /* Exported types ------------------------------------------------------------*/
+/** @defgroup PCDEx_Exported_Types PCDEx Exported Types
+  * @{
+  */
+
+/**
+  * @brief  PCD endpoint stream transfer descriptor
+  */
+typedef struct
+{
+  uint8_t  *pBuffer;            /*!< Transfer buffer                                      */
+  uint32_t Length;              /*!< IN endpoint: bytes to send, OUT endpoint: buffer size */
+  uint32_t Actual;              /*!< Bytes transferred, set on completion                 */
+} PCDEx_StreamXferTypeDef;
+
+/**
+  * @brief  PCD endpoint stream statistics
+  */
+typedef struct
+{
+  uint32_t Transfers;           /*!< Completed transfers                                          */
+  uint64_t Bytes;               /*!< Bytes transferred                                            */
+  uint32_t Starved;             /*!< Completions with no next transfer queued                     */
+  uint32_t Incomplete;          /*!< Isochronous transfers missed in their (micro)frame           */
+  uint32_t IntervalMin;         /*!< Shortest time between back-to-back completions               */
+  uint32_t IntervalMax;         /*!< Longest time between back-to-back completions                */
+  uint32_t Elapsed;             /*!< Time since the statistics were reset, Bytes / Elapsed gives
+                                     the throughput and IntervalMax - IntervalMin the jitter      */
+} PCDEx_StreamStatsTypeDef;
+
+/**
+  * @brief  PCD endpoint stream handle
+  */
+typedef struct
+{
+  PCD_HandleTypeDef        *hpcd;             /*!< PCD handle                                  */
+  PCDEx_StreamXferTypeDef  *pXfer;            /*!< Transfer descriptor ring                    */
+  uint32_t                 XferNbr;           /*!< Number of descriptors in the ring, a power of 2 */
+  uint32_t                 SubmitCount;       /*!< Transfers submitted                         */
+  uint32_t                 ActiveCount;       /*!< Transfers completed by the endpoint         */
+  uint32_t                 ReclaimCount;      /*!< Transfers returned to the application       */
+  uint8_t                  EpAddr;            /*!< Endpoint address                            */
+  uint8_t                  ZeroLengthPacket;  /*!< Terminate bulk IN transfers of a multiple of
+                                                   the max packet size with a ZLP              */
+  uint8_t                  ZlpPending;        /*!< ZLP in progress                             */
+  uint8_t                  Busy;              /*!< Transfer in progress on the endpoint        */
+  uint32_t                 (*GetTime)(void);  /*!< Statistics time base                        */
+  uint32_t                 StartTime;         /*!< Time of the statistics reset                */
+  uint32_t                 LastTime;          /*!< Time of the last completion                 */
+  uint32_t                 BackToBack;        /*!< Last completion was followed by a queued transfer */
+  PCDEx_StreamStatsTypeDef Stats;             /*!< Statistics                                  */
+} PCDEx_StreamTypeDef;
+
+/**
+  * @brief  PCD isochronous feedback endpoint handle
+  */
+typedef struct
+{
+  PCD_HandleTypeDef        *hpcd;             /*!< PCD handle                                  */
+  uint8_t                  EpAddr;            /*!< Feedback IN endpoint address                */
+  uint8_t                  Size;              /*!< 3 bytes (10.14) at full speed, 4 bytes (16.16) at high speed */
+  uint8_t                  Busy;              /*!< Transfer in progress on the endpoint        */
+  uint8_t                  Slot;              /*!< Slot holding the latest value               */
+  uint8_t                  Sending;           /*!< Slot armed on the endpoint, while Busy      */
+  uint32_t                 Value[2];          /*!< Feedback values, double-buffered, little-endian
+                                                   words sent from their first Size bytes      */
+  uint32_t                 Updates;           /*!< Number of rate updates                      */
+} PCDEx_FeedbackTypeDef;
+
+/**
+  * @}
+  */
 /* Exported constants --------------------------------------------------------*/
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
@@ -63,6 +134,27 @@ void HAL_PCDEx_BCD_VBUSDetect(PCD_HandleTypeDef *hpcd);
 void HAL_PCDEx_LPM_Callback(PCD_HandleTypeDef *hpcd, PCD_LPM_MsgTypeDef msg);
 void HAL_PCDEx_BCD_Callback(PCD_HandleTypeDef *hpcd, PCD_BCD_MsgTypeDef msg);
 
+/**
+  * @}
+  */
+
+/** @addtogroup PCDEx_Exported_Functions_Group2 Endpoint streaming functions
+  * @{
+  */
+HAL_StatusTypeDef HAL_PCDEx_StreamInit(PCD_HandleTypeDef *hpcd, PCDEx_StreamTypeDef *hstream, uint8_t ep_addr,
+                                       PCDEx_StreamXferTypeDef *pXfer, uint32_t XferNbr,
+                                       uint8_t ZeroLengthPacket, uint32_t (*GetTime)(void));
+HAL_StatusTypeDef HAL_PCDEx_StreamSubmit(PCDEx_StreamTypeDef *hstream, uint8_t *pBuffer, uint32_t Length);
+HAL_StatusTypeDef HAL_PCDEx_StreamGetCompleted(PCDEx_StreamTypeDef *hstream, PCDEx_StreamXferTypeDef *pXfer);
+void HAL_PCDEx_StreamReset(PCDEx_StreamTypeDef *hstream);
+void HAL_PCDEx_StreamDataStage(PCDEx_StreamTypeDef *hstream);
+void HAL_PCDEx_StreamIncomplete(PCDEx_StreamTypeDef *hstream);
+void HAL_PCDEx_StreamGetStats(PCDEx_StreamTypeDef *hstream, PCDEx_StreamStatsTypeDef *pStats);
+void HAL_PCDEx_StreamResetStats(PCDEx_StreamTypeDef *hstream);
+
+HAL_StatusTypeDef HAL_PCDEx_FeedbackInit(PCD_HandleTypeDef *hpcd, PCDEx_FeedbackTypeDef *hfb, uint8_t ep_addr);
+void HAL_PCDEx_FeedbackSetRate(PCDEx_FeedbackTypeDef *hfb, uint32_t Samples, uint32_t Frames);
+void HAL_PCDEx_FeedbackDataStage(PCDEx_FeedbackTypeDef *hfb);
 /**
   * @}
   */
@@ -55,11 +55,172 @@ typedef struct
                              This parameter must be a number between Min_Data = 0 and Max_Data = 7. */
 } SAIEx_PdmMicDelayParamTypeDef;
 
+/**
+  * @brief  Audio stream configuration structure definition
+  */
+typedef struct
+{
+  uint32_t Direction;        /*!< Specifies the stream direction.
+                                  This parameter can be a value of @ref SAIEx_Stream_Direction */
+
+  uint8_t *pBuffer;          /*!< Specifies the ring buffer used by the circular DMA.
+                                  Its size is BlockCount * BlockSize bytes. */
+
+  uint32_t BlockSize;        /*!< Specifies the size of one ring block in bytes.
+                                  This parameter must be a multiple of FrameSize. */
+
+  uint32_t BlockCount;       /*!< Specifies the number of blocks in the ring.
+                                  This parameter must be a number between Min_Data = 2 and Max_Data = 32. */
+
+  uint32_t FrameSize;        /*!< Specifies the size in bytes of one audio frame (all slots of one
+                                  sampling period). It must be a multiple of the DMA memory data width. */
+
+  uint32_t TargetLevel;      /*!< Specifies the fill level in frames the servo keeps the ring at.
+                                  If 0, half of the ring is used. */
+
+  uint32_t MaxLevel;         /*!< Specifies the latency bound in frames. Frames written above this level
+                                  are discarded and counted as overruns. If 0, BlockCount - 1 blocks are used. */
+
+  uint32_t CorrectionMode;   /*!< Specifies how clock drift is compensated.
+                                  This parameter can be a value of @ref SAIEx_Stream_Correction_Mode */
+
+  uint32_t PLLSource;        /*!< Specifies the PLL trimmed when CorrectionMode is SAIEX_STREAM_CORRECTION_PLL.
+                                  This parameter can be a value of @ref SAIEx_Stream_PLL_Source.
+                                  All the outputs of the PLL are trimmed: PLL1 is rejected while it
+                                  clocks the system. */
+
+  uint32_t PLLFracNominal;   /*!< Specifies the nominal fractional part of the PLL multiplication factor.
+                                  This parameter must be a number between Min_Data = 0 and Max_Data = 8191. */
+
+  uint32_t PLLFracRange;     /*!< Specifies the maximum deviation in FRACN steps around PLLFracNominal. */
+
+  int32_t  ProportionalGain; /*!< Specifies the servo proportional gain in Q16 format. The output unit is
+                                  one FRACN step (PLL correction) or one frame per update (sample correction). */
+
+  int32_t  IntegralGain;     /*!< Specifies the servo integral gain in Q16 format. */
+} SAIEx_StreamInitTypeDef;
+
+/**
+  * @brief  Audio stream statistics structure definition
+  */
+typedef struct
+{
+  uint32_t Updates;          /*!< Number of servo updates */
+
+  uint32_t Underruns;        /*!< Number of times the consumer caught up with the producer */
+
+  uint32_t Overruns;         /*!< Number of times the fill level exceeded the latency bound */
+
+  uint32_t LevelMin;         /*!< Lowest fill level observed, in frames */
+
+  uint32_t LevelMax;         /*!< Highest fill level observed, in frames */
+
+  uint32_t LevelAverage;     /*!< Moving average of the fill level, in 1/256 frame */
+
+  uint32_t Jitter;           /*!< Peak deviation of the fill level from TargetLevel, in frames */
+
+  uint32_t FramesInserted;   /*!< Number of frames duplicated by sample correction */
+
+  uint32_t FramesDropped;    /*!< Number of frames skipped by sample correction */
+
+  uint32_t PLLUpdates;       /*!< Number of fractional PLL trims applied */
+
+  int32_t  Correction;       /*!< Last servo output in Q16 format */
+
+  int32_t  CorrectionMin;    /*!< Lowest servo output in Q16 format */
+
+  int32_t  CorrectionMax;    /*!< Highest servo output in Q16 format */
+} SAIEx_StreamStatsTypeDef;
+
+/**
+  * @brief  Audio stream handle structure definition
+  */
+typedef struct
+{
+  SAI_HandleTypeDef        *hsai;          /*!< SAI handle the stream runs on */
+
+  SAIEx_StreamInitTypeDef  Init;           /*!< Stream configuration parameters */
+
+  uint32_t                 RingFrames;     /*!< Ring size in frames */
+
+  uint32_t                 ItemSize;       /*!< DMA memory data width in bytes */
+
+  uint32_t                 AppIndex;       /*!< Application side position in the ring, in frames */
+
+  __IO uint32_t            AppTotal;       /*!< Frames produced (Tx) or consumed (Rx) by the application */
+
+  __IO uint32_t            HwTotal;        /*!< Frames consumed (Tx) or produced (Rx) by the DMA at last update */
+
+  __IO uint32_t            HwIndex;        /*!< DMA position in the ring at last update, in frames */
+
+  int32_t                  Integrator;     /*!< Servo integrator, in frames */
+
+  int32_t                  SlipFraction;   /*!< Servo output not yet converted into a frame slip, in Q16 */
+
+  __IO uint32_t            SlipRequested;  /*!< Frame slips requested by the servo, +1 per drop, -1 per insert */
+
+  __IO uint32_t            SlipApplied;    /*!< Frame slips applied by the application side */
+
+  uint32_t                 PLLFrac;        /*!< Fractional PLL value currently applied */
+
+  SAIEx_StreamStatsTypeDef Stats;          /*!< Stream statistics */
+
+  __IO uint32_t            State;          /*!< Stream state, one of @ref SAIEx_Stream_State */
+} SAIEx_StreamTypeDef;
+
 /**
   * @}
   */
 
 /* Exported constants --------------------------------------------------------*/
+/** @defgroup SAIEx_Exported_Constants SAIEx Exported Constants
+  * @{
+  */
+
+/** @defgroup SAIEx_Stream_Direction SAIEx Stream Direction
+  * @{
+  */
+#define SAIEX_STREAM_TX                    0x00000000U  /*!< Application produces, SAI consumes */
+#define SAIEX_STREAM_RX                    0x00000001U  /*!< SAI produces, application consumes */
+/**
+  * @}
+  */
+
+/** @defgroup SAIEx_Stream_Correction_Mode SAIEx Stream Correction Mode
+  * @{
+  */
+#define SAIEX_STREAM_CORRECTION_NONE       0x00000000U  /*!< Fill level is only monitored             */
+#define SAIEX_STREAM_CORRECTION_PLL        0x00000001U  /*!< SAI kernel clock is trimmed by PLL FRACN */
+#define SAIEX_STREAM_CORRECTION_SAMPLE     0x00000002U  /*!< Frames are inserted or dropped           */
+/**
+  * @}
+  */
+
+/** @defgroup SAIEx_Stream_PLL_Source SAIEx Stream PLL Source
+  * @{
+  */
+#define SAIEX_STREAM_PLL1                  0x00000000U  /*!< SAI clocked from PLL1 Q output, PLL1 not
+                                                             clocking the system */
+#define SAIEX_STREAM_PLL2                  0x00000001U  /*!< SAI clocked from PLL2 P output */
+#define SAIEX_STREAM_PLL3                  0x00000002U  /*!< SAI clocked from PLL3 P output */
+/**
+  * @}
+  */
+
+/** @defgroup SAIEx_Stream_State SAIEx Stream State
+  * @{
+  */
+#define SAIEX_STREAM_STATE_RESET           0x00000000U  /*!< Stream not initialized */
+#define SAIEX_STREAM_STATE_READY           0x00000001U  /*!< Stream initialized     */
+#define SAIEX_STREAM_STATE_RUNNING         0x00000002U  /*!< Stream DMA running     */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
 /* Exported macros -----------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 /** @addtogroup SAIEx_Exported_Functions SAIEx Extended Exported Functions
@@ -75,6 +236,23 @@ HAL_StatusTypeDef HAL_SAIEx_ConfigPdmMicDelay(const SAI_HandleTypeDef *hsai,
   * @}
   */
 
+/** @addtogroup SAIEx_Exported_Functions_Group2 Audio streaming functions
+  * @{
+  */
+HAL_StatusTypeDef HAL_SAIEx_StreamInit(SAIEx_StreamTypeDef *hstream, SAI_HandleTypeDef *hsai,
+                                       const SAIEx_StreamInitTypeDef *pInit);
+HAL_StatusTypeDef HAL_SAIEx_StreamStart(SAIEx_StreamTypeDef *hstream);
+HAL_StatusTypeDef HAL_SAIEx_StreamStop(SAIEx_StreamTypeDef *hstream);
+uint32_t          HAL_SAIEx_StreamWrite(SAIEx_StreamTypeDef *hstream, const uint8_t *pData, uint32_t NbFrames);
+uint32_t          HAL_SAIEx_StreamRead(SAIEx_StreamTypeDef *hstream, uint8_t *pData, uint32_t NbFrames);
+void              HAL_SAIEx_StreamUpdate(SAIEx_StreamTypeDef *hstream);
+int32_t           HAL_SAIEx_StreamGetLevel(const SAIEx_StreamTypeDef *hstream);
+void              HAL_SAIEx_StreamGetStats(const SAIEx_StreamTypeDef *hstream, SAIEx_StreamStatsTypeDef *pStats);
+void              HAL_SAIEx_StreamResetStats(SAIEx_StreamTypeDef *hstream);
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -84,6 +262,21 @@ HAL_StatusTypeDef HAL_SAIEx_ConfigPdmMicDelay(const SAI_HandleTypeDef *hsai,
   * @{
   */
 #define IS_SAI_PDM_MIC_DELAY(VALUE)   ((VALUE) <= 7U)
+
+#define IS_SAIEX_STREAM_DIRECTION(DIR)  (((DIR) == SAIEX_STREAM_TX) || \
+                                         ((DIR) == SAIEX_STREAM_RX))
+
+#define IS_SAIEX_STREAM_CORRECTION(MODE) (((MODE) == SAIEX_STREAM_CORRECTION_NONE) || \
+                                          ((MODE) == SAIEX_STREAM_CORRECTION_PLL)  || \
+                                          ((MODE) == SAIEX_STREAM_CORRECTION_SAMPLE))
+
+#define IS_SAIEX_STREAM_PLL(PLL)        (((PLL) == SAIEX_STREAM_PLL1) || \
+                                         ((PLL) == SAIEX_STREAM_PLL2) || \
+                                         ((PLL) == SAIEX_STREAM_PLL3))
+
+#define IS_SAIEX_STREAM_BLOCK_COUNT(COUNT) (((COUNT) >= 2U) && ((COUNT) <= 32U))
+
+#define IS_SAIEX_STREAM_PLL_FRACN(VALUE) ((VALUE) <= 8191U)
 /**
   * @}
   */
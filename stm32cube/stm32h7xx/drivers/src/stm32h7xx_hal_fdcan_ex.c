@@ -0,0 +1,1831 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx_hal_fdcan_ex.c
+  * @brief   FDCAN Extended HAL module driver.
+  *          This file provides firmware functions to manage the following
+  *          functionalities of the Flexible DataRate Controller Area Network
+  *          (FDCAN) peripheral:
+  *           + Acceptance filter compilation and message RAM sizing
+  *           + Bulk and zero-copy Rx FIFO reception
+  *           + Priority-aware software Tx queue
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                        ##### How to use this driver #####
+  ==============================================================================
+    [..]
+      (#) Describe the reception traffic in an array of FDCANEx_AcceptTypeDef:
+          one entry per accepted identifier or identifier range, with its
+          destination FIFO, expected rate and largest payload.
+
+      (#) Fill a FDCANEx_FilterProfileTypeDef with the filter, Rx buffer and
+          message RAM budgets and the longest Rx FIFO service interval, then
+          call HAL_FDCANEx_CompileFilters(). It:
+            (++) routes the highest-rate single identifiers to dedicated Rx buffers,
+            (++) covers each aligned block of identifiers, e.g. 0x100, 0x300,
+                 0x500 and 0x700, with a single classic mask filter,
+            (++) merges overlapping and adjacent ranges,
+            (++) packs remaining single identifiers by pairs into dual ID filters,
+            (++) merges the closest ranges when the filter budget is exceeded,
+                 reporting the number of extra identifiers accepted,
+            (++) sizes Rx FIFOs and Rx buffers from the traffic profile.
+          The compilation does not access the peripheral and can be run once
+          at build time on a host.
+
+      (#) Fill the Tx related fields of hfdcan->Init and call
+          HAL_FDCANEx_InitWithFilterSet() instead of HAL_FDCAN_Init(). The Rx
+          sections are laid out from the compiled set, all filter elements are
+          written in a single pass and non-matching frames are rejected.
+
+      (#) Call HAL_FDCANEx_RecordFilterHit() for each received frame to collect
+          per filter element hit statistics.
+
+      (#) To drain an Rx FIFO in bursts, call HAL_FDCANEx_GetRxMessages(): the
+          fill level is read once, up to MaxFrames frames are copied and
+          acknowledged with a single write to the acknowledge register.
+
+      (#) To parse frames in place, call HAL_FDCANEx_AcquireRxElements() to get
+          pointers to the oldest elements in message RAM, decode them with
+          HAL_FDCANEx_DecodeRxHeader() and __HAL_FDCANEX_GET_RX_ELEMENT_DATA(),
+          then call HAL_FDCANEx_ReleaseRxElements(). The elements stay valid
+          until released; this is only supported with the Rx FIFO in blocking
+          mode.
+
+      (#) To transmit through a priority-ordered software queue, configure the
+          Tx FIFO/Queue in FDCAN_TX_QUEUE_OPERATION mode and call
+          HAL_FDCANEx_TxQueueInit() with an array of FDCANEx_TxFrameTypeDef
+          used as frame storage. Activate the FDCAN_IT_TX_COMPLETE and
+          FDCAN_IT_TX_ABORT_COMPLETE notifications for the Tx FIFO/Queue
+          buffers and call HAL_FDCANEx_TxQueueProcess() from
+          HAL_FDCAN_TxBufferCompleteCallback(), HAL_FDCAN_TxBufferAbortCallback()
+          and HAL_FDCAN_TxFifoEmptyCallback().
+            (++) HAL_FDCANEx_TxQueueAdd() queues a frame; the hardware buffers
+                 are refilled with the highest priority frames and, when they
+                 are all used, the lowest priority hardware request is aborted
+                 in favor of a higher priority waiting frame.
+            (++) HAL_FDCANEx_TxQueueReplace() updates the content of a queued
+                 frame with the same identifier, e.g. a stale periodic frame.
+            (++) HAL_FDCANEx_TxQueueCancel() removes the frames with a given
+                 identifier.
+            (++) HAL_FDCANEx_TxQueueGetStats() reports queueing latencies,
+                 in GetTime units.
+
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7xx_hal.h"
+
+#if defined(FDCAN1)
+
+/** @addtogroup STM32H7xx_HAL_Driver
+  * @{
+  */
+
+/** @defgroup FDCANEx FDCANEx
+  * @brief FDCAN Extended HAL module driver
+  * @{
+  */
+
+#ifdef HAL_FDCAN_MODULE_ENABLED
+
+/* Private typedef -----------------------------------------------------------*/
+/** @defgroup FDCANEx_Private_Types FDCANEx Private Types
+  * @{
+  */
+typedef struct
+{
+  uint32_t  *pBase;      /* Rx FIFO start address in message RAM  */
+  uint32_t  ElmtWords;   /* Element size in 32-bit words          */
+  uint32_t  ElmtsNbr;    /* Rx FIFO depth                         */
+  uint32_t  GetIndex;    /* Index of the oldest element           */
+  uint32_t  FillLevel;   /* Number of elements to read            */
+} FDCANEx_RxFifoTypeDef;
+/**
+  * @}
+  */
+
+/* Private define ------------------------------------------------------------*/
+/** @defgroup FDCANEx_Private_Constants FDCANEx Private Constants
+  * @{
+  */
+#define FDCANEX_STD_ID_MAX        0x7FFU
+#define FDCANEX_EXT_ID_MAX        0x1FFFFFFFU
+#define FDCANEX_NO_ID             0xFFFFFFFFU
+
+#define FDCANEX_ELEMENT_MASK_STDID ((uint32_t)0x1FFC0000U) /* Standard Identifier         */
+#define FDCANEX_ELEMENT_MASK_EXTID ((uint32_t)0x1FFFFFFFU) /* Extended Identifier         */
+#define FDCANEX_ELEMENT_MASK_RTR   ((uint32_t)0x20000000U) /* Remote Transmission Request */
+#define FDCANEX_ELEMENT_MASK_XTD   ((uint32_t)0x40000000U) /* Extended Identifier         */
+#define FDCANEX_ELEMENT_MASK_ESI   ((uint32_t)0x80000000U) /* Error State Indicator       */
+#define FDCANEX_ELEMENT_MASK_TS    ((uint32_t)0x0000FFFFU) /* Timestamp                   */
+#define FDCANEX_ELEMENT_MASK_DLC   ((uint32_t)0x000F0000U) /* Data Length Code            */
+#define FDCANEX_ELEMENT_MASK_BRS   ((uint32_t)0x00100000U) /* Bit Rate Switch             */
+#define FDCANEX_ELEMENT_MASK_FDF   ((uint32_t)0x00200000U) /* FD Format                   */
+#define FDCANEX_ELEMENT_MASK_FIDX  ((uint32_t)0x7F000000U) /* Filter Index                */
+#define FDCANEX_ELEMENT_MASK_ANMF  ((uint32_t)0x80000000U) /* Accepted Non-matching Frame */
+#define FDCANEX_TX_FLAG_CANCEL    0x01U  /* Frame to be dropped once out of hardware  */
+#define FDCANEX_TX_FLAG_REPLACE   0x02U  /* Frame content replaced while in hardware    */
+/**
+  * @}
+  */
+
+/* Private macro -------------------------------------------------------------*/
+/** @defgroup FDCANEx_Private_Macros FDCANEx Private Macros
+  * @{
+  */
+#define FDCANEX_ENTER_CRITICAL(__PRIMASK__)  do { (__PRIMASK__) = __get_PRIMASK(); __disable_irq(); } while (0U)
+#define FDCANEX_EXIT_CRITICAL(__PRIMASK__)   __set_PRIMASK(__PRIMASK__)
+/**
+  * @}
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/** @defgroup FDCANEx_Private_Variables FDCANEx Private Variables
+  * @{
+  */
+static const uint8_t FDCANEx_DLCtoBytes[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64};
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup FDCANEx_Private_Functions FDCANEx Private Functions
+  * @{
+  */
+static void     FDCANEx_SortAccept(FDCANEx_AcceptTypeDef *pAccept, uint32_t AcceptNbr);
+static uint32_t FDCANEx_AssignRxBuffers(const FDCANEx_FilterProfileTypeDef *pProfile, uint32_t IdType,
+                                        uint32_t FirstIndex, FDCANEx_FilterSetTypeDef *pFilterSet);
+static uint32_t FDCANEx_BuildMasks(FDCANEx_FilterProfileTypeDef *pProfile, uint32_t IdType, uint32_t FirstIndex,
+                                   uint32_t Limit, FDCANEx_FilterSetTypeDef *pFilterSet);
+static uint32_t FDCANEx_MatchMask(FDCANEx_FilterProfileTypeDef *pProfile, uint32_t IdType, uint32_t FilterConfig,
+                                  uint32_t Base, uint32_t Free, uint32_t FilterIndex, uint32_t *pSingles);
+static uint32_t FDCANEx_BuildFilters(const FDCANEx_FilterProfileTypeDef *pProfile, uint32_t IdType,
+                                     uint32_t Gap, uint32_t FirstIndex, FDCANEx_FilterSetTypeDef *pFilterSet);
+static void     FDCANEx_WriteFilter(FDCANEx_FilterSetTypeDef *pFilterSet, uint32_t IdType, uint32_t Index,
+                                    uint32_t FilterType, uint32_t FilterConfig, uint32_t Id1, uint32_t Id2);
+static uint32_t FDCANEx_PayloadToDataSize(uint32_t Payload);
+static HAL_StatusTypeDef FDCANEx_GetRxFifo(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, FDCANEx_RxFifoTypeDef *pFifo);
+static void     FDCANEx_AcknowledgeRxFifo(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, const FDCANEx_RxFifoTypeDef *pFifo,
+                                          uint32_t FramesNbr);
+static void     FDCANEx_TxCopy(FDCANEx_TxFrameTypeDef *pFrame, const FDCAN_TxHeaderTypeDef *pTxHeader, const uint8_t *pTxData);
+static void     FDCANEx_TxInsert(FDCANEx_TxQueueTypeDef *hqueue, FDCANEx_TxFrameTypeDef *pFrame, uint32_t Front);
+static void     FDCANEx_TxRelease(FDCANEx_TxQueueTypeDef *hqueue, FDCANEx_TxFrameTypeDef *pFrame);
+static void     FDCANEx_TxSchedule(FDCANEx_TxQueueTypeDef *hqueue);
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup FDCANEx_Exported_Functions FDCANEx Exported Functions
+  * @{
+  */
+
+/** @defgroup FDCANEx_Exported_Functions_Group1 Acceptance filter compilation functions
+  * @brief    Acceptance filter compilation functions
+  *
+@verbatim
+  ==============================================================================
+              ##### Acceptance filter compilation functions #####
+  ==============================================================================
+    [..]  This section provides functions allowing to:
+      (+) Compile a set of accepted identifiers into a minimal filter list.
+      (+) Size the Rx sections of the message RAM from a traffic profile.
+      (+) Initialize the FDCAN with a compiled filter set in one pass.
+      (+) Collect filter hit statistics.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Compile accepted identifiers into filter elements and Rx section sizes.
+  * @note   This function does not access the peripheral.
+  * @param  pProfile pointer to a FDCANEx_FilterProfileTypeDef structure. The
+  *         accepted identifier array is sorted in place and its FilterIndex and
+  *         RxBufferIndex output fields are updated.
+  * @param  pFilterSet pointer to the FDCANEx_FilterSetTypeDef structure receiving
+  *         the compiled filters.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_FDCANEx_CompileFilters(FDCANEx_FilterProfileTypeDef *pProfile, FDCANEx_FilterSetTypeDef *pFilterSet)
+{
+  FDCANEx_AcceptTypeDef *entry;
+  uint32_t maxStd;
+  uint32_t maxExt;
+  uint32_t ramWords;
+  uint32_t bufStd;
+  uint32_t bufExt;
+  uint32_t idType;
+  uint32_t limit;
+  uint32_t low;
+  uint32_t high;
+  uint32_t mid;
+  uint32_t rate[2] = {0U, 0U};
+  uint32_t payload[3] = {0U, 0U, 0U};
+  uint32_t routed[2] = {0U, 0U};
+  uint32_t used;
+  uint32_t index;
+  uint64_t depth;
+
+  if ((pProfile == NULL) || (pFilterSet == NULL) || ((pProfile->pAccept == NULL) && (pProfile->AcceptNbr != 0U)))
+  {
+    return HAL_ERROR;
+  }
+
+  maxStd = (pProfile->MaxStdFilters == 0U) ? FDCANEX_MAX_STD_FILTERS : pProfile->MaxStdFilters;
+  maxExt = (pProfile->MaxExtFilters == 0U) ? FDCANEX_MAX_EXT_FILTERS : pProfile->MaxExtFilters;
+  ramWords = (pProfile->RamWords == 0U) ? FDCANEX_MESSAGE_RAM_WORDS : pProfile->RamWords;
+  if ((maxStd > FDCANEX_MAX_STD_FILTERS) || (maxExt > FDCANEX_MAX_EXT_FILTERS) ||
+      (pProfile->MaxRxBuffers > FDCANEX_MAX_RX_BUFFERS))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Check the accepted identifiers */
+  for (index = 0U; index < pProfile->AcceptNbr; index++)
+  {
+    entry = &pProfile->pAccept[index];
+    assert_param(IS_FDCAN_ID_TYPE(entry->IdType));
+    assert_param(IS_FDCANEX_ACCEPT_CONFIG(entry->FilterConfig));
+
+    limit = (entry->IdType == FDCAN_STANDARD_ID) ? FDCANEX_STD_ID_MAX : FDCANEX_EXT_ID_MAX;
+    if ((entry->IdLow > entry->IdHigh) || (entry->IdHigh > limit) || (entry->MaxPayload > 64U) ||
+        ((entry->FilterConfig != FDCAN_FILTER_TO_RXFIFO0) && (entry->FilterConfig != FDCAN_FILTER_TO_RXFIFO1)))
+    {
+      return HAL_ERROR;
+    }
+    entry->FilterIndex = FDCANEX_NO_RX_BUFFER;
+    entry->RxBufferIndex = FDCANEX_NO_RX_BUFFER;
+  }
+
+  /* Group the identifiers by type, destination and ascending identifier */
+  FDCANEx_SortAccept(pProfile->pAccept, pProfile->AcceptNbr);
+
+  /* Dedicated Rx buffers take the first filter elements of each list so that
+     they win over any merged range covering the same identifier */
+  pFilterSet->RxBuffersNbr = 0U;
+  bufStd = FDCANEx_AssignRxBuffers(pProfile, FDCAN_STANDARD_ID, 0U, pFilterSet);
+  bufExt = FDCANEx_AssignRxBuffers(pProfile, FDCAN_EXTENDED_ID, bufStd, pFilterSet);
+  if ((bufStd > maxStd) || (bufExt > maxExt))
+  {
+    return HAL_ERROR;
+  }
+
+  /* For each list, cover the aligned blocks of identifiers exactly with mask
+     filters, then find the smallest gap between the remaining ranges that has
+     to be bridged for the list to fit its budget and emit them with this gap */
+  pFilterSet->ExtraIds = 0U;
+  for (idType = 0U; idType < 2U; idType++)
+  {
+    uint32_t first = (idType == 0U) ? bufStd : bufExt;
+    uint32_t maxId = (idType == 0U) ? FDCANEX_STD_ID_MAX : FDCANEX_EXT_ID_MAX;
+    uint32_t type = (idType == 0U) ? FDCAN_STANDARD_ID : FDCAN_EXTENDED_ID;
+
+    limit = ((idType == 0U) ? maxStd : maxExt) - first;
+    used = FDCANEx_BuildMasks(pProfile, type, first, limit, pFilterSet);
+
+    /* Give the masks up when the other identifiers no longer fit, even merged */
+    if ((used != 0U) && (FDCANEx_BuildFilters(pProfile, type, maxId, first + used, NULL) > (limit - used)))
+    {
+      for (index = 0U; index < pProfile->AcceptNbr; index++)
+      {
+        entry = &pProfile->pAccept[index];
+        if ((entry->IdType == type) && (entry->RxBufferIndex == FDCANEX_NO_RX_BUFFER))
+        {
+          entry->FilterIndex = FDCANEX_NO_RX_BUFFER;
+        }
+      }
+      used = 0U;
+    }
+    first += used;
+    limit -= used;
+    low = 0U;
+    high = maxId;
+    while (low < high)
+    {
+      mid = low + ((high - low) / 2U);
+      if (FDCANEx_BuildFilters(pProfile, type, mid, first, NULL) <= limit)
+      {
+        high = mid;
+      }
+      else
+      {
+        low = mid + 1U;
+      }
+    }
+
+    used = FDCANEx_BuildFilters(pProfile, type, low, first, pFilterSet);
+    if (used > limit)
+    {
+      return HAL_ERROR;
+    }
+
+    if (idType == 0U)
+    {
+      pFilterSet->StdFiltersNbr = first + used;
+    }
+    else
+    {
+      pFilterSet->ExtFiltersNbr = first + used;
+    }
+  }
+
+  /* Aggregate the traffic profile per destination */
+  for (index = 0U; index < pProfile->AcceptNbr; index++)
+  {
+    entry = &pProfile->pAccept[index];
+    if (entry->RxBufferIndex != FDCANEX_NO_RX_BUFFER)
+    {
+      payload[2] = (entry->MaxPayload > payload[2]) ? entry->MaxPayload : payload[2];
+    }
+    else
+    {
+      used = (entry->FilterConfig == FDCAN_FILTER_TO_RXFIFO0) ? 0U : 1U;
+      rate[used] += entry->Rate;
+      routed[used]++;
+      payload[used] = (entry->MaxPayload > payload[used]) ? entry->MaxPayload : payload[used];
+    }
+  }
+
+  /* Size each Rx FIFO to absorb the frames received during one service interval */
+  for (used = 0U; used < 2U; used++)
+  {
+    depth = 0U;
+    if (routed[used] != 0U)
+    {
+      depth = ((((uint64_t)rate[used] * pProfile->ServiceInterval) + 999999U) / 1000000U) + 1U;
+      if (depth > FDCANEX_MAX_FIFO_ELEMENTS)
+      {
+        depth = FDCANEX_MAX_FIFO_ELEMENTS;
+      }
+    }
+    if (used == 0U)
+    {
+      pFilterSet->RxFifo0ElmtsNbr = (uint32_t)depth;
+      pFilterSet->RxFifo0ElmtSize = FDCANEx_PayloadToDataSize(payload[0]);
+    }
+    else
+    {
+      pFilterSet->RxFifo1ElmtsNbr = (uint32_t)depth;
+      pFilterSet->RxFifo1ElmtSize = FDCANEx_PayloadToDataSize(payload[1]);
+    }
+  }
+  pFilterSet->RxBufferSize = FDCANEx_PayloadToDataSize(payload[2]);
+
+  /* Shrink the deepest FIFO until the layout fits the message RAM budget.
+     Element sizes in FDCAN_data_field_size unit are 32-bit words. */
+  for (;;)
+  {
+    pFilterSet->RamWords = pFilterSet->StdFiltersNbr + (pFilterSet->ExtFiltersNbr * 2U) +
+                           (pFilterSet->RxFifo0ElmtsNbr * pFilterSet->RxFifo0ElmtSize) +
+                           (pFilterSet->RxFifo1ElmtsNbr * pFilterSet->RxFifo1ElmtSize) +
+                           (pFilterSet->RxBuffersNbr * pFilterSet->RxBufferSize);
+    if (pFilterSet->RamWords <= ramWords)
+    {
+      break;
+    }
+
+    if ((pFilterSet->RxFifo0ElmtsNbr >= pFilterSet->RxFifo1ElmtsNbr) && (pFilterSet->RxFifo0ElmtsNbr > 1U))
+    {
+      pFilterSet->RxFifo0ElmtsNbr--;
+    }
+    else if (pFilterSet->RxFifo1ElmtsNbr > 1U)
+    {
+      pFilterSet->RxFifo1ElmtsNbr--;
+    }
+    else
+    {
+      return HAL_ERROR;
+    }
+  }
+
+  HAL_FDCANEx_ResetFilterHits(pFilterSet);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Initialize the FDCAN with the Rx layout and filters of a compiled set.
+  * @note   The Rx related fields of hfdcan->Init are overwritten, the other
+  *         fields must be set by the application as for HAL_FDCAN_Init().
+  *         Non-matching frames are rejected.
+  * @param  hfdcan pointer to an FDCAN_HandleTypeDef structure that contains
+  *         the configuration information for the specified FDCAN.
+  * @param  pFilterSet pointer to a compiled FDCANEx_FilterSetTypeDef structure.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_FDCANEx_InitWithFilterSet(FDCAN_HandleTypeDef *hfdcan, const FDCANEx_FilterSetTypeDef *pFilterSet)
+{
+  HAL_StatusTypeDef status;
+  uint32_t *FilterAddress;
+  uint32_t index;
+
+  if ((hfdcan == NULL) || (pFilterSet == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  hfdcan->Init.StdFiltersNbr = pFilterSet->StdFiltersNbr;
+  hfdcan->Init.ExtFiltersNbr = pFilterSet->ExtFiltersNbr;
+  hfdcan->Init.RxFifo0ElmtsNbr = pFilterSet->RxFifo0ElmtsNbr;
+  hfdcan->Init.RxFifo0ElmtSize = pFilterSet->RxFifo0ElmtSize;
+  hfdcan->Init.RxFifo1ElmtsNbr = pFilterSet->RxFifo1ElmtsNbr;
+  hfdcan->Init.RxFifo1ElmtSize = pFilterSet->RxFifo1ElmtSize;
+  hfdcan->Init.RxBuffersNbr = pFilterSet->RxBuffersNbr;
+  hfdcan->Init.RxBufferSize = pFilterSet->RxBufferSize;
+
+  status = HAL_FDCAN_Init(hfdcan);
+  if (status != HAL_OK)
+  {
+    return status;
+  }
+
+  /* Write all filter elements to the message RAM */
+  FilterAddress = (uint32_t *)hfdcan->msgRam.StandardFilterSA;
+  for (index = 0U; index < pFilterSet->StdFiltersNbr; index++)
+  {
+    FilterAddress[index] = pFilterSet->StdFilters[index];
+  }
+
+  FilterAddress = (uint32_t *)hfdcan->msgRam.ExtendedFilterSA;
+  for (index = 0U; index < (pFilterSet->ExtFiltersNbr * 2U); index++)
+  {
+    FilterAddress[index] = pFilterSet->ExtFilters[index];
+  }
+
+  /* Only the compiled identifiers are accepted */
+  return HAL_FDCAN_ConfigGlobalFilter(hfdcan, FDCAN_REJECT, FDCAN_REJECT, FDCAN_FILTER_REMOTE, FDCAN_FILTER_REMOTE);
+}
+
+/**
+  * @brief  Account a received frame in the filter hit statistics.
+  * @param  pFilterSet pointer to a compiled FDCANEx_FilterSetTypeDef structure.
+  * @param  pRxHeader pointer to the FDCAN_RxHeaderTypeDef of the received frame.
+  * @retval None
+  */
+void HAL_FDCANEx_RecordFilterHit(FDCANEx_FilterSetTypeDef *pFilterSet, const FDCAN_RxHeaderTypeDef *pRxHeader)
+{
+  if (pRxHeader->IsFilterMatchingFrame != 0U)
+  {
+    pFilterSet->NonMatchingHits++;
+  }
+  else if (pRxHeader->IdType == FDCAN_STANDARD_ID)
+  {
+    if (pRxHeader->FilterIndex < FDCANEX_MAX_STD_FILTERS)
+    {
+      pFilterSet->StdHits[pRxHeader->FilterIndex]++;
+    }
+  }
+  else
+  {
+    if (pRxHeader->FilterIndex < FDCANEX_MAX_EXT_FILTERS)
+    {
+      pFilterSet->ExtHits[pRxHeader->FilterIndex]++;
+    }
+  }
+}
+
+/**
+  * @brief  Clear the filter hit statistics.
+  * @param  pFilterSet pointer to a compiled FDCANEx_FilterSetTypeDef structure.
+  * @retval None
+  */
+void HAL_FDCANEx_ResetFilterHits(FDCANEx_FilterSetTypeDef *pFilterSet)
+{
+  uint32_t index;
+
+  for (index = 0U; index < FDCANEX_MAX_STD_FILTERS; index++)
+  {
+    pFilterSet->StdHits[index] = 0U;
+  }
+  for (index = 0U; index < FDCANEX_MAX_EXT_FILTERS; index++)
+  {
+    pFilterSet->ExtHits[index] = 0U;
+  }
+  pFilterSet->NonMatchingHits = 0U;
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup FDCANEx_Exported_Functions_Group2 Bulk reception functions
+  * @brief    Bulk and zero-copy reception functions
+  *
+@verbatim
+  ==============================================================================
+                      ##### Bulk reception functions #####
+  ==============================================================================
+    [..]  This section provides functions allowing to:
+      (+) Copy several frames out of an Rx FIFO with a single acknowledge.
+      (+) Access Rx FIFO elements in place and release them.
+      (+) Decode the header of an Rx element.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Get up to MaxFrames frames from an Rx FIFO.
+  * @note   The Rx FIFO status is read once and all copied elements are
+  *         acknowledged with a single register write.
+  * @param  hfdcan pointer to an FDCAN_HandleTypeDef structure that contains
+  *         the configuration information for the specified FDCAN.
+  * @param  RxFifo Rx FIFO.
+  *         This parameter can be one of the following values:
+  *           @arg FDCAN_RX_FIFO0: Rx FIFO 0
+  *           @arg FDCAN_RX_FIFO1: Rx FIFO 1
+  * @param  pRxHeader pointer to an array of MaxFrames FDCAN_RxHeaderTypeDef structures.
+  * @param  pRxData pointer to the buffer where the payloads are stored, frame n
+  *         payload starting at pRxData + (n * DataStride).
+  * @param  DataStride distance in bytes between two payloads, at least the
+  *         largest payload configured for the Rx FIFO.
+  * @param  MaxFrames maximum number of frames to read.
+  * @param  pFramesNbr pointer to the number of frames read.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_FDCANEx_GetRxMessages(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, FDCAN_RxHeaderTypeDef *pRxHeader,
+                                            uint8_t *pRxData, uint32_t DataStride, uint32_t MaxFrames, uint32_t *pFramesNbr)
+{
+  FDCANEx_RxFifoTypeDef fifo;
+  const uint32_t *RxAddress;
+  const uint8_t *pData;
+  uint8_t *pDest;
+  uint32_t ByteCounter;
+  uint32_t DataLength;
+  uint32_t index;
+  uint32_t count;
+
+  /* Check function parameters */
+  assert_param(IS_FDCAN_RX_FIFO(RxFifo));
+
+  *pFramesNbr = 0U;
+
+  if (FDCANEx_GetRxFifo(hfdcan, RxFifo, &fifo) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+
+  count = (fifo.FillLevel < MaxFrames) ? fifo.FillLevel : MaxFrames;
+  index = fifo.GetIndex;
+  pDest = pRxData;
+
+  for (; *pFramesNbr < count; (*pFramesNbr)++)
+  {
+    RxAddress = fifo.pBase + (index * fifo.ElmtWords);
+    HAL_FDCANEx_DecodeRxHeader(RxAddress, &pRxHeader[*pFramesNbr]);
+
+    /* Retrieve Rx payload */
+    pData = (const uint8_t *)&RxAddress[2U];
+    DataLength = FDCANEx_DLCtoBytes[pRxHeader[*pFramesNbr].DataLength >> 16];
+    for (ByteCounter = 0U; ByteCounter < DataLength; ByteCounter++)
+    {
+      pDest[ByteCounter] = pData[ByteCounter];
+    }
+    pDest += DataStride;
+
+    index++;
+    if (index == fifo.ElmtsNbr)
+    {
+      index = 0U;
+    }
+  }
+
+  if (count != 0U)
+  {
+    FDCANEx_AcknowledgeRxFifo(hfdcan, RxFifo, &fifo, count);
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Get pointers to the oldest elements of an Rx FIFO without copying them.
+  * @note   The elements are not acknowledged and remain valid until
+  *         HAL_FDCANEx_ReleaseRxElements() is called. The Rx FIFO must be
+  *         configured in blocking mode.
+  * @param  hfdcan pointer to an FDCAN_HandleTypeDef structure that contains
+  *         the configuration information for the specified FDCAN.
+  * @param  RxFifo Rx FIFO.
+  *         This parameter can be one of the following values:
+  *           @arg FDCAN_RX_FIFO0: Rx FIFO 0
+  *           @arg FDCAN_RX_FIFO1: Rx FIFO 1
+  * @param  pElements pointer to an array of MaxFrames element pointers.
+  * @param  MaxFrames maximum number of elements to return.
+  * @param  pFramesNbr pointer to the number of elements returned.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_FDCANEx_AcquireRxElements(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, const uint32_t **pElements,
+                                                uint32_t MaxFrames, uint32_t *pFramesNbr)
+{
+  FDCANEx_RxFifoTypeDef fifo;
+  uint32_t overwrite;
+  uint32_t index;
+  uint32_t count;
+
+  /* Check function parameters */
+  assert_param(IS_FDCAN_RX_FIFO(RxFifo));
+
+  *pFramesNbr = 0U;
+
+  /* In overwrite mode the hardware may reuse an element while it is parsed */
+  if (RxFifo == FDCAN_RX_FIFO0)
+  {
+    overwrite = hfdcan->Instance->RXF0C & FDCAN_RXF0C_F0OM;
+  }
+  else
+  {
+    overwrite = hfdcan->Instance->RXF1C & FDCAN_RXF1C_F1OM;
+  }
+  if (overwrite == FDCAN_RX_FIFO_OVERWRITE)
+  {
+    /* Update error code */
+    hfdcan->ErrorCode |= HAL_FDCAN_ERROR_PARAM;
+
+    return HAL_ERROR;
+  }
+
+  if (FDCANEx_GetRxFifo(hfdcan, RxFifo, &fifo) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+
+  count = (fifo.FillLevel < MaxFrames) ? fifo.FillLevel : MaxFrames;
+  index = fifo.GetIndex;
+
+  for (; *pFramesNbr < count; (*pFramesNbr)++)
+  {
+    pElements[*pFramesNbr] = fifo.pBase + (index * fifo.ElmtWords);
+
+    index++;
+    if (index == fifo.ElmtsNbr)
+    {
+      index = 0U;
+    }
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Release the oldest elements of an Rx FIFO.
+  * @param  hfdcan pointer to an FDCAN_HandleTypeDef structure that contains
+  *         the configuration information for the specified FDCAN.
+  * @param  RxFifo Rx FIFO.
+  *         This parameter can be one of the following values:
+  *           @arg FDCAN_RX_FIFO0: Rx FIFO 0
+  *           @arg FDCAN_RX_FIFO1: Rx FIFO 1
+  * @param  FramesNbr number of elements to release, at most the number
+  *         returned by HAL_FDCANEx_AcquireRxElements().
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_FDCANEx_ReleaseRxElements(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, uint32_t FramesNbr)
+{
+  FDCANEx_RxFifoTypeDef fifo;
+
+  /* Check function parameters */
+  assert_param(IS_FDCAN_RX_FIFO(RxFifo));
+
+  if (FramesNbr == 0U)
+  {
+    return HAL_OK;
+  }
+
+  if (FDCANEx_GetRxFifo(hfdcan, RxFifo, &fifo) != HAL_OK)
+  {
+    return HAL_ERROR;
+  }
+
+  if (FramesNbr > fifo.FillLevel)
+  {
+    /* Update error code */
+    hfdcan->ErrorCode |= HAL_FDCAN_ERROR_PARAM;
+
+    return HAL_ERROR;
+  }
+
+  FDCANEx_AcknowledgeRxFifo(hfdcan, RxFifo, &fifo, FramesNbr);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Decode the header of an Rx element.
+  * @param  pElement pointer to the Rx element in message RAM.
+  * @param  pRxHeader pointer to a FDCAN_RxHeaderTypeDef structure.
+  * @retval None
+  */
+void HAL_FDCANEx_DecodeRxHeader(const uint32_t *pElement, FDCAN_RxHeaderTypeDef *pRxHeader)
+{
+  uint32_t R0 = pElement[0];
+  uint32_t R1 = pElement[1];
+
+  pRxHeader->IdType = R0 & FDCANEX_ELEMENT_MASK_XTD;
+  if (pRxHeader->IdType == FDCAN_STANDARD_ID)
+  {
+    pRxHeader->Identifier = ((R0 & FDCANEX_ELEMENT_MASK_STDID) >> 18U);
+  }
+  else
+  {
+    pRxHeader->Identifier = (R0 & FDCANEX_ELEMENT_MASK_EXTID);
+  }
+  pRxHeader->RxFrameType = (R0 & FDCANEX_ELEMENT_MASK_RTR);
+  pRxHeader->ErrorStateIndicator = (R0 & FDCANEX_ELEMENT_MASK_ESI);
+  pRxHeader->RxTimestamp = (R1 & FDCANEX_ELEMENT_MASK_TS);
+  pRxHeader->DataLength = (R1 & FDCANEX_ELEMENT_MASK_DLC);
+  pRxHeader->BitRateSwitch = (R1 & FDCANEX_ELEMENT_MASK_BRS);
+  pRxHeader->FDFormat = (R1 & FDCANEX_ELEMENT_MASK_FDF);
+  pRxHeader->FilterIndex = ((R1 & FDCANEX_ELEMENT_MASK_FIDX) >> 24U);
+  pRxHeader->IsFilterMatchingFrame = ((R1 & FDCANEX_ELEMENT_MASK_ANMF) >> 31U);
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup FDCANEx_Exported_Functions_Group3 Software Tx queue functions
+  * @brief    Priority-aware software Tx queue functions
+  *
+@verbatim
+  ==============================================================================
+                    ##### Software Tx queue functions #####
+  ==============================================================================
+    [..]  This section provides functions allowing to:
+      (+) Queue frames in software, ordered by CAN arbitration priority.
+      (+) Keep the hardware Tx FIFO/Queue filled with the highest priority frames.
+      (+) Cancel or replace queued frames.
+      (+) Report queueing latency statistics.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize a software Tx queue.
+  * @param  hqueue pointer to the FDCANEx_TxQueueTypeDef structure to initialize.
+  * @param  hfdcan pointer to an FDCAN_HandleTypeDef structure that contains
+  *         the configuration information for the specified FDCAN. A Tx
+  *         FIFO/Queue must be allocated.
+  * @param  pFrames pointer to the frame storage array, bounding the number of
+  *         frames that can be queued at once.
+  * @param  FramesNbr number of elements in pFrames.
+  * @param  GetTime pointer to the function returning the current time used for
+  *         latency statistics, or NULL to use HAL_GetTick().
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_FDCANEx_TxQueueInit(FDCANEx_TxQueueTypeDef *hqueue, FDCAN_HandleTypeDef *hfdcan,
+                                          FDCANEx_TxFrameTypeDef *pFrames, uint32_t FramesNbr, uint32_t (*GetTime)(void))
+{
+  uint32_t index;
+
+  if ((hqueue == NULL) || (hfdcan == NULL) || (pFrames == NULL) || (FramesNbr == 0U) ||
+      (hfdcan->Init.TxFifoQueueElmtsNbr == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  hqueue->hfdcan = hfdcan;
+  hqueue->pPending = NULL;
+  hqueue->pFree = NULL;
+  hqueue->HwFrames = 0U;
+  hqueue->PendingFrames = 0U;
+  hqueue->GetTime = (GetTime != NULL) ? GetTime : HAL_GetTick;
+
+  for (index = 0U; index < 32U; index++)
+  {
+    hqueue->pHw[index] = NULL;
+  }
+
+  for (index = FramesNbr; index > 0U; index--)
+  {
+    pFrames[index - 1U].pNext = hqueue->pFree;
+    pFrames[index - 1U].State = FDCANEX_TX_FRAME_FREE;
+    pFrames[index - 1U].Flags = 0U;
+    hqueue->pFree = &pFrames[index - 1U];
+  }
+
+  HAL_FDCANEx_TxQueueResetStats(hqueue);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Add a frame to the software Tx queue.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @param  pTxHeader pointer to a FDCAN_TxHeaderTypeDef structure.
+  * @param  pTxData pointer to the frame payload.
+  * @retval HAL status, HAL_ERROR when no frame storage is left
+  */
+HAL_StatusTypeDef HAL_FDCANEx_TxQueueAdd(FDCANEx_TxQueueTypeDef *hqueue, const FDCAN_TxHeaderTypeDef *pTxHeader,
+                                         const uint8_t *pTxData)
+{
+  FDCANEx_TxFrameTypeDef *frame;
+  uint32_t primask;
+
+  FDCANEX_ENTER_CRITICAL(primask);
+
+  frame = hqueue->pFree;
+  if (frame == NULL)
+  {
+    hqueue->Stats.Overflows++;
+    FDCANEX_EXIT_CRITICAL(primask);
+
+    return HAL_ERROR;
+  }
+  hqueue->pFree = frame->pNext;
+
+  FDCANEx_TxCopy(frame, pTxHeader, pTxData);
+  frame->QueueTime = hqueue->GetTime();
+  frame->Flags = 0U;
+  FDCANEx_TxInsert(hqueue, frame, 0U);
+  hqueue->Stats.Queued++;
+
+  FDCANEx_TxSchedule(hqueue);
+
+  FDCANEX_EXIT_CRITICAL(primask);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Replace the content of a queued frame with the same identifier.
+  * @note   A frame already in a hardware buffer is aborted and queued again
+  *         with the new content. If no frame with this identifier is queued,
+  *         the frame is added.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @param  pTxHeader pointer to a FDCAN_TxHeaderTypeDef structure.
+  * @param  pTxData pointer to the frame payload.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_FDCANEx_TxQueueReplace(FDCANEx_TxQueueTypeDef *hqueue, const FDCAN_TxHeaderTypeDef *pTxHeader,
+                                             const uint8_t *pTxData)
+{
+  FDCANEx_TxFrameTypeDef *frame;
+  uint32_t primask;
+  uint32_t index;
+
+  FDCANEX_ENTER_CRITICAL(primask);
+
+  /* Look for a waiting frame first */
+  for (frame = hqueue->pPending; frame != NULL; frame = frame->pNext)
+  {
+    if ((frame->Header.IdType == pTxHeader->IdType) && (frame->Header.Identifier == pTxHeader->Identifier))
+    {
+      FDCANEx_TxCopy(frame, pTxHeader, pTxData);
+      hqueue->Stats.Replaced++;
+      FDCANEX_EXIT_CRITICAL(primask);
+
+      return HAL_OK;
+    }
+  }
+
+  /* Then for a frame held by the hardware */
+  for (index = 0U; index < 32U; index++)
+  {
+    frame = hqueue->pHw[index];
+    if ((frame != NULL) && ((frame->Flags & FDCANEX_TX_FLAG_CANCEL) == 0U) &&
+        (frame->Header.IdType == pTxHeader->IdType) && (frame->Header.Identifier == pTxHeader->Identifier))
+    {
+      FDCANEx_TxCopy(frame, pTxHeader, pTxData);
+      frame->QueueTime = hqueue->GetTime();
+      frame->Flags |= FDCANEX_TX_FLAG_REPLACE;
+      if (frame->State == FDCANEX_TX_FRAME_HW)
+      {
+        frame->State = FDCANEX_TX_FRAME_CANCELLING;
+        (void)HAL_FDCAN_AbortTxRequest(hqueue->hfdcan, ((uint32_t)1 << index));
+      }
+      hqueue->Stats.Replaced++;
+      FDCANEX_EXIT_CRITICAL(primask);
+
+      return HAL_OK;
+    }
+  }
+
+  FDCANEX_EXIT_CRITICAL(primask);
+
+  return HAL_FDCANEx_TxQueueAdd(hqueue, pTxHeader, pTxData);
+}
+
+/**
+  * @brief  Cancel the queued frames with a given identifier.
+  * @note   Frames held by the hardware are aborted; a frame whose transmission
+  *         already started may still be sent.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @param  IdType identifier type, a value of @ref FDCAN_id_type.
+  * @param  Identifier frame identifier.
+  * @retval HAL status, HAL_ERROR when no frame with this identifier is queued
+  */
+HAL_StatusTypeDef HAL_FDCANEx_TxQueueCancel(FDCANEx_TxQueueTypeDef *hqueue, uint32_t IdType, uint32_t Identifier)
+{
+  FDCANEx_TxFrameTypeDef **link;
+  FDCANEx_TxFrameTypeDef *frame;
+  uint32_t primask;
+  uint32_t index;
+  uint32_t found = 0U;
+
+  FDCANEX_ENTER_CRITICAL(primask);
+
+  link = &hqueue->pPending;
+  while (*link != NULL)
+  {
+    frame = *link;
+    if ((frame->Header.IdType == IdType) && (frame->Header.Identifier == Identifier))
+    {
+      *link = frame->pNext;
+      hqueue->PendingFrames--;
+      FDCANEx_TxRelease(hqueue, frame);
+      hqueue->Stats.Cancelled++;
+      found++;
+    }
+    else
+    {
+      link = &frame->pNext;
+    }
+  }
+
+  for (index = 0U; index < 32U; index++)
+  {
+    frame = hqueue->pHw[index];
+    if ((frame != NULL) && (frame->Header.IdType == IdType) && (frame->Header.Identifier == Identifier))
+    {
+      frame->Flags = FDCANEX_TX_FLAG_CANCEL;
+      if (frame->State == FDCANEX_TX_FRAME_HW)
+      {
+        frame->State = FDCANEX_TX_FRAME_CANCELLING;
+        (void)HAL_FDCAN_AbortTxRequest(hqueue->hfdcan, ((uint32_t)1 << index));
+      }
+      found++;
+    }
+  }
+
+  FDCANEX_EXIT_CRITICAL(primask);
+
+  return (found != 0U) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+  * @brief  Retire the completed hardware requests and refill the hardware.
+  * @note   To be called from HAL_FDCAN_TxBufferCompleteCallback(),
+  *         HAL_FDCAN_TxBufferAbortCallback() and HAL_FDCAN_TxFifoEmptyCallback().
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @retval None
+  */
+void HAL_FDCANEx_TxQueueProcess(FDCANEx_TxQueueTypeDef *hqueue)
+{
+  uint32_t primask;
+
+  FDCANEX_ENTER_CRITICAL(primask);
+  FDCANEx_TxSchedule(hqueue);
+  FDCANEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @brief  Return the number of frames queued, in software and in hardware.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @retval Number of frames not yet transmitted or cancelled
+  */
+uint32_t HAL_FDCANEx_TxQueueGetLevel(const FDCANEx_TxQueueTypeDef *hqueue)
+{
+  return hqueue->PendingFrames + hqueue->HwFrames;
+}
+
+/**
+  * @brief  Get the software Tx queue statistics.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @param  pStats pointer to the FDCANEx_TxQueueStatsTypeDef structure to fill.
+  * @retval None
+  */
+void HAL_FDCANEx_TxQueueGetStats(const FDCANEx_TxQueueTypeDef *hqueue, FDCANEx_TxQueueStatsTypeDef *pStats)
+{
+  uint32_t primask;
+
+  FDCANEX_ENTER_CRITICAL(primask);
+  *pStats = hqueue->Stats;
+  FDCANEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @brief  Clear the software Tx queue statistics.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @retval None
+  */
+void HAL_FDCANEx_TxQueueResetStats(FDCANEx_TxQueueTypeDef *hqueue)
+{
+  uint32_t primask;
+
+  FDCANEX_ENTER_CRITICAL(primask);
+  hqueue->Stats.Queued = 0U;
+  hqueue->Stats.Sent = 0U;
+  hqueue->Stats.Cancelled = 0U;
+  hqueue->Stats.Replaced = 0U;
+  hqueue->Stats.Preempted = 0U;
+  hqueue->Stats.Overflows = 0U;
+  hqueue->Stats.PendingMax = hqueue->PendingFrames;
+  hqueue->Stats.LatencyMin = 0xFFFFFFFFU;
+  hqueue->Stats.LatencyMax = 0U;
+  hqueue->Stats.LatencyTotal = 0U;
+  FDCANEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup FDCANEx_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Sort accepted identifiers by type, destination and first identifier.
+  * @param  pAccept pointer to the accepted identifier array.
+  * @param  AcceptNbr number of entries.
+  * @retval None
+  */
+static void FDCANEx_SortAccept(FDCANEx_AcceptTypeDef *pAccept, uint32_t AcceptNbr)
+{
+  FDCANEx_AcceptTypeDef key;
+  uint32_t index;
+  uint32_t pos;
+
+  /* Insertion sort: run once at init, no dynamic memory */
+  for (index = 1U; index < AcceptNbr; index++)
+  {
+    key = pAccept[index];
+    pos = index;
+    while ((pos > 0U) &&
+           ((pAccept[pos - 1U].IdType > key.IdType) ||
+            ((pAccept[pos - 1U].IdType == key.IdType) &&
+             ((pAccept[pos - 1U].FilterConfig > key.FilterConfig) ||
+              ((pAccept[pos - 1U].FilterConfig == key.FilterConfig) && (pAccept[pos - 1U].IdLow > key.IdLow))))))
+    {
+      pAccept[pos] = pAccept[pos - 1U];
+      pos--;
+    }
+    pAccept[pos] = key;
+  }
+}
+
+/**
+  * @brief  Route the highest-rate single identifiers of a type to Rx buffers.
+  * @param  pProfile pointer to the traffic profile.
+  * @param  IdType identifier type, a value of @ref FDCAN_id_type.
+  * @param  FirstIndex first Rx buffer index available.
+  * @param  pFilterSet pointer to the compiled filter set.
+  * @retval Number of filter elements used.
+  */
+static uint32_t FDCANEx_AssignRxBuffers(const FDCANEx_FilterProfileTypeDef *pProfile, uint32_t IdType,
+                                        uint32_t FirstIndex, FDCANEx_FilterSetTypeDef *pFilterSet)
+{
+  FDCANEx_AcceptTypeDef *entry;
+  uint32_t count = 0U;
+  uint32_t best;
+  uint32_t index;
+
+  if (pProfile->RxBufferRateThreshold == 0U)
+  {
+    return 0U;
+  }
+
+  while ((FirstIndex + count) < pProfile->MaxRxBuffers)
+  {
+    /* Pick the remaining single identifier with the highest rate */
+    best = FDCANEX_NO_ID;
+    for (index = 0U; index < pProfile->AcceptNbr; index++)
+    {
+      entry = &pProfile->pAccept[index];
+      if ((entry->IdType == IdType) && (entry->IdLow == entry->IdHigh) &&
+          (entry->RxBufferIndex == FDCANEX_NO_RX_BUFFER) && (entry->Rate >= pProfile->RxBufferRateThreshold) &&
+          ((best == FDCANEX_NO_ID) || (entry->Rate > pProfile->pAccept[best].Rate)))
+      {
+        best = index;
+      }
+    }
+
+    if (best == FDCANEX_NO_ID)
+    {
+      break;
+    }
+
+    entry = &pProfile->pAccept[best];
+    entry->RxBufferIndex = FirstIndex + count;
+    entry->FilterIndex = count;
+    FDCANEx_WriteFilter(pFilterSet, IdType, count, 0U, FDCAN_FILTER_TO_RXBUFFER, entry->IdLow, entry->RxBufferIndex);
+    count++;
+  }
+
+  pFilterSet->RxBuffersNbr = FirstIndex + count;
+
+  return count;
+}
+
+/**
+  * @brief  Cover the aligned blocks of FIFO routed identifiers of a type with mask filters.
+  * @note   A classic mask filter accepts the identifiers equal to its base on
+  *         the bits set in its mask. From each single identifier or aligned
+  *         power-of-2 range, the block is doubled bit by bit, lowest first, as
+  *         long as it is exactly made of requested identifiers of the same
+  *         destination. A block is only emitted when it replaces more than
+  *         one range or dual ID filter.
+  * @param  pProfile pointer to the traffic profile, sorted.
+  * @param  IdType identifier type, a value of @ref FDCAN_id_type.
+  * @param  FirstIndex first filter element available.
+  * @param  Limit number of filter elements available.
+  * @param  pFilterSet pointer to the compiled filter set.
+  * @retval Number of filter elements used.
+  */
+static uint32_t FDCANEx_BuildMasks(FDCANEx_FilterProfileTypeDef *pProfile, uint32_t IdType, uint32_t FirstIndex,
+                                   uint32_t Limit, FDCANEx_FilterSetTypeDef *pFilterSet)
+{
+  const FDCANEx_AcceptTypeDef *seed;
+  uint32_t maxId = (IdType == FDCAN_STANDARD_ID) ? FDCANEX_STD_ID_MAX : FDCANEX_EXT_ID_MAX;
+  uint32_t count = 0U;
+  uint32_t base;
+  uint32_t free;
+  uint32_t bit;
+  uint32_t entries;
+  uint32_t singles = 0U;
+  uint32_t grown;
+  uint32_t grownSingles;
+  uint32_t index;
+
+  for (index = 0U; (index < pProfile->AcceptNbr) && (count < Limit); index++)
+  {
+    seed = &pProfile->pAccept[index];
+    free = seed->IdHigh - seed->IdLow;
+    if ((seed->IdType != IdType) || (seed->FilterIndex != FDCANEX_NO_RX_BUFFER) ||
+        ((free & (free + 1U)) != 0U) || ((seed->IdLow & free) != 0U))
+    {
+      continue;
+    }
+
+    /* Grow the block from the seed while it stays fully requested */
+    base = seed->IdLow;
+    entries = 1U;
+    for (bit = 1U; bit <= maxId; bit <<= 1U)
+    {
+      if ((free & bit) != 0U)
+      {
+        continue;
+      }
+      grown = FDCANEx_MatchMask(pProfile, IdType, seed->FilterConfig, base & ~bit, free | bit,
+                                FDCANEX_NO_RX_BUFFER, &grownSingles);
+      if (grown != 0U)
+      {
+        base &= ~bit;
+        free |= bit;
+        entries = grown;
+        singles = grownSingles;
+      }
+    }
+
+    /* Two single identifiers take one dual ID filter anyway */
+    if ((entries > 2U) || ((entries == 2U) && (singles < 2U)))
+    {
+      FDCANEx_WriteFilter(pFilterSet, IdType, FirstIndex + count, FDCAN_FILTER_MASK, seed->FilterConfig, base,
+                          maxId & ~free);
+      (void)FDCANEx_MatchMask(pProfile, IdType, seed->FilterConfig, base, free, FirstIndex + count, &grownSingles);
+      count++;
+    }
+  }
+
+  return count;
+}
+
+/**
+  * @brief  Match the FIFO routed entries of a type lying in a block of identifiers.
+  * @note   Only the single identifiers and aligned power-of-2 ranges are
+  *         considered, any other range is left to the range filters.
+  * @param  pProfile pointer to the traffic profile, sorted.
+  * @param  IdType identifier type, a value of @ref FDCAN_id_type.
+  * @param  FilterConfig destination of the block.
+  * @param  Base first identifier of the block, with the Free bits cleared.
+  * @param  Free identifier bits varying in the block.
+  * @param  FilterIndex filter element covering the block assigned to the
+  *         entries, or FDCANEX_NO_RX_BUFFER to only match.
+  * @param  pSingles pointer to the number of single identifier entries.
+  * @retval Number of entries making the whole block, 0 if some identifiers of
+  *         the block are not requested or requested twice.
+  */
+static uint32_t FDCANEx_MatchMask(FDCANEx_FilterProfileTypeDef *pProfile, uint32_t IdType, uint32_t FilterConfig,
+                                  uint32_t Base, uint32_t Free, uint32_t FilterIndex, uint32_t *pSingles)
+{
+  FDCANEx_AcceptTypeDef *entry;
+  uint32_t covered = 0U;
+  uint32_t entries = 0U;
+  uint32_t next = 0U;
+  uint32_t size;
+  uint32_t index;
+
+  *pSingles = 0U;
+  for (index = 0U; index < pProfile->AcceptNbr; index++)
+  {
+    entry = &pProfile->pAccept[index];
+    size = entry->IdHigh - entry->IdLow;
+    if ((entry->IdType != IdType) || (entry->FilterConfig != FilterConfig) ||
+        (entry->FilterIndex != FDCANEX_NO_RX_BUFFER) || ((entry->IdLow & ~Free) != Base) ||
+        ((size & (size + 1U)) != 0U) || ((entry->IdLow & size) != 0U) || ((size & ~Free) != 0U))
+    {
+      continue;
+    }
+
+    /* The entries are sorted: an overlap shows as a start below the end of the previous one */
+    if ((entries != 0U) && (entry->IdLow < next))
+    {
+      return 0U;
+    }
+    next = entry->IdHigh + 1U;
+    covered += size + 1U;
+    entries++;
+    *pSingles += (size == 0U) ? 1U : 0U;
+
+    if (FilterIndex != FDCANEX_NO_RX_BUFFER)
+    {
+      entry->FilterIndex = FilterIndex;
+    }
+  }
+
+  /* 2^n identifiers are in the block, n the number of Free bits */
+  size = 1U;
+  for (index = Free; index != 0U; index &= (index - 1U))
+  {
+    size <<= 1U;
+  }
+
+  return (covered == size) ? entries : 0U;
+}
+
+/**
+  * @brief  Merge the FIFO routed identifiers of a type into filter elements.
+  * @note   Ranges of the same destination closer than Gap identifiers are merged,
+  *         single identifiers are packed by pairs into dual ID filters. The
+  *         entries already covered by a filter below FirstIndex are skipped.
+  * @param  pProfile pointer to the traffic profile, sorted.
+  * @param  IdType identifier type, a value of @ref FDCAN_id_type.
+  * @param  Gap largest number of non-requested identifiers bridged between ranges.
+  * @param  FirstIndex first filter element available.
+  * @param  pFilterSet pointer to the compiled filter set, or NULL to only count.
+  * @retval Number of filter elements needed.
+  */
+static uint32_t FDCANEx_BuildFilters(const FDCANEx_FilterProfileTypeDef *pProfile, uint32_t IdType,
+                                     uint32_t Gap, uint32_t FirstIndex, FDCANEx_FilterSetTypeDef *pFilterSet)
+{
+  FDCANEx_AcceptTypeDef *entry;
+  uint32_t count = 0U;
+  uint32_t extra = 0U;
+  uint32_t curLow = FDCANEX_NO_ID;
+  uint32_t curHigh = 0U;
+  uint32_t curConfig = 0U;
+  uint32_t curFirst = 0U;
+  uint32_t pendingId = FDCANEX_NO_ID;
+  uint32_t pendingConfig = 0U;
+  uint32_t pendingFirst = 0U;
+  uint32_t pendingLast = 0U;
+  uint32_t index;
+  uint32_t scan;
+  uint32_t filterIndex;
+
+  for (index = 0U; index <= pProfile->AcceptNbr; index++)
+  {
+    entry = (index < pProfile->AcceptNbr) ? &pProfile->pAccept[index] : NULL;
+
+    if ((entry != NULL) && ((entry->IdType != IdType) || (entry->FilterIndex < FirstIndex)))
+    {
+      continue;
+    }
+
+    /* Extend the current interval with an overlapping or close enough range */
+    if ((entry != NULL) && (curLow != FDCANEX_NO_ID) && (entry->FilterConfig == curConfig) &&
+        (entry->IdLow <= (curHigh + 1U + Gap)))
+    {
+      if (entry->IdLow > (curHigh + 1U))
+      {
+        extra += entry->IdLow - curHigh - 1U;
+      }
+      curHigh = (entry->IdHigh > curHigh) ? entry->IdHigh : curHigh;
+      continue;
+    }
+
+    /* Close the current interval */
+    if (curLow != FDCANEX_NO_ID)
+    {
+      if (curLow != curHigh)
+      {
+        filterIndex = FirstIndex + count;
+        count++;
+        if (pFilterSet != NULL)
+        {
+          FDCANEx_WriteFilter(pFilterSet, IdType, filterIndex, FDCAN_FILTER_RANGE, curConfig, curLow, curHigh);
+          for (scan = curFirst; scan < index; scan++)
+          {
+            if ((pProfile->pAccept[scan].IdType == IdType) &&
+                (pProfile->pAccept[scan].FilterIndex >= FirstIndex))
+            {
+              pProfile->pAccept[scan].FilterIndex = filterIndex;
+            }
+          }
+        }
+      }
+      else if ((pendingId != FDCANEX_NO_ID) && (pendingConfig == curConfig))
+      {
+        /* Pair with the pending single identifier */
+        filterIndex = FirstIndex + count;
+        count++;
+        if (pFilterSet != NULL)
+        {
+          FDCANEx_WriteFilter(pFilterSet, IdType, filterIndex, FDCAN_FILTER_DUAL, curConfig, pendingId, curLow);
+          for (scan = pendingFirst; scan < index; scan++)
+          {
+            if ((pProfile->pAccept[scan].IdType == IdType) &&
+                (pProfile->pAccept[scan].FilterIndex >= FirstIndex) &&
+                ((scan <= pendingLast) || (scan >= curFirst)))
+            {
+              pProfile->pAccept[scan].FilterIndex = filterIndex;
+            }
+          }
+        }
+        pendingId = FDCANEX_NO_ID;
+      }
+      else
+      {
+        if (pendingId != FDCANEX_NO_ID)
+        {
+          /* Destination changed: the pending identifier gets its own element */
+          filterIndex = FirstIndex + count;
+          count++;
+          if (pFilterSet != NULL)
+          {
+            FDCANEx_WriteFilter(pFilterSet, IdType, filterIndex, FDCAN_FILTER_DUAL, pendingConfig, pendingId, pendingId);
+            for (scan = pendingFirst; scan <= pendingLast; scan++)
+            {
+              if ((pProfile->pAccept[scan].IdType == IdType) &&
+                  (pProfile->pAccept[scan].FilterIndex >= FirstIndex))
+              {
+                pProfile->pAccept[scan].FilterIndex = filterIndex;
+              }
+            }
+          }
+        }
+        pendingId = curLow;
+        pendingConfig = curConfig;
+        pendingFirst = curFirst;
+        pendingLast = index - 1U;
+      }
+    }
+
+    if (entry == NULL)
+    {
+      break;
+    }
+
+    /* Open a new interval */
+    curLow = entry->IdLow;
+    curHigh = entry->IdHigh;
+    curConfig = entry->FilterConfig;
+    curFirst = index;
+  }
+
+  /* Flush the last unpaired single identifier */
+  if (pendingId != FDCANEX_NO_ID)
+  {
+    filterIndex = FirstIndex + count;
+    count++;
+    if (pFilterSet != NULL)
+    {
+      FDCANEx_WriteFilter(pFilterSet, IdType, filterIndex, FDCAN_FILTER_DUAL, pendingConfig, pendingId, pendingId);
+      for (scan = pendingFirst; scan <= pendingLast; scan++)
+      {
+        if ((pProfile->pAccept[scan].IdType == IdType) &&
+            (pProfile->pAccept[scan].FilterIndex >= FirstIndex))
+        {
+          pProfile->pAccept[scan].FilterIndex = filterIndex;
+        }
+      }
+    }
+  }
+
+  if (pFilterSet != NULL)
+  {
+    pFilterSet->ExtraIds += extra;
+  }
+
+  return count;
+}
+
+/**
+  * @brief  Encode a filter element into the compiled set.
+  * @param  pFilterSet pointer to the compiled filter set.
+  * @param  IdType identifier type, a value of @ref FDCAN_id_type.
+  * @param  Index filter element index.
+  * @param  FilterType a value of @ref FDCAN_filter_type.
+  * @param  FilterConfig a value of @ref FDCAN_filter_config.
+  * @param  Id1 filter identification 1.
+  * @param  Id2 filter identification 2, or Rx buffer index for FDCAN_FILTER_TO_RXBUFFER.
+  * @retval None
+  */
+static void FDCANEx_WriteFilter(FDCANEx_FilterSetTypeDef *pFilterSet, uint32_t IdType, uint32_t Index,
+                                uint32_t FilterType, uint32_t FilterConfig, uint32_t Id1, uint32_t Id2)
+{
+  if (IdType == FDCAN_STANDARD_ID)
+  {
+    if (Index < FDCANEX_MAX_STD_FILTERS)
+    {
+      /* Same encoding as HAL_FDCAN_ConfigFilter() */
+      if (FilterConfig == FDCAN_FILTER_TO_RXBUFFER)
+      {
+        pFilterSet->StdFilters[Index] = ((FDCAN_FILTER_TO_RXBUFFER << 27U) | (Id1 << 16U) | Id2);
+      }
+      else
+      {
+        pFilterSet->StdFilters[Index] = ((FilterType << 30U) | (FilterConfig << 27U) | (Id1 << 16U) | Id2);
+      }
+    }
+  }
+  else
+  {
+    if (Index < FDCANEX_MAX_EXT_FILTERS)
+    {
+      pFilterSet->ExtFilters[Index * 2U] = ((FilterConfig << 29U) | Id1);
+      if (FilterConfig == FDCAN_FILTER_TO_RXBUFFER)
+      {
+        pFilterSet->ExtFilters[(Index * 2U) + 1U] = Id2;
+      }
+      else
+      {
+        pFilterSet->ExtFilters[(Index * 2U) + 1U] = ((FilterType << 30U) | Id2);
+      }
+    }
+  }
+}
+
+/**
+  * @brief  Return the smallest element data field holding a payload.
+  * @param  Payload payload size in bytes.
+  * @retval a value of @ref FDCAN_data_field_size
+  */
+static uint32_t FDCANEx_PayloadToDataSize(uint32_t Payload)
+{
+  uint32_t size;
+
+  if (Payload <= 8U)
+  {
+    size = FDCAN_DATA_BYTES_8;
+  }
+  else if (Payload <= 12U)
+  {
+    size = FDCAN_DATA_BYTES_12;
+  }
+  else if (Payload <= 16U)
+  {
+    size = FDCAN_DATA_BYTES_16;
+  }
+  else if (Payload <= 20U)
+  {
+    size = FDCAN_DATA_BYTES_20;
+  }
+  else if (Payload <= 24U)
+  {
+    size = FDCAN_DATA_BYTES_24;
+  }
+  else if (Payload <= 32U)
+  {
+    size = FDCAN_DATA_BYTES_32;
+  }
+  else if (Payload <= 48U)
+  {
+    size = FDCAN_DATA_BYTES_48;
+  }
+  else
+  {
+    size = FDCAN_DATA_BYTES_64;
+  }
+
+  return size;
+}
+
+/**
+  * @brief  Read the Rx FIFO status once and locate its oldest element.
+  * @param  hfdcan pointer to an FDCAN_HandleTypeDef structure that contains
+  *         the configuration information for the specified FDCAN.
+  * @param  RxFifo Rx FIFO, FDCAN_RX_FIFO0 or FDCAN_RX_FIFO1.
+  * @param  pFifo pointer to the Rx FIFO view to fill.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef FDCANEx_GetRxFifo(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, FDCANEx_RxFifoTypeDef *pFifo)
+{
+  uint32_t status;
+  uint32_t config;
+
+  if (hfdcan->State != HAL_FDCAN_STATE_BUSY)
+  {
+    /* Update error code */
+    hfdcan->ErrorCode |= HAL_FDCAN_ERROR_NOT_STARTED;
+
+    return HAL_ERROR;
+  }
+
+  if (RxFifo == FDCAN_RX_FIFO0)
+  {
+    config = hfdcan->Instance->RXF0C;
+    status = hfdcan->Instance->RXF0S;
+    pFifo->pBase = (uint32_t *)hfdcan->msgRam.RxFIFO0SA;
+    pFifo->ElmtWords = hfdcan->Init.RxFifo0ElmtSize;
+    pFifo->ElmtsNbr = ((config & FDCAN_RXF0C_F0S) != 0U) ? hfdcan->Init.RxFifo0ElmtsNbr : 0U;
+    pFifo->GetIndex = (status & FDCAN_RXF0S_F0GI) >> FDCAN_RXF0S_F0GI_Pos;
+    pFifo->FillLevel = status & FDCAN_RXF0S_F0FL;
+
+    /* When the Rx FIFO is full in overwrite mode the oldest element is being replaced */
+    if (((status & FDCAN_RXF0S_F0F) != 0U) &&
+        ((config & FDCAN_RXF0C_F0OM) == FDCAN_RX_FIFO_OVERWRITE))
+    {
+      pFifo->GetIndex++;
+      pFifo->FillLevel--;
+    }
+  }
+  else
+  {
+    config = hfdcan->Instance->RXF1C;
+    status = hfdcan->Instance->RXF1S;
+    pFifo->pBase = (uint32_t *)hfdcan->msgRam.RxFIFO1SA;
+    pFifo->ElmtWords = hfdcan->Init.RxFifo1ElmtSize;
+    pFifo->ElmtsNbr = ((config & FDCAN_RXF1C_F1S) != 0U) ? hfdcan->Init.RxFifo1ElmtsNbr : 0U;
+    pFifo->GetIndex = (status & FDCAN_RXF1S_F1GI) >> FDCAN_RXF1S_F1GI_Pos;
+    pFifo->FillLevel = status & FDCAN_RXF1S_F1FL;
+
+    /* When the Rx FIFO is full in overwrite mode the oldest element is being replaced */
+    if (((status & FDCAN_RXF1S_F1F) != 0U) &&
+        ((config & FDCAN_RXF1C_F1OM) == FDCAN_RX_FIFO_OVERWRITE))
+    {
+      pFifo->GetIndex++;
+      pFifo->FillLevel--;
+    }
+  }
+
+  /* Check that the Rx FIFO has an allocated area into the RAM */
+  if (pFifo->ElmtsNbr == 0U)
+  {
+    /* Update error code */
+    hfdcan->ErrorCode |= HAL_FDCAN_ERROR_PARAM;
+
+    return HAL_ERROR;
+  }
+
+  if (pFifo->GetIndex >= pFifo->ElmtsNbr)
+  {
+    pFifo->GetIndex -= pFifo->ElmtsNbr;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Acknowledge the oldest elements of an Rx FIFO with a single write.
+  * @param  hfdcan pointer to an FDCAN_HandleTypeDef structure that contains
+  *         the configuration information for the specified FDCAN.
+  * @param  RxFifo Rx FIFO, FDCAN_RX_FIFO0 or FDCAN_RX_FIFO1.
+  * @param  pFifo pointer to the Rx FIFO view.
+  * @param  FramesNbr number of elements read, not 0.
+  * @retval None
+  */
+static void FDCANEx_AcknowledgeRxFifo(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo, const FDCANEx_RxFifoTypeDef *pFifo,
+                                      uint32_t FramesNbr)
+{
+  uint32_t index = pFifo->GetIndex + FramesNbr - 1U;
+
+  if (index >= pFifo->ElmtsNbr)
+  {
+    index -= pFifo->ElmtsNbr;
+  }
+
+  /* Acknowledging an element releases it and all the older ones */
+  if (RxFifo == FDCAN_RX_FIFO0)
+  {
+    hfdcan->Instance->RXF0A = index;
+  }
+  else
+  {
+    hfdcan->Instance->RXF1A = index;
+  }
+}
+
+/**
+  * @brief  Copy a frame header and payload into a software Tx queue frame.
+  * @param  pFrame pointer to the frame.
+  * @param  pTxHeader pointer to a FDCAN_TxHeaderTypeDef structure.
+  * @param  pTxData pointer to the frame payload.
+  * @retval None
+  */
+static void FDCANEx_TxCopy(FDCANEx_TxFrameTypeDef *pFrame, const FDCAN_TxHeaderTypeDef *pTxHeader, const uint8_t *pTxData)
+{
+  uint32_t ByteCounter;
+  uint32_t DataLength = FDCANEx_DLCtoBytes[(pTxHeader->DataLength >> 16) & 0xFU];
+
+  pFrame->Header = *pTxHeader;
+  for (ByteCounter = 0U; ByteCounter < DataLength; ByteCounter++)
+  {
+    pFrame->Data[ByteCounter] = pTxData[ByteCounter];
+  }
+
+  /* Standard identifiers win the arbitration over extended ones with the same base identifier */
+  if (pTxHeader->IdType == FDCAN_STANDARD_ID)
+  {
+    pFrame->PriorityKey = (pTxHeader->Identifier << 19U);
+  }
+  else
+  {
+    pFrame->PriorityKey = ((pTxHeader->Identifier << 1U) | 1U);
+  }
+}
+
+/**
+  * @brief  Insert a frame in the pending list, sorted by priority.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @param  pFrame pointer to the frame.
+  * @param  Front if not 0, the frame goes before frames of equal priority.
+  * @retval None
+  */
+static void FDCANEx_TxInsert(FDCANEx_TxQueueTypeDef *hqueue, FDCANEx_TxFrameTypeDef *pFrame, uint32_t Front)
+{
+  FDCANEx_TxFrameTypeDef **link = &hqueue->pPending;
+
+  while ((*link != NULL) &&
+         (((*link)->PriorityKey < pFrame->PriorityKey) ||
+          ((Front == 0U) && ((*link)->PriorityKey == pFrame->PriorityKey))))
+  {
+    link = &(*link)->pNext;
+  }
+  pFrame->pNext = *link;
+  *link = pFrame;
+  pFrame->State = FDCANEX_TX_FRAME_PENDING;
+
+  hqueue->PendingFrames++;
+  if (hqueue->PendingFrames > hqueue->Stats.PendingMax)
+  {
+    hqueue->Stats.PendingMax = hqueue->PendingFrames;
+  }
+}
+
+/**
+  * @brief  Return a frame to the free list.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @param  pFrame pointer to the frame.
+  * @retval None
+  */
+static void FDCANEx_TxRelease(FDCANEx_TxQueueTypeDef *hqueue, FDCANEx_TxFrameTypeDef *pFrame)
+{
+  pFrame->State = FDCANEX_TX_FRAME_FREE;
+  pFrame->Flags = 0U;
+  pFrame->pNext = hqueue->pFree;
+  hqueue->pFree = pFrame;
+}
+
+/**
+  * @brief  Retire completed hardware requests, refill the hardware and
+  *         preempt a lower priority request if needed.
+  * @note   Called with interrupts disabled.
+  * @param  hqueue pointer to a FDCANEx_TxQueueTypeDef structure.
+  * @retval None
+  */
+static void FDCANEx_TxSchedule(FDCANEx_TxQueueTypeDef *hqueue)
+{
+  FDCAN_HandleTypeDef *hfdcan = hqueue->hfdcan;
+  FDCANEx_TxFrameTypeDef *frame;
+  uint32_t pending;
+  uint32_t occurred;
+  uint32_t latency;
+  uint32_t index;
+  uint32_t victim;
+  uint32_t cancelling;
+
+  /* Retire the hardware buffers whose request is no longer pending */
+  pending = hfdcan->Instance->TXBRP;
+  occurred = hfdcan->Instance->TXBTO;
+  for (index = 0U; (index < 32U) && (hqueue->HwFrames != 0U); index++)
+  {
+    frame = hqueue->pHw[index];
+    if ((frame == NULL) || ((pending & ((uint32_t)1 << index)) != 0U))
+    {
+      continue;
+    }
+
+    hqueue->pHw[index] = NULL;
+    hqueue->HwFrames--;
+
+    if ((occurred & ((uint32_t)1 << index)) != 0U)
+    {
+      /* Transmitted */
+      latency = hqueue->GetTime() - frame->QueueTime;
+      hqueue->Stats.Sent++;
+      hqueue->Stats.LatencyTotal += latency;
+      if (latency < hqueue->Stats.LatencyMin)
+      {
+        hqueue->Stats.LatencyMin = latency;
+      }
+      if (latency > hqueue->Stats.LatencyMax)
+      {
+        hqueue->Stats.LatencyMax = latency;
+      }
+
+      if ((frame->Flags & FDCANEX_TX_FLAG_REPLACE) != 0U)
+      {
+        /* The old content went out, the new one still has to */
+        frame->Flags = 0U;
+        FDCANEx_TxInsert(hqueue, frame, 1U);
+      }
+      else
+      {
+        FDCANEx_TxRelease(hqueue, frame);
+      }
+    }
+    else if ((frame->Flags & FDCANEX_TX_FLAG_CANCEL) != 0U)
+    {
+      hqueue->Stats.Cancelled++;
+      FDCANEx_TxRelease(hqueue, frame);
+    }
+    else
+    {
+      /* Preempted or replaced: wait again for a hardware buffer */
+      frame->Flags = 0U;
+      FDCANEx_TxInsert(hqueue, frame, 1U);
+    }
+  }
+
+  /* Move the highest priority frames to the hardware */
+  while ((hqueue->pPending != NULL) && ((hfdcan->Instance->TXFQS & FDCAN_TXFQS_TFQF) == 0U))
+  {
+    frame = hqueue->pPending;
+    if (HAL_FDCAN_AddMessageToTxFifoQ(hfdcan, &frame->Header, frame->Data) != HAL_OK)
+    {
+      break;
+    }
+    hqueue->pPending = frame->pNext;
+    hqueue->PendingFrames--;
+
+    index = POSITION_VAL(HAL_FDCAN_GetLatestTxFifoQRequestBuffer(hfdcan));
+    hqueue->pHw[index] = frame;
+    frame->State = FDCANEX_TX_FRAME_HW;
+    hqueue->HwFrames++;
+  }
+
+  /* In Tx Queue mode, abort the lowest priority hardware request when a higher
+     priority frame waits, one abort at a time */
+  if ((hqueue->pPending != NULL) && (hfdcan->Init.TxFifoQueueMode == FDCAN_TX_QUEUE_OPERATION))
+  {
+    victim = 32U;
+    cancelling = 0U;
+    for (index = 0U; index < 32U; index++)
+    {
+      frame = hqueue->pHw[index];
+      if (frame != NULL)
+      {
+        if (frame->State == FDCANEX_TX_FRAME_CANCELLING)
+        {
+          cancelling++;
+        }
+        else if ((victim == 32U) || (frame->PriorityKey > hqueue->pHw[victim]->PriorityKey))
+        {
+          victim = index;
+        }
+        else
+        {
+          /* Keep the current victim */
+        }
+      }
+    }
+
+    if ((cancelling == 0U) && (victim != 32U) &&
+        (hqueue->pPending->PriorityKey < hqueue->pHw[victim]->PriorityKey))
+    {
+      hqueue->pHw[victim]->State = FDCANEX_TX_FRAME_CANCELLING;
+      hqueue->Stats.Preempted++;
+      (void)HAL_FDCAN_AbortTxRequest(hfdcan, ((uint32_t)1 << victim));
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+#endif /* HAL_FDCAN_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* FDCAN1 */
@@ -0,0 +1,882 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx_hal_hcd_ex.c
+  * @brief   HCD Extended HAL module driver.
+  *          This file provides firmware functions to manage the following
+  *          functionalities of the USB Peripheral Controller:
+  *           + Transfer scheduler functions
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                    ##### How to use this driver #####
+  ==============================================================================
+  [..]
+    (#)Initialize and start the HCD as usual, then call HAL_HCDEx_SchedInit()
+       with the range of host channels given to the scheduler.
+
+    (#)Call HAL_HCDEx_SchedSOF() from HAL_HCD_SOF_Callback() and
+       HAL_HCDEx_SchedURBChange() from HAL_HCD_HC_NotifyURBChange_Callback().
+
+    (#)Open each device endpoint with HAL_HCDEx_EndpointOpen(). Endpoints do
+       not own a host channel: a channel is assigned when a URB is started and
+       released when it completes, with the data toggle kept in the endpoint.
+       A channel the scheduler halts stays assigned until the halt completes:
+       a transfer completing meanwhile is reported, and the data toggle is
+       saved once the channel is stopped.
+
+    (#)Queue transfers with HAL_HCDEx_SubmitURB(). The scheduler:
+        (##) starts periodic endpoints first, on their interval frame,
+        (##) then control and bulk endpoints in round-robin,
+        (##) parks an endpoint answering NAK more than NakThreshold times for
+             an exponentially growing number of SOFs, up to BackoffMax, instead
+             of retrying it continuously,
+        (##) calls the URB completion callback from the HCD interrupt.
+
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7xx_hal.h"
+
+/** @addtogroup STM32H7xx_HAL_Driver
+  * @{
+  */
+
+/** @defgroup HCDEx HCDEx
+  * @brief HCD Extended HAL module driver
+  * @{
+  */
+
+#ifdef HAL_HCD_MODULE_ENABLED
+
+#if defined (USB_OTG_FS) || defined (USB_OTG_HS)
+/* Private types -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private constants ---------------------------------------------------------*/
+/* Private macros ------------------------------------------------------------*/
+/** @defgroup HCDEx_Private_Macros HCDEx Private Macros
+  * @{
+  */
+#define HCDEX_ENTER_CRITICAL(__PRIMASK__)  do { (__PRIMASK__) = __get_PRIMASK(); __disable_irq(); } while (0U)
+#define HCDEX_EXIT_CRITICAL(__PRIMASK__)   __set_PRIMASK(__PRIMASK__)
+
+#define HCDEX_IS_PERIODIC(__EP__)          (((__EP__)->EpType == EP_TYPE_INTR) || ((__EP__)->EpType == EP_TYPE_ISOC))
+/**
+  * @}
+  */
+
+/* Private functions ---------------------------------------------------------*/
+/** @defgroup HCDEx_Private_Functions HCDEx Private Functions
+  * @{
+  */
+static void HCDEx_Run(HCDEx_SchedTypeDef *hsched);
+static uint8_t HCDEx_AllocChannel(HCDEx_SchedTypeDef *hsched);
+static void HCDEx_Start(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep, uint8_t ch_num);
+static void HCDEx_Submit(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep);
+static void HCDEx_Release(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep);
+static void HCDEx_Halt(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep);
+static void HCDEx_HaltEvent(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep, HCD_URBStateTypeDef urb_state);
+static void HCDEx_HaltDone(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep);
+static uint32_t HCDEx_IsHalted(const HCDEx_SchedTypeDef *hsched, uint8_t ch_num);
+static void HCDEx_Transferred(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep);
+static void HCDEx_Complete(HCDEx_EndpointTypeDef *hep, uint8_t Status);
+static void HCDEx_Throttle(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep);
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+
+/** @defgroup HCDEx_Exported_Functions HCDEx Exported Functions
+  * @{
+  */
+
+/** @defgroup HCDEx_Exported_Functions_Group1 Transfer scheduler functions
+  * @brief    HCDEx transfer scheduler functions
+  *
+@verbatim
+ ===============================================================================
+                 ##### Transfer scheduler functions #####
+ ===============================================================================
+    [..]  This section provides functions allowing to:
+      (+) Queue URBs per endpoint
+      (+) Share the host channels between endpoints
+      (+) Throttle endpoints answering NAK
+      (+) Schedule periodic endpoints on their interval
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize the transfer scheduler.
+  * @param  hsched scheduler handle
+  * @param  hhcd HCD handle
+  * @param  FirstChannel first host channel managed by the scheduler
+  * @param  ChannelsNbr number of host channels managed by the scheduler
+  * @param  NakThreshold NAKs tolerated on a URB before the endpoint is throttled
+  * @param  BackoffMax longest throttle, in SOFs
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HCDEx_SchedInit(HCDEx_SchedTypeDef *hsched, HCD_HandleTypeDef *hhcd, uint8_t FirstChannel,
+                                      uint8_t ChannelsNbr, uint16_t NakThreshold, uint32_t BackoffMax)
+{
+  uint32_t i;
+
+  if ((hsched == NULL) || (hhcd == NULL) || (ChannelsNbr == 0U) ||
+      (((uint32_t)FirstChannel + ChannelsNbr) > hhcd->Init.Host_channels) ||
+      (((uint32_t)FirstChannel + ChannelsNbr) > 16U))
+  {
+    return HAL_ERROR;
+  }
+
+  hsched->hhcd = hhcd;
+  hsched->pEndpoints = NULL;
+  hsched->pLastServed = NULL;
+  hsched->HaltingChannels = 0U;
+  hsched->Frame = 0U;
+  hsched->FirstChannel = FirstChannel;
+  hsched->ChannelsNbr = ChannelsNbr;
+  hsched->NakThreshold = NakThreshold;
+  hsched->BackoffMax = (BackoffMax == 0U) ? 1U : BackoffMax;
+
+  for (i = 0U; i < 16U; i++)
+  {
+    hsched->pChannel[i] = NULL;
+  }
+
+  HAL_HCDEx_SchedResetStats(hsched);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Open a device endpoint.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @param  dev_address device address
+  * @param  ep_addr endpoint address, bit 7 set for IN
+  * @param  ep_type EP_TYPE_CTRL, EP_TYPE_ISOC, EP_TYPE_BULK or EP_TYPE_INTR
+  * @param  speed HCD_DEVICE_SPEED_HIGH, HCD_DEVICE_SPEED_FULL or HCD_DEVICE_SPEED_LOW
+  * @param  mps max packet size
+  * @param  interval periodic endpoints: service interval in SOFs (frames at
+  *         full speed, microframes at high speed), ignored otherwise
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HCDEx_EndpointOpen(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep, uint8_t dev_address,
+                                         uint8_t ep_addr, uint8_t ep_type, uint8_t speed, uint16_t mps,
+                                         uint16_t interval)
+{
+  uint32_t primask;
+
+  if ((hep == NULL) || (mps == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  hep->DevAddr = dev_address;
+  hep->EpAddr = ep_addr;
+  hep->EpType = ep_type;
+  hep->Speed = speed;
+  hep->MaxPacket = mps;
+  hep->Interval = (interval == 0U) ? 1U : interval;
+  hep->ToggleIn = 0U;
+  hep->ToggleOut = 0U;
+  hep->Channel = HCDEX_NO_CHANNEL;
+  hep->DoPing = 0U;
+  hep->Closing = 0U;
+  hep->NakCount = 0U;
+  hep->Backoff = 0U;
+  hep->BackoffNext = 1U;
+  hep->pHead = NULL;
+  hep->pTail = NULL;
+  hep->Stats.Completed = 0U;
+  hep->Stats.Bytes = 0U;
+  hep->Stats.Naks = 0U;
+  hep->Stats.Throttled = 0U;
+  hep->Stats.Errors = 0U;
+  hep->Stats.Stalls = 0U;
+  hep->Stats.Late = 0U;
+
+  HCDEX_ENTER_CRITICAL(primask);
+  hep->NextFrame = hsched->Frame;
+  hep->pNext = hsched->pEndpoints;
+  hsched->pEndpoints = hep;
+  HCDEX_EXIT_CRITICAL(primask);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Close a device endpoint.
+  * @note   The queued URBs are completed with the HCDEX_URB_ABORTED status.
+  *         A URB in progress is completed once its host channel is halted,
+  *         from the HCD interrupt: with HCDEX_URB_DONE if the transfer
+  *         completed meanwhile, HCDEX_URB_ABORTED otherwise. The endpoint
+  *         handle may be reused after the completion callback of its last URB.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HCDEx_EndpointClose(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep)
+{
+  HCDEx_EndpointTypeDef **link;
+  HCDEx_URBTypeDef *hurb;
+  uint32_t primask;
+
+  HCDEX_ENTER_CRITICAL(primask);
+
+  hurb = hep->pHead;
+  if ((hep->Channel != HCDEX_NO_CHANNEL) && (hurb != NULL) && (hurb->Status == HCDEX_URB_ACTIVE))
+  {
+    /* The URB in progress completes once the channel is halted */
+    hep->pHead = hurb->pNext;
+    while (hep->pHead != NULL)
+    {
+      HCDEx_Complete(hep, HCDEX_URB_ABORTED);
+    }
+    hurb->pNext = NULL;
+    hep->pHead = hurb;
+    hep->pTail = hurb;
+
+    hep->Closing = 1U;
+    if ((hsched->HaltingChannels & (1UL << hep->Channel)) == 0U)
+    {
+      HCDEx_Halt(hsched, hep);
+    }
+  }
+  else
+  {
+    if (hep->Channel != HCDEX_NO_CHANNEL)
+    {
+      /* Stopped channel kept until the next SOF, freed there */
+      hsched->pChannel[hep->Channel] = NULL;
+      hep->Channel = HCDEX_NO_CHANNEL;
+    }
+
+    while (hep->pHead != NULL)
+    {
+      HCDEx_Complete(hep, HCDEX_URB_ABORTED);
+    }
+  }
+
+  for (link = &hsched->pEndpoints; *link != NULL; link = &(*link)->pNext)
+  {
+    if (*link == hep)
+    {
+      *link = hep->pNext;
+      break;
+    }
+  }
+  if (hsched->pLastServed == hep)
+  {
+    hsched->pLastServed = NULL;
+  }
+
+  HCDEX_EXIT_CRITICAL(primask);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Reset the data toggles of an endpoint, e.g. after a CLEAR_FEATURE(ENDPOINT_HALT).
+  * @param  hep endpoint handle
+  * @retval None
+  */
+void HAL_HCDEx_EndpointResetToggle(HCDEx_EndpointTypeDef *hep)
+{
+  hep->ToggleIn = 0U;
+  hep->ToggleOut = 0U;
+}
+
+/**
+  * @brief  Queue a URB on an endpoint.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @param  hurb URB, owned by the scheduler until its completion callback
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HCDEx_SubmitURB(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep, HCDEx_URBTypeDef *hurb)
+{
+  uint32_t primask;
+
+  if ((hurb == NULL) || (hurb->Length > 0xFFFFU))
+  {
+    return HAL_ERROR;
+  }
+
+  hurb->Actual = 0U;
+  hurb->Status = HCDEX_URB_QUEUED;
+  hurb->pNext = NULL;
+
+  HCDEX_ENTER_CRITICAL(primask);
+  if (hep->pTail == NULL)
+  {
+    hep->pHead = hurb;
+  }
+  else
+  {
+    hep->pTail->pNext = hurb;
+  }
+  hep->pTail = hurb;
+
+  HCDEx_Run(hsched);
+  HCDEX_EXIT_CRITICAL(primask);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Advance the scheduler by one SOF.
+  * @note   To be called from HAL_HCD_SOF_Callback().
+  * @param  hsched scheduler handle
+  * @retval None
+  */
+void HAL_HCDEx_SchedSOF(HCDEx_SchedTypeDef *hsched)
+{
+  HCDEx_EndpointTypeDef *hep;
+  uint32_t ch_num;
+
+  hsched->Frame++;
+  hsched->Stats.Frames++;
+
+  /* Free the halting channels now stopped */
+  for (ch_num = hsched->FirstChannel; ch_num < ((uint32_t)hsched->FirstChannel + hsched->ChannelsNbr); ch_num++)
+  {
+    if (((hsched->HaltingChannels & (1UL << ch_num)) != 0U) && (HCDEx_IsHalted(hsched, (uint8_t)ch_num) != 0U))
+    {
+      if (hsched->pChannel[ch_num] != NULL)
+      {
+        HCDEx_HaltDone(hsched, hsched->pChannel[ch_num]);
+      }
+      else
+      {
+        hsched->HaltingChannels &= ~(1UL << ch_num);
+      }
+    }
+  }
+
+  for (hep = hsched->pEndpoints; hep != NULL; hep = hep->pNext)
+  {
+    if (hep->Backoff != 0U)
+    {
+      hep->Backoff--;
+    }
+  }
+
+  HCDEx_Run(hsched);
+}
+
+/**
+  * @brief  Handle a host channel URB state change.
+  * @note   To be called from HAL_HCD_HC_NotifyURBChange_Callback().
+  * @param  hsched scheduler handle
+  * @param  chnum host channel number
+  * @param  urb_state new URB state
+  * @retval None
+  */
+void HAL_HCDEx_SchedURBChange(HCDEx_SchedTypeDef *hsched, uint8_t chnum, HCD_URBStateTypeDef urb_state)
+{
+  HCDEx_EndpointTypeDef *hep;
+
+  if (chnum >= 16U)
+  {
+    return;
+  }
+
+  hep = hsched->pChannel[chnum];
+  if ((hep == NULL) || (hep->pHead == NULL))
+  {
+    return;
+  }
+  hsched->Stats.Events++;
+
+  if ((hsched->HaltingChannels & (1UL << chnum)) != 0U)
+  {
+    HCDEx_HaltEvent(hsched, hep, urb_state);
+    HCDEx_Run(hsched);
+    return;
+  }
+
+  switch (urb_state)
+  {
+    case URB_DONE:
+      HCDEx_Transferred(hsched, hep);
+      HCDEx_Complete(hep, HCDEX_URB_DONE);
+
+      if (HCDEX_IS_PERIODIC(hep))
+      {
+        /* The HCD driver updates the IN data toggle after this notification:
+           keep the stopped channel until the next SOF */
+        hsched->HaltingChannels |= (1UL << chnum);
+      }
+      else if ((hep->pHead != NULL) && (hep->EpType == EP_TYPE_BULK))
+      {
+        /* Keep the channel to stream the next bulk URB */
+        HCDEx_Submit(hsched, hep);
+      }
+      else
+      {
+        HCDEx_Release(hsched, hep);
+      }
+      break;
+
+    case URB_NOTREADY:
+    case URB_NYET:
+      hep->NakCount++;
+      hep->Stats.Naks++;
+
+      if (HCDEX_IS_PERIODIC(hep))
+      {
+        /* The channel is halted: retry on the next interval */
+        HCDEx_Release(hsched, hep);
+      }
+      else if ((hep->EpAddr & 0x80U) == 0x80U)
+      {
+        /* IN channels are re-armed by the HCD driver: throttle them to stop the NAK storm */
+        if (hep->NakCount >= hsched->NakThreshold)
+        {
+          HCDEx_Halt(hsched, hep);
+          HCDEx_Throttle(hsched, hep);
+        }
+      }
+      else
+      {
+        /* OUT channels are halted: retry with a PING at high speed */
+        hep->DoPing = (hep->Speed == HCD_DEVICE_SPEED_HIGH) ? 1U : 0U;
+        if (hep->NakCount >= hsched->NakThreshold)
+        {
+          HCDEx_Release(hsched, hep);
+          HCDEx_Throttle(hsched, hep);
+        }
+        else
+        {
+          HCDEx_Submit(hsched, hep);
+        }
+      }
+      break;
+
+    case URB_ERROR:
+      hep->Stats.Errors++;
+      hep->NakCount = 0U;
+      HCDEx_Complete(hep, HCDEX_URB_ERROR);
+      HCDEx_Release(hsched, hep);
+      break;
+
+    case URB_STALL:
+      hep->Stats.Stalls++;
+      hep->NakCount = 0U;
+      HCDEx_Complete(hep, HCDEX_URB_STALL);
+      HCDEx_Release(hsched, hep);
+      break;
+
+    default:
+      break;
+  }
+
+  HCDEx_Run(hsched);
+}
+
+/**
+  * @brief  Get the scheduler statistics.
+  * @param  hsched scheduler handle
+  * @param  pStats pointer to the statistics to fill
+  * @retval None
+  */
+void HAL_HCDEx_SchedGetStats(HCDEx_SchedTypeDef *hsched, HCDEx_SchedStatsTypeDef *pStats)
+{
+  uint32_t primask;
+
+  HCDEX_ENTER_CRITICAL(primask);
+  *pStats = hsched->Stats;
+  HCDEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @brief  Clear the scheduler statistics.
+  * @param  hsched scheduler handle
+  * @retval None
+  */
+void HAL_HCDEx_SchedResetStats(HCDEx_SchedTypeDef *hsched)
+{
+  uint32_t primask;
+
+  HCDEX_ENTER_CRITICAL(primask);
+  hsched->Stats.ChannelStarts = 0U;
+  hsched->Stats.NoChannel = 0U;
+  hsched->Stats.Events = 0U;
+  hsched->Stats.Frames = 0U;
+  HCDEX_EXIT_CRITICAL(primask);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup HCDEx_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Give free host channels to the endpoints ready to transfer.
+  * @note   Periodic endpoints are served first, then the asynchronous ones in
+  *         round-robin order. Called from the HCD interrupt or with interrupts
+  *         disabled.
+  * @param  hsched scheduler handle
+  * @retval None
+  */
+static void HCDEx_Run(HCDEx_SchedTypeDef *hsched)
+{
+  HCDEx_EndpointTypeDef *hep;
+  HCDEx_EndpointTypeDef *start;
+  uint8_t ch_num;
+
+  /* Periodic endpoints due in this frame */
+  for (hep = hsched->pEndpoints; hep != NULL; hep = hep->pNext)
+  {
+    if ((hep->Channel == HCDEX_NO_CHANNEL) && (hep->pHead != NULL) && HCDEX_IS_PERIODIC(hep) &&
+        ((int32_t)(hsched->Frame - hep->NextFrame) >= 0))
+    {
+      ch_num = HCDEx_AllocChannel(hsched);
+      if (ch_num == HCDEX_NO_CHANNEL)
+      {
+        hsched->Stats.NoChannel++;
+        return;
+      }
+      if (hsched->Frame != hep->NextFrame)
+      {
+        hep->Stats.Late++;
+      }
+      hep->NextFrame = hsched->Frame + hep->Interval;
+      HCDEx_Start(hsched, hep, ch_num);
+    }
+  }
+
+  /* Control and bulk endpoints, starting after the last one served */
+  start = ((hsched->pLastServed != NULL) && (hsched->pLastServed->pNext != NULL)) ?
+          hsched->pLastServed->pNext : hsched->pEndpoints;
+  hep = start;
+  while (hep != NULL)
+  {
+    if ((hep->Channel == HCDEX_NO_CHANNEL) && (hep->pHead != NULL) && !HCDEX_IS_PERIODIC(hep) &&
+        (hep->Backoff == 0U))
+    {
+      ch_num = HCDEx_AllocChannel(hsched);
+      if (ch_num == HCDEX_NO_CHANNEL)
+      {
+        hsched->Stats.NoChannel++;
+        return;
+      }
+      HCDEx_Start(hsched, hep, ch_num);
+      hsched->pLastServed = hep;
+    }
+
+    hep = (hep->pNext != NULL) ? hep->pNext : hsched->pEndpoints;
+    if (hep == start)
+    {
+      break;
+    }
+  }
+}
+
+/**
+  * @brief  Find a free host channel.
+  * @param  hsched scheduler handle
+  * @retval Host channel number or HCDEX_NO_CHANNEL
+  */
+static uint8_t HCDEx_AllocChannel(HCDEx_SchedTypeDef *hsched)
+{
+  uint32_t ch_num;
+
+  for (ch_num = hsched->FirstChannel; ch_num < ((uint32_t)hsched->FirstChannel + hsched->ChannelsNbr); ch_num++)
+  {
+    if ((hsched->pChannel[ch_num] == NULL) && ((hsched->HaltingChannels & (1UL << ch_num)) == 0U))
+    {
+      return (uint8_t)ch_num;
+    }
+  }
+
+  return HCDEX_NO_CHANNEL;
+}
+
+/**
+  * @brief  Assign a host channel to an endpoint and start its oldest URB.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @param  ch_num free host channel
+  * @retval None
+  */
+static void HCDEx_Start(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep, uint8_t ch_num)
+{
+  HCD_HandleTypeDef *hhcd = hsched->hhcd;
+  uint8_t epnum = hep->EpAddr;
+
+  /* The direction of a control endpoint follows the stage */
+  if (hep->EpType == EP_TYPE_CTRL)
+  {
+    epnum = (hep->EpAddr & 0x7FU) | ((hep->pHead->Direction != 0U) ? 0x80U : 0x00U);
+  }
+
+  (void)HAL_HCD_HC_Init(hhcd, ch_num, epnum, hep->DevAddr, hep->Speed, hep->EpType, hep->MaxPacket);
+  hhcd->hc[ch_num].toggle_in = hep->ToggleIn;
+  hhcd->hc[ch_num].toggle_out = hep->ToggleOut;
+
+  hsched->pChannel[ch_num] = hep;
+  hep->Channel = ch_num;
+
+  HCDEx_Submit(hsched, hep);
+}
+
+/**
+  * @brief  Submit the oldest URB of an endpoint on its host channel.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @retval None
+  */
+static void HCDEx_Submit(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep)
+{
+  HCDEx_URBTypeDef *hurb = hep->pHead;
+  uint8_t direction;
+  uint8_t token;
+
+  if (hep->EpType == EP_TYPE_CTRL)
+  {
+    direction = hurb->Direction;
+    token = hurb->Token;
+  }
+  else
+  {
+    direction = ((hep->EpAddr & 0x80U) == 0x80U) ? 1U : 0U;
+    token = 1U;
+  }
+
+  hurb->Status = HCDEX_URB_ACTIVE;
+  hsched->Stats.ChannelStarts++;
+
+  (void)HAL_HCD_HC_SubmitRequest(hsched->hhcd, hep->Channel, direction, hep->EpType, token,
+                                 hurb->pBuffer, (uint16_t)hurb->Length, hep->DoPing);
+}
+
+/**
+  * @brief  Release the host channel of an endpoint, keeping its data toggles.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @retval None
+  */
+static void HCDEx_Release(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep)
+{
+  uint8_t ch_num = hep->Channel;
+
+  hep->ToggleIn = hsched->hhcd->hc[ch_num].toggle_in;
+  hep->ToggleOut = hsched->hhcd->hc[ch_num].toggle_out;
+
+  hsched->pChannel[ch_num] = NULL;
+  hep->Channel = HCDEX_NO_CHANNEL;
+
+  if (hep->pHead != NULL)
+  {
+    hep->pHead->Status = HCDEX_URB_QUEUED;
+  }
+}
+
+/**
+  * @brief  Halt the host channel of an endpoint.
+  * @note   The endpoint keeps the channel until the halt is complete, see
+  *         HCDEx_HaltEvent() and HCDEx_HaltDone().
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @retval None
+  */
+static void HCDEx_Halt(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep)
+{
+  hsched->HaltingChannels |= (1UL << hep->Channel);
+  (void)HAL_HCD_HC_Halt(hsched->hhcd, hep->Channel);
+}
+
+/**
+  * @brief  Handle a URB state change of a halting host channel.
+  * @note   The transfer may have completed before the halt took effect: the
+  *         URB is then reported. A closing endpoint completes it once the
+  *         channel is released.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @param  urb_state new URB state
+  * @retval None
+  */
+static void HCDEx_HaltEvent(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep, HCD_URBStateTypeDef urb_state)
+{
+  uint8_t ch_num = hep->Channel;
+
+  switch (urb_state)
+  {
+    case URB_DONE:
+      HCDEx_Transferred(hsched, hep);
+      if (hep->Closing != 0U)
+      {
+        hep->pHead->Status = HCDEX_URB_DONE;
+      }
+      else
+      {
+        HCDEx_Complete(hep, HCDEX_URB_DONE);
+      }
+      break;
+
+    case URB_ERROR:
+    case URB_STALL:
+      if (urb_state == URB_ERROR)
+      {
+        hep->Stats.Errors++;
+      }
+      else
+      {
+        hep->Stats.Stalls++;
+      }
+      if (hep->Closing == 0U)
+      {
+        HCDEx_Complete(hep, (urb_state == URB_ERROR) ? HCDEX_URB_ERROR : HCDEX_URB_STALL);
+      }
+      break;
+
+    default:
+      /* The HCD driver re-arms control and bulk IN channels after a NAK: halt again */
+      if (HCDEx_IsHalted(hsched, ch_num) == 0U)
+      {
+        (void)HAL_HCD_HC_Halt(hsched->hhcd, ch_num);
+      }
+      break;
+  }
+
+  if (HCDEx_IsHalted(hsched, ch_num) != 0U)
+  {
+    HCDEx_HaltDone(hsched, hep);
+  }
+}
+
+/**
+  * @brief  Release the host channel of an endpoint once its halt is complete.
+  * @note   The data toggles are saved now that the channel no longer moves
+  *         data. A closing endpoint completes its last URB.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @retval None
+  */
+static void HCDEx_HaltDone(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep)
+{
+  hsched->HaltingChannels &= ~(1UL << hep->Channel);
+
+  if (hep->Closing != 0U)
+  {
+    hsched->pChannel[hep->Channel] = NULL;
+    hep->Channel = HCDEX_NO_CHANNEL;
+    hep->Closing = 0U;
+    HCDEx_Complete(hep, (hep->pHead->Status == HCDEX_URB_DONE) ? HCDEX_URB_DONE : HCDEX_URB_ABORTED);
+  }
+  else
+  {
+    HCDEx_Release(hsched, hep);
+  }
+}
+
+/**
+  * @brief  Check that a host channel is stopped, with no event left for the HCD driver.
+  * @param  hsched scheduler handle
+  * @param  ch_num host channel
+  * @retval 1 if the channel is halted, 0 otherwise
+  */
+static uint32_t HCDEx_IsHalted(const HCDEx_SchedTypeDef *hsched, uint8_t ch_num)
+{
+  uint32_t USBx_BASE = (uint32_t)hsched->hhcd->Instance;
+
+  return (((USBx_HC(ch_num)->HCCHAR & USB_OTG_HCCHAR_CHENA) == 0U) &&
+          ((USBx_HC(ch_num)->HCINT & USBx_HC(ch_num)->HCINTMSK) == 0U)) ? 1U : 0U;
+}
+
+/**
+  * @brief  Account the transfer of the oldest URB of an endpoint.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @retval None
+  */
+static void HCDEx_Transferred(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep)
+{
+  HCDEx_URBTypeDef *hurb = hep->pHead;
+
+  hurb->Actual = HAL_HCD_HC_GetXferCount(hsched->hhcd, hep->Channel);
+  hep->NakCount = 0U;
+  hep->BackoffNext = 1U;
+  hep->DoPing = 0U;
+  hep->Stats.Completed++;
+  hep->Stats.Bytes += hurb->Actual;
+}
+
+/**
+  * @brief  Dequeue the oldest URB of an endpoint and call its completion callback.
+  * @param  hep endpoint handle
+  * @param  Status completion status, a value of @ref HCDEx_URB_Status
+  * @retval None
+  */
+static void HCDEx_Complete(HCDEx_EndpointTypeDef *hep, uint8_t Status)
+{
+  HCDEx_URBTypeDef *hurb = hep->pHead;
+
+  hep->pHead = hurb->pNext;
+  if (hep->pHead == NULL)
+  {
+    hep->pTail = NULL;
+  }
+
+  hurb->pNext = NULL;
+  hurb->Status = Status;
+  if (hurb->pCallback != NULL)
+  {
+    hurb->pCallback(hurb);
+  }
+}
+
+/**
+  * @brief  Park an endpoint answering NAK for a growing number of SOFs.
+  * @param  hsched scheduler handle
+  * @param  hep endpoint handle
+  * @retval None
+  */
+static void HCDEx_Throttle(HCDEx_SchedTypeDef *hsched, HCDEx_EndpointTypeDef *hep)
+{
+  hep->NakCount = 0U;
+  hep->Backoff = hep->BackoffNext;
+  hep->Stats.Throttled++;
+
+  if (hep->BackoffNext < hsched->BackoffMax)
+  {
+    hep->BackoffNext *= 2U;
+    if (hep->BackoffNext > hsched->BackoffMax)
+    {
+      hep->BackoffNext = hsched->BackoffMax;
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+#endif /* defined (USB_OTG_FS) || defined (USB_OTG_HS) */
+#endif /* HAL_HCD_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,618 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx_hal_hsem_ex.c
+  * @brief   HSEM HAL Extended module driver.
+  *          This file provides firmware functions to manage the following
+  *          functionalities of the semaphore peripheral:
+  *           + Inter-core message rings in shared memory
+  *           + Message ring doorbells using semaphore release notifications
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+    A message ring carries messages from one or several producers to a single
+    consumer, each of them possibly running on a different core. The ring is
+    lock-free with a single producer; with several producers, a semaphore
+    serializes them.
+
+      (#) Reserve in a memory shared by the cores an HSEMEx_RingCtrlTypeDef
+          control block and the slot storage, sized with
+          __HAL_HSEMEX_RING_STORAGE_SIZE(). Both must be aligned on
+          HSEMEX_CACHE_LINE_SIZE bytes.
+
+      (#) On each core, and for each producer, initialize a local ring handle
+          with HAL_HSEMEx_RingInit(), giving it the shared parts, the slot size,
+          the number of slots (a power of 2) and the doorbell semaphore ID.
+          When the D-cache of the core is enabled, the shared parts are cleaned
+          and invalidated by the ring functions. CacheMaintenance may be cleared
+          when the MPU maps the shared memory as non-cacheable.
+
+      (#) With several producers, give each producer handle the producer lock
+          semaphore ID and a unique process ID with HAL_HSEMEx_RingSetLock().
+
+      (#) Before the other side uses the ring, reset the shared control block
+          with HAL_HSEMEx_RingReset() from one side only.
+
+      (#) On the consumer side, enable the doorbell with
+          HAL_HSEMEx_RingEnableDoorbell() and the HSEM interrupt of the core.
+          From HAL_HSEM_FreeCallback(), call HAL_HSEMEx_RingDoorbell() for each
+          ring: it returns 1 when the ring was notified and re-enables its
+          doorbell, the ring is then drained.
+
+      (#) Produce messages either:
+          (++) without copy: HAL_HSEMEx_RingAcquire() gives a pointer on the
+               payload of the next free slot, the message is built in place then
+               published with HAL_HSEMEx_RingCommit(),
+          (++) or with a copy using HAL_HSEMEx_RingSend().
+          A commit releases the doorbell semaphore, notifying the consumer core.
+
+      (#) Consume messages either:
+          (++) without copy: HAL_HSEMEx_RingPeek() gives a pointer on the oldest
+               message, which stays valid until HAL_HSEMEx_RingRelease() gives
+               its slot back to the producers,
+          (++) or with a copy using HAL_HSEMEx_RingReceive().
+
+      (#) HAL_BUSY is returned when the ring is full (producer), empty
+          (consumer) or when the producer lock is held by another producer.
+
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7xx_hal.h"
+
+/** @addtogroup STM32H7xx_HAL_Driver
+  * @{
+  */
+
+/** @defgroup HSEMEx HSEMEx
+  * @brief HSEM HAL Extended module driver
+  * @{
+  */
+
+#ifdef HAL_HSEM_MODULE_ENABLED
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/** @defgroup HSEMEx_Private_Macros HSEMEx Private Macros
+  * @{
+  */
+#define HSEMEX_IS_ALIGNED(__ADDRESS__)  ((((uint32_t)(__ADDRESS__)) & (HSEMEX_CACHE_LINE_SIZE - 1U)) == 0U)
+
+#define HSEMEX_SLOT(__HRING__, __INDEX__) \
+  (&(__HRING__)->pSlots[((__INDEX__) & ((__HRING__)->SlotNbr - 1U)) * (__HRING__)->SlotSize])
+/**
+  * @}
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup HSEMEx_Private_Functions HSEMEx Private Functions
+  * @{
+  */
+static void HSEMEx_CleanShared(const HSEMEx_RingTypeDef *hring, volatile void *pAddress, uint32_t Size);
+static void HSEMEx_InvalidateShared(const HSEMEx_RingTypeDef *hring, volatile void *pAddress, uint32_t Size);
+static void HSEMEx_RingUnlock(const HSEMEx_RingTypeDef *hring);
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+
+/** @defgroup HSEMEx_Exported_Functions HSEMEx Exported Functions
+  * @{
+  */
+
+/** @defgroup HSEMEx_Exported_Functions_Group1 Message ring configuration functions
+  * @brief    Message ring configuration functions
+  *
+@verbatim
+ ===============================================================================
+               ##### Message ring configuration functions #####
+ ===============================================================================
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize the local handle of a message ring.
+  * @note   The shared control block is not modified, see HAL_HSEMEx_RingReset().
+  * @param  hring pointer to the local ring handle.
+  * @param  pCtrl pointer to the shared control block, aligned on HSEMEX_CACHE_LINE_SIZE.
+  * @param  pSlots pointer to the shared slot storage, aligned on HSEMEX_CACHE_LINE_SIZE.
+  * @param  SlotSize bytes per slot, header included, multiple of HSEMEX_CACHE_LINE_SIZE.
+  * @param  SlotNbr number of slots, power of 2.
+  * @param  DoorbellSemID semaphore ID released after each commit: From 0 to HSEM_SEMID_MAX
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingInit(HSEMEx_RingTypeDef *hring, HSEMEx_RingCtrlTypeDef *pCtrl, uint8_t *pSlots,
+                                      uint32_t SlotSize, uint32_t SlotNbr, uint32_t DoorbellSemID)
+{
+  if ((hring == NULL) || (pCtrl == NULL) || (pSlots == NULL) ||
+      (HSEMEX_IS_ALIGNED(pCtrl) == 0U) || (HSEMEX_IS_ALIGNED(pSlots) == 0U) ||
+      (SlotSize <= HSEMEX_RING_SLOT_HEADER) || ((SlotSize & (HSEMEX_CACHE_LINE_SIZE - 1U)) != 0U) ||
+      (SlotNbr == 0U) || ((SlotNbr & (SlotNbr - 1U)) != 0U) || (DoorbellSemID > HSEM_SEMID_MAX))
+  {
+    return HAL_ERROR;
+  }
+
+  hring->pCtrl = pCtrl;
+  hring->pSlots = pSlots;
+  hring->SlotSize = SlotSize;
+  hring->SlotNbr = SlotNbr;
+  hring->DoorbellSemID = DoorbellSemID;
+  hring->LockSemID = HSEMEX_RING_NO_LOCK;
+  hring->ProcessID = 0U;
+  hring->Pending = 0U;
+
+  hring->Stats.Messages = 0U;
+  hring->Stats.Full = 0U;
+  hring->Stats.Empty = 0U;
+  hring->Stats.Doorbells = 0U;
+  hring->Stats.LockBusy = 0U;
+
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  hring->CacheMaintenance = ((SCB->CCR & SCB_CCR_DC_Msk) != 0U) ? 1U : 0U;
+#else
+  hring->CacheMaintenance = 0U;
+#endif /* __DCACHE_PRESENT */
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Set the producer lock of a message ring with several producers.
+  * @param  hring pointer to the local ring handle of a producer.
+  * @param  LockSemID semaphore ID serializing the producers: From 0 to HSEM_SEMID_MAX,
+  *         or HSEMEX_RING_NO_LOCK for a single producer.
+  * @param  ProcessID process ID of this producer: From 0 to HSEM_PROCESSID_MAX,
+  *         unique among the producers of the ring running on the same core.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingSetLock(HSEMEx_RingTypeDef *hring, uint32_t LockSemID, uint32_t ProcessID)
+{
+  if ((hring == NULL) || (hring->Pending != 0U) || (ProcessID > HSEM_PROCESSID_MAX) ||
+      ((LockSemID != HSEMEX_RING_NO_LOCK) &&
+       ((LockSemID > HSEM_SEMID_MAX) || (LockSemID == hring->DoorbellSemID))))
+  {
+    return HAL_ERROR;
+  }
+
+  hring->LockSemID = LockSemID;
+  hring->ProcessID = ProcessID;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Reset the shared control block of a message ring, discarding its messages.
+  * @note   To be called from one side only, before the other side uses the ring.
+  * @param  hring pointer to the local ring handle.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingReset(HSEMEx_RingTypeDef *hring)
+{
+  if (hring == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  hring->pCtrl->Head = 0U;
+  hring->pCtrl->Tail = 0U;
+  hring->Pending = 0U;
+  HSEMEx_CleanShared(hring, hring->pCtrl, sizeof(HSEMEx_RingCtrlTypeDef));
+
+  return HAL_OK;
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup HSEMEx_Exported_Functions_Group2 Message ring producer functions
+  * @brief    Message ring producer functions
+  *
+@verbatim
+ ===============================================================================
+                 ##### Message ring producer functions #####
+ ===============================================================================
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Acquire the next free slot of a message ring to build a message in place.
+  * @note   With several producers, the producer lock is held until
+  *         HAL_HSEMEx_RingCommit() is called.
+  * @param  hring pointer to the local ring handle of a producer.
+  * @param  ppBuffer pointer filled with the address of the slot payload.
+  * @param  pSize pointer filled with the maximum message size.
+  * @retval HAL status, HAL_BUSY if the ring is full or the lock held by another producer.
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingAcquire(HSEMEx_RingTypeDef *hring, uint8_t **ppBuffer, uint32_t *pSize)
+{
+  uint32_t head;
+  uint32_t tail;
+
+  if ((hring == NULL) || (ppBuffer == NULL) || (pSize == NULL) || (hring->Pending != 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  if (hring->LockSemID != HSEMEX_RING_NO_LOCK)
+  {
+    if (HAL_HSEM_Take(hring->LockSemID, hring->ProcessID) != HAL_OK)
+    {
+      hring->Stats.LockBusy++;
+      return HAL_BUSY;
+    }
+  }
+
+  /* Head may be updated by another producer, Tail by the consumer */
+  HSEMEx_InvalidateShared(hring, hring->pCtrl, sizeof(HSEMEx_RingCtrlTypeDef));
+  head = hring->pCtrl->Head;
+  tail = hring->pCtrl->Tail;
+
+  if ((head - tail) >= hring->SlotNbr)
+  {
+    hring->Stats.Full++;
+    HSEMEx_RingUnlock(hring);
+    return HAL_BUSY;
+  }
+
+  /* Slot reads by the consumer complete before the slot is written again */
+  __DMB();
+
+  *ppBuffer = &HSEMEX_SLOT(hring, head)[HSEMEX_RING_SLOT_HEADER];
+  *pSize = hring->SlotSize - HSEMEX_RING_SLOT_HEADER;
+  hring->Pending = 1U;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Publish the message built in the slot acquired and notify the consumer.
+  * @param  hring pointer to the local ring handle of a producer.
+  * @param  Length message length in bytes.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingCommit(HSEMEx_RingTypeDef *hring, uint32_t Length)
+{
+  uint8_t *p_slot;
+  uint32_t head;
+
+  if ((hring == NULL) || (hring->Pending == 0U) || (Length > (hring->SlotSize - HSEMEX_RING_SLOT_HEADER)))
+  {
+    return HAL_ERROR;
+  }
+
+  head = hring->pCtrl->Head;
+  p_slot = HSEMEX_SLOT(hring, head);
+  *((uint32_t *)p_slot) = Length;
+  HSEMEx_CleanShared(hring, p_slot, HSEMEX_RING_SLOT_HEADER + Length);
+
+  /* The message is visible before the slot is published */
+  __DMB();
+  hring->pCtrl->Head = head + 1U;
+  HSEMEx_CleanShared(hring, &hring->pCtrl->Head, HSEMEX_CACHE_LINE_SIZE);
+
+  hring->Pending = 0U;
+  hring->Stats.Messages++;
+  HSEMEx_RingUnlock(hring);
+
+  /* Ring the doorbell: the release notifies the consumer core. If the semaphore
+     is taken by another producer, its own release notifies the consumer. */
+  if (HAL_HSEM_FastTake(hring->DoorbellSemID) == HAL_OK)
+  {
+    HAL_HSEM_Release(hring->DoorbellSemID, 0U);
+    hring->Stats.Doorbells++;
+  }
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Copy a message into a message ring and notify the consumer.
+  * @param  hring pointer to the local ring handle of a producer.
+  * @param  pData pointer to the message.
+  * @param  Length message length in bytes.
+  * @retval HAL status, HAL_BUSY if the ring is full or the lock held by another producer.
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingSend(HSEMEx_RingTypeDef *hring, const uint8_t *pData, uint32_t Length)
+{
+  HAL_StatusTypeDef status;
+  uint8_t *p_buffer;
+  uint32_t size;
+  uint32_t index;
+
+  if ((hring == NULL) || ((pData == NULL) && (Length != 0U)) ||
+      (Length > (hring->SlotSize - HSEMEX_RING_SLOT_HEADER)))
+  {
+    return HAL_ERROR;
+  }
+
+  status = HAL_HSEMEx_RingAcquire(hring, &p_buffer, &size);
+  if (status != HAL_OK)
+  {
+    return status;
+  }
+
+  for (index = 0U; index < Length; index++)
+  {
+    p_buffer[index] = pData[index];
+  }
+
+  return HAL_HSEMEx_RingCommit(hring, Length);
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup HSEMEx_Exported_Functions_Group3 Message ring consumer functions
+  * @brief    Message ring consumer functions
+  *
+@verbatim
+ ===============================================================================
+                 ##### Message ring consumer functions #####
+ ===============================================================================
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Activate the notification of the doorbell semaphore of a message ring.
+  * @param  hring pointer to the local ring handle of the consumer.
+  * @retval None
+  */
+void HAL_HSEMEx_RingEnableDoorbell(const HSEMEx_RingTypeDef *hring)
+{
+  HAL_HSEM_ActivateNotification(1UL << hring->DoorbellSemID);
+}
+
+/**
+  * @brief  Handle a semaphore release notification for a message ring.
+  * @note   To be called from HAL_HSEM_FreeCallback(). HAL_HSEM_IRQHandler() deactivates
+  *         the notification of the released semaphores, it is activated again here.
+  * @param  hring pointer to the local ring handle of the consumer.
+  * @param  SemMask mask of the released semaphores given to HAL_HSEM_FreeCallback().
+  * @retval 1 if the doorbell of the ring was rung, the ring must then be drained, 0 otherwise.
+  */
+uint32_t HAL_HSEMEx_RingDoorbell(HSEMEx_RingTypeDef *hring, uint32_t SemMask)
+{
+  if ((SemMask & (1UL << hring->DoorbellSemID)) == 0U)
+  {
+    return 0U;
+  }
+
+  hring->Stats.Doorbells++;
+  HAL_HSEMEx_RingEnableDoorbell(hring);
+
+  return 1U;
+}
+
+/**
+  * @brief  Get the oldest message of a message ring without copying it.
+  * @note   The message stays valid until HAL_HSEMEx_RingRelease() is called.
+  * @param  hring pointer to the local ring handle of the consumer.
+  * @param  ppBuffer pointer filled with the address of the message.
+  * @param  pLength pointer filled with the message length.
+  * @retval HAL status, HAL_BUSY if the ring is empty.
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingPeek(HSEMEx_RingTypeDef *hring, uint8_t **ppBuffer, uint32_t *pLength)
+{
+  uint8_t *p_slot;
+  uint32_t tail;
+  uint32_t length;
+
+  if ((hring == NULL) || (ppBuffer == NULL) || (pLength == NULL) || (hring->Pending != 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  HSEMEx_InvalidateShared(hring, &hring->pCtrl->Head, HSEMEX_CACHE_LINE_SIZE);
+  tail = hring->pCtrl->Tail;
+
+  if (hring->pCtrl->Head == tail)
+  {
+    hring->Stats.Empty++;
+    return HAL_BUSY;
+  }
+
+  /* The slot is read after its publication */
+  __DMB();
+
+  p_slot = HSEMEX_SLOT(hring, tail);
+  HSEMEx_InvalidateShared(hring, p_slot, HSEMEX_CACHE_LINE_SIZE);
+  length = *((uint32_t *)p_slot);
+  if (length > (hring->SlotSize - HSEMEX_RING_SLOT_HEADER))
+  {
+    return HAL_ERROR;
+  }
+
+  if ((HSEMEX_RING_SLOT_HEADER + length) > HSEMEX_CACHE_LINE_SIZE)
+  {
+    HSEMEx_InvalidateShared(hring, &p_slot[HSEMEX_CACHE_LINE_SIZE],
+                            (HSEMEX_RING_SLOT_HEADER + length) - HSEMEX_CACHE_LINE_SIZE);
+  }
+
+  *ppBuffer = &p_slot[HSEMEX_RING_SLOT_HEADER];
+  *pLength = length;
+  hring->Pending = 1U;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Give the slot of the message peeked back to the producers.
+  * @param  hring pointer to the local ring handle of the consumer.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingRelease(HSEMEx_RingTypeDef *hring)
+{
+  if ((hring == NULL) || (hring->Pending == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  /* The message is read before the slot can be reused */
+  __DMB();
+  hring->pCtrl->Tail = hring->pCtrl->Tail + 1U;
+  HSEMEx_CleanShared(hring, &hring->pCtrl->Tail, HSEMEX_CACHE_LINE_SIZE);
+
+  hring->Pending = 0U;
+  hring->Stats.Messages++;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Copy the oldest message of a message ring and remove it from the ring.
+  * @param  hring pointer to the local ring handle of the consumer.
+  * @param  pData pointer to the buffer receiving the message.
+  * @param  Size size of pData in bytes.
+  * @param  pLength pointer filled with the message length.
+  * @retval HAL status, HAL_BUSY if the ring is empty, HAL_ERROR if the message is
+  *         larger than Size, the message then stays in the ring.
+  */
+HAL_StatusTypeDef HAL_HSEMEx_RingReceive(HSEMEx_RingTypeDef *hring, uint8_t *pData, uint32_t Size,
+                                         uint32_t *pLength)
+{
+  HAL_StatusTypeDef status;
+  uint8_t *p_buffer;
+  uint32_t length;
+  uint32_t index;
+
+  if ((pData == NULL) || (pLength == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  status = HAL_HSEMEx_RingPeek(hring, &p_buffer, &length);
+  if (status != HAL_OK)
+  {
+    return status;
+  }
+
+  if (length > Size)
+  {
+    hring->Pending = 0U;
+    return HAL_ERROR;
+  }
+
+  for (index = 0U; index < length; index++)
+  {
+    pData[index] = p_buffer[index];
+  }
+  *pLength = length;
+
+  return HAL_HSEMEx_RingRelease(hring);
+}
+
+/**
+  * @brief  Get the number of messages in a message ring.
+  * @param  hring pointer to the local ring handle.
+  * @retval Number of messages committed and not released
+  */
+uint32_t HAL_HSEMEx_RingGetCount(const HSEMEx_RingTypeDef *hring)
+{
+  HSEMEx_InvalidateShared(hring, hring->pCtrl, sizeof(HSEMEx_RingCtrlTypeDef));
+
+  return (hring->pCtrl->Head - hring->pCtrl->Tail);
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup HSEMEx_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Write back the D-cache lines of a shared ring part.
+  * @param  hring pointer to the local ring handle.
+  * @param  pAddress address of the shared part.
+  * @param  Size size of the shared part in bytes.
+  * @retval None
+  */
+static void HSEMEx_CleanShared(const HSEMEx_RingTypeDef *hring, volatile void *pAddress, uint32_t Size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  if (hring->CacheMaintenance != 0U)
+  {
+    SCB_CleanDCache_by_Addr((uint32_t *)pAddress, (int32_t)Size);
+  }
+#else
+  UNUSED(hring);
+  UNUSED(pAddress);
+  UNUSED(Size);
+#endif /* __DCACHE_PRESENT */
+}
+
+/**
+  * @brief  Discard the D-cache lines of a shared ring part.
+  * @note   The lines of the shared parts are always cleaned right after being
+  *         written, so that no pending write is discarded.
+  * @param  hring pointer to the local ring handle.
+  * @param  pAddress address of the shared part.
+  * @param  Size size of the shared part in bytes.
+  * @retval None
+  */
+static void HSEMEx_InvalidateShared(const HSEMEx_RingTypeDef *hring, volatile void *pAddress, uint32_t Size)
+{
+#if defined(__DCACHE_PRESENT) && (__DCACHE_PRESENT == 1U)
+  if (hring->CacheMaintenance != 0U)
+  {
+    SCB_InvalidateDCache_by_Addr((uint32_t *)pAddress, (int32_t)Size);
+  }
+#else
+  UNUSED(hring);
+  UNUSED(pAddress);
+  UNUSED(Size);
+#endif /* __DCACHE_PRESENT */
+}
+
+/**
+  * @brief  Release the producer lock of a message ring, if any.
+  * @param  hring pointer to the local ring handle of a producer.
+  * @retval None
+  */
+static void HSEMEx_RingUnlock(const HSEMEx_RingTypeDef *hring)
+{
+  if (hring->LockSemID != HSEMEX_RING_NO_LOCK)
+  {
+    HAL_HSEM_Release(hring->LockSemID, hring->ProcessID);
+  }
+}
+
+/**
+  * @}
+  */
+
+#endif /* HAL_HSEM_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -0,0 +1,351 @@
+/**
+  ******************************************************************************
+  * @file    stm32h7xx_hal_rcc_ex_pll.c
+  * @brief   Extended RCC HAL module driver.
+  *          This file provides firmware functions to manage the following
+  *          functionalities RCC extension peripheral:
+  *           + Extended PLL solver functions
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                        ##### How to use this driver #####
+  ==============================================================================
+    [..]
+      (#) The PLL solver only uses its parameters and does not access the RCC
+          registers. It is kept apart from stm32h7xx_hal_rcc_ex.c so that it
+          can be built alone, on a host or in a unit test.
+
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32h7xx_hal.h"
+
+/** @addtogroup STM32H7xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup RCCEx
+  * @{
+  */
+
+#ifdef HAL_RCC_MODULE_ENABLED
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private defines -----------------------------------------------------------*/
+/** @addtogroup RCCEx_Private_defines
+ * @{
+ */
+#define PLLVCO_INPUT_MIN             1000000U   /* Frequency min for PLL VCO input, in Hz          */
+#define PLLVCO_INPUT_MAX            16000000U   /* Frequency max for PLL VCO input, in Hz          */
+#if (POWER_DOMAINS_NUMBER == 3U)
+#define PLLVCO_MEDIUM_OUTPUT_MIN   150000000U   /* Frequency min for medium range PLL VCO, in Hz   */
+#define PLLVCO_MEDIUM_OUTPUT_MAX   420000000U   /* Frequency max for medium range PLL VCO, in Hz   */
+#define PLLVCO_WIDE_OUTPUT_MIN     192000000U   /* Frequency min for wide range PLL VCO, in Hz     */
+#define PLLVCO_WIDE_OUTPUT_MAX     836000000U   /* Frequency max for wide range PLL VCO, in Hz     */
+#else
+#define PLLVCO_MEDIUM_OUTPUT_MIN   150000000U   /* Frequency min for medium range PLL VCO, in Hz   */
+#define PLLVCO_MEDIUM_OUTPUT_MAX   420000000U   /* Frequency max for medium range PLL VCO, in Hz   */
+#define PLLVCO_WIDE_OUTPUT_MIN     128000000U   /* Frequency min for wide range PLL VCO, in Hz     */
+#define PLLVCO_WIDE_OUTPUT_MAX     560000000U   /* Frequency max for wide range PLL VCO, in Hz     */
+#endif /* POWER_DOMAINS_NUMBER == 3U */
+#if !defined(RCC_VER_2_0)
+#define PLLN_MIN                          4U
+#define PLLN_MAX                        512U
+#else
+#define PLLN_MIN                          8U
+#define PLLN_MAX                        420U
+#endif /* !RCC_VER_2_0 */
+#define PLLDIV_MAX                      128U    /* Highest PLL output division factor              */
+#define PLLFRACN_RESOLUTION            8192U    /* Multiplication factor steps per integer value   */
+/**
+  * @}
+  */
+
+/* Private macros ------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+static uint32_t RCCEx_PLLSelectDivider(uint64_t PLLVCOFreq, uint32_t Freq, uint32_t Tolerance, uint32_t DivMin,
+                                       uint32_t DivStep, uint32_t *pDivider, uint32_t *pError);
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup RCCEx_Exported_Functions
+  * @{
+  */
+
+/** @defgroup RCCEx_Exported_Functions_Group4 Extended PLL solver functions
+ *  @brief  Extended PLL solver functions
+ *
+@verbatim
+ ===============================================================================
+                ##### Extended PLL solver functions  #####
+ ===============================================================================
+    [..]
+      HAL_RCCEx_PLLSolve() computes the PLL division and multiplication factors,
+      including the fractional part of the multiplication factor, reaching the
+      target frequencies of the PLLP, PLLQ and PLLR outputs within their tolerance:
+
+      (#) Fill a RCC_PLLTargetTypeDef structure with the PLL entry clock, the PLL
+          to configure and the target frequency and tolerance of each output used.
+
+      (#) Call HAL_RCCEx_PLLSolve() to fill the PLL field of the RCC_OscInitTypeDef
+          structure given to HAL_RCC_OscConfig(), or copy the result to the
+          RCC_PLL2InitTypeDef or RCC_PLL3InitTypeDef structure of
+          HAL_RCCEx_PeriphCLKConfig().
+
+      [..]
+      Among the configurations meeting all the tolerances, the one with the lowest
+      total frequency error is returned. Ties are broken by preferring an integer
+      multiplication factor, as the fractional mode adds jitter, then the highest
+      VCO input frequency, then the lowest VCO output frequency, to lower the
+      power consumption.
+      [..]
+      The solver only uses its parameters and does not access the RCC registers,
+      so it can also be used on a host to precompute a configuration at build time.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Compute a PLL configuration reaching the target output frequencies.
+  * @param  pTarget  pointer to an RCC_PLLTargetTypeDef structure giving the PLL
+  *         entry clock and the target output frequencies.
+  * @param  pPLLInit  pointer to an RCC_PLLInitTypeDef structure filled with the
+  *         PLL configuration, with PLLState set to RCC_PLL_ON. PLLRGE and PLLVCOSEL
+  *         are values of RCC_PLLx_VCI_Range and RCC_PLLx_VCO_Range of the PLL
+  *         selected by pTarget->PLLx.
+  * @retval HAL_OK when a configuration meets all the tolerances, HAL_ERROR otherwise
+  *         or when no output is used (pPLLInit is then left unchanged)
+  */
+HAL_StatusTypeDef HAL_RCCEx_PLLSolve(const RCC_PLLTargetTypeDef *pTarget, RCC_PLLInitTypeDef *pPLLInit)
+{
+  static const uint32_t pllrge[3][4] =
+  {
+    {RCC_PLL1VCIRANGE_0, RCC_PLL1VCIRANGE_1, RCC_PLL1VCIRANGE_2, RCC_PLL1VCIRANGE_3},
+    {RCC_PLL2VCIRANGE_0, RCC_PLL2VCIRANGE_1, RCC_PLL2VCIRANGE_2, RCC_PLL2VCIRANGE_3},
+    {RCC_PLL3VCIRANGE_0, RCC_PLL3VCIRANGE_1, RCC_PLL3VCIRANGE_2, RCC_PLL3VCIRANGE_3}
+  };
+  static const uint32_t pllvcosel[3][2] =
+  {
+    {RCC_PLL1VCOWIDE, RCC_PLL1VCOMEDIUM},
+    {RCC_PLL2VCOWIDE, RCC_PLL2VCOMEDIUM},
+    {RCC_PLL3VCOWIDE, RCC_PLL3VCOMEDIUM}
+  };
+  uint32_t freq[3];
+  uint32_t tolerance[3];
+  uint32_t divmin[3];
+  uint32_t divstep[3];
+  uint32_t divider[3] = {0U, 0U, 0U};
+  uint32_t pllm;
+  uint32_t plln;
+  uint32_t pllfracn;
+  uint32_t rangeindex;
+  uint32_t medium;
+  uint32_t vcomin;
+  uint32_t vcomax;
+  uint32_t output;
+  uint32_t div;
+  uint32_t error;
+  uint32_t besterror = 0U;
+  uint32_t bestpllm = 0U;
+  uint32_t bestpllfracn = 0U;
+  uint64_t pllnx;
+  uint64_t pllvcox;
+  uint64_t bestpllvcox = 0U;
+  HAL_StatusTypeDef status = HAL_ERROR;
+
+  /* Check Null pointer and PLL index */
+  if ((pTarget == NULL) || (pPLLInit == NULL) || (pTarget->PLLx < 1U) || (pTarget->PLLx > 3U))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Check the parameters */
+  assert_param(IS_RCC_PLLSOURCE(pTarget->PLLSource));
+
+  freq[0] = pTarget->PLLPFreq;
+  freq[1] = pTarget->PLLQFreq;
+  freq[2] = pTarget->PLLRFreq;
+  tolerance[0] = pTarget->PLLPTolerance;
+  tolerance[1] = pTarget->PLLQTolerance;
+  tolerance[2] = pTarget->PLLRTolerance;
+
+  /* Odd PLL1 P division factors are not allowed */
+  divmin[0]  = (pTarget->PLLx == 1U) ? 2U : 1U;
+  divstep[0] = (pTarget->PLLx == 1U) ? 2U : 1U;
+  divmin[1]  = 1U;
+  divstep[1] = 1U;
+  divmin[2]  = 1U;
+  divstep[2] = 1U;
+
+  for (pllm = 1U; pllm <= 63U; pllm++)
+  {
+    if ((pTarget->InputFreq >= (PLLVCO_INPUT_MIN * pllm)) && (pTarget->InputFreq <= (PLLVCO_INPUT_MAX * pllm)))
+    {
+      /* VCI and VCO ranges */
+      if (pTarget->InputFreq < (2000000U * pllm))
+      {
+        rangeindex = 0U;
+        medium = 1U;
+        vcomin = PLLVCO_MEDIUM_OUTPUT_MIN;
+        vcomax = PLLVCO_MEDIUM_OUTPUT_MAX;
+      }
+      else
+      {
+        rangeindex = (pTarget->InputFreq >= (8000000U * pllm)) ? 3U : ((pTarget->InputFreq >= (4000000U * pllm)) ? 2U : 1U);
+        medium = 0U;
+        vcomin = PLLVCO_WIDE_OUTPUT_MIN;
+        vcomax = PLLVCO_WIDE_OUTPUT_MAX;
+      }
+
+      /* Each used output in turn sets the VCO frequency: the multiplication factor
+         is chosen to reach its target exactly with each of its dividers keeping
+         the VCO in range, the other outputs then use their closest divider */
+      for (output = 0U; output < 3U; output++)
+      {
+        if (freq[output] != 0U)
+        {
+          div = (vcomin + freq[output] - 1U) / freq[output];
+          div = (div > divmin[output]) ? (divmin[output] + ((((div - divmin[output]) + divstep[output]) - 1U) / divstep[output]) * divstep[output]) : divmin[output];
+
+          while ((div <= PLLDIV_MAX) && (((uint64_t)freq[output] * div) <= vcomax))
+          {
+            /* Multiplication factor scaled by the fractional part resolution */
+            pllnx = ((((uint64_t)freq[output] * div * pllm) * PLLFRACN_RESOLUTION) + (pTarget->InputFreq / 2U)) / pTarget->InputFreq;
+            if (pTarget->Fractional == 0U)
+            {
+              pllnx = ((pllnx + (PLLFRACN_RESOLUTION / 2U)) / PLLFRACN_RESOLUTION) * PLLFRACN_RESOLUTION;
+            }
+            plln = (uint32_t)(pllnx / PLLFRACN_RESOLUTION);
+            pllfracn = (uint32_t)(pllnx % PLLFRACN_RESOLUTION);
+
+            /* VCO frequency scaled by the fractional part resolution */
+            pllvcox = ((uint64_t)pTarget->InputFreq * pllnx) / pllm;
+
+            if ((plln >= PLLN_MIN) && (plln <= PLLN_MAX) &&
+                (pllvcox >= ((uint64_t)vcomin * PLLFRACN_RESOLUTION)) && (pllvcox <= ((uint64_t)vcomax * PLLFRACN_RESOLUTION)))
+            {
+              error = 0U;
+
+              if ((RCCEx_PLLSelectDivider(pllvcox, freq[0], tolerance[0], divmin[0], divstep[0], &divider[0], &error) != 0U) &&
+                  (RCCEx_PLLSelectDivider(pllvcox, freq[1], tolerance[1], divmin[1], divstep[1], &divider[1], &error) != 0U) &&
+                  (RCCEx_PLLSelectDivider(pllvcox, freq[2], tolerance[2], divmin[2], divstep[2], &divider[2], &error) != 0U))
+              {
+                /* The VCO input frequency decreases with PLLM */
+                if ((status != HAL_OK) || (error < besterror) ||
+                    ((error == besterror) && (pllfracn == 0U) && (bestpllfracn != 0U)) ||
+                    ((error == besterror) && ((pllfracn == 0U) == (bestpllfracn == 0U)) &&
+                     (pllm == bestpllm) && (pllvcox < bestpllvcox)))
+                {
+                  besterror = error;
+                  bestpllm = pllm;
+                  bestpllfracn = pllfracn;
+                  bestpllvcox = pllvcox;
+
+                  pPLLInit->PLLState  = RCC_PLL_ON;
+                  pPLLInit->PLLSource = pTarget->PLLSource;
+                  pPLLInit->PLLM      = pllm;
+                  pPLLInit->PLLN      = plln;
+                  pPLLInit->PLLFRACN  = pllfracn;
+                  pPLLInit->PLLP      = divider[0];
+                  pPLLInit->PLLQ      = divider[1];
+                  pPLLInit->PLLR      = divider[2];
+                  pPLLInit->PLLRGE    = pllrge[pTarget->PLLx - 1U][rangeindex];
+                  pPLLInit->PLLVCOSEL = pllvcosel[pTarget->PLLx - 1U][medium];
+
+                  status = HAL_OK;
+                }
+              }
+            }
+
+            div += divstep[output];
+          }
+        }
+      }
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @defgroup RCCEx_Private_Functions RCCEx Private Functions
+  * @{
+  */
+
+/**
+  * @brief  Select the PLL output divider closest to a target frequency.
+  * @param  PLLVCOFreq  VCO output frequency in Hz, multiplied by PLLFRACN_RESOLUTION.
+  * @param  Freq  Target frequency in Hz, 0 when the output is not used.
+  * @param  Tolerance  Maximum deviation from Freq in Hz.
+  * @param  DivMin  Lowest divider value.
+  * @param  DivStep  Step between two divider values.
+  * @param  pDivider  Selected divider.
+  * @param  pError  Incremented by the deviation from Freq of the selected divider.
+  * @retval 1 when the deviation is within Tolerance, 0 otherwise
+  */
+static uint32_t RCCEx_PLLSelectDivider(uint64_t PLLVCOFreq, uint32_t Freq, uint32_t Tolerance, uint32_t DivMin,
+                                       uint32_t DivStep, uint32_t *pDivider, uint32_t *pError)
+{
+  uint32_t divider;
+  uint32_t candidate;
+  uint32_t outfreq;
+  uint32_t deviation;
+  uint32_t bestdeviation = 0xFFFFFFFFU;
+
+  if (Freq == 0U)
+  {
+    /* Unused output: lowest frequency */
+    *pDivider = PLLDIV_MAX;
+    return 1U;
+  }
+
+  /* Divider values around PLLVCOFreq / Freq */
+  divider = (uint32_t)(PLLVCOFreq / ((uint64_t)Freq * PLLFRACN_RESOLUTION));
+  divider = (divider > DivMin) ? (DivMin + (((divider - DivMin) / DivStep) * DivStep)) : DivMin;
+  divider = (divider > PLLDIV_MAX) ? PLLDIV_MAX : divider;
+
+  for (candidate = divider; (candidate <= (divider + DivStep)) && (candidate <= PLLDIV_MAX); candidate += DivStep)
+  {
+    outfreq = (uint32_t)(PLLVCOFreq / ((uint64_t)candidate * PLLFRACN_RESOLUTION));
+    deviation = (outfreq > Freq) ? (outfreq - Freq) : (Freq - outfreq);
+
+    if (deviation < bestdeviation)
+    {
+      bestdeviation = deviation;
+      *pDivider = candidate;
+    }
+  }
+
+  *pError += bestdeviation;
+
+  return (bestdeviation <= Tolerance) ? 1U : 0U;
+}
+
+/**
+  * @}
+  */
+
+#endif /* HAL_RCC_MODULE_ENABLED */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
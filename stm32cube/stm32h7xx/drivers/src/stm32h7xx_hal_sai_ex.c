@@ -6,6 +6,7 @@
   *          This file provides firmware functions to manage the following
   *          functionality of the SAI Peripheral Controller:
   *           + Modify PDM microphone delays.
+  *           + Stream audio through a DMA ring with clock drift compensation.
   *
   ******************************************************************************
   * @attention
@@ -18,6 +19,45 @@
   * If no LICENSE file comes with this software, it is provided AS-IS.
   *
   ******************************************************************************
+  @verbatim
+  ==============================================================================
+                   ##### How to use the audio streaming functions #####
+  ==============================================================================
+  [..]
+    The streaming functions bridge an audio producer and consumer running on
+    slightly different clocks (USB, network and SAI domains) with a bounded
+    latency:
+
+    (#) Initialize the SAI handle and its DMA handle as usual. The DMA must be
+        configured in DMA_CIRCULAR mode.
+    (#) Fill a SAIEx_StreamInitTypeDef structure with the ring geometry
+        (BlockCount blocks of BlockSize bytes), the frame size, the target and
+        maximum fill levels and the drift correction mode, then call
+        HAL_SAIEx_StreamInit().
+    (#) Call HAL_SAIEx_StreamStart() to start the circular DMA over the ring.
+        In Tx direction the ring is first primed with silence up to the target level.
+    (#) Feed the stream with HAL_SAIEx_StreamWrite() (Tx) or drain it with
+        HAL_SAIEx_StreamRead() (Rx) from the application domain.
+    (#) Call HAL_SAIEx_StreamUpdate() at least twice per ring period, typically
+        from HAL_SAI_TxHalfCpltCallback()/HAL_SAI_TxCpltCallback() (or their Rx
+        counterparts). It tracks the DMA position, runs the fill-level servo and
+        applies the correction:
+        (++) SAIEX_STREAM_CORRECTION_PLL trims the fractional multiplier of the
+             PLL feeding the SAI kernel clock (asynchronous rate conversion in hardware).
+             The trim moves every output of that PLL: SAIEX_STREAM_PLL1 is
+             rejected while PLL1 is the system clock source, and its P and R
+             outputs must not clock other peripherals.
+        (++) SAIEX_STREAM_CORRECTION_SAMPLE inserts or drops one frame in the next
+             HAL_SAIEx_StreamWrite()/HAL_SAIEx_StreamRead() call.
+    (#) Use HAL_SAIEx_StreamGetStats() to retrieve fill-level jitter, underrun,
+        overrun and correction statistics.
+    (#) Call HAL_SAIEx_StreamStop() to stop the DMA.
+
+    (@) The ring buffer is accessed by the DMA: it must be placed in a memory
+        reachable by the selected DMA and kept coherent with the D-Cache by the
+        application (non-cacheable MPU region or cache maintenance).
+  @endverbatim
+  ******************************************************************************
   */
 
 /* Includes ------------------------------------------------------------------*/
@@ -40,7 +80,29 @@
 #define SAI_PDM_DELAY_OFFSET        8U
 #define SAI_PDM_RIGHT_DELAY_OFFSET  4U
 
+#define SAIEX_STREAM_Q16_ONE        0x10000L
+#define SAIEX_STREAM_INTEGRATOR_MAX 0x8000L
+#define SAIEX_STREAM_OUTPUT_MAX     0x7FFF0000L  /* Servo output bound, SlipFraction + output fits in int32_t */
+#define SAIEX_STREAM_AVERAGE_SHIFT  4U
+
 /* Private macros ------------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup SAIEx_Private_Functions SAIEx Private Functions
+  * @{
+  */
+static DMA_HandleTypeDef *SAIEx_StreamGetDMA(const SAIEx_StreamTypeDef *hstream);
+static uint32_t SAIEx_StreamGetHwIndex(const SAIEx_StreamTypeDef *hstream);
+static uint32_t SAIEx_StreamGetHwTotal(const SAIEx_StreamTypeDef *hstream, uint32_t *pHwIndex);
+static int32_t  SAIEx_StreamComputeLevel(const SAIEx_StreamTypeDef *hstream);
+static void     SAIEx_StreamResync(SAIEx_StreamTypeDef *hstream);
+static int32_t  SAIEx_StreamGetSlip(const SAIEx_StreamTypeDef *hstream);
+static void     SAIEx_StreamCopy(SAIEx_StreamTypeDef *hstream, uint8_t *pDst, const uint8_t *pSrc,
+                                 uint32_t NbFrames, uint32_t ToRing);
+static void     SAIEx_StreamSetPLLFrac(uint32_t PLLSource, uint32_t PLLFrac);
+/**
+  * @}
+  */
+
 /* Private functions ---------------------------------------------------------*/
 /* Exported functions --------------------------------------------------------*/
 /** @defgroup SAIEx_Exported_Functions SAIEx Extended Exported Functions
@@ -119,6 +181,809 @@ HAL_StatusTypeDef HAL_SAIEx_ConfigPdmMicDelay(const SAI_HandleTypeDef *hsai,
   * @}
   */
 
+/** @defgroup SAIEx_Exported_Functions_Group2 Audio streaming functions
+  * @brief    SAIEx audio streaming functions
+  *
+@verbatim
+ ===============================================================================
+                 ##### Audio streaming functions #####
+ ===============================================================================
+    [..]  This section provides functions allowing to:
+      (+) Initialize, start and stop an audio stream over a circular DMA ring
+      (+) Write or read audio frames with bounded latency
+      (+) Compensate clock drift by fractional PLL trim or frame insert/drop
+      (+) Retrieve fill-level and correction statistics
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize an audio stream on top of a SAI handle.
+  * @param  hstream Audio stream handle.
+  * @param  hsai SAI handle, initialized, with a circular DMA handle linked.
+  * @param  pInit Stream configuration.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SAIEx_StreamInit(SAIEx_StreamTypeDef *hstream, SAI_HandleTypeDef *hsai,
+                                       const SAIEx_StreamInitTypeDef *pInit)
+{
+  DMA_HandleTypeDef *hdma;
+  uint32_t ringsize;
+
+  if ((hstream == NULL) || (hsai == NULL) || (pInit == NULL) || (pInit->pBuffer == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  assert_param(IS_SAIEX_STREAM_DIRECTION(pInit->Direction));
+  assert_param(IS_SAIEX_STREAM_BLOCK_COUNT(pInit->BlockCount));
+  assert_param(IS_SAIEX_STREAM_CORRECTION(pInit->CorrectionMode));
+
+  if (hstream->State == SAIEX_STREAM_STATE_RUNNING)
+  {
+    return HAL_BUSY;
+  }
+
+  hstream->hsai = hsai;
+  hstream->Init = *pInit;
+  hdma = SAIEx_StreamGetDMA(hstream);
+
+  /* The stream relies on a circular DMA over the whole ring */
+  if ((hdma == NULL) || (hdma->Init.Mode != DMA_CIRCULAR))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Get the DMA memory data width */
+  if (hdma->Init.MemDataAlignment == DMA_MDATAALIGN_BYTE)
+  {
+    hstream->ItemSize = 1U;
+  }
+  else if (hdma->Init.MemDataAlignment == DMA_MDATAALIGN_HALFWORD)
+  {
+    hstream->ItemSize = 2U;
+  }
+  else
+  {
+    hstream->ItemSize = 4U;
+  }
+
+  /* Check the ring geometry */
+  ringsize = pInit->BlockSize * pInit->BlockCount;
+  if ((pInit->FrameSize == 0U) || ((pInit->FrameSize % hstream->ItemSize) != 0U) ||
+      ((pInit->BlockSize % pInit->FrameSize) != 0U) || (pInit->BlockCount < 2U) ||
+      ((ringsize / hstream->ItemSize) > 0xFFFFU))
+  {
+    return HAL_ERROR;
+  }
+  hstream->RingFrames = ringsize / pInit->FrameSize;
+
+  /* Default latency settings */
+  if (hstream->Init.MaxLevel == 0U)
+  {
+    hstream->Init.MaxLevel = ((pInit->BlockCount - 1U) * pInit->BlockSize) / pInit->FrameSize;
+  }
+  if (hstream->Init.TargetLevel == 0U)
+  {
+    hstream->Init.TargetLevel = hstream->RingFrames / 2U;
+  }
+  if ((hstream->Init.MaxLevel >= hstream->RingFrames) || (hstream->Init.TargetLevel > hstream->Init.MaxLevel))
+  {
+    return HAL_ERROR;
+  }
+
+  if (pInit->CorrectionMode == SAIEX_STREAM_CORRECTION_PLL)
+  {
+    assert_param(IS_SAIEX_STREAM_PLL(pInit->PLLSource));
+    assert_param(IS_SAIEX_STREAM_PLL_FRACN(pInit->PLLFracNominal));
+
+    if ((pInit->PLLFracNominal < pInit->PLLFracRange) || ((pInit->PLLFracNominal + pInit->PLLFracRange) > 8191U))
+    {
+      return HAL_ERROR;
+    }
+
+    /* Trimming PLL1 while it clocks the system would move SYSCLK, the SysTick and every bus clock */
+    if ((pInit->PLLSource == SAIEX_STREAM_PLL1) &&
+        (__HAL_RCC_GET_SYSCLK_SOURCE() == RCC_SYSCLKSOURCE_STATUS_PLLCLK))
+    {
+      return HAL_ERROR;
+    }
+  }
+  hstream->PLLFrac = pInit->PLLFracNominal;
+
+  hstream->AppIndex = 0U;
+  hstream->AppTotal = 0U;
+  hstream->HwTotal = 0U;
+  hstream->HwIndex = 0U;
+  hstream->Integrator = 0;
+  hstream->SlipFraction = 0;
+  hstream->SlipRequested = 0U;
+  hstream->SlipApplied = 0U;
+  HAL_SAIEx_StreamResetStats(hstream);
+
+  hstream->State = SAIEX_STREAM_STATE_READY;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Start the circular DMA over the stream ring.
+  * @note   In Tx direction the ring is primed with TargetLevel frames of silence.
+  * @param  hstream Audio stream handle.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SAIEx_StreamStart(SAIEx_StreamTypeDef *hstream)
+{
+  HAL_StatusTypeDef status;
+  uint32_t ringsize = hstream->RingFrames * hstream->Init.FrameSize;
+  uint32_t index;
+
+  if (hstream->State != SAIEX_STREAM_STATE_READY)
+  {
+    return HAL_ERROR;
+  }
+
+  for (index = 0U; index < ringsize; index++)
+  {
+    hstream->Init.pBuffer[index] = 0U;
+  }
+
+  hstream->HwTotal = 0U;
+  hstream->HwIndex = 0U;
+  hstream->Integrator = 0;
+  hstream->SlipFraction = 0;
+  hstream->SlipRequested = 0U;
+  hstream->SlipApplied = 0U;
+
+  if (hstream->Init.CorrectionMode == SAIEX_STREAM_CORRECTION_PLL)
+  {
+    hstream->PLLFrac = hstream->Init.PLLFracNominal;
+    SAIEx_StreamSetPLLFrac(hstream->Init.PLLSource, hstream->PLLFrac);
+  }
+
+  if (hstream->Init.Direction == SAIEX_STREAM_TX)
+  {
+    /* Silence already queued ahead of the DMA sets the initial latency */
+    hstream->AppIndex = hstream->Init.TargetLevel;
+    hstream->AppTotal = hstream->Init.TargetLevel;
+    status = HAL_SAI_Transmit_DMA(hstream->hsai, hstream->Init.pBuffer, (uint16_t)(ringsize / hstream->ItemSize));
+  }
+  else
+  {
+    hstream->AppIndex = 0U;
+    hstream->AppTotal = 0U;
+    status = HAL_SAI_Receive_DMA(hstream->hsai, hstream->Init.pBuffer, (uint16_t)(ringsize / hstream->ItemSize));
+  }
+
+  if (status == HAL_OK)
+  {
+    hstream->State = SAIEX_STREAM_STATE_RUNNING;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Stop the stream DMA.
+  * @note   In PLL correction mode the nominal fractional value is restored.
+  * @param  hstream Audio stream handle.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SAIEx_StreamStop(SAIEx_StreamTypeDef *hstream)
+{
+  HAL_StatusTypeDef status;
+
+  if (hstream->State != SAIEX_STREAM_STATE_RUNNING)
+  {
+    return HAL_ERROR;
+  }
+
+  status = HAL_SAI_DMAStop(hstream->hsai);
+
+  if (hstream->Init.CorrectionMode == SAIEX_STREAM_CORRECTION_PLL)
+  {
+    hstream->PLLFrac = hstream->Init.PLLFracNominal;
+    SAIEx_StreamSetPLLFrac(hstream->Init.PLLSource, hstream->PLLFrac);
+  }
+
+  hstream->State = SAIEX_STREAM_STATE_READY;
+
+  return status;
+}
+
+/**
+  * @brief  Queue audio frames for transmission (Tx direction).
+  * @note   Frames that would raise the fill level above MaxLevel are discarded.
+  * @note   In sample correction mode, one frame of pData may be dropped or the
+  *         last frame duplicated to absorb the pending drift.
+  * @param  hstream Audio stream handle.
+  * @param  pData Pointer to the frames to queue.
+  * @param  NbFrames Number of frames in pData.
+  * @retval Number of frames taken from pData.
+  */
+uint32_t HAL_SAIEx_StreamWrite(SAIEx_StreamTypeDef *hstream, const uint8_t *pData, uint32_t NbFrames)
+{
+  int32_t level;
+  int32_t slip;
+  uint32_t space;
+  uint32_t count;
+  uint32_t frameSize = hstream->Init.FrameSize;
+
+  if ((hstream->State != SAIEX_STREAM_STATE_RUNNING) || (hstream->Init.Direction != SAIEX_STREAM_TX) ||
+      (NbFrames == 0U))
+  {
+    return 0U;
+  }
+
+  level = SAIEx_StreamComputeLevel(hstream);
+  if (level < 0)
+  {
+    /* The SAI played stale data: restart from the target latency */
+    hstream->Stats.Underruns++;
+    SAIEx_StreamResync(hstream);
+    level = (int32_t)hstream->Init.TargetLevel;
+  }
+
+  /* Consume the pending sample correction */
+  slip = SAIEx_StreamGetSlip(hstream);
+
+  if ((slip > 0) && (NbFrames > 1U))
+  {
+    /* Producer is ahead: skip the first frame */
+    pData = &pData[frameSize];
+    NbFrames--;
+    hstream->SlipApplied++;
+    hstream->Stats.FramesDropped++;
+  }
+  else
+  {
+    slip = (slip < 0) ? -1 : 0;
+  }
+
+  space = hstream->Init.MaxLevel - (uint32_t)level;
+  if ((uint32_t)level >= hstream->Init.MaxLevel)
+  {
+    space = 0U;
+  }
+
+  count = (NbFrames < space) ? NbFrames : space;
+  if (count < NbFrames)
+  {
+    hstream->Stats.Overruns++;
+  }
+
+  if (count != 0U)
+  {
+    SAIEx_StreamCopy(hstream, NULL, pData, count, 1U);
+
+    if ((slip < 0) && (count < space))
+    {
+      /* Producer is behind: repeat the last frame */
+      SAIEx_StreamCopy(hstream, NULL, &pData[(count - 1U) * frameSize], 1U, 1U);
+      hstream->SlipApplied--;
+      hstream->Stats.FramesInserted++;
+    }
+  }
+
+  return (slip > 0) ? (count + 1U) : count;
+}
+
+/**
+  * @brief  Retrieve received audio frames (Rx direction).
+  * @note   In sample correction mode, one ring frame may be skipped or the last
+  *         frame duplicated to absorb the pending drift.
+  * @param  hstream Audio stream handle.
+  * @param  pData Pointer to the destination buffer.
+  * @param  NbFrames Number of frames requested.
+  * @retval Number of frames written to pData.
+  */
+uint32_t HAL_SAIEx_StreamRead(SAIEx_StreamTypeDef *hstream, uint8_t *pData, uint32_t NbFrames)
+{
+  int32_t level;
+  int32_t slip;
+  uint32_t count;
+  uint32_t index;
+  uint32_t frameSize = hstream->Init.FrameSize;
+
+  if ((hstream->State != SAIEX_STREAM_STATE_RUNNING) || (hstream->Init.Direction != SAIEX_STREAM_RX) ||
+      (NbFrames == 0U))
+  {
+    return 0U;
+  }
+
+  level = SAIEx_StreamComputeLevel(hstream);
+  if (level > (int32_t)hstream->Init.MaxLevel)
+  {
+    /* The DMA overwrote frames not read yet: restart from the target latency */
+    hstream->Stats.Overruns++;
+    SAIEx_StreamResync(hstream);
+    level = (int32_t)hstream->Init.TargetLevel;
+  }
+  else if (level < 0)
+  {
+    level = 0;
+  }
+  else
+  {
+    /* Level within bounds */
+  }
+
+  /* Consume the pending sample correction */
+  slip = SAIEx_StreamGetSlip(hstream);
+
+  if ((slip > 0) && (level > 1))
+  {
+    /* Producer is ahead: skip one frame */
+    hstream->AppIndex = (hstream->AppIndex + 1U) % hstream->RingFrames;
+    hstream->AppTotal++;
+    hstream->SlipApplied++;
+    hstream->Stats.FramesDropped++;
+    level--;
+  }
+  else if ((slip < 0) && (NbFrames > 1U))
+  {
+    /* Producer is behind: read one frame less, the last frame is repeated */
+    NbFrames--;
+  }
+  else
+  {
+    slip = 0;
+  }
+
+  count = (NbFrames < (uint32_t)level) ? NbFrames : (uint32_t)level;
+  if (count < NbFrames)
+  {
+    hstream->Stats.Underruns++;
+  }
+
+  if (count != 0U)
+  {
+    SAIEx_StreamCopy(hstream, pData, NULL, count, 0U);
+
+    if (slip < 0)
+    {
+      /* Producer is behind: repeat the last frame */
+      for (index = 0U; index < frameSize; index++)
+      {
+        pData[(count * frameSize) + index] = pData[((count - 1U) * frameSize) + index];
+      }
+      count++;
+      hstream->SlipApplied--;
+      hstream->Stats.FramesInserted++;
+    }
+  }
+
+  return count;
+}
+
+/**
+  * @brief  Track the DMA position and run the fill-level servo.
+  * @note   This function must be called at least twice per ring period, for
+  *         instance from the SAI half complete and complete callbacks.
+  * @param  hstream Audio stream handle.
+  * @retval None
+  */
+void HAL_SAIEx_StreamUpdate(SAIEx_StreamTypeDef *hstream)
+{
+  SAIEx_StreamStatsTypeDef *stats = &hstream->Stats;
+  uint32_t hwindex;
+  uint32_t deviation;
+  int32_t level;
+  int32_t error;
+  int64_t servo;
+  int32_t output;
+  uint32_t frac;
+
+  if (hstream->State != SAIEX_STREAM_STATE_RUNNING)
+  {
+    return;
+  }
+
+  /* Accumulate the frames moved by the DMA since the last update */
+  hwindex = SAIEx_StreamGetHwIndex(hstream);
+  hstream->HwTotal += (hwindex + hstream->RingFrames - hstream->HwIndex) % hstream->RingFrames;
+  hstream->HwIndex = hwindex;
+
+  level = SAIEx_StreamComputeLevel(hstream);
+  stats->Updates++;
+
+  /* Fill-level statistics */
+  if (level < 0)
+  {
+    level = 0;
+  }
+  if ((uint32_t)level < stats->LevelMin)
+  {
+    stats->LevelMin = (uint32_t)level;
+  }
+  if ((uint32_t)level > stats->LevelMax)
+  {
+    stats->LevelMax = (uint32_t)level;
+  }
+  stats->LevelAverage = stats->LevelAverage - (stats->LevelAverage >> SAIEX_STREAM_AVERAGE_SHIFT)
+                        + (((uint32_t)level << 8U) >> SAIEX_STREAM_AVERAGE_SHIFT);
+
+  error = level - (int32_t)hstream->Init.TargetLevel;
+  deviation = (error < 0) ? (uint32_t)(-error) : (uint32_t)error;
+  if (deviation > stats->Jitter)
+  {
+    stats->Jitter = deviation;
+  }
+
+  if (hstream->Init.CorrectionMode == SAIEX_STREAM_CORRECTION_NONE)
+  {
+    return;
+  }
+
+  /* PI servo on the fill-level error, output in Q16 */
+  hstream->Integrator += error;
+  if (hstream->Integrator > SAIEX_STREAM_INTEGRATOR_MAX)
+  {
+    hstream->Integrator = SAIEX_STREAM_INTEGRATOR_MAX;
+  }
+  else if (hstream->Integrator < -SAIEX_STREAM_INTEGRATOR_MAX)
+  {
+    hstream->Integrator = -SAIEX_STREAM_INTEGRATOR_MAX;
+  }
+  else
+  {
+    /* Integrator within range */
+  }
+
+  /* 64-bit products: a Q16 gain of 1.0 times the integrator bound already exceeds int32_t */
+  servo = ((int64_t)hstream->Init.ProportionalGain * error) +
+          ((int64_t)hstream->Init.IntegralGain * hstream->Integrator);
+  if (servo > SAIEX_STREAM_OUTPUT_MAX)
+  {
+    output = (int32_t)SAIEX_STREAM_OUTPUT_MAX;
+  }
+  else if (servo < -SAIEX_STREAM_OUTPUT_MAX)
+  {
+    output = -(int32_t)SAIEX_STREAM_OUTPUT_MAX;
+  }
+  else
+  {
+    output = (int32_t)servo;
+  }
+
+  stats->Correction = output;
+  if (output < stats->CorrectionMin)
+  {
+    stats->CorrectionMin = output;
+  }
+  if (output > stats->CorrectionMax)
+  {
+    stats->CorrectionMax = output;
+  }
+
+  if (hstream->Init.CorrectionMode == SAIEX_STREAM_CORRECTION_SAMPLE)
+  {
+    /* Positive output means the producer is ahead: frames are dropped.
+       At most one slip is kept pending in each direction. */
+    hstream->SlipFraction += output;
+    if (hstream->SlipFraction >= SAIEX_STREAM_Q16_ONE)
+    {
+      if (SAIEx_StreamGetSlip(hstream) <= 0)
+      {
+        hstream->SlipRequested++;
+      }
+      hstream->SlipFraction = 0;
+    }
+    else if (hstream->SlipFraction <= -SAIEX_STREAM_Q16_ONE)
+    {
+      if (SAIEx_StreamGetSlip(hstream) >= 0)
+      {
+        hstream->SlipRequested--;
+      }
+      hstream->SlipFraction = 0;
+    }
+    else
+    {
+      /* Less than one frame of drift accumulated */
+    }
+  }
+  else
+  {
+    /* A fuller Tx ring needs a faster SAI clock, a fuller Rx ring a slower one */
+    output /= SAIEX_STREAM_Q16_ONE;
+    if (hstream->Init.Direction == SAIEX_STREAM_RX)
+    {
+      output = -output;
+    }
+    if (output > (int32_t)hstream->Init.PLLFracRange)
+    {
+      output = (int32_t)hstream->Init.PLLFracRange;
+    }
+    else if (output < -(int32_t)hstream->Init.PLLFracRange)
+    {
+      output = -(int32_t)hstream->Init.PLLFracRange;
+    }
+    else
+    {
+      /* Trim within range */
+    }
+
+    frac = (uint32_t)((int32_t)hstream->Init.PLLFracNominal + output);
+    if (frac != hstream->PLLFrac)
+    {
+      hstream->PLLFrac = frac;
+      SAIEx_StreamSetPLLFrac(hstream->Init.PLLSource, frac);
+      stats->PLLUpdates++;
+    }
+  }
+}
+
+/**
+  * @brief  Return the current stream fill level.
+  * @param  hstream Audio stream handle.
+  * @retval Number of frames queued in the ring (negative on underrun).
+  */
+int32_t HAL_SAIEx_StreamGetLevel(const SAIEx_StreamTypeDef *hstream)
+{
+  if (hstream->State != SAIEX_STREAM_STATE_RUNNING)
+  {
+    return 0;
+  }
+
+  return SAIEx_StreamComputeLevel(hstream);
+}
+
+/**
+  * @brief  Retrieve the stream statistics.
+  * @param  hstream Audio stream handle.
+  * @param  pStats Pointer to the structure receiving the statistics.
+  * @retval None
+  */
+void HAL_SAIEx_StreamGetStats(const SAIEx_StreamTypeDef *hstream, SAIEx_StreamStatsTypeDef *pStats)
+{
+  *pStats = hstream->Stats;
+}
+
+/**
+  * @brief  Reset the stream statistics.
+  * @param  hstream Audio stream handle.
+  * @retval None
+  */
+void HAL_SAIEx_StreamResetStats(SAIEx_StreamTypeDef *hstream)
+{
+  SAIEx_StreamStatsTypeDef *stats = &hstream->Stats;
+
+  stats->Updates = 0U;
+  stats->Underruns = 0U;
+  stats->Overruns = 0U;
+  stats->LevelMin = 0xFFFFFFFFU;
+  stats->LevelMax = 0U;
+  stats->LevelAverage = hstream->Init.TargetLevel << 8U;
+  stats->Jitter = 0U;
+  stats->FramesInserted = 0U;
+  stats->FramesDropped = 0U;
+  stats->PLLUpdates = 0U;
+  stats->Correction = 0;
+  stats->CorrectionMin = 0x7FFFFFFF;
+  stats->CorrectionMax = -0x7FFFFFFF - 1;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup SAIEx_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Return the DMA handle moving the stream data.
+  * @param  hstream Audio stream handle.
+  * @retval DMA handle
+  */
+static DMA_HandleTypeDef *SAIEx_StreamGetDMA(const SAIEx_StreamTypeDef *hstream)
+{
+  return (hstream->Init.Direction == SAIEX_STREAM_TX) ? hstream->hsai->hdmatx : hstream->hsai->hdmarx;
+}
+
+/**
+  * @brief  Return the DMA position in the ring.
+  * @param  hstream Audio stream handle.
+  * @retval Index of the next frame the DMA accesses.
+  */
+static uint32_t SAIEx_StreamGetHwIndex(const SAIEx_StreamTypeDef *hstream)
+{
+  const DMA_HandleTypeDef *hdma = SAIEx_StreamGetDMA(hstream);
+  uint32_t items = (hstream->RingFrames * hstream->Init.FrameSize) / hstream->ItemSize;
+  uint32_t remaining = __HAL_DMA_GET_COUNTER(hdma);
+
+  return (((items - remaining) * hstream->ItemSize) / hstream->Init.FrameSize) % hstream->RingFrames;
+}
+
+/**
+  * @brief  Return the frames moved by the DMA since the stream start, from the
+  *         live DMA position.
+  * @note   HwTotal and HwIndex are updated together by HAL_SAIEx_StreamUpdate(),
+  *         typically from the DMA interrupt: they are read with the DMA position
+  *         with the interrupts masked.
+  * @param  hstream Audio stream handle.
+  * @param  pHwIndex Pointer to the DMA position in the ring, or NULL.
+  * @retval Frames consumed (Tx) or produced (Rx) by the DMA.
+  */
+static uint32_t SAIEx_StreamGetHwTotal(const SAIEx_StreamTypeDef *hstream, uint32_t *pHwIndex)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint32_t hwindex;
+  uint32_t hwtotal;
+
+  __disable_irq();
+  hwindex = SAIEx_StreamGetHwIndex(hstream);
+  hwtotal = hstream->HwTotal + ((hwindex + hstream->RingFrames - hstream->HwIndex) % hstream->RingFrames);
+  __set_PRIMASK(primask);
+
+  if (pHwIndex != NULL)
+  {
+    *pHwIndex = hwindex;
+  }
+
+  return hwtotal;
+}
+
+/**
+  * @brief  Compute the fill level from the live DMA position.
+  * @note   This function does not modify the stream so it can run concurrently
+  *         with HAL_SAIEx_StreamUpdate().
+  * @param  hstream Audio stream handle.
+  * @retval Number of frames between the producer and the consumer.
+  */
+static int32_t SAIEx_StreamComputeLevel(const SAIEx_StreamTypeDef *hstream)
+{
+  uint32_t hwtotal = SAIEx_StreamGetHwTotal(hstream, NULL);
+
+  if (hstream->Init.Direction == SAIEX_STREAM_TX)
+  {
+    return (int32_t)(hstream->AppTotal - hwtotal);
+  }
+
+  return (int32_t)(hwtotal - hstream->AppTotal);
+}
+
+/**
+  * @brief  Move the application position back to the target latency.
+  * @param  hstream Audio stream handle.
+  * @retval None
+  */
+static void SAIEx_StreamResync(SAIEx_StreamTypeDef *hstream)
+{
+  uint32_t hwindex;
+  uint32_t hwtotal = SAIEx_StreamGetHwTotal(hstream, &hwindex);
+  uint32_t target = hstream->Init.TargetLevel;
+  uint32_t frameSize = hstream->Init.FrameSize;
+  uint32_t index;
+  uint32_t byte;
+  uint32_t offset;
+
+  if (hstream->Init.Direction == SAIEX_STREAM_TX)
+  {
+    /* Queue silence up to the target level */
+    for (index = 0U; index < target; index++)
+    {
+      offset = ((hwindex + index) % hstream->RingFrames) * frameSize;
+      for (byte = 0U; byte < frameSize; byte++)
+      {
+        hstream->Init.pBuffer[offset + byte] = 0U;
+      }
+    }
+    hstream->AppIndex = (hwindex + target) % hstream->RingFrames;
+    hstream->AppTotal = hwtotal + target;
+  }
+  else
+  {
+    hstream->AppIndex = (hwindex + hstream->RingFrames - target) % hstream->RingFrames;
+    hstream->AppTotal = hwtotal - target;
+  }
+
+  /* Pending slips are meaningless after a resync */
+  hstream->SlipApplied = hstream->SlipRequested;
+}
+
+/**
+  * @brief  Return the frame slips requested by the servo and not applied yet.
+  * @param  hstream Audio stream handle.
+  * @retval Positive to drop frames, negative to insert frames.
+  */
+static int32_t SAIEx_StreamGetSlip(const SAIEx_StreamTypeDef *hstream)
+{
+  if (hstream->Init.CorrectionMode != SAIEX_STREAM_CORRECTION_SAMPLE)
+  {
+    return 0;
+  }
+
+  return (int32_t)(hstream->SlipRequested - hstream->SlipApplied);
+}
+
+/**
+  * @brief  Copy frames between the ring and an application buffer.
+  * @param  hstream Audio stream handle.
+  * @param  pDst Destination buffer (ToRing = 0).
+  * @param  pSrc Source buffer (ToRing = 1).
+  * @param  NbFrames Number of frames to copy.
+  * @param  ToRing 1 to copy into the ring, 0 to copy out of it.
+  * @retval None
+  */
+static void SAIEx_StreamCopy(SAIEx_StreamTypeDef *hstream, uint8_t *pDst, const uint8_t *pSrc,
+                             uint32_t NbFrames, uint32_t ToRing)
+{
+  uint32_t frameSize = hstream->Init.FrameSize;
+  uint32_t chunk;
+  uint32_t size;
+  uint32_t index;
+  uint8_t *pRing;
+
+  while (NbFrames != 0U)
+  {
+    /* Copy up to the end of the ring, then wrap */
+    chunk = hstream->RingFrames - hstream->AppIndex;
+    if (chunk > NbFrames)
+    {
+      chunk = NbFrames;
+    }
+    pRing = &hstream->Init.pBuffer[hstream->AppIndex * frameSize];
+    size = chunk * frameSize;
+
+    if (ToRing != 0U)
+    {
+      for (index = 0U; index < size; index++)
+      {
+        pRing[index] = pSrc[index];
+      }
+      pSrc = &pSrc[size];
+    }
+    else
+    {
+      for (index = 0U; index < size; index++)
+      {
+        pDst[index] = pRing[index];
+      }
+      pDst = &pDst[size];
+    }
+
+    hstream->AppIndex = (hstream->AppIndex + chunk) % hstream->RingFrames;
+    hstream->AppTotal += chunk;
+    NbFrames -= chunk;
+  }
+}
+
+/**
+  * @brief  Apply a new fractional multiplier to the PLL feeding the SAI.
+  * @note   The new FRACN value is latched on the FRACEN rising edge, the PLL
+  *         keeps running so the SAI clock is trimmed without glitch.
+  * @param  PLLSource PLL to trim, a value of @ref SAIEx_Stream_PLL_Source
+  * @param  PLLFrac Fractional part of the multiplication factor.
+  * @retval None
+  */
+static void SAIEx_StreamSetPLLFrac(uint32_t PLLSource, uint32_t PLLFrac)
+{
+  if (PLLSource == SAIEX_STREAM_PLL1)
+  {
+    __HAL_RCC_PLLFRACN_DISABLE();
+    __HAL_RCC_PLLFRACN_CONFIG(PLLFrac);
+    __HAL_RCC_PLLFRACN_ENABLE();
+  }
+  else if (PLLSource == SAIEX_STREAM_PLL2)
+  {
+    __HAL_RCC_PLL2FRACN_DISABLE();
+    __HAL_RCC_PLL2FRACN_CONFIG(PLLFrac);
+    __HAL_RCC_PLL2FRACN_ENABLE();
+  }
+  else
+  {
+    __HAL_RCC_PLL3FRACN_DISABLE();
+    __HAL_RCC_PLL3FRACN_CONFIG(PLLFrac);
+    __HAL_RCC_PLL3FRACN_ENABLE();
+  }
+}
+
 /**
   * @}
   */
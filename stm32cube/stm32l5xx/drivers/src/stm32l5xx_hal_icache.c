@@ -9,6 +9,7 @@
   *           + Invalidate functions
   *           + Monitoring management
   *           + Memory address remap management
+  *           + Monitor sampling
   ******************************************************************************
   * @attention
   *
@@ -70,6 +71,24 @@
         memories to the internal Code region for execution with
         @ref HAL_ICACHE_EnableRemapRegion() and @ref HAL_ICACHE_DisableRemapRegion()
 
+    (#) Sample the performance monitoring counters periodically:
+        (++) Start the sampler with @ref HAL_ICACHE_Sampler_Init(), giving it a ring of
+             samples. The Hit and Miss monitors are started and reset.
+        (++) Call @ref HAL_ICACHE_Sampler_Sample() periodically, for instance from a
+             timer callback, before the 16-bit Miss monitor saturates. Each call reads
+             and resets the monitors and stores a sample, the oldest one being
+             overwritten when the ring is full.
+        (++) Call @ref HAL_ICACHE_Sampler_SetTag() on task switches or on code region
+             entry and exit to attribute the next samples to a task or region.
+        (++) Export the time series with @ref HAL_ICACHE_Sampler_GetSample() and get a
+             rolling hit ratio over the last samples of a tag with
+             @ref HAL_ICACHE_Sampler_GetTotals().
+        (++) To compare two cache configurations on a live workload, alternate them
+             periodically (@ref HAL_ICACHE_Disable(), @ref HAL_ICACHE_ConfigAssociativityMode(),
+             @ref HAL_ICACHE_Enable()), call @ref HAL_ICACHE_Sampler_SetConfig() after each
+             change and compare the totals of each configuration.
+        (++) Stop the monitors with @ref HAL_ICACHE_Sampler_Stop().
+
   @endverbatim
   */
 
@@ -93,6 +112,9 @@
   */
 #define ICACHE_INVALIDATE_TIMEOUT_VALUE        1U   /* 1ms */
 #define ICACHE_DISABLE_TIMEOUT_VALUE           1U   /* 1ms */
+#define ICACHE_MONITOR_HIT_MAX                 0xFFFFFFFFU  /* Saturation value of the Hit monitor */
+#define ICACHE_MONITOR_MISS_MAX                0xFFFFU      /* Saturation value of the Miss monitor */
+#define ICACHE_SAMPLER_RATIO_SCALE             10000U       /* Hit ratio unit, per ten thousand */
 
 /**
   * @}
@@ -634,6 +656,246 @@ HAL_StatusTypeDef  HAL_ICACHE_DisableRemapRegion(uint32_t Region)
 }
 
 
+/**
+  * @}
+  */
+
+/** @defgroup ICACHE_Exported_Functions_Group4 Monitor sampling functions
+  * @brief    Monitor sampling functions
+  *
+  @verbatim
+  ==============================================================================
+                 ##### Monitor sampling functions #####
+  ==============================================================================
+  [..]
+    The sampler reads and resets the Hit and Miss monitors at each sample, so
+    that they never saturate when sampled often enough, and keeps a ring of
+    samples tagged with the task or code region and the cache configuration
+    active when they were taken.
+    The sampling functions may be called from interrupt context, they mask the
+    interrupts while they update the ring; the functions reading samples must
+    not be preempted by them to get a consistent result.
+
+  @endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize the Instruction Cache monitor sampler and start the monitors.
+  * @note   Tag and Config are reset to 0 and GetTime is set to HAL_GetTick(); it may be
+  *         replaced by a faster timestamp source after this call.
+  * @param  hsampler  Pointer to the sampler
+  * @param  pSamples  Pointer to the sample ring storage
+  * @param  Depth     Number of entries of pSamples
+  * @retval HAL status (HAL_OK/HAL_ERROR)
+  */
+HAL_StatusTypeDef HAL_ICACHE_Sampler_Init(ICACHE_SamplerTypeDef *hsampler, ICACHE_SampleTypeDef *pSamples,
+                                          uint32_t Depth)
+{
+  if ((hsampler == NULL) || (pSamples == NULL) || (Depth == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  hsampler->pSamples = pSamples;
+  hsampler->Depth = Depth;
+  hsampler->Head = 0U;
+  hsampler->Count = 0U;
+  hsampler->Tag = 0U;
+  hsampler->Config = 0U;
+  hsampler->Saturated = 0U;
+  hsampler->GetTime = HAL_GetTick;
+
+  (void)HAL_ICACHE_Monitor_Reset(ICACHE_MONITOR_HIT_MISS);
+
+  return HAL_ICACHE_Monitor_Start(ICACHE_MONITOR_HIT_MISS);
+}
+
+/**
+  * @brief  Stop the Instruction Cache monitors used by the sampler.
+  * @note   The samples remain available.
+  * @param  hsampler  Pointer to the sampler
+  * @retval HAL status (HAL_OK/HAL_ERROR)
+  */
+HAL_StatusTypeDef HAL_ICACHE_Sampler_Stop(const ICACHE_SamplerTypeDef *hsampler)
+{
+  if (hsampler == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  return HAL_ICACHE_Monitor_Stop(ICACHE_MONITOR_HIT_MISS);
+}
+
+/**
+  * @brief  Take a sample of the Instruction Cache monitors.
+  * @note   The monitors are read then reset; the accesses occurring between the
+  *         read and the reset are not counted.
+  * @param  hsampler  Pointer to the sampler
+  * @retval None
+  */
+void HAL_ICACHE_Sampler_Sample(ICACHE_SamplerTypeDef *hsampler)
+{
+  ICACHE_SampleTypeDef *p_sample;
+  uint32_t hit;
+  uint32_t miss;
+  uint32_t primask_bit;
+
+  /* The ring is updated from thread and interrupt context */
+  primask_bit = __get_PRIMASK();
+  __disable_irq();
+
+  hit = ICACHE->HMONR;
+  miss = ICACHE->MMONR;
+  (void)HAL_ICACHE_Monitor_Reset(ICACHE_MONITOR_HIT_MISS);
+
+  if ((hit == ICACHE_MONITOR_HIT_MAX) || (miss >= ICACHE_MONITOR_MISS_MAX))
+  {
+    hsampler->Saturated++;
+  }
+
+  p_sample = &hsampler->pSamples[hsampler->Head];
+  p_sample->Timestamp = hsampler->GetTime();
+  p_sample->Hit = hit;
+  p_sample->Miss = (uint16_t)miss;
+  p_sample->Tag = hsampler->Tag;
+  p_sample->Config = hsampler->Config;
+
+  hsampler->Head = ((hsampler->Head + 1U) == hsampler->Depth) ? 0U : (hsampler->Head + 1U);
+  if (hsampler->Count < hsampler->Depth)
+  {
+    hsampler->Count++;
+  }
+
+  __set_PRIMASK(primask_bit);
+}
+
+/**
+  * @brief  Attribute the next samples to a task or code region.
+  * @note   A sample is taken first to close the window of the previous tag.
+  * @param  hsampler  Pointer to the sampler
+  * @param  Tag       Task or code region identifier, ICACHE_SAMPLER_ANY excepted
+  * @retval None
+  */
+void HAL_ICACHE_Sampler_SetTag(ICACHE_SamplerTypeDef *hsampler, uint8_t Tag)
+{
+  uint32_t primask_bit;
+
+  /* No sample from an interrupt between the window closed and the switch */
+  primask_bit = __get_PRIMASK();
+  __disable_irq();
+  HAL_ICACHE_Sampler_Sample(hsampler);
+  hsampler->Tag = Tag;
+  __set_PRIMASK(primask_bit);
+}
+
+/**
+  * @brief  Attribute the next samples to a cache configuration.
+  * @note   A sample is taken first to close the window of the previous configuration.
+  *         The configuration itself is applied by the caller.
+  * @param  hsampler  Pointer to the sampler
+  * @param  Config    Cache configuration identifier, ICACHE_SAMPLER_ANY excepted
+  * @retval None
+  */
+void HAL_ICACHE_Sampler_SetConfig(ICACHE_SamplerTypeDef *hsampler, uint8_t Config)
+{
+  uint32_t primask_bit;
+
+  /* No sample from an interrupt between the window closed and the switch */
+  primask_bit = __get_PRIMASK();
+  __disable_irq();
+  HAL_ICACHE_Sampler_Sample(hsampler);
+  hsampler->Config = Config;
+  __set_PRIMASK(primask_bit);
+}
+
+/**
+  * @brief  Get a sample of the ring.
+  * @param  hsampler  Pointer to the sampler
+  * @param  Index     Sample index, 0 being the oldest sample
+  * @param  pSample   Pointer to the sample filled
+  * @retval HAL status (HAL_OK/HAL_ERROR)
+  */
+HAL_StatusTypeDef HAL_ICACHE_Sampler_GetSample(const ICACHE_SamplerTypeDef *hsampler, uint32_t Index,
+                                               ICACHE_SampleTypeDef *pSample)
+{
+  uint32_t position;
+
+  if ((hsampler == NULL) || (pSample == NULL) || (Index >= hsampler->Count))
+  {
+    return HAL_ERROR;
+  }
+
+  position = hsampler->Head + hsampler->Depth - hsampler->Count + Index;
+  if (position >= hsampler->Depth)
+  {
+    position -= hsampler->Depth;
+  }
+
+  *pSample = hsampler->pSamples[position];
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Sum the most recent samples of a tag and configuration.
+  * @param  hsampler  Pointer to the sampler
+  * @param  Tag       Task or code region identifier, or ICACHE_SAMPLER_ANY
+  * @param  Config    Cache configuration identifier, or ICACHE_SAMPLER_ANY
+  * @param  Window    Number of most recent samples examined, 0 for all the samples
+  * @param  pTotals   Pointer to the totals filled
+  * @retval HAL status (HAL_OK/HAL_ERROR)
+  */
+HAL_StatusTypeDef HAL_ICACHE_Sampler_GetTotals(const ICACHE_SamplerTypeDef *hsampler, uint8_t Tag, uint8_t Config,
+                                               uint32_t Window, ICACHE_SamplerTotalsTypeDef *pTotals)
+{
+  const ICACHE_SampleTypeDef *p_sample;
+  uint32_t position;
+  uint32_t count;
+  uint64_t accesses;
+
+  if ((hsampler == NULL) || (pTotals == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  pTotals->Hit = 0U;
+  pTotals->Miss = 0U;
+  pTotals->SampleNbr = 0U;
+  pTotals->HitRatio = 0U;
+
+  count = hsampler->Count;
+  if ((Window != 0U) && (Window < count))
+  {
+    count = Window;
+  }
+
+  /* Walk back from the most recent sample */
+  position = hsampler->Head;
+  while (count != 0U)
+  {
+    position = (position == 0U) ? (hsampler->Depth - 1U) : (position - 1U);
+    p_sample = &hsampler->pSamples[position];
+
+    if (((Tag == ICACHE_SAMPLER_ANY) || (p_sample->Tag == Tag)) &&
+        ((Config == ICACHE_SAMPLER_ANY) || (p_sample->Config == Config)))
+    {
+      pTotals->Hit += p_sample->Hit;
+      pTotals->Miss += p_sample->Miss;
+      pTotals->SampleNbr++;
+    }
+    count--;
+  }
+
+  accesses = pTotals->Hit + pTotals->Miss;
+  if (accesses != 0U)
+  {
+    pTotals->HitRatio = (uint32_t)((pTotals->Hit * ICACHE_SAMPLER_RATIO_SCALE) / accesses);
+  }
+
+  return HAL_OK;
+}
+
 /**
   * @}
   */
@@ -0,0 +1,178 @@
+/**
+  ******************************************************************************
+  * @file    stm32mp1xx_hal_ipcc_ex.h
+  * @brief   Header file of Mailbox HAL Extended module.
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32MP1xx_HAL_IPCC_EX_H
+#define STM32MP1xx_HAL_IPCC_EX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32mp1xx_hal_def.h"
+
+/** @addtogroup STM32MP1xx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup IPCCEx
+  * @{
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup IPCCEx_Exported_Constants IPCCEx Exported Constants
+  * @{
+  */
+
+/** @defgroup IPCCEx_Slot_Header IPCCEx channel slot header
+  * @{
+  */
+#define IPCCEX_SLOT_HEADER          4U    /*!< Bytes at the start of each slot holding the message length */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup IPCCEx_Exported_Types IPCCEx Exported Types
+  * @{
+  */
+
+/**
+  * @brief  IPCC channel ring control block, at the start of the shared memory of each direction
+  */
+typedef struct
+{
+  __IO uint32_t Head;       /*!< Messages published, written by the sender only   */
+  __IO uint32_t Tail;       /*!< Messages consumed, written by the receiver only  */
+} IPCCEx_RingCtrlTypeDef;
+
+/**
+  * @brief  IPCC channel ring, one direction of a channel
+  */
+typedef struct
+{
+  IPCCEx_RingCtrlTypeDef  *pCtrl;     /*!< Shared control block                         */
+  uint8_t                 *pSlots;    /*!< Shared slots, following the control block    */
+} IPCCEx_RingTypeDef;
+
+/**
+  * @brief  IPCC channel statistics
+  */
+typedef struct
+{
+  uint32_t TxMessages;      /*!< Messages written                                                  */
+  uint32_t RxMessages;      /*!< Messages processed                                                */
+  uint32_t Notifications;   /*!< Flushes notifying the peer                                        */
+  uint32_t Suppressed;      /*!< Flushes not notifying the peer, still busy with previous messages */
+  uint32_t Batches;         /*!< Receive batches, each returning its credits at once               */
+  uint32_t CreditRefresh;   /*!< Reads of the peer Tail to get credits back                        */
+  uint32_t NoCredit;        /*!< Writes refused because the peer ring was full                     */
+} IPCCEx_ChannelStatsTypeDef;
+
+/**
+  * @brief  IPCC channel handle, a duplex message link over one IPCC channel
+  */
+typedef struct __IPCCEx_ChannelTypeDef
+{
+  IPCC_HandleTypeDef          *hipcc;           /*!< IPCC handle                                          */
+  uint32_t                    ChannelIndex;     /*!< IPCC channel, a value of @ref IPCC_Channel           */
+  IPCCEx_RingTypeDef          Tx;               /*!< Ring of the messages sent to the peer                */
+  IPCCEx_RingTypeDef          Rx;               /*!< Ring of the messages received from the peer          */
+  uint32_t                    SlotSize;         /*!< Bytes per slot, header included, multiple of 4       */
+  uint32_t                    SlotNbr;          /*!< Number of slots of each ring, power of 2             */
+  uint32_t                    TxHead;           /*!< Messages written, published to the peer on flush     */
+  uint32_t                    TxCredits;        /*!< Slots known free in the Tx ring                      */
+  uint32_t                    TxPending;        /*!< Messages written and not yet flushed                 */
+  uint32_t                    RxTail;           /*!< Messages processed                                   */
+  void (* RxCallback)(struct __IPCCEx_ChannelTypeDef *hch, const uint8_t *pData,
+                      uint32_t Length);         /*!< Called for each message received                     */
+  IPCCEx_ChannelStatsTypeDef  Stats;            /*!< Statistics                                           */
+} IPCCEx_ChannelTypeDef;
+
+/**
+  * @brief  IPCC channel receive callback
+  */
+typedef void IPCCEx_ChannelRxCb(IPCCEx_ChannelTypeDef *hch, const uint8_t *pData, uint32_t Length);
+
+/**
+  * @}
+  */
+
+/* Exported macros -----------------------------------------------------------*/
+/** @defgroup IPCCEx_Exported_Macros IPCCEx Exported Macros
+  * @{
+  */
+
+/** @brief  Shared memory needed by one direction of a channel.
+  * @param  __SLOTSIZE__ bytes per slot, header included.
+  * @param  __SLOTS__ number of slots.
+  * @retval Number of bytes.
+  */
+#define __HAL_IPCCEX_RING_SIZE(__SLOTSIZE__, __SLOTS__) \
+  (sizeof(IPCCEx_RingCtrlTypeDef) + ((__SLOTSIZE__) * (__SLOTS__)))
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup IPCCEx_Exported_Functions
+  * @{
+  */
+
+/** @addtogroup IPCCEx_Exported_Functions_Group1
+  * @{
+  */
+/* Channel configuration functions ********************************************/
+HAL_StatusTypeDef HAL_IPCCEx_ChannelInit(IPCCEx_ChannelTypeDef *hch, IPCC_HandleTypeDef *hipcc, uint32_t ChannelIndex,
+                                         uint32_t *pTxShared, uint32_t *pRxShared, uint32_t SlotSize,
+                                         uint32_t SlotNbr, IPCCEx_ChannelRxCb RxCallback);
+HAL_StatusTypeDef HAL_IPCCEx_ChannelReset(IPCCEx_ChannelTypeDef *hch);
+/**
+  * @}
+  */
+
+/** @addtogroup IPCCEx_Exported_Functions_Group2
+  * @{
+  */
+/* Channel transfer functions *************************************************/
+HAL_StatusTypeDef HAL_IPCCEx_ChannelWrite(IPCCEx_ChannelTypeDef *hch, const uint8_t *pData, uint32_t Length);
+HAL_StatusTypeDef HAL_IPCCEx_ChannelFlush(IPCCEx_ChannelTypeDef *hch);
+HAL_StatusTypeDef HAL_IPCCEx_ChannelSend(IPCCEx_ChannelTypeDef *hch, const uint8_t *pData, uint32_t Length);
+uint32_t          HAL_IPCCEx_ChannelGetCredits(IPCCEx_ChannelTypeDef *hch);
+uint32_t          HAL_IPCCEx_ChannelProcess(IPCCEx_ChannelTypeDef *hch, uint32_t Budget);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32MP1xx_HAL_IPCC_EX_H */
@@ -0,0 +1,392 @@
+/**
+  ******************************************************************************
+  * @file    stm32mp1xx_hal_ipcc_ex.c
+  * @brief   IPCC HAL Extended module driver.
+  *          This file provides firmware functions to manage the following
+  *          functionalities of the Inter-Processor communication controller
+  *          peripherals (IPCC).
+  *           + Message channels in shared memory
+  *           + Notification suppression, batch reception and flow control
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                        ##### How to use this driver #####
+  ==============================================================================
+    [..]
+      A channel is a duplex message link between the two CPUs over one IPCC
+      channel. Each direction is a ring of fixed size slots in shared memory,
+      with a single sender and a single receiver.
+
+      (#) Reserve in a memory shared by the CPUs, for each direction, a
+          word aligned area of __HAL_IPCCEX_RING_SIZE() bytes. The Tx area of a
+          CPU is the Rx area of the other one. The areas must not be cached.
+
+      (#) Initialize the IPCC with HAL_IPCC_Init(), then the channel of each CPU
+          with HAL_IPCCEx_ChannelInit(). Before the second CPU initializes its
+          channel, the first one resets the shared areas with
+          HAL_IPCCEx_ChannelReset().
+
+      (#) To be notified of the messages received, activate the Rx notification
+          of the IPCC channel with HAL_IPCC_ActivateNotification(). Its callback
+          calls HAL_IPCCEx_ChannelProcess(), and the Tx free notification is
+          not needed. Without notification, HAL_IPCCEx_ChannelProcess() is
+          called periodically.
+
+      (#) Send messages with HAL_IPCCEx_ChannelSend(), or write several messages
+          with HAL_IPCCEx_ChannelWrite() and publish them at once with
+          HAL_IPCCEx_ChannelFlush().
+
+      (#) HAL_IPCCEx_ChannelProcess() calls the receive callback for each message
+          and returns the slots to the sender once per batch. The callback
+          must copy the message data it needs after returning.
+
+    [..]
+      The IPCC channel occupied flag tells whether the receiver is busy with the
+      messages of the channel: a flush only notifies the peer when the flag is
+      free, the messages published while it is set being processed by the same
+      batch. The receiver clears the flag once the ring is empty.
+
+    [..]
+      The sender counts the free slots of the peer ring as credits, and only
+      reads the Tail of the receiver when its credits are exhausted. When the
+      ring stays full, HAL_IPCCEx_ChannelWrite() returns HAL_BUSY; the Tx free
+      notification of the IPCC channel then signals the next receive batch.
+
+  @endverbatim
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32mp1xx_hal.h"
+
+/** @addtogroup STM32MP1xx_HAL_Driver
+  * @{
+  */
+
+/** @defgroup IPCCEx IPCCEx
+  * @brief IPCC HAL Extended module driver
+  * @{
+  */
+
+#ifdef HAL_IPCC_MODULE_ENABLED
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/* Private macro -------------------------------------------------------------*/
+/** @defgroup IPCCEx_Private_Macros IPCCEx Private Macros
+  * @{
+  */
+#define IPCCEX_SLOT(__HCH__, __RING__, __INDEX__) \
+  (&(__RING__)->pSlots[((__INDEX__) & ((__HCH__)->SlotNbr - 1U)) * (__HCH__)->SlotSize])
+/**
+  * @}
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/* Exported functions --------------------------------------------------------*/
+
+/** @defgroup IPCCEx_Exported_Functions IPCCEx Exported Functions
+  * @{
+  */
+
+/** @defgroup IPCCEx_Exported_Functions_Group1 Channel configuration functions
+  * @brief    Channel configuration functions
+  *
+@verbatim
+ ===============================================================================
+                   ##### Channel configuration functions #####
+ ===============================================================================
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize a channel.
+  * @note   The local state is loaded from the shared areas, which must have been
+  *         reset by one of the CPUs before.
+  * @param  hch channel handle
+  * @param  hipcc IPCC handle
+  * @param  ChannelIndex Channel number
+  *          This parameter can be one of the following values:
+  *            @arg IPCC_CHANNEL_1: IPCC Channel 1
+  *            @arg IPCC_CHANNEL_2: IPCC Channel 2
+  *            @arg IPCC_CHANNEL_3: IPCC Channel 3
+  *            @arg IPCC_CHANNEL_4: IPCC Channel 4
+  *            @arg IPCC_CHANNEL_5: IPCC Channel 5
+  *            @arg IPCC_CHANNEL_6: IPCC Channel 6
+  * @param  pTxShared shared area of the messages sent
+  * @param  pRxShared shared area of the messages received
+  * @param  SlotSize bytes per slot, header included, multiple of 4
+  * @param  SlotNbr number of slots of each direction, power of 2
+  * @param  RxCallback callback called for each message received
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_IPCCEx_ChannelInit(IPCCEx_ChannelTypeDef *hch, IPCC_HandleTypeDef *hipcc, uint32_t ChannelIndex,
+                                         uint32_t *pTxShared, uint32_t *pRxShared, uint32_t SlotSize,
+                                         uint32_t SlotNbr, IPCCEx_ChannelRxCb RxCallback)
+{
+  if ((hch == NULL) || (hipcc == NULL) || (pTxShared == NULL) || (pRxShared == NULL) ||
+      (pTxShared == pRxShared) || (RxCallback == NULL) || (ChannelIndex >= IPCC_CHANNEL_NUMBER) ||
+      (SlotSize <= IPCCEX_SLOT_HEADER) || ((SlotSize & 3U) != 0U) ||
+      (SlotNbr == 0U) || ((SlotNbr & (SlotNbr - 1U)) != 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  hch->hipcc = hipcc;
+  hch->ChannelIndex = ChannelIndex;
+  hch->Tx.pCtrl = (IPCCEx_RingCtrlTypeDef *)pTxShared;
+  hch->Tx.pSlots = (uint8_t *)&pTxShared[sizeof(IPCCEx_RingCtrlTypeDef) / 4U];
+  hch->Rx.pCtrl = (IPCCEx_RingCtrlTypeDef *)pRxShared;
+  hch->Rx.pSlots = (uint8_t *)&pRxShared[sizeof(IPCCEx_RingCtrlTypeDef) / 4U];
+  hch->SlotSize = SlotSize;
+  hch->SlotNbr = SlotNbr;
+  hch->RxCallback = RxCallback;
+
+  hch->TxHead = hch->Tx.pCtrl->Head;
+  hch->TxCredits = 0U;
+  hch->TxPending = 0U;
+  hch->RxTail = hch->Rx.pCtrl->Tail;
+
+  hch->Stats.TxMessages = 0U;
+  hch->Stats.RxMessages = 0U;
+  hch->Stats.Notifications = 0U;
+  hch->Stats.Suppressed = 0U;
+  hch->Stats.Batches = 0U;
+  hch->Stats.CreditRefresh = 0U;
+  hch->Stats.NoCredit = 0U;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Reset the shared areas of a channel, discarding their messages.
+  * @note   To be called by one CPU only, before the other CPU initializes its channel.
+  * @param  hch channel handle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_IPCCEx_ChannelReset(IPCCEx_ChannelTypeDef *hch)
+{
+  if (hch == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  hch->Tx.pCtrl->Head = 0U;
+  hch->Tx.pCtrl->Tail = 0U;
+  hch->Rx.pCtrl->Head = 0U;
+  hch->Rx.pCtrl->Tail = 0U;
+
+  hch->TxHead = 0U;
+  hch->TxCredits = 0U;
+  hch->TxPending = 0U;
+  hch->RxTail = 0U;
+
+  return HAL_OK;
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup IPCCEx_Exported_Functions_Group2 Channel transfer functions
+  * @brief    Channel transfer functions
+  *
+@verbatim
+ ===============================================================================
+                    ##### Channel transfer functions #####
+ ===============================================================================
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Write a message in the Tx ring of a channel, without publishing it.
+  * @param  hch channel handle
+  * @param  pData pointer to the message
+  * @param  Length message length in bytes
+  * @retval HAL status, HAL_BUSY if no slot is free.
+  */
+HAL_StatusTypeDef HAL_IPCCEx_ChannelWrite(IPCCEx_ChannelTypeDef *hch, const uint8_t *pData, uint32_t Length)
+{
+  uint8_t *p_slot;
+  uint32_t index;
+
+  if ((hch == NULL) || ((pData == NULL) && (Length != 0U)) || (Length > (hch->SlotSize - IPCCEX_SLOT_HEADER)))
+  {
+    return HAL_ERROR;
+  }
+
+  if ((hch->TxCredits == 0U) && (HAL_IPCCEx_ChannelGetCredits(hch) == 0U))
+  {
+    hch->Stats.NoCredit++;
+    return HAL_BUSY;
+  }
+
+  p_slot = IPCCEX_SLOT(hch, &hch->Tx, hch->TxHead);
+  *((uint32_t *)p_slot) = Length;
+  for (index = 0U; index < Length; index++)
+  {
+    p_slot[IPCCEX_SLOT_HEADER + index] = pData[index];
+  }
+
+  hch->TxHead++;
+  hch->TxCredits--;
+  hch->TxPending++;
+  hch->Stats.TxMessages++;
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Publish the messages written to the peer, and notify it if it is idle.
+  * @param  hch channel handle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_IPCCEx_ChannelFlush(IPCCEx_ChannelTypeDef *hch)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+
+  if (hch == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  if (hch->TxPending != 0U)
+  {
+    /* The messages are visible before being published */
+    __DMB();
+    hch->Tx.pCtrl->Head = hch->TxHead;
+    hch->TxPending = 0U;
+
+    /* The peer reads Head after clearing the channel flag: either it sees the
+       messages published, or the flag is seen free and the peer is notified */
+    __DMB();
+    if (HAL_IPCC_GetChannelStatus(hch->hipcc, hch->ChannelIndex, IPCC_CHANNEL_DIR_TX) == IPCC_CHANNEL_STATUS_FREE)
+    {
+      status = HAL_IPCC_NotifyCPU(hch->hipcc, hch->ChannelIndex, IPCC_CHANNEL_DIR_TX);
+      hch->Stats.Notifications++;
+    }
+    else
+    {
+      hch->Stats.Suppressed++;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Send a message to the peer.
+  * @param  hch channel handle
+  * @param  pData pointer to the message
+  * @param  Length message length in bytes
+  * @retval HAL status, HAL_BUSY if no slot is free.
+  */
+HAL_StatusTypeDef HAL_IPCCEx_ChannelSend(IPCCEx_ChannelTypeDef *hch, const uint8_t *pData, uint32_t Length)
+{
+  HAL_StatusTypeDef status;
+
+  status = HAL_IPCCEx_ChannelWrite(hch, pData, Length);
+  if (status == HAL_OK)
+  {
+    status = HAL_IPCCEx_ChannelFlush(hch);
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Get back the credits of the slots freed by the peer.
+  * @param  hch channel handle
+  * @retval Number of messages that can be written
+  */
+uint32_t HAL_IPCCEx_ChannelGetCredits(IPCCEx_ChannelTypeDef *hch)
+{
+  hch->TxCredits = hch->SlotNbr - (hch->TxHead - hch->Tx.pCtrl->Tail);
+  hch->Stats.CreditRefresh++;
+
+  /* Slot reads by the peer complete before the slots are written again */
+  __DMB();
+
+  return hch->TxCredits;
+}
+
+/**
+  * @brief  Process the messages received from the peer.
+  * @note   To be called from the Rx occupied callback of the IPCC channel, or
+  *         periodically. When Budget messages are processed, messages may remain
+  *         and the function must be called again later.
+  * @param  hch channel handle
+  * @param  Budget maximum number of messages processed
+  * @retval Number of messages processed
+  */
+uint32_t HAL_IPCCEx_ChannelProcess(IPCCEx_ChannelTypeDef *hch, uint32_t Budget)
+{
+  const uint8_t *p_slot;
+  uint32_t head;
+  uint32_t count = 0U;
+
+  do
+  {
+    head = hch->Rx.pCtrl->Head;
+    if (head != hch->RxTail)
+    {
+      /* The slots are read after their publication */
+      __DMB();
+
+      while ((head != hch->RxTail) && (count < Budget))
+      {
+        p_slot = IPCCEX_SLOT(hch, &hch->Rx, hch->RxTail);
+        hch->RxCallback(hch, &p_slot[IPCCEX_SLOT_HEADER], *((const uint32_t *)p_slot));
+        hch->RxTail++;
+        count++;
+      }
+
+      /* Return the credits of the whole batch */
+      __DMB();
+      hch->Rx.pCtrl->Tail = hch->RxTail;
+      hch->Stats.Batches++;
+
+      if (head != hch->RxTail)
+      {
+        break;
+      }
+    }
+
+    /* Ring empty: clear the channel flag so that the peer notifies the next
+       messages, then check again for messages published meanwhile */
+    (void)HAL_IPCC_NotifyCPU(hch->hipcc, hch->ChannelIndex, IPCC_CHANNEL_DIR_RX);
+    __DMB();
+  } while ((hch->Rx.pCtrl->Head != hch->RxTail) && (count < Budget));
+
+  hch->Stats.RxMessages += count;
+
+  return count;
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#endif /* HAL_IPCC_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
@@ -106,6 +106,50 @@ typedef enum
   HAL_DCACHE_MSPDEINIT_CB_ID                        = 0x06U  /*!< DCACHE Msp DeInit callback ID                      */
 } HAL_DCACHE_CallbackIDTypeDef;
 
+/**
+  * @brief  HAL DCACHE monitor sample structure definition
+  */
+typedef struct
+{
+  uint32_t Timestamp;                /*!< GetTime() value at the end of the sample window     */
+  uint32_t ReadHit;                  /*!< Read hits counted during the sample window          */
+  uint32_t WriteHit;                 /*!< Write hits counted during the sample window         */
+  uint16_t ReadMiss;                 /*!< Read misses counted during the sample window        */
+  uint16_t WriteMiss;                /*!< Write misses counted during the sample window       */
+  uint8_t  Tag;                      /*!< Task or code region active during the sample window */
+  uint8_t  Config;                   /*!< Cache configuration active during the sample window */
+} DCACHE_SampleTypeDef;
+
+/**
+  * @brief  HAL DCACHE monitor sampler totals structure definition
+  */
+typedef struct
+{
+  uint64_t ReadHit;                  /*!< Read hits of the samples selected                   */
+  uint64_t ReadMiss;                 /*!< Read misses of the samples selected                 */
+  uint64_t WriteHit;                 /*!< Write hits of the samples selected                  */
+  uint64_t WriteMiss;                /*!< Write misses of the samples selected                */
+  uint32_t SampleNbr;                /*!< Number of samples selected                          */
+  uint32_t ReadHitRatio;             /*!< Read hits per 10000 reads, 0 without any read       */
+  uint32_t WriteHitRatio;            /*!< Write hits per 10000 writes, 0 without any write    */
+} DCACHE_SamplerTotalsTypeDef;
+
+/**
+  * @brief  HAL DCACHE monitor sampler structure definition
+  */
+typedef struct
+{
+  DCACHE_HandleTypeDef  *hdcache;    /*!< DCACHE handle sampled                               */
+  DCACHE_SampleTypeDef  *pSamples;   /*!< Sample ring storage, provided by the user           */
+  uint32_t              Depth;       /*!< Number of entries of pSamples                       */
+  __IO uint32_t         Head;        /*!< Next sample to write                                */
+  __IO uint32_t         Count;       /*!< Number of valid samples, up to Depth                */
+  __IO uint8_t          Tag;         /*!< Task or code region active                          */
+  __IO uint8_t          Config;      /*!< Cache configuration active                          */
+  uint32_t              Saturated;   /*!< Sample windows in which a monitor counter saturated */
+  uint32_t              (*GetTime)(void); /*!< Timestamp source, HAL_GetTick() by default     */
+} DCACHE_SamplerTypeDef;
+
 /**
   * @}
   */
@@ -145,6 +189,14 @@ typedef enum
   * @}
   */
 
+/** @defgroup DCACHE_Sampler_Filter Monitor sampler filter
+  * @{
+  */
+#define DCACHE_SAMPLER_ANY             0xFFU  /*!< Select the samples of any tag or configuration */
+/**
+  * @}
+  */
+
 /** @defgroup DCACHE_Read_Burst_Type Remapped Output burst type
   * @{
   */
@@ -327,6 +379,24 @@ uint32_t HAL_DCACHE_GetError(const DCACHE_HandleTypeDef *hdcache);
   * @}
   */
 
+/** @defgroup DCACHE_Exported_Functions_Group5 Monitor sampling functions
+  * @brief    Monitor sampling functions
+  * @{
+  */
+HAL_StatusTypeDef HAL_DCACHE_Sampler_Init(DCACHE_SamplerTypeDef *hsampler, DCACHE_HandleTypeDef *hdcache,
+                                          DCACHE_SampleTypeDef *pSamples, uint32_t Depth);
+HAL_StatusTypeDef HAL_DCACHE_Sampler_Stop(const DCACHE_SamplerTypeDef *hsampler);
+void HAL_DCACHE_Sampler_Sample(DCACHE_SamplerTypeDef *hsampler);
+void HAL_DCACHE_Sampler_SetTag(DCACHE_SamplerTypeDef *hsampler, uint8_t Tag);
+void HAL_DCACHE_Sampler_SetConfig(DCACHE_SamplerTypeDef *hsampler, uint8_t Config);
+HAL_StatusTypeDef HAL_DCACHE_Sampler_GetSample(const DCACHE_SamplerTypeDef *hsampler, uint32_t Index,
+                                               DCACHE_SampleTypeDef *pSample);
+HAL_StatusTypeDef HAL_DCACHE_Sampler_GetTotals(const DCACHE_SamplerTypeDef *hsampler, uint8_t Tag, uint8_t Config,
+                                               uint32_t Window, DCACHE_SamplerTotalsTypeDef *pTotals);
+/**
+  * @}
+  */
+
 /**
   * @}
   */
@@ -8,6 +8,7 @@
   *           + Initialization and Configuration
   *           + Cache coherency command
   *           + Monitoring management
+  *           + Monitor sampling
   ******************************************************************************
     * @attention
   *
@@ -63,6 +64,26 @@
     [..]  Use HAL_DCACHE_GetState() function to return the DCACHE state and HAL_DCACHE_GetError()
           in case of error detection.
 
+     *** Monitor sampling ***
+     ========================
+    [..]
+        (+) Use HAL_DCACHE_Sampler_Init() to start the four monitors of a DCACHE and
+            give the sampler a ring of samples.
+        (+) Call HAL_DCACHE_Sampler_Sample() periodically, before the 16-bit miss
+            monitors saturate. Each call reads and resets the monitors and stores a
+            sample, the oldest one being overwritten when the ring is full.
+        (+) Call HAL_DCACHE_Sampler_SetTag() on task switches or on code region entry
+            and exit to attribute the next samples to a task or region.
+        (+) Use HAL_DCACHE_Sampler_GetSample() to export the time series and
+            HAL_DCACHE_Sampler_GetTotals() to get rolling read and write hit ratios
+            over the last samples of a tag.
+        (+) To compare two cache configurations on a live workload, for instance the
+            read burst types, alternate them periodically (HAL_DCACHE_Disable(),
+            HAL_DCACHE_SetReadBurstType(), HAL_DCACHE_Enable()), call
+            HAL_DCACHE_Sampler_SetConfig() after each change and compare the totals
+            of each configuration.
+        (+) Use HAL_DCACHE_Sampler_Stop() to stop the monitors.
+
      *** DCACHE HAL driver macros list ***
      =============================================
      [..]
@@ -134,6 +155,10 @@
 #define DCACHE_POLLING_MODE                    0U
 #define DCACHE_IT_MODE                         1U
 
+#define DCACHE_MONITOR_HIT_MAX                 0xFFFFFFFFU  /* Saturation value of the hit monitors  */
+#define DCACHE_MONITOR_MISS_MAX                0xFFFFU      /* Saturation value of the miss monitors */
+#define DCACHE_SAMPLER_RATIO_SCALE             10000U       /* Hit ratio unit, per ten thousand      */
+
 /**
   * @}
   */
@@ -142,6 +167,7 @@
 /* Private function prototypes -----------------------------------------------*/
 static HAL_StatusTypeDef DCACHE_CommandByAddr(DCACHE_HandleTypeDef *hdcache, uint32_t Command,
                                               const uint32_t *const pAddr, uint32_t dSize, uint32_t mode);
+static uint32_t DCACHE_SamplerRatio(uint64_t Hit, uint64_t Miss);
 
 /* Exported functions --------------------------------------------------------*/
 /** @addtogroup DCACHE_Exported_Functions DCACHE Exported Functions
@@ -1375,6 +1401,255 @@ uint32_t HAL_DCACHE_GetError(const DCACHE_HandleTypeDef *hdcache)
   return hdcache->ErrorCode;
 }
 
+/**
+  * @}
+  */
+
+/** @addtogroup DCACHE_Exported_Functions_Group5
+  *
+@verbatim
+ ===============================================================================
+            #####          Monitor sampling functions          #####
+ ===============================================================================
+    [..]
+    The sampler reads and resets the four monitors at each sample, so that they
+    never saturate when sampled often enough, and keeps a ring of samples tagged
+    with the task or code region and the cache configuration active when they
+    were taken.
+    The sampling functions may be called from interrupt context, they mask the
+    interrupts while they update the ring; the functions reading samples must
+    not be preempted by them to get a consistent result.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize a Data Cache monitor sampler and start the monitors.
+  * @note   Tag and Config are reset to 0 and GetTime is set to HAL_GetTick(); it may be
+  *         replaced by a faster timestamp source after this call.
+  * @param  hsampler Pointer to the sampler.
+  * @param  hdcache Pointer to a DCACHE_HandleTypeDef structure that contains
+  *                 the configuration information for the specified DCACHEx peripheral.
+  * @param  pSamples Pointer to the sample ring storage.
+  * @param  Depth Number of entries of pSamples.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_DCACHE_Sampler_Init(DCACHE_SamplerTypeDef *hsampler, DCACHE_HandleTypeDef *hdcache,
+                                          DCACHE_SampleTypeDef *pSamples, uint32_t Depth)
+{
+  if ((hsampler == NULL) || (hdcache == NULL) || (pSamples == NULL) || (Depth == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  hsampler->hdcache = hdcache;
+  hsampler->pSamples = pSamples;
+  hsampler->Depth = Depth;
+  hsampler->Head = 0U;
+  hsampler->Count = 0U;
+  hsampler->Tag = 0U;
+  hsampler->Config = 0U;
+  hsampler->Saturated = 0U;
+  hsampler->GetTime = HAL_GetTick;
+
+  (void)HAL_DCACHE_Monitor_Reset(hdcache, DCACHE_MONITOR_ALL);
+
+  return HAL_DCACHE_Monitor_Start(hdcache, DCACHE_MONITOR_ALL);
+}
+
+/**
+  * @brief  Stop the Data Cache monitors used by a sampler.
+  * @note   The samples remain available.
+  * @param  hsampler Pointer to the sampler.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_DCACHE_Sampler_Stop(const DCACHE_SamplerTypeDef *hsampler)
+{
+  if (hsampler == NULL)
+  {
+    return HAL_ERROR;
+  }
+
+  return HAL_DCACHE_Monitor_Stop(hsampler->hdcache, DCACHE_MONITOR_ALL);
+}
+
+/**
+  * @brief  Take a sample of the Data Cache monitors.
+  * @note   The monitors are read then reset; the accesses occurring between the
+  *         read and the reset are not counted.
+  * @param  hsampler Pointer to the sampler.
+  * @retval None
+  */
+void HAL_DCACHE_Sampler_Sample(DCACHE_SamplerTypeDef *hsampler)
+{
+  DCACHE_TypeDef *instance = hsampler->hdcache->Instance;
+  DCACHE_SampleTypeDef *p_sample;
+  uint32_t read_hit;
+  uint32_t read_miss;
+  uint32_t write_hit;
+  uint32_t write_miss;
+  uint32_t primask_bit;
+
+  /* The ring is updated from thread and interrupt context */
+  primask_bit = __get_PRIMASK();
+  __disable_irq();
+
+  read_hit = instance->RHMONR;
+  read_miss = instance->RMMONR;
+  write_hit = instance->WHMONR;
+  write_miss = instance->WMMONR;
+  (void)HAL_DCACHE_Monitor_Reset(hsampler->hdcache, DCACHE_MONITOR_ALL);
+
+  if ((read_hit == DCACHE_MONITOR_HIT_MAX) || (write_hit == DCACHE_MONITOR_HIT_MAX) ||
+      (read_miss >= DCACHE_MONITOR_MISS_MAX) || (write_miss >= DCACHE_MONITOR_MISS_MAX))
+  {
+    hsampler->Saturated++;
+  }
+
+  p_sample = &hsampler->pSamples[hsampler->Head];
+  p_sample->Timestamp = hsampler->GetTime();
+  p_sample->ReadHit = read_hit;
+  p_sample->WriteHit = write_hit;
+  p_sample->ReadMiss = (uint16_t)read_miss;
+  p_sample->WriteMiss = (uint16_t)write_miss;
+  p_sample->Tag = hsampler->Tag;
+  p_sample->Config = hsampler->Config;
+
+  hsampler->Head = ((hsampler->Head + 1U) == hsampler->Depth) ? 0U : (hsampler->Head + 1U);
+  if (hsampler->Count < hsampler->Depth)
+  {
+    hsampler->Count++;
+  }
+
+  __set_PRIMASK(primask_bit);
+}
+
+/**
+  * @brief  Attribute the next samples to a task or code region.
+  * @note   A sample is taken first to close the window of the previous tag.
+  * @param  hsampler Pointer to the sampler.
+  * @param  Tag Task or code region identifier, DCACHE_SAMPLER_ANY excepted.
+  * @retval None
+  */
+void HAL_DCACHE_Sampler_SetTag(DCACHE_SamplerTypeDef *hsampler, uint8_t Tag)
+{
+  uint32_t primask_bit;
+
+  /* No sample from an interrupt between the window closed and the switch */
+  primask_bit = __get_PRIMASK();
+  __disable_irq();
+  HAL_DCACHE_Sampler_Sample(hsampler);
+  hsampler->Tag = Tag;
+  __set_PRIMASK(primask_bit);
+}
+
+/**
+  * @brief  Attribute the next samples to a cache configuration.
+  * @note   A sample is taken first to close the window of the previous configuration.
+  *         The configuration itself is applied by the caller.
+  * @param  hsampler Pointer to the sampler.
+  * @param  Config Cache configuration identifier, DCACHE_SAMPLER_ANY excepted.
+  * @retval None
+  */
+void HAL_DCACHE_Sampler_SetConfig(DCACHE_SamplerTypeDef *hsampler, uint8_t Config)
+{
+  uint32_t primask_bit;
+
+  /* No sample from an interrupt between the window closed and the switch */
+  primask_bit = __get_PRIMASK();
+  __disable_irq();
+  HAL_DCACHE_Sampler_Sample(hsampler);
+  hsampler->Config = Config;
+  __set_PRIMASK(primask_bit);
+}
+
+/**
+  * @brief  Get a sample of the ring.
+  * @param  hsampler Pointer to the sampler.
+  * @param  Index Sample index, 0 being the oldest sample.
+  * @param  pSample Pointer to the sample filled.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_DCACHE_Sampler_GetSample(const DCACHE_SamplerTypeDef *hsampler, uint32_t Index,
+                                               DCACHE_SampleTypeDef *pSample)
+{
+  uint32_t position;
+
+  if ((hsampler == NULL) || (pSample == NULL) || (Index >= hsampler->Count))
+  {
+    return HAL_ERROR;
+  }
+
+  position = hsampler->Head + hsampler->Depth - hsampler->Count + Index;
+  if (position >= hsampler->Depth)
+  {
+    position -= hsampler->Depth;
+  }
+
+  *pSample = hsampler->pSamples[position];
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Sum the most recent samples of a tag and configuration.
+  * @param  hsampler Pointer to the sampler.
+  * @param  Tag Task or code region identifier, or DCACHE_SAMPLER_ANY.
+  * @param  Config Cache configuration identifier, or DCACHE_SAMPLER_ANY.
+  * @param  Window Number of most recent samples examined, 0 for all the samples.
+  * @param  pTotals Pointer to the totals filled.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_DCACHE_Sampler_GetTotals(const DCACHE_SamplerTypeDef *hsampler, uint8_t Tag, uint8_t Config,
+                                               uint32_t Window, DCACHE_SamplerTotalsTypeDef *pTotals)
+{
+  const DCACHE_SampleTypeDef *p_sample;
+  uint32_t position;
+  uint32_t count;
+
+  if ((hsampler == NULL) || (pTotals == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  pTotals->ReadHit = 0U;
+  pTotals->ReadMiss = 0U;
+  pTotals->WriteHit = 0U;
+  pTotals->WriteMiss = 0U;
+  pTotals->SampleNbr = 0U;
+
+  count = hsampler->Count;
+  if ((Window != 0U) && (Window < count))
+  {
+    count = Window;
+  }
+
+  /* Walk back from the most recent sample */
+  position = hsampler->Head;
+  while (count != 0U)
+  {
+    position = (position == 0U) ? (hsampler->Depth - 1U) : (position - 1U);
+    p_sample = &hsampler->pSamples[position];
+
+    if (((Tag == DCACHE_SAMPLER_ANY) || (p_sample->Tag == Tag)) &&
+        ((Config == DCACHE_SAMPLER_ANY) || (p_sample->Config == Config)))
+    {
+      pTotals->ReadHit += p_sample->ReadHit;
+      pTotals->ReadMiss += p_sample->ReadMiss;
+      pTotals->WriteHit += p_sample->WriteHit;
+      pTotals->WriteMiss += p_sample->WriteMiss;
+      pTotals->SampleNbr++;
+    }
+    count--;
+  }
+
+  pTotals->ReadHitRatio = DCACHE_SamplerRatio(pTotals->ReadHit, pTotals->ReadMiss);
+  pTotals->WriteHitRatio = DCACHE_SamplerRatio(pTotals->WriteHit, pTotals->WriteMiss);
+
+  return HAL_OK;
+}
+
 /**
   * @}
   */
@@ -1479,6 +1754,24 @@ static HAL_StatusTypeDef DCACHE_CommandByAddr(DCACHE_HandleTypeDef *hdcache, uin
   return status;
 }
 
+/**
+  * @brief  Compute a hit ratio for the monitor sampler.
+  * @param  Hit Number of hits.
+  * @param  Miss Number of misses.
+  * @retval Hits per 10000 accesses, 0 without any access
+  */
+static uint32_t DCACHE_SamplerRatio(uint64_t Hit, uint64_t Miss)
+{
+  uint64_t accesses = Hit + Miss;
+
+  if (accesses == 0U)
+  {
+    return 0U;
+  }
+
+  return (uint32_t)((Hit * DCACHE_SAMPLER_RATIO_SCALE) / accesses);
+}
+
 /**
   * @}
   */
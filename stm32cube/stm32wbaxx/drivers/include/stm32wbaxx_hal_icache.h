@@ -59,6 +59,58 @@ typedef struct
   uint32_t OutputBurstType;          /*!< Selects the output burst type.
                                           This parameter can be a value of @ref ICACHE_Output_Burst_Type */
 } ICACHE_RegionConfigTypeDef;
+
+/**
+  * @brief  HAL ICACHE monitor sample structure definition
+  */
+typedef struct
+{
+  uint32_t Timestamp;                /*!< GetTime() value at the end of the sample window */
+
+  uint32_t Hit;                      /*!< Hits counted during the sample window */
+
+  uint16_t Miss;                     /*!< Misses counted during the sample window */
+
+  uint8_t Tag;                       /*!< Task or code region active during the sample window */
+
+  uint8_t Config;                    /*!< Cache configuration active during the sample window */
+} ICACHE_SampleTypeDef;
+
+/**
+  * @brief  HAL ICACHE monitor sampler totals structure definition
+  */
+typedef struct
+{
+  uint64_t Hit;                      /*!< Hits of the samples selected */
+
+  uint64_t Miss;                     /*!< Misses of the samples selected */
+
+  uint32_t SampleNbr;                /*!< Number of samples selected */
+
+  uint32_t HitRatio;                 /*!< Hits per 10000 accesses, 0 without any access */
+} ICACHE_SamplerTotalsTypeDef;
+
+/**
+  * @brief  HAL ICACHE monitor sampler structure definition
+  */
+typedef struct
+{
+  ICACHE_SampleTypeDef *pSamples;    /*!< Sample ring storage, provided by the user */
+
+  uint32_t Depth;                    /*!< Number of entries of pSamples */
+
+  __IO uint32_t Head;                /*!< Next sample to write */
+
+  __IO uint32_t Count;               /*!< Number of valid samples, up to Depth */
+
+  __IO uint8_t Tag;                  /*!< Task or code region active, see HAL_ICACHE_Sampler_SetTag() */
+
+  __IO uint8_t Config;               /*!< Cache configuration active, see HAL_ICACHE_Sampler_SetConfig() */
+
+  uint32_t Saturated;                /*!< Sample windows in which a monitor counter saturated */
+
+  uint32_t (*GetTime)(void);         /*!< Timestamp source, HAL_GetTick() by default */
+} ICACHE_SamplerTypeDef;
 /**
   * @}
   */
@@ -87,6 +139,14 @@ typedef struct
   * @}
   */
 
+/** @defgroup ICACHE_Sampler_Filter Monitor sampler filter
+  * @{
+  */
+#define ICACHE_SAMPLER_ANY             0xFFU  /*!< Select the samples of any tag or configuration */
+/**
+  * @}
+  */
+
 /** @defgroup ICACHE_Region Remapped Region number
   * @{
   */
@@ -270,6 +330,26 @@ void HAL_ICACHE_ErrorCallback(void);
 HAL_StatusTypeDef HAL_ICACHE_EnableRemapRegion(uint32_t Region, const ICACHE_RegionConfigTypeDef *const pRegionConfig);
 HAL_StatusTypeDef HAL_ICACHE_DisableRemapRegion(uint32_t Region);
 
+/**
+  * @}
+  */
+
+/** @addtogroup ICACHE_Exported_Functions_Group4
+  * @brief    Monitor sampling functions
+  * @{
+  */
+/******* Monitor sampling functions */
+HAL_StatusTypeDef HAL_ICACHE_Sampler_Init(ICACHE_SamplerTypeDef *hsampler, ICACHE_SampleTypeDef *pSamples,
+                                          uint32_t Depth);
+HAL_StatusTypeDef HAL_ICACHE_Sampler_Stop(const ICACHE_SamplerTypeDef *hsampler);
+void HAL_ICACHE_Sampler_Sample(ICACHE_SamplerTypeDef *hsampler);
+void HAL_ICACHE_Sampler_SetTag(ICACHE_SamplerTypeDef *hsampler, uint8_t Tag);
+void HAL_ICACHE_Sampler_SetConfig(ICACHE_SamplerTypeDef *hsampler, uint8_t Config);
+HAL_StatusTypeDef HAL_ICACHE_Sampler_GetSample(const ICACHE_SamplerTypeDef *hsampler, uint32_t Index,
+                                               ICACHE_SampleTypeDef *pSample);
+HAL_StatusTypeDef HAL_ICACHE_Sampler_GetTotals(const ICACHE_SamplerTypeDef *hsampler, uint8_t Tag, uint8_t Config,
+                                               uint32_t Window, ICACHE_SamplerTotalsTypeDef *pTotals);
+
 /**
   * @}
   */
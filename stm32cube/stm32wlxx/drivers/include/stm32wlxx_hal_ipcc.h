@@ -220,6 +220,9 @@ typedef void ChannelCb(IPCC_HandleTypeDef *hipcc, uint32_t ChannelIndex, IPCC_CH
   * @}
   */
 
+/* Include IPCC HAL Extended module */
+#include "stm32wlxx_hal_ipcc_ex.h"
+
 /* Exported functions --------------------------------------------------------*/
 /** @defgroup IPCC_Exported_Functions IPCC Exported Functions
   * @{
@@ -201,6 +201,7 @@ typedef enum
 #define HAL_SUBGHZ_ERROR_NONE               (0x00000000U)   /*!< No error                         */
 #define HAL_SUBGHZ_ERROR_TIMEOUT            (0x00000001U)   /*!< Timeout Error                    */
 #define HAL_SUBGHZ_ERROR_RF_BUSY            (0x00000002U)   /*!< RF Busy Error                    */
+#define HAL_SUBGHZ_ERROR_DMA                (0x00000004U)   /*!< DMA transfer error               */
 #if (USE_HAL_SUBGHZ_REGISTER_CALLBACKS == 1)
 #define HAL_SUBGHZ_ERROR_INVALID_CALLBACK   (0x00000080U)   /*!< Invalid Callback error           */
 #endif /* USE_HAL_SUBGHZ_REGISTER_CALLBACKS */
@@ -331,6 +332,9 @@ typedef enum
   * @}
   */
 
+/* Include SUBGHZ HAL Extended module */
+#include "stm32wlxx_hal_subghz_ex.h"
+
 /* Exported functions ------------------------------------------------------- */
 /** @addtogroup SUBGHZ_Exported_Functions
   * @{
@@ -0,0 +1,165 @@
+/**
+  ******************************************************************************
+  * @file    stm32wlxx_hal_subghz_ex.h
+  * @brief   Header file of SUBGHZ HAL Extended module.
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef STM32WLxx_HAL_SUBGHZ_EX_H
+#define STM32WLxx_HAL_SUBGHZ_EX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32wlxx_hal_def.h"
+
+/** @addtogroup STM32WLxx_HAL_Driver
+  * @{
+  */
+
+/** @addtogroup SUBGHZEx
+  * @{
+  */
+
+/* Exported types ------------------------------------------------------------*/
+/** @defgroup SUBGHZEx_Exported_Types SUBGHZEx Exported Types
+  * @{
+  */
+
+/**
+  * @brief  SUBGHZ command batch structure definition
+  * @note   Commands are stored back to back in pBuffer, each one preceded by
+  *         its length: [Length][Opcode][Parameters...]
+  */
+typedef struct
+{
+  uint8_t   *pBuffer;       /*!< Command storage, provided by the user            */
+  uint16_t  Size;           /*!< Size of pBuffer in bytes                         */
+  uint16_t  Length;         /*!< Bytes used in pBuffer                            */
+  uint16_t  CmdNbr;         /*!< Number of commands queued                        */
+  uint8_t   LastCommand;    /*!< Opcode of the last command queued                */
+} SUBGHZEx_BatchTypeDef;
+
+/**
+  * @brief  SUBGHZ asynchronous transfer handle structure definition
+  */
+typedef struct __SUBGHZEx_XferTypeDef
+{
+  SUBGHZ_HandleTypeDef         *hsubghz;      /*!< SUBGHZ handle                                     */
+  DMA_HandleTypeDef            *hdmatx;       /*!< SUBGHZSPI Tx DMA handle, may be NULL for batches  */
+  DMA_HandleTypeDef            *hdmarx;       /*!< SUBGHZSPI Rx DMA handle, may be NULL for batches  */
+  const SUBGHZEx_BatchTypeDef  *pBatch;       /*!< Batch being executed                              */
+  uint16_t                     BatchPos;      /*!< Offset of the next command in the batch           */
+  uint16_t                     XferSize;      /*!< Size of the buffer transfer                       */
+  uint8_t                      *pXferBuffer;  /*!< Buffer of the buffer transfer                     */
+  uint8_t                      Operation;     /*!< Ongoing operation                                 */
+  __IO uint32_t                ErrorCode;     /*!< Error code, a value of @ref SUBGHZ_Error_Code     */
+  void                         (*XferCpltCallback)(struct __SUBGHZEx_XferTypeDef *hxfer); /*!< Called from interrupt
+                                                   context once the radio has left BUSY              */
+  void                         (*ErrorCallback)(struct __SUBGHZEx_XferTypeDef *hxfer);    /*!< Called on DMA or BUSY
+                                                   timeout error, may be NULL                        */
+  void                         *pContext;     /*!< User context                                      */
+} SUBGHZEx_XferTypeDef;
+
+/**
+  * @}
+  */
+
+/* Exported constants --------------------------------------------------------*/
+/** @defgroup SUBGHZEx_Exported_Constants SUBGHZEx Exported Constants
+  * @{
+  */
+
+/** @defgroup SUBGHZEx_Batch_Overhead SUBGHZEx Batch Overhead
+  * @brief    Bytes of batch storage used by each command besides its parameters
+  * @{
+  */
+#define SUBGHZEX_BATCH_SETCMD_OVERHEAD      2U   /*!< Length and opcode                     */
+#define SUBGHZEX_BATCH_REGISTER_OVERHEAD    4U   /*!< Length, opcode and 16-bit address     */
+#define SUBGHZEX_BATCH_BUFFER_OVERHEAD      3U   /*!< Length, opcode and offset             */
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/* Exported macros -----------------------------------------------------------*/
+/** @defgroup SUBGHZEx_Exported_Macros SUBGHZEx Exported Macros
+  * @{
+  */
+
+/** @brief  Storage needed to queue a command with the given number of parameter bytes.
+  * @param  __PARAMS__ number of parameter bytes.
+  * @retval Number of bytes.
+  */
+#define __HAL_SUBGHZEX_BATCH_SETCMD_SIZE(__PARAMS__)  ((__PARAMS__) + SUBGHZEX_BATCH_SETCMD_OVERHEAD)
+
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @addtogroup SUBGHZEx_Exported_Functions
+  * @{
+  */
+
+/** @addtogroup SUBGHZEx_Exported_Functions_Group1
+  * @{
+  */
+/* Command batch functions ****************************************************/
+HAL_StatusTypeDef HAL_SUBGHZEx_BatchInit(SUBGHZEx_BatchTypeDef *hbatch, uint8_t *pBuffer, uint16_t Size);
+void              HAL_SUBGHZEx_BatchReset(SUBGHZEx_BatchTypeDef *hbatch);
+HAL_StatusTypeDef HAL_SUBGHZEx_BatchAddSetCmd(SUBGHZEx_BatchTypeDef *hbatch, SUBGHZ_RadioSetCmd_t Command,
+                                              const uint8_t *pBuffer, uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZEx_BatchAddWriteRegisters(SUBGHZEx_BatchTypeDef *hbatch, uint16_t Address,
+                                                      const uint8_t *pBuffer, uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZEx_BatchAddWriteBuffer(SUBGHZEx_BatchTypeDef *hbatch, uint8_t Offset,
+                                                   const uint8_t *pBuffer, uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZEx_ExecBatch(SUBGHZ_HandleTypeDef *hsubghz, const SUBGHZEx_BatchTypeDef *hbatch);
+/**
+  * @}
+  */
+
+/** @addtogroup SUBGHZEx_Exported_Functions_Group2
+  * @{
+  */
+/* Interrupt and DMA driven functions *****************************************/
+HAL_StatusTypeDef HAL_SUBGHZEx_XferInit(SUBGHZEx_XferTypeDef *hxfer, SUBGHZ_HandleTypeDef *hsubghz,
+                                        DMA_HandleTypeDef *hdmatx, DMA_HandleTypeDef *hdmarx);
+HAL_StatusTypeDef HAL_SUBGHZEx_ExecBatch_IT(SUBGHZEx_XferTypeDef *hxfer, const SUBGHZEx_BatchTypeDef *hbatch);
+HAL_StatusTypeDef HAL_SUBGHZEx_WriteBuffer_DMA(SUBGHZEx_XferTypeDef *hxfer, uint8_t Offset, uint8_t *pBuffer,
+                                               uint16_t Size);
+HAL_StatusTypeDef HAL_SUBGHZEx_ReadBuffer_DMA(SUBGHZEx_XferTypeDef *hxfer, uint8_t Offset, uint8_t *pBuffer,
+                                              uint16_t Size);
+void              HAL_SUBGHZEx_BusyIRQHandler(SUBGHZEx_XferTypeDef *hxfer);
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STM32WLxx_HAL_SUBGHZ_EX_H */
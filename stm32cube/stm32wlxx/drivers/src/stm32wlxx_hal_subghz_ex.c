@@ -0,0 +1,1078 @@
+/**
+  ******************************************************************************
+  * @file    stm32wlxx_hal_subghz_ex.c
+  * @brief   SUBGHZ Extended HAL module driver.
+  *          This file provides firmware functions to manage the following
+  *          functionalities of the SUBGHZ peripheral:
+  *           + Command batch functions
+  *           + Interrupt and DMA driven functions
+  *
+  ******************************************************************************
+  * @attention
+  *
+  * SPDX-License-Identifier: Apache-2.0
+  *
+  ******************************************************************************
+  @verbatim
+  ==============================================================================
+                     ##### How to use this driver #####
+  ==============================================================================
+  [..]
+    (#) Radio reconfigurations made of several commands (frequency hopping,
+        modulation changes) can be queued in a command batch:
+        (++) Provide the storage of the batch with HAL_SUBGHZEx_BatchInit().
+        (++) Queue commands with HAL_SUBGHZEx_BatchAddSetCmd(),
+             HAL_SUBGHZEx_BatchAddWriteRegisters() and
+             HAL_SUBGHZEx_BatchAddWriteBuffer(). A command putting the radio to
+             sleep (RADIO_SET_SLEEP, RADIO_SET_RXDUTYCYCLE) may only end a batch.
+        (++) Execute the batch with HAL_SUBGHZEx_ExecBatch() (blocking) or
+             HAL_SUBGHZEx_ExecBatch_IT(). A batch is not modified by its
+             execution and can be executed again.
+
+    (#) A batch is executed under a single lock and wake-up check, and each
+        command is shifted out with the SUBGHZSPI FIFO kept full. The radio
+        BUSY signal still has to be waited for between commands.
+
+    (#) Interrupt and DMA driven operations use a SUBGHZEx_XferTypeDef handle:
+        (++) Configure a DMA channel for SUBGHZSPI Tx (request
+             DMA_REQUEST_SUBGHZSPI_TX, memory to peripheral, byte) and, for
+             HAL_SUBGHZEx_ReadBuffer_DMA(), one for SUBGHZSPI Rx (request
+             DMA_REQUEST_SUBGHZSPI_RX, peripheral to memory, byte), both with
+             memory increment enabled and in normal mode.
+        (++) Call HAL_SUBGHZEx_XferInit() and set XferCpltCallback and
+             ErrorCallback.
+        (++) Call HAL_SUBGHZEx_BusyIRQHandler() from SUBGHZ_Radio_IRQHandler(),
+             ahead of HAL_SUBGHZ_IRQHandler(): the radio BUSY interrupt shares
+             this vector through EXTI line 45.
+
+    (#) HAL_SUBGHZEx_ExecBatch_IT(), HAL_SUBGHZEx_WriteBuffer_DMA() and
+        HAL_SUBGHZEx_ReadBuffer_DMA() return once the first SPI transfer is
+        started. Instead of polling BUSY, the next command is sent, or
+        XferCpltCallback is called, from the radio BUSY falling edge
+        interrupt. The callback may be called before the function returns
+        when the radio is never seen BUSY.
+
+    (#) While an operation is ongoing the SUBGHZ handle state is
+        HAL_SUBGHZ_STATE_BUSY and the other SUBGHZ functions return HAL_BUSY,
+        HAL_SUBGHZ_IRQHandler() included: keep radio interrupts masked or
+        unexpected during these operations.
+
+  @endverbatim
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "stm32wlxx_hal.h"
+
+/** @addtogroup STM32WLxx_HAL_Driver
+  * @{
+  */
+
+/** @defgroup SUBGHZEx SUBGHZEx
+  * @brief SUBGHZ Extended HAL module driver
+  * @{
+  */
+
+#ifdef HAL_SUBGHZ_MODULE_ENABLED
+
+/* Private typedef -----------------------------------------------------------*/
+/* Private define ------------------------------------------------------------*/
+/** @defgroup SUBGHZEx_Private_Constants SUBGHZEx Private Constants
+  * @{
+  */
+#define SUBGHZEX_DEFAULT_TIMEOUT     100U    /* HAL Timeout in ms, as SUBGHZ_DEFAULT_TIMEOUT          */
+#define SUBGHZEX_DUMMY_DATA          0xFFU   /* SUBGHZSPI Dummy Data use for Tx                        */
+#define SUBGHZEX_DEEP_SLEEP_ENABLE   1U      /* SUBGHZ Radio in Deep Sleep, as SUBGHZ_DEEP_SLEEP_ENABLE */
+#define SUBGHZEX_DEEP_SLEEP_DISABLE  0U      /* SUBGHZ Radio not in Deep Sleep                         */
+#define SUBGHZEX_SPI_FIFO_DEPTH      4U      /* SUBGHZSPI Rx FIFO depth in bytes                       */
+#define SUBGHZEX_CMD_MAX_LENGTH      255U    /* Longest command in a batch, opcode included            */
+
+/* SystemCoreClock dividers. Corresponding to time execution of while loop.   */
+#define SUBGHZEX_DEFAULT_LOOP_TIME   ((SystemCoreClock*28U)>>19U)
+#define SUBGHZEX_RFBUSY_LOOP_TIME    ((SystemCoreClock*24U)>>20U)
+#define SUBGHZEX_NSS_LOOP_TIME       ((SystemCoreClock*24U)>>16U)
+
+/* EXTI line of the radio BUSY interrupt */
+#define SUBGHZEX_EXTI_LINE_RFBUSY    LL_EXTI_LINE_45
+
+/* Ongoing operation */
+#define SUBGHZEX_OP_NONE             0x00U
+#define SUBGHZEX_OP_BATCH            0x01U
+#define SUBGHZEX_OP_WRITE_BUFFER     0x02U
+#define SUBGHZEX_OP_READ_BUFFER      0x03U
+/**
+  * @}
+  */
+
+/* Private macro -------------------------------------------------------------*/
+/* Private variables ---------------------------------------------------------*/
+/* Private function prototypes -----------------------------------------------*/
+/** @defgroup SUBGHZEx_Private_Functions SUBGHZEx Private Functions
+  * @{
+  */
+static uint32_t          SUBGHZEx_IsBusy(void);
+static HAL_StatusTypeDef SUBGHZEx_WaitOnBusy(SUBGHZ_HandleTypeDef *hsubghz);
+static void              SUBGHZEx_WakeUp(SUBGHZ_HandleTypeDef *hsubghz);
+static HAL_StatusTypeDef SUBGHZEx_SPITransfer(SUBGHZ_HandleTypeDef *hsubghz, const uint8_t *pTxData,
+                                              uint8_t *pRxData, uint16_t Size);
+static HAL_StatusTypeDef SUBGHZEx_SPIFlush(SUBGHZ_HandleTypeDef *hsubghz);
+static HAL_StatusTypeDef SUBGHZEx_BatchAdd(SUBGHZEx_BatchTypeDef *hbatch, const uint8_t *pHeader,
+                                           uint16_t HeaderSize, const uint8_t *pBuffer, uint16_t Size);
+static uint32_t          SUBGHZEx_ArmBusy(void);
+static void              SUBGHZEx_DisarmBusy(void);
+static void              SUBGHZEx_BatchStep(SUBGHZEx_XferTypeDef *hxfer);
+static void              SUBGHZEx_BufferDone(SUBGHZEx_XferTypeDef *hxfer);
+static void              SUBGHZEx_Complete(SUBGHZEx_XferTypeDef *hxfer);
+static void              SUBGHZEx_Error(SUBGHZEx_XferTypeDef *hxfer, uint32_t ErrorCode);
+static void              SUBGHZEx_DMATxCplt(DMA_HandleTypeDef *hdma);
+static void              SUBGHZEx_DMARxCplt(DMA_HandleTypeDef *hdma);
+static void              SUBGHZEx_DMAError(DMA_HandleTypeDef *hdma);
+/**
+  * @}
+  */
+
+/* Exported functions --------------------------------------------------------*/
+/** @defgroup SUBGHZEx_Exported_Functions SUBGHZEx Exported Functions
+  * @{
+  */
+
+/** @defgroup SUBGHZEx_Exported_Functions_Group1 Command batch functions
+  *  @brief   Command batch functions
+  *
+@verbatim
+ ===============================================================================
+                      ##### Command batch functions #####
+ ===============================================================================
+    [..]  This subsection provides a set of functions allowing to queue several
+          radio commands and to send them in a single call.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize an empty command batch.
+  * @param  hbatch pointer to a SUBGHZEx_BatchTypeDef structure.
+  * @param  pBuffer pointer to the batch storage.
+  * @param  Size size of the batch storage in bytes.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_BatchInit(SUBGHZEx_BatchTypeDef *hbatch, uint8_t *pBuffer, uint16_t Size)
+{
+  if ((hbatch == NULL) || (pBuffer == NULL) || (Size == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  hbatch->pBuffer = pBuffer;
+  hbatch->Size    = Size;
+  HAL_SUBGHZEx_BatchReset(hbatch);
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Remove all the commands of a batch.
+  * @param  hbatch pointer to a SUBGHZEx_BatchTypeDef structure.
+  * @retval None
+  */
+void HAL_SUBGHZEx_BatchReset(SUBGHZEx_BatchTypeDef *hbatch)
+{
+  hbatch->Length      = 0U;
+  hbatch->CmdNbr      = 0U;
+  hbatch->LastCommand = 0U;
+}
+
+/**
+  * @brief  Queue a command, as sent by HAL_SUBGHZ_ExecSetCmd().
+  * @param  hbatch pointer to a SUBGHZEx_BatchTypeDef structure.
+  * @param  Command command opcode.
+  * @param  pBuffer pointer to the command parameters, copied into the batch.
+  * @param  Size    number of parameter bytes.
+  * @retval HAL status, HAL_ERROR if the batch is full or already ends with a
+  *         command putting the radio to sleep.
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_BatchAddSetCmd(SUBGHZEx_BatchTypeDef *hbatch, SUBGHZ_RadioSetCmd_t Command,
+                                              const uint8_t *pBuffer, uint16_t Size)
+{
+  uint8_t header = (uint8_t)Command;
+
+  /* LORA Modulation not available on STM32WLx4xx devices */
+  assert_param((Size == 0U) || IS_SUBGHZ_MODULATION_SUPPORTED(Command, pBuffer[0U]));
+
+  return SUBGHZEx_BatchAdd(hbatch, &header, 1U, pBuffer, Size);
+}
+
+/**
+  * @brief  Queue a register write, as done by HAL_SUBGHZ_WriteRegisters().
+  * @param  hbatch pointer to a SUBGHZEx_BatchTypeDef structure.
+  * @param  Address first register address.
+  * @param  pBuffer pointer to the register values, copied into the batch.
+  * @param  Size    number of registers.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_BatchAddWriteRegisters(SUBGHZEx_BatchTypeDef *hbatch, uint16_t Address,
+                                                      const uint8_t *pBuffer, uint16_t Size)
+{
+  uint8_t header[3];
+
+  header[0] = SUBGHZ_RADIO_WRITE_REGISTER;
+  header[1] = (uint8_t)((Address & 0xFF00U) >> 8U);
+  header[2] = (uint8_t)(Address & 0x00FFU);
+
+  return SUBGHZEx_BatchAdd(hbatch, header, 3U, pBuffer, Size);
+}
+
+/**
+  * @brief  Queue a write of the radio data buffer, as done by
+  *         HAL_SUBGHZ_WriteBuffer().
+  * @param  hbatch pointer to a SUBGHZEx_BatchTypeDef structure.
+  * @param  Offset  offset inside the payload.
+  * @param  pBuffer pointer to the data, copied into the batch.
+  * @param  Size    amount of data.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_BatchAddWriteBuffer(SUBGHZEx_BatchTypeDef *hbatch, uint8_t Offset,
+                                                   const uint8_t *pBuffer, uint16_t Size)
+{
+  uint8_t header[2];
+
+  header[0] = SUBGHZ_RADIO_WRITE_BUFFER;
+  header[1] = Offset;
+
+  return SUBGHZEx_BatchAdd(hbatch, header, 2U, pBuffer, Size);
+}
+
+/**
+  * @brief  Send all the commands of a batch, in polling mode.
+  * @param  hsubghz pointer to a SUBGHZ_HandleTypeDef structure that contains
+  *         the configuration information for the specified SUBGHZ.
+  * @param  hbatch pointer to a SUBGHZEx_BatchTypeDef structure.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_ExecBatch(SUBGHZ_HandleTypeDef *hsubghz, const SUBGHZEx_BatchTypeDef *hbatch)
+{
+  HAL_StatusTypeDef status;
+  uint32_t pos = 0U;
+  uint32_t length;
+
+  if (hbatch->CmdNbr == 0U)
+  {
+    return HAL_ERROR;
+  }
+
+  if (hsubghz->State == HAL_SUBGHZ_STATE_READY)
+  {
+    /* Process Locked */
+    __HAL_LOCK(hsubghz);
+
+    /* Need to wakeup Radio if already in Sleep at startup */
+    SUBGHZEx_WakeUp(hsubghz);
+
+    while (pos < hbatch->Length)
+    {
+      /* The previous command is processed once BUSY is released */
+      if (pos != 0U)
+      {
+        (void)SUBGHZEx_WaitOnBusy(hsubghz);
+      }
+
+      length = hbatch->pBuffer[pos];
+
+      /* NSS = 0 */
+      LL_PWR_SelectSUBGHZSPI_NSS();
+
+      (void)SUBGHZEx_SPITransfer(hsubghz, &hbatch->pBuffer[pos + 1U], NULL, (uint16_t)length);
+
+      /* NSS = 1 */
+      LL_PWR_UnselectSUBGHZSPI_NSS();
+
+      pos += length + 1U;
+    }
+
+    if ((hbatch->LastCommand == (uint8_t)RADIO_SET_SLEEP) || (hbatch->LastCommand == (uint8_t)RADIO_SET_RXDUTYCYCLE))
+    {
+      hsubghz->DeepSleep = SUBGHZEX_DEEP_SLEEP_ENABLE;
+    }
+    else
+    {
+      hsubghz->DeepSleep = SUBGHZEX_DEEP_SLEEP_DISABLE;
+    }
+
+    if (hbatch->LastCommand != (uint8_t)RADIO_SET_SLEEP)
+    {
+      (void)SUBGHZEx_WaitOnBusy(hsubghz);
+    }
+
+    if (hsubghz->ErrorCode != HAL_SUBGHZ_ERROR_NONE)
+    {
+      status = HAL_ERROR;
+    }
+    else
+    {
+      status = HAL_OK;
+    }
+
+    /* Process Unlocked */
+    __HAL_UNLOCK(hsubghz);
+
+    return status;
+  }
+  else
+  {
+    return HAL_BUSY;
+  }
+}
+
+/**
+  * @}
+  */
+
+/** @defgroup SUBGHZEx_Exported_Functions_Group2 Interrupt and DMA driven functions
+  *  @brief   Interrupt and DMA driven functions
+  *
+@verbatim
+ ===============================================================================
+                 ##### Interrupt and DMA driven functions #####
+ ===============================================================================
+    [..]  This subsection provides a set of functions sending command batches
+          and transferring the radio data buffer without polling, using the
+          SUBGHZSPI DMA requests and the radio BUSY interrupt.
+
+@endverbatim
+  * @{
+  */
+
+/**
+  * @brief  Initialize an asynchronous transfer handle and link it to the DMA handles.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @param  hsubghz pointer to an initialized SUBGHZ handle.
+  * @param  hdmatx SUBGHZSPI Tx DMA handle, NULL when only batches are used.
+  * @param  hdmarx SUBGHZSPI Rx DMA handle, NULL when HAL_SUBGHZEx_ReadBuffer_DMA()
+  *         is not used.
+  * @note   The radio BUSY interrupt is unmasked on EXTI line 45 for the
+  *         current CPU.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_XferInit(SUBGHZEx_XferTypeDef *hxfer, SUBGHZ_HandleTypeDef *hsubghz,
+                                        DMA_HandleTypeDef *hdmatx, DMA_HandleTypeDef *hdmarx)
+{
+  if ((hxfer == NULL) || (hsubghz == NULL))
+  {
+    return HAL_ERROR;
+  }
+
+  hxfer->hsubghz          = hsubghz;
+  hxfer->hdmatx           = hdmatx;
+  hxfer->hdmarx           = hdmarx;
+  hxfer->pBatch           = NULL;
+  hxfer->BatchPos         = 0U;
+  hxfer->pXferBuffer      = NULL;
+  hxfer->XferSize         = 0U;
+  hxfer->Operation        = SUBGHZEX_OP_NONE;
+  hxfer->ErrorCode        = HAL_SUBGHZ_ERROR_NONE;
+  hxfer->XferCpltCallback = NULL;
+  hxfer->ErrorCallback    = NULL;
+
+  if (hdmatx != NULL)
+  {
+    hdmatx->Parent = hxfer;
+  }
+  if (hdmarx != NULL)
+  {
+    hdmarx->Parent = hxfer;
+  }
+
+  /* Radio BUSY interrupt on falling edge, left disabled until an operation waits for it */
+  SUBGHZEx_DisarmBusy();
+  HAL_PWREx_SetRadioBusyPolarity(PWR_RADIO_BUSY_POLARITY_FALLING);
+#ifdef CORE_CM0PLUS
+  LL_C2_EXTI_EnableIT_32_63(SUBGHZEX_EXTI_LINE_RFBUSY);
+#else
+  LL_EXTI_EnableIT_32_63(SUBGHZEX_EXTI_LINE_RFBUSY);
+#endif /* CORE_CM0PLUS */
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Send all the commands of a batch, waiting for BUSY with the radio
+  *         BUSY interrupt.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @param  hbatch pointer to a SUBGHZEx_BatchTypeDef structure, which must not
+  *         be modified before XferCpltCallback is called.
+  * @note   The commands are sent from the interrupt handler, each one taking
+  *         a few microseconds of SUBGHZSPI transfer.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_ExecBatch_IT(SUBGHZEx_XferTypeDef *hxfer, const SUBGHZEx_BatchTypeDef *hbatch)
+{
+  SUBGHZ_HandleTypeDef *hsubghz = hxfer->hsubghz;
+
+  if (hbatch->CmdNbr == 0U)
+  {
+    return HAL_ERROR;
+  }
+
+  if (hsubghz->State == HAL_SUBGHZ_STATE_READY)
+  {
+    /* Process Locked */
+    __HAL_LOCK(hsubghz);
+
+    hsubghz->State   = HAL_SUBGHZ_STATE_BUSY;
+    hxfer->Operation = SUBGHZEX_OP_BATCH;
+    hxfer->ErrorCode = HAL_SUBGHZ_ERROR_NONE;
+    hxfer->pBatch    = hbatch;
+    hxfer->BatchPos  = 0U;
+
+    /* Need to wakeup Radio if already in Sleep at startup */
+    SUBGHZEx_WakeUp(hsubghz);
+
+    /* Process Unlocked */
+    __HAL_UNLOCK(hsubghz);
+
+    SUBGHZEx_BatchStep(hxfer);
+
+    return HAL_OK;
+  }
+  else
+  {
+    return HAL_BUSY;
+  }
+}
+
+/**
+  * @brief  Write the radio data buffer with the SUBGHZSPI Tx DMA.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @param  Offset  offset inside the payload.
+  * @param  pBuffer pointer to the data, which must stay valid until
+  *         XferCpltCallback is called.
+  * @param  Size    amount of data to be sent.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_WriteBuffer_DMA(SUBGHZEx_XferTypeDef *hxfer, uint8_t Offset, uint8_t *pBuffer,
+                                               uint16_t Size)
+{
+  SUBGHZ_HandleTypeDef *hsubghz = hxfer->hsubghz;
+  uint8_t header[2];
+
+  if ((hxfer->hdmatx == NULL) || (pBuffer == NULL) || (Size == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  if (hsubghz->State == HAL_SUBGHZ_STATE_READY)
+  {
+    /* Process Locked */
+    __HAL_LOCK(hsubghz);
+
+    hsubghz->State     = HAL_SUBGHZ_STATE_BUSY;
+    hxfer->Operation   = SUBGHZEX_OP_WRITE_BUFFER;
+    hxfer->ErrorCode   = HAL_SUBGHZ_ERROR_NONE;
+    hxfer->pXferBuffer = pBuffer;
+    hxfer->XferSize    = Size;
+
+    SUBGHZEx_WakeUp(hsubghz);
+
+    header[0] = SUBGHZ_RADIO_WRITE_BUFFER;
+    header[1] = Offset;
+
+    /* NSS = 0 */
+    LL_PWR_SelectSUBGHZSPI_NSS();
+
+    (void)SUBGHZEx_SPITransfer(hsubghz, header, NULL, 2U);
+
+    /* The Rx FIFO is left to overrun during the transfer and flushed at its end */
+    hxfer->hdmatx->XferCpltCallback     = SUBGHZEx_DMATxCplt;
+    hxfer->hdmatx->XferHalfCpltCallback = NULL;
+    hxfer->hdmatx->XferErrorCallback    = SUBGHZEx_DMAError;
+    hxfer->hdmatx->XferAbortCallback    = NULL;
+
+    if (HAL_DMA_Start_IT(hxfer->hdmatx, (uint32_t)pBuffer, (uint32_t)&SUBGHZSPI->DR, Size) != HAL_OK)
+    {
+      /* NSS = 1 */
+      LL_PWR_UnselectSUBGHZSPI_NSS();
+
+      hxfer->Operation = SUBGHZEX_OP_NONE;
+      hxfer->ErrorCode = HAL_SUBGHZ_ERROR_DMA;
+      hsubghz->State   = HAL_SUBGHZ_STATE_READY;
+
+      /* Process Unlocked */
+      __HAL_UNLOCK(hsubghz);
+
+      return HAL_ERROR;
+    }
+
+    SET_BIT(SUBGHZSPI->CR2, SPI_CR2_TXDMAEN);
+
+    /* Process Unlocked */
+    __HAL_UNLOCK(hsubghz);
+
+    return HAL_OK;
+  }
+  else
+  {
+    return HAL_BUSY;
+  }
+}
+
+/**
+  * @brief  Read the radio data buffer with the SUBGHZSPI Rx and Tx DMA.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @param  Offset  offset inside the payload.
+  * @param  pBuffer pointer to the destination buffer, which must stay valid
+  *         until XferCpltCallback is called.
+  * @param  Size    amount of data to be received.
+  * @note   pBuffer is filled with dummy bytes then used as Tx DMA source, so
+  *         both DMA channels keep memory increment enabled.
+  * @retval HAL status
+  */
+HAL_StatusTypeDef HAL_SUBGHZEx_ReadBuffer_DMA(SUBGHZEx_XferTypeDef *hxfer, uint8_t Offset, uint8_t *pBuffer,
+                                              uint16_t Size)
+{
+  SUBGHZ_HandleTypeDef *hsubghz = hxfer->hsubghz;
+  uint8_t header[3];
+
+  if ((hxfer->hdmatx == NULL) || (hxfer->hdmarx == NULL) || (pBuffer == NULL) || (Size == 0U))
+  {
+    return HAL_ERROR;
+  }
+
+  if (hsubghz->State == HAL_SUBGHZ_STATE_READY)
+  {
+    /* Process Locked */
+    __HAL_LOCK(hsubghz);
+
+    hsubghz->State     = HAL_SUBGHZ_STATE_BUSY;
+    hxfer->Operation   = SUBGHZEX_OP_READ_BUFFER;
+    hxfer->ErrorCode   = HAL_SUBGHZ_ERROR_NONE;
+    hxfer->pXferBuffer = pBuffer;
+    hxfer->XferSize    = Size;
+
+    for (uint16_t i = 0U; i < Size; i++)
+    {
+      pBuffer[i] = SUBGHZEX_DUMMY_DATA;
+    }
+
+    SUBGHZEx_WakeUp(hsubghz);
+
+    header[0] = SUBGHZ_RADIO_READ_BUFFER;
+    header[1] = Offset;
+    header[2] = 0x00U;
+
+    /* NSS = 0 */
+    LL_PWR_SelectSUBGHZSPI_NSS();
+
+    /* Opcode, offset, then the status byte which is flushed */
+    (void)SUBGHZEx_SPITransfer(hsubghz, header, NULL, 3U);
+
+    hxfer->hdmarx->XferCpltCallback     = SUBGHZEx_DMARxCplt;
+    hxfer->hdmarx->XferHalfCpltCallback = NULL;
+    hxfer->hdmarx->XferErrorCallback    = SUBGHZEx_DMAError;
+    hxfer->hdmarx->XferAbortCallback    = NULL;
+    hxfer->hdmatx->XferCpltCallback     = NULL;
+    hxfer->hdmatx->XferHalfCpltCallback = NULL;
+    hxfer->hdmatx->XferErrorCallback    = SUBGHZEx_DMAError;
+    hxfer->hdmatx->XferAbortCallback    = NULL;
+
+    /* Rx DMA request is enabled first, Tx DMA request last */
+    SET_BIT(SUBGHZSPI->CR2, SPI_CR2_RXDMAEN);
+
+    if ((HAL_DMA_Start_IT(hxfer->hdmarx, (uint32_t)&SUBGHZSPI->DR, (uint32_t)pBuffer, Size) != HAL_OK)
+        || (HAL_DMA_Start_IT(hxfer->hdmatx, (uint32_t)pBuffer, (uint32_t)&SUBGHZSPI->DR, Size) != HAL_OK))
+    {
+      (void)HAL_DMA_Abort(hxfer->hdmarx);
+      CLEAR_BIT(SUBGHZSPI->CR2, SPI_CR2_RXDMAEN);
+
+      /* NSS = 1 */
+      LL_PWR_UnselectSUBGHZSPI_NSS();
+
+      hxfer->Operation = SUBGHZEX_OP_NONE;
+      hxfer->ErrorCode = HAL_SUBGHZ_ERROR_DMA;
+      hsubghz->State   = HAL_SUBGHZ_STATE_READY;
+
+      /* Process Unlocked */
+      __HAL_UNLOCK(hsubghz);
+
+      return HAL_ERROR;
+    }
+
+    SET_BIT(SUBGHZSPI->CR2, SPI_CR2_TXDMAEN);
+
+    /* Process Unlocked */
+    __HAL_UNLOCK(hsubghz);
+
+    return HAL_OK;
+  }
+  else
+  {
+    return HAL_BUSY;
+  }
+}
+
+/**
+  * @brief  Handle the radio BUSY interrupt.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @note   To be called from SUBGHZ_Radio_IRQHandler(). Returns without effect
+  *         when the interrupt was not raised by the radio BUSY signal.
+  * @retval None
+  */
+void HAL_SUBGHZEx_BusyIRQHandler(SUBGHZEx_XferTypeDef *hxfer)
+{
+  if (LL_PWR_IsActiveFlag_RFBUSY() != 0UL)
+  {
+    LL_PWR_ClearFlag_RFBUSY();
+
+    /* Ignore a stale edge, BUSY may have been raised again since */
+    if ((hxfer->Operation != SUBGHZEX_OP_NONE) && (SUBGHZEx_IsBusy() == 0UL))
+    {
+      SUBGHZEx_DisarmBusy();
+
+      if (hxfer->Operation == SUBGHZEX_OP_BATCH)
+      {
+        SUBGHZEx_BatchStep(hxfer);
+      }
+      else
+      {
+        SUBGHZEx_Complete(hxfer);
+      }
+    }
+  }
+}
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */
+
+/** @addtogroup SUBGHZEx_Private_Functions
+  * @brief   Private functions
+  * @{
+  */
+
+/**
+  * @brief  Check the radio BUSY signal, as SUBGHZ_WaitOnBusy() does.
+  * @retval 1 when the radio is busy, 0 otherwise.
+  */
+static uint32_t SUBGHZEx_IsBusy(void)
+{
+  return (LL_PWR_IsActiveFlag_RFBUSYS() & LL_PWR_IsActiveFlag_RFBUSYMS());
+}
+
+/**
+  * @brief  Wait busy flag low from peripheral
+  * @param  hsubghz pointer to a SUBGHZ_HandleTypeDef structure that contains
+  *         the handle information for SUBGHZ module.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SUBGHZEx_WaitOnBusy(SUBGHZ_HandleTypeDef *hsubghz)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  __IO uint32_t count = SUBGHZEX_DEFAULT_TIMEOUT * SUBGHZEX_RFBUSY_LOOP_TIME;
+
+  while (SUBGHZEx_IsBusy() == 1UL)
+  {
+    if (count == 0U)
+    {
+      status = HAL_ERROR;
+      hsubghz->ErrorCode = HAL_SUBGHZ_ERROR_RF_BUSY;
+      break;
+    }
+    count--;
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Wake the radio up when it sleeps, then wait for BUSY low.
+  * @param  hsubghz pointer to a SUBGHZ_HandleTypeDef structure that contains
+  *         the handle information for SUBGHZ module.
+  * @retval None
+  */
+static void SUBGHZEx_WakeUp(SUBGHZ_HandleTypeDef *hsubghz)
+{
+  __IO uint32_t count;
+
+  /* Wakeup radio in case of sleep mode: Select-Unselect radio */
+  if (hsubghz->DeepSleep == SUBGHZEX_DEEP_SLEEP_ENABLE)
+  {
+    /* Initialize NSS switch Delay */
+    count = SUBGHZEX_NSS_LOOP_TIME;
+
+    /* NSS = 0; */
+    LL_PWR_SelectSUBGHZSPI_NSS();
+
+    /* Wait Radio wakeup */
+    do
+    {
+      count--;
+    } while (count != 0UL);
+
+    /* NSS = 1 */
+    LL_PWR_UnselectSUBGHZSPI_NSS();
+  }
+
+  (void)SUBGHZEx_WaitOnBusy(hsubghz);
+}
+
+/**
+  * @brief  Full-duplex SUBGHZSPI transfer keeping up to SUBGHZEX_SPI_FIFO_DEPTH
+  *         bytes in flight, NSS being handled by the caller.
+  * @param  hsubghz pointer to a SUBGHZ_HandleTypeDef structure that contains
+  *         the handle information for SUBGHZ module.
+  * @param  pTxData bytes to send, NULL to send dummy bytes.
+  * @param  pRxData received bytes, NULL to discard them.
+  * @param  Size    number of bytes.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SUBGHZEx_SPITransfer(SUBGHZ_HandleTypeDef *hsubghz, const uint8_t *pTxData,
+                                              uint8_t *pRxData, uint16_t Size)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  __IO uint8_t *spidr = ((__IO uint8_t *)&SUBGHZSPI->DR);
+  __IO uint32_t count = SUBGHZEX_DEFAULT_TIMEOUT * SUBGHZEX_DEFAULT_LOOP_TIME;
+  uint16_t txcount = 0U;
+  uint16_t rxcount = 0U;
+  uint8_t data;
+
+  while (rxcount < Size)
+  {
+    if ((txcount < Size) && ((uint16_t)(txcount - rxcount) < SUBGHZEX_SPI_FIFO_DEPTH)
+        && (READ_BIT(SUBGHZSPI->SR, SPI_SR_TXE) == SPI_SR_TXE))
+    {
+      *spidr = (pTxData != NULL) ? pTxData[txcount] : SUBGHZEX_DUMMY_DATA;
+      txcount++;
+    }
+
+    if (READ_BIT(SUBGHZSPI->SR, SPI_SR_RXNE) == SPI_SR_RXNE)
+    {
+      data = *spidr;
+      if (pRxData != NULL)
+      {
+        pRxData[rxcount] = data;
+      }
+      rxcount++;
+      count = SUBGHZEX_DEFAULT_TIMEOUT * SUBGHZEX_DEFAULT_LOOP_TIME;
+    }
+    else
+    {
+      if (count == 0U)
+      {
+        status = HAL_ERROR;
+        hsubghz->ErrorCode = HAL_SUBGHZ_ERROR_TIMEOUT;
+        break;
+      }
+      count--;
+    }
+  }
+
+  return status;
+}
+
+/**
+  * @brief  Wait for the end of a Tx only DMA transfer, then empty the Rx FIFO
+  *         and clear the overrun it caused.
+  * @param  hsubghz pointer to a SUBGHZ_HandleTypeDef structure that contains
+  *         the handle information for SUBGHZ module.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SUBGHZEx_SPIFlush(SUBGHZ_HandleTypeDef *hsubghz)
+{
+  HAL_StatusTypeDef status = HAL_OK;
+  __IO uint32_t count = SUBGHZEX_DEFAULT_TIMEOUT * SUBGHZEX_DEFAULT_LOOP_TIME;
+
+  while ((READ_BIT(SUBGHZSPI->SR, SPI_SR_FTLVL) != 0U) || (READ_BIT(SUBGHZSPI->SR, SPI_SR_BSY) != 0U))
+  {
+    if (count == 0U)
+    {
+      status = HAL_ERROR;
+      hsubghz->ErrorCode = HAL_SUBGHZ_ERROR_TIMEOUT;
+      break;
+    }
+    count--;
+  }
+
+  while (READ_BIT(SUBGHZSPI->SR, SPI_SR_FRLVL) != 0U)
+  {
+    (void)*((__IO uint8_t *)&SUBGHZSPI->DR);
+  }
+
+  /* Clear overrun: read DR then SR */
+  (void)READ_REG(SUBGHZSPI->DR);
+  (void)READ_REG(SUBGHZSPI->SR);
+
+  return status;
+}
+
+/**
+  * @brief  Append a command to a batch.
+  * @param  hbatch pointer to a SUBGHZEx_BatchTypeDef structure.
+  * @param  pHeader opcode and address bytes.
+  * @param  HeaderSize number of header bytes.
+  * @param  pBuffer data bytes.
+  * @param  Size number of data bytes.
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SUBGHZEx_BatchAdd(SUBGHZEx_BatchTypeDef *hbatch, const uint8_t *pHeader,
+                                           uint16_t HeaderSize, const uint8_t *pBuffer, uint16_t Size)
+{
+  uint32_t length = (uint32_t)HeaderSize + Size;
+  uint8_t *pDst;
+
+  if ((length > SUBGHZEX_CMD_MAX_LENGTH) || ((Size != 0U) && (pBuffer == NULL))
+      || (((uint32_t)hbatch->Length + length + 1U) > hbatch->Size))
+  {
+    return HAL_ERROR;
+  }
+
+  /* Nothing may follow a command putting the radio to sleep */
+  if ((hbatch->CmdNbr != 0U) && ((hbatch->LastCommand == (uint8_t)RADIO_SET_SLEEP)
+                                 || (hbatch->LastCommand == (uint8_t)RADIO_SET_RXDUTYCYCLE)))
+  {
+    return HAL_ERROR;
+  }
+
+  pDst = &hbatch->pBuffer[hbatch->Length];
+  *pDst = (uint8_t)length;
+  pDst++;
+
+  for (uint16_t i = 0U; i < HeaderSize; i++)
+  {
+    *pDst = pHeader[i];
+    pDst++;
+  }
+  for (uint16_t i = 0U; i < Size; i++)
+  {
+    *pDst = pBuffer[i];
+    pDst++;
+  }
+
+  hbatch->Length += (uint16_t)(length + 1U);
+  hbatch->CmdNbr++;
+  hbatch->LastCommand = pHeader[0];
+
+  return HAL_OK;
+}
+
+/**
+  * @brief  Enable the radio BUSY interrupt.
+  * @retval 1 when armed, 0 when the radio is already not busy.
+  */
+static uint32_t SUBGHZEx_ArmBusy(void)
+{
+  LL_PWR_ClearFlag_RFBUSY();
+  HAL_PWREx_SetRadioBusyTrigger(PWR_RADIO_BUSY_TRIGGER_WU_IT);
+
+  /* BUSY may have dropped before the trigger was enabled */
+  if (SUBGHZEx_IsBusy() == 0UL)
+  {
+    SUBGHZEx_DisarmBusy();
+    return 0U;
+  }
+
+  return 1U;
+}
+
+/**
+  * @brief  Disable the radio BUSY interrupt.
+  * @retval None
+  */
+static void SUBGHZEx_DisarmBusy(void)
+{
+  HAL_PWREx_SetRadioBusyTrigger(PWR_RADIO_BUSY_TRIGGER_NONE);
+  LL_PWR_ClearFlag_RFBUSY();
+}
+
+/**
+  * @brief  Send the next commands of a batch until one leaves the radio busy.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @retval None
+  */
+static void SUBGHZEx_BatchStep(SUBGHZEx_XferTypeDef *hxfer)
+{
+  SUBGHZ_HandleTypeDef *hsubghz = hxfer->hsubghz;
+  const SUBGHZEx_BatchTypeDef *hbatch = hxfer->pBatch;
+  uint32_t length;
+
+  do
+  {
+    if (hxfer->BatchPos >= hbatch->Length)
+    {
+      SUBGHZEx_Complete(hxfer);
+      return;
+    }
+
+    length = hbatch->pBuffer[hxfer->BatchPos];
+
+    /* NSS = 0 */
+    LL_PWR_SelectSUBGHZSPI_NSS();
+
+    if (SUBGHZEx_SPITransfer(hsubghz, &hbatch->pBuffer[hxfer->BatchPos + 1U], NULL, (uint16_t)length) != HAL_OK)
+    {
+      /* NSS = 1 */
+      LL_PWR_UnselectSUBGHZSPI_NSS();
+
+      SUBGHZEx_Error(hxfer, HAL_SUBGHZ_ERROR_TIMEOUT);
+      return;
+    }
+
+    /* NSS = 1 */
+    LL_PWR_UnselectSUBGHZSPI_NSS();
+
+    hxfer->BatchPos += (uint16_t)(length + 1U);
+
+    /* BUSY is not released once the radio sleeps */
+    if ((hxfer->BatchPos >= hbatch->Length) && (hbatch->LastCommand == (uint8_t)RADIO_SET_SLEEP))
+    {
+      SUBGHZEx_Complete(hxfer);
+      return;
+    }
+  } while (SUBGHZEx_ArmBusy() == 0U);
+}
+
+/**
+  * @brief  End of the SUBGHZSPI part of a buffer transfer: release NSS and
+  *         wait for BUSY.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @retval None
+  */
+static void SUBGHZEx_BufferDone(SUBGHZEx_XferTypeDef *hxfer)
+{
+  CLEAR_BIT(SUBGHZSPI->CR2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+
+  if (hxfer->Operation == SUBGHZEX_OP_WRITE_BUFFER)
+  {
+    (void)SUBGHZEx_SPIFlush(hxfer->hsubghz);
+  }
+
+  /* NSS = 1 */
+  LL_PWR_UnselectSUBGHZSPI_NSS();
+
+  if (SUBGHZEx_ArmBusy() == 0U)
+  {
+    SUBGHZEx_Complete(hxfer);
+  }
+}
+
+/**
+  * @brief  End an operation and call the completion callback.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @retval None
+  */
+static void SUBGHZEx_Complete(SUBGHZEx_XferTypeDef *hxfer)
+{
+  SUBGHZ_HandleTypeDef *hsubghz = hxfer->hsubghz;
+
+  if (hxfer->Operation == SUBGHZEX_OP_BATCH)
+  {
+    if ((hxfer->pBatch->LastCommand == (uint8_t)RADIO_SET_SLEEP)
+        || (hxfer->pBatch->LastCommand == (uint8_t)RADIO_SET_RXDUTYCYCLE))
+    {
+      hsubghz->DeepSleep = SUBGHZEX_DEEP_SLEEP_ENABLE;
+    }
+    else
+    {
+      hsubghz->DeepSleep = SUBGHZEX_DEEP_SLEEP_DISABLE;
+    }
+  }
+
+  hxfer->Operation = SUBGHZEX_OP_NONE;
+  hsubghz->State   = HAL_SUBGHZ_STATE_READY;
+
+  if (hxfer->XferCpltCallback != NULL)
+  {
+    hxfer->XferCpltCallback(hxfer);
+  }
+}
+
+/**
+  * @brief  Abort an operation and call the error callback.
+  * @param  hxfer pointer to a SUBGHZEx_XferTypeDef structure.
+  * @param  ErrorCode a value of @ref SUBGHZ_Error_Code.
+  * @retval None
+  */
+static void SUBGHZEx_Error(SUBGHZEx_XferTypeDef *hxfer, uint32_t ErrorCode)
+{
+  SUBGHZ_HandleTypeDef *hsubghz = hxfer->hsubghz;
+
+  SUBGHZEx_DisarmBusy();
+
+  hxfer->ErrorCode   |= ErrorCode;
+  hsubghz->ErrorCode |= ErrorCode;
+  hxfer->Operation    = SUBGHZEX_OP_NONE;
+  hsubghz->State      = HAL_SUBGHZ_STATE_READY;
+
+  if (hxfer->ErrorCallback != NULL)
+  {
+    hxfer->ErrorCallback(hxfer);
+  }
+}
+
+/**
+  * @brief  SUBGHZSPI Tx DMA transfer complete callback.
+  * @param  hdma pointer to a DMA_HandleTypeDef structure.
+  * @retval None
+  */
+static void SUBGHZEx_DMATxCplt(DMA_HandleTypeDef *hdma)
+{
+  SUBGHZEx_XferTypeDef *hxfer = (SUBGHZEx_XferTypeDef *)(hdma->Parent);
+
+  SUBGHZEx_BufferDone(hxfer);
+}
+
+/**
+  * @brief  SUBGHZSPI Rx DMA transfer complete callback.
+  * @param  hdma pointer to a DMA_HandleTypeDef structure.
+  * @retval None
+  */
+static void SUBGHZEx_DMARxCplt(DMA_HandleTypeDef *hdma)
+{
+  SUBGHZEx_XferTypeDef *hxfer = (SUBGHZEx_XferTypeDef *)(hdma->Parent);
+
+  SUBGHZEx_BufferDone(hxfer);
+}
+
+/**
+  * @brief  SUBGHZSPI DMA error callback.
+  * @param  hdma pointer to a DMA_HandleTypeDef structure.
+  * @retval None
+  */
+static void SUBGHZEx_DMAError(DMA_HandleTypeDef *hdma)
+{
+  SUBGHZEx_XferTypeDef *hxfer = (SUBGHZEx_XferTypeDef *)(hdma->Parent);
+
+  CLEAR_BIT(SUBGHZSPI->CR2, SPI_CR2_TXDMAEN | SPI_CR2_RXDMAEN);
+
+  if (hxfer->hdmatx != NULL)
+  {
+    (void)HAL_DMA_Abort(hxfer->hdmatx);
+  }
+  if (hxfer->hdmarx != NULL)
+  {
+    (void)HAL_DMA_Abort(hxfer->hdmarx);
+  }
+
+  (void)SUBGHZEx_SPIFlush(hxfer->hsubghz);
+
+  /* NSS = 1 */
+  LL_PWR_UnselectSUBGHZSPI_NSS();
+
+  SUBGHZEx_Error(hxfer, HAL_SUBGHZ_ERROR_DMA);
+}
+
+/**
+  * @}
+  */
+
+#endif /* HAL_SUBGHZ_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+
+/**
+  * @}
+  */